@@ -59,6 +59,7 @@ enum st_args_cmd {
   ST_ARG_PTP_UNICAST_ADDR,
   ST_ARG_CNI_THREAD,
   ST_ARG_RX_EBU,
+  ST_ARG_TX_EBU,
   ST_ARG_USER_LCORES,
   ST_ARG_SCH_DATA_QUOTA,
   ST_ARG_SCH_SESSION_QUOTA,
@@ -171,6 +172,7 @@ static struct option st_app_args_options[] = {
     {"ptp_unicast", no_argument, 0, ST_ARG_PTP_UNICAST_ADDR},
     {"cni_thread", no_argument, 0, ST_ARG_CNI_THREAD},
     {"ebu", no_argument, 0, ST_ARG_RX_EBU},
+    {"tx_ebu", no_argument, 0, ST_ARG_TX_EBU},
     {"lcores", required_argument, 0, ST_ARG_USER_LCORES},
     {"sch_data_quota", required_argument, 0, ST_ARG_SCH_DATA_QUOTA},
     {"sch_session_quota", required_argument, 0, ST_ARG_SCH_SESSION_QUOTA},
@@ -491,6 +493,9 @@ int st_app_parse_args(struct st_app_context* ctx, struct mtl_init_params* p, int
       case ST_ARG_RX_EBU:
         p->flags |= MTL_FLAG_RX_VIDEO_EBU;
         break;
+      case ST_ARG_TX_EBU:
+        p->flags |= MTL_FLAG_TX_VIDEO_EBU;
+        break;
       case ST_ARG_RX_MONO_POOL:
         p->flags |= MTL_FLAG_RX_MONO_POOL;
         break;
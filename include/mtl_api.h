@@ -426,6 +426,13 @@ enum st21_tx_pacing_way {
  * Enable built-in PHC2SYS implementation.
  */
 #define MTL_FLAG_PHC2SYS_ENABLE (MTL_BIT64(46))
+/**
+ * Flag bit in flags of struct mtl_init_params, debug usage only.
+ * Enable video tx ebu check, the burst time of each pkt is traced and analysed with
+ * the ST2110-21 model(Cinst, VRX, TRoffset). Can be used with a net_null/net_ring vdev
+ * port to check the pacing without a hardware analyzer.
+ */
+#define MTL_FLAG_TX_VIDEO_EBU (MTL_BIT64(47))
 
 /**
  * The structure describing how to init af_xdp interface.
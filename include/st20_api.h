@@ -212,6 +212,15 @@ extern "C" {
  * If enabled, simulate random packet loss.
  */
 #define ST22_RX_FLAG_SIMULATE_PKT_LOSS (MTL_BIT32(4))
+/**
+ * Flag bit in flags of struct st22_rx_ops.
+ * Only for ST22_TYPE_FRAME_LEVEL.
+ * If set, lib holds the received packets instead of copying the payload into the
+ * framebuffer, the codestream is passed as the segments list in st22_rx_frame_meta and
+ * the packets are released when the frame is put back by st22_rx_put_framebuff.
+ * Lib falls back to copy for the packets once the rx mempool is running low.
+ */
+#define ST22_RX_FLAG_CODESTREAM_SEGMENTS (MTL_BIT32(5))
 
 /**
  * Flag bit in flags of struct st22_rx_ops.
@@ -297,6 +306,12 @@ enum st22_type {
   ST22_TYPE_FRAME_LEVEL = 0,
   /** app interface lib based on RTP level, same to ST20_TYPE_RTP_LEVEL */
   ST22_TYPE_RTP_LEVEL,
+  /**
+   * similar to ST22_TYPE_FRAME_LEVEL but with slice control, the codestream is sent
+   * once the bytes are ready on tx and notified as it arrives on rx.
+   * For rx, pls always enable ST22_RX_FLAG_RECEIVE_INCOMPLETE_FRAME.
+   */
+  ST22_TYPE_SLICE_LEVEL,
   /** max value of this enum */
   ST22_TYPE_MAX,
 };
@@ -448,6 +463,38 @@ struct st20_rx_slice_meta {
   uint32_t frame_recv_lines;
 };
 
+/**
+ * Preview meta data of st2110-20(video) rx streaming, a decimated copy of the frame.
+ */
+struct st20_rx_preview_meta {
+  /**
+   * The preview buffer in ST20_FMT_YUV_422_8BIT, owned by lib and only valid inside the
+   * notify_preview_ready callback.
+   */
+  void* addr;
+  /** Preview resolution width */
+  uint32_t width;
+  /** Preview resolution height, the field height for interlaced mode */
+  uint32_t height;
+  /** Preview line size in bytes */
+  size_t linesize;
+  /** Preview size in bytes */
+  size_t size;
+  /** Preview format, always ST20_FMT_YUV_422_8BIT */
+  enum st20_fmt fmt;
+  /** Frame timestamp format */
+  enum st10_timestamp_fmt tfmt;
+  /** Frame timestamp value */
+  uint64_t timestamp;
+  /** Second field type indicate, for interlaced mode */
+  bool second_field;
+  /**
+   * Frame status, ST_FRAME_STATUS_CORRUPTED means some lines are missing and keep the
+   * content of the previous preview.
+   */
+  enum st_frame_status status;
+};
+
 /**
  * Pixel group meta data for user frame st2110-20(video) rx streaming.
  */
@@ -478,6 +525,30 @@ struct st20_rx_uframe_pg_meta {
   uint64_t timestamp;
 };
 
+/**
+ * Pixel group meta data for user frame in st2110-20(video) tx streaming.
+ */
+struct st20_tx_uframe_pg_meta {
+  /** Frame resolution width */
+  uint32_t width;
+  /** Frame resolution height */
+  uint32_t height;
+  /** Frame resolution fps */
+  enum st_fps fps;
+  /** Frame resolution format */
+  enum st20_fmt fmt;
+  /** Point to the pixel groups payload to be filled by app */
+  void* payload;
+  /** Number of octets of data to be filled in current pixel groups payload */
+  uint16_t row_length;
+  /** Scan line number */
+  uint16_t row_number;
+  /** Offset of the first pixel of the payload data within current pixel groups data */
+  uint16_t row_offset;
+  /** How many pixel groups in current meta */
+  uint32_t pg_cnt;
+};
+
 /**
  * Frame meta data of st2110-22(video) tx streaming
  */
@@ -498,6 +569,24 @@ struct st22_tx_frame_meta {
   uint64_t epoch;
 };
 
+/**
+ * Slice meta data of st2110-22(video) tx streaming
+ */
+struct st22_tx_slice_meta {
+  /** Ready codestream bytes from the start of the frame */
+  size_t bytes_ready;
+};
+
+/**
+ * One segment of st2110-22 codestream, the payload of one received packet.
+ */
+struct st22_codestream_seg {
+  /** Segment address, NULL if the packet is not received */
+  void* addr;
+  /** Segment length in bytes, 0 if the packet is not received */
+  size_t len;
+};
+
 /**
  * Frame meta data of st2110-22(video) rx streaming
  */
@@ -510,6 +599,27 @@ struct st22_rx_frame_meta {
   size_t frame_total_size;
   /** Frame status, complete or not */
   enum st_frame_status status;
+  /**
+   * The codestream segments in packet order, only for ST22_RX_FLAG_CODESTREAM_SEGMENTS.
+   * Indexed by the packet index of the frame, a lost packet leaves a hole with NULL
+   * addr and 0 len in the list and the status is incomplete then, app should skip the
+   * holes. Valid until the frame is put back by st22_rx_put_framebuff.
+   */
+  struct st22_codestream_seg* segs;
+  /** The number of segments including the holes, the max packet index received + 1 */
+  uint32_t segs_cnt;
+};
+
+/**
+ * Slice meta data of st2110-22(video) rx streaming
+ */
+struct st22_rx_slice_meta {
+  /** Frame timestamp format */
+  enum st10_timestamp_fmt tfmt;
+  /** Frame timestamp value */
+  uint64_t timestamp;
+  /** The received codestream size without any gap from the start of the frame */
+  size_t frame_recv_size;
 };
 
 /**
@@ -907,7 +1017,10 @@ MTL_PACK(struct st20_rfc4175_422_8_pg2_le {
 struct st20_ext_frame {
   /** Virtual address of external framebuffer */
   void* buf_addr;
-  /** DMA mapped IOVA of external framebuffer */
+  /**
+   * DMA mapped IOVA of external framebuffer. For tx, 0 or MTL_BAD_IOVA let the lib map
+   * the buffer on the first use and cache the mapping for the next frames.
+   */
   mtl_iova_t buf_iova;
   /** Length of external framebuffer */
   size_t buf_len;
@@ -1041,6 +1154,21 @@ struct st20_tx_ops {
    */
   int (*query_frame_lines_ready)(void* priv, uint16_t frame_idx,
                                  struct st20_tx_slice_meta* meta);
+  /**
+   * Optional for ST20_TYPE_FRAME_LEVEL/ST20_TYPE_SLICE_LEVEL.
+   * User frame callback when lib build one pkt, the framebuffer is not used and app
+   * should fill the pixel group data of the payload from the user frame of frame_idx,
+   * it saves the full frame convert to the framebuffer.
+   * meta: point to the meta data.
+   * return:
+   *   - 0: if app fill the pixel group successfully.
+   *   < 0: the error code if app can't handle, lib still sends the pkt with a zeroed
+   *   payload to keep the seq and pacing, and counts it in the session stat.
+   * And only non-block method can be used in this callback as it run from lcore tasklet
+   * routine. The session framebuffers are not allocated in this mode.
+   */
+  int (*uframe_pg_callback)(void* priv, uint16_t frame_idx,
+                            struct st20_tx_uframe_pg_meta* meta);
 
   /** Mandatory for ST20_TYPE_RTP_LEVEL. rtp ring queue size, must be power of 2 */
   uint32_t rtp_ring_size;
@@ -1172,6 +1300,16 @@ struct st22_tx_ops {
    * tasklet routine.
    */
   int (*notify_rtp_done)(void* priv);
+
+  /**
+   * Mandatory for ST22_TYPE_SLICE_LEVEL.
+   * The callback when lib requires the ready codestream bytes of the frame in sending.
+   * The codestream_size of get_next_frame is the final size in this mode, usually the
+   * CBR size, the frame is sent as the bytes get ready. And only non-block method can
+   * be used within this callback as it run from lcore tasklet routine.
+   */
+  int (*query_frame_bytes_ready)(void* priv, uint16_t frame_idx,
+                                 struct st22_tx_slice_meta* meta);
 };
 
 /**
@@ -1373,6 +1511,22 @@ struct st20_rx_ops {
    * routine.
    */
   int (*notify_rtp_ready)(void* priv);
+
+  /**
+   * Optional for ST20_TYPE_FRAME_LEVEL/ST20_TYPE_SLICE_LEVEL. The decimation factor of
+   * the preview, one of 2, 4, 8, 16, 0 means no preview. The preview is sampled from the
+   * packets of ST20_FMT_YUV_422_10BIT or ST20_FMT_YUV_422_8BIT in the rx tasklet.
+   */
+  uint8_t preview_scale;
+  /** Optional. Deliver one preview every preview_interval frames, 0 means 1 */
+  uint16_t preview_interval;
+  /**
+   * Mandatory if preview_scale is set. The callback when one preview is ready, the
+   * preview buffer is reused after this callback returns.
+   * And only non-block method can be used in this callback as it run from lcore tasklet
+   * routine.
+   */
+  int (*notify_preview_ready)(void* priv, struct st20_rx_preview_meta* meta);
 };
 
 /**
@@ -1469,6 +1623,21 @@ struct st22_rx_ops {
    * routine.
    */
   int (*notify_rtp_ready)(void* priv);
+
+  /**
+   * Optional for ST22_TYPE_SLICE_LEVEL. The codestream bytes of one slice, the
+   * notify_slice_ready is called once more slice received. Default is
+   * framebuff_max_size / 32.
+   */
+  uint32_t slice_size;
+  /**
+   * Mandatory for ST22_TYPE_SLICE_LEVEL.
+   * The callback when lib received one more slice of the codestream for a frame, the
+   * frame is notified by notify_frame_ready as usual once the whole frame received.
+   * And only non-block method can be used in this callback as it run from lcore tasklet
+   * routine.
+   */
+  int (*notify_slice_ready)(void* priv, void* frame, struct st22_rx_slice_meta* meta);
 };
 
 /**
@@ -60,6 +60,15 @@ typedef struct st_rx_audio_session_handle_impl* st30_rx_handle;
  * If enable the rtcp.
  */
 #define ST30_TX_FLAG_ENABLE_RTCP (MTL_BIT32(6))
+/**
+ * Flag bit in flags of struct st30_tx_ops.
+ * If enabled, lib create one eventfd which can be get by st30_tx_get_event_fd, it's
+ * signalled when a frame is done(ST30_TYPE_FRAME_LEVEL) or a rtp packet is consumed
+ * (ST30_TYPE_RTP_LEVEL). Only one write happens until the next get_next_frame call or
+ * st30_tx_get_mbuf call, app should call st30_tx_get_mbuf until NULL after the fd is
+ * readable for ST30_TYPE_RTP_LEVEL.
+ */
+#define ST30_TX_FLAG_EVENT_FD (MTL_BIT32(7))
 
 /**
  * Flag bit in flags of struct st30_rx_ops, for non MTL_PMD_DPDK_USER.
@@ -72,6 +81,15 @@ typedef struct st_rx_audio_session_handle_impl* st30_rx_handle;
  * If enable the rtcp.
  */
 #define ST30_RX_FLAG_ENABLE_RTCP (MTL_BIT32(1))
+/**
+ * Flag bit in flags of struct st30_rx_ops.
+ * If enabled, lib create one eventfd which can be get by st30_rx_get_event_fd, it's
+ * signalled when notify_frame_ready or notify_rtp_ready is called. Only one write
+ * happens until the next st30_rx_put_framebuff or st30_rx_get_mbuf call, app should
+ * check the ready frames again after each st30_rx_put_framebuff, or call
+ * st30_rx_get_mbuf until NULL after the fd is readable.
+ */
+#define ST30_RX_FLAG_EVENT_FD (MTL_BIT32(2))
 
 /** default time in the fifo between packet builder and pacing */
 #define ST30_TX_FIFO_DEFAULT_TIME_MS (10)
@@ -502,6 +520,18 @@ void* st30_tx_get_mbuf(st30_tx_handle handle, void** usrptr);
  */
 int st30_tx_put_mbuf(st30_tx_handle handle, void* mbuf, uint16_t len);
 
+/**
+ * Get the eventfd of the tx st2110-30(audio) session, only for ST30_TX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st30_tx_free.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30(audio) session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st30_tx_get_event_fd(st30_tx_handle handle);
+
 /**
  * Retrieve the packet time in nanoseconds from st2110-30(audio) ptime.
  *
@@ -659,6 +689,18 @@ void st30_rx_put_mbuf(st30_rx_handle handle, void* mbuf);
  */
 int st30_rx_get_queue_meta(st30_rx_handle handle, struct st_queue_meta* meta);
 
+/**
+ * Get the eventfd of the rx st2110-30(audio) session, only for ST30_RX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st30_rx_free.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30(audio) session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st30_rx_get_event_fd(st30_rx_handle handle);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,442 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+/**
+ * @file st30_pipeline_api.h
+ *
+ * Interfaces for st2110-30 pipeline transport.
+ * It hide the packet level detail and the pcm sample format convert that application
+ * can focus on the frame based pcm handling.
+ *
+ */
+
+#include "st30_api.h"
+#include "st_pipeline_api.h"
+
+#ifndef _ST30_PIPELINE_API_HEAD_H_
+#define _ST30_PIPELINE_API_HEAD_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/** Handle to tx st2110-30 pipeline session of lib */
+typedef struct st30p_tx_ctx* st30p_tx_handle;
+/** Handle to rx st2110-30 pipeline session of lib */
+typedef struct st30p_rx_ctx* st30p_rx_handle;
+
+/**
+ * Pcm sample format of the st2110-30 pipeline frame.
+ */
+enum st30_frame_fmt {
+  /** Same as the transport format, no convert, the frame is the transport buffer */
+  ST30_FRAME_FMT_TRANSPORT = 0,
+  /**
+   * Signed 32 bits little endian per sample, the big endian transport sample is left
+   * aligned into the 32 bits. Only for ST30_FMT_PCM16 and ST30_FMT_PCM24 transport.
+   */
+  ST30_FRAME_FMT_S32LE,
+  /** AES3 subframe per sample, only for ST31_FMT_AM824 transport */
+  ST30_FRAME_FMT_AES3,
+  /** max value of this enum */
+  ST30_FRAME_FMT_MAX,
+};
+
+/** The structure info for st2110-30 pipeline frame. */
+struct st30_frame {
+  /** frame buffer address */
+  void* addr;
+  /** frame buffer size */
+  size_t buffer_size;
+  /** frame valid data size */
+  size_t data_size;
+  /** frame pcm format */
+  enum st30_frame_fmt fmt;
+  /** the pcm format on the wire */
+  enum st30_fmt transport_fmt;
+  /** channel number */
+  uint16_t channel;
+  /** sampling rate */
+  enum st30_sampling sampling;
+  /** packet time */
+  enum st30_ptime ptime;
+  /** samples of each channel in this frame */
+  uint32_t sample_num;
+  /** frame timestamp format */
+  enum st10_timestamp_fmt tfmt;
+  /** frame timestamp value */
+  uint64_t timestamp;
+
+  /** priv pointer for lib, do not touch this */
+  void* priv;
+  /** priv data for user */
+  void* opaque;
+};
+
+/**
+ * Flag bit in flags of struct st30p_tx_ops.
+ * P TX destination mac assigned by user
+ */
+#define ST30P_TX_FLAG_USER_P_MAC (MTL_BIT32(0))
+/**
+ * Flag bit in flags of struct st30p_tx_ops.
+ * R TX destination mac assigned by user
+ */
+#define ST30P_TX_FLAG_USER_R_MAC (MTL_BIT32(1))
+/**
+ * Flag bit in flags of struct st30p_tx_ops.
+ * User control the frame pacing by pass a timestamp in st30_frame,
+ * lib will wait until timestamp is reached for each frame.
+ */
+#define ST30P_TX_FLAG_USER_PACING (MTL_BIT32(3))
+/**
+ * Flag bit in flags of struct st30p_tx_ops.
+ * If enabled, lib will assign the rtp timestamp to the value in
+ * st30_frame(ST10_TIMESTAMP_FMT_MEDIA_CLK is used)
+ */
+#define ST30P_TX_FLAG_USER_TIMESTAMP (MTL_BIT32(4))
+/**
+ * Flag bit in flags of struct st30p_tx_ops.
+ * If enabled, st30p_tx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st30p_tx_set_block_timeout.
+ * st30p_tx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST30P_TX_FLAG_BLOCK_GET (MTL_BIT32(8))
+/**
+ * Flag bit in flags of struct st30p_tx_ops.
+ * If enabled, lib create one eventfd which can be get by st30p_tx_get_event_fd, it's
+ * signalled when any frame is free for st30p_tx_get_frame. Only one write happens until
+ * the next st30p_tx_get_frame call, app should call st30p_tx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST30P_TX_FLAG_EVENT_FD (MTL_BIT32(9))
+
+/**
+ * Flag bit in flags of struct st30p_rx_ops, for non MTL_PMD_DPDK_USER.
+ * If set, it's application duty to set the rx flow(queue) and multicast join/drop.
+ * Use st30p_rx_get_queue_meta to get the queue meta(queue number etc) info.
+ */
+#define ST30P_RX_FLAG_DATA_PATH_ONLY (MTL_BIT32(0))
+/**
+ * Flag bit in flags of struct st30p_rx_ops.
+ * If enabled, st30p_rx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st30p_rx_set_block_timeout.
+ * st30p_rx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST30P_RX_FLAG_BLOCK_GET (MTL_BIT32(3))
+/**
+ * Flag bit in flags of struct st30p_rx_ops.
+ * If enabled, lib create one eventfd which can be get by st30p_rx_get_event_fd, it's
+ * signalled when any frame is ready for st30p_rx_get_frame. Only one write happens until
+ * the next st30p_rx_get_frame call, app should call st30p_rx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST30P_RX_FLAG_EVENT_FD (MTL_BIT32(4))
+
+/** The structure describing how to create a tx st2110-30 pipeline session. */
+struct st30p_tx_ops {
+  /** Mandatory. tx port info */
+  struct st_tx_port port;
+  /** Mandatory. Session pcm format on the wire */
+  enum st30_fmt fmt;
+  /** Mandatory. Session channel number */
+  uint16_t channel;
+  /** Mandatory. Session sampling rate */
+  enum st30_sampling sampling;
+  /** Mandatory. Session packet time */
+  enum st30_ptime ptime;
+  /** Mandatory. Session input frame pcm format */
+  enum st30_frame_fmt frame_fmt;
+  /**
+   * Mandatory. The duration of each frame in us, ex 10000 for 10ms, lib round it to the
+   * nearest count(at least one) of the ptime packets.
+   */
+  uint32_t frame_time_us;
+  /**
+   * Mandatory. the frame buffer count requested for one st30 pipeline tx session,
+   * should be at least 2.
+   */
+  uint16_t framebuff_cnt;
+
+  /** Optional. name */
+  const char* name;
+  /** Optional. private data to the callback function */
+  void* priv;
+  /** Optional. Flags to control session behaviors. See ST30P_TX_FLAG_* for possible value
+   */
+  uint32_t flags;
+  /**
+   * Callback when frame available in the lib, mandatory if neither
+   * ST30P_TX_FLAG_BLOCK_GET nor ST30P_TX_FLAG_EVENT_FD is set.
+   * And only non-block method can be used within this callback as it run from lcore
+   * tasklet routine.
+   */
+  int (*notify_frame_available)(void* priv);
+  /**
+   * Optional. Callback when frame done in the lib.
+   * And only non-block method can be used within this callback as it run from lcore
+   * tasklet routine.
+   */
+  int (*notify_frame_done)(void* priv, struct st30_frame* frame);
+
+  /**
+   * Optional. tx destination mac address.
+   * Valid if ST30P_TX_FLAG_USER_P(R)_MAC is enabled
+   */
+  uint8_t tx_dst_mac[MTL_SESSION_PORT_MAX][MTL_MAC_ADDR_LEN];
+};
+
+/** The structure describing how to create a rx st2110-30 pipeline session. */
+struct st30p_rx_ops {
+  /** Mandatory. rx port info */
+  struct st_rx_port port;
+  /** Mandatory. Session pcm format on the wire */
+  enum st30_fmt fmt;
+  /** Mandatory. Session channel number */
+  uint16_t channel;
+  /** Mandatory. Session sampling rate */
+  enum st30_sampling sampling;
+  /** Mandatory. Session packet time */
+  enum st30_ptime ptime;
+  /** Mandatory. Session output frame pcm format */
+  enum st30_frame_fmt frame_fmt;
+  /**
+   * Mandatory. The duration of each frame in us, ex 10000 for 10ms, lib round it to the
+   * nearest count(at least one) of the ptime packets.
+   */
+  uint32_t frame_time_us;
+  /**
+   * Mandatory. the frame buffer count requested for one st30 pipeline rx session,
+   * should be at least 2.
+   */
+  uint16_t framebuff_cnt;
+
+  /** Optional. name */
+  const char* name;
+  /** Optional. private data to the callback function */
+  void* priv;
+  /** Optional. Flags to control session behaviors. See ST30P_RX_FLAG_* for possible value
+   */
+  uint32_t flags;
+  /**
+   * Callback when frame available in the lib, mandatory if neither
+   * ST30P_RX_FLAG_BLOCK_GET nor ST30P_RX_FLAG_EVENT_FD is set.
+   * And only non-block method can be used within this callback as it run from lcore
+   * tasklet routine.
+   */
+  int (*notify_frame_available)(void* priv);
+};
+
+/**
+ * Create one tx st2110-30 pipeline session.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param ops
+ *   The pointer to the structure describing how to create a tx
+ * st2110-30 pipeline session.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the tx st2110-30 pipeline session.
+ */
+st30p_tx_handle st30p_tx_create(mtl_handle mt, struct st30p_tx_ops* ops);
+
+/**
+ * Free the tx st2110-30 pipeline session.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30 pipeline session.
+ * @return
+ *   - 0: Success, tx st2110-30 pipeline session freed.
+ *   - <0: Error code of the tx st2110-30 pipeline session free.
+ */
+int st30p_tx_free(st30p_tx_handle handle);
+
+/**
+ * Get one tx frame from the tx st2110-30 pipeline session.
+ * Call st30p_tx_put_frame to return the frame to session.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30 pipeline session.
+ * @return
+ *   - NULL if no available frame in the session.
+ *   - Otherwise, the frame pointer.
+ */
+struct st30_frame* st30p_tx_get_frame(st30p_tx_handle handle);
+
+/**
+ * Put back the frame which get by st30p_tx_get_frame to the tx
+ * st2110-30 pipeline session.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30 pipeline session.
+ * @param frame
+ *   the frame pointer by st30p_tx_get_frame.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st30p_tx_put_frame(st30p_tx_handle handle, struct st30_frame* frame);
+
+/**
+ * Get the frame size from the tx st2110-30 pipeline session.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30 pipeline session.
+ * @return
+ *   - size
+ */
+size_t st30p_tx_frame_size(st30p_tx_handle handle);
+
+/**
+ * Wake up the thread blocked in st30p_tx_get_frame, only for ST30P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st30p_tx_wake_block(st30p_tx_handle handle);
+
+/**
+ * Set the timeout of the block st30p_tx_get_frame, only for ST30P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st30p_tx_set_block_timeout(st30p_tx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the tx st2110-30 pipeline session, only for ST30P_TX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st30p_tx_free.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st30p_tx_get_event_fd(st30p_tx_handle handle);
+
+/**
+ * Create one rx st2110-30 pipeline session.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param ops
+ *   The pointer to the structure describing how to create a rx
+ * st2110-30 pipeline session.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the rx st2110-30 pipeline session.
+ */
+st30p_rx_handle st30p_rx_create(mtl_handle mt, struct st30p_rx_ops* ops);
+
+/**
+ * Free the rx st2110-30 pipeline session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @return
+ *   - 0: Success, rx st2110-30 pipeline session freed.
+ *   - <0: Error code of the rx st2110-30 pipeline session free.
+ */
+int st30p_rx_free(st30p_rx_handle handle);
+
+/**
+ * Get one rx frame from the rx st2110-30 pipeline session.
+ * Call st30p_rx_put_frame to return the frame to session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @return
+ *   - NULL if no available frame in the session.
+ *   - Otherwise, the frame pointer.
+ */
+struct st30_frame* st30p_rx_get_frame(st30p_rx_handle handle);
+
+/**
+ * Put back the frame which get by st30p_rx_get_frame to the rx
+ * st2110-30 pipeline session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @param frame
+ *   the frame pointer by st30p_rx_get_frame.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st30p_rx_put_frame(st30p_rx_handle handle, struct st30_frame* frame);
+
+/**
+ * Get the frame size from the rx st2110-30 pipeline session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @return
+ *   - size
+ */
+size_t st30p_rx_frame_size(st30p_rx_handle handle);
+
+/**
+ * Wake up the thread blocked in st30p_rx_get_frame, only for ST30P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st30p_rx_wake_block(st30p_rx_handle handle);
+
+/**
+ * Set the timeout of the block st30p_rx_get_frame, only for ST30P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st30p_rx_set_block_timeout(st30p_rx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the rx st2110-30 pipeline session, only for ST30P_RX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st30p_rx_free.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st30p_rx_get_event_fd(st30p_rx_handle handle);
+
+/**
+ * Get the queue meta attached to rx st2110-30 pipeline session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30 pipeline session.
+ * @param meta
+ *   the rx queue meta info.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st30p_rx_get_queue_meta(st30p_rx_handle handle, struct st_queue_meta* meta);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -54,6 +54,15 @@ typedef struct st_rx_ancillary_session_handle_impl* st40_rx_handle;
  * If enable the rtcp.
  */
 #define ST40_TX_FLAG_ENABLE_RTCP (MTL_BIT32(5))
+/**
+ * Flag bit in flags of struct st40_tx_ops.
+ * If enabled, lib create one eventfd which can be get by st40_tx_get_event_fd, it's
+ * signalled when a frame is done(ST40_TYPE_FRAME_LEVEL) or a rtp packet is consumed
+ * (ST40_TYPE_RTP_LEVEL). Only one write happens until the next get_next_frame call or
+ * st40_tx_get_mbuf call, app should call st40_tx_get_mbuf until NULL after the fd is
+ * readable for ST40_TYPE_RTP_LEVEL.
+ */
+#define ST40_TX_FLAG_EVENT_FD (MTL_BIT32(6))
 
 /**
  * Flag bit in flags of struct st30_rx_ops, for non MTL_PMD_DPDK_USER.
@@ -66,6 +75,14 @@ typedef struct st_rx_ancillary_session_handle_impl* st40_rx_handle;
  * If enable the rtcp.
  */
 #define ST40_RX_FLAG_ENABLE_RTCP (MTL_BIT32(1))
+/**
+ * Flag bit in flags of struct st40_rx_ops.
+ * If enabled, lib create one eventfd which can be get by st40_rx_get_event_fd, it's
+ * signalled when notify_rtp_ready is called. Only one write happens until the next
+ * st40_rx_get_mbuf call, app should call st40_rx_get_mbuf until NULL after the fd is
+ * readable.
+ */
+#define ST40_RX_FLAG_EVENT_FD (MTL_BIT32(2))
 
 /**
  * Session type of st2110-40(ancillary) streaming
@@ -406,6 +423,19 @@ void* st40_tx_get_mbuf(st40_tx_handle handle, void** usrptr);
  */
 int st40_tx_put_mbuf(st40_tx_handle handle, void* mbuf, uint16_t len);
 
+/**
+ * Get the eventfd of the tx st2110-40(ancillary) session, only for
+ * ST40_TX_FLAG_EVENT_FD. The fd can be used with poll/epoll, it's owned by the lib and
+ * closed in st40_tx_free.
+ *
+ * @param handle
+ *   The handle to the tx st2110-40(ancillary) session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st40_tx_get_event_fd(st40_tx_handle handle);
+
 /**
  * Create one rx st2110-40(ancillary) session.
  *
@@ -485,6 +515,19 @@ void st40_rx_put_mbuf(st40_rx_handle handle, void* mbuf);
  */
 int st40_rx_get_queue_meta(st40_rx_handle handle, struct st_queue_meta* meta);
 
+/**
+ * Get the eventfd of the rx st2110-40(ancillary) session, only for
+ * ST40_RX_FLAG_EVENT_FD. The fd can be used with poll/epoll, it's owned by the lib and
+ * closed in st40_rx_free.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40(ancillary) session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st40_rx_get_event_fd(st40_rx_handle handle);
+
 /**
  * Get udw from from st2110-40(ancillary) payload.
  *
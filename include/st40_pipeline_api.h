@@ -0,0 +1,421 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+/**
+ * @file st40_pipeline_api.h
+ *
+ * Interfaces for st2110-40 pipeline transport.
+ * It hide the rfc8331 packet detail(10 bits words, parity and checksum) that application
+ * can focus on the decoded ANC data packets of each field/frame.
+ *
+ */
+
+#include "st40_api.h"
+#include "st_pipeline_api.h"
+
+#ifndef _ST40_PIPELINE_API_HEAD_H_
+#define _ST40_PIPELINE_API_HEAD_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/** Handle to tx st2110-40 pipeline session of lib */
+typedef struct st40p_tx_ctx* st40p_tx_handle;
+/** Handle to rx st2110-40 pipeline session of lib */
+typedef struct st40p_rx_ctx* st40p_rx_handle;
+
+/**
+ * Max number of user data words in one ANC data packet, the data count word is 8 bits.
+ */
+#define ST40_MAX_UDW (255)
+
+/**
+ * Field identification of rfc8331 for the st2110-40 pipeline frame.
+ */
+enum st40_field {
+  /** progressive frame or not specified */
+  ST40_FIELD_PROGRESSIVE = 0,
+  /** invalid value of rfc8331 */
+  ST40_FIELD_INVALID = 1,
+  /** the first field of interlaced frame */
+  ST40_FIELD_FIRST = 2,
+  /** the second field of interlaced frame */
+  ST40_FIELD_SECOND = 3,
+};
+
+/**
+ * One decoded ANC data packet, the values are without the parity bits.
+ */
+struct st40_anc_pkt {
+  /** the ANC data uses luma (Y) data channel */
+  uint8_t c;
+  /** the source data stream number is valid */
+  uint8_t s;
+  /** the source data stream number of the ANC data packet */
+  uint8_t stream_num;
+  /** Data Identification Word */
+  uint8_t did;
+  /** Secondary Data Identification Word */
+  uint8_t sdid;
+  /** Number of the User Data Words in udw */
+  uint8_t udw_size;
+  /** line number corresponds to the location (vertical) of the ANC data packet */
+  uint16_t line_number;
+  /** the location of the ANC data packet in the SDI raster */
+  uint16_t hori_offset;
+  /** User Data Words */
+  uint8_t udw[ST40_MAX_UDW];
+};
+
+/** The structure info for st2110-40 pipeline frame, one field for interlaced. */
+struct st40_anc_frame {
+  /** ANC data packets of this frame */
+  struct st40_anc_pkt pkts[ST40_MAX_META];
+  /**
+   * number of valid ANC data packets in pkts, 0 is valid and tx send it as one
+   * rfc8331 packet with ANC_Count 0.
+   */
+  uint32_t pkt_cnt;
+  /** field identification, rx only, the tx transport always send as progressive */
+  enum st40_field field;
+  /** frame timestamp format */
+  enum st10_timestamp_fmt tfmt;
+  /** frame timestamp value */
+  uint64_t timestamp;
+
+  /** priv pointer for lib, do not touch this */
+  void* priv;
+  /** priv data for user */
+  void* opaque;
+};
+
+/**
+ * Flag bit in flags of struct st40p_tx_ops.
+ * P TX destination mac assigned by user
+ */
+#define ST40P_TX_FLAG_USER_P_MAC (MTL_BIT32(0))
+/**
+ * Flag bit in flags of struct st40p_tx_ops.
+ * R TX destination mac assigned by user
+ */
+#define ST40P_TX_FLAG_USER_R_MAC (MTL_BIT32(1))
+/**
+ * Flag bit in flags of struct st40p_tx_ops.
+ * User control the frame pacing by pass a timestamp in st40_anc_frame,
+ * lib will wait until timestamp is reached for each frame.
+ */
+#define ST40P_TX_FLAG_USER_PACING (MTL_BIT32(3))
+/**
+ * Flag bit in flags of struct st40p_tx_ops.
+ * If enabled, lib will assign the rtp timestamp to the value in
+ * st40_anc_frame(ST10_TIMESTAMP_FMT_MEDIA_CLK is used)
+ */
+#define ST40P_TX_FLAG_USER_TIMESTAMP (MTL_BIT32(4))
+/**
+ * Flag bit in flags of struct st40p_tx_ops.
+ * If enabled, st40p_tx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st40p_tx_set_block_timeout.
+ * st40p_tx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST40P_TX_FLAG_BLOCK_GET (MTL_BIT32(8))
+/**
+ * Flag bit in flags of struct st40p_tx_ops.
+ * If enabled, lib create one eventfd which can be get by st40p_tx_get_event_fd, it's
+ * signalled when any frame is free for st40p_tx_get_frame. Only one write happens until
+ * the next st40p_tx_get_frame call, app should call st40p_tx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST40P_TX_FLAG_EVENT_FD (MTL_BIT32(9))
+
+/**
+ * Flag bit in flags of struct st40p_rx_ops, for non MTL_PMD_DPDK_USER.
+ * If set, it's application duty to set the rx flow(queue) and multicast join/drop.
+ * Use st40p_rx_get_queue_meta to get the queue meta(queue number etc) info.
+ */
+#define ST40P_RX_FLAG_DATA_PATH_ONLY (MTL_BIT32(0))
+/**
+ * Flag bit in flags of struct st40p_rx_ops.
+ * If enabled, st40p_rx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st40p_rx_set_block_timeout.
+ * st40p_rx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST40P_RX_FLAG_BLOCK_GET (MTL_BIT32(3))
+/**
+ * Flag bit in flags of struct st40p_rx_ops.
+ * If enabled, lib create one eventfd which can be get by st40p_rx_get_event_fd, it's
+ * signalled when any frame is ready for st40p_rx_get_frame. Only one write happens until
+ * the next st40p_rx_get_frame call, app should call st40p_rx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST40P_RX_FLAG_EVENT_FD (MTL_BIT32(4))
+
+/** The default timeout to deliver the frame in assembling, 10ms */
+#define ST40P_RX_ASSEMBLE_TIMEOUT_US (10 * 1000)
+
+/** The structure describing how to create a tx st2110-40 pipeline session. */
+struct st40p_tx_ops {
+  /** Mandatory. tx port info */
+  struct st_tx_port port;
+  /** Mandatory. Session fps */
+  enum st_fps fps;
+  /**
+   * Mandatory. the frame buffer count requested for one st40 pipeline tx session,
+   * should be at least 2.
+   */
+  uint16_t framebuff_cnt;
+
+  /** Optional. name */
+  const char* name;
+  /** Optional. private data to the callback function */
+  void* priv;
+  /** Optional. Flags to control session behaviors. See ST40P_TX_FLAG_* for possible value
+   */
+  uint32_t flags;
+  /**
+   * Callback when frame available in the lib, mandatory if neither
+   * ST40P_TX_FLAG_BLOCK_GET nor ST40P_TX_FLAG_EVENT_FD is set.
+   * And only non-block method can be used within this callback as it run from lcore
+   * tasklet routine.
+   */
+  int (*notify_frame_available)(void* priv);
+  /**
+   * Optional. Callback when frame done in the lib.
+   * And only non-block method can be used within this callback as it run from lcore
+   * tasklet routine.
+   */
+  int (*notify_frame_done)(void* priv, struct st40_anc_frame* frame);
+
+  /**
+   * Optional. tx destination mac address.
+   * Valid if ST40P_TX_FLAG_USER_P(R)_MAC is enabled
+   */
+  uint8_t tx_dst_mac[MTL_SESSION_PORT_MAX][MTL_MAC_ADDR_LEN];
+};
+
+/** The structure describing how to create a rx st2110-40 pipeline session. */
+struct st40p_rx_ops {
+  /** Mandatory. rx port info */
+  struct st_rx_port port;
+  /**
+   * Mandatory. the frame buffer count requested for one st40 pipeline rx session,
+   * should be at least 2.
+   */
+  uint16_t framebuff_cnt;
+
+  /** Optional. name */
+  const char* name;
+  /** Optional. private data to the callback function */
+  void* priv;
+  /** Optional. Flags to control session behaviors. See ST40P_RX_FLAG_* for possible value
+   */
+  uint32_t flags;
+  /**
+   * Callback when frame available in the lib, mandatory if neither
+   * ST40P_RX_FLAG_BLOCK_GET nor ST40P_RX_FLAG_EVENT_FD is set.
+   * And only non-block method can be used within this callback as it run from lcore
+   * tasklet routine.
+   */
+  int (*notify_frame_available)(void* priv);
+  /**
+   * Optional. The frame in assembling is delivered if no more packet of it arrives
+   * within this time in us, for the case the marker packet is lost and no new timestamp
+   * follows. 0 means the default ST40P_RX_ASSEMBLE_TIMEOUT_US.
+   */
+  uint32_t assemble_timeout_us;
+};
+
+/**
+ * Create one tx st2110-40 pipeline session.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param ops
+ *   The pointer to the structure describing how to create a tx
+ * st2110-40 pipeline session.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the tx st2110-40 pipeline session.
+ */
+st40p_tx_handle st40p_tx_create(mtl_handle mt, struct st40p_tx_ops* ops);
+
+/**
+ * Free the tx st2110-40 pipeline session.
+ *
+ * @param handle
+ *   The handle to the tx st2110-40 pipeline session.
+ * @return
+ *   - 0: Success, tx st2110-40 pipeline session freed.
+ *   - <0: Error code of the tx st2110-40 pipeline session free.
+ */
+int st40p_tx_free(st40p_tx_handle handle);
+
+/**
+ * Get one tx frame from the tx st2110-40 pipeline session.
+ * Call st40p_tx_put_frame to return the frame to session.
+ *
+ * @param handle
+ *   The handle to the tx st2110-40 pipeline session.
+ * @return
+ *   - NULL if no available frame in the session.
+ *   - Otherwise, the frame pointer.
+ */
+struct st40_anc_frame* st40p_tx_get_frame(st40p_tx_handle handle);
+
+/**
+ * Put back the frame which get by st40p_tx_get_frame to the tx
+ * st2110-40 pipeline session, lib add the parity bits and checksum for each packet.
+ *
+ * @param handle
+ *   The handle to the tx st2110-40 pipeline session.
+ * @param frame
+ *   the frame pointer by st40p_tx_get_frame.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st40p_tx_put_frame(st40p_tx_handle handle, struct st40_anc_frame* frame);
+
+/**
+ * Wake up the thread blocked in st40p_tx_get_frame, only for ST40P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-40 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st40p_tx_wake_block(st40p_tx_handle handle);
+
+/**
+ * Set the timeout of the block st40p_tx_get_frame, only for ST40P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-40 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st40p_tx_set_block_timeout(st40p_tx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the tx st2110-40 pipeline session, only for ST40P_TX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st40p_tx_free.
+ *
+ * @param handle
+ *   The handle to the tx st2110-40 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st40p_tx_get_event_fd(st40p_tx_handle handle);
+
+/**
+ * Create one rx st2110-40 pipeline session.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param ops
+ *   The pointer to the structure describing how to create a rx
+ * st2110-40 pipeline session.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the rx st2110-40 pipeline session.
+ */
+st40p_rx_handle st40p_rx_create(mtl_handle mt, struct st40p_rx_ops* ops);
+
+/**
+ * Free the rx st2110-40 pipeline session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40 pipeline session.
+ * @return
+ *   - 0: Success, rx st2110-40 pipeline session freed.
+ *   - <0: Error code of the rx st2110-40 pipeline session free.
+ */
+int st40p_rx_free(st40p_rx_handle handle);
+
+/**
+ * Get one rx frame from the rx st2110-40 pipeline session, the ANC data packets with
+ * parity or checksum error are dropped by lib.
+ * Call st40p_rx_put_frame to return the frame to session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40 pipeline session.
+ * @return
+ *   - NULL if no available frame in the session.
+ *   - Otherwise, the frame pointer.
+ */
+struct st40_anc_frame* st40p_rx_get_frame(st40p_rx_handle handle);
+
+/**
+ * Put back the frame which get by st40p_rx_get_frame to the rx
+ * st2110-40 pipeline session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40 pipeline session.
+ * @param frame
+ *   the frame pointer by st40p_rx_get_frame.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st40p_rx_put_frame(st40p_rx_handle handle, struct st40_anc_frame* frame);
+
+/**
+ * Wake up the thread blocked in st40p_rx_get_frame, only for ST40P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st40p_rx_wake_block(st40p_rx_handle handle);
+
+/**
+ * Set the timeout of the block st40p_rx_get_frame, only for ST40P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st40p_rx_set_block_timeout(st40p_rx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the rx st2110-40 pipeline session, only for ST40P_RX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st40p_rx_free.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st40p_rx_get_event_fd(st40p_rx_handle handle);
+
+/**
+ * Get the queue meta attached to rx st2110-40 pipeline session.
+ *
+ * @param handle
+ *   The handle to the rx st2110-40 pipeline session.
+ * @param meta
+ *   the rx queue meta info.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st40p_rx_get_queue_meta(st40p_rx_handle handle, struct st_queue_meta* meta);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -198,6 +198,14 @@ enum st_frame_fmt {
 #define ST_FMT_CAP_UYVY (MTL_BIT64(ST_FRAME_FMT_UYVY))
 /** ST format cap of ST_FRAME_FMT_YUV422RFC4175PG2BE10 */
 #define ST_FMT_CAP_YUV422RFC4175PG2BE10 (MTL_BIT64(ST_FRAME_FMT_YUV422RFC4175PG2BE10))
+/** ST format cap of ST_FRAME_FMT_YUV422PLANAR12LE */
+#define ST_FMT_CAP_YUV422PLANAR12LE (MTL_BIT64(ST_FRAME_FMT_YUV422PLANAR12LE))
+/** ST format cap of ST_FRAME_FMT_YUV444PLANAR10LE */
+#define ST_FMT_CAP_YUV444PLANAR10LE (MTL_BIT64(ST_FRAME_FMT_YUV444PLANAR10LE))
+/** ST format cap of ST_FRAME_FMT_YUV444PLANAR12LE */
+#define ST_FMT_CAP_YUV444PLANAR12LE (MTL_BIT64(ST_FRAME_FMT_YUV444PLANAR12LE))
+/** ST format cap of ST_FRAME_FMT_YUV420CUSTOM8 */
+#define ST_FMT_CAP_YUV420CUSTOM8 (MTL_BIT64(ST_FRAME_FMT_YUV420CUSTOM8))
 
 /** ST format cap of ST_FRAME_FMT_ARGB */
 #define ST_FMT_CAP_ARGB (MTL_BIT64(ST_FRAME_FMT_ARGB))
@@ -205,6 +213,10 @@ enum st_frame_fmt {
 #define ST_FMT_CAP_BGRA (MTL_BIT64(ST_FRAME_FMT_BGRA))
 /** ST format cap of ST_FRAME_FMT_RGB8 */
 #define ST_FMT_CAP_RGB8 (MTL_BIT64(ST_FRAME_FMT_RGB8))
+/** ST format cap of ST_FRAME_FMT_GBRPLANAR10LE */
+#define ST_FMT_CAP_GBRPLANAR10LE (MTL_BIT64(ST_FRAME_FMT_GBRPLANAR10LE))
+/** ST format cap of ST_FRAME_FMT_GBRPLANAR12LE */
+#define ST_FMT_CAP_GBRPLANAR12LE (MTL_BIT64(ST_FRAME_FMT_GBRPLANAR12LE))
 
 /** ST format cap of ST_FRAME_FMT_JPEGXS_CODESTREAM, used in the st22_plugin caps */
 #define ST_FMT_CAP_JPEGXS_CODESTREAM (MTL_BIT64(ST_FRAME_FMT_JPEGXS_CODESTREAM))
@@ -224,7 +236,10 @@ enum st_frame_fmt {
 struct st_ext_frame {
   /** Each plane's virtual address of external frame */
   void* addr[ST_MAX_PLANES];
-  /** Each plane's IOVA of external frame */
+  /**
+   * Each plane's IOVA of external frame. For st20p tx in derive mode, 0 let the lib map
+   * the buffer on the first use and cache the mapping for the next frames.
+   */
   mtl_iova_t iova[ST_MAX_PLANES];
   /** Each plane's linesize of external frame,
    * if no padding, can be calculated from st_frame_least_linesize */
@@ -235,6 +250,18 @@ struct st_ext_frame {
   void* opaque;
 };
 
+/** Color matrix of the RGB <-> YUV frame convert */
+enum st_frame_color_matrix {
+  /** ITU-R BT.709, the default */
+  ST_FRAME_COLOR_MATRIX_BT709 = 0,
+  /** ITU-R BT.601 */
+  ST_FRAME_COLOR_MATRIX_BT601,
+  /** ITU-R BT.2020 non-constant luminance */
+  ST_FRAME_COLOR_MATRIX_BT2020,
+  /** max value of this enum */
+  ST_FRAME_COLOR_MATRIX_MAX,
+};
+
 /** The structure info for frame meta. */
 struct st_frame {
   /** frame buffer address of each plane */
@@ -284,6 +311,14 @@ struct st_frame {
   void* priv;
   /** priv data for user */
   void* opaque;
+
+  /**
+   * color matrix of the YUV data, the RGB <-> YUV convert reads it from the YUV side
+   * frame. Zero is BT.709.
+   */
+  enum st_frame_color_matrix color_matrix;
+  /** the YUV data is full range or narrow(video) range, for the RGB <-> YUV convert */
+  bool color_full_range;
 };
 
 /** Device type of st plugin */
@@ -367,6 +402,29 @@ enum st22_quality_mode {
  * performance since the object enqueue/dequeue will be acted one by one.
  */
 #define ST22P_TX_FLAG_DISABLE_BULK (MTL_BIT32(7))
+/**
+ * Flag bit in flags of struct st22p_tx_ops.
+ * If enabled, st22p_tx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st22p_tx_set_block_timeout.
+ * st22p_tx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST22P_TX_FLAG_BLOCK_GET (MTL_BIT32(8))
+/**
+ * Flag bit in flags of struct st22p_tx_ops.
+ * If enabled, lib create one eventfd which can be get by st22p_tx_get_event_fd, it's
+ * signalled when any frame is free for st22p_tx_get_frame. Only one write happens until
+ * the next st22p_tx_get_frame call, app should call st22p_tx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST22P_TX_FLAG_EVENT_FD (MTL_BIT32(9))
+/**
+ * Flag bit in flags of struct st22p_tx_ops.
+ * Enable the slice level mode, app publish the ready lines of a frame by
+ * st22p_tx_put_frame_lines. If the encoder supports slice, it encodes the lines as they
+ * get ready and the transport sends the codestream once the first bytes are ready.
+ * Otherwise the frame is encoded once all lines ready.
+ */
+#define ST22P_TX_FLAG_SLICE_LEVEL (MTL_BIT32(10))
 
 /**
  * Flag bit in flags of struct st20p_tx_ops.
@@ -424,6 +482,47 @@ enum st22_quality_mode {
  * performance since the object enqueue/dequeue will be acted one by one.
  */
 #define ST20P_TX_FLAG_DISABLE_BULK (MTL_BIT32(9))
+/**
+ * Flag bit in flags of struct st20p_tx_ops.
+ * Enable the slice level mode, app publish the ready lines of a frame by
+ * st20p_tx_put_frame_lines, lib converts the lines per slice and start the transmission
+ * once the first slice is ready. Only for progressive and non ext frame mode, the
+ * converting is done by the internal converter.
+ */
+#define ST20P_TX_FLAG_SLICE_LEVEL (MTL_BIT32(10))
+/**
+ * Flag bit in flags of struct st20p_tx_ops.
+ * If enabled, st20p_tx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st20p_tx_set_block_timeout.
+ * st20p_tx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST20P_TX_FLAG_BLOCK_GET (MTL_BIT32(11))
+/**
+ * Flag bit in flags of struct st20p_tx_ops.
+ * If enabled, lib create one eventfd which can be get by st20p_tx_get_event_fd, it's
+ * signalled when any frame is free for st20p_tx_get_frame. Only one write happens until
+ * the next st20p_tx_get_frame call, app should call st20p_tx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST20P_TX_FLAG_EVENT_FD (MTL_BIT32(12))
+/**
+ * Flag bit in flags of struct st20p_tx_ops.
+ * Pin each internal convert worker thread to one lcore got from the lcores list of
+ * mtl_init_params. Only valid when convert_worker_cnt is set.
+ */
+#define ST20P_TX_FLAG_CONVERT_WORKER_LCORE (MTL_BIT32(13))
+/**
+ * Flag bit in flags of struct st20p_tx_ops.
+ * Only used for internal convert mode and limited formats:
+ * ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210 or ST_FRAME_FMT_V210 to
+ * ST20_FMT_YUV_422_10BIT.
+ * ST_FRAME_FMT_YUV422PLANAR12LE to ST20_FMT_YUV_422_12BIT.
+ * ST_FRAME_FMT_YUV444PLANAR10LE/12LE to ST20_FMT_YUV_444_10BIT/12BIT.
+ * ST_FRAME_FMT_GBRPLANAR10LE/12LE to ST20_FMT_RGB_10BIT/12BIT.
+ * Perform the color format conversion on each packet from the user frame to the payload,
+ * no transport framebuffer convert. Not support ST20P_TX_FLAG_SLICE_LEVEL.
+ */
+#define ST20P_TX_FLAG_PKT_CONVERT (MTL_BIT32(14))
 
 /**
  * Flag bit in flags of struct st22p_rx_ops, for non MTL_PMD_DPDK_USER.
@@ -441,6 +540,44 @@ enum st22_quality_mode {
  * If enable the rtcp.
  */
 #define ST22P_RX_FLAG_ENABLE_RTCP (MTL_BIT32(2))
+/**
+ * Flag bit in flags of struct st22p_rx_ops.
+ * If enabled, st22p_rx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st22p_rx_set_block_timeout.
+ * st22p_rx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST22P_RX_FLAG_BLOCK_GET (MTL_BIT32(3))
+/**
+ * Flag bit in flags of struct st22p_rx_ops.
+ * If enabled, lib create one eventfd which can be get by st22p_rx_get_event_fd, it's
+ * signalled when any frame is ready for st22p_rx_get_frame. Only one write happens until
+ * the next st22p_rx_get_frame call, app should call st22p_rx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST22P_RX_FLAG_EVENT_FD (MTL_BIT32(4))
+/**
+ * Flag bit in flags of struct st22p_rx_ops.
+ * Enable the slice level mode, if the decoder supports slice, the codestream is passed
+ * to the decoder once the first slice arrived and the decoder gets the received bytes by
+ * st22_decoder_get_frame_bytes. Otherwise the frame is decoded once fully received.
+ */
+#define ST22P_RX_FLAG_SLICE_LEVEL (MTL_BIT32(5))
+/**
+ * Flag bit in flags of struct st22p_rx_ops.
+ * Pass the codestream to the decoder as the segments of the received packets without
+ * the copy into one contiguous buffer if the decoder supports it, the packets are held
+ * until the decoder put the frame. Can't be used with ST22P_RX_FLAG_SLICE_LEVEL.
+ */
+#define ST22P_RX_FLAG_CODESTREAM_SEGMENTS (MTL_BIT32(6))
+/**
+ * Flag bit in flags of struct st22p_rx_ops.
+ * Allow the decoder to change the layout of the dst frames, the decoder which writes
+ * into the dst frame directly may ask a linesize alignment and extra lines after each
+ * plane. The app should then use the linesize of each st_frame and st22p_rx_frame_size
+ * instead of the compact layout of the output_fmt. Without this flag the dst frames keep
+ * the compact layout and such a decoder copies the decoded picture into the dst.
+ */
+#define ST22P_RX_FLAG_DECODER_DST_LAYOUT (MTL_BIT32(7))
 /**
  * Flag bit in flags of struct st22p_rx_ops.
  * If set, lib will pass the incomplete frame to app also.
@@ -469,7 +606,11 @@ enum st22_quality_mode {
 /**
  * Flag bit in flags of struct st20p_rx_ops.
  * Only used for internal convert mode and limited formats:
- * ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210, ST_FRAME_FMT_UYVY
+ * ST20_FMT_YUV_422_10BIT to ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210,
+ * ST_FRAME_FMT_UYVY or ST_FRAME_FMT_V210.
+ * ST20_FMT_YUV_422_12BIT to ST_FRAME_FMT_YUV422PLANAR12LE.
+ * ST20_FMT_YUV_444_10BIT/12BIT to ST_FRAME_FMT_YUV444PLANAR10LE/12LE.
+ * ST20_FMT_RGB_10BIT/12BIT to ST_FRAME_FMT_GBRPLANAR10LE/12LE.
  * Perform the color format conversion on each packet.
  */
 #define ST20P_RX_FLAG_PKT_CONVERT (MTL_BIT32(3))
@@ -478,6 +619,27 @@ enum st22_quality_mode {
  * If enable the rtcp.
  */
 #define ST20P_RX_FLAG_ENABLE_RTCP (MTL_BIT32(4))
+/**
+ * Flag bit in flags of struct st20p_rx_ops.
+ * If enabled, st20p_rx_get_frame will be blocked until a frame is available or timeout,
+ * the default timeout is 1s and can be changed by st20p_rx_set_block_timeout.
+ * st20p_rx_wake_block can be used to wake up the blocked thread.
+ */
+#define ST20P_RX_FLAG_BLOCK_GET (MTL_BIT32(5))
+/**
+ * Flag bit in flags of struct st20p_rx_ops.
+ * If enabled, lib create one eventfd which can be get by st20p_rx_get_event_fd, it's
+ * signalled when any frame is ready for st20p_rx_get_frame. Only one write happens until
+ * the next st20p_rx_get_frame call, app should call st20p_rx_get_frame until NULL after
+ * the fd is readable.
+ */
+#define ST20P_RX_FLAG_EVENT_FD (MTL_BIT32(6))
+/**
+ * Flag bit in flags of struct st20p_rx_ops.
+ * Pin each internal convert worker thread to one lcore got from the lcores list of
+ * mtl_init_params. Only valid when convert_worker_cnt is set.
+ */
+#define ST20P_RX_FLAG_CONVERT_WORKER_LCORE (MTL_BIT32(7))
 /**
  * Flag bit in flags of struct st20p_rx_ops.
  * If set, lib will pass the incomplete frame to app also.
@@ -504,6 +666,11 @@ enum st22_quality_mode {
  */
 #define ST20P_RX_FLAG_DISABLE_MIGRATE (MTL_BIT32(20))
 
+/** Max lib worker threads of one st22 encoder/decoder dev */
+#define ST22_PLUGIN_MAX_WORKERS (32)
+/** Max frames of one batch call of st22 encoder/decoder dev */
+#define ST22_PLUGIN_MAX_BATCH (16)
+
 /** The structure info for st plugin encode session create request. */
 struct st22_encoder_create_req {
   /** codestream size required */
@@ -527,6 +694,28 @@ struct st22_encoder_create_req {
 
   /** max size for frame(encoded code stream), set by plugin */
   size_t max_codestream_size;
+
+  /** ST22P_TX_FLAG_SLICE_LEVEL enabled for the session, set by lib */
+  bool slice_level;
+  /**
+   * Set by plugin if slice_level and the encoder supports it. The frame is passed to
+   * the encoder once the first lines ready, the encoder gets the ready lines by
+   * st22_encoder_get_frame_lines and publishes the encoded bytes by
+   * st22_encoder_put_frame_bytes. The codestream size should be fixed to
+   * codestream_size(CBR) as the transport starts before the encoding finish, the lib
+   * pads the bytes after the dst data_size with zero.
+   */
+  bool slice_enabled;
+};
+
+/** The structure info for st22 encode frame meta. */
+struct st22_encode_frame_meta {
+  /** Encode source frame */
+  struct st_frame* src;
+  /** Encode dst frame */
+  struct st_frame* dst;
+  /** priv pointer for lib, do not touch this */
+  void* priv;
 };
 
 /** The structure info for st22 encoder dev. */
@@ -545,20 +734,40 @@ struct st22_encoder_dev {
   /** create session function */
   st22_encode_priv (*create_session)(void* priv, st22p_encode_session session_p,
                                      struct st22_encoder_create_req* req);
-  /** Callback when frame available in the lib. */
+  /**
+   * Callback when frame available in the lib.
+   * Not used if worker_cnt is set as the lib workers pull the frames.
+   */
   int (*notify_frame_available)(st22_encode_priv encode_priv);
   /** free session function */
   int (*free_session)(void* priv, st22_encode_priv encode_priv);
-};
 
-/** The structure info for st22 encode frame meta. */
-struct st22_encode_frame_meta {
-  /** Encode source frame */
-  struct st_frame* src;
-  /** Encode dst frame */
-  struct st_frame* dst;
-  /** priv pointer for lib, do not touch this */
-  void* priv;
+  /**
+   * Optional. The number of lib worker threads shared by all sessions of this dev, max
+   * ST22_PLUGIN_MAX_WORKERS. If set, the workers pull the frames from all sessions and
+   * call encode_frames, the frames are put back to each session in the original order
+   * even if the batches complete out of order. Zero means the plugin runs its own
+   * threads with st22_encoder_get_frame/st22_encoder_put_frame.
+   */
+  uint16_t worker_cnt;
+  /** Optional. The max frames of one encode_frames call, max ST22_PLUGIN_MAX_BATCH */
+  uint16_t batch_size;
+  /**
+   * Mandatory if worker_cnt is set. Encode a batch of frames, frames[i] is for session
+   * sessions[i] and the frames may come from different sessions. Set results[i] for
+   * each frame, < 0 means fail. It's called from the lib workers concurrently.
+   */
+  int (*encode_frames)(void* priv, st22_encode_priv* sessions,
+                       struct st22_encode_frame_meta** frames, int* results,
+                       uint16_t nb_frames);
+  /**
+   * Optional. Self benchmark of one format pair, return the frames per second the dev
+   * can encode at the resolution, <= 0 if not supported. The lib calls it on the first
+   * request of each format pair and resolution, without any lib lock held, and picks
+   * the fastest dev with spare capacity.
+   */
+  double (*benchmark)(void* priv, enum st_frame_fmt input_fmt,
+                      enum st_frame_fmt output_fmt, uint32_t width, uint32_t height);
 };
 
 /** The structure info for st plugin decode session create request. */
@@ -577,6 +786,55 @@ struct st22_decoder_create_req {
   uint16_t framebuff_cnt;
   /** thread count, set by lib */
   uint32_t codec_thread_cnt;
+
+  /**
+   * The linesize alignment in bytes of each planar dst frame plane, set by plugin.
+   * Optional, for the decoder which writes into the dst frame directly. Only applied if
+   * the app enabled ST22P_RX_FLAG_DECODER_DST_LAYOUT, the decoder should check the
+   * linesize of the dst frame.
+   */
+  uint32_t dst_linesize_align;
+  /**
+   * The extra lines after each planar dst frame plane, set by plugin. Optional, for the
+   * decoder which writes the whole aligned(macroblock) height into the dst frame. Only
+   * applied if the app enabled ST22P_RX_FLAG_DECODER_DST_LAYOUT.
+   */
+  uint32_t dst_pad_lines;
+
+  /** ST22P_RX_FLAG_SLICE_LEVEL enabled for the session, set by lib */
+  bool slice_level;
+  /**
+   * Set by plugin if slice_level and the decoder supports it. The frame is passed to
+   * the decoder once the first codestream slice arrived, the decoder gets the received
+   * bytes by st22_decoder_get_frame_bytes.
+   */
+  bool slice_enabled;
+
+  /** ST22P_RX_FLAG_CODESTREAM_SEGMENTS enabled for the session, set by lib */
+  bool codestream_segs;
+  /**
+   * Set by plugin if codestream_segs and the decoder can read the codestream from the
+   * src_segs of st22_decode_frame_meta, the src frame buffer is not filled then.
+   */
+  bool segs_enabled;
+};
+
+/** The structure info for st22 decode frame meta. */
+struct st22_decode_frame_meta {
+  /** Encode source frame */
+  struct st_frame* src;
+  /** Encode dst frame */
+  struct st_frame* dst;
+  /** priv pointer for lib, do not touch this */
+  void* priv;
+  /**
+   * The codestream segments of the src frame in packet order, only if segs_enabled by
+   * the decoder. A missing packet leaves a hole with NULL addr and 0 len, valid until
+   * the frame put.
+   */
+  struct st22_codestream_seg* src_segs;
+  /** The number of src_segs */
+  uint32_t src_segs_cnt;
 };
 
 /** The structure info for st22 decoder dev. */
@@ -595,20 +853,37 @@ struct st22_decoder_dev {
   /** create session function */
   st22_decode_priv (*create_session)(void* priv, st22p_decode_session session_p,
                                      struct st22_decoder_create_req* req);
-  /** Callback when frame available in the lib. */
+  /**
+   * Callback when frame available in the lib.
+   * Not used if worker_cnt is set as the lib workers pull the frames.
+   */
   int (*notify_frame_available)(st22_decode_priv decode_priv);
   /** free session function */
   int (*free_session)(void* priv, st22_decode_priv decode_priv);
-};
 
-/** The structure info for st22 decode frame meta. */
-struct st22_decode_frame_meta {
-  /** Encode source frame */
-  struct st_frame* src;
-  /** Encode dst frame */
-  struct st_frame* dst;
-  /** priv pointer for lib, do not touch this */
-  void* priv;
+  /**
+   * Optional. The number of lib worker threads shared by all sessions of this dev, max
+   * ST22_PLUGIN_MAX_WORKERS. Same as the worker_cnt of struct st22_encoder_dev.
+   */
+  uint16_t worker_cnt;
+  /** Optional. The max frames of one decode_frames call, max ST22_PLUGIN_MAX_BATCH */
+  uint16_t batch_size;
+  /**
+   * Mandatory if worker_cnt is set. Decode a batch of frames, frames[i] is for session
+   * sessions[i] and the frames may come from different sessions. Set results[i] for
+   * each frame, < 0 means fail. It's called from the lib workers concurrently.
+   */
+  int (*decode_frames)(void* priv, st22_decode_priv* sessions,
+                       struct st22_decode_frame_meta** frames, int* results,
+                       uint16_t nb_frames);
+  /**
+   * Optional. Self benchmark of one format pair, return the frames per second the dev
+   * can decode at the resolution, <= 0 if not supported. The lib calls it on the first
+   * request of each format pair and resolution, without any lib lock held, and picks
+   * the fastest dev with spare capacity.
+   */
+  double (*benchmark)(void* priv, enum st_frame_fmt input_fmt,
+                      enum st_frame_fmt output_fmt, uint32_t width, uint32_t height);
 };
 
 /** The structure info for st plugin convert session create request. */
@@ -647,6 +922,14 @@ struct st20_converter_dev {
   int (*notify_frame_available)(st20_convert_priv convert_priv);
   /** free session function */
   int (*free_session)(void* priv, st20_convert_priv convert_priv);
+  /**
+   * Optional. Self benchmark of one format pair, return the frames per second the dev
+   * can convert at the resolution, <= 0 if not supported. The lib calls it on the first
+   * request of each format pair and resolution, without any lib lock held, and picks
+   * the fastest dev with spare capacity.
+   */
+  double (*benchmark)(void* priv, enum st_frame_fmt input_fmt,
+                      enum st_frame_fmt output_fmt, uint32_t width, uint32_t height);
 };
 
 /** The structure info for st20 convert frame meta. */
@@ -659,6 +942,43 @@ struct st20_convert_frame_meta {
   void* priv;
 };
 
+/** Max number of stages for one st20 pipeline session */
+#define ST20P_STAGES_MAX (8)
+/** Max number of worker threads for one st20 pipeline stage */
+#define ST20P_STAGE_WORKERS_MAX (8)
+
+/**
+ * The structure describing one stage of the st20 pipeline frame processing graph.
+ * The stage gets the frame from the previous stage(the session for the first stage),
+ * processes it into one frame owned by the stage and passes it to the next stage.
+ */
+struct st20p_stage_ops {
+  /** Optional. name */
+  const char* name;
+  /** Optional. private data to the process callback */
+  void* priv;
+  /** Mandatory. The output frame format of this stage */
+  enum st_frame_fmt output_fmt;
+  /** Optional. The output resolution width, 0 means same as the input */
+  uint32_t width;
+  /** Optional. The output resolution height, 0 means same as the input */
+  uint32_t height;
+  /**
+   * Optional. The number of lib owned worker threads for this stage, in range
+   * [0, ST20P_STAGE_WORKERS_MAX], 0 means 1. The frames are processed in parallel if
+   * more than one worker, lib passes the output to the next stage in the input order.
+   */
+  uint8_t worker_cnt;
+  /** Optional. The output frame buffer count, 0 means same as the session */
+  uint16_t framebuff_cnt;
+  /**
+   * Mandatory. Process the src frame into the dst frame, called from the worker thread.
+   * The timestamp, status and user meta are passed to the dst by lib.
+   * Return < 0 to drop the frame.
+   */
+  int (*process)(void* priv, struct st_frame* src, struct st_frame* dst);
+};
+
 /** The structure info for st tx port, used in creating session. */
 struct st_tx_port {
   /** Mandatory. Destination IP address */
@@ -720,7 +1040,8 @@ struct st20p_tx_ops {
    */
   uint32_t flags;
   /**
-   * Optional.Callback when frame available in the lib.
+   * Callback when frame available in the lib, mandatory if neither
+   * ST20P_TX_FLAG_BLOCK_GET nor ST20P_TX_FLAG_EVENT_FD is set.
    * And only non-block method can be used within this callback as it run from lcore
    * tasklet routine.
    */
@@ -737,6 +1058,19 @@ struct st20p_tx_ops {
   size_t transport_linesize;
   /** Optional. Array of external frames */
   struct st_ext_frame* ext_frames;
+  /**
+   * Optional. Color matrix of the YUV frames for the RGB <-> YUV internal converter, the
+   * YUV side can be either the transport or the app frames. Zero is BT.709.
+   */
+  enum st_frame_color_matrix color_matrix;
+  /** Optional. The YUV frames are full range, for the RGB <-> YUV converter */
+  bool color_full_range;
+  /**
+   * Optional. The number of lib owned worker threads which run the internal converter
+   * once a frame is put, in range [0, 8]. Zero means convert in the put call.
+   * Only for the internal converter and not for the slice level mode.
+   */
+  uint8_t convert_worker_cnt;
 
   /**
    * Optional. tx destination mac address.
@@ -804,7 +1138,8 @@ struct st20p_rx_ops {
    */
   uint32_t flags;
   /**
-   * Optional. Callback when frame available in the lib.
+   * Callback when frame available in the lib, mandatory if neither
+   * ST20P_RX_FLAG_BLOCK_GET nor ST20P_RX_FLAG_EVENT_FD is set.
    * And only non-block method can be used within this callback as it run from lcore
    * tasklet routine.
    */
@@ -816,6 +1151,20 @@ struct st20p_rx_ops {
   size_t transport_linesize;
   /** Optional. Array of external frames */
   struct st_ext_frame* ext_frames;
+  /**
+   * Optional. Color matrix of the YUV frames for the RGB <-> YUV internal converter, the
+   * YUV side can be either the transport or the app frames. Zero is BT.709.
+   */
+  enum st_frame_color_matrix color_matrix;
+  /** Optional. The YUV frames are full range, for the RGB <-> YUV converter */
+  bool color_full_range;
+  /**
+   * Optional. The number of lib owned worker threads which run the internal converter
+   * once a frame is received, in range [0, 8]. Zero means convert in the get call.
+   * Only for the internal converter and not for st20p_rx_get_ext_frame. The frames are
+   * converted in parallel but always returned to the app in the received order.
+   */
+  uint8_t convert_worker_cnt;
   /**
    * Optional. Callback when the lib query next external frame's data address.
    * Only for non-convert mode with ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME.
@@ -831,6 +1180,26 @@ struct st20p_rx_ops {
    * Ex, cast to struct st10_vsync_meta for ST_EVENT_VSYNC.
    */
   int (*notify_event)(void* priv, enum st_event event, void* args);
+  /**
+   * Optional. The stages run in order on the output frame by the lib workers, the frame
+   * got by st20p_rx_get_frame is the output of the last stage then.
+   * Not for st20p_rx_get_ext_frame.
+   */
+  struct st20p_stage_ops* stages;
+  /** Optional. The number of stages, in range [0, ST20P_STAGES_MAX] */
+  uint8_t stages_cnt;
+  /**
+   * Optional. The decimation factor of the transport preview, see preview_scale in
+   * struct st20_rx_ops.
+   */
+  uint8_t preview_scale;
+  /** Optional. Deliver one preview every preview_interval frames, 0 means 1 */
+  uint16_t preview_interval;
+  /**
+   * Mandatory if preview_scale is set. The callback when one preview is ready.
+   * Only non-block method can be used in this callback as it run from lcore routine.
+   */
+  int (*notify_preview_ready)(void* priv, struct st20_rx_preview_meta* meta);
 };
 
 /** The structure describing how to create a tx st2110-22 pipeline session. */
@@ -871,7 +1240,8 @@ struct st22p_tx_ops {
   /** Optional. thread count for codec, leave to zero if not know */
   uint32_t codec_thread_cnt;
   /**
-   * Optional. Callback when frame available in the lib.
+   * Callback when frame available in the lib, mandatory if neither
+   * ST22P_TX_FLAG_BLOCK_GET nor ST22P_TX_FLAG_EVENT_FD is set.
    * And only non-block method can be used within this callback as it run from lcore
    * tasklet routine.
    */
@@ -935,7 +1305,8 @@ struct st22p_rx_ops {
   /** Optional. max codestream size, lib will use output frame size if not set */
   size_t max_codestream_size;
   /**
-   * Optional. Callback when frame available in the lib.
+   * Callback when frame available in the lib, mandatory if neither
+   * ST22P_RX_FLAG_BLOCK_GET nor ST22P_RX_FLAG_EVENT_FD is set.
    * And only non-block method can be used within this callback as it run from lcore
    * tasklet routine.
    */
@@ -1003,6 +1374,43 @@ struct st22_encode_frame_meta* st22_encoder_get_frame(st22p_encode_session sessi
 int st22_encoder_put_frame(st22p_encode_session session,
                            struct st22_encode_frame_meta* frame, int result);
 
+/**
+ * Get the ready lines of the src frame which get by st22_encoder_get_frame, only if
+ * slice_enabled is set by the plugin. The lines in [0, return value) are ready to
+ * encode, the src is complete once it reach the height.
+ *
+ * @param session
+ *   The handle to the tx st2110-22 pipeline session.
+ * @param frame
+ *   the frame pointer by st22_encoder_get_frame.
+ * @return
+ *   The number of lines ready from the top of the src frame.
+ */
+uint16_t st22_encoder_get_frame_lines(st22p_encode_session session,
+                                      struct st22_encode_frame_meta* frame);
+
+/**
+ * Publish the encoded bytes of the dst frame which get by st22_encoder_get_frame, only if
+ * slice_enabled is set by the plugin. The bytes in [0, bytes_ready) of the codestream
+ * are sent by the transport immediately, the first publish hands the frame to the
+ * transport. st22_encoder_put_frame should be called still once the encoding finish,
+ * the bytes from the dst data_size to the codestream_size(CBR) are padded with zero.
+ * If the encoding fails, all the bytes not published yet are padded with zero.
+ *
+ * @param session
+ *   The handle to the tx st2110-22 pipeline session.
+ * @param frame
+ *   the frame pointer by st22_encoder_get_frame.
+ * @param bytes_ready
+ *   The encoded bytes from the start of the codestream, should be increasing.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st22_encoder_put_frame_bytes(st22p_encode_session session,
+                                 struct st22_encode_frame_meta* frame,
+                                 size_t bytes_ready);
+
 /**
  * Register one st22 decoder.
  *
@@ -1057,6 +1465,57 @@ struct st22_decode_frame_meta* st22_decoder_get_frame(st22p_decode_session sessi
 int st22_decoder_put_frame(st22p_decode_session session,
                            struct st22_decode_frame_meta* frame, int result);
 
+/**
+ * Hold the dst of the frame which get by st22_decoder_get_frame, for the decoder which
+ * keeps reading the decoded picture as a reference after st22_decoder_put_frame. The
+ * session doesn't reuse the dst until st22_decoder_release_frame, the app can still get
+ * the decoded frame. Only valid before st22_decoder_put_frame.
+ *
+ * @param session
+ *   The handle to the rx st2110-22 pipeline session.
+ * @param frame
+ *   the frame pointer by st22_decoder_get_frame.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int st22_decoder_hold_frame(st22p_decode_session session,
+                            struct st22_decode_frame_meta* frame);
+
+/**
+ * Release the dst held by st22_decoder_hold_frame, it can be called after
+ * st22_decoder_put_frame and from any thread.
+ *
+ * @param session
+ *   The handle to the rx st2110-22 pipeline session.
+ * @param frame
+ *   the frame pointer by st22_decoder_get_frame.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if fail.
+ */
+int st22_decoder_release_frame(st22p_decode_session session,
+                               struct st22_decode_frame_meta* frame);
+
+/**
+ * Get the received bytes of the src codestream which get by st22_decoder_get_frame, only
+ * if slice_enabled is set by the plugin. The bytes in [0, return value) are ready to
+ * decode.
+ *
+ * @param session
+ *   The handle to the rx st2110-22 pipeline session.
+ * @param frame
+ *   the frame pointer by st22_decoder_get_frame.
+ * @param complete
+ *   Set to true if the frame is fully received(or ended with lost packets), the src
+ *   data_size and status are final then.
+ * @return
+ *   The received bytes from the start of the codestream.
+ */
+size_t st22_decoder_get_frame_bytes(st22p_decode_session session,
+                                    struct st22_decode_frame_meta* frame,
+                                    bool* complete);
+
 /**
  * Register one st20 converter.
  *
@@ -1200,6 +1659,27 @@ struct st_frame* st22p_tx_get_frame(st22p_tx_handle handle);
  */
 int st22p_tx_put_frame(st22p_tx_handle handle, struct st_frame* frame);
 
+/**
+ * Publish the ready lines of the frame which get by st22p_tx_get_frame to the tx
+ * st2110-22 pipeline session, only for ST22P_TX_FLAG_SLICE_LEVEL.
+ * The lines in [0, lines_ready) must be filled. The frame meta(timestamp) are copied on
+ * the first publish. The frame is returned to the session once lines_ready reach the
+ * height, app should not touch the frame after that. st22p_tx_put_frame is the same as
+ * publish all lines in the slice level mode.
+ *
+ * @param handle
+ *   The handle to the tx st2110-22 pipeline session.
+ * @param frame
+ *   The frame pointer by st22p_tx_get_frame.
+ * @param lines_ready
+ *   The number of lines ready from the top of the frame, should be increasing.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st22p_tx_put_frame_lines(st22p_tx_handle handle, struct st_frame* frame,
+                             uint16_t lines_ready);
+
 /**
  * Get the framebuffer pointer from the tx st2110-22 pipeline session.
  *
@@ -1223,6 +1703,42 @@ void* st22p_tx_get_fb_addr(st22p_tx_handle handle, uint16_t idx);
  */
 size_t st22p_tx_frame_size(st22p_tx_handle handle);
 
+/**
+ * Wake up the thread blocked in st22p_tx_get_frame, only for ST22P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-22 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st22p_tx_wake_block(st22p_tx_handle handle);
+
+/**
+ * Set the timeout of the block st22p_tx_get_frame, only for ST22P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-22 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st22p_tx_set_block_timeout(st22p_tx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the tx st2110-22 pipeline session, only for ST22P_TX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st22p_tx_free.
+ *
+ * @param handle
+ *   The handle to the tx st2110-22 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st22p_tx_get_event_fd(st22p_tx_handle handle);
+
 /**
  * Create one rx st2110-22 pipeline session.
  *
@@ -1297,6 +1813,42 @@ void* st22p_rx_get_fb_addr(st22p_rx_handle handle, uint16_t idx);
  */
 size_t st22p_rx_frame_size(st22p_rx_handle handle);
 
+/**
+ * Wake up the thread blocked in st22p_rx_get_frame, only for ST22P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-22 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st22p_rx_wake_block(st22p_rx_handle handle);
+
+/**
+ * Set the timeout of the block st22p_rx_get_frame, only for ST22P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-22 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st22p_rx_set_block_timeout(st22p_rx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the rx st2110-22 pipeline session, only for ST22P_RX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st22p_rx_free.
+ *
+ * @param handle
+ *   The handle to the rx st2110-22 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st22p_rx_get_event_fd(st22p_rx_handle handle);
+
 /**
  * Dump st2110-22 pipeline packets to pcapng file.
  *
@@ -1397,6 +1949,28 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame);
 int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
                            struct st_ext_frame* ext_frame);
 
+/**
+ * Publish the ready lines of the frame which get by st20p_tx_get_frame to the tx
+ * st2110-20 pipeline session, only for ST20P_TX_FLAG_SLICE_LEVEL.
+ * The lines in [0, lines_ready) must be filled, the new lines are converted and can be
+ * transmitted immediately. The frame meta(timestamp, user_meta) are copied on the first
+ * publish. The frame is returned to the session once lines_ready reach the height, app
+ * should not touch the frame after that. st20p_tx_put_frame is the same as publish all
+ * lines in the slice level mode.
+ *
+ * @param handle
+ *   The handle to the tx st2110-20 pipeline session.
+ * @param frame
+ *   The frame pointer by st20p_tx_get_frame.
+ * @param lines_ready
+ *   The number of lines ready from the top of the frame, should be increasing.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail, the new lines are not published if the convert fail.
+ */
+int st20p_tx_put_frame_lines(st20p_tx_handle handle, struct st_frame* frame,
+                             uint16_t lines_ready);
+
 /**
  * Get the framebuffer pointer from the tx st2110-20 pipeline session.
  *
@@ -1420,6 +1994,42 @@ void* st20p_tx_get_fb_addr(st20p_tx_handle handle, uint16_t idx);
  */
 size_t st20p_tx_frame_size(st20p_tx_handle handle);
 
+/**
+ * Wake up the thread blocked in st20p_tx_get_frame, only for ST20P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-20 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st20p_tx_wake_block(st20p_tx_handle handle);
+
+/**
+ * Set the timeout of the block st20p_tx_get_frame, only for ST20P_TX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the tx st2110-20 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st20p_tx_set_block_timeout(st20p_tx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the tx st2110-20 pipeline session, only for ST20P_TX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st20p_tx_free.
+ *
+ * @param handle
+ *   The handle to the tx st2110-20 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st20p_tx_get_event_fd(st20p_tx_handle handle);
+
 /**
  * Get the scheduler index for the tx st2110-20(pipeline) session.
  *
@@ -1550,6 +2160,42 @@ void* st20p_rx_get_fb_addr(st20p_rx_handle handle, uint16_t idx);
  */
 size_t st20p_rx_frame_size(st20p_rx_handle handle);
 
+/**
+ * Wake up the thread blocked in st20p_rx_get_frame, only for ST20P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-20 pipeline session.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st20p_rx_wake_block(st20p_rx_handle handle);
+
+/**
+ * Set the timeout of the block st20p_rx_get_frame, only for ST20P_RX_FLAG_BLOCK_GET.
+ *
+ * @param handle
+ *   The handle to the rx st2110-20 pipeline session.
+ * @param timedwait_ns
+ *   The timeout in ns.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code.
+ */
+int st20p_rx_set_block_timeout(st20p_rx_handle handle, uint64_t timedwait_ns);
+
+/**
+ * Get the eventfd of the rx st2110-20 pipeline session, only for ST20P_RX_FLAG_EVENT_FD.
+ * The fd can be used with poll/epoll, it's owned by the lib and closed in st20p_rx_free.
+ *
+ * @param handle
+ *   The handle to the rx st2110-20 pipeline session.
+ * @return
+ *   - >=0 the eventfd.
+ *   - <0: Error code.
+ */
+int st20p_rx_get_event_fd(st20p_rx_handle handle);
+
 /**
  * Dump st2110-20 pipeline packets to pcapng file.
  *
@@ -1624,6 +2270,11 @@ int st20p_rx_reset_port_stats(st20p_rx_handle handle, enum mtl_session_port port
 
 /**
  * Convert color format from source frame to destination frame.
+ * The frame is split into horizontal bands and converted in parallel if the band
+ * threads is set by st_frame_convert_set_threads.
+ * The RGB <-> YUV convert uses the color_matrix and color_full_range of the YUV side
+ * frame, the RGB side is always full range and 4:2:2 chroma is co-sited with the even
+ * pixels.
  *
  * @param src
  *   The source frame.
@@ -1635,6 +2286,41 @@ int st20p_rx_reset_port_stats(st20p_rx_handle handle, enum mtl_session_port port
  */
 int st_frame_convert(struct st_frame* src, struct st_frame* dst);
 
+/**
+ * Set the threads count used by st_frame_convert for the band parallel convert, include
+ * the caller thread. Default is 1 which means no band split, max is 8. The band pool is
+ * shared by all callers, the concurrent calls each work on their own bands and the pool
+ * threads help any call which still has bands left. Set back to 1 to release the pool
+ * threads, it waits for the calls in running.
+ *
+ * @param threads
+ *   The threads count.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_frame_convert_set_threads(uint8_t threads);
+
+/**
+ * Convert one horizontal band of the frame from source frame to destination frame, the
+ * app can run all the bands on its own workers. The band lines are aligned to keep the
+ * pixel group of the RFC4175 formats inside one band. Not support interlaced frame.
+ *
+ * @param src
+ *   The source frame.
+ * @param dst
+ *   The destination frame.
+ * @param band_idx
+ *   The band index, [0, band_cnt).
+ * @param band_cnt
+ *   The number of bands the frame split into.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_frame_convert_band(struct st_frame* src, struct st_frame* dst, uint32_t band_idx,
+                          uint32_t band_cnt);
+
 /**
  * Downsample frame size to destination frame.
  *
@@ -0,0 +1,173 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+/**
+ * @file st_rx_group_api.h
+ *
+ * Interfaces for the rx flow group of st2110 pipeline sessions.
+ * One group binds one st20 pipeline video session with several st30 pipeline audio
+ * and st40 pipeline ancillary sessions, it aligns the frames of all sessions by the RTP
+ * timestamp mapped to the PTP(TAI) time and hands one bundle per video frame.
+ *
+ */
+
+#include "st30_pipeline_api.h"
+#include "st40_pipeline_api.h"
+#include "st_pipeline_api.h"
+
+#ifndef _ST_RX_GROUP_API_HEAD_H_
+#define _ST_RX_GROUP_API_HEAD_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/** Handle to rx flow group of lib */
+typedef struct st_rx_group_ctx* st_rx_group_handle;
+
+/** Max number of st30 pipeline audio sessions in one rx flow group */
+#define ST_RX_GROUP_MAX_AUDIO (16)
+/** Max number of st40 pipeline ancillary sessions in one rx flow group */
+#define ST_RX_GROUP_MAX_ANC (4)
+/** Max number of audio frames of one audio session attached to one bundle */
+#define ST_RX_GROUP_MAX_AUDIO_FRAMES (8)
+/** Max number of ANC frames(fields) of one ancillary session attached to one bundle */
+#define ST_RX_GROUP_MAX_ANC_FRAMES (4)
+
+/** The audio frames of one st30 pipeline session attached to one bundle. */
+struct st_rx_group_audio {
+  /**
+   * the audio frames overlapping the video frame period, in timestamp order. The frame
+   * straddling the end of the period is also the first frame of the next bundle, it's
+   * put back to the session after both bundles are put.
+   */
+  struct st30_frame* frames[ST_RX_GROUP_MAX_AUDIO_FRAMES];
+  /** the number of frames */
+  uint16_t frame_cnt;
+  /** true if the audio frames cover the whole video frame period */
+  bool complete;
+};
+
+/** The ANC frames of one st40 pipeline session attached to one bundle. */
+struct st_rx_group_anc {
+  /** the ANC frames(fields) within the video frame period, in timestamp order */
+  struct st40_anc_frame* frames[ST_RX_GROUP_MAX_ANC_FRAMES];
+  /** the number of frames */
+  uint16_t frame_cnt;
+  /**
+   * true if the ANC frame(or the second field) of the video frame or a later ANC frame
+   * is received, no more for this bundle.
+   */
+  bool complete;
+};
+
+/** The bundle of all essences for one video frame of the rx flow group. */
+struct st_rx_group_bundle {
+  /** the video frame */
+  struct st_frame* video;
+  /** the start time of the video frame, in ns since the TAI epoch */
+  uint64_t tai;
+  /** the video frame period in ns */
+  uint64_t duration_ns;
+  /** the audio frames for each audio session, same order as st_rx_group_ops */
+  struct st_rx_group_audio audio[ST_RX_GROUP_MAX_AUDIO];
+  /** the number of audio sessions */
+  uint16_t audio_cnt;
+  /** the ANC frames for each ancillary session, same order as st_rx_group_ops */
+  struct st_rx_group_anc anc[ST_RX_GROUP_MAX_ANC];
+  /** the number of ancillary sessions */
+  uint16_t anc_cnt;
+  /**
+   * true if all audio and ANC sessions are complete, false if the bundle is handed out
+   * as the lateness tolerance expired.
+   */
+  bool complete;
+  /** private data for lib, user should not touch this */
+  void* priv;
+};
+
+/**
+ * The structure describing how to create a rx flow group.
+ * All sessions should be created by the app before the group and freed after the group,
+ * the frames of the sessions should only be got from the group after it's created.
+ */
+struct st_rx_group_ops {
+  /** Optional. name */
+  const char* name;
+  /** Mandatory. The st20 pipeline video session which drives the bundle */
+  st20p_rx_handle video;
+  /** Optional. The st30 pipeline audio sessions */
+  st30p_rx_handle audio[ST_RX_GROUP_MAX_AUDIO];
+  /** Optional. The number of audio sessions */
+  uint16_t audio_cnt;
+  /** Optional. The st40 pipeline ancillary sessions */
+  st40p_rx_handle anc[ST_RX_GROUP_MAX_ANC];
+  /** Optional. The number of ancillary sessions */
+  uint16_t anc_cnt;
+  /**
+   * Optional. How long in ns the bundle waits for the late audio/ANC frames after the
+   * video frame is received, the incomplete bundle is handed out once expired.
+   * Default(0) is one video frame period.
+   */
+  uint64_t lateness_ns;
+};
+
+/**
+ * Create one rx flow group.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param ops
+ *   The pointer to the structure describing how to create the rx flow group.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the rx flow group.
+ */
+st_rx_group_handle st_rx_group_create(mtl_handle mt, struct st_rx_group_ops* ops);
+
+/**
+ * Free the rx flow group, all frames held by the group are put back to the sessions.
+ * The bundles got by the app should be put back before the free.
+ *
+ * @param handle
+ *   The handle to the rx flow group.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_rx_group_free(st_rx_group_handle handle);
+
+/**
+ * Get one bundle from the rx flow group, it's not thread safe and should be called from
+ * one app thread. It returns NULL if no video frame is available or the current video
+ * frame is still waiting for the late audio/ANC frames, call it again later. It follows
+ * the ST20P_RX_FLAG_BLOCK_GET behavior of the video session for the video frame.
+ *
+ * @param handle
+ *   The handle to the rx flow group.
+ * @return
+ *   - NULL if no available bundle.
+ *   - Otherwise, the bundle pointer.
+ */
+struct st_rx_group_bundle* st_rx_group_get_bundle(st_rx_group_handle handle);
+
+/**
+ * Put back the bundle which get by st_rx_group_get_bundle, all the frames of the bundle
+ * are put back to the sessions.
+ *
+ * @param handle
+ *   The handle to the rx flow group.
+ * @param bundle
+ *   The bundle pointer by st_rx_group_get_bundle.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st_rx_group_put_bundle(st_rx_group_handle handle, struct st_rx_group_bundle* bundle);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -79,6 +79,18 @@ static const struct mt_dev_driver_info dev_drvs[] = {
         .drv_type = MT_DRV_MLX5,
         .flow_type = MT_FLOW_ALL,
     },
+    {
+        .name = "net_null", /* vdev without hw, for the tx pacing check */
+        .port_type = MT_PORT_PF,
+        .drv_type = MT_DRV_NULL,
+        .flow_type = MT_FLOW_NONE, /* no rte flow, rss only */
+    },
+    {
+        .name = "net_ring", /* vdev without hw, for the tx pacing check */
+        .port_type = MT_PORT_PF,
+        .drv_type = MT_DRV_RING,
+        .flow_type = MT_FLOW_ALL, /* same as the default, no rss on ring */
+    },
 };
 
 static int parse_driver_info(const char* driver, struct mt_dev_driver_info* drv_info) {
@@ -299,6 +311,13 @@ static void* dev_eal_init_thread(void* arg) {
   return NULL;
 }
 
+/* virtual device without hw, e.g. net_null and net_ring for pacing simulation */
+static bool dev_is_vdev(const char* port) {
+  if (!strncmp(port, "net_null", strlen("net_null"))) return true;
+  if (!strncmp(port, "net_ring", strlen("net_ring"))) return true;
+  return false;
+}
+
 static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_info) {
   char* argv[MT_EAL_MAX_ARGS];
   int argc, ret;
@@ -328,6 +347,8 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
     if (p->pmd[i] == MTL_PMD_DPDK_AF_XDP) {
       argv[argc] = "--vdev";
       has_afxdp = true;
+    } else if (dev_is_vdev(p->port[i])) {
+      argv[argc] = "--vdev";
     } else {
       argv[argc] = "-a";
       pci_ports++;
@@ -11,100 +11,431 @@ static inline struct mt_map_mgr* mt_get_map_mgr(struct mtl_main_impl* impl) {
   return &impl->map_mgr;
 }
 
-int mt_map_add(struct mtl_main_impl* impl, struct mt_map_item* item) {
-  struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
+/* binary search the item covering addr, items are sorted without overlap */
+static int map_find(struct mt_map_mgr* mgr, const void* addr) {
+  int low = 0, high = mgr->items_cnt - 1;
+  struct mt_map_item* item;
+
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    item = mgr->items[mid];
+    if (addr < item->vaddr)
+      high = mid - 1;
+    else if (addr >= RTE_PTR_ADD(item->vaddr, item->size))
+      low = mid + 1;
+    else
+      return mid;
+  }
+
+  return -1;
+}
+
+/* the first item which start after addr */
+static int map_insert_pos(struct mt_map_mgr* mgr, const void* addr) {
+  int low = 0, high = mgr->items_cnt;
+
+  while (low < high) {
+    int mid = (low + high) / 2;
+    if (mgr->items[mid]->vaddr <= addr)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
+/* caller should hold the mutex */
+static struct mt_map_item* map_insert(struct mtl_main_impl* impl, struct mt_map_mgr* mgr,
+                                      struct mt_map_item* item) {
   void* start = item->vaddr;
-  void* end = start + item->size;
+  void* end = RTE_PTR_ADD(start, item->size);
   struct mt_map_item* i_item;
-  void* i_start;
-  void* i_end;
   mtl_iova_t iova_base = 0x10000; /* assume user IOVA start from 1M */
   mtl_iova_t iova_end;
+  int pos;
 
-  mt_pthread_mutex_lock(&mgr->mutex);
+  if (mgr->items_cnt >= MT_MAP_MAX_ITEMS) {
+    err("%s, no space, all items are used\n", __func__);
+    return NULL;
+  }
 
-  /* first check if any conflict with exist mapping */
-  for (int i = 0; i < MT_MAP_MAX_ITEMS; i++) {
-    i_item = mgr->items[i];
-    if (!i_item) continue;
-    i_start = i_item->vaddr;
-    i_end = i_start + i_item->size;
-    if ((start >= i_start) && (start <= i_end)) {
-      err("%s, invalid start %p i_start %p i_end %p\n", __func__, start, i_start, i_end);
-      mt_pthread_mutex_unlock(&mgr->mutex);
-      return -EINVAL;
+  /* check if any conflict with the neighbours */
+  pos = map_insert_pos(mgr, start);
+  if (pos > 0) {
+    i_item = mgr->items[pos - 1];
+    if (start < RTE_PTR_ADD(i_item->vaddr, i_item->size)) {
+      err("%s, invalid start %p i_start %p i_size %" PRIu64 "\n", __func__, start,
+          i_item->vaddr, i_item->size);
+      return NULL;
     }
-    if ((end >= i_start) && (end <= i_end)) {
-      err("%s, invalid end %p i_start %p i_end %p\n", __func__, start, i_start, i_end);
-      mt_pthread_mutex_unlock(&mgr->mutex);
-      return -EINVAL;
+  }
+  if (pos < mgr->items_cnt) {
+    i_item = mgr->items[pos];
+    if (end > i_item->vaddr) {
+      err("%s, invalid end %p i_start %p i_size %" PRIu64 "\n", __func__, end,
+          i_item->vaddr, i_item->size);
+      return NULL;
     }
-    /* simply set iova_base to max iova in previous item */
-    iova_end = i_item->iova + i_item->size;
-    if (iova_end > iova_base) iova_base = iova_end;
-  }
-  item->iova = iova_base;
-
-  /* find empty slot and insert */
-  for (int i = 0; i < MT_MAP_MAX_ITEMS; i++) {
-    i_item = mgr->items[i];
-    if (i_item) continue;
-    i_item = mt_rte_zmalloc_socket(sizeof(*i_item), mt_socket_id(impl, MTL_PORT_P));
-    if (!i_item) {
-      err("%s, i_item malloc fail\n", __func__);
-      mt_pthread_mutex_unlock(&mgr->mutex);
-      return -EINVAL;
+  }
+
+  /* auto items use the va as iova, simply set iova_base to max iova of user items */
+  if (!item->auto_map) {
+    for (int i = 0; i < mgr->items_cnt; i++) {
+      i_item = mgr->items[i];
+      if (i_item->auto_map) continue;
+      iova_end = i_item->iova + i_item->size;
+      if (iova_end > iova_base) iova_base = iova_end;
     }
-    *i_item = *item;
-    mgr->items[i] = i_item;
-    mt_pthread_mutex_unlock(&mgr->mutex);
-    info("%s(%d), start %p end %p iova 0x%" PRIx64 "\n", __func__, i, start, end,
-         i_item->iova);
-    return 0;
+    item->iova = iova_base;
+  }
+
+  i_item = mt_rte_zmalloc_socket(sizeof(*i_item), mt_socket_id(impl, MTL_PORT_P));
+  if (!i_item) {
+    err("%s, i_item malloc fail\n", __func__);
+    return NULL;
+  }
+  *i_item = *item;
+
+  memmove(&mgr->items[pos + 1], &mgr->items[pos],
+          sizeof(*mgr->items) * (mgr->items_cnt - pos));
+  mgr->items[pos] = i_item;
+  mgr->items_cnt++;
+  if (i_item->auto_map) mgr->auto_cnt++;
+  info("%s(%d), start %p end %p iova 0x%" PRIx64 "%s\n", __func__, pos, start, end,
+       i_item->iova, i_item->auto_map ? " auto" : "");
+  return i_item;
+}
+
+/* caller should hold the mutex */
+static void map_delete(struct mt_map_mgr* mgr, int pos) {
+  struct mt_map_item* item = mgr->items[pos];
+
+  info("%s(%d), start %p size %" PRIu64 " iova 0x%" PRIx64 "\n", __func__, pos,
+       item->vaddr, item->size, item->iova);
+  if (item->auto_map) mgr->auto_cnt--;
+  mgr->items_cnt--;
+  memmove(&mgr->items[pos], &mgr->items[pos + 1],
+          sizeof(*mgr->items) * (mgr->items_cnt - pos));
+  mgr->items[mgr->items_cnt] = NULL;
+  mt_rte_free(item);
+}
+
+int mt_map_dma(struct mtl_main_impl* impl, void* vaddr, mtl_iova_t iova, size_t size) {
+  size_t page_size = mtl_page_size(impl);
+  int ret;
+
+  ret = rte_extmem_register(vaddr, size, NULL, 0, page_size);
+  if (ret < 0) {
+    err("%s, fail(%d,%s) to register extmem %p\n", __func__, ret, rte_strerror(rte_errno),
+        vaddr);
+    return ret;
+  }
+
+  /* only map for MTL_PORT_P now */
+  ret = rte_dev_dma_map(mt_port_device(impl, MTL_PORT_P), vaddr, iova, size);
+  if (ret < 0) {
+    err("%s, dma map fail(%d,%s) for add(%p,%" PRIu64 ")\n", __func__, ret,
+        rte_strerror(rte_errno), vaddr, size);
+    rte_extmem_unregister(vaddr, size);
+    return ret;
+  }
+
+  return 0;
+}
+
+int mt_unmap_dma(struct mtl_main_impl* impl, void* vaddr, mtl_iova_t iova, size_t size) {
+  int ret;
+
+  /* only unmap for MTL_PORT_P now */
+  ret = rte_dev_dma_unmap(mt_port_device(impl, MTL_PORT_P), vaddr, iova, size);
+  if (ret < 0) {
+    err("%s, dma unmap fail(%d,%s) for add(%p,%" PRIu64 ")\n", __func__, ret,
+        rte_strerror(rte_errno), vaddr, size);
+  }
+
+  rte_extmem_unregister(vaddr, size);
+  return ret;
+}
+
+/* caller should hold the mutex */
+static void map_auto_evict(struct mtl_main_impl* impl, struct mt_map_mgr* mgr, int pos) {
+  struct mt_map_item* item = mgr->items[pos];
+
+  mt_unmap_dma(impl, item->vaddr, item->iova, item->size);
+  map_delete(mgr, pos);
+}
+
+/* caller should hold the mutex, the first item which end after addr */
+static int map_first_after(struct mt_map_mgr* mgr, const void* addr) {
+  int pos = map_insert_pos(mgr, addr);
+  struct mt_map_item* item;
+
+  if (pos > 0) {
+    item = mgr->items[pos - 1];
+    if (RTE_PTR_ADD(item->vaddr, item->size) > addr) pos--;
   }
+  return pos;
+}
+
+/*
+ * caller should hold the mutex, drop one reference of the auto items in [start, end).
+ * The idle item is unmapped at once, the buffer may be freed and the same va reused by
+ * another allocation which must not hit the stale pages.
+ */
+static void map_auto_unref(struct mtl_main_impl* impl, struct mt_map_mgr* mgr,
+                           void* start, void* end) {
+  struct mt_map_item* item;
+
+  for (int i = map_first_after(mgr, start); i < mgr->items_cnt; i++) {
+    item = mgr->items[i];
+    if (item->vaddr >= end) break;
+    if (!item->auto_map || item->refcnt <= 0) continue;
+    item->refcnt--;
+    if (!item->refcnt) {
+      map_auto_evict(impl, mgr, i);
+      i--; /* the next item moved to i */
+    }
+  }
+}
+
+/* caller should hold the mutex, apply the puts deferred from the data path */
+static void map_put_drain(struct mtl_main_impl* impl, struct mt_map_mgr* mgr) {
+  void* range[2];
+
+  if (!mgr->put_ring) return;
+  while (rte_ring_sc_dequeue_bulk(mgr->put_ring, range, 2, NULL) == 2) {
+    map_auto_unref(impl, mgr, range[0], range[1]);
+    mgr->gets_inflight--;
+  }
+}
+
+int mt_map_add(struct mtl_main_impl* impl, struct mt_map_item* item) {
+  struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
+  struct mt_map_item* i_item;
 
-  err("%s, no space, all items are used\n", __func__);
+  mt_pthread_mutex_lock(&mgr->mutex);
+  item->auto_map = false;
+  item->refcnt = 0;
+  i_item = map_insert(impl, mgr, item);
   mt_pthread_mutex_unlock(&mgr->mutex);
-  return -EIO;
+  if (!i_item) return -EINVAL;
+
+  item->iova = i_item->iova;
+  return 0;
 }
 
 int mt_map_remove(struct mtl_main_impl* impl, struct mt_map_item* item) {
   struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
-  void* start = item->vaddr;
-  void* end = start + item->size;
   struct mt_map_item* i_item;
-  void* i_start;
-  void* i_end;
+  int pos;
 
   mt_pthread_mutex_lock(&mgr->mutex);
 
-  /* find slot and delete */
-  for (int i = 0; i < MT_MAP_MAX_ITEMS; i++) {
-    i_item = mgr->items[i];
-    if (!i_item) continue;
-    i_start = i_item->vaddr;
-    i_end = i_start + i_item->size;
-    if ((start == i_start) && (end == i_end) && (item->iova == i_item->iova)) {
-      info("%s(%d), start %p end %p iova 0x%" PRIx64 "\n", __func__, i, start, end,
-           i_item->iova);
-      mt_rte_free(i_item);
-      mgr->items[i] = NULL;
+  pos = map_find(mgr, item->vaddr);
+  if (pos >= 0) {
+    i_item = mgr->items[pos];
+    if ((item->vaddr == i_item->vaddr) && (item->size == i_item->size) &&
+        (item->iova == i_item->iova) && !i_item->auto_map) {
+      map_delete(mgr, pos);
       mt_pthread_mutex_unlock(&mgr->mutex);
       return 0;
     }
   }
 
-  err("%s, unknown items start %p end %p iova %" PRIx64 "\n", __func__, start, end,
-      item->iova);
+  err("%s, unknown items start %p size %" PRIu64 " iova %" PRIx64 "\n", __func__,
+      item->vaddr, item->size, item->iova);
   mt_pthread_mutex_unlock(&mgr->mutex);
   return -EIO;
 }
 
+mtl_iova_t mt_map_get(struct mtl_main_impl* impl, void* vaddr, size_t size) {
+  struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
+  size_t page_size = mtl_page_size(impl);
+  struct mt_map_item item;
+  struct mt_map_item* i_item;
+  mtl_iova_t iova;
+  int pos, ret;
+
+  mt_pthread_mutex_lock(&mgr->mutex);
+
+  map_put_drain(impl, mgr);
+
+  /* each get has one put, the put ring can hold all of them */
+  if (mgr->gets_inflight >= MT_MAP_MAX_GETS) {
+    err("%s, %d gets not put yet\n", __func__, mgr->gets_inflight);
+    mt_pthread_mutex_unlock(&mgr->mutex);
+    return MTL_BAD_IOVA;
+  }
+
+  /* hit in the user mapping of mtl_dma_map */
+  pos = map_find(mgr, vaddr);
+  if ((pos >= 0) && !mgr->items[pos]->auto_map) {
+    i_item = mgr->items[pos];
+    if (RTE_PTR_ADD(vaddr, size) > RTE_PTR_ADD(i_item->vaddr, i_item->size)) {
+      err("%s, %p(%" PRIu64 ") cross the end of mapping %p(%" PRIu64 ")\n", __func__,
+          vaddr, size, i_item->vaddr, i_item->size);
+      mt_pthread_mutex_unlock(&mgr->mutex);
+      return MTL_BAD_IOVA;
+    }
+    iova = i_item->iova + RTE_PTR_DIFF(vaddr, i_item->vaddr);
+    mgr->gets_inflight++;
+    mt_pthread_mutex_unlock(&mgr->mutex);
+    return iova;
+  }
+
+  if (pos < 0) {
+    /* the memory from dpdk hugepage already has iova */
+    const struct rte_memseg* ms = rte_mem_virt2memseg(vaddr, NULL);
+    if (ms && (ms->iova != RTE_BAD_IOVA)) {
+      mgr->gets_inflight++;
+      mt_pthread_mutex_unlock(&mgr->mutex);
+      return rte_mem_virt2iova(vaddr);
+    }
+
+    if (impl->iova_mode != RTE_IOVA_VA) {
+      err("%s, invalid iova_mode %d for %p\n", __func__, impl->iova_mode, vaddr);
+      mt_pthread_mutex_unlock(&mgr->mutex);
+      return MTL_BAD_IOVA;
+    }
+  }
+
+  /*
+   * miss, map the pages covering the buffer. The pages already mapped by other buffers
+   * are shared with a reference, only the gaps are mapped. The auto items use the va
+   * as iova, so the buffer is contiguous in iova even it spans several items.
+   */
+  void* start = RTE_PTR_ALIGN_FLOOR(vaddr, page_size);
+  void* end = RTE_PTR_ALIGN_CEIL(RTE_PTR_ADD(vaddr, size), page_size);
+  void* cur;
+  int gaps = 0;
+
+  for (pos = map_first_after(mgr, start); pos < mgr->items_cnt; pos++) {
+    i_item = mgr->items[pos];
+    if (i_item->vaddr >= end) break;
+    if (!i_item->auto_map) {
+      err("%s, %p(%" PRIu64 ") overlap with the user mapping %p(%" PRIu64 ")\n",
+          __func__, vaddr, size, i_item->vaddr, i_item->size);
+      goto fail;
+    }
+  }
+  /* count the gaps to map */
+  cur = start;
+  for (pos = map_first_after(mgr, start); pos < mgr->items_cnt; pos++) {
+    i_item = mgr->items[pos];
+    if (i_item->vaddr >= end) break;
+    if (i_item->vaddr > cur) gaps++;
+    cur = RTE_PTR_ADD(i_item->vaddr, i_item->size);
+  }
+  if (cur < end) gaps++;
+
+  if ((mgr->auto_cnt + gaps > MT_MAP_MAX_AUTO_ITEMS) ||
+      (mgr->items_cnt + gaps > MT_MAP_MAX_ITEMS)) {
+    err("%s, no space for %d new items, auto %d all %d\n", __func__, gaps,
+        mgr->auto_cnt, mgr->items_cnt);
+    goto fail;
+  }
+
+  /* hold the shared items */
+  for (pos = map_first_after(mgr, start); pos < mgr->items_cnt; pos++) {
+    i_item = mgr->items[pos];
+    if (i_item->vaddr >= end) break;
+    i_item->refcnt++;
+  }
+
+  cur = start;
+  while (cur < end) {
+    void* gap_end = end;
+
+    pos = map_first_after(mgr, cur);
+    if (pos < mgr->items_cnt) {
+      i_item = mgr->items[pos];
+      if (i_item->vaddr <= cur) { /* shared, already hold */
+        cur = RTE_PTR_ADD(i_item->vaddr, i_item->size);
+        continue;
+      }
+      gap_end = RTE_MIN(end, i_item->vaddr);
+    }
+
+    memset(&item, 0, sizeof(item));
+    item.vaddr = cur;
+    item.size = RTE_PTR_DIFF(gap_end, cur);
+    item.iova = (mtl_iova_t)(uintptr_t)cur;
+    item.auto_map = true;
+    item.refcnt = 1;
+    i_item = map_insert(impl, mgr, &item);
+    if (!i_item) goto fail_unref;
+    ret = mt_map_dma(impl, i_item->vaddr, i_item->iova, i_item->size);
+    if (ret < 0) {
+      map_delete(mgr, map_find(mgr, i_item->vaddr));
+      goto fail_unref;
+    }
+    cur = gap_end;
+  }
+
+  iova = (mtl_iova_t)(uintptr_t)vaddr;
+  mgr->gets_inflight++;
+  mt_pthread_mutex_unlock(&mgr->mutex);
+  return iova;
+
+fail_unref:
+  map_auto_unref(impl, mgr, start, end);
+fail:
+  err("%s, map %p(%" PRIu64 ") fail\n", __func__, vaddr, size);
+  mt_pthread_mutex_unlock(&mgr->mutex);
+  return MTL_BAD_IOVA;
+}
+
+int mt_map_put(struct mtl_main_impl* impl, void* vaddr, size_t size) {
+  struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
+  void* range[2] = {vaddr, RTE_PTR_ADD(vaddr, size)};
+
+  /*
+   * called from the tasklet, defer to next mt_map_get or the stat thread to avoid the
+   * mutex. The ring is sized for all the gets inflight, never full.
+   */
+  if (rte_ring_mp_enqueue_bulk(mgr->put_ring, range, 2, NULL) != 2) {
+    err("%s, put ring full, drop the put of %p\n", __func__, vaddr);
+    rte_atomic32_inc(&mgr->stat_put_drop);
+    return -ENOSPC;
+  }
+
+  return 0;
+}
+
+static int map_stat(void* priv) {
+  struct mtl_main_impl* impl = priv;
+  struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
+  int drop = rte_atomic32_read(&mgr->stat_put_drop);
+
+  /* unmap the idle buffers which no more get after the put */
+  mt_pthread_mutex_lock(&mgr->mutex);
+  map_put_drain(impl, mgr);
+  mt_pthread_mutex_unlock(&mgr->mutex);
+
+  if (drop) {
+    notice("MAP: %d puts dropped\n", drop);
+    rte_atomic32_sub(&mgr->stat_put_drop, drop);
+  }
+  return 0;
+}
+
 int mt_map_init(struct mtl_main_impl* impl) {
   struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
 
   mt_pthread_mutex_init(&mgr->mutex, NULL);
 
+  /* multi-producer from the tasklets, single-consumer under the mutex */
+  mgr->put_ring = rte_ring_create("MT_MAP_PUT", MT_MAP_PUT_RING_SIZE,
+                                  mt_socket_id(impl, MTL_PORT_P), RING_F_SC_DEQ);
+  if (!mgr->put_ring) {
+    err("%s, put ring create fail\n", __func__);
+    mt_pthread_mutex_destroy(&mgr->mutex);
+    return -ENOMEM;
+  }
+  rte_atomic32_set(&mgr->stat_put_drop, 0);
+  mt_stat_register(impl, map_stat, impl, "map");
+
   return 0;
 }
 
@@ -112,12 +443,21 @@ int mt_map_uinit(struct mtl_main_impl* impl) {
   struct mt_map_mgr* mgr = mt_get_map_mgr(impl);
   struct mt_map_item* item;
 
-  for (int i = 0; i < MT_MAP_MAX_ITEMS; i++) {
+  mt_stat_unregister(impl, map_stat, impl);
+  map_put_drain(impl, mgr);
+  if (mgr->put_ring) {
+    rte_ring_free(mgr->put_ring);
+    mgr->put_ring = NULL;
+  }
+
+  for (int i = mgr->items_cnt - 1; i >= 0; i--) {
     item = mgr->items[i];
-    if (item) {
+    if (item->auto_map) {
+      if (item->refcnt) warn("%s(%d), auto %p still in use\n", __func__, i, item->vaddr);
+      map_auto_evict(impl, mgr, i);
+    } else {
       warn("%s(%d), still active, vaddr %p\n", __func__, i, item->vaddr);
-      mt_rte_free(item);
-      mgr->items[i] = NULL;
+      map_delete(mgr, i);
     }
   }
 
@@ -74,5 +74,17 @@ int mt_map_init(struct mtl_main_impl* impl);
 int mt_map_uinit(struct mtl_main_impl* impl);
 int mt_map_add(struct mtl_main_impl* impl, struct mt_map_item* item);
 int mt_map_remove(struct mtl_main_impl* impl, struct mt_map_item* item);
+int mt_map_dma(struct mtl_main_impl* impl, void* vaddr, mtl_iova_t iova, size_t size);
+int mt_unmap_dma(struct mtl_main_impl* impl, void* vaddr, mtl_iova_t iova, size_t size);
+/*
+ * get the iova of one ext buffer, map it on the first use and cache the mapping. The
+ * pages shared with the neighbour buffers are reference counted.
+ */
+mtl_iova_t mt_map_get(struct mtl_main_impl* impl, void* vaddr, size_t size);
+/*
+ * release the reference hold by mt_map_get with the same vaddr and size, lock free for
+ * the data path. The idle mapping is unmapped in the next mt_map_get or stat dump.
+ */
+int mt_map_put(struct mtl_main_impl* impl, void* vaddr, size_t size);
 
 #endif
@@ -28,6 +28,11 @@ enum mt_handle_type {
   MT_ST22_HANDLE_DEV_ENCODE = 27,
   MT_ST22_HANDLE_DEV_DECODE = 28,
   MT_ST20_HANDLE_DEV_CONVERT = 29,
+  MT_ST30_HANDLE_PIPELINE_TX = 30,
+  MT_ST30_HANDLE_PIPELINE_RX = 31,
+  MT_ST40_HANDLE_PIPELINE_TX = 32,
+  MT_ST40_HANDLE_PIPELINE_RX = 33,
+  MT_ST_HANDLE_RX_GROUP = 34,
 
   MT_HANDLE_UDMA = 40,
   MT_HANDLE_UDP = 41,
@@ -42,4 +47,10 @@ struct mt_udp_hdr {
   struct rte_udp_hdr udp;   /* size: 8 */
 } __attribute__((__packed__)) __rte_aligned(2);
 
+/* eventfd for the readiness notification, only one write until the consumer ack */
+struct mt_event_fd {
+  int fd;               /* -1 if not enabled */
+  rte_atomic32_t armed; /* one write is pending for the consumer, coalesce the writes */
+};
+
 #endif
@@ -762,28 +762,13 @@ mtl_iova_t mtl_dma_map(mtl_handle mt, const void* vaddr, size_t size) {
   if (ret < 0) return MTL_BAD_IOVA;
   iova = item.iova;
 
-  ret = rte_extmem_register((void*)vaddr, size, NULL, 0, page_size);
+  ret = mt_map_dma(impl, (void*)vaddr, iova, size);
   if (ret < 0) {
-    err("%s, fail(%d,%s) to register extmem %p\n", __func__, ret, rte_strerror(rte_errno),
-        vaddr);
-    goto fail_extmem;
-  }
-
-  /* only map for MTL_PORT_P now */
-  ret = rte_dev_dma_map(mt_port_device(impl, MTL_PORT_P), (void*)vaddr, iova, size);
-  if (ret < 0) {
-    err("%s, dma map fail(%d,%s) for add(%p,%" PRIu64 ")\n", __func__, ret,
-        rte_strerror(rte_errno), vaddr, size);
-    goto fail_map;
+    mt_map_remove(impl, &item);
+    return MTL_BAD_IOVA;
   }
 
   return iova;
-
-fail_map:
-  rte_extmem_unregister((void*)vaddr, size);
-fail_extmem:
-  mt_map_remove(impl, &item);
-  return MTL_BAD_IOVA;
 }
 
 int mtl_dma_unmap(mtl_handle mt, const void* vaddr, mtl_iova_t iova, size_t size) {
@@ -818,14 +803,7 @@ int mtl_dma_unmap(mtl_handle mt, const void* vaddr, mtl_iova_t iova, size_t size
   ret = mt_map_remove(impl, &item);
   if (ret < 0) return ret;
 
-  /* only unmap for MTL_PORT_P now */
-  ret = rte_dev_dma_unmap(mt_port_device(impl, MTL_PORT_P), (void*)vaddr, iova, size);
-  if (ret < 0) {
-    err("%s, dma unmap fail(%d,%s) for add(%p,%" PRIu64 ")\n", __func__, ret,
-        rte_strerror(rte_errno), vaddr, size);
-  }
-
-  rte_extmem_unregister((void*)vaddr, size);
+  mt_unmap_dma(impl, (void*)vaddr, iova, size);
 
   return 0;
 }
@@ -63,6 +63,12 @@
 #define MT_DMA_RTE_RING (1)
 
 #define MT_MAP_MAX_ITEMS (256)
+/* max items mapped automatically for the ext frames, unmapped once idle */
+#define MT_MAP_MAX_AUTO_ITEMS (64)
+/* the deferred mt_map_put from tasklets, each put takes 2 entries */
+#define MT_MAP_PUT_RING_SIZE (1024)
+/* max mt_map_get not put yet, so the put ring(size - 1 usable) never full */
+#define MT_MAP_MAX_GETS ((MT_MAP_PUT_RING_SIZE - 1) / 2)
 
 #define MT_IP_DONT_FRAGMENT_FLAG (0x0040)
 
@@ -134,6 +140,8 @@ enum mt_driver_type {
   MT_DRV_IGC,       /* igc, net_igc */
   MT_DRV_ENA,       /* aws ena, net_ena */
   MT_DRV_MLX5,      /* mlx, mlx5_pci */
+  MT_DRV_NULL,      /* null vdev, net_null */
+  MT_DRV_RING,      /* ring vdev, net_ring */
 };
 
 enum mt_flow_type {
@@ -739,11 +747,21 @@ struct mt_map_item {
   void* vaddr;
   size_t size;
   mtl_iova_t iova; /* iova address */
+  /* below for the mapping created by mt_map_get */
+  bool auto_map;
+  int refcnt; /* active users, protected by mutex of mgr */
 };
 
 struct mt_map_mgr {
   pthread_mutex_t mutex;
+  /* sorted by vaddr, no overlap between items, auto items are page aligned */
   struct mt_map_item* items[MT_MAP_MAX_ITEMS];
+  int items_cnt;
+  int auto_cnt;
+  /* the va ranges released by mt_map_put, applied in mt_map_get and the stat thread */
+  struct rte_ring* put_ring;
+  int gets_inflight; /* mt_map_get not drained by the put yet */
+  rte_atomic32_t stat_put_drop;
 };
 
 struct mt_var_params {
@@ -1096,6 +1114,13 @@ static inline bool mt_has_ebu(struct mtl_main_impl* impl) {
     return false;
 }
 
+static inline bool mt_has_tx_ebu(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_TX_VIDEO_EBU)
+    return true;
+  else
+    return false;
+}
+
 static inline bool mt_has_rxv_separate_sch(struct mtl_main_impl* impl) {
   if (mt_get_user_params(impl)->flags & MTL_FLAG_RX_SEPARATE_VIDEO_LCORE)
     return true;
@@ -1371,6 +1396,32 @@ static inline void mt_ns_to_timespec(uint64_t ns, struct timespec* ts) {
   ts->tv_nsec = ns % NS_PER_S;
 }
 
+/* init the cond with MT_THREAD_TIMEDWAIT_CLOCK_ID for mt_pthread_cond_timedwait_ns */
+static inline int mt_pthread_cond_wait_init(pthread_cond_t* cond) {
+#if MT_THREAD_TIMEDWAIT_CLOCK_ID != CLOCK_REALTIME
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, MT_THREAD_TIMEDWAIT_CLOCK_ID);
+  int ret = mt_pthread_cond_init(cond, &attr);
+  pthread_condattr_destroy(&attr);
+  return ret;
+#else
+  return mt_pthread_cond_init(cond, NULL);
+#endif
+}
+
+/* wait the cond with the relative timeout in ns, mutex should be locked by caller */
+static inline int mt_pthread_cond_timedwait_ns(pthread_cond_t* cond,
+                                               pthread_mutex_t* mutex,
+                                               uint64_t timedwait_ns) {
+  struct timespec time;
+  clock_gettime(MT_THREAD_TIMEDWAIT_CLOCK_ID, &time);
+  uint64_t ns = mt_timespec_to_ns(&time);
+  ns += timedwait_ns;
+  mt_ns_to_timespec(ns, &time);
+  return mt_pthread_cond_timedwait(cond, mutex, &time);
+}
+
 static inline int mt_wait_tsc_stable(struct mtl_main_impl* impl) {
   if (impl->tsc_cal_tid) {
     pthread_join(impl->tsc_cal_tid, NULL);
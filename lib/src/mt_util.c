@@ -7,6 +7,10 @@
 #include "mt_log.h"
 #include "mt_main.h"
 
+#ifndef WINDOWSENV
+#include <sys/eventfd.h>
+#endif
+
 #ifdef MTL_HAS_ASAN
 #include <execinfo.h>
 
@@ -793,3 +797,52 @@ uint16_t mt_random_port(uint16_t base_port) {
 
   return port;
 }
+
+int mt_event_fd_init(struct mt_event_fd* ev) {
+  rte_atomic32_set(&ev->armed, 0);
+#ifdef WINDOWSENV
+  ev->fd = -1;
+  err("%s, eventfd not support on windows\n", __func__);
+  return -ENOTSUP;
+#else
+  ev->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (ev->fd < 0) {
+    err("%s, eventfd create fail %d\n", __func__, errno);
+    return -EIO;
+  }
+  return 0;
+#endif
+}
+
+int mt_event_fd_uinit(struct mt_event_fd* ev) {
+  if (ev->fd >= 0) {
+    close(ev->fd);
+    ev->fd = -1;
+  }
+  return 0;
+}
+
+void mt_event_fd_notify(struct mt_event_fd* ev) {
+  uint64_t one = 1;
+
+  if (ev->fd < 0) return;
+  /* coalesce, the consumer is not waked up yet */
+  if (!rte_atomic32_test_and_set(&ev->armed)) return;
+  if (write(ev->fd, &one, sizeof(one)) != sizeof(one))
+    dbg("%s(%d), write fail %d\n", __func__, ev->fd, errno);
+}
+
+void mt_event_fd_ack(struct mt_event_fd* ev) {
+  uint64_t cnt;
+
+  if (ev->fd < 0) return;
+  /*
+   * always drain, the write of a notify may land after its armed is seen. Clear after
+   * the read, a notify in between is coalesced but the consumer checks the frames after
+   * the ack, any later notify writes again.
+   */
+  if (read(ev->fd, &cnt, sizeof(cnt)) != sizeof(cnt)) {
+    if (errno != EAGAIN) dbg("%s(%d), read fail %d\n", __func__, ev->fd, errno);
+  }
+  rte_atomic32_clear(&ev->armed);
+}
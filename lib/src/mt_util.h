@@ -194,6 +194,13 @@ uint16_t mt_random_port(uint16_t base_port);
 
 static inline const char* mt_string_safe(const char* msg) { return msg ? msg : "null"; }
 
+/* eventfd for the readiness notification, see struct mt_event_fd */
+int mt_event_fd_init(struct mt_event_fd* ev);
+int mt_event_fd_uinit(struct mt_event_fd* ev);
+void mt_event_fd_notify(struct mt_event_fd* ev);
+/* drain the eventfd, should be called before the consumer check the frames */
+void mt_event_fd_ack(struct mt_event_fd* ev);
+
 static inline void mt_mbuf_refcnt_inc_bulk(struct rte_mbuf** mbufs, uint16_t nb) {
   struct rte_mbuf* m = NULL;
   for (uint16_t i = 0; i < nb; i++) {
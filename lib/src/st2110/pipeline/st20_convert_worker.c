@@ -0,0 +1,248 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include "st20_convert_worker.h"
+
+#include "../../mt_dev.h"
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+
+/* get one frame with the seq assigned, the seq follows the frame order */
+static struct st20_convert_frame_meta* convert_worker_get_seq(
+    struct st20_convert_workers* workers, uint64_t* seq) {
+  struct st20_convert_workers_ops* ops = &workers->ops;
+  struct st20_convert_frame_meta* frame = NULL;
+
+  mt_pthread_mutex_lock(&workers->seq_lock);
+  /* never happen as the pipeline holds at most slot_cnt frames */
+  if ((workers->seq_get - workers->seq_put) < workers->slot_cnt) {
+    frame = ops->get_frame(ops->priv);
+    if (frame) *seq = workers->seq_get++;
+  }
+  mt_pthread_mutex_unlock(&workers->seq_lock);
+
+  return frame;
+}
+
+static struct st20_convert_frame_meta* convert_worker_get_frame(
+    struct st20_convert_workers* workers, uint64_t* seq) {
+  struct st20_convert_frame_meta* frame;
+
+  frame = convert_worker_get_seq(workers, seq);
+  if (frame) return frame;
+
+  mt_pthread_mutex_lock(&workers->lock);
+  /* check again with lock hold to not miss the wake */
+  frame = convert_worker_get_seq(workers, seq);
+  if (!frame && !rte_atomic32_read(&workers->stop)) {
+    mt_pthread_cond_timedwait_ns(&workers->wake_cond, &workers->lock,
+                                 ST_PIPELINE_BLOCK_TIMEOUT_NS);
+  }
+  mt_pthread_mutex_unlock(&workers->lock);
+
+  return frame;
+}
+
+/* put back the converted frames in the order of the get */
+static void convert_worker_put_frame(struct st20_convert_workers* workers, uint64_t seq,
+                                     struct st20_convert_frame_meta* frame, int result) {
+  struct st20_convert_workers_ops* ops = &workers->ops;
+  struct st20_convert_worker_slot* slot;
+
+  mt_pthread_mutex_lock(&workers->seq_lock);
+  if (seq != workers->seq_put) rte_atomic32_inc(&workers->stat_reorder);
+  slot = &workers->slots[seq % workers->slot_cnt];
+  slot->frame = frame;
+  slot->result = result;
+  slot->done = true;
+
+  while (workers->seq_put < workers->seq_get) {
+    slot = &workers->slots[workers->seq_put % workers->slot_cnt];
+    if (!slot->done) break;
+    ops->put_frame(ops->priv, slot->frame, slot->result);
+    slot->done = false;
+    slot->frame = NULL;
+    workers->seq_put++;
+  }
+  mt_pthread_mutex_unlock(&workers->seq_lock);
+}
+
+static void* convert_worker_thread(void* arg) {
+  struct st20_convert_worker* worker = arg;
+  struct st20_convert_workers* workers = worker->parent;
+  struct st20_convert_workers_ops* ops = &workers->ops;
+  struct st20_convert_frame_meta* frame;
+  uint64_t seq = 0;
+  int ret;
+
+  info("%s(%s,%d), start\n", __func__, workers->name, worker->idx);
+  while (!rte_atomic32_read(&workers->stop)) {
+    frame = convert_worker_get_frame(workers, &seq);
+    if (!frame) continue;
+
+    ret = ops->converter->convert_func(frame->src, frame->dst);
+    if (ret < 0) {
+      dbg("%s(%s,%d), convert fail %d\n", __func__, workers->name, worker->idx, ret);
+      rte_atomic32_inc(&workers->stat_convert_fail);
+    }
+    rte_atomic32_inc(&workers->stat_convert);
+    convert_worker_put_frame(workers, seq, frame, ret);
+  }
+  info("%s(%s,%d), stop\n", __func__, workers->name, worker->idx);
+
+  return NULL;
+}
+
+static int convert_worker_start(struct st20_convert_workers* workers,
+                                struct st20_convert_worker* worker) {
+  struct mtl_main_impl* impl = workers->impl;
+  int idx = worker->idx;
+  int ret;
+
+  ret = pthread_create(&worker->tid, NULL, convert_worker_thread, worker);
+  if (ret) {
+    err("%s(%s,%d), pthread_create fail %d\n", __func__, workers->name, idx, ret);
+    return -ret;
+  }
+  worker->started = true;
+
+  if (workers->ops.bind_lcore) {
+    ret = mt_dev_get_lcore(impl, &worker->lcore);
+    if (ret < 0) {
+      /* still work without the pinning */
+      warn("%s(%s,%d), get lcore fail %d\n", __func__, workers->name, idx, ret);
+      return 0;
+    }
+    worker->has_lcore = true;
+    mtl_bind_to_lcore(impl, worker->tid, worker->lcore);
+    info("%s(%s,%d), bind to lcore %u\n", __func__, workers->name, idx, worker->lcore);
+  }
+
+  return 0;
+}
+
+int st20_convert_workers_notify(struct st20_convert_workers* workers) {
+  /* wake up one idle worker */
+  mt_pthread_mutex_lock(&workers->lock);
+  mt_pthread_cond_signal(&workers->wake_cond);
+  mt_pthread_mutex_unlock(&workers->lock);
+  return 0;
+}
+
+static int convert_workers_stat(void* priv) {
+  struct st20_convert_workers* workers = priv;
+
+  int convert = rte_atomic32_read(&workers->stat_convert);
+  rte_atomic32_set(&workers->stat_convert, 0);
+  notice("%s(%s), %d workers convert %d frames\n", __func__, workers->name,
+         workers->worker_cnt, convert);
+
+  int convert_fail = rte_atomic32_read(&workers->stat_convert_fail);
+  rte_atomic32_set(&workers->stat_convert_fail, 0);
+  if (convert_fail) {
+    notice("%s(%s), convert fail %d\n", __func__, workers->name, convert_fail);
+  }
+
+  int reorder = rte_atomic32_read(&workers->stat_reorder);
+  rte_atomic32_set(&workers->stat_reorder, 0);
+  if (reorder) {
+    notice("%s(%s), reorder %d frames\n", __func__, workers->name, reorder);
+  }
+
+  return 0;
+}
+
+int st20_convert_workers_free(struct st20_convert_workers* workers) {
+  struct st20_convert_worker* worker;
+
+  if (workers->stat_registered) {
+    mt_stat_unregister(workers->impl, convert_workers_stat, workers);
+    workers->stat_registered = false;
+  }
+
+  rte_atomic32_set(&workers->stop, 1);
+  mt_pthread_mutex_lock(&workers->lock);
+  mt_pthread_cond_broadcast(&workers->wake_cond);
+  mt_pthread_mutex_unlock(&workers->lock);
+
+  for (uint8_t i = 0; i < workers->worker_cnt; i++) {
+    worker = &workers->workers[i];
+    if (worker->started) {
+      pthread_join(worker->tid, NULL);
+      worker->started = false;
+    }
+    if (worker->has_lcore) {
+      mt_dev_put_lcore(workers->impl, worker->lcore);
+      worker->has_lcore = false;
+    }
+  }
+
+  mt_pthread_mutex_destroy(&workers->lock);
+  mt_pthread_mutex_destroy(&workers->seq_lock);
+  mt_pthread_cond_destroy(&workers->wake_cond);
+  if (workers->slots) {
+    mt_rte_free(workers->slots);
+    workers->slots = NULL;
+  }
+  info("%s(%s), succ\n", __func__, workers->name);
+  mt_rte_free(workers);
+  return 0;
+}
+
+struct st20_convert_workers* st20_convert_workers_create(
+    struct mtl_main_impl* impl, struct st20_convert_workers_ops* ops) {
+  struct st20_convert_workers* workers;
+  int ret;
+
+  if (!ops->worker_cnt || ops->worker_cnt > ST20_CONVERT_WORKER_MAX) {
+    err("%s, invalid worker_cnt %u\n", __func__, ops->worker_cnt);
+    return NULL;
+  }
+  if (!ops->converter || !ops->get_frame || !ops->put_frame || !ops->frame_cnt) {
+    err("%s, invalid ops\n", __func__);
+    return NULL;
+  }
+
+  workers = mt_rte_zmalloc_socket(sizeof(*workers), mt_socket_id(impl, MTL_PORT_P));
+  if (!workers) {
+    err("%s, workers malloc fail\n", __func__);
+    return NULL;
+  }
+  workers->impl = impl;
+  workers->ops = *ops;
+  snprintf(workers->name, sizeof(workers->name), "%s", mt_string_safe(ops->name));
+  mt_pthread_mutex_init(&workers->lock, NULL);
+  mt_pthread_mutex_init(&workers->seq_lock, NULL);
+  mt_pthread_cond_wait_init(&workers->wake_cond);
+  rte_atomic32_set(&workers->stop, 0);
+  rte_atomic32_set(&workers->stat_convert, 0);
+  rte_atomic32_set(&workers->stat_convert_fail, 0);
+  rte_atomic32_set(&workers->stat_reorder, 0);
+
+  workers->slot_cnt = ops->frame_cnt;
+  workers->slots = mt_rte_zmalloc_socket(sizeof(*workers->slots) * workers->slot_cnt,
+                                         mt_socket_id(impl, MTL_PORT_P));
+  if (!workers->slots) {
+    err("%s(%s), slots malloc fail\n", __func__, workers->name);
+    st20_convert_workers_free(workers);
+    return NULL;
+  }
+
+  workers->worker_cnt = ops->worker_cnt;
+  for (uint8_t i = 0; i < workers->worker_cnt; i++) {
+    workers->workers[i].parent = workers;
+    workers->workers[i].idx = i;
+    ret = convert_worker_start(workers, &workers->workers[i]);
+    if (ret < 0) {
+      st20_convert_workers_free(workers);
+      return NULL;
+    }
+  }
+
+  mt_stat_register(impl, convert_workers_stat, workers, workers->name);
+  workers->stat_registered = true;
+
+  info("%s(%s), %u workers succ\n", __func__, workers->name, workers->worker_cnt);
+  return workers;
+}
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_ST20_CONVERT_WORKER_HEAD_H_
+#define _ST_LIB_PIPELINE_ST20_CONVERT_WORKER_HEAD_H_
+
+#include "../st_main.h"
+
+#define ST20_CONVERT_WORKER_MAX (8)
+
+struct st20_convert_workers_ops {
+  const char* name;
+  /* worker thread count, [1, ST20_CONVERT_WORKER_MAX] */
+  uint8_t worker_cnt;
+  /* pin each worker to one lcore from mt_dev_get_lcore */
+  bool bind_lcore;
+  /* the internal converter used by the workers */
+  struct st_frame_converter* converter;
+  /* max frames in converting, the put_frame follows the get_frame order */
+  uint16_t frame_cnt;
+
+  /* same as the convert plugin session callbacks, should be mt safe */
+  void* priv;
+  struct st20_convert_frame_meta* (*get_frame)(void* priv);
+  int (*put_frame)(void* priv, struct st20_convert_frame_meta* frame, int result);
+};
+
+struct st20_convert_workers;
+
+/* one converted frame waiting for the frames got before it */
+struct st20_convert_worker_slot {
+  struct st20_convert_frame_meta* frame;
+  int result;
+  bool done;
+};
+
+struct st20_convert_worker {
+  struct st20_convert_workers* parent;
+  int idx;
+  pthread_t tid;
+  bool started;
+  unsigned int lcore;
+  bool has_lcore;
+};
+
+struct st20_convert_workers {
+  struct mtl_main_impl* impl;
+  char name[ST_MAX_NAME_LEN];
+  struct st20_convert_workers_ops ops;
+
+  /* the workers wait on cond when no ready frame */
+  pthread_mutex_t lock;
+  pthread_cond_t wake_cond;
+  rte_atomic32_t stop;
+
+  /* the frames are put back in the order of the get, protected by seq_lock */
+  pthread_mutex_t seq_lock;
+  uint64_t seq_get;
+  uint64_t seq_put;
+  uint16_t slot_cnt;
+  struct st20_convert_worker_slot* slots;
+
+  uint8_t worker_cnt;
+  struct st20_convert_worker workers[ST20_CONVERT_WORKER_MAX];
+
+  rte_atomic32_t stat_convert;
+  rte_atomic32_t stat_convert_fail;
+  rte_atomic32_t stat_reorder;
+  bool stat_registered;
+};
+
+struct st20_convert_workers* st20_convert_workers_create(
+    struct mtl_main_impl* impl, struct st20_convert_workers_ops* ops);
+int st20_convert_workers_free(struct st20_convert_workers* workers);
+int st20_convert_workers_notify(struct st20_convert_workers* workers);
+
+#endif
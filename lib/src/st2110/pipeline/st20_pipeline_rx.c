@@ -6,104 +6,286 @@
 
 #include "../../mt_log.h"
 
-static const char* st20p_rx_frame_stat_name[ST20P_RX_FRAME_STATUS_MAX] = {
-    "free", "ready", "in_converting", "converted", "in_user",
-};
+static struct rte_ring* rx_st20p_ring_create(struct st20p_rx_ctx* ctx, const char* tag) {
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST20PRX%d_%s", ctx->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, ctx->framebuff_cnt,
+                         mt_socket_id(ctx->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%d), rte_ring_create %s fail\n", __func__, ctx->idx, ring_name);
+  return ring;
+}
 
-static const char* rx_st20p_stat_name(enum st20p_rx_frame_status stat) {
-  return st20p_rx_frame_stat_name[stat];
+/* move the frame to the desired state ring */
+static inline void rx_st20p_ring_put(struct rte_ring* ring,
+                                     struct st20p_rx_frame* framebuff,
+                                     enum st20p_rx_frame_status stat) {
+  framebuff->stat = stat;
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
 }
 
-static uint16_t rx_st20p_next_idx(struct st20p_rx_ctx* ctx, uint16_t idx) {
-  /* point to next */
-  uint16_t next_idx = idx;
-  next_idx++;
-  if (next_idx >= ctx->framebuff_cnt) next_idx = 0;
-  return next_idx;
+static inline struct st20p_rx_frame* rx_st20p_ring_get(struct rte_ring* ring) {
+  struct st20p_rx_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
 }
 
-static struct st20p_rx_frame* rx_st20p_next_available(
-    struct st20p_rx_ctx* ctx, uint16_t idx_start, enum st20p_rx_frame_status desired) {
-  uint16_t idx = idx_start;
+/* the frame which is filling by the packet convert for this timestamp */
+static struct st20p_rx_frame* rx_st20p_converting_frame(struct st20p_rx_ctx* ctx,
+                                                       uint64_t timestamp) {
   struct st20p_rx_frame* framebuff;
 
-  /* check ready frame from idx_start */
-  while (1) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == framebuff->stat) {
-      /* find one desired */
+  /* only the transport lcore touch the in converting frames, no lock needed */
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[i];
+    if (ST20P_RX_FRAME_IN_CONVERTING == framebuff->stat &&
+        framebuff->dst.timestamp == timestamp)
       return framebuff;
-    }
-    idx = rx_st20p_next_idx(ctx, idx);
-    if (idx == idx_start) {
-      /* loop all frames end */
-      break;
-    }
   }
 
-  /* no any desired frame */
   return NULL;
 }
 
+/* put back the in converting frames which never reached the frame ready */
+static void rx_st20p_converting_reclaim(struct st20p_rx_ctx* ctx) {
+  struct st20p_rx_frame* framebuff;
+  uint64_t cur_tsc = mt_get_tsc(ctx->impl);
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[i];
+    if (ST20P_RX_FRAME_IN_CONVERTING != framebuff->stat) continue;
+    if ((cur_tsc - framebuff->pkt_convert_tsc) < ctx->pkt_convert_timeout_ns) continue;
+    dbg("%s(%d), frame %u timeout\n", __func__, ctx->idx, i);
+    rx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_RX_FRAME_FREE);
+    rte_atomic32_inc(&ctx->stat_pkt_convert_timeout);
+  }
+}
+
+static void rx_st20p_block_wake(struct st20p_rx_ctx* ctx) {
+  /* order the frame enqueue before the waiters read */
+  rte_smp_mb();
+  /* only lock and signal when any block get is waiting */
+  if (!rte_atomic32_read(&ctx->block_waiters)) return;
+  mt_pthread_mutex_lock(&ctx->lock);
+  mt_pthread_cond_signal(&ctx->block_wake_cond);
+  mt_pthread_mutex_unlock(&ctx->lock);
+}
+
+static void rx_st20p_notify_user(struct st20p_rx_ctx* ctx) {
+  if (ctx->ops.notify_frame_available) { /* notify app */
+    ctx->ops.notify_frame_available(ctx->ops.priv);
+  }
+
+  if (ctx->block_get) rx_st20p_block_wake(ctx);
+
+  mt_event_fd_notify(&ctx->event);
+}
+
+static void rx_st20p_notify_frame_available(struct st20p_rx_ctx* ctx) {
+  /* the frame goes to the stages first */
+  if (ctx->graph) {
+    st20_stage_graph_notify(ctx->graph);
+    return;
+  }
+
+  rx_st20p_notify_user(ctx);
+}
+
+/* wait until any frame status change or timeout, ctx->lock should be locked */
+static void rx_st20p_block_wait(struct st20p_rx_ctx* ctx) {
+  dbg("%s(%d), start\n", __func__, ctx->idx);
+  mt_pthread_cond_timedwait_ns(&ctx->block_wake_cond, &ctx->lock, ctx->block_timeout_ns);
+  dbg("%s(%d), end\n", __func__, ctx->idx);
+}
+
+static struct st20p_rx_frame* rx_st20p_user_get(struct st20p_rx_ctx* ctx,
+                                                struct rte_ring* ring) {
+  struct st20p_rx_frame* framebuff = rx_st20p_ring_get(ring);
+
+  if (!framebuff && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    framebuff = rx_st20p_ring_get(ring);
+    if (!framebuff) {
+      rx_st20p_block_wait(ctx);
+      framebuff = rx_st20p_ring_get(ring);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
+    mt_pthread_mutex_unlock(&ctx->lock);
+  }
+
+  return framebuff;
+}
+
+/* the dst frame with the user meta, for the consumer of the output frame */
+static struct st_frame* rx_st20p_dst_frame(struct st20p_rx_frame* framebuff) {
+  struct st_frame* frame = &framebuff->dst;
+
+  if (framebuff->user_meta_data_size) {
+    frame->user_meta = framebuff->user_meta;
+    frame->user_meta_size = framebuff->user_meta_data_size;
+  } else {
+    frame->user_meta = NULL;
+    frame->user_meta_size = 0;
+  }
+  return frame;
+}
+
+/* the dst address in the plane for the pixel offset of the packet */
+static inline void* rx_st20p_pkt_dst(struct st_frame* dst, uint8_t plane, uint16_t row,
+                                     size_t offset_bytes) {
+  return (uint8_t*)dst->addr[plane] + dst->linesize[plane] * row + offset_bytes;
+}
+
+/* set the n-th 10 bits component of one v210 line, 3 components in one le32 word */
+static inline void rx_st20p_v210_set(uint32_t* words, uint32_t n, uint16_t val) {
+  uint32_t shift = (n % 3) * 10;
+  /* the last component also clears the 2 padding bits */
+  uint32_t mask = (shift == 20) ? 0xFFF00000 : (0x3FF << shift);
+  uint32_t word = rte_le_to_cpu_32(words[n / 3]);
+
+  word = (word & ~mask) | ((uint32_t)val << shift);
+  words[n / 3] = rte_cpu_to_le_32(word);
+}
+
+/* rfc4175 422 10 bit packet to v210 line, pg_offset is the pg index within the line */
+static int rx_st20p_pkt_to_v210(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* line,
+                                uint32_t pg_offset, uint32_t pg_cnt) {
+  /* 3 pgs(6 pixels) in one 16 bytes v210 block */
+  uint32_t head = RTE_MIN((3 - pg_offset % 3) % 3, pg_cnt);
+  uint32_t blocks = (pg_cnt - head) / 3;
+  uint32_t* words = (uint32_t*)line;
+  uint32_t n;
+  int ret;
+
+  /* the pgs not aligned to one v210 block are set by component */
+  for (uint32_t i = 0; i < pg_cnt; i++) {
+    if (i == head && blocks) i += blocks * 3;
+    if (i >= pg_cnt) break;
+    n = (pg_offset + i) * 4; /* v210 component order is same as pg2: Cb Y0 Cr Y1 */
+    rx_st20p_v210_set(words, n, (pg[i].Cb00 << 2) + pg[i].Cb00_);
+    rx_st20p_v210_set(words, n + 1, (pg[i].Y00 << 4) + pg[i].Y00_);
+    rx_st20p_v210_set(words, n + 2, (pg[i].Cr00 << 6) + pg[i].Cr00_);
+    rx_st20p_v210_set(words, n + 3, (pg[i].Y01 << 8) + pg[i].Y01_);
+  }
+
+  if (!blocks) return 0;
+  ret = st20_rfc4175_422be10_to_v210(&pg[head], line + (pg_offset + head) / 3 * 16,
+                                     blocks * 3, 2);
+  return ret;
+}
+
 static int rx_st20p_packet_convert(void* priv, void* frame,
                                    struct st20_rx_uframe_pg_meta* meta) {
   struct st20p_rx_ctx* ctx = priv;
   struct st20p_rx_frame* framebuff;
+  struct st_frame* dst;
+  uint16_t *y, *b, *r;
   int ret = 0;
-  struct st20_rfc4175_422_10_pg2_be* src = meta->payload;
-  mt_pthread_mutex_lock(&ctx->lock);
+  void* src = meta->payload;
+  uint16_t row = meta->row_number;
+  uint32_t offset = meta->row_offset; /* pixel offset in the line */
   if (meta->row_number == 0 && meta->row_offset == 0) {
     /* first packet of frame */
-    framebuff =
-        rx_st20p_next_available(ctx, ctx->framebuff_producer_idx, ST20P_RX_FRAME_FREE);
+    rx_st20p_converting_reclaim(ctx);
+    framebuff = rx_st20p_ring_get(ctx->free_ring);
     if (framebuff) {
-      framebuff->stat = ST20P_RX_FRAME_IN_CONVERTING;
       framebuff->dst.timestamp = meta->timestamp;
+      framebuff->pkt_convert_tsc = mt_get_tsc(ctx->impl);
+      framebuff->stat = ST20P_RX_FRAME_IN_CONVERTING;
     }
   } else {
-    framebuff = rx_st20p_next_available(ctx, ctx->framebuff_producer_idx,
-                                        ST20P_RX_FRAME_IN_CONVERTING);
-    if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-      dbg("%s(%d), not this frame, find next one\n", __func__, ctx->idx);
-      framebuff =
-          rx_st20p_next_available(ctx, framebuff->idx, ST20P_RX_FRAME_IN_CONVERTING);
-      if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-        /* should never happen */
-        err_once("%s(%d), wrong frame timestamp\n", __func__, ctx->idx);
-        mt_pthread_mutex_unlock(&ctx->lock);
-        return -EIO;
-      }
-    }
+    framebuff = rx_st20p_converting_frame(ctx, meta->timestamp);
   }
   if (!framebuff) {
     rte_atomic32_inc(&ctx->stat_busy);
-    mt_pthread_mutex_unlock(&ctx->lock);
     return -EBUSY;
   }
-  mt_pthread_mutex_unlock(&ctx->lock);
-  if (ctx->ops.output_fmt == ST_FRAME_FMT_YUV422PLANAR10LE) {
-    uint8_t* y = (uint8_t*)framebuff->dst.addr[0] +
-                 framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 2;
-    uint8_t* b = (uint8_t*)framebuff->dst.addr[1] +
-                 framebuff->dst.linesize[1] * meta->row_number + meta->row_offset;
-    uint8_t* r = (uint8_t*)framebuff->dst.addr[2] +
-                 framebuff->dst.linesize[2] * meta->row_number + meta->row_offset;
-    ret = st20_rfc4175_422be10_to_yuv422p10le(src, (uint16_t*)y, (uint16_t*)b,
-                                              (uint16_t*)r, meta->pg_cnt, 2);
-  } else if (ctx->ops.output_fmt == ST_FRAME_FMT_Y210) {
-    uint8_t* dst = (uint8_t*)framebuff->dst.addr[0] +
-                   framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 4;
-    ret = st20_rfc4175_422be10_to_y210(src, (uint16_t*)dst, meta->pg_cnt, 2);
-  } else if (ctx->ops.output_fmt == ST_FRAME_FMT_UYVY) {
-    uint8_t* dst = (uint8_t*)framebuff->dst.addr[0] +
-                   framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 2;
-    ret = st20_rfc4175_422be10_to_422le8(src, (struct st20_rfc4175_422_8_pg2_le*)dst,
-                                         meta->pg_cnt, 2);
+  dst = &framebuff->dst;
+
+  switch (ctx->ops.output_fmt) {
+    case ST_FRAME_FMT_YUV422PLANAR10LE:
+      y = rx_st20p_pkt_dst(dst, 0, row, offset * 2);
+      b = rx_st20p_pkt_dst(dst, 1, row, offset);
+      r = rx_st20p_pkt_dst(dst, 2, row, offset);
+      ret = st20_rfc4175_422be10_to_yuv422p10le(src, y, b, r, meta->pg_cnt, 2);
+      break;
+    case ST_FRAME_FMT_Y210:
+      y = rx_st20p_pkt_dst(dst, 0, row, offset * 4);
+      ret = st20_rfc4175_422be10_to_y210(src, y, meta->pg_cnt, 2);
+      break;
+    case ST_FRAME_FMT_UYVY:
+      ret = st20_rfc4175_422be10_to_422le8(src, rx_st20p_pkt_dst(dst, 0, row, offset * 2),
+                                           meta->pg_cnt, 2);
+      break;
+    case ST_FRAME_FMT_V210:
+      ret = rx_st20p_pkt_to_v210(src, rx_st20p_pkt_dst(dst, 0, row, 0), offset / 2,
+                                 meta->pg_cnt);
+      break;
+    case ST_FRAME_FMT_YUV422PLANAR12LE:
+      y = rx_st20p_pkt_dst(dst, 0, row, offset * 2);
+      b = rx_st20p_pkt_dst(dst, 1, row, offset);
+      r = rx_st20p_pkt_dst(dst, 2, row, offset);
+      ret = st20_rfc4175_422be12_to_yuv422p12le(src, y, b, r, meta->pg_cnt, 2);
+      break;
+    case ST_FRAME_FMT_YUV444PLANAR10LE:
+    case ST_FRAME_FMT_GBRPLANAR10LE:
+    case ST_FRAME_FMT_YUV444PLANAR12LE:
+    case ST_FRAME_FMT_GBRPLANAR12LE:
+      /* the G, B, R planes for GBR */
+      y = rx_st20p_pkt_dst(dst, 0, row, offset * 2);
+      b = rx_st20p_pkt_dst(dst, 1, row, offset * 2);
+      r = rx_st20p_pkt_dst(dst, 2, row, offset * 2);
+      if (ctx->ops.output_fmt == ST_FRAME_FMT_YUV444PLANAR10LE) /* 4 pixels in one pg */
+        ret = st20_rfc4175_444be10_to_yuv444p10le(src, y, b, r, meta->pg_cnt, 4);
+      else if (ctx->ops.output_fmt == ST_FRAME_FMT_GBRPLANAR10LE)
+        ret = st20_rfc4175_444be10_to_gbrp10le(src, y, b, r, meta->pg_cnt, 4);
+      else if (ctx->ops.output_fmt == ST_FRAME_FMT_YUV444PLANAR12LE)
+        ret = st20_rfc4175_444be12_to_yuv444p12le(src, y, b, r, meta->pg_cnt, 2);
+      else
+        ret = st20_rfc4175_444be12_to_gbrp12le(src, y, b, r, meta->pg_cnt, 2);
+      break;
+    default:
+      ret = -EINVAL;
+      break;
+  }
+
+  if (ret < 0) {
+    /* drop this frame, the remaining pkts of it are dropped as busy */
+    err("%s(%d), convert fail %d for frame %u\n", __func__, ctx->idx, ret,
+        framebuff->idx);
+    rx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_RX_FRAME_FREE);
+    rte_atomic32_inc(&ctx->stat_convert_fail);
   }
 
   return ret;
 }
 
+/* the output formats can be converted on each packet for the transport format */
+static uint64_t rx_st20p_packet_convert_cap(enum st20_fmt transport_fmt) {
+  switch (transport_fmt) {
+    case ST20_FMT_YUV_422_10BIT:
+      return ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_Y210 | ST_FMT_CAP_UYVY |
+             ST_FMT_CAP_V210;
+    case ST20_FMT_YUV_422_12BIT:
+      return ST_FMT_CAP_YUV422PLANAR12LE;
+    case ST20_FMT_YUV_444_10BIT:
+      return ST_FMT_CAP_YUV444PLANAR10LE;
+    case ST20_FMT_YUV_444_12BIT:
+      return ST_FMT_CAP_YUV444PLANAR12LE;
+    case ST20_FMT_RGB_10BIT:
+      return ST_FMT_CAP_GBRPLANAR10LE;
+    case ST20_FMT_RGB_12BIT:
+      return ST_FMT_CAP_GBRPLANAR12LE;
+    default:
+      return 0;
+  }
+}
+
 static int rx_st20p_frame_ready(void* priv, void* frame,
                                 struct st20_rx_frame_meta* meta) {
   struct st20p_rx_ctx* ctx = priv;
@@ -111,30 +293,19 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
   if (ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT) {
-    framebuff = rx_st20p_next_available(ctx, ctx->framebuff_producer_idx,
-                                        ST20P_RX_FRAME_IN_CONVERTING);
-    if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-      dbg("%s(%d), not this frame, find next one\n", __func__, ctx->idx);
-      framebuff =
-          rx_st20p_next_available(ctx, framebuff->idx, ST20P_RX_FRAME_IN_CONVERTING);
-      if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-        /* should never happen */
-        mt_pthread_mutex_unlock(&ctx->lock);
-        err_once("%s(%d), wrong frame timestamp\n", __func__, ctx->idx);
-        return 0; /* surpress the error */
-      }
-    }
+    framebuff = rx_st20p_converting_frame(ctx, meta->timestamp);
+  } else if (ctx->query_framebuff) {
+    /* the frame already picked in the query ext frame */
+    framebuff = ctx->query_framebuff;
+    ctx->query_framebuff = NULL;
   } else {
-    framebuff =
-        rx_st20p_next_available(ctx, ctx->framebuff_producer_idx, ST20P_RX_FRAME_FREE);
+    framebuff = rx_st20p_ring_get(ctx->free_ring);
   }
 
   /* not any free frame */
   if (!framebuff) {
     rte_atomic32_inc(&ctx->stat_busy);
-    mt_pthread_mutex_unlock(&ctx->lock);
     return -EBUSY;
   }
 
@@ -159,31 +330,23 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
   /* ask app to consume src frame directly */
   if (ctx->derive || (ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT)) {
     if (ctx->derive) framebuff->dst = framebuff->src;
-    framebuff->stat = ST20P_RX_FRAME_CONVERTED;
-    /* point to next */
-    ctx->framebuff_producer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
-    mt_pthread_mutex_unlock(&ctx->lock);
-    if (ctx->ops.notify_frame_available) { /* notify app */
-      ctx->ops.notify_frame_available(ctx->ops.priv);
-    }
+    rx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_RX_FRAME_CONVERTED);
+    rx_st20p_notify_frame_available(ctx);
     return 0;
   }
-  framebuff->stat = ST20P_RX_FRAME_READY;
-
-  /* point to next */
-  ctx->framebuff_producer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
+  rx_st20p_ring_put(ctx->ready_ring, framebuff, ST20P_RX_FRAME_READY);
 
   dbg("%s(%d), frame %u succ\n", __func__, ctx->idx, framebuff->idx);
 
   /* ask convert plugin to consume */
   if (ctx->convert_impl) st20_convert_notify_frame_ready(ctx->convert_impl);
 
-  /* or ask app to consume with internal converter */
-  if (ctx->internal_converter) {
-    if (ctx->ops.notify_frame_available) { /* notify app */
-      ctx->ops.notify_frame_available(ctx->ops.priv);
-    }
+  /* or ask the lib workers to convert */
+  if (ctx->convert_workers) {
+    st20_convert_workers_notify(ctx->convert_workers);
+  } else if (ctx->internal_converter) {
+    /* or ask app to consume with internal converter */
+    rx_st20p_notify_frame_available(ctx);
   }
 
   return 0;
@@ -197,23 +360,18 @@ static int rx_st20p_query_ext_frame(void* priv, struct st20_ext_frame* ext_frame
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      rx_st20p_next_available(ctx, ctx->framebuff_producer_idx, ST20P_RX_FRAME_FREE);
+  /* hold one free frame for the following frame ready */
+  if (!ctx->query_framebuff) ctx->query_framebuff = rx_st20p_ring_get(ctx->free_ring);
+  framebuff = ctx->query_framebuff;
   /* not any free frame */
   if (!framebuff) {
     rte_atomic32_inc(&ctx->stat_busy);
-    mt_pthread_mutex_unlock(&ctx->lock);
     return -EBUSY;
   }
 
   ret = ctx->ops.query_ext_frame(ctx->ops.priv, ext_frame, meta);
-  if (ret < 0) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return -EBUSY;
-  }
+  if (ret < 0) return -EBUSY;
   framebuff->src.opaque = ext_frame->opaque;
-  mt_pthread_mutex_unlock(&ctx->lock);
 
   return 0;
 }
@@ -228,6 +386,12 @@ static int rx_st20p_notify_event(void* priv, enum st_event event, void* args) {
   return 0;
 }
 
+static int rx_st20p_notify_preview_ready(void* priv, struct st20_rx_preview_meta* meta) {
+  struct st20p_rx_ctx* ctx = priv;
+
+  return ctx->ops.notify_preview_ready(ctx->ops.priv, meta);
+}
+
 static struct st20_convert_frame_meta* rx_st20p_convert_get_frame(void* priv) {
   struct st20p_rx_ctx* ctx = priv;
   int idx = ctx->idx;
@@ -240,19 +404,11 @@ static struct st20_convert_frame_meta* rx_st20p_convert_get_frame(void* priv) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      rx_st20p_next_available(ctx, ctx->framebuff_convert_idx, ST20P_RX_FRAME_READY);
+  framebuff = rx_st20p_ring_get(ctx->ready_ring);
   /* not any ready frame */
-  if (!framebuff) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
-  }
+  if (!framebuff) return NULL;
 
   framebuff->stat = ST20P_RX_FRAME_IN_CONVERTING;
-  /* point to next */
-  ctx->framebuff_convert_idx = rx_st20p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   return &framebuff->convert_frame;
@@ -280,13 +436,11 @@ static int rx_st20p_convert_put_frame(void* priv, struct st20_convert_frame_meta
   if (result < 0) {
     /* free the frame */
     st20_rx_put_framebuff(ctx->transport, framebuff->src.addr[0]);
-    framebuff->stat = ST20P_RX_FRAME_FREE;
+    rx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_RX_FRAME_FREE);
     rte_atomic32_inc(&ctx->stat_convert_fail);
   } else {
-    framebuff->stat = ST20P_RX_FRAME_CONVERTED;
-    if (ctx->ops.notify_frame_available) { /* notify app */
-      ctx->ops.notify_frame_available(ctx->ops.priv);
-    }
+    rx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_RX_FRAME_CONVERTED);
+    rx_st20p_notify_frame_available(ctx);
   }
 
   return 0;
@@ -294,17 +448,12 @@ static int rx_st20p_convert_put_frame(void* priv, struct st20_convert_frame_meta
 
 static int rx_st20p_convert_dump(void* priv) {
   struct st20p_rx_ctx* ctx = priv;
-  struct st20p_rx_frame* framebuff = ctx->framebuffs;
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  uint16_t producer_idx = ctx->framebuff_producer_idx;
-  uint16_t convert_idx = ctx->framebuff_convert_idx;
-  uint16_t consumer_idx = ctx->framebuff_consumer_idx;
-  notice("RX_st20p(%s), p(%d:%s) cv(%d:%s) c(%d:%s)\n", ctx->ops_name, producer_idx,
-         rx_st20p_stat_name(framebuff[producer_idx].stat), convert_idx,
-         rx_st20p_stat_name(framebuff[convert_idx].stat), consumer_idx,
-         rx_st20p_stat_name(framebuff[consumer_idx].stat));
+  notice("RX_st20p(%s), free %u ready %u converted %u\n", ctx->ops_name,
+         rte_ring_count(ctx->free_ring), rte_ring_count(ctx->ready_ring),
+         rte_ring_count(ctx->converted_ring));
 
   int convert_fail = rte_atomic32_read(&ctx->stat_convert_fail);
   rte_atomic32_set(&ctx->stat_convert_fail, 0);
@@ -318,6 +467,13 @@ static int rx_st20p_convert_dump(void* priv) {
     notice("RX_st20p(%s), busy drop frame %d\n", ctx->ops_name, busy);
   }
 
+  int pkt_convert_timeout = rte_atomic32_read(&ctx->stat_pkt_convert_timeout);
+  rte_atomic32_set(&ctx->stat_pkt_convert_timeout, 0);
+  if (pkt_convert_timeout) {
+    notice("RX_st20p(%s), pkt convert timeout frame %d\n", ctx->ops_name,
+           pkt_convert_timeout);
+  }
+
   return 0;
 }
 
@@ -347,17 +503,18 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
   if (ops->flags & ST20P_RX_FLAG_DISABLE_MIGRATE)
     ops_rx.flags |= ST20_RX_FLAG_DISABLE_MIGRATE;
   if (ops->flags & ST20P_RX_FLAG_PKT_CONVERT) {
-    uint64_t pkt_cvt_output_cap =
-        ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_Y210 | ST_FMT_CAP_UYVY;
-    if (ops->transport_fmt != ST20_FMT_YUV_422_10BIT) {
-      err("%s(%d), only 422 10bit support packet convert\n", __func__, idx);
-      return -EIO;
-    }
+    uint64_t pkt_cvt_output_cap = rx_st20p_packet_convert_cap(ops->transport_fmt);
     if (!(MTL_BIT64(ops->output_fmt) & pkt_cvt_output_cap)) {
-      err("%s(%d), %s not supported by packet convert\n", __func__, idx,
-          st_frame_fmt_name(ops->output_fmt));
+      err("%s(%d), transport fmt %d to %s not supported by packet convert\n", __func__,
+          idx, ops->transport_fmt, st_frame_fmt_name(ops->output_fmt));
       return -EIO;
     }
+    /* each v210 line should be whole 16 bytes blocks as the packet writes by line */
+    if (ops->output_fmt == ST_FRAME_FMT_V210 && (ops->width % 6)) {
+      err("%s(%d), width %u not multiple of 6 for v210 packet convert\n", __func__, idx,
+          ops->width);
+      return -EINVAL;
+    }
     ops_rx.uframe_pg_callback = rx_st20p_packet_convert;
     ops_rx.uframe_size = st20_frame_size(ops->transport_fmt, ops->width, ops->height);
   }
@@ -373,6 +530,12 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
   ops_rx.framebuff_cnt = ops->framebuff_cnt;
   ops_rx.notify_frame_ready = rx_st20p_frame_ready;
   ops_rx.notify_event = rx_st20p_notify_event;
+  if (ops->preview_scale) {
+    ops_rx.preview_scale = ops->preview_scale;
+    ops_rx.preview_interval = ops->preview_interval;
+    if (ops->notify_preview_ready)
+      ops_rx.notify_preview_ready = rx_st20p_notify_preview_ready;
+  }
   if (ctx->derive) {
     /* ext frame info directly passed down to st20 lib */
     if (ops->ext_frames) {
@@ -414,6 +577,8 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     frames[i].src.fmt = st_frame_fmt_from_transport(ctx->ops.transport_fmt);
     frames[i].src.interlaced = ops->interlaced;
+    frames[i].src.color_matrix = ops->color_matrix;
+    frames[i].src.color_full_range = ops->color_full_range;
     frames[i].src.buffer_size =
         st_frame_size(frames[i].src.fmt, ops->width, ops->height, ops->interlaced);
     frames[i].src.data_size = frames[i].src.buffer_size;
@@ -456,6 +621,19 @@ static int rx_st20p_uinit_dst_fbs(struct st20p_rx_ctx* ctx) {
     ctx->framebuffs = NULL;
   }
 
+  if (ctx->free_ring) {
+    rte_ring_free(ctx->free_ring);
+    ctx->free_ring = NULL;
+  }
+  if (ctx->ready_ring) {
+    rte_ring_free(ctx->ready_ring);
+    ctx->ready_ring = NULL;
+  }
+  if (ctx->converted_ring) {
+    rte_ring_free(ctx->converted_ring);
+    ctx->converted_ring = NULL;
+  }
+
   return 0;
 }
 
@@ -475,11 +653,21 @@ static int rx_st20p_init_dst_fbs(struct mtl_main_impl* impl, struct st20p_rx_ctx
   }
   ctx->framebuffs = frames;
 
+  ctx->free_ring = rx_st20p_ring_create(ctx, "FREE");
+  ctx->ready_ring = rx_st20p_ring_create(ctx, "READY");
+  ctx->converted_ring = rx_st20p_ring_create(ctx, "CONVERTED");
+  if (!ctx->free_ring || !ctx->ready_ring || !ctx->converted_ring) {
+    rx_st20p_uinit_dst_fbs(ctx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    frames[i].stat = ST20P_RX_FRAME_FREE;
     frames[i].idx = i;
     frames[i].dst.fmt = ops->output_fmt;
     frames[i].dst.interlaced = ops->interlaced;
+    /* the convert reads the color from the YUV side, the dst for a RGB transport */
+    frames[i].dst.color_matrix = ops->color_matrix;
+    frames[i].dst.color_full_range = ops->color_full_range;
     frames[i].dst.width = ops->width;
     frames[i].dst.height = ops->height;
     if (!ctx->derive) { /* when derive, no need to alloc dst frames */
@@ -529,12 +717,81 @@ static int rx_st20p_init_dst_fbs(struct mtl_main_impl* impl, struct st20p_rx_ctx
       rx_st20p_uinit_dst_fbs(ctx);
       return -ENOMEM;
     }
+    rx_st20p_ring_put(ctx->free_ring, &frames[i], ST20P_RX_FRAME_FREE);
   }
   info("%s(%d), size %" PRIu64 " fmt %d with %u frames\n", __func__, idx, dst_size,
        ops->output_fmt, ctx->framebuff_cnt);
   return 0;
 }
 
+static struct st_frame* rx_st20p_graph_get_frame(void* priv) {
+  struct st20p_rx_ctx* ctx = priv;
+  struct st20p_rx_frame* framebuff;
+
+  if (!ctx->ready) return NULL; /* not ready */
+
+  /* the internal converter without workers runs in the first stage */
+  bool convert_in_get = ctx->internal_converter && !ctx->convert_workers;
+  struct rte_ring* ring = convert_in_get ? ctx->ready_ring : ctx->converted_ring;
+
+  framebuff = rx_st20p_ring_get(ring);
+  if (!framebuff) return NULL;
+  if (convert_in_get) {
+    ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+  }
+
+  framebuff->stat = ST20P_RX_FRAME_IN_STAGE;
+  dbg("%s(%d), frame %u succ\n", __func__, ctx->idx, framebuff->idx);
+  return rx_st20p_dst_frame(framebuff);
+}
+
+static int rx_st20p_graph_put_frame(void* priv, struct st_frame* frame) {
+  struct st20p_rx_ctx* ctx = priv;
+  struct st20p_rx_frame* framebuff = frame->priv;
+
+  if (ST20P_RX_FRAME_IN_STAGE != framebuff->stat) {
+    err("%s(%d), frame %u not in stage %d\n", __func__, ctx->idx, framebuff->idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  /* free the frame */
+  st20_rx_put_framebuff(ctx->transport, framebuff->src.addr[0]);
+  rx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_RX_FRAME_FREE);
+  return 0;
+}
+
+static void rx_st20p_graph_notify(void* priv) {
+  rx_st20p_notify_user(priv);
+}
+
+static int rx_st20p_create_graph(struct mtl_main_impl* impl, struct st20p_rx_ctx* ctx,
+                                 struct st20p_rx_ops* ops) {
+  struct st20_stage_graph_ops graph_ops;
+
+  memset(&graph_ops, 0, sizeof(graph_ops));
+  graph_ops.name = ctx->ops_name;
+  graph_ops.input_fmt = ops->output_fmt;
+  graph_ops.width = ops->width;
+  graph_ops.height = ops->height;
+  graph_ops.interlaced = ops->interlaced;
+  graph_ops.framebuff_cnt = ops->framebuff_cnt;
+  graph_ops.stages = ops->stages;
+  graph_ops.stages_cnt = ops->stages_cnt;
+  graph_ops.priv = ctx;
+  graph_ops.get_frame = rx_st20p_graph_get_frame;
+  graph_ops.put_frame = rx_st20p_graph_put_frame;
+  graph_ops.notify_frame_available = rx_st20p_graph_notify;
+
+  ctx->graph = st20_stage_graph_create(impl, &graph_ops);
+  if (!ctx->graph) {
+    err("%s(%d), stage graph create fail\n", __func__, ctx->idx);
+    return -EIO;
+  }
+
+  return 0;
+}
+
 static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ctx* ctx,
                                   struct st20p_rx_ops* ops) {
   int idx = ctx->idx;
@@ -568,7 +825,30 @@ static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ct
       return -EIO;
     }
     ctx->internal_converter = converter;
+    ctx->internal_load = st20_get_internal_converter(impl, &req);
     info("%s(%d), use internal converter\n", __func__, idx);
+    if (ops->convert_worker_cnt) {
+      if (ops->flags & ST20P_RX_FLAG_EXT_FRAME) {
+        err("%s(%d), convert worker not support ext frame mode\n", __func__, idx);
+        return -EINVAL;
+      }
+      struct st20_convert_workers_ops workers_ops;
+      memset(&workers_ops, 0, sizeof(workers_ops));
+      workers_ops.name = ctx->ops_name;
+      workers_ops.worker_cnt = ops->convert_worker_cnt;
+      workers_ops.bind_lcore =
+          (ops->flags & ST20P_RX_FLAG_CONVERT_WORKER_LCORE) ? true : false;
+      workers_ops.converter = converter;
+      workers_ops.frame_cnt = ops->framebuff_cnt;
+      workers_ops.priv = ctx;
+      workers_ops.get_frame = rx_st20p_convert_get_frame;
+      workers_ops.put_frame = rx_st20p_convert_put_frame;
+      ctx->convert_workers = st20_convert_workers_create(impl, &workers_ops);
+      if (!ctx->convert_workers) {
+        err("%s(%d), convert workers create fail\n", __func__, idx);
+        return -EIO;
+      }
+    }
     return 0;
   }
   ctx->convert_impl = convert_impl;
@@ -581,7 +861,6 @@ struct st_frame* st20p_rx_get_ext_frame(st20p_rx_handle handle,
   struct st20p_rx_ctx* ctx = handle;
   int idx = ctx->idx;
   struct st20p_rx_frame* framebuff;
-  struct st_frame* frame;
 
   if (ctx->type != MT_ST20_HANDLE_PIPELINE_RX) {
     err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
@@ -600,15 +879,11 @@ struct st_frame* st20p_rx_get_ext_frame(st20p_rx_handle handle,
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
+  mt_event_fd_ack(&ctx->event);
 
-  framebuff =
-      rx_st20p_next_available(ctx, ctx->framebuff_consumer_idx, ST20P_RX_FRAME_READY);
+  framebuff = rx_st20p_user_get(ctx, ctx->ready_ring);
   /* not any ready frame */
-  if (!framebuff) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
-  }
+  if (!framebuff) return NULL;
   for (int plane = 0; plane < st_frame_fmt_planes(framebuff->dst.fmt); plane++) {
     framebuff->dst.addr[plane] = ext_frame->addr[plane];
     framebuff->dst.iova[plane] = ext_frame->iova[plane];
@@ -619,28 +894,36 @@ struct st_frame* st20p_rx_get_ext_frame(st20p_rx_handle handle,
   framebuff->dst.flags |= ST_FRAME_FLAG_EXT_BUF;
   int ret = st_frame_sanity_check(&framebuff->dst);
   if (ret < 0) {
-    err("%s, ext framebuffer sanity check fail %d fb_idx %d\n", __func__, ret,
-        ctx->framebuff_consumer_idx);
-    mt_pthread_mutex_unlock(&ctx->lock);
+    err("%s, ext framebuffer sanity check fail %d fb_idx %u\n", __func__, ret,
+        framebuff->idx);
+    /* back to the ready ring */
+    rx_st20p_ring_put(ctx->ready_ring, framebuff, ST20P_RX_FRAME_READY);
     return NULL;
   }
   ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
 
   framebuff->stat = ST20P_RX_FRAME_IN_USER;
-  /* point to next */
-  ctx->framebuff_consumer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
-
-  mt_pthread_mutex_unlock(&ctx->lock);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
-  frame = &framebuff->dst;
-  if (framebuff->user_meta_data_size) {
-    frame->user_meta = framebuff->user_meta;
-    frame->user_meta_size = framebuff->user_meta_data_size;
-  } else {
-    frame->user_meta = NULL;
-    frame->user_meta_size = 0;
+  return rx_st20p_dst_frame(framebuff);
+}
+
+static struct st_frame* rx_st20p_graph_user_get(struct st20p_rx_ctx* ctx) {
+  struct st_frame* frame = st20_stage_graph_get_frame(ctx->graph);
+
+  if (!frame && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    frame = st20_stage_graph_get_frame(ctx->graph);
+    if (!frame) {
+      rx_st20p_block_wait(ctx);
+      frame = st20_stage_graph_get_frame(ctx->graph);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
+    mt_pthread_mutex_unlock(&ctx->lock);
   }
+
   return frame;
 }
 
@@ -648,7 +931,6 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
   struct st20p_rx_ctx* ctx = handle;
   int idx = ctx->idx;
   struct st20p_rx_frame* framebuff;
-  struct st_frame* frame;
 
   if (ctx->type != MT_ST20_HANDLE_PIPELINE_RX) {
     err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
@@ -657,56 +939,44 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
+  mt_event_fd_ack(&ctx->event);
 
-  if (ctx->internal_converter) { /* convert internal */
-    framebuff =
-        rx_st20p_next_available(ctx, ctx->framebuff_consumer_idx, ST20P_RX_FRAME_READY);
-    /* not any ready frame */
-    if (!framebuff) {
-      mt_pthread_mutex_unlock(&ctx->lock);
-      return NULL;
-    }
+  if (ctx->graph) return rx_st20p_graph_user_get(ctx);
+
+  /* the internal converter works on the ready frame in the get call */
+  bool convert_in_get = ctx->internal_converter && !ctx->convert_workers;
+  struct rte_ring* ring = convert_in_get ? ctx->ready_ring : ctx->converted_ring;
+
+  framebuff = rx_st20p_user_get(ctx, ring);
+  /* not any ready or converted frame */
+  if (!framebuff) return NULL;
+  if (convert_in_get) { /* convert internal */
     ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
-  } else {
-    framebuff = rx_st20p_next_available(ctx, ctx->framebuff_consumer_idx,
-                                        ST20P_RX_FRAME_CONVERTED);
-    /* not any converted frame */
-    if (!framebuff) {
-      mt_pthread_mutex_unlock(&ctx->lock);
-      return NULL;
-    }
   }
 
   framebuff->stat = ST20P_RX_FRAME_IN_USER;
-  /* point to next */
-  ctx->framebuff_consumer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
-
-  mt_pthread_mutex_unlock(&ctx->lock);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
-  frame = &framebuff->dst;
-  if (framebuff->user_meta_data_size) {
-    frame->user_meta = framebuff->user_meta;
-    frame->user_meta_size = framebuff->user_meta_data_size;
-  } else {
-    frame->user_meta = NULL;
-    frame->user_meta_size = 0;
-  }
-  return frame;
+  return rx_st20p_dst_frame(framebuff);
 }
 
 int st20p_rx_put_frame(st20p_rx_handle handle, struct st_frame* frame) {
   struct st20p_rx_ctx* ctx = handle;
   int idx = ctx->idx;
-  struct st20p_rx_frame* framebuff = frame->priv;
-  uint16_t consumer_idx = framebuff->idx;
+  struct st20p_rx_frame* framebuff;
+  uint16_t consumer_idx;
 
   if (ctx->type != MT_ST20_HANDLE_PIPELINE_RX) {
     err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
     return -EIO;
   }
 
+  /* the frame of the last stage */
+  if (ctx->graph) return st20_stage_graph_put_frame(ctx->graph, frame);
+
+  framebuff = frame->priv;
+  consumer_idx = framebuff->idx;
+
   if (ST20P_RX_FRAME_IN_USER != framebuff->stat) {
     err("%s(%d), frame %u not in user %d\n", __func__, idx, consumer_idx,
         framebuff->stat);
@@ -715,7 +985,7 @@ int st20p_rx_put_frame(st20p_rx_handle handle, struct st_frame* frame) {
 
   /* free the frame */
   st20_rx_put_framebuff(ctx->transport, framebuff->src.addr[0]);
-  framebuff->stat = ST20P_RX_FRAME_FREE;
+  rx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_RX_FRAME_FREE);
   dbg("%s(%d), frame %u succ\n", __func__, idx, consumer_idx);
 
   return 0;
@@ -736,17 +1006,34 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
     return NULL;
   }
 
-  if (!ops->notify_frame_available) {
+  uint32_t no_notify_flags = ST20P_RX_FLAG_BLOCK_GET | ST20P_RX_FLAG_EVENT_FD;
+  if (!(ops->flags & no_notify_flags) && !ops->notify_frame_available) {
     err("%s, pls set notify_frame_available\n", __func__);
     return NULL;
   }
 
+  if (ops->color_matrix >= ST_FRAME_COLOR_MATRIX_MAX) {
+    err("%s, invalid color matrix %d\n", __func__, ops->color_matrix);
+    return NULL;
+  }
+
   dst_size = st_frame_size(ops->output_fmt, ops->width, ops->height, ops->interlaced);
   if (!dst_size) {
     err("%s(%d), get dst size fail\n", __func__, idx);
     return NULL;
   }
 
+  if (ops->stages_cnt) {
+    if (!ops->stages || ops->stages_cnt > ST20P_STAGES_MAX) {
+      err("%s(%d), invalid stages %u\n", __func__, idx, ops->stages_cnt);
+      return NULL;
+    }
+    if (ops->flags & ST20P_RX_FLAG_EXT_FRAME) {
+      err("%s(%d), stages not support ext frame mode\n", __func__, idx);
+      return NULL;
+    }
+  }
+
   ctx = mt_rte_zmalloc_socket(sizeof(*ctx), mt_socket_id(impl, MTL_PORT_P));
   if (!ctx) {
     err("%s, ctx malloc fail\n", __func__);
@@ -761,7 +1048,16 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
   ctx->dst_size = dst_size;
   rte_atomic32_set(&ctx->stat_convert_fail, 0);
   rte_atomic32_set(&ctx->stat_busy, 0);
+  rte_atomic32_set(&ctx->stat_pkt_convert_timeout, 0);
+  /* two frame times as the transport also drop the incomplete frame */
+  double frame_rate = st_frame_rate(ops->fps);
+  ctx->pkt_convert_timeout_ns = frame_rate ? NS_PER_S * 2 / frame_rate : NS_PER_S;
   mt_pthread_mutex_init(&ctx->lock, NULL);
+  mt_pthread_cond_wait_init(&ctx->block_wake_cond);
+  rte_atomic32_set(&ctx->block_waiters, 0);
+  ctx->block_get = (ops->flags & ST20P_RX_FLAG_BLOCK_GET) ? true : false;
+  ctx->block_timeout_ns = ST_PIPELINE_BLOCK_TIMEOUT_NS;
+  ctx->event.fd = -1;
 
   /* copy ops */
   if (ops->name) {
@@ -771,6 +1067,15 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
   }
   ctx->ops = *ops;
 
+  if (ops->flags & ST20P_RX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&ctx->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      st20p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* get one suitable convert device */
   if (!ctx->derive && !(ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT)) {
     ret = rx_st20p_get_converter(impl, ctx, ops);
@@ -797,15 +1102,21 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
     return NULL;
   }
 
+  if (ops->stages_cnt) {
+    ret = rx_st20p_create_graph(impl, ctx, ops);
+    if (ret < 0) {
+      st20p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* all ready now */
   ctx->ready = true;
   notice("%s(%d), transport fmt %s, output fmt %s\n", __func__, idx,
          st20_frame_fmt_name(ops->transport_fmt), st_frame_fmt_name(ops->output_fmt));
   st20p_rx_idx++;
 
-  if (ctx->ops.notify_frame_available) { /* notify app */
-    ctx->ops.notify_frame_available(ctx->ops.priv);
-  }
+  rx_st20p_notify_frame_available(ctx);
 
   return ctx;
 }
@@ -821,12 +1132,25 @@ int st20p_rx_free(st20p_rx_handle handle) {
 
   notice("%s(%d), start\n", __func__, ctx->idx);
 
+  /* the stages hold the frames of the transport */
+  if (ctx->graph) {
+    st20_stage_graph_free(ctx->graph);
+    ctx->graph = NULL;
+  }
+
+  if (ctx->convert_workers) {
+    st20_convert_workers_free(ctx->convert_workers);
+    ctx->convert_workers = NULL;
+  }
+
   if (ctx->convert_impl) {
     st20_put_converter(impl, ctx->convert_impl);
     ctx->convert_impl = NULL;
   }
 
   if (ctx->internal_converter) {
+    st20_put_internal_converter(impl, ctx->internal_load);
+    ctx->internal_load = 0;
     mt_rte_free(ctx->internal_converter);
     ctx->internal_converter = NULL;
   }
@@ -838,6 +1162,8 @@ int st20p_rx_free(st20p_rx_handle handle) {
   rx_st20p_uinit_dst_fbs(ctx);
 
   mt_pthread_mutex_destroy(&ctx->lock);
+  mt_pthread_cond_destroy(&ctx->block_wake_cond);
+  mt_event_fd_uinit(&ctx->event);
   notice("%s(%d), succ\n", __func__, ctx->idx);
   mt_rte_free(ctx);
 
@@ -871,6 +1197,7 @@ size_t st20p_rx_frame_size(st20p_rx_handle handle) {
     return 0;
   }
 
+  if (ctx->graph) return st20_stage_graph_frame_size(ctx->graph);
   return ctx->dst_size;
 }
 
@@ -935,3 +1262,47 @@ int st20p_rx_reset_port_stats(st20p_rx_handle handle, enum mtl_session_port port
 
   return st20_rx_reset_port_stats(ctx->transport, port);
 }
+
+int st20p_rx_wake_block(st20p_rx_handle handle) {
+  struct st20p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->block_get) rx_st20p_block_wake(ctx);
+
+  return 0;
+}
+
+int st20p_rx_set_block_timeout(st20p_rx_handle handle, uint64_t timedwait_ns) {
+  struct st20p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  ctx->block_timeout_ns = timedwait_ns;
+  return 0;
+}
+
+int st20p_rx_get_event_fd(st20p_rx_handle handle) {
+  struct st20p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, cidx);
+    return -EIO;
+  }
+
+  return ctx->event.fd;
+}
@@ -6,6 +6,8 @@
 #define _ST_LIB_PIPELINE_ST20_RX_HEAD_H_
 
 #include "../st_main.h"
+#include "st20_convert_worker.h"
+#include "st20_stage_graph.h"
 #include "st_plugin.h"
 
 enum st20p_rx_frame_status {
@@ -13,7 +15,8 @@ enum st20p_rx_frame_status {
   ST20P_RX_FRAME_READY,         /* get from transport */
   ST20P_RX_FRAME_IN_CONVERTING, /* for converting */
   ST20P_RX_FRAME_CONVERTED,
-  ST20P_RX_FRAME_IN_USER, /* in user */
+  ST20P_RX_FRAME_IN_USER,  /* in user */
+  ST20P_RX_FRAME_IN_STAGE, /* in the first stage of the graph */
   ST20P_RX_FRAME_STATUS_MAX,
 };
 
@@ -26,6 +29,8 @@ struct st20p_rx_frame {
   void* user_meta; /* the user meta data */
   size_t user_meta_buffer_size;
   size_t user_meta_data_size;
+  /* the first pkt time for ST20P_RX_FLAG_PKT_CONVERT, the frame is in no ring */
+  uint64_t pkt_convert_tsc;
 };
 
 struct st20p_rx_ctx {
@@ -38,21 +43,39 @@ struct st20p_rx_ctx {
 
   st20_rx_handle transport;
   uint16_t framebuff_cnt;
-  uint16_t framebuff_producer_idx;
-  uint16_t framebuff_convert_idx;
-  uint16_t framebuff_consumer_idx;
   struct st20p_rx_frame* framebuffs;
-  pthread_mutex_t lock;
+  /* lock-free rings of framebuff pointer for each queued state */
+  struct rte_ring* free_ring;      /* ST20P_RX_FRAME_FREE */
+  struct rte_ring* ready_ring;     /* ST20P_RX_FRAME_READY */
+  struct rte_ring* converted_ring; /* ST20P_RX_FRAME_CONVERTED */
+  /* the free frame picked by query_ext_frame, used by the next frame ready */
+  struct st20p_rx_frame* query_framebuff;
+  pthread_mutex_t lock; /* only for the block wait */
 
   struct st20_convert_session_impl* convert_impl;
   struct st_frame_converter* internal_converter;
+  double internal_load; /* the load accounted to the internal converters */
+  struct st20_convert_workers* convert_workers; /* run the internal converter */
+  struct st20_stage_graph* graph; /* the stages after the convert */
   bool ready;
+
+  /* for ST20P_RX_FLAG_BLOCK_GET, wait on lock */
+  bool block_get;
+  pthread_cond_t block_wake_cond;
+  rte_atomic32_t block_waiters; /* the block get waiting on block_wake_cond */
+  uint64_t block_timeout_ns;
+
+  /* for ST20P_RX_FLAG_EVENT_FD */
+  struct mt_event_fd event;
   bool derive;
 
   size_t dst_size;
+  /* the in converting frame not completed in this time is back to free ring */
+  uint64_t pkt_convert_timeout_ns;
 
   rte_atomic32_t stat_convert_fail;
   rte_atomic32_t stat_busy;
+  rte_atomic32_t stat_pkt_convert_timeout;
 };
 
 #endif
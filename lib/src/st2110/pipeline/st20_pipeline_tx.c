@@ -6,48 +6,63 @@
 
 #include "../../mt_log.h"
 
-static const char* st20p_tx_frame_stat_name[ST20P_TX_FRAME_STATUS_MAX] = {
-    "free", "ready", "in_converting", "converted", "in_user", "in_transmitting",
-};
-
-static const char* tx_st20p_stat_name(enum st20p_tx_frame_status stat) {
-  return st20p_tx_frame_stat_name[stat];
+static inline struct st_frame* tx_st20p_user_frame(struct st20p_tx_ctx* ctx,
+                                                   struct st20p_tx_frame* framebuff) {
+  return ctx->derive ? &framebuff->dst : &framebuff->src;
 }
 
-static uint16_t tx_st20p_next_idx(struct st20p_tx_ctx* ctx, uint16_t idx) {
-  /* point to next */
-  uint16_t next_idx = idx;
-  next_idx++;
-  if (next_idx >= ctx->framebuff_cnt) next_idx = 0;
-  return next_idx;
+static struct rte_ring* tx_st20p_ring_create(struct st20p_tx_ctx* ctx, const char* tag) {
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST20PTX%d_%s", ctx->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, ctx->framebuff_cnt,
+                         mt_socket_id(ctx->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%d), rte_ring_create %s fail\n", __func__, ctx->idx, ring_name);
+  return ring;
 }
 
-static inline struct st_frame* tx_st20p_user_frame(struct st20p_tx_ctx* ctx,
-                                                   struct st20p_tx_frame* framebuff) {
-  return ctx->derive ? &framebuff->dst : &framebuff->src;
+/* move the frame to the desired state ring */
+static inline void tx_st20p_ring_put(struct rte_ring* ring,
+                                     struct st20p_tx_frame* framebuff,
+                                     enum st20p_tx_frame_status stat) {
+  framebuff->stat = stat;
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
 }
 
-static struct st20p_tx_frame* tx_st20p_next_available(
-    struct st20p_tx_ctx* ctx, uint16_t idx_start, enum st20p_tx_frame_status desired) {
-  uint16_t idx = idx_start;
+static inline struct st20p_tx_frame* tx_st20p_ring_get(struct rte_ring* ring) {
   struct st20p_tx_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
+}
 
-  /* check ready frame from idx_start */
-  while (1) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == framebuff->stat) {
-      /* find one desired */
-      return framebuff;
-    }
-    idx = tx_st20p_next_idx(ctx, idx);
-    if (idx == idx_start) {
-      /* loop all frames end */
-      break;
-    }
+static void tx_st20p_block_wake(struct st20p_tx_ctx* ctx) {
+  /* order the frame enqueue before the waiters read */
+  rte_smp_mb();
+  /* only lock and signal when any block get is waiting */
+  if (!rte_atomic32_read(&ctx->block_waiters)) return;
+  mt_pthread_mutex_lock(&ctx->lock);
+  mt_pthread_cond_signal(&ctx->block_wake_cond);
+  mt_pthread_mutex_unlock(&ctx->lock);
+}
+
+static void tx_st20p_notify_frame_available(struct st20p_tx_ctx* ctx) {
+  if (ctx->ops.notify_frame_available) { /* notify app */
+    ctx->ops.notify_frame_available(ctx->ops.priv);
   }
 
-  /* no any desired frame */
-  return NULL;
+  if (ctx->block_get) tx_st20p_block_wake(ctx);
+
+  mt_event_fd_notify(&ctx->event);
+}
+
+/* wait until any frame status change or timeout, ctx->lock should be locked */
+static void tx_st20p_block_wait(struct st20p_tx_ctx* ctx) {
+  dbg("%s(%d), start\n", __func__, ctx->idx);
+  mt_pthread_cond_timedwait_ns(&ctx->block_wake_cond, &ctx->lock, ctx->block_timeout_ns);
+  dbg("%s(%d), end\n", __func__, ctx->idx);
 }
 
 static int tx_st20p_next_frame(void* priv, uint16_t* next_frame_idx,
@@ -57,14 +72,9 @@ static int tx_st20p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      tx_st20p_next_available(ctx, ctx->framebuff_consumer_idx, ST20P_TX_FRAME_CONVERTED);
+  framebuff = tx_st20p_ring_get(ctx->converted_ring);
   /* not any converted frame */
-  if (!framebuff) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return -EBUSY;
-  }
+  if (!framebuff) return -EBUSY;
 
   framebuff->stat = ST20P_TX_FRAME_IN_TRANSMITTING;
   *next_frame_idx = framebuff->idx;
@@ -79,9 +89,6 @@ static int tx_st20p_next_frame(void* priv, uint16_t* next_frame_idx,
     meta->user_meta = framebuff->user_meta;
     meta->user_meta_size = framebuff->user_meta_data_size;
   }
-  /* point to next */
-  ctx->framebuff_consumer_idx = tx_st20p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
   dbg("%s(%d), frame %u succ\n", __func__, ctx->idx, framebuff->idx);
   return 0;
 }
@@ -92,34 +99,176 @@ static int tx_st20p_frame_done(void* priv, uint16_t frame_idx,
   int ret;
   struct st20p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
 
-  mt_pthread_mutex_lock(&ctx->lock);
+  struct st_frame* frame = tx_st20p_user_frame(ctx, framebuff);
+  frame->tfmt = meta->tfmt;
+  frame->timestamp = meta->timestamp;
+  frame->epoch = meta->epoch;
+
   if (ST20P_TX_FRAME_IN_TRANSMITTING == framebuff->stat) {
     ret = 0;
-    framebuff->stat = ST20P_TX_FRAME_FREE;
+    tx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_TX_FRAME_FREE);
     dbg("%s(%d), done_idx %u\n", __func__, ctx->idx, frame_idx);
   } else {
     ret = -EIO;
     err("%s(%d), err status %d for frame %u\n", __func__, ctx->idx, framebuff->stat,
         frame_idx);
   }
-  mt_pthread_mutex_unlock(&ctx->lock);
-
-  struct st_frame* frame = tx_st20p_user_frame(ctx, framebuff);
-  frame->tfmt = meta->tfmt;
-  frame->timestamp = meta->timestamp;
-  frame->epoch = meta->epoch;
 
   if (ctx->ops.notify_frame_done) { /* notify app which frame done */
     ctx->ops.notify_frame_done(ctx->ops.priv, frame);
   }
 
-  if (ctx->ops.notify_frame_available) { /* notify app can get frame */
-    ctx->ops.notify_frame_available(ctx->ops.priv);
+  tx_st20p_notify_frame_available(ctx);
+
+  return ret;
+}
+
+/* the src address in the plane for the pixel offset of the packet */
+static inline void* tx_st20p_pkt_src(struct st_frame* src, uint8_t plane, uint16_t row,
+                                     size_t offset_bytes) {
+  return (uint8_t*)src->addr[plane] + src->linesize[plane] * row + offset_bytes;
+}
+
+/* get the n-th 10 bits component of one v210 line, 3 components in one le32 word */
+static inline uint16_t tx_st20p_v210_get(uint32_t* words, uint32_t n) {
+  return (rte_le_to_cpu_32(words[n / 3]) >> ((n % 3) * 10)) & 0x3FF;
+}
+
+/* v210 line to rfc4175 422 10 bit packet, pg_offset is the pg index within the line */
+static int tx_st20p_v210_to_pkt(uint8_t* line, struct st20_rfc4175_422_10_pg2_be* pg,
+                                uint32_t pg_offset, uint32_t pg_cnt) {
+  /* 3 pgs(6 pixels) in one 16 bytes v210 block */
+  uint32_t head = RTE_MIN((3 - pg_offset % 3) % 3, pg_cnt);
+  uint32_t blocks = (pg_cnt - head) / 3;
+  uint32_t* words = (uint32_t*)line;
+  uint16_t cb, y0, cr, y1;
+  uint32_t n;
+
+  /* the pgs not aligned to one v210 block are got by component */
+  for (uint32_t i = 0; i < pg_cnt; i++) {
+    if (i == head && blocks) i += blocks * 3;
+    if (i >= pg_cnt) break;
+    n = (pg_offset + i) * 4; /* v210 component order is same as pg2: Cb Y0 Cr Y1 */
+    cb = tx_st20p_v210_get(words, n);
+    y0 = tx_st20p_v210_get(words, n + 1);
+    cr = tx_st20p_v210_get(words, n + 2);
+    y1 = tx_st20p_v210_get(words, n + 3);
+    pg[i].Cb00 = cb >> 2;
+    pg[i].Cb00_ = cb;
+    pg[i].Y00 = y0 >> 4;
+    pg[i].Y00_ = y0;
+    pg[i].Cr00 = cr >> 6;
+    pg[i].Cr00_ = cr;
+    pg[i].Y01 = y1 >> 8;
+    pg[i].Y01_ = y1;
   }
 
+  if (!blocks) return 0;
+  return st20_v210_to_rfc4175_422be10(line + (pg_offset + head) / 3 * 16, &pg[head],
+                                      blocks * 3, 2);
+}
+
+static int tx_st20p_packet_convert(void* priv, uint16_t frame_idx,
+                                   struct st20_tx_uframe_pg_meta* meta) {
+  struct st20p_tx_ctx* ctx = priv;
+  struct st_frame* src = &ctx->framebuffs[frame_idx].src;
+  void* dst = meta->payload;
+  uint16_t row = meta->row_number;
+  uint32_t offset = meta->row_offset; /* pixel offset in the line */
+  uint16_t *y, *b, *r;
+  int ret;
+
+  switch (ctx->ops.input_fmt) {
+    case ST_FRAME_FMT_YUV422PLANAR10LE:
+      y = tx_st20p_pkt_src(src, 0, row, offset * 2);
+      b = tx_st20p_pkt_src(src, 1, row, offset);
+      r = tx_st20p_pkt_src(src, 2, row, offset);
+      ret = st20_yuv422p10le_to_rfc4175_422be10(y, b, r, dst, meta->pg_cnt, 2);
+      break;
+    case ST_FRAME_FMT_Y210:
+      y = tx_st20p_pkt_src(src, 0, row, offset * 4);
+      ret = st20_y210_to_rfc4175_422be10(y, dst, meta->pg_cnt, 2);
+      break;
+    case ST_FRAME_FMT_V210:
+      ret = tx_st20p_v210_to_pkt(tx_st20p_pkt_src(src, 0, row, 0), dst, offset / 2,
+                                 meta->pg_cnt);
+      break;
+    case ST_FRAME_FMT_YUV422PLANAR12LE:
+      y = tx_st20p_pkt_src(src, 0, row, offset * 2);
+      b = tx_st20p_pkt_src(src, 1, row, offset);
+      r = tx_st20p_pkt_src(src, 2, row, offset);
+      ret = st20_yuv422p12le_to_rfc4175_422be12(y, b, r, dst, meta->pg_cnt, 2);
+      break;
+    case ST_FRAME_FMT_YUV444PLANAR10LE:
+    case ST_FRAME_FMT_GBRPLANAR10LE:
+    case ST_FRAME_FMT_YUV444PLANAR12LE:
+    case ST_FRAME_FMT_GBRPLANAR12LE:
+      /* the G, B, R planes for GBR */
+      y = tx_st20p_pkt_src(src, 0, row, offset * 2);
+      b = tx_st20p_pkt_src(src, 1, row, offset * 2);
+      r = tx_st20p_pkt_src(src, 2, row, offset * 2);
+      if (ctx->ops.input_fmt == ST_FRAME_FMT_YUV444PLANAR10LE) /* 4 pixels in one pg */
+        ret = st20_yuv444p10le_to_rfc4175_444be10(y, b, r, dst, meta->pg_cnt, 4);
+      else if (ctx->ops.input_fmt == ST_FRAME_FMT_GBRPLANAR10LE)
+        ret = st20_gbrp10le_to_rfc4175_444be10(y, b, r, dst, meta->pg_cnt, 4);
+      else if (ctx->ops.input_fmt == ST_FRAME_FMT_YUV444PLANAR12LE)
+        ret = st20_yuv444p12le_to_rfc4175_444be12(y, b, r, dst, meta->pg_cnt, 2);
+      else
+        ret = st20_gbrp12le_to_rfc4175_444be12(y, b, r, dst, meta->pg_cnt, 2);
+      break;
+    default:
+      ret = -EINVAL;
+      break;
+  }
+
+  if (ret < 0) rte_atomic32_inc(&ctx->stat_convert_fail);
   return ret;
 }
 
+/* the input formats can be converted on each packet for the transport format */
+static uint64_t tx_st20p_packet_convert_cap(enum st20_fmt transport_fmt) {
+  switch (transport_fmt) {
+    case ST20_FMT_YUV_422_10BIT:
+      return ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_Y210 | ST_FMT_CAP_V210;
+    case ST20_FMT_YUV_422_12BIT:
+      return ST_FMT_CAP_YUV422PLANAR12LE;
+    case ST20_FMT_YUV_444_10BIT:
+      return ST_FMT_CAP_YUV444PLANAR10LE;
+    case ST20_FMT_YUV_444_12BIT:
+      return ST_FMT_CAP_YUV444PLANAR12LE;
+    case ST20_FMT_RGB_10BIT:
+      return ST_FMT_CAP_GBRPLANAR10LE;
+    case ST20_FMT_RGB_12BIT:
+      return ST_FMT_CAP_GBRPLANAR12LE;
+    default:
+      return 0;
+  }
+}
+
+static int tx_st20p_query_lines_ready(void* priv, uint16_t frame_idx,
+                                      struct st20_tx_slice_meta* meta) {
+  struct st20p_tx_ctx* ctx = priv;
+  struct st20p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
+
+  meta->lines_ready = rte_atomic32_read(&framebuff->lines_ready);
+  return 0;
+}
+
+/* convert the lines in [start, end) only, all planes have full height lines */
+static int tx_st20p_convert_lines(struct st20p_tx_ctx* ctx,
+                                  struct st20p_tx_frame* framebuff, uint16_t start,
+                                  uint16_t end) {
+  struct st_frame src = framebuff->src;
+  struct st_frame dst = framebuff->dst;
+  int ret;
+
+  ret = st_frame_band_view(&src, start, end - start);
+  if (ret < 0) return ret;
+  ret = st_frame_band_view(&dst, start, end - start);
+  if (ret < 0) return ret;
+  return ctx->internal_converter->convert_func(&src, &dst);
+}
+
 static int tx_st20p_notify_event(void* priv, enum st_event event, void* args) {
   struct st20p_tx_ctx* ctx = priv;
 
@@ -142,19 +291,11 @@ static struct st20_convert_frame_meta* tx_st20p_convert_get_frame(void* priv) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      tx_st20p_next_available(ctx, ctx->framebuff_convert_idx, ST20P_TX_FRAME_READY);
-  /* not any free frame */
-  if (!framebuff) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
-  }
+  framebuff = tx_st20p_ring_get(ctx->ready_ring);
+  /* not any ready frame */
+  if (!framebuff) return NULL;
 
   framebuff->stat = ST20P_TX_FRAME_IN_CONVERTING;
-  /* point to next */
-  ctx->framebuff_convert_idx = tx_st20p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   return &framebuff->convert_frame;
@@ -182,13 +323,11 @@ static int tx_st20p_convert_put_frame(void* priv, struct st20_convert_frame_meta
   if ((result < 0) || (data_size <= 0)) {
     dbg("%s(%d), frame %u result %d data_size %" PRIu64 "\n", __func__, idx, convert_idx,
         result, data_size);
-    framebuff->stat = ST20P_TX_FRAME_FREE;
-    if (ctx->ops.notify_frame_available) { /* notify app */
-      ctx->ops.notify_frame_available(ctx->ops.priv);
-    }
+    tx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_TX_FRAME_FREE);
+    tx_st20p_notify_frame_available(ctx);
     rte_atomic32_inc(&ctx->stat_convert_fail);
   } else {
-    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
+    tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
   }
 
   return 0;
@@ -196,17 +335,12 @@ static int tx_st20p_convert_put_frame(void* priv, struct st20_convert_frame_meta
 
 static int tx_st20p_convert_dump(void* priv) {
   struct st20p_tx_ctx* ctx = priv;
-  struct st20p_tx_frame* framebuff = ctx->framebuffs;
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  uint16_t producer_idx = ctx->framebuff_producer_idx;
-  uint16_t convert_idx = ctx->framebuff_convert_idx;
-  uint16_t consumer_idx = ctx->framebuff_consumer_idx;
-  notice("TX_st20p(%s), p(%d:%s) cv(%d:%s) c(%d:%s)\n", ctx->ops_name, producer_idx,
-         tx_st20p_stat_name(framebuff[producer_idx].stat), convert_idx,
-         tx_st20p_stat_name(framebuff[convert_idx].stat), consumer_idx,
-         tx_st20p_stat_name(framebuff[consumer_idx].stat));
+  notice("TX_st20p(%s), free %u ready %u converted %u\n", ctx->ops_name,
+         rte_ring_count(ctx->free_ring), rte_ring_count(ctx->ready_ring),
+         rte_ring_count(ctx->converted_ring));
 
   int convert_fail = rte_atomic32_read(&ctx->stat_convert_fail);
   rte_atomic32_set(&ctx->stat_convert_fail, 0);
@@ -261,10 +395,12 @@ static int tx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_tx
   ops_tx.interlaced = ops->interlaced;
   ops_tx.linesize = ops->transport_linesize;
   ops_tx.payload_type = ops->port.payload_type;
-  ops_tx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_tx.type = ctx->slice ? ST20_TYPE_SLICE_LEVEL : ST20_TYPE_FRAME_LEVEL;
   ops_tx.framebuff_cnt = ops->framebuff_cnt;
   ops_tx.get_next_frame = tx_st20p_next_frame;
   ops_tx.notify_frame_done = tx_st20p_frame_done;
+  if (ctx->slice) ops_tx.query_frame_lines_ready = tx_st20p_query_lines_ready;
+  if (ctx->pkt_convert) ops_tx.uframe_pg_callback = tx_st20p_packet_convert;
   ops_tx.notify_event = tx_st20p_notify_event;
   if (ctx->derive && ops->flags & ST20P_TX_FLAG_EXT_FRAME)
     ops_tx.flags |= ST20_TX_FLAG_EXT_FRAME;
@@ -288,13 +424,16 @@ static int tx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_tx
 
   struct st20p_tx_frame* frames = ctx->framebuffs;
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    if (ctx->derive && ops->flags & ST20P_TX_FLAG_EXT_FRAME) {
+    if ((ctx->derive && ops->flags & ST20P_TX_FLAG_EXT_FRAME) || ctx->pkt_convert) {
+      /* no transport framebuffer for the pkt convert, see uframe_pg_callback */
       frames[i].dst.addr[0] = NULL;
     } else {
       frames[i].dst.addr[0] = st20_tx_get_framebuffer(transport, i);
     }
     frames[i].dst.fmt = st_frame_fmt_from_transport(ctx->ops.transport_fmt);
     frames[i].dst.interlaced = ops->interlaced;
+    frames[i].dst.color_matrix = ops->color_matrix;
+    frames[i].dst.color_full_range = ops->color_full_range;
     frames[i].dst.buffer_size =
         st_frame_size(frames[i].dst.fmt, ops->width, ops->height, ops->interlaced);
     frames[i].dst.data_size = frames[i].dst.buffer_size;
@@ -334,6 +473,19 @@ static int tx_st20p_uinit_src_fbs(struct st20p_tx_ctx* ctx) {
     ctx->framebuffs = NULL;
   }
 
+  if (ctx->free_ring) {
+    rte_ring_free(ctx->free_ring);
+    ctx->free_ring = NULL;
+  }
+  if (ctx->ready_ring) {
+    rte_ring_free(ctx->ready_ring);
+    ctx->ready_ring = NULL;
+  }
+  if (ctx->converted_ring) {
+    rte_ring_free(ctx->converted_ring);
+    ctx->converted_ring = NULL;
+  }
+
   return 0;
 }
 
@@ -353,11 +505,22 @@ static int tx_st20p_init_src_fbs(struct mtl_main_impl* impl, struct st20p_tx_ctx
   }
   ctx->framebuffs = frames;
 
+  ctx->free_ring = tx_st20p_ring_create(ctx, "FREE");
+  ctx->ready_ring = tx_st20p_ring_create(ctx, "READY");
+  ctx->converted_ring = tx_st20p_ring_create(ctx, "CONVERTED");
+  if (!ctx->free_ring || !ctx->ready_ring || !ctx->converted_ring) {
+    tx_st20p_uinit_src_fbs(ctx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    frames[i].stat = ST20P_TX_FRAME_FREE;
     frames[i].idx = i;
+    rte_atomic32_set(&frames[i].lines_ready, 0);
     frames[i].src.fmt = ops->input_fmt;
     frames[i].src.interlaced = ops->interlaced;
+    /* the convert reads the color from the YUV side, the src for a RGB transport */
+    frames[i].src.color_matrix = ops->color_matrix;
+    frames[i].src.color_full_range = ops->color_full_range;
     frames[i].src.width = ops->width;
     frames[i].src.height = ops->height;
     if (!ctx->derive) { /* when derive, no need to alloc src frames */
@@ -398,6 +561,7 @@ static int tx_st20p_init_src_fbs(struct mtl_main_impl* impl, struct st20p_tx_ctx
       tx_st20p_uinit_src_fbs(ctx);
       return -ENOMEM;
     }
+    tx_st20p_ring_put(ctx->free_ring, &frames[i], ST20P_TX_FRAME_FREE);
   }
   info("%s(%d), size %" PRIu64 " fmt %d with %u frames\n", __func__, idx, src_size,
        ops->transport_fmt, ctx->framebuff_cnt);
@@ -422,7 +586,9 @@ static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ct
   req.put_frame = tx_st20p_convert_put_frame;
   req.dump = tx_st20p_convert_dump;
 
-  struct st20_convert_session_impl* convert_impl = st20_get_converter(impl, &req);
+  /* slice level converts the lines in the put call, use the internal one */
+  struct st20_convert_session_impl* convert_impl = NULL;
+  if (!ctx->slice) convert_impl = st20_get_converter(impl, &req);
   if (req.device == ST_PLUGIN_DEVICE_TEST_INTERNAL || !convert_impl) {
     struct st_frame_converter* converter = NULL;
     converter = mt_rte_zmalloc_socket(sizeof(*converter), mt_socket_id(impl, MTL_PORT_P));
@@ -437,7 +603,27 @@ static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ct
       return -EIO;
     }
     ctx->internal_converter = converter;
+    ctx->internal_load = st20_get_internal_converter(impl, &req);
     info("%s(%d), use internal converter\n", __func__, idx);
+    /* slice level converts the lines in the put call, no worker */
+    if (ops->convert_worker_cnt && !ctx->slice) {
+      struct st20_convert_workers_ops workers_ops;
+      memset(&workers_ops, 0, sizeof(workers_ops));
+      workers_ops.name = ctx->ops_name;
+      workers_ops.worker_cnt = ops->convert_worker_cnt;
+      workers_ops.bind_lcore =
+          (ops->flags & ST20P_TX_FLAG_CONVERT_WORKER_LCORE) ? true : false;
+      workers_ops.converter = converter;
+      workers_ops.frame_cnt = ops->framebuff_cnt;
+      workers_ops.priv = ctx;
+      workers_ops.get_frame = tx_st20p_convert_get_frame;
+      workers_ops.put_frame = tx_st20p_convert_put_frame;
+      ctx->convert_workers = st20_convert_workers_create(impl, &workers_ops);
+      if (!ctx->convert_workers) {
+        err("%s(%d), convert workers create fail\n", __func__, idx);
+        return -EIO;
+      }
+    }
     return 0;
   }
   ctx->convert_impl = convert_impl;
@@ -457,19 +643,26 @@ struct st_frame* st20p_tx_get_frame(st20p_tx_handle handle) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      tx_st20p_next_available(ctx, ctx->framebuff_producer_idx, ST20P_TX_FRAME_FREE);
-  /* not any free frame */
-  if (!framebuff) {
+  mt_event_fd_ack(&ctx->event);
+
+  framebuff = tx_st20p_ring_get(ctx->free_ring);
+  if (!framebuff && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    framebuff = tx_st20p_ring_get(ctx->free_ring);
+    if (!framebuff) {
+      tx_st20p_block_wait(ctx);
+      framebuff = tx_st20p_ring_get(ctx->free_ring);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
     mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
   }
+  /* not any free frame */
+  if (!framebuff) return NULL;
 
   framebuff->stat = ST20P_TX_FRAME_IN_USER;
-  /* point to next */
-  ctx->framebuff_producer_idx = tx_st20p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
+  rte_atomic32_set(&framebuff->lines_ready, 0);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   struct st_frame* frame = tx_st20p_user_frame(ctx, framebuff);
@@ -493,6 +686,8 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame) {
     return -EIO;
   }
 
+  if (ctx->slice) return st20p_tx_put_frame_lines(handle, frame, ctx->ops.height);
+
   if (ST20P_TX_FRAME_IN_USER != framebuff->stat) {
     err("%s(%d), frame %u not in user %d\n", __func__, idx, producer_idx,
         framebuff->stat);
@@ -504,7 +699,7 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame) {
     if (frame->user_meta_size > framebuff->user_meta_buffer_size) {
       err("%s(%d), frame %u user meta size %" PRId64 " too large\n", __func__, idx,
           producer_idx, frame->user_meta_size);
-      framebuff->stat = ST20P_TX_FRAME_FREE;
+      tx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_TX_FRAME_FREE);
       return -EIO;
     }
 
@@ -513,13 +708,18 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame) {
     framebuff->user_meta_data_size = frame->user_meta_size;
   }
 
-  if (ctx->internal_converter) { /* convert internal */
+  if (ctx->pkt_convert) { /* convert on each pkt by the transport */
+    tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
+  } else if (ctx->convert_workers) { /* convert by the lib workers */
+    tx_st20p_ring_put(ctx->ready_ring, framebuff, ST20P_TX_FRAME_READY);
+    st20_convert_workers_notify(ctx->convert_workers);
+  } else if (ctx->internal_converter) { /* convert internal */
     ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
-    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
+    tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
   } else if (ctx->derive) {
-    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
+    tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
   } else {
-    framebuff->stat = ST20P_TX_FRAME_READY;
+    tx_st20p_ring_put(ctx->ready_ring, framebuff, ST20P_TX_FRAME_READY);
     st20_convert_notify_frame_ready(ctx->convert_impl);
   }
 
@@ -566,7 +766,7 @@ int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
     framebuff->dst.iova[0] = ext_frame->iova[0];
     framebuff->dst.opaque = ext_frame->opaque;
     framebuff->dst.flags |= ST_FRAME_FLAG_EXT_BUF;
-    framebuff->stat = ST20P_TX_FRAME_CONVERTED;
+    tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
   } else {
     for (int plane = 0; plane < planes; plane++) {
       framebuff->src.addr[plane] = ext_frame->addr[plane];
@@ -582,13 +782,18 @@ int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
           producer_idx);
       return -EIO;
     }
-    if (ctx->internal_converter) { /* convert internal */
+    if (ctx->pkt_convert) { /* convert on each pkt by the transport */
+      tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
+    } else if (ctx->convert_workers) { /* convert by the lib workers */
+      tx_st20p_ring_put(ctx->ready_ring, framebuff, ST20P_TX_FRAME_READY);
+      st20_convert_workers_notify(ctx->convert_workers);
+    } else if (ctx->internal_converter) { /* convert internal */
       ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
-      framebuff->stat = ST20P_TX_FRAME_CONVERTED;
       if (ctx->ops.notify_frame_done)
         ctx->ops.notify_frame_done(ctx->ops.priv, &framebuff->src);
+      tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
     } else {
-      framebuff->stat = ST20P_TX_FRAME_READY;
+      tx_st20p_ring_put(ctx->ready_ring, framebuff, ST20P_TX_FRAME_READY);
       st20_convert_notify_frame_ready(ctx->convert_impl);
     }
   }
@@ -597,6 +802,77 @@ int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
   return 0;
 }
 
+int st20p_tx_put_frame_lines(st20p_tx_handle handle, struct st_frame* frame,
+                             uint16_t lines_ready) {
+  struct st20p_tx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st20p_tx_frame* framebuff = frame->priv;
+  uint16_t producer_idx = framebuff->idx;
+  uint16_t lines_done;
+  int ret;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
+  }
+
+  if (!ctx->slice) {
+    err("%s(%d), SLICE_LEVEL flag not enabled\n", __func__, idx);
+    return -EIO;
+  }
+
+  if (lines_ready > ctx->ops.height) {
+    err("%s(%d), frame %u invalid lines_ready %u\n", __func__, idx, producer_idx,
+        lines_ready);
+    return -EINVAL;
+  }
+
+  lines_done = rte_atomic32_read(&framebuff->lines_ready);
+  if (ST20P_TX_FRAME_IN_USER == framebuff->stat) {
+    if (!lines_ready) return 0; /* nothing to publish */
+
+    framebuff->user_meta_data_size = 0;
+    if (frame->user_meta) {
+      if (frame->user_meta_size > framebuff->user_meta_buffer_size) {
+        err("%s(%d), frame %u user meta size %" PRId64 " too large\n", __func__, idx,
+            producer_idx, frame->user_meta_size);
+        tx_st20p_ring_put(ctx->free_ring, framebuff, ST20P_TX_FRAME_FREE);
+        return -EIO;
+      }
+
+      /* copy user meta to framebuff user_meta */
+      rte_memcpy(framebuff->user_meta, frame->user_meta, frame->user_meta_size);
+      framebuff->user_meta_data_size = frame->user_meta_size;
+    }
+  } else if (!lines_done || lines_done >= ctx->ops.height) {
+    /* only the published but not completed frame can be updated */
+    err("%s(%d), frame %u not in slice %d, lines %u\n", __func__, idx, producer_idx,
+        framebuff->stat, lines_done);
+    return -EIO;
+  }
+
+  if (lines_ready <= lines_done) return 0; /* no new lines */
+
+  if (ctx->internal_converter) { /* convert the new slice */
+    ret = tx_st20p_convert_lines(ctx, framebuff, lines_done, lines_ready);
+    if (ret < 0) {
+      /* the lines are not published, app can put them again */
+      err("%s(%d), frame %u convert lines %u:%u fail %d\n", __func__, idx, producer_idx,
+          lines_done, lines_ready, ret);
+      rte_atomic32_inc(&ctx->stat_convert_fail);
+      return ret;
+    }
+  }
+
+  rte_atomic32_set(&framebuff->lines_ready, lines_ready);
+  if (!lines_done) { /* first slice, the transport can pick it now */
+    tx_st20p_ring_put(ctx->converted_ring, framebuff, ST20P_TX_FRAME_CONVERTED);
+  }
+
+  dbg("%s(%d), frame %u lines %u succ\n", __func__, idx, producer_idx, lines_ready);
+  return 0;
+}
+
 st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
   static int st20p_tx_idx;
   struct mtl_main_impl* impl = mt;
@@ -612,11 +888,43 @@ st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
     return NULL;
   }
 
-  if (!ops->notify_frame_available) {
+  uint32_t no_notify_flags = ST20P_TX_FLAG_BLOCK_GET | ST20P_TX_FLAG_EVENT_FD;
+  if (!(ops->flags & no_notify_flags) && !ops->notify_frame_available) {
     err("%s, pls set notify_frame_available\n", __func__);
     return NULL;
   }
 
+  if (ops->flags & ST20P_TX_FLAG_SLICE_LEVEL) {
+    if (ops->interlaced || (ops->flags & ST20P_TX_FLAG_EXT_FRAME)) {
+      err("%s, slice level not support interlaced or ext frame\n", __func__);
+      return NULL;
+    }
+  }
+
+  if ((ops->flags & ST20P_TX_FLAG_PKT_CONVERT) &&
+      !st_frame_fmt_equal_transport(ops->input_fmt, ops->transport_fmt)) {
+    if (ops->flags & ST20P_TX_FLAG_SLICE_LEVEL) {
+      err("%s, packet convert not support slice level\n", __func__);
+      return NULL;
+    }
+    if (!(MTL_BIT64(ops->input_fmt) & tx_st20p_packet_convert_cap(ops->transport_fmt))) {
+      err("%s, %s to transport fmt %d not supported by packet convert\n", __func__,
+          st_frame_fmt_name(ops->input_fmt), ops->transport_fmt);
+      return NULL;
+    }
+    /* each v210 line should be whole 16 bytes blocks as the packet reads by line */
+    if (ops->input_fmt == ST_FRAME_FMT_V210 && (ops->width % 6)) {
+      err("%s, width %u not multiple of 6 for v210 packet convert\n", __func__,
+          ops->width);
+      return NULL;
+    }
+  }
+
+  if (ops->color_matrix >= ST_FRAME_COLOR_MATRIX_MAX) {
+    err("%s, invalid color matrix %d\n", __func__, ops->color_matrix);
+    return NULL;
+  }
+
   src_size = st_frame_size(ops->input_fmt, ops->width, ops->height, ops->interlaced);
   if (!src_size) {
     err("%s(%d), get src size fail\n", __func__, idx);
@@ -632,12 +940,20 @@ st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
   ctx->idx = idx;
   ctx->ready = false;
   ctx->derive = st_frame_fmt_equal_transport(ops->input_fmt, ops->transport_fmt);
+  ctx->slice = (ops->flags & ST20P_TX_FLAG_SLICE_LEVEL) ? true : false;
+  ctx->pkt_convert =
+      (!ctx->derive && (ops->flags & ST20P_TX_FLAG_PKT_CONVERT)) ? true : false;
   ctx->impl = impl;
   ctx->type = MT_ST20_HANDLE_PIPELINE_TX;
   ctx->src_size = src_size;
   rte_atomic32_set(&ctx->stat_convert_fail, 0);
   rte_atomic32_set(&ctx->stat_busy, 0);
   mt_pthread_mutex_init(&ctx->lock, NULL);
+  mt_pthread_cond_wait_init(&ctx->block_wake_cond);
+  rte_atomic32_set(&ctx->block_waiters, 0);
+  ctx->block_get = (ops->flags & ST20P_TX_FLAG_BLOCK_GET) ? true : false;
+  ctx->block_timeout_ns = ST_PIPELINE_BLOCK_TIMEOUT_NS;
+  ctx->event.fd = -1;
 
   /* copy ops */
   if (ops->name) {
@@ -647,8 +963,17 @@ st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
   }
   ctx->ops = *ops;
 
+  if (ops->flags & ST20P_TX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&ctx->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      st20p_tx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* get one suitable convert device */
-  if (!ctx->derive) {
+  if (!ctx->derive && !ctx->pkt_convert) {
     ret = tx_st20p_get_converter(impl, ctx, ops);
     if (ret < 0) {
       err("%s(%d), get converter fail %d\n", __func__, idx, ret);
@@ -679,9 +1004,7 @@ st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
          st20_frame_fmt_name(ops->transport_fmt), st_frame_fmt_name(ops->input_fmt));
   st20p_tx_idx++;
 
-  if (ctx->ops.notify_frame_available) { /* notify app */
-    ctx->ops.notify_frame_available(ctx->ops.priv);
-  }
+  tx_st20p_notify_frame_available(ctx);
 
   return ctx;
 }
@@ -697,12 +1020,19 @@ int st20p_tx_free(st20p_tx_handle handle) {
 
   notice("%s(%d), start\n", __func__, ctx->idx);
 
+  if (ctx->convert_workers) {
+    st20_convert_workers_free(ctx->convert_workers);
+    ctx->convert_workers = NULL;
+  }
+
   if (ctx->convert_impl) {
     st20_put_converter(impl, ctx->convert_impl);
     ctx->convert_impl = NULL;
   }
 
   if (ctx->internal_converter) {
+    st20_put_internal_converter(impl, ctx->internal_load);
+    ctx->internal_load = 0;
     mt_rte_free(ctx->internal_converter);
     ctx->internal_converter = NULL;
   }
@@ -714,6 +1044,8 @@ int st20p_tx_free(st20p_tx_handle handle) {
   tx_st20p_uinit_src_fbs(ctx);
 
   mt_pthread_mutex_destroy(&ctx->lock);
+  mt_pthread_cond_destroy(&ctx->block_wake_cond);
+  mt_event_fd_uinit(&ctx->event);
   notice("%s(%d), succ\n", __func__, ctx->idx);
   mt_rte_free(ctx);
 
@@ -787,3 +1119,47 @@ int st20p_tx_reset_port_stats(st20p_tx_handle handle, enum mtl_session_port port
 
   return st20_tx_reset_port_stats(ctx->transport, port);
 }
+
+int st20p_tx_wake_block(st20p_tx_handle handle) {
+  struct st20p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->block_get) tx_st20p_block_wake(ctx);
+
+  return 0;
+}
+
+int st20p_tx_set_block_timeout(st20p_tx_handle handle, uint64_t timedwait_ns) {
+  struct st20p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  ctx->block_timeout_ns = timedwait_ns;
+  return 0;
+}
+
+int st20p_tx_get_event_fd(st20p_tx_handle handle) {
+  struct st20p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST20_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, cidx);
+    return -EIO;
+  }
+
+  return ctx->event.fd;
+}
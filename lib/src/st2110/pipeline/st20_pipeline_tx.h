@@ -6,6 +6,7 @@
 #define _ST_LIB_PIPELINE_ST20_TX_HEAD_H_
 
 #include "../st_main.h"
+#include "st20_convert_worker.h"
 #include "st_plugin.h"
 
 enum st20p_tx_frame_status {
@@ -27,6 +28,7 @@ struct st20p_tx_frame {
   void* user_meta; /* the meta data from user */
   size_t user_meta_buffer_size;
   size_t user_meta_data_size;
+  rte_atomic32_t lines_ready; /* lines ready for transport in slice mode */
 };
 
 struct st20p_tx_ctx {
@@ -39,16 +41,31 @@ struct st20p_tx_ctx {
 
   st20_tx_handle transport;
   uint16_t framebuff_cnt;
-  uint16_t framebuff_producer_idx;
-  uint16_t framebuff_convert_idx;
-  uint16_t framebuff_consumer_idx;
   struct st20p_tx_frame* framebuffs;
-  pthread_mutex_t lock;
+  /* lock-free rings of framebuff pointer for each queued state */
+  struct rte_ring* free_ring;      /* ST20P_TX_FRAME_FREE */
+  struct rte_ring* ready_ring;     /* ST20P_TX_FRAME_READY */
+  struct rte_ring* converted_ring; /* ST20P_TX_FRAME_CONVERTED */
+  pthread_mutex_t lock;            /* only for the block wait */
 
   struct st20_convert_session_impl* convert_impl;
   struct st_frame_converter* internal_converter;
+  double internal_load; /* the load accounted to the internal converters */
+  struct st20_convert_workers* convert_workers; /* run the internal converter */
   bool ready;
+
+  /* for ST20P_TX_FLAG_BLOCK_GET, wait on lock */
+  bool block_get;
+  pthread_cond_t block_wake_cond;
+  rte_atomic32_t block_waiters; /* the block get waiting on block_wake_cond */
+  uint64_t block_timeout_ns;
+
+  /* for ST20P_TX_FLAG_EVENT_FD */
+  struct mt_event_fd event;
   bool derive; /* input_fmt == transport_fmt */
+  bool slice;  /* ST20P_TX_FLAG_SLICE_LEVEL */
+  /* ST20P_TX_FLAG_PKT_CONVERT, convert from src frame to payload of each pkt */
+  bool pkt_convert;
 
   size_t src_size;
 
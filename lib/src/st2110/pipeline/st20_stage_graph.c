@@ -0,0 +1,502 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include "st20_stage_graph.h"
+
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+
+static struct rte_ring* stage_ring_create(struct st20_stage* stage, const char* tag) {
+  struct st20_stage_graph* graph = stage->parent;
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST20SG%dS%d_%s", graph->idx, stage->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, stage->framebuff_cnt,
+                         mt_socket_id(graph->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%s), rte_ring_create %s fail\n", __func__, stage->name, ring_name);
+  return ring;
+}
+
+static inline void stage_ring_put(struct rte_ring* ring,
+                                  struct st20_stage_frame* framebuff) {
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
+}
+
+static inline struct st20_stage_frame* stage_ring_get(struct rte_ring* ring) {
+  struct st20_stage_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
+}
+
+static void stage_wake(struct st20_stage* stage) {
+  mt_pthread_mutex_lock(&stage->lock);
+  mt_pthread_cond_signal(&stage->wake_cond);
+  mt_pthread_mutex_unlock(&stage->lock);
+}
+
+static struct st_frame* stage_input_get(struct st20_stage* stage) {
+  struct st20_stage_graph* graph = stage->parent;
+  struct st20_stage_frame* framebuff;
+
+  if (!stage->idx) return graph->ops.get_frame(graph->ops.priv);
+
+  framebuff = stage_ring_get(graph->stages[stage->idx - 1].done_ring);
+  if (!framebuff) return NULL;
+  return &framebuff->frame;
+}
+
+static void stage_input_put(struct st20_stage* stage, struct st_frame* frame) {
+  struct st20_stage_graph* graph = stage->parent;
+  struct st20_stage* prev;
+
+  if (!stage->idx) {
+    graph->ops.put_frame(graph->ops.priv, frame);
+    return;
+  }
+
+  /* back to the previous stage as free output */
+  prev = &graph->stages[stage->idx - 1];
+  stage_ring_put(prev->free_ring, frame->priv);
+  stage_wake(prev);
+}
+
+/* get one input frame and one free output frame */
+static bool stage_get(struct st20_stage* stage, struct st_frame** src,
+                      struct st20_stage_frame** dst) {
+  struct st20_stage_frame* framebuff;
+  struct st_frame* frame = NULL;
+
+  /* the seq follows the input order as the workers get with seq_lock hold */
+  mt_pthread_mutex_lock(&stage->seq_lock);
+  framebuff = stage_ring_get(stage->free_ring);
+  if (framebuff) {
+    frame = stage_input_get(stage);
+    if (frame)
+      framebuff->seq = stage->seq_in++;
+    else
+      stage_ring_put(stage->free_ring, framebuff);
+  }
+  mt_pthread_mutex_unlock(&stage->seq_lock);
+  if (!frame) return false;
+
+  *src = frame;
+  *dst = framebuff;
+  return true;
+}
+
+/* the output is done, release the outputs to done_ring in the input order */
+static uint16_t stage_output_done(struct st20_stage* stage,
+                                  struct st20_stage_frame* framebuff, bool fail) {
+  struct st20_stage_reorder* reorder;
+  uint16_t released = 0;
+
+  mt_pthread_mutex_lock(&stage->seq_lock);
+  /*
+   * each seq in [seq_out, seq_in) holds one output frame until released, so the
+   * window is never larger than framebuff_cnt and the slot is not in use.
+   */
+  reorder = &stage->reorder[framebuff->seq % stage->framebuff_cnt];
+  reorder->framebuff = framebuff;
+  reorder->fail = fail;
+  reorder->done = true;
+  while (true) {
+    reorder = &stage->reorder[stage->seq_out % stage->framebuff_cnt];
+    if (!reorder->done) break;
+    if (reorder->fail) {
+      stage_ring_put(stage->free_ring, reorder->framebuff);
+    } else {
+      stage_ring_put(stage->done_ring, reorder->framebuff);
+      released++;
+    }
+    reorder->framebuff = NULL;
+    reorder->done = false;
+    stage->seq_out++;
+  }
+  mt_pthread_mutex_unlock(&stage->seq_lock);
+
+  return released;
+}
+
+static void stage_pass_meta(struct st_frame* src, struct st20_stage_frame* framebuff) {
+  struct st_frame* dst = &framebuff->frame;
+
+  dst->tfmt = src->tfmt;
+  dst->timestamp = src->timestamp;
+  dst->status = src->status;
+  dst->second_field = src->second_field;
+  dst->opaque = src->opaque;
+  if (src->user_meta && src->user_meta_size <= framebuff->user_meta_buffer_size) {
+    rte_memcpy(framebuff->user_meta, src->user_meta, src->user_meta_size);
+    dst->user_meta = framebuff->user_meta;
+    dst->user_meta_size = src->user_meta_size;
+  } else {
+    dst->user_meta = NULL;
+    dst->user_meta_size = 0;
+  }
+}
+
+static void* stage_worker_thread(void* arg) {
+  struct st20_stage_worker* worker = arg;
+  struct st20_stage* stage = worker->parent;
+  struct st20_stage_graph* graph = stage->parent;
+  bool last = (stage->idx == (graph->stages_cnt - 1));
+  struct st_frame* src;
+  struct st20_stage_frame* dst;
+  int ret;
+
+  info("%s(%s,%d), start\n", __func__, stage->name, worker->idx);
+  while (!rte_atomic32_read(&graph->stop)) {
+    if (!stage_get(stage, &src, &dst)) {
+      mt_pthread_mutex_lock(&stage->lock);
+      /* check again with lock hold to not miss the wake */
+      bool got = stage_get(stage, &src, &dst);
+      if (!got && !rte_atomic32_read(&graph->stop)) {
+        mt_pthread_cond_timedwait_ns(&stage->wake_cond, &stage->lock,
+                                     ST_PIPELINE_BLOCK_TIMEOUT_NS);
+      }
+      mt_pthread_mutex_unlock(&stage->lock);
+      if (!got) continue;
+    }
+
+    ret = stage->ops.process(stage->ops.priv, src, &dst->frame);
+    rte_atomic32_inc(&stage->stat_frames);
+    if (ret >= 0) stage_pass_meta(src, dst);
+    /* the input is not used anymore */
+    stage_input_put(stage, src);
+
+    if (ret < 0) {
+      dbg("%s(%s,%d), process fail %d\n", __func__, stage->name, worker->idx, ret);
+      rte_atomic32_inc(&stage->stat_fail);
+      /* still in the seq as the later outputs may wait on it */
+      if (!stage_output_done(stage, dst, true)) continue;
+    } else if (!stage_output_done(stage, dst, false)) {
+      /* wait the earlier inputs still in processing by other workers */
+      continue;
+    }
+
+    if (last)
+      graph->ops.notify_frame_available(graph->ops.priv);
+    else
+      stage_wake(&graph->stages[stage->idx + 1]);
+  }
+  info("%s(%s,%d), stop\n", __func__, stage->name, worker->idx);
+
+  return NULL;
+}
+
+int st20_stage_graph_notify(struct st20_stage_graph* graph) {
+  stage_wake(&graph->stages[0]);
+  return 0;
+}
+
+struct st_frame* st20_stage_graph_get_frame(struct st20_stage_graph* graph) {
+  struct st20_stage* stage = &graph->stages[graph->stages_cnt - 1];
+  struct st20_stage_frame* framebuff;
+
+  framebuff = stage_ring_get(stage->done_ring);
+  if (!framebuff) return NULL;
+  return &framebuff->frame;
+}
+
+int st20_stage_graph_put_frame(struct st20_stage_graph* graph, struct st_frame* frame) {
+  struct st20_stage* stage = &graph->stages[graph->stages_cnt - 1];
+  struct st20_stage_frame* framebuff = frame->priv;
+
+  if (!framebuff || framebuff->stage != stage) {
+    err("%s(%s), frame %p not from the last stage\n", __func__, graph->name, frame);
+    return -EIO;
+  }
+
+  stage_ring_put(stage->free_ring, framebuff);
+  stage_wake(stage);
+  return 0;
+}
+
+size_t st20_stage_graph_frame_size(struct st20_stage_graph* graph) {
+  return graph->stages[graph->stages_cnt - 1].frame_size;
+}
+
+static int stage_graph_stat(void* priv) {
+  struct st20_stage_graph* graph = priv;
+  struct st20_stage* stage;
+
+  for (uint8_t i = 0; i < graph->stages_cnt; i++) {
+    stage = &graph->stages[i];
+    int frames = rte_atomic32_read(&stage->stat_frames);
+    rte_atomic32_set(&stage->stat_frames, 0);
+    notice("%s(%s), stage %u(%s) frames %d, free %u done %u\n", __func__, graph->name, i,
+           stage->name, frames, rte_ring_count(stage->free_ring),
+           rte_ring_count(stage->done_ring));
+    int fail = rte_atomic32_read(&stage->stat_fail);
+    rte_atomic32_set(&stage->stat_fail, 0);
+    if (fail) {
+      notice("%s(%s), stage %u process fail %d\n", __func__, graph->name, i, fail);
+    }
+  }
+
+  return 0;
+}
+
+static void stage_uinit(struct st20_stage* stage) {
+  if (stage->framebuffs) {
+    for (uint16_t i = 0; i < stage->framebuff_cnt; i++) {
+      if (stage->framebuffs[i].frame.addr[0]) {
+        mt_rte_free(stage->framebuffs[i].frame.addr[0]);
+        stage->framebuffs[i].frame.addr[0] = NULL;
+      }
+      if (stage->framebuffs[i].user_meta) {
+        mt_rte_free(stage->framebuffs[i].user_meta);
+        stage->framebuffs[i].user_meta = NULL;
+      }
+    }
+    mt_rte_free(stage->framebuffs);
+    stage->framebuffs = NULL;
+  }
+
+  if (stage->free_ring) {
+    rte_ring_free(stage->free_ring);
+    stage->free_ring = NULL;
+  }
+  if (stage->done_ring) {
+    rte_ring_free(stage->done_ring);
+    stage->done_ring = NULL;
+  }
+  if (stage->reorder) {
+    mt_rte_free(stage->reorder);
+    stage->reorder = NULL;
+  }
+
+  mt_pthread_mutex_destroy(&stage->seq_lock);
+  mt_pthread_mutex_destroy(&stage->lock);
+  mt_pthread_cond_destroy(&stage->wake_cond);
+}
+
+static int stage_init(struct st20_stage_graph* graph, struct st20_stage* stage,
+                      struct st_frame* input) {
+  struct mtl_main_impl* impl = graph->impl;
+  int soc_id = mt_socket_id(impl, MTL_PORT_P);
+  struct st20p_stage_ops* ops = &stage->ops;
+  struct st20_stage_frame* frames;
+  struct st_frame* frame;
+  void* addr;
+
+  mt_pthread_mutex_init(&stage->lock, NULL);
+  mt_pthread_cond_wait_init(&stage->wake_cond);
+  mt_pthread_mutex_init(&stage->seq_lock, NULL);
+  stage->seq_in = 0;
+  stage->seq_out = 0;
+  rte_atomic32_set(&stage->stat_frames, 0);
+  rte_atomic32_set(&stage->stat_fail, 0);
+
+  if (!ops->width) ops->width = input->width;
+  if (!ops->height) ops->height = input->height;
+  stage->frame_size =
+      st_frame_size(ops->output_fmt, ops->width, ops->height, input->interlaced);
+  if (!stage->frame_size) {
+    err("%s(%s), get frame size fail, fmt %s\n", __func__, stage->name,
+        st_frame_fmt_name(ops->output_fmt));
+    return -EINVAL;
+  }
+  stage->framebuff_cnt = ops->framebuff_cnt ? ops->framebuff_cnt : graph->ops.framebuff_cnt;
+  stage->worker_cnt = ops->worker_cnt ? ops->worker_cnt : 1;
+
+  frames = mt_rte_zmalloc_socket(sizeof(*frames) * stage->framebuff_cnt, soc_id);
+  if (!frames) {
+    err("%s(%s), frames malloc fail\n", __func__, stage->name);
+    return -ENOMEM;
+  }
+  stage->framebuffs = frames;
+
+  stage->reorder =
+      mt_rte_zmalloc_socket(sizeof(*stage->reorder) * stage->framebuff_cnt, soc_id);
+  if (!stage->reorder) {
+    err("%s(%s), reorder malloc fail\n", __func__, stage->name);
+    return -ENOMEM;
+  }
+
+  stage->free_ring = stage_ring_create(stage, "FREE");
+  stage->done_ring = stage_ring_create(stage, "DONE");
+  if (!stage->free_ring || !stage->done_ring) return -ENOMEM;
+
+  for (uint16_t i = 0; i < stage->framebuff_cnt; i++) {
+    frames[i].idx = i;
+    frames[i].stage = stage;
+    frame = &frames[i].frame;
+    frame->fmt = ops->output_fmt;
+    frame->interlaced = input->interlaced;
+    frame->width = ops->width;
+    frame->height = ops->height;
+    addr = mt_rte_zmalloc_socket(stage->frame_size, soc_id);
+    if (!addr) {
+      err("%s(%s), frame malloc fail at %u\n", __func__, stage->name, i);
+      return -ENOMEM;
+    }
+    frame->buffer_size = stage->frame_size;
+    frame->data_size = stage->frame_size;
+    st_frame_init_plane_single_src(frame, addr, mtl_hp_virt2iova(impl, addr));
+    if (st_frame_sanity_check(frame) < 0) {
+      err("%s(%s), frame %u sanity check fail\n", __func__, stage->name, i);
+      return -EINVAL;
+    }
+    frame->priv = &frames[i];
+    /* init user meta */
+    frames[i].user_meta_buffer_size =
+        impl->pkt_udp_suggest_max_size - sizeof(struct st20_rfc4175_rtp_hdr);
+    frames[i].user_meta = mt_rte_zmalloc_socket(frames[i].user_meta_buffer_size, soc_id);
+    if (!frames[i].user_meta) {
+      err("%s(%s), user_meta malloc fail at %u\n", __func__, stage->name, i);
+      return -ENOMEM;
+    }
+    stage_ring_put(stage->free_ring, &frames[i]);
+  }
+
+  info("%s(%s), fmt %s %ux%u, size %" PRIu64 " with %u frames %u workers\n", __func__,
+       stage->name, st_frame_fmt_name(ops->output_fmt), ops->width, ops->height,
+       stage->frame_size, stage->framebuff_cnt, stage->worker_cnt);
+  return 0;
+}
+
+static int stage_start(struct st20_stage* stage) {
+  struct st20_stage_worker* worker;
+  int ret;
+
+  for (uint8_t i = 0; i < stage->worker_cnt; i++) {
+    worker = &stage->workers[i];
+    worker->parent = stage;
+    worker->idx = i;
+    ret = pthread_create(&worker->tid, NULL, stage_worker_thread, worker);
+    if (ret) {
+      err("%s(%s,%u), pthread_create fail %d\n", __func__, stage->name, i, ret);
+      return -ret;
+    }
+    worker->started = true;
+  }
+
+  return 0;
+}
+
+static void stage_stop(struct st20_stage* stage) {
+  struct st20_stage_worker* worker;
+
+  mt_pthread_mutex_lock(&stage->lock);
+  mt_pthread_cond_broadcast(&stage->wake_cond);
+  mt_pthread_mutex_unlock(&stage->lock);
+
+  for (uint8_t i = 0; i < stage->worker_cnt; i++) {
+    worker = &stage->workers[i];
+    if (worker->started) {
+      pthread_join(worker->tid, NULL);
+      worker->started = false;
+    }
+  }
+}
+
+int st20_stage_graph_free(struct st20_stage_graph* graph) {
+  if (graph->stat_registered) {
+    mt_stat_unregister(graph->impl, stage_graph_stat, graph);
+    graph->stat_registered = false;
+  }
+
+  /* stop all workers before any frame freed */
+  rte_atomic32_set(&graph->stop, 1);
+  for (uint8_t i = 0; i < graph->stages_cnt; i++) stage_stop(&graph->stages[i]);
+  for (uint8_t i = 0; i < graph->stages_cnt; i++) stage_uinit(&graph->stages[i]);
+
+  info("%s(%s), succ\n", __func__, graph->name);
+  mt_rte_free(graph);
+  return 0;
+}
+
+struct st20_stage_graph* st20_stage_graph_create(struct mtl_main_impl* impl,
+                                                 struct st20_stage_graph_ops* ops) {
+  /* the idx is in the ring names, unique even for the graphs created in parallel */
+  static rte_atomic32_t st20_stage_graph_idx;
+  struct st20_stage_graph* graph;
+  struct st20_stage* stage;
+  struct st20p_stage_ops* stage_ops;
+  struct st_frame input;
+  int ret;
+
+  if (!ops->stages_cnt || ops->stages_cnt > ST20P_STAGES_MAX) {
+    err("%s, invalid stages_cnt %u\n", __func__, ops->stages_cnt);
+    return NULL;
+  }
+  if (!ops->get_frame || !ops->put_frame || !ops->notify_frame_available) {
+    err("%s, invalid ops\n", __func__);
+    return NULL;
+  }
+  for (uint8_t i = 0; i < ops->stages_cnt; i++) {
+    stage_ops = &ops->stages[i];
+    if (!stage_ops->process) {
+      err("%s, pls set process for stage %u\n", __func__, i);
+      return NULL;
+    }
+    if (stage_ops->worker_cnt > ST20P_STAGE_WORKERS_MAX) {
+      err("%s, invalid worker_cnt %u for stage %u\n", __func__, stage_ops->worker_cnt,
+          i);
+      return NULL;
+    }
+    if (stage_ops->framebuff_cnt == 1) {
+      err("%s, invalid framebuff_cnt %u for stage %u\n", __func__,
+          stage_ops->framebuff_cnt, i);
+      return NULL;
+    }
+  }
+
+  graph = mt_rte_zmalloc_socket(sizeof(*graph), mt_socket_id(impl, MTL_PORT_P));
+  if (!graph) {
+    err("%s, graph malloc fail\n", __func__);
+    return NULL;
+  }
+  graph->impl = impl;
+  graph->idx = rte_atomic32_add_return(&st20_stage_graph_idx, 1) - 1;
+  graph->ops = *ops;
+  snprintf(graph->name, sizeof(graph->name), "%s", mt_string_safe(ops->name));
+  rte_atomic32_set(&graph->stop, 0);
+
+  /* the input of the first stage */
+  memset(&input, 0, sizeof(input));
+  input.fmt = ops->input_fmt;
+  input.width = ops->width;
+  input.height = ops->height;
+  input.interlaced = ops->interlaced;
+
+  graph->stages_cnt = ops->stages_cnt;
+  for (uint8_t i = 0; i < graph->stages_cnt; i++) {
+    stage = &graph->stages[i];
+    stage->parent = graph;
+    stage->idx = i;
+    stage->ops = ops->stages[i];
+    if (stage->ops.name)
+      snprintf(stage->name, sizeof(stage->name), "%s", stage->ops.name);
+    else
+      snprintf(stage->name, sizeof(stage->name), "%s_S%u", graph->name, i);
+    ret = stage_init(graph, stage, &input);
+    if (ret < 0) {
+      err("%s(%s), stage %u init fail %d\n", __func__, graph->name, i, ret);
+      graph->stages_cnt = i + 1;
+      st20_stage_graph_free(graph);
+      return NULL;
+    }
+    /* the output is the input of next stage */
+    input = stage->framebuffs[0].frame;
+  }
+
+  for (uint8_t i = 0; i < graph->stages_cnt; i++) {
+    ret = stage_start(&graph->stages[i]);
+    if (ret < 0) {
+      st20_stage_graph_free(graph);
+      return NULL;
+    }
+  }
+
+  mt_stat_register(impl, stage_graph_stat, graph, graph->name);
+  graph->stat_registered = true;
+
+  info("%s(%s), %u stages succ\n", __func__, graph->name, graph->stages_cnt);
+  return graph;
+}
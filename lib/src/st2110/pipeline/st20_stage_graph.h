@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_ST20_STAGE_GRAPH_HEAD_H_
+#define _ST_LIB_PIPELINE_ST20_STAGE_GRAPH_HEAD_H_
+
+#include "../st_main.h"
+
+struct st20_stage_graph_ops {
+  const char* name;
+  /* the input frame info of the first stage */
+  enum st_frame_fmt input_fmt;
+  uint32_t width;
+  uint32_t height;
+  bool interlaced;
+  /* the default output frame count of each stage */
+  uint16_t framebuff_cnt;
+  /* the stages in order, copied by the graph */
+  struct st20p_stage_ops* stages;
+  uint8_t stages_cnt;
+
+  /* the input of the first stage, should be mt safe */
+  void* priv;
+  struct st_frame* (*get_frame)(void* priv);
+  int (*put_frame)(void* priv, struct st_frame* frame);
+  /* the output frame of the last stage is available */
+  void (*notify_frame_available)(void* priv);
+};
+
+struct st20_stage;
+
+struct st20_stage_frame {
+  struct st_frame frame;
+  struct st20_stage* stage;
+  uint16_t idx;
+  uint64_t seq;    /* the input order of the frame in the stage */
+  void* user_meta; /* the user meta data passed from the input */
+  size_t user_meta_buffer_size;
+};
+
+struct st20_stage_worker {
+  struct st20_stage* parent;
+  int idx;
+  pthread_t tid;
+  bool started;
+};
+
+/* the processed output waits here until all the earlier inputs are done */
+struct st20_stage_reorder {
+  struct st20_stage_frame* framebuff;
+  bool done;
+  bool fail; /* the process fail, back to free_ring on release */
+};
+
+struct st20_stage_graph;
+
+struct st20_stage {
+  struct st20_stage_graph* parent;
+  int idx;
+  char name[ST_MAX_NAME_LEN];
+  struct st20p_stage_ops ops;
+  size_t frame_size;
+
+  uint16_t framebuff_cnt;
+  struct st20_stage_frame* framebuffs;
+  /* lock-free rings of the output frames */
+  struct rte_ring* free_ring; /* free to process */
+  struct rte_ring* done_ring; /* processed, for the next stage or user */
+
+  /* resequence the output of the workers into the input order, by seq_lock */
+  pthread_mutex_t seq_lock;
+  uint64_t seq_in;                    /* the seq for the next input */
+  uint64_t seq_out;                   /* the seq for the next output to done_ring */
+  struct st20_stage_reorder* reorder; /* framebuff_cnt slots, indexed by seq */
+
+  /* the workers wait on cond when no input or no free output frame */
+  pthread_mutex_t lock;
+  pthread_cond_t wake_cond;
+  uint8_t worker_cnt;
+  struct st20_stage_worker workers[ST20P_STAGE_WORKERS_MAX];
+
+  rte_atomic32_t stat_frames;
+  rte_atomic32_t stat_fail;
+};
+
+struct st20_stage_graph {
+  struct mtl_main_impl* impl;
+  int idx;
+  char name[ST_MAX_NAME_LEN];
+  struct st20_stage_graph_ops ops;
+  rte_atomic32_t stop;
+
+  uint8_t stages_cnt;
+  struct st20_stage stages[ST20P_STAGES_MAX];
+
+  bool stat_registered;
+};
+
+struct st20_stage_graph* st20_stage_graph_create(struct mtl_main_impl* impl,
+                                                 struct st20_stage_graph_ops* ops);
+int st20_stage_graph_free(struct st20_stage_graph* graph);
+/* new input frame for the first stage */
+int st20_stage_graph_notify(struct st20_stage_graph* graph);
+/* get/put the output frame of the last stage */
+struct st_frame* st20_stage_graph_get_frame(struct st20_stage_graph* graph);
+int st20_stage_graph_put_frame(struct st20_stage_graph* graph, struct st_frame* frame);
+size_t st20_stage_graph_frame_size(struct st20_stage_graph* graph);
+
+#endif
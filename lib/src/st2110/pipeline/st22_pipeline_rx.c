@@ -6,73 +6,204 @@
 
 #include "../../mt_log.h"
 
-static const char* st22p_rx_frame_stat_name[ST22P_RX_FRAME_STATUS_MAX] = {
-    "free", "ready", "in_decoding", "decoded", "in_user",
-};
-
-static const char* rx_st22p_stat_name(enum st22p_rx_frame_status stat) {
-  return st22p_rx_frame_stat_name[stat];
+static struct rte_ring* rx_st22p_ring_create(struct st22p_rx_ctx* ctx, const char* tag) {
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST22PRX%d_%s", ctx->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, ctx->framebuff_cnt,
+                         mt_socket_id(ctx->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%d), rte_ring_create %s fail\n", __func__, ctx->idx, ring_name);
+  return ring;
 }
 
-static uint16_t rx_st22p_next_idx(struct st22p_rx_ctx* ctx, uint16_t idx) {
-  /* point to next */
-  uint16_t next_idx = idx;
-  next_idx++;
-  if (next_idx >= ctx->framebuff_cnt) next_idx = 0;
-  return next_idx;
+/* move the frame to the desired state ring */
+static inline void rx_st22p_ring_put(struct rte_ring* ring,
+                                     struct st22p_rx_frame* framebuff,
+                                     enum st22p_rx_frame_status stat) {
+  framebuff->stat = stat;
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
 }
 
-static struct st22p_rx_frame* rx_st22p_next_available(
-    struct st22p_rx_ctx* ctx, uint16_t idx_start, enum st22p_rx_frame_status desired) {
-  uint16_t idx = idx_start;
+static inline struct st22p_rx_frame* rx_st22p_ring_get(struct rte_ring* ring) {
   struct st22p_rx_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
+}
 
-  /* check ready frame from idx_start */
-  while (1) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == framebuff->stat) {
-      /* find one desired */
-      return framebuff;
-    }
-    idx = rx_st22p_next_idx(ctx, idx);
-    if (idx == idx_start) {
-      /* loop all frames end */
-      break;
-    }
+static void rx_st22p_block_wake(struct st22p_rx_ctx* ctx) {
+  /* order the frame enqueue before the waiters read */
+  rte_smp_mb();
+  /* only lock and signal when any block get is waiting */
+  if (!rte_atomic32_read(&ctx->block_waiters)) return;
+  mt_pthread_mutex_lock(&ctx->lock);
+  mt_pthread_cond_signal(&ctx->block_wake_cond);
+  mt_pthread_mutex_unlock(&ctx->lock);
+}
+
+static void rx_st22p_notify_frame_available(struct st22p_rx_ctx* ctx) {
+  if (ctx->ops.notify_frame_available) { /* notify app */
+    ctx->ops.notify_frame_available(ctx->ops.priv);
+  }
+
+  if (ctx->block_get) rx_st22p_block_wake(ctx);
+
+  mt_event_fd_notify(&ctx->event);
+}
+
+/* wait until any frame status change or timeout, ctx->lock should be locked */
+static void rx_st22p_block_wait(struct st22p_rx_ctx* ctx) {
+  dbg("%s(%d), start\n", __func__, ctx->idx);
+  mt_pthread_cond_timedwait_ns(&ctx->block_wake_cond, &ctx->lock, ctx->block_timeout_ns);
+  dbg("%s(%d), end\n", __func__, ctx->idx);
+}
+
+static void rx_st22p_init_src(struct st22p_rx_frame* framebuff, void* frame,
+                              enum st10_timestamp_fmt tfmt, uint64_t timestamp) {
+  framebuff->src.addr[0] = frame;
+  framebuff->src.tfmt = tfmt;
+  framebuff->src.timestamp = timestamp;
+  framebuff->dst.tfmt = tfmt;
+  /* set dst timestamp to same as src? */
+  framebuff->dst.timestamp = timestamp;
+}
+
+/* drop the session ref of the frame, free it if the decoder doesn't hold the dst */
+static void rx_st22p_frame_free(struct st22p_rx_ctx* ctx,
+                                struct st22p_rx_frame* framebuff) {
+  st22_rx_put_framebuff(ctx->transport, framebuff->src.addr[0]);
+  framebuff->stat = ST22P_RX_FRAME_HELD;
+  if (rte_atomic32_dec_and_test(&framebuff->dst_refcnt))
+    rx_st22p_ring_put(ctx->free_ring, framebuff, ST22P_RX_FRAME_FREE);
+}
+
+/* the decoded frame is done, move to decoded or free */
+static void rx_st22p_decode_done(struct st22p_rx_ctx* ctx,
+                                 struct st22p_rx_frame* framebuff, int result) {
+  bool drop = false;
+
+  if (result < 0) {
+    drop = true;
+    rte_atomic32_inc(&ctx->stat_decode_fail);
+  } else if (ctx->slice && !st_is_frame_complete(framebuff->src.status) &&
+             !(ctx->ops.flags & ST22P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)) {
+    /* the incomplete frame is decoded already in slice mode */
+    drop = true;
+    rte_atomic32_inc(&ctx->stat_drop_incomplete);
   }
 
-  /* no any desired frame */
+  if (drop) {
+    /* free the frame */
+    rx_st22p_frame_free(ctx, framebuff);
+  } else {
+    rx_st22p_ring_put(ctx->decoded_ring, framebuff, ST22P_RX_FRAME_DECODED);
+    rx_st22p_notify_frame_available(ctx);
+  }
+}
+
+/* the frame whose codestream is passed to the decoder in receiving */
+static struct st22p_rx_frame* rx_st22p_slice_frame(struct st22p_rx_ctx* ctx,
+                                                   void* frame) {
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    if (ctx->framebuffs[i].slice_src == frame) return &ctx->framebuffs[i];
+  }
   return NULL;
 }
 
+static int rx_st22p_slice_ready(void* priv, void* frame,
+                                struct st22_rx_slice_meta* meta) {
+  struct st22p_rx_ctx* ctx = priv;
+  struct st22p_rx_frame* framebuff;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  framebuff = rx_st22p_slice_frame(ctx, frame);
+  if (framebuff) {
+    rte_atomic64_set(&framebuff->bytes_ready, meta->frame_recv_size);
+    st22_decode_notify_frame_ready(ctx->decode_impl);
+    return 0;
+  }
+
+  /* the first slice, pass to the decoder now */
+  framebuff = rx_st22p_ring_get(ctx->free_ring);
+  /* not any free frame, try again on next slice */
+  if (!framebuff) return -EBUSY;
+
+  rx_st22p_init_src(framebuff, frame, meta->tfmt, meta->timestamp);
+  framebuff->src.data_size = 0; /* unknown until the frame complete */
+  framebuff->src.status = ST_FRAME_STATUS_COMPLETE;
+  framebuff->slice_src = frame;
+  rte_atomic64_set(&framebuff->bytes_ready, meta->frame_recv_size);
+  rte_atomic32_set(&framebuff->slice_state, ST22P_RX_SLICE_RECEIVING);
+  rx_st22p_ring_put(ctx->ready_ring, framebuff, ST22P_RX_FRAME_READY);
+
+  dbg("%s(%d), frame %u start with %" PRIu64 " bytes\n", __func__, ctx->idx,
+      framebuff->idx, meta->frame_recv_size);
+  st22_decode_notify_frame_ready(ctx->decode_impl);
+  return 0;
+}
+
+/* the codestream of the frame in decoding is fully received */
+static void rx_st22p_slice_complete(struct st22p_rx_ctx* ctx,
+                                    struct st22p_rx_frame* framebuff,
+                                    struct st22_rx_frame_meta* meta) {
+  framebuff->slice_src = NULL;
+  framebuff->src.data_size = meta->frame_total_size;
+  framebuff->src.status = meta->status;
+  rte_atomic64_set(&framebuff->bytes_ready, meta->frame_total_size);
+  rte_smp_wmb();
+  if (rte_atomic32_cmpset((volatile uint32_t*)&framebuff->slice_state.cnt,
+                          ST22P_RX_SLICE_RECEIVING, ST22P_RX_SLICE_COMPLETE)) {
+    st22_decode_notify_frame_ready(ctx->decode_impl);
+  } else {
+    /* the decoder put it already, the transport frame can be used now */
+    rx_st22p_decode_done(ctx, framebuff, framebuff->decode_result);
+  }
+}
+
 static int rx_st22p_frame_ready(void* priv, void* frame,
                                 struct st22_rx_frame_meta* meta) {
   struct st22p_rx_ctx* ctx = priv;
   struct st22p_rx_frame* framebuff;
+  bool complete = st_is_frame_complete(meta->status);
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      rx_st22p_next_available(ctx, ctx->framebuff_producer_idx, ST22P_RX_FRAME_FREE);
+  if (ctx->slice) {
+    framebuff = rx_st22p_slice_frame(ctx, frame);
+    if (framebuff) { /* in the decoder already */
+      rx_st22p_slice_complete(ctx, framebuff, meta);
+      return 0;
+    }
+    /* the transport passes all incomplete frames in slice mode */
+    if (!complete && !(ctx->ops.flags & ST22P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)) {
+      rte_atomic32_inc(&ctx->stat_drop_incomplete);
+      st22_rx_put_framebuff(ctx->transport, frame);
+      return 0;
+    }
+  }
+
+  framebuff = rx_st22p_ring_get(ctx->free_ring);
   /* not any free frame */
   if (!framebuff) {
     rte_atomic32_inc(&ctx->stat_busy);
-    mt_pthread_mutex_unlock(&ctx->lock);
+    /* the transport only frees the complete frame if fail */
+    if (!complete) st22_rx_put_framebuff(ctx->transport, frame);
     return -EBUSY;
   }
 
-  framebuff->src.addr[0] = frame;
+  rx_st22p_init_src(framebuff, frame, meta->tfmt, meta->timestamp);
   framebuff->src.data_size = meta->frame_total_size;
-  framebuff->src.tfmt = meta->tfmt;
-  framebuff->src.timestamp = meta->timestamp;
-  framebuff->dst.tfmt = meta->tfmt;
-  /* set dst timestamp to same as src? */
-  framebuff->dst.timestamp = meta->timestamp;
-  framebuff->stat = ST22P_RX_FRAME_READY;
-  /* point to next */
-  ctx->framebuff_producer_idx = rx_st22p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
+  framebuff->src.status = meta->status;
+  if (ctx->segs) {
+    framebuff->decode_frame.src_segs = meta->segs;
+    framebuff->decode_frame.src_segs_cnt = meta->segs_cnt;
+  }
+  rte_atomic64_set(&framebuff->bytes_ready, meta->frame_total_size);
+  rte_atomic32_set(&framebuff->slice_state, ST22P_RX_SLICE_COMPLETE);
+  rx_st22p_ring_put(ctx->ready_ring, framebuff, ST22P_RX_FRAME_READY);
 
   dbg("%s(%d), frame %u succ\n", __func__, ctx->idx, framebuff->idx);
   st22_decode_notify_frame_ready(ctx->decode_impl);
@@ -102,24 +233,48 @@ static struct st22_decode_frame_meta* rx_st22p_decode_get_frame(void* priv) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      rx_st22p_next_available(ctx, ctx->framebuff_decode_idx, ST22P_RX_FRAME_READY);
+  framebuff = rx_st22p_ring_get(ctx->ready_ring);
   /* not any ready frame */
-  if (!framebuff) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
-  }
+  if (!framebuff) return NULL;
 
   framebuff->stat = ST22P_RX_FRAME_IN_DECODING;
-  /* point to next */
-  ctx->framebuff_decode_idx = rx_st22p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
+  rte_atomic32_set(&framebuff->dst_refcnt, 1);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   return &framebuff->decode_frame;
 }
 
+static int rx_st22p_decode_hold_frame(void* priv, struct st22_decode_frame_meta* frame) {
+  struct st22p_rx_ctx* ctx = priv;
+  struct st22p_rx_frame* framebuff = frame->priv;
+
+  if (ST22P_RX_FRAME_IN_DECODING != framebuff->stat) {
+    err("%s(%d), frame %u not in decoding %d\n", __func__, ctx->idx, framebuff->idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  rte_atomic32_inc(&framebuff->dst_refcnt);
+  return 0;
+}
+
+static int rx_st22p_decode_release_frame(void* priv,
+                                         struct st22_decode_frame_meta* frame) {
+  struct st22p_rx_ctx* ctx = priv;
+  struct st22p_rx_frame* framebuff = frame->priv;
+
+  if (!rte_atomic32_read(&framebuff->dst_refcnt)) {
+    err("%s(%d), frame %u not held\n", __func__, ctx->idx, framebuff->idx);
+    return -EIO;
+  }
+
+  if (rte_atomic32_dec_and_test(&framebuff->dst_refcnt)) {
+    dbg("%s(%d), frame %u back to free\n", __func__, ctx->idx, framebuff->idx);
+    rx_st22p_ring_put(ctx->free_ring, framebuff, ST22P_RX_FRAME_FREE);
+  }
+  return 0;
+}
+
 static int rx_st22p_decode_put_frame(void* priv, struct st22_decode_frame_meta* frame,
                                      int result) {
   struct st22p_rx_ctx* ctx = priv;
@@ -139,34 +294,36 @@ static int rx_st22p_decode_put_frame(void* priv, struct st22_decode_frame_meta*
   }
 
   dbg("%s(%d), frame %u result %d\n", __func__, idx, decode_idx, result);
-  if (result < 0) {
-    /* free the frame */
-    st22_rx_put_framebuff(ctx->transport, framebuff->src.addr[0]);
-    framebuff->stat = ST22P_RX_FRAME_FREE;
-    rte_atomic32_inc(&ctx->stat_decode_fail);
-  } else {
-    framebuff->stat = ST22P_RX_FRAME_DECODED;
-    if (ctx->ops.notify_frame_available) { /* notify app */
-      ctx->ops.notify_frame_available(ctx->ops.priv);
-    }
+  framebuff->decode_result = result;
+  if (rte_atomic32_cmpset((volatile uint32_t*)&framebuff->slice_state.cnt,
+                          ST22P_RX_SLICE_RECEIVING, ST22P_RX_SLICE_DECODE_DONE)) {
+    /* the transport still writes the frame, done once it's complete */
+    dbg("%s(%d), frame %u put before receive complete\n", __func__, idx, decode_idx);
+    return 0;
   }
 
+  rx_st22p_decode_done(ctx, framebuff, result);
   return 0;
 }
 
+static size_t rx_st22p_decode_get_frame_bytes(void* priv,
+                                              struct st22_decode_frame_meta* frame,
+                                              bool* complete) {
+  struct st22p_rx_frame* framebuff = frame->priv;
+
+  *complete = (rte_atomic32_read(&framebuff->slice_state) != ST22P_RX_SLICE_RECEIVING);
+  rte_smp_rmb();
+  return rte_atomic64_read(&framebuff->bytes_ready);
+}
+
 static int rx_st22p_decode_dump(void* priv) {
   struct st22p_rx_ctx* ctx = priv;
-  struct st22p_rx_frame* framebuff = ctx->framebuffs;
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  uint16_t producer_idx = ctx->framebuff_producer_idx;
-  uint16_t decode_idx = ctx->framebuff_decode_idx;
-  uint16_t consumer_idx = ctx->framebuff_consumer_idx;
-  notice("RX_ST22P(%s), p(%d:%s) d(%d:%s) c(%d:%s)\n", ctx->ops_name, producer_idx,
-         rx_st22p_stat_name(framebuff[producer_idx].stat), decode_idx,
-         rx_st22p_stat_name(framebuff[decode_idx].stat), consumer_idx,
-         rx_st22p_stat_name(framebuff[consumer_idx].stat));
+  notice("RX_ST22P(%s), free %u ready %u decoded %u\n", ctx->ops_name,
+         rte_ring_count(ctx->free_ring), rte_ring_count(ctx->ready_ring),
+         rte_ring_count(ctx->decoded_ring));
 
   int decode_fail = rte_atomic32_read(&ctx->stat_decode_fail);
   rte_atomic32_set(&ctx->stat_decode_fail, 0);
@@ -180,6 +337,12 @@ static int rx_st22p_decode_dump(void* priv) {
     notice("RX_ST22P(%s), busy drop frame %d\n", ctx->ops_name, busy);
   }
 
+  int drop_incomplete = rte_atomic32_read(&ctx->stat_drop_incomplete);
+  rte_atomic32_set(&ctx->stat_drop_incomplete, 0);
+  if (drop_incomplete) {
+    notice("RX_ST22P(%s), incomplete drop frame %d\n", ctx->ops_name, drop_incomplete);
+  }
+
   return 0;
 }
 
@@ -203,12 +366,20 @@ static int rx_st22p_create_transport(struct mtl_main_impl* impl, struct st22p_rx
   if (ops->flags & ST22P_RX_FLAG_ENABLE_VSYNC) ops_rx.flags |= ST22_RX_FLAG_ENABLE_VSYNC;
   if (ops->flags & ST22P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)
     ops_rx.flags |= ST22_RX_FLAG_RECEIVE_INCOMPLETE_FRAME;
+  if (ctx->segs) ops_rx.flags |= ST22_RX_FLAG_CODESTREAM_SEGMENTS;
   ops_rx.pacing = ST21_PACING_NARROW;
+  if (ctx->slice) {
+    ops_rx.type = ST22_TYPE_SLICE_LEVEL;
+    ops_rx.notify_slice_ready = rx_st22p_slice_ready;
+    /* the frame in decoding should be always notified */
+    ops_rx.flags |= ST22_RX_FLAG_RECEIVE_INCOMPLETE_FRAME;
+  } else {
+    ops_rx.type = ST22_TYPE_FRAME_LEVEL;
+  }
   ops_rx.width = ops->width;
   ops_rx.height = ops->height;
   ops_rx.fps = ops->fps;
   ops_rx.payload_type = ops->port.payload_type;
-  ops_rx.type = ST22_TYPE_FRAME_LEVEL;
   ops_rx.pack_type = ops->pack_type;
   ops_rx.framebuff_cnt = ops->framebuff_cnt;
   ops_rx.framebuff_max_size = ctx->max_codestream_size;
@@ -251,9 +422,40 @@ static int rx_st22p_uinit_dst_fbs(struct st22p_rx_ctx* ctx) {
     ctx->framebuffs = NULL;
   }
 
+  if (ctx->free_ring) {
+    rte_ring_free(ctx->free_ring);
+    ctx->free_ring = NULL;
+  }
+  if (ctx->ready_ring) {
+    rte_ring_free(ctx->ready_ring);
+    ctx->ready_ring = NULL;
+  }
+  if (ctx->decoded_ring) {
+    rte_ring_free(ctx->decoded_ring);
+    ctx->decoded_ring = NULL;
+  }
+
   return 0;
 }
 
+static void rx_st22p_init_dst_planes(struct st22p_rx_ctx* ctx, struct st_frame* frame,
+                                     void* addr, mtl_iova_t iova) {
+  uint8_t planes = st_frame_fmt_planes(frame->fmt);
+  size_t offset = 0;
+
+  if (!ctx->dst_padded) {
+    st_frame_init_plane_single_src(frame, addr, iova);
+    return;
+  }
+
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    frame->linesize[plane] = ctx->dst_linesize[plane];
+    frame->addr[plane] = addr + offset;
+    frame->iova[plane] = iova + offset;
+    offset += frame->linesize[plane] * (frame->height + ctx->dst_pad_lines);
+  }
+}
+
 static int rx_st22p_init_dst_fbs(struct mtl_main_impl* impl, struct st22p_rx_ctx* ctx,
                                  struct st22p_rx_ops* ops) {
   int idx = ctx->idx;
@@ -270,8 +472,15 @@ static int rx_st22p_init_dst_fbs(struct mtl_main_impl* impl, struct st22p_rx_ctx
   }
   ctx->framebuffs = frames;
 
+  ctx->free_ring = rx_st22p_ring_create(ctx, "FREE");
+  ctx->ready_ring = rx_st22p_ring_create(ctx, "READY");
+  ctx->decoded_ring = rx_st22p_ring_create(ctx, "DECODED");
+  if (!ctx->free_ring || !ctx->ready_ring || !ctx->decoded_ring) {
+    rx_st22p_uinit_dst_fbs(ctx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    frames[i].stat = ST22P_RX_FRAME_FREE;
     frames[i].idx = i;
     dst = mt_rte_zmalloc_socket(dst_size, soc_id);
     if (!dst) {
@@ -286,13 +495,14 @@ static int rx_st22p_init_dst_fbs(struct mtl_main_impl* impl, struct st22p_rx_ctx
     frames[i].dst.height = ops->height;
     frames[i].dst.priv = &frames[i];
     /* init plane */
-    st_frame_init_plane_single_src(&frames[i].dst, dst, mtl_hp_virt2iova(ctx->impl, dst));
+    rx_st22p_init_dst_planes(ctx, &frames[i].dst, dst, mtl_hp_virt2iova(ctx->impl, dst));
     /* check plane */
     if (st_frame_sanity_check(&frames[i].dst) < 0) {
       err("%s(%d), dst frame %d sanity check fail\n", __func__, idx, i);
       rx_st22p_uinit_dst_fbs(ctx);
       return -EINVAL;
     }
+    rx_st22p_ring_put(ctx->free_ring, &frames[i], ST22P_RX_FRAME_FREE);
   }
 
   info("%s(%d), size %" PRIu64 " fmt %d with %u frames\n", __func__, idx, dst_size,
@@ -314,10 +524,15 @@ static int rx_st22p_get_decoder(struct mtl_main_impl* impl, struct st22p_rx_ctx*
   req.req.input_fmt = ctx->codestream_fmt;
   req.req.framebuff_cnt = ops->framebuff_cnt;
   req.req.codec_thread_cnt = ops->codec_thread_cnt;
+  if (ops->flags & ST22P_RX_FLAG_SLICE_LEVEL) req.req.slice_level = true;
+  if (ops->flags & ST22P_RX_FLAG_CODESTREAM_SEGMENTS) req.req.codestream_segs = true;
   req.priv = ctx;
   req.get_frame = rx_st22p_decode_get_frame;
   req.put_frame = rx_st22p_decode_put_frame;
   req.dump = rx_st22p_decode_dump;
+  req.get_frame_bytes = rx_st22p_decode_get_frame_bytes;
+  req.hold_frame = rx_st22p_decode_hold_frame;
+  req.release_frame = rx_st22p_decode_release_frame;
 
   struct st22_decode_session_impl* decode_impl = st22_get_decoder(impl, &req);
   if (!decode_impl) {
@@ -326,6 +541,49 @@ static int rx_st22p_get_decoder(struct mtl_main_impl* impl, struct st22p_rx_ctx*
   }
   ctx->decode_impl = decode_impl;
 
+  if (req.req.slice_level) {
+    if (req.req.slice_enabled)
+      ctx->slice = true;
+    else
+      warn("%s(%d), decoder not support slice, fallback to frame level\n", __func__,
+           idx);
+  }
+
+  if (req.req.codestream_segs) {
+    if (req.req.segs_enabled)
+      ctx->segs = true;
+    else
+      warn("%s(%d), decoder not support codestream segments, fallback to copy\n",
+           __func__, idx);
+  }
+
+  /*
+   * the decoder writes into the dst frame directly, follow the layout it required only
+   * if the app accepts it as the public geometry of the frames changes.
+   */
+  uint32_t align = req.req.dst_linesize_align;
+  if ((align || req.req.dst_pad_lines) &&
+      !(ops->flags & ST22P_RX_FLAG_DECODER_DST_LAYOUT)) {
+    info("%s(%d), keep the compact dst layout, decoder align %u pad lines %u\n",
+         __func__, idx, align, req.req.dst_pad_lines);
+  } else if (align || req.req.dst_pad_lines) {
+    uint8_t planes = st_frame_fmt_planes(ops->output_fmt);
+    size_t dst_size = 0;
+
+    if (!align) align = 1;
+    for (uint8_t plane = 0; plane < planes; plane++) {
+      size_t linesize = st_frame_least_linesize(ops->output_fmt, ops->width, plane);
+      linesize = (linesize + align - 1) / align * align;
+      ctx->dst_linesize[plane] = linesize;
+      dst_size += linesize * (ops->height + req.req.dst_pad_lines);
+    }
+    ctx->dst_padded = true;
+    ctx->dst_pad_lines = req.req.dst_pad_lines;
+    ctx->dst_size = dst_size;
+    info("%s(%d), dst linesize align %u pad lines %u, size %" PRIu64 "\n", __func__, idx,
+         align, ctx->dst_pad_lines, ctx->dst_size);
+  }
+
   return 0;
 }
 
@@ -341,19 +599,25 @@ struct st_frame* st22p_rx_get_frame(st22p_rx_handle handle) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      rx_st22p_next_available(ctx, ctx->framebuff_consumer_idx, ST22P_RX_FRAME_DECODED);
-  /* not any decoded frame */
-  if (!framebuff) {
+  mt_event_fd_ack(&ctx->event);
+
+  framebuff = rx_st22p_ring_get(ctx->decoded_ring);
+  if (!framebuff && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    framebuff = rx_st22p_ring_get(ctx->decoded_ring);
+    if (!framebuff) {
+      rx_st22p_block_wait(ctx);
+      framebuff = rx_st22p_ring_get(ctx->decoded_ring);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
     mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
   }
+  /* not any decoded frame */
+  if (!framebuff) return NULL;
 
   framebuff->stat = ST22P_RX_FRAME_IN_USER;
-  /* point to next */
-  ctx->framebuff_consumer_idx = rx_st22p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   return &framebuff->dst;
@@ -377,8 +641,7 @@ int st22p_rx_put_frame(st22p_rx_handle handle, struct st_frame* frame) {
   }
 
   /* free the frame */
-  st22_rx_put_framebuff(ctx->transport, framebuff->src.addr[0]);
-  framebuff->stat = ST22P_RX_FRAME_FREE;
+  rx_st22p_frame_free(ctx, framebuff);
   dbg("%s(%d), frame %u succ\n", __func__, idx, consumer_idx);
 
   return 0;
@@ -400,11 +663,18 @@ st22p_rx_handle st22p_rx_create(mtl_handle mt, struct st22p_rx_ops* ops) {
     return NULL;
   }
 
-  if (!ops->notify_frame_available) {
+  uint32_t no_notify_flags = ST22P_RX_FLAG_BLOCK_GET | ST22P_RX_FLAG_EVENT_FD;
+  if (!(ops->flags & no_notify_flags) && !ops->notify_frame_available) {
     err("%s, pls set notify_frame_available\n", __func__);
     return NULL;
   }
 
+  if ((ops->flags & ST22P_RX_FLAG_SLICE_LEVEL) &&
+      (ops->flags & ST22P_RX_FLAG_CODESTREAM_SEGMENTS)) {
+    err("%s, codestream segments not support slice level\n", __func__);
+    return NULL;
+  }
+
   dst_size = st_frame_size(ops->output_fmt, ops->width, ops->height, false);
   if (!dst_size) {
     err("%s(%d), get dst size fail\n", __func__, idx);
@@ -437,7 +707,13 @@ st22p_rx_handle st22p_rx_create(mtl_handle mt, struct st22p_rx_ops* ops) {
   if (!ctx->max_codestream_size) ctx->max_codestream_size = dst_size;
   rte_atomic32_set(&ctx->stat_decode_fail, 0);
   rte_atomic32_set(&ctx->stat_busy, 0);
+  rte_atomic32_set(&ctx->stat_drop_incomplete, 0);
   mt_pthread_mutex_init(&ctx->lock, NULL);
+  mt_pthread_cond_wait_init(&ctx->block_wake_cond);
+  rte_atomic32_set(&ctx->block_waiters, 0);
+  ctx->block_get = (ops->flags & ST22P_RX_FLAG_BLOCK_GET) ? true : false;
+  ctx->block_timeout_ns = ST_PIPELINE_BLOCK_TIMEOUT_NS;
+  ctx->event.fd = -1;
 
   /* copy ops */
   if (ops->name) {
@@ -447,6 +723,15 @@ st22p_rx_handle st22p_rx_create(mtl_handle mt, struct st22p_rx_ops* ops) {
   }
   ctx->ops = *ops;
 
+  if (ops->flags & ST22P_RX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&ctx->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      st22p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* get one suitable jpegxs decode device */
   ret = rx_st22p_get_decoder(impl, ctx, ops);
   if (ret < 0) {
@@ -477,9 +762,7 @@ st22p_rx_handle st22p_rx_create(mtl_handle mt, struct st22p_rx_ops* ops) {
          st_frame_fmt_name(ctx->codestream_fmt), st_frame_fmt_name(ops->output_fmt));
   st22p_rx_idx++;
 
-  if (ctx->ops.notify_frame_available) { /* notify app */
-    ctx->ops.notify_frame_available(ctx->ops.priv);
-  }
+  rx_st22p_notify_frame_available(ctx);
 
   return ctx;
 }
@@ -505,6 +788,8 @@ int st22p_rx_free(st22p_rx_handle handle) {
   rx_st22p_uinit_dst_fbs(ctx);
 
   mt_pthread_mutex_destroy(&ctx->lock);
+  mt_pthread_cond_destroy(&ctx->block_wake_cond);
+  mt_event_fd_uinit(&ctx->event);
   mt_rte_free(ctx);
 
   return 0;
@@ -564,3 +849,47 @@ int st22p_rx_pcapng_dump(st22p_rx_handle handle, uint32_t max_dump_packets, bool
 
   return st22_rx_pcapng_dump(ctx->transport, max_dump_packets, sync, meta);
 }
+
+int st22p_rx_wake_block(st22p_rx_handle handle) {
+  struct st22p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->block_get) rx_st22p_block_wake(ctx);
+
+  return 0;
+}
+
+int st22p_rx_set_block_timeout(st22p_rx_handle handle, uint64_t timedwait_ns) {
+  struct st22p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  ctx->block_timeout_ns = timedwait_ns;
+  return 0;
+}
+
+int st22p_rx_get_event_fd(st22p_rx_handle handle) {
+  struct st22p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, cidx);
+    return -EIO;
+  }
+
+  return ctx->event.fd;
+}
@@ -14,15 +14,31 @@ enum st22p_rx_frame_status {
   ST22P_RX_FRAME_IN_DECODING, /* for encoding */
   ST22P_RX_FRAME_DECODED,
   ST22P_RX_FRAME_IN_USER, /* in user */
+  ST22P_RX_FRAME_HELD,    /* put by user, the dst still held by the decoder */
   ST22P_RX_FRAME_STATUS_MAX,
 };
 
+/* the receive state of the codestream passed to the decoder in slice mode */
+enum st22p_rx_slice_state {
+  ST22P_RX_SLICE_RECEIVING = 0,
+  ST22P_RX_SLICE_COMPLETE,
+  ST22P_RX_SLICE_DECODE_DONE, /* decoder put before the receive complete */
+};
+
 struct st22p_rx_frame {
   enum st22p_rx_frame_status stat;
   struct st_frame src; /* before decoding */
   struct st_frame dst; /* decoded */
   struct st22_decode_frame_meta decode_frame;
   uint16_t idx;
+  /* the session and the decoder holds of the dst, back to free when it drops to 0 */
+  rte_atomic32_t dst_refcnt;
+
+  /* for slice mode */
+  void* slice_src;            /* the transport frame in receiving, only for tasklet */
+  rte_atomic64_t bytes_ready; /* received codestream bytes */
+  rte_atomic32_t slice_state; /* enum st22p_rx_slice_state */
+  int decode_result;          /* for ST22P_RX_SLICE_DECODE_DONE */
 };
 
 struct st22p_rx_ctx {
@@ -36,20 +52,37 @@ struct st22p_rx_ctx {
 
   st22_rx_handle transport;
   uint16_t framebuff_cnt;
-  uint16_t framebuff_producer_idx;
-  uint16_t framebuff_decode_idx;
-  uint16_t framebuff_consumer_idx;
   struct st22p_rx_frame* framebuffs;
-  pthread_mutex_t lock;
+  /* lock-free rings of framebuff pointer for each queued state */
+  struct rte_ring* free_ring;    /* ST22P_RX_FRAME_FREE */
+  struct rte_ring* ready_ring;   /* ST22P_RX_FRAME_READY */
+  struct rte_ring* decoded_ring; /* ST22P_RX_FRAME_DECODED */
+  pthread_mutex_t lock;          /* only for the block wait */
 
   struct st22_decode_session_impl* decode_impl;
   bool ready;
+  bool slice; /* ST22P_RX_FLAG_SLICE_LEVEL and slice_enabled by decoder */
+  bool segs;  /* ST22P_RX_FLAG_CODESTREAM_SEGMENTS and segs_enabled by decoder */
+
+  /* for ST22P_RX_FLAG_BLOCK_GET, wait on lock */
+  bool block_get;
+  pthread_cond_t block_wake_cond;
+  rte_atomic32_t block_waiters; /* the block get waiting on block_wake_cond */
+  uint64_t block_timeout_ns;
+
+  /* for ST22P_RX_FLAG_EVENT_FD */
+  struct mt_event_fd event;
 
   size_t dst_size;
   size_t max_codestream_size;
+  /* the dst planes layout required by the decoder, only if dst_padded */
+  bool dst_padded;
+  size_t dst_linesize[ST_MAX_PLANES];
+  uint32_t dst_pad_lines;
 
   rte_atomic32_t stat_decode_fail;
   rte_atomic32_t stat_busy;
+  rte_atomic32_t stat_drop_incomplete;
 };
 
 #endif
@@ -6,43 +6,58 @@
 
 #include "../../mt_log.h"
 
-static const char* st22p_tx_frame_stat_name[ST22P_TX_FRAME_STATUS_MAX] = {
-    "free", "in_user", "ready", "in_encoding", "encoded", "in_trans",
-};
-
-static const char* tx_st22p_stat_name(enum st22p_tx_frame_status stat) {
-  return st22p_tx_frame_stat_name[stat];
+static struct rte_ring* tx_st22p_ring_create(struct st22p_tx_ctx* ctx, const char* tag) {
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST22PTX%d_%s", ctx->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, ctx->framebuff_cnt,
+                         mt_socket_id(ctx->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%d), rte_ring_create %s fail\n", __func__, ctx->idx, ring_name);
+  return ring;
 }
 
-static uint16_t tx_st22p_next_idx(struct st22p_tx_ctx* ctx, uint16_t idx) {
-  /* point to next */
-  uint16_t next_idx = idx;
-  next_idx++;
-  if (next_idx >= ctx->framebuff_cnt) next_idx = 0;
-  return next_idx;
+/* move the frame to the desired state ring */
+static inline void tx_st22p_ring_put(struct rte_ring* ring,
+                                     struct st22p_tx_frame* framebuff,
+                                     enum st22p_tx_frame_status stat) {
+  framebuff->stat = stat;
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
 }
 
-static struct st22p_tx_frame* tx_st22p_next_available(
-    struct st22p_tx_ctx* ctx, uint16_t idx_start, enum st22p_tx_frame_status desired) {
-  uint16_t idx = idx_start;
+static inline struct st22p_tx_frame* tx_st22p_ring_get(struct rte_ring* ring) {
   struct st22p_tx_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
+}
 
-  /* check ready frame from idx_start */
-  while (1) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == framebuff->stat) {
-      /* find one desired */
-      return framebuff;
-    }
-    idx = tx_st22p_next_idx(ctx, idx);
-    if (idx == idx_start) {
-      /* loop all frames end */
-      break;
-    }
+static void tx_st22p_block_wake(struct st22p_tx_ctx* ctx) {
+  /* order the frame enqueue before the waiters read */
+  rte_smp_mb();
+  /* only lock and signal when any block get is waiting */
+  if (!rte_atomic32_read(&ctx->block_waiters)) return;
+  mt_pthread_mutex_lock(&ctx->lock);
+  mt_pthread_cond_signal(&ctx->block_wake_cond);
+  mt_pthread_mutex_unlock(&ctx->lock);
+}
+
+static void tx_st22p_notify_frame_available(struct st22p_tx_ctx* ctx) {
+  if (ctx->ops.notify_frame_available) { /* notify app */
+    ctx->ops.notify_frame_available(ctx->ops.priv);
   }
 
-  /* no any desired frame */
-  return NULL;
+  if (ctx->block_get) tx_st22p_block_wake(ctx);
+
+  mt_event_fd_notify(&ctx->event);
+}
+
+/* wait until any frame status change or timeout, ctx->lock should be locked */
+static void tx_st22p_block_wait(struct st22p_tx_ctx* ctx) {
+  dbg("%s(%d), start\n", __func__, ctx->idx);
+  mt_pthread_cond_timedwait_ns(&ctx->block_wake_cond, &ctx->lock, ctx->block_timeout_ns);
+  dbg("%s(%d), end\n", __func__, ctx->idx);
 }
 
 static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
@@ -52,14 +67,9 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      tx_st22p_next_available(ctx, ctx->framebuff_consumer_idx, ST22P_TX_FRAME_ENCODED);
+  framebuff = tx_st22p_ring_get(ctx->encoded_ring);
   /* not any encoded frame */
-  if (!framebuff) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return -EBUSY;
-  }
+  if (!framebuff) return -EBUSY;
 
   framebuff->stat = ST22P_TX_FRAME_IN_TRANSMITTING;
   *next_frame_idx = framebuff->idx;
@@ -70,43 +80,45 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
         framebuff->idx, meta->timestamp);
   }
   meta->codestream_size = framebuff->dst.data_size;
-  /* point to next */
-  ctx->framebuff_consumer_idx = tx_st22p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
   dbg("%s(%d), frame %u succ\n", __func__, ctx->idx, framebuff->idx);
   return 0;
 }
 
+static int tx_st22p_query_bytes_ready(void* priv, uint16_t frame_idx,
+                                      struct st22_tx_slice_meta* meta) {
+  struct st22p_tx_ctx* ctx = priv;
+  struct st22p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
+
+  meta->bytes_ready = rte_atomic64_read(&framebuff->bytes_ready);
+  return 0;
+}
+
 static int tx_st22p_frame_done(void* priv, uint16_t frame_idx,
                                struct st22_tx_frame_meta* meta) {
   struct st22p_tx_ctx* ctx = priv;
   int ret;
   struct st22p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
 
-  mt_pthread_mutex_lock(&ctx->lock);
+  framebuff->src.tfmt = meta->tfmt;
+  framebuff->dst.tfmt = meta->tfmt;
+  framebuff->src.timestamp = meta->timestamp;
+  framebuff->dst.timestamp = meta->timestamp;
+
   if (ST22P_TX_FRAME_IN_TRANSMITTING == framebuff->stat) {
     ret = 0;
-    framebuff->stat = ST22P_TX_FRAME_FREE;
+    tx_st22p_ring_put(ctx->free_ring, framebuff, ST22P_TX_FRAME_FREE);
     dbg("%s(%d), done_idx %u\n", __func__, ctx->idx, frame_idx);
   } else {
     ret = -EIO;
     err("%s(%d), err status %d for frame %u\n", __func__, ctx->idx, framebuff->stat,
         frame_idx);
   }
-  mt_pthread_mutex_unlock(&ctx->lock);
-
-  framebuff->src.tfmt = meta->tfmt;
-  framebuff->dst.tfmt = meta->tfmt;
-  framebuff->src.timestamp = meta->timestamp;
-  framebuff->dst.timestamp = meta->timestamp;
 
   if (ctx->ops.notify_frame_done) { /* notify app which frame done */
     ctx->ops.notify_frame_done(ctx->ops.priv, &framebuff->src);
   }
 
-  if (ctx->ops.notify_frame_available) { /* notify app */
-    ctx->ops.notify_frame_available(ctx->ops.priv);
-  }
+  tx_st22p_notify_frame_available(ctx);
 
   return ret;
 }
@@ -133,19 +145,13 @@ static struct st22_encode_frame_meta* tx_st22p_encode_get_frame(void* priv) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      tx_st22p_next_available(ctx, ctx->framebuff_encode_idx, ST22P_TX_FRAME_READY);
-  /* not any free frame */
-  if (!framebuff) {
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
-  }
+  framebuff = tx_st22p_ring_get(ctx->ready_ring);
+  /* not any ready frame */
+  if (!framebuff) return NULL;
 
   framebuff->stat = ST22P_TX_FRAME_IN_ENCODING;
-  /* point to next */
-  ctx->framebuff_encode_idx = tx_st22p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
+  framebuff->dst_published = false;
+  rte_atomic64_set(&framebuff->bytes_ready, 0);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   return &framebuff->encode_frame;
@@ -168,6 +174,29 @@ static int tx_st22p_encode_put_frame(void* priv, struct st22_encode_frame_meta*
     return -EIO;
   }
 
+  if (framebuff->dst_published) {
+    /* in transmitting already, pad the tail and release all bytes to the transport */
+    size_t size = ctx->slice_codestream_size;
+    size_t pad_offset = rte_atomic64_read(&framebuff->bytes_ready);
+
+    dbg("%s(%d), slice frame %u result %d data_size %" PRIu64 "\n", __func__, idx,
+        encode_idx, result, data_size);
+    if (result < 0) {
+      /* only the bytes on the wire are kept, the others are not valid */
+      rte_atomic32_inc(&ctx->stat_encode_fail);
+    } else {
+      pad_offset = RTE_MAX(pad_offset, data_size);
+    }
+    if (pad_offset < size) {
+      memset((uint8_t*)frame->dst->addr[0] + pad_offset, 0, size - pad_offset);
+      rte_atomic32_inc(&ctx->stat_slice_pad);
+    }
+    frame->dst->data_size = size;
+    framebuff->dst_published = false;
+    rte_atomic64_set(&framebuff->bytes_ready, size);
+    return 0;
+  }
+
   if (ST22P_TX_FRAME_IN_ENCODING != framebuff->stat) {
     err("%s(%d), frame %u not in encoding %d\n", __func__, idx, encode_idx,
         framebuff->stat);
@@ -181,13 +210,48 @@ static int tx_st22p_encode_put_frame(void* priv, struct st22_encode_frame_meta*
          ", allowed min %u max %" PRIu64 "\n",
          __func__, idx, encode_idx, result, data_size, ST22_ENCODE_MIN_FRAME_SZ,
          max_size);
-    framebuff->stat = ST22P_TX_FRAME_FREE;
-    if (ctx->ops.notify_frame_available) { /* notify app */
-      ctx->ops.notify_frame_available(ctx->ops.priv);
-    }
+    tx_st22p_ring_put(ctx->free_ring, framebuff, ST22P_TX_FRAME_FREE);
+    tx_st22p_notify_frame_available(ctx);
     rte_atomic32_inc(&ctx->stat_encode_fail);
   } else {
-    framebuff->stat = ST22P_TX_FRAME_ENCODED;
+    rte_atomic64_set(&framebuff->bytes_ready, data_size);
+    tx_st22p_ring_put(ctx->encoded_ring, framebuff, ST22P_TX_FRAME_ENCODED);
+  }
+
+  return 0;
+}
+
+static uint16_t tx_st22p_encode_get_frame_lines(void* priv,
+                                                struct st22_encode_frame_meta* frame) {
+  struct st22p_tx_frame* framebuff = frame->priv;
+
+  return rte_atomic32_read(&framebuff->lines_ready);
+}
+
+static int tx_st22p_encode_put_frame_bytes(void* priv,
+                                           struct st22_encode_frame_meta* frame,
+                                           size_t bytes) {
+  struct st22p_tx_ctx* ctx = priv;
+  int idx = ctx->idx;
+  struct st22p_tx_frame* framebuff = frame->priv;
+  size_t size = ctx->slice_codestream_size;
+
+  if (!framebuff->dst_published && (ST22P_TX_FRAME_IN_ENCODING != framebuff->stat)) {
+    err("%s(%d), frame %u not in encoding %d\n", __func__, idx, framebuff->idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  /* the last bytes are released by the put_frame */
+  if (bytes >= size) bytes = size - 1;
+  rte_atomic64_set(&framebuff->bytes_ready, bytes);
+  if (!framebuff->dst_published) {
+    /* the first bytes, start the transmitting */
+    framebuff->dst_published = true;
+    frame->dst->data_size = size;
+    tx_st22p_ring_put(ctx->encoded_ring, framebuff, ST22P_TX_FRAME_ENCODED);
+    dbg("%s(%d), frame %u start with %" PRIu64 " bytes\n", __func__, idx,
+        framebuff->idx, bytes);
   }
 
   return 0;
@@ -195,23 +259,23 @@ static int tx_st22p_encode_put_frame(void* priv, struct st22_encode_frame_meta*
 
 static int tx_st22p_encode_dump(void* priv) {
   struct st22p_tx_ctx* ctx = priv;
-  struct st22p_tx_frame* framebuff = ctx->framebuffs;
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  uint16_t producer_idx = ctx->framebuff_producer_idx;
-  uint16_t encode_idx = ctx->framebuff_encode_idx;
-  uint16_t consumer_idx = ctx->framebuff_consumer_idx;
-  notice("TX_ST22P(%s), p(%d:%s) e(%d:%s) c(%d:%s)\n", ctx->ops_name, producer_idx,
-         tx_st22p_stat_name(framebuff[producer_idx].stat), encode_idx,
-         tx_st22p_stat_name(framebuff[encode_idx].stat), consumer_idx,
-         tx_st22p_stat_name(framebuff[consumer_idx].stat));
+  notice("TX_ST22P(%s), free %u ready %u encoded %u\n", ctx->ops_name,
+         rte_ring_count(ctx->free_ring), rte_ring_count(ctx->ready_ring),
+         rte_ring_count(ctx->encoded_ring));
 
   int encode_fail = rte_atomic32_read(&ctx->stat_encode_fail);
   rte_atomic32_set(&ctx->stat_encode_fail, 0);
   if (encode_fail) {
     notice("RX_ST22P(%s), encode fail %d\n", ctx->ops_name, encode_fail);
   }
+  int slice_pad = rte_atomic32_read(&ctx->stat_slice_pad);
+  rte_atomic32_set(&ctx->stat_slice_pad, 0);
+  if (slice_pad) {
+    notice("TX_ST22P(%s), slice frames padded %d\n", ctx->ops_name, slice_pad);
+  }
 
   return 0;
 }
@@ -258,7 +322,12 @@ static int tx_st22p_create_transport(struct mtl_main_impl* impl, struct st22p_tx
   ops_tx.height = ops->height;
   ops_tx.fps = ops->fps;
   ops_tx.payload_type = ops->port.payload_type;
-  ops_tx.type = ST22_TYPE_FRAME_LEVEL;
+  if (ctx->slice_encode) {
+    ops_tx.type = ST22_TYPE_SLICE_LEVEL;
+    ops_tx.query_frame_bytes_ready = tx_st22p_query_bytes_ready;
+  } else {
+    ops_tx.type = ST22_TYPE_FRAME_LEVEL;
+  }
   ops_tx.pack_type = ops->pack_type;
   ops_tx.framebuff_cnt = ops->framebuff_cnt;
   ops_tx.framebuff_max_size = ctx->encode_impl->codestream_max_size;
@@ -306,6 +375,19 @@ static int tx_st22p_uinit_src_fbs(struct st22p_tx_ctx* ctx) {
     ctx->framebuffs = NULL;
   }
 
+  if (ctx->free_ring) {
+    rte_ring_free(ctx->free_ring);
+    ctx->free_ring = NULL;
+  }
+  if (ctx->ready_ring) {
+    rte_ring_free(ctx->ready_ring);
+    ctx->ready_ring = NULL;
+  }
+  if (ctx->encoded_ring) {
+    rte_ring_free(ctx->encoded_ring);
+    ctx->encoded_ring = NULL;
+  }
+
   return 0;
 }
 
@@ -325,8 +407,15 @@ static int tx_st22p_init_src_fbs(struct mtl_main_impl* impl, struct st22p_tx_ctx
   }
   ctx->framebuffs = frames;
 
+  ctx->free_ring = tx_st22p_ring_create(ctx, "FREE");
+  ctx->ready_ring = tx_st22p_ring_create(ctx, "READY");
+  ctx->encoded_ring = tx_st22p_ring_create(ctx, "ENCODED");
+  if (!ctx->free_ring || !ctx->ready_ring || !ctx->encoded_ring) {
+    tx_st22p_uinit_src_fbs(ctx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    frames[i].stat = ST22P_TX_FRAME_FREE;
     frames[i].idx = i;
     src = mt_rte_zmalloc_socket(src_size, soc_id);
     if (!src) {
@@ -348,6 +437,7 @@ static int tx_st22p_init_src_fbs(struct mtl_main_impl* impl, struct st22p_tx_ctx
       tx_st22p_uinit_src_fbs(ctx);
       return -EINVAL;
     }
+    tx_st22p_ring_put(ctx->free_ring, &frames[i], ST22P_TX_FRAME_FREE);
   }
 
   info("%s(%d), size %" PRIu64 " fmt %d with %u frames\n", __func__, idx, src_size,
@@ -372,11 +462,14 @@ static int tx_st22p_get_encoder(struct mtl_main_impl* impl, struct st22p_tx_ctx*
   req.req.quality = ops->quality;
   req.req.framebuff_cnt = ops->framebuff_cnt;
   req.req.codec_thread_cnt = ops->codec_thread_cnt;
+  req.req.slice_level = ctx->slice;
 
   req.priv = ctx;
   req.get_frame = tx_st22p_encode_get_frame;
   req.put_frame = tx_st22p_encode_put_frame;
   req.dump = tx_st22p_encode_dump;
+  req.get_frame_lines = tx_st22p_encode_get_frame_lines;
+  req.put_frame_bytes = tx_st22p_encode_put_frame_bytes;
 
   struct st22_encode_session_impl* encode_impl = st22_get_encoder(impl, &req);
   if (!encode_impl) {
@@ -390,6 +483,19 @@ static int tx_st22p_get_encoder(struct mtl_main_impl* impl, struct st22p_tx_ctx*
     return -EINVAL;
   }
 
+  if (ctx->slice) {
+    if (req.req.slice_enabled) {
+      ctx->slice_encode = true;
+      ctx->slice_codestream_size =
+          RTE_MIN(ops->codestream_size, encode_impl->codestream_max_size);
+      info("%s(%d), slice encode with codestream size %" PRIu64 "\n", __func__, idx,
+           ctx->slice_codestream_size);
+    } else {
+      warn("%s(%d), encoder not support slice, encode once all lines ready\n", __func__,
+           idx);
+    }
+  }
+
   return 0;
 }
 
@@ -405,24 +511,82 @@ struct st_frame* st22p_tx_get_frame(st22p_tx_handle handle) {
 
   if (!ctx->ready) return NULL; /* not ready */
 
-  mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      tx_st22p_next_available(ctx, ctx->framebuff_producer_idx, ST22P_TX_FRAME_FREE);
-  /* not any free frame */
-  if (!framebuff) {
+  mt_event_fd_ack(&ctx->event);
+
+  framebuff = tx_st22p_ring_get(ctx->free_ring);
+  if (!framebuff && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    framebuff = tx_st22p_ring_get(ctx->free_ring);
+    if (!framebuff) {
+      tx_st22p_block_wait(ctx);
+      framebuff = tx_st22p_ring_get(ctx->free_ring);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
     mt_pthread_mutex_unlock(&ctx->lock);
-    return NULL;
   }
+  /* not any free frame */
+  if (!framebuff) return NULL;
 
   framebuff->stat = ST22P_TX_FRAME_IN_USER;
-  /* point to next */
-  ctx->framebuff_producer_idx = tx_st22p_next_idx(ctx, framebuff->idx);
-  mt_pthread_mutex_unlock(&ctx->lock);
+  framebuff->src_published = false;
+  rte_atomic32_set(&framebuff->lines_ready, 0);
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   return &framebuff->src;
 }
 
+int st22p_tx_put_frame_lines(st22p_tx_handle handle, struct st_frame* frame,
+                             uint16_t lines_ready) {
+  struct st22p_tx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st22p_tx_frame* framebuff = frame->priv;
+  uint16_t producer_idx = framebuff->idx;
+  uint16_t height = ctx->ops.height;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
+  }
+
+  if (!ctx->slice) {
+    err("%s(%d), slice level not enabled\n", __func__, idx);
+    return -EINVAL;
+  }
+
+  if (!framebuff->src_published && (ST22P_TX_FRAME_IN_USER != framebuff->stat)) {
+    err("%s(%d), frame %u not in user %d\n", __func__, idx, producer_idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  if (lines_ready > height) lines_ready = height;
+  if (lines_ready < rte_atomic32_read(&framebuff->lines_ready)) {
+    err("%s(%d), frame %u lines %u less than published %d\n", __func__, idx,
+        producer_idx, lines_ready, rte_atomic32_read(&framebuff->lines_ready));
+    return -EINVAL;
+  }
+  rte_atomic32_set(&framebuff->lines_ready, lines_ready);
+
+  if (framebuff->src_published) {
+    /* wake the encoder for the new lines */
+    st22_encode_notify_frame_ready(ctx->encode_impl);
+    return 0;
+  }
+
+  /* the slice encoder starts from the first lines, others need all lines */
+  if ((ctx->slice_encode && lines_ready) || (lines_ready >= height)) {
+    framebuff->src_published = true;
+    tx_st22p_ring_put(ctx->ready_ring, framebuff, ST22P_TX_FRAME_READY);
+    st22_encode_notify_frame_ready(ctx->encode_impl);
+    dbg("%s(%d), frame %u start with %u lines\n", __func__, idx, producer_idx,
+        lines_ready);
+  }
+
+  return 0;
+}
+
 int st22p_tx_put_frame(st22p_tx_handle handle, struct st_frame* frame) {
   struct st22p_tx_ctx* ctx = handle;
   int idx = ctx->idx;
@@ -434,13 +598,15 @@ int st22p_tx_put_frame(st22p_tx_handle handle, struct st_frame* frame) {
     return -EIO;
   }
 
+  if (ctx->slice) return st22p_tx_put_frame_lines(handle, frame, ctx->ops.height);
+
   if (ST22P_TX_FRAME_IN_USER != framebuff->stat) {
     err("%s(%d), frame %u not in free %d\n", __func__, idx, producer_idx,
         framebuff->stat);
     return -EIO;
   }
 
-  framebuff->stat = ST22P_TX_FRAME_READY;
+  tx_st22p_ring_put(ctx->ready_ring, framebuff, ST22P_TX_FRAME_READY);
   st22_encode_notify_frame_ready(ctx->encode_impl);
   dbg("%s(%d), frame %u succ\n", __func__, idx, producer_idx);
 
@@ -463,7 +629,8 @@ st22p_tx_handle st22p_tx_create(mtl_handle mt, struct st22p_tx_ops* ops) {
     return NULL;
   }
 
-  if (!ops->notify_frame_available) {
+  uint32_t no_notify_flags = ST22P_TX_FLAG_BLOCK_GET | ST22P_TX_FLAG_EVENT_FD;
+  if (!(ops->flags & no_notify_flags) && !ops->notify_frame_available) {
     err("%s, pls set notify_frame_available\n", __func__);
     return NULL;
   }
@@ -496,7 +663,14 @@ st22p_tx_handle st22p_tx_create(mtl_handle mt, struct st22p_tx_ops* ops) {
   ctx->type = MT_ST22_HANDLE_PIPELINE_TX;
   ctx->src_size = src_size;
   rte_atomic32_set(&ctx->stat_encode_fail, 0);
+  rte_atomic32_set(&ctx->stat_slice_pad, 0);
   mt_pthread_mutex_init(&ctx->lock, NULL);
+  mt_pthread_cond_wait_init(&ctx->block_wake_cond);
+  rte_atomic32_set(&ctx->block_waiters, 0);
+  ctx->block_get = (ops->flags & ST22P_TX_FLAG_BLOCK_GET) ? true : false;
+  ctx->block_timeout_ns = ST_PIPELINE_BLOCK_TIMEOUT_NS;
+  ctx->event.fd = -1;
+  ctx->slice = (ops->flags & ST22P_TX_FLAG_SLICE_LEVEL) ? true : false;
 
   /* copy ops */
   if (ops->name) {
@@ -506,6 +680,15 @@ st22p_tx_handle st22p_tx_create(mtl_handle mt, struct st22p_tx_ops* ops) {
   }
   ctx->ops = *ops;
 
+  if (ops->flags & ST22P_TX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&ctx->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      st22p_tx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* get one suitable jpegxs encode device */
   ret = tx_st22p_get_encoder(impl, ctx, ops);
   if (ret < 0) {
@@ -536,9 +719,7 @@ st22p_tx_handle st22p_tx_create(mtl_handle mt, struct st22p_tx_ops* ops) {
          st_frame_fmt_name(ctx->codestream_fmt), st_frame_fmt_name(ops->input_fmt));
   st22p_tx_idx++;
 
-  if (ctx->ops.notify_frame_available) { /* notify app */
-    ctx->ops.notify_frame_available(ctx->ops.priv);
-  }
+  tx_st22p_notify_frame_available(ctx);
 
   return ctx;
 }
@@ -566,6 +747,8 @@ int st22p_tx_free(st22p_tx_handle handle) {
   tx_st22p_uinit_src_fbs(ctx);
 
   mt_pthread_mutex_destroy(&ctx->lock);
+  mt_pthread_cond_destroy(&ctx->block_wake_cond);
+  mt_event_fd_uinit(&ctx->event);
   notice("%s(%d), succ\n", __func__, ctx->idx);
   mt_rte_free(ctx);
 
@@ -601,3 +784,47 @@ size_t st22p_tx_frame_size(st22p_tx_handle handle) {
 
   return ctx->src_size;
 }
+
+int st22p_tx_wake_block(st22p_tx_handle handle) {
+  struct st22p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->block_get) tx_st22p_block_wake(ctx);
+
+  return 0;
+}
+
+int st22p_tx_set_block_timeout(st22p_tx_handle handle, uint64_t timedwait_ns) {
+  struct st22p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  ctx->block_timeout_ns = timedwait_ns;
+  return 0;
+}
+
+int st22p_tx_get_event_fd(st22p_tx_handle handle) {
+  struct st22p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST22_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, cidx);
+    return -EIO;
+  }
+
+  return ctx->event.fd;
+}
@@ -24,6 +24,12 @@ struct st22p_tx_frame {
   struct st_frame dst; /* encoded */
   struct st22_encode_frame_meta encode_frame;
   uint16_t idx;
+
+  /* for slice mode */
+  bool src_published;         /* passed to the encoder, only for app thread */
+  rte_atomic32_t lines_ready; /* src lines ready for encoder */
+  bool dst_published;         /* passed to the transport, only for encoder thread */
+  rte_atomic64_t bytes_ready; /* encoded bytes ready for transport */
 };
 
 struct st22p_tx_ctx {
@@ -37,18 +43,33 @@ struct st22p_tx_ctx {
 
   st22_tx_handle transport;
   uint16_t framebuff_cnt;
-  uint16_t framebuff_producer_idx;
-  uint16_t framebuff_encode_idx;
-  uint16_t framebuff_consumer_idx;
   struct st22p_tx_frame* framebuffs;
-  pthread_mutex_t lock; /* protect framebuffs */
+  /* lock-free rings of framebuff pointer for each queued state */
+  struct rte_ring* free_ring;    /* ST22P_TX_FRAME_FREE */
+  struct rte_ring* ready_ring;   /* ST22P_TX_FRAME_READY */
+  struct rte_ring* encoded_ring; /* ST22P_TX_FRAME_ENCODED */
+  pthread_mutex_t lock;          /* only for the block wait */
 
   struct st22_encode_session_impl* encode_impl;
   bool ready;
+  bool slice;        /* ST22P_TX_FLAG_SLICE_LEVEL */
+  bool slice_encode; /* slice_enabled by encoder */
+  /* the fixed codestream size for the slice encode */
+  size_t slice_codestream_size;
+
+  /* for ST22P_TX_FLAG_BLOCK_GET, wait on lock */
+  bool block_get;
+  pthread_cond_t block_wake_cond;
+  rte_atomic32_t block_waiters; /* the block get waiting on block_wake_cond */
+  uint64_t block_timeout_ns;
+
+  /* for ST22P_TX_FLAG_EVENT_FD */
+  struct mt_event_fd event;
 
   size_t src_size;
 
   rte_atomic32_t stat_encode_fail;
+  rte_atomic32_t stat_slice_pad;
 };
 
 #endif
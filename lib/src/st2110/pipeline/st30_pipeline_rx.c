@@ -0,0 +1,541 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include "st30_pipeline_rx.h"
+
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+
+static struct rte_ring* rx_st30p_ring_create(struct st30p_rx_ctx* ctx, const char* tag) {
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST30PRX%d_%s", ctx->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, ctx->framebuff_cnt,
+                         mt_socket_id(ctx->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%d), rte_ring_create %s fail\n", __func__, ctx->idx, ring_name);
+  return ring;
+}
+
+/* move the frame to the desired state ring */
+static inline void rx_st30p_ring_put(struct rte_ring* ring,
+                                     struct st30p_rx_frame* framebuff,
+                                     enum st30p_rx_frame_status stat) {
+  framebuff->stat = stat;
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
+}
+
+static inline struct st30p_rx_frame* rx_st30p_ring_get(struct rte_ring* ring) {
+  struct st30p_rx_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
+}
+
+static void rx_st30p_block_wake(struct st30p_rx_ctx* ctx) {
+  /* order the frame enqueue before the waiters read */
+  rte_smp_mb();
+  /* only lock and signal when any block get is waiting */
+  if (!rte_atomic32_read(&ctx->block_waiters)) return;
+  mt_pthread_mutex_lock(&ctx->lock);
+  mt_pthread_cond_signal(&ctx->block_wake_cond);
+  mt_pthread_mutex_unlock(&ctx->lock);
+}
+
+static void rx_st30p_notify_frame_available(struct st30p_rx_ctx* ctx) {
+  if (ctx->ops.notify_frame_available) { /* notify app */
+    ctx->ops.notify_frame_available(ctx->ops.priv);
+  }
+
+  if (ctx->block_get) rx_st30p_block_wake(ctx);
+
+  mt_event_fd_notify(&ctx->event);
+}
+
+/* wait until any frame status change or timeout, ctx->lock should be locked */
+static void rx_st30p_block_wait(struct st30p_rx_ctx* ctx) {
+  dbg("%s(%d), start\n", __func__, ctx->idx);
+  mt_pthread_cond_timedwait_ns(&ctx->block_wake_cond, &ctx->lock, ctx->block_timeout_ns);
+  dbg("%s(%d), end\n", __func__, ctx->idx);
+}
+
+/* convert the transport frame into the user frame */
+static int rx_st30p_convert(struct st30p_rx_ctx* ctx, struct st30p_rx_frame* framebuff) {
+  struct st30_frame* frame = &framebuff->frame;
+  uint32_t samples = ctx->sample_num * ctx->ops.channel;
+
+  if (frame->fmt == ST30_FRAME_FMT_S32LE) {
+    uint8_t* src = framebuff->transport_frame;
+    uint32_t* dst = frame->addr;
+    uint32_t sample;
+
+    /* left align the big endian sample into 32 bits */
+    if (frame->transport_fmt == ST30_FMT_PCM24) {
+      for (uint32_t i = 0; i < samples; i++) {
+        sample = ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | (src[2] << 8);
+        dst[i] = rte_cpu_to_le_32(sample);
+        src += 3;
+      }
+    } else { /* ST30_FMT_PCM16 */
+      for (uint32_t i = 0; i < samples; i++) {
+        sample = ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16);
+        dst[i] = rte_cpu_to_le_32(sample);
+        src += 2;
+      }
+    }
+    return 0;
+  }
+
+  if (frame->fmt == ST30_FRAME_FMT_AES3) {
+    struct st31_am824* src = framebuff->transport_frame;
+    struct st31_aes3* dst = frame->addr;
+    uint16_t subframes;
+    int ret;
+
+    while (samples) {
+      subframes = RTE_MIN(samples, UINT16_MAX);
+      ret = st31_am824_to_aes3(src, dst, subframes);
+      if (ret < 0) return ret;
+      src += subframes;
+      dst += subframes;
+      samples -= subframes;
+    }
+    return 0;
+  }
+
+  err("%s(%d), unknown fmt %d\n", __func__, ctx->idx, frame->fmt);
+  return -EINVAL;
+}
+
+static int rx_st30p_frame_ready(void* priv, void* frame,
+                                struct st30_rx_frame_meta* meta) {
+  struct st30p_rx_ctx* ctx = priv;
+  struct st30p_rx_frame* framebuff;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  framebuff = rx_st30p_ring_get(ctx->free_ring);
+  /* not any free frame */
+  if (!framebuff) {
+    rte_atomic32_inc(&ctx->stat_busy);
+    return -EBUSY;
+  }
+
+  framebuff->transport_frame = frame;
+  /* app read the transport frame directly if no convert */
+  if (ctx->derive) framebuff->frame.addr = frame;
+  framebuff->frame.tfmt = meta->tfmt;
+  framebuff->frame.timestamp = meta->timestamp;
+  rx_st30p_ring_put(ctx->ready_ring, framebuff, ST30P_RX_FRAME_READY);
+
+  dbg("%s(%d), frame %u succ\n", __func__, ctx->idx, framebuff->idx);
+  rx_st30p_notify_frame_available(ctx);
+
+  return 0;
+}
+
+static int rx_st30p_stat(void* priv) {
+  struct st30p_rx_ctx* ctx = priv;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  notice("RX_ST30P(%s), free %u ready %u\n", ctx->ops_name,
+         rte_ring_count(ctx->free_ring), rte_ring_count(ctx->ready_ring));
+
+  int busy = rte_atomic32_read(&ctx->stat_busy);
+  rte_atomic32_set(&ctx->stat_busy, 0);
+  if (busy) {
+    notice("RX_ST30P(%s), busy drop frame %d\n", ctx->ops_name, busy);
+  }
+
+  return 0;
+}
+
+static int rx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_rx_ctx* ctx,
+                                     struct st30p_rx_ops* ops) {
+  int idx = ctx->idx;
+  struct st30_rx_ops ops_rx;
+  st30_rx_handle transport;
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = ops->name;
+  ops_rx.priv = ctx;
+  ops_rx.num_port = RTE_MIN(ops->port.num_port, MTL_SESSION_PORT_MAX);
+  for (int i = 0; i < ops_rx.num_port; i++) {
+    memcpy(ops_rx.sip_addr[i], ops->port.sip_addr[i], MTL_IP_ADDR_LEN);
+    snprintf(ops_rx.port[i], MTL_PORT_MAX_LEN, "%s", ops->port.port[i]);
+    ops_rx.udp_port[i] = ops->port.udp_port[i];
+  }
+  if (ops->flags & ST30P_RX_FLAG_DATA_PATH_ONLY)
+    ops_rx.flags |= ST30_RX_FLAG_DATA_PATH_ONLY;
+  ops_rx.fmt = ops->fmt;
+  ops_rx.channel = ops->channel;
+  ops_rx.sampling = ops->sampling;
+  ops_rx.ptime = ops->ptime;
+  ops_rx.payload_type = ops->port.payload_type;
+  ops_rx.type = ST30_TYPE_FRAME_LEVEL;
+  ops_rx.framebuff_cnt = ops->framebuff_cnt;
+  ops_rx.framebuff_size = ctx->transport_frame_size;
+  ops_rx.notify_frame_ready = rx_st30p_frame_ready;
+
+  transport = st30_rx_create(impl, &ops_rx);
+  if (!transport) {
+    err("%s(%d), transport create fail\n", __func__, idx);
+    return -EIO;
+  }
+  ctx->transport = transport;
+
+  return 0;
+}
+
+static int rx_st30p_uinit_fbs(struct st30p_rx_ctx* ctx) {
+  if (ctx->framebuffs) {
+    for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+      if (!ctx->derive && ctx->framebuffs[i].frame.addr) {
+        mt_rte_free(ctx->framebuffs[i].frame.addr);
+        ctx->framebuffs[i].frame.addr = NULL;
+      }
+    }
+    mt_rte_free(ctx->framebuffs);
+    ctx->framebuffs = NULL;
+  }
+
+  if (ctx->free_ring) {
+    rte_ring_free(ctx->free_ring);
+    ctx->free_ring = NULL;
+  }
+  if (ctx->ready_ring) {
+    rte_ring_free(ctx->ready_ring);
+    ctx->ready_ring = NULL;
+  }
+
+  return 0;
+}
+
+static int rx_st30p_init_fbs(struct mtl_main_impl* impl, struct st30p_rx_ctx* ctx,
+                             struct st30p_rx_ops* ops) {
+  int idx = ctx->idx;
+  int soc_id = mt_socket_id(impl, MTL_PORT_P);
+  struct st30p_rx_frame* frames;
+  void* addr;
+
+  ctx->framebuff_cnt = ops->framebuff_cnt;
+  frames = mt_rte_zmalloc_socket(sizeof(*frames) * ctx->framebuff_cnt, soc_id);
+  if (!frames) {
+    err("%s(%d), frames malloc fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+  ctx->framebuffs = frames;
+
+  ctx->free_ring = rx_st30p_ring_create(ctx, "FREE");
+  ctx->ready_ring = rx_st30p_ring_create(ctx, "READY");
+  if (!ctx->free_ring || !ctx->ready_ring) {
+    rx_st30p_uinit_fbs(ctx);
+    return -ENOMEM;
+  }
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    frames[i].idx = i;
+    if (!ctx->derive) {
+      addr = mt_rte_zmalloc_socket(ctx->frame_size, soc_id);
+      if (!addr) {
+        err("%s(%d), frame malloc fail at %u\n", __func__, idx, i);
+        rx_st30p_uinit_fbs(ctx);
+        return -ENOMEM;
+      }
+      frames[i].frame.addr = addr;
+    }
+    frames[i].frame.fmt = ops->frame_fmt;
+    frames[i].frame.transport_fmt = ops->fmt;
+    frames[i].frame.buffer_size = ctx->frame_size;
+    frames[i].frame.data_size = ctx->frame_size;
+    frames[i].frame.channel = ops->channel;
+    frames[i].frame.sampling = ops->sampling;
+    frames[i].frame.ptime = ops->ptime;
+    frames[i].frame.sample_num = ctx->sample_num;
+    frames[i].frame.priv = &frames[i];
+    rx_st30p_ring_put(ctx->free_ring, &frames[i], ST30P_RX_FRAME_FREE);
+  }
+
+  info("%s(%d), size %" PRIu64 " fmt %d with %u frames\n", __func__, idx,
+       ctx->frame_size, ops->frame_fmt, ctx->framebuff_cnt);
+  return 0;
+}
+
+struct st30_frame* st30p_rx_get_frame(st30p_rx_handle handle) {
+  struct st30p_rx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st30p_rx_frame* framebuff;
+  int ret;
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return NULL;
+  }
+
+  if (!ctx->ready) return NULL; /* not ready */
+
+  mt_event_fd_ack(&ctx->event);
+
+  framebuff = rx_st30p_ring_get(ctx->ready_ring);
+  if (!framebuff && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    framebuff = rx_st30p_ring_get(ctx->ready_ring);
+    if (!framebuff) {
+      rx_st30p_block_wait(ctx);
+      framebuff = rx_st30p_ring_get(ctx->ready_ring);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
+    mt_pthread_mutex_unlock(&ctx->lock);
+  }
+  /* not any ready frame */
+  if (!framebuff) return NULL;
+
+  if (!ctx->derive) {
+    /* convert in the app thread, then the transport frame can be returned early */
+    ret = rx_st30p_convert(ctx, framebuff);
+    st30_rx_put_framebuff(ctx->transport, framebuff->transport_frame);
+    framebuff->transport_frame = NULL;
+    if (ret < 0) {
+      err("%s(%d), frame %u convert fail %d\n", __func__, idx, framebuff->idx, ret);
+      rx_st30p_ring_put(ctx->free_ring, framebuff, ST30P_RX_FRAME_FREE);
+      return NULL;
+    }
+  }
+
+  framebuff->stat = ST30P_RX_FRAME_IN_USER;
+
+  dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
+  return &framebuff->frame;
+}
+
+int st30p_rx_put_frame(st30p_rx_handle handle, struct st30_frame* frame) {
+  struct st30p_rx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st30p_rx_frame* framebuff = frame->priv;
+  uint16_t consumer_idx = framebuff->idx;
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ST30P_RX_FRAME_IN_USER != framebuff->stat) {
+    err("%s(%d), frame %u not in user %d\n", __func__, idx, consumer_idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  /* free the transport frame if not returned in the get */
+  if (framebuff->transport_frame) {
+    st30_rx_put_framebuff(ctx->transport, framebuff->transport_frame);
+    framebuff->transport_frame = NULL;
+  }
+  rx_st30p_ring_put(ctx->free_ring, framebuff, ST30P_RX_FRAME_FREE);
+  dbg("%s(%d), frame %u succ\n", __func__, idx, consumer_idx);
+
+  return 0;
+}
+
+st30p_rx_handle st30p_rx_create(mtl_handle mt, struct st30p_rx_ops* ops) {
+  static int st30p_rx_idx;
+  struct mtl_main_impl* impl = mt;
+  struct st30p_rx_ctx* ctx;
+  int ret;
+  int idx = st30p_rx_idx;
+  int pkt_size, pkts, frame_sample_size;
+
+  notice("%s, start for %s\n", __func__, mt_string_safe(ops->name));
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+
+  uint32_t no_notify_flags = ST30P_RX_FLAG_BLOCK_GET | ST30P_RX_FLAG_EVENT_FD;
+  if (!(ops->flags & no_notify_flags) && !ops->notify_frame_available) {
+    err("%s, pls set notify_frame_available\n", __func__);
+    return NULL;
+  }
+
+  frame_sample_size = st30_frame_sample_size(ops->frame_fmt, ops->fmt);
+  if (frame_sample_size < 0) {
+    err("%s(%d), invalid frame fmt %d for fmt %d\n", __func__, idx, ops->frame_fmt,
+        ops->fmt);
+    return NULL;
+  }
+  pkt_size = st30_get_packet_size(ops->fmt, ops->ptime, ops->sampling, ops->channel);
+  if (pkt_size < 0) {
+    err("%s(%d), get packet size fail\n", __func__, idx);
+    return NULL;
+  }
+  pkts = st30_frame_pkts(ops->ptime, ops->frame_time_us);
+  if (pkts < 0) {
+    err("%s(%d), get frame pkts fail\n", __func__, idx);
+    return NULL;
+  }
+
+  ctx = mt_rte_zmalloc_socket(sizeof(*ctx), mt_socket_id(impl, MTL_PORT_P));
+  if (!ctx) {
+    err("%s, ctx malloc fail\n", __func__);
+    return NULL;
+  }
+
+  ctx->idx = idx;
+  ctx->ready = false;
+  ctx->impl = impl;
+  ctx->type = MT_ST30_HANDLE_PIPELINE_RX;
+  ctx->derive = (ops->frame_fmt == ST30_FRAME_FMT_TRANSPORT) ? true : false;
+  ctx->transport_frame_size = pkt_size * pkts;
+  ctx->sample_num = st30_get_sample_num(ops->ptime, ops->sampling) * pkts;
+  ctx->frame_size = (size_t)ctx->sample_num * ops->channel * frame_sample_size;
+  rte_atomic32_set(&ctx->stat_busy, 0);
+  mt_pthread_mutex_init(&ctx->lock, NULL);
+  mt_pthread_cond_wait_init(&ctx->block_wake_cond);
+  rte_atomic32_set(&ctx->block_waiters, 0);
+  ctx->block_get = (ops->flags & ST30P_RX_FLAG_BLOCK_GET) ? true : false;
+  ctx->block_timeout_ns = ST_PIPELINE_BLOCK_TIMEOUT_NS;
+  ctx->event.fd = -1;
+
+  /* copy ops */
+  if (ops->name) {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "%s", ops->name);
+  } else {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "ST30P_RX_%d", idx);
+  }
+  ctx->ops = *ops;
+
+  if (ops->flags & ST30P_RX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&ctx->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      st30p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
+  /* init fbs */
+  ret = rx_st30p_init_fbs(impl, ctx, ops);
+  if (ret < 0) {
+    err("%s(%d), init fbs fail %d\n", __func__, idx, ret);
+    st30p_rx_free(ctx);
+    return NULL;
+  }
+
+  /* crete transport handle */
+  ret = rx_st30p_create_transport(impl, ctx, ops);
+  if (ret < 0) {
+    err("%s(%d), create transport fail\n", __func__, idx);
+    st30p_rx_free(ctx);
+    return NULL;
+  }
+
+  mt_stat_register(impl, rx_st30p_stat, ctx, ctx->ops_name);
+
+  /* all ready now */
+  ctx->ready = true;
+  notice("%s(%d), %d pkts %u samples per frame, frame fmt %d transport fmt %d\n",
+         __func__, idx, pkts, ctx->sample_num, ops->frame_fmt, ops->fmt);
+  st30p_rx_idx++;
+
+  return ctx;
+}
+
+int st30p_rx_free(st30p_rx_handle handle) {
+  struct st30p_rx_ctx* ctx = handle;
+
+  notice("%s(%d), start\n", __func__, ctx->idx);
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, ctx->idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->ready) mt_stat_unregister(ctx->impl, rx_st30p_stat, ctx);
+
+  if (ctx->transport) {
+    st30_rx_free(ctx->transport);
+    ctx->transport = NULL;
+  }
+  rx_st30p_uinit_fbs(ctx);
+
+  mt_pthread_mutex_destroy(&ctx->lock);
+  mt_pthread_cond_destroy(&ctx->block_wake_cond);
+  mt_event_fd_uinit(&ctx->event);
+  notice("%s(%d), succ\n", __func__, ctx->idx);
+  mt_rte_free(ctx);
+
+  return 0;
+}
+
+size_t st30p_rx_frame_size(st30p_rx_handle handle) {
+  struct st30p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return 0;
+  }
+
+  return ctx->frame_size;
+}
+
+int st30p_rx_get_queue_meta(st30p_rx_handle handle, struct st_queue_meta* meta) {
+  struct st30p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  return st30_rx_get_queue_meta(ctx->transport, meta);
+}
+
+int st30p_rx_wake_block(st30p_rx_handle handle) {
+  struct st30p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->block_get) rx_st30p_block_wake(ctx);
+
+  return 0;
+}
+
+int st30p_rx_set_block_timeout(st30p_rx_handle handle, uint64_t timedwait_ns) {
+  struct st30p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  ctx->block_timeout_ns = timedwait_ns;
+  return 0;
+}
+
+int st30p_rx_get_event_fd(st30p_rx_handle handle) {
+  struct st30p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST30_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, cidx);
+    return -EIO;
+  }
+
+  return ctx->event.fd;
+}
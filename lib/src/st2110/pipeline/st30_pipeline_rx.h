@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_ST30_RX_HEAD_H_
+#define _ST_LIB_PIPELINE_ST30_RX_HEAD_H_
+
+#include "../st_main.h"
+
+enum st30p_rx_frame_status {
+  ST30P_RX_FRAME_FREE = 0,
+  ST30P_RX_FRAME_READY,
+  ST30P_RX_FRAME_IN_USER,
+  ST30P_RX_FRAME_STATUS_MAX,
+};
+
+struct st30p_rx_frame {
+  enum st30p_rx_frame_status stat;
+  struct st30_frame frame; /* user frame */
+  void* transport_frame;   /* the transport frame hold by this framebuff */
+  uint16_t idx;
+};
+
+struct st30p_rx_ctx {
+  struct mtl_main_impl* impl;
+  int idx;
+  enum mt_handle_type type; /* for sanity check */
+
+  char ops_name[ST_MAX_NAME_LEN];
+  struct st30p_rx_ops ops;
+
+  st30_rx_handle transport;
+  uint16_t framebuff_cnt;
+  struct st30p_rx_frame* framebuffs;
+  /* lock-free rings of framebuff pointer for each queued state */
+  struct rte_ring* free_ring;  /* ST30P_RX_FRAME_FREE */
+  struct rte_ring* ready_ring; /* ST30P_RX_FRAME_READY */
+  pthread_mutex_t lock;        /* only for the block wait */
+
+  bool derive; /* user frame is the transport frame, no convert */
+  bool ready;
+
+  /* for ST30P_RX_FLAG_BLOCK_GET, wait on lock */
+  bool block_get;
+  pthread_cond_t block_wake_cond;
+  rte_atomic32_t block_waiters; /* the block get waiting on block_wake_cond */
+  uint64_t block_timeout_ns;
+
+  /* for ST30P_RX_FLAG_EVENT_FD */
+  struct mt_event_fd event;
+
+  uint32_t sample_num;           /* samples of each channel in one frame */
+  size_t frame_size;             /* user frame size */
+  uint32_t transport_frame_size; /* framebuff_size of transport */
+
+  rte_atomic32_t stat_busy;
+};
+
+#endif
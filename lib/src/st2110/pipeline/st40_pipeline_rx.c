@@ -0,0 +1,625 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include "st40_pipeline_rx.h"
+
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+
+static struct rte_ring* rx_st40p_ring_create(struct st40p_rx_ctx* ctx, const char* tag) {
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST40PRX%d_%s", ctx->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, ctx->framebuff_cnt,
+                         mt_socket_id(ctx->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%d), rte_ring_create %s fail\n", __func__, ctx->idx, ring_name);
+  return ring;
+}
+
+/* move the frame to the desired state ring */
+static inline void rx_st40p_ring_put(struct rte_ring* ring,
+                                     struct st40p_rx_frame* framebuff,
+                                     enum st40p_rx_frame_status stat) {
+  framebuff->stat = stat;
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
+}
+
+static inline struct st40p_rx_frame* rx_st40p_ring_get(struct rte_ring* ring) {
+  struct st40p_rx_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
+}
+
+static void rx_st40p_block_wake(struct st40p_rx_ctx* ctx) {
+  /* order the frame enqueue before the waiters read */
+  rte_smp_mb();
+  /* only lock and signal when any block get is waiting */
+  if (!rte_atomic32_read(&ctx->block_waiters)) return;
+  mt_pthread_mutex_lock(&ctx->lock);
+  mt_pthread_cond_signal(&ctx->block_wake_cond);
+  mt_pthread_mutex_unlock(&ctx->lock);
+}
+
+static void rx_st40p_notify_frame_available(struct st40p_rx_ctx* ctx) {
+  if (ctx->ops.notify_frame_available) { /* notify app */
+    ctx->ops.notify_frame_available(ctx->ops.priv);
+  }
+
+  if (ctx->block_get) rx_st40p_block_wake(ctx);
+
+  mt_event_fd_notify(&ctx->event);
+}
+
+/* wait until any frame status change or timeout, ctx->lock should be locked */
+static void rx_st40p_block_wait(struct st40p_rx_ctx* ctx) {
+  dbg("%s(%d), start\n", __func__, ctx->idx);
+  mt_pthread_cond_timedwait_ns(&ctx->block_wake_cond, &ctx->lock, ctx->block_timeout_ns);
+  dbg("%s(%d), end\n", __func__, ctx->idx);
+}
+
+/* the caller should notify app after the ctx->assembling_lock is released */
+static void rx_st40p_frame_deliver(struct st40p_rx_ctx* ctx,
+                                   struct st40p_rx_frame* framebuff) {
+  rx_st40p_ring_put(ctx->ready_ring, framebuff, ST40P_RX_FRAME_READY);
+  dbg("%s(%d), frame %u succ with %u pkts\n", __func__, ctx->idx, framebuff->idx,
+      framebuff->frame.pkt_cnt);
+}
+
+/* deliver the assembling frame to app, ctx->assembling_lock should be locked */
+static void rx_st40p_frame_done(struct st40p_rx_ctx* ctx) {
+  struct st40p_rx_frame* framebuff = ctx->assembling;
+
+  ctx->assembling = NULL;
+  rx_st40p_frame_deliver(ctx, framebuff);
+}
+
+/* deliver the assembling frame if no rtp of it arrives within the timeout */
+static void rx_st40p_assemble_alarm(void* param) {
+  struct st40p_rx_ctx* ctx = param;
+  struct st40p_rx_frame* framebuff = NULL;
+
+  rte_spinlock_lock(&ctx->assembling_lock);
+  if (ctx->assembling &&
+      (mt_get_tsc(ctx->impl) - ctx->assembling_last_ns) > ctx->assemble_timeout_ns) {
+    framebuff = ctx->assembling;
+    ctx->assembling = NULL;
+  }
+  rte_spinlock_unlock(&ctx->assembling_lock);
+
+  if (framebuff) {
+    dbg("%s(%d), frame %u timeout\n", __func__, ctx->idx, framebuff->idx);
+    rte_atomic32_inc(&ctx->stat_timeout_frame);
+    rx_st40p_frame_deliver(ctx, framebuff);
+    rx_st40p_notify_frame_available(ctx);
+  }
+
+  rte_eal_alarm_set(ctx->assemble_timeout_ns / NS_PER_US, rx_st40p_assemble_alarm, ctx);
+}
+
+/*
+ * decode one rfc8331 ANC data packet into pkt, the size of it is returned in anc_len.
+ * -EIO if the packet is corrupted but can be skipped, -EINVAL if the rest of the rtp
+ * payload can't be trusted.
+ */
+static int rx_st40p_parse_anc(struct st40p_rx_ctx* ctx,
+                              struct st40_rfc8331_payload_hdr* payload_hdr,
+                              uint32_t len, struct st40_anc_pkt* pkt, uint32_t* anc_len) {
+  /* the 10 bits words are read from the network order stream directly */
+  uint8_t* words = (uint8_t*)&payload_hdr->second_hdr_chunk;
+  struct st40_rfc8331_payload_hdr hdr;
+  uint16_t did, sdid, data_count, udw, checksum;
+  uint32_t total_size, payload_len;
+  uint8_t udw_size;
+
+  if (len < sizeof(*payload_hdr)) return -EINVAL;
+
+  data_count = st40_get_udw(2, words);
+  if (!st40_check_parity_bits(data_count)) {
+    dbg("%s(%d), data count parity error\n", __func__, ctx->idx);
+    return -EINVAL;
+  }
+  udw_size = data_count & 0xff;
+
+  /* DID, SDID, DATA_COUNT, UDW and checksum words, aligned to 32 bits */
+  total_size = ((3 + udw_size + 1) * 10) / 8;
+  total_size = (4 - total_size % 4) + total_size;
+  payload_len = sizeof(*payload_hdr) - 4 + total_size;
+  if (len < payload_len) {
+    dbg("%s(%d), len %u too small for %u udw\n", __func__, ctx->idx, len, udw_size);
+    return -EINVAL;
+  }
+  *anc_len = payload_len;
+
+  did = st40_get_udw(0, words);
+  sdid = st40_get_udw(1, words);
+  if (!st40_check_parity_bits(did) || !st40_check_parity_bits(sdid)) {
+    dbg("%s(%d), did/sdid parity error\n", __func__, ctx->idx);
+    return -EIO;
+  }
+  checksum = st40_get_udw(3 + udw_size, words);
+  if (checksum != st40_calc_checksum(3 + udw_size, words)) {
+    dbg("%s(%d), checksum error\n", __func__, ctx->idx);
+    return -EIO;
+  }
+  for (uint8_t i = 0; i < udw_size; i++) {
+    udw = st40_get_udw(3 + i, words);
+    if (!st40_check_parity_bits(udw)) {
+      dbg("%s(%d), udw %u parity error\n", __func__, ctx->idx, i);
+      return -EIO;
+    }
+    pkt->udw[i] = udw & 0xff;
+  }
+
+  hdr.swaped_first_hdr_chunk = ntohl(payload_hdr->swaped_first_hdr_chunk);
+  pkt->c = hdr.first_hdr_chunk.c;
+  pkt->line_number = hdr.first_hdr_chunk.line_number;
+  pkt->hori_offset = hdr.first_hdr_chunk.horizontal_offset;
+  pkt->s = hdr.first_hdr_chunk.s;
+  pkt->stream_num = hdr.first_hdr_chunk.stream_num;
+  pkt->did = did & 0xff;
+  pkt->sdid = sdid & 0xff;
+  pkt->udw_size = udw_size;
+  return 0;
+}
+
+/* return the number of frames delivered, ctx->assembling_lock should be locked */
+static int rx_st40p_handle_rtp(struct st40p_rx_ctx* ctx, void* usrptr, uint16_t len) {
+  struct st40_rfc8331_rtp_hdr* rtp = usrptr;
+  struct st40p_rx_frame* framebuff = ctx->assembling;
+  struct st40_anc_frame* frame;
+  uint8_t* payload;
+  uint32_t tmstamp, remaining, anc_len = 0;
+  int ret, done = 0;
+
+  if (len < sizeof(*rtp)) {
+    rte_atomic32_inc(&ctx->stat_err_pkt);
+    return 0;
+  }
+  tmstamp = ntohl(rtp->base.tmstamp);
+
+  /* all packets of the frame are dropped if no free frame at the first packet */
+  if (ctx->dropping && (ctx->drop_rtp_timestamp == tmstamp)) {
+    rte_atomic32_inc(&ctx->stat_busy);
+    return 0;
+  }
+  ctx->dropping = false;
+
+  /* the marker packet is lost, deliver the frame as a new timestamp arrives */
+  if (framebuff && (framebuff->rtp_timestamp != tmstamp)) {
+    rx_st40p_frame_done(ctx);
+    framebuff = NULL;
+    done++;
+  }
+  if (!framebuff) {
+    framebuff = rx_st40p_ring_get(ctx->free_ring);
+    if (!framebuff) {
+      ctx->dropping = true;
+      ctx->drop_rtp_timestamp = tmstamp;
+      rte_atomic32_inc(&ctx->stat_busy);
+      return done;
+    }
+    framebuff->stat = ST40P_RX_FRAME_IN_ASSEMBLING;
+    framebuff->rtp_timestamp = tmstamp;
+    framebuff->frame.pkt_cnt = 0;
+    framebuff->frame.field = rtp->f;
+    framebuff->frame.tfmt = ST10_TIMESTAMP_FMT_MEDIA_CLK;
+    framebuff->frame.timestamp = tmstamp;
+    ctx->assembling = framebuff;
+  }
+  frame = &framebuff->frame;
+
+  payload = (uint8_t*)&rtp[1];
+  remaining = len - sizeof(*rtp);
+  for (int i = 0; i < rtp->anc_count; i++) {
+    if (frame->pkt_cnt >= ST40_MAX_META) {
+      rte_atomic32_add(&ctx->stat_overflow_pkt, rtp->anc_count - i);
+      break;
+    }
+    ret = rx_st40p_parse_anc(ctx, (struct st40_rfc8331_payload_hdr*)payload, remaining,
+                             &frame->pkts[frame->pkt_cnt], &anc_len);
+    if (ret == -EINVAL) {
+      rte_atomic32_inc(&ctx->stat_err_pkt);
+      break;
+    }
+    if (ret < 0)
+      rte_atomic32_inc(&ctx->stat_err_pkt);
+    else
+      frame->pkt_cnt++;
+    payload += anc_len;
+    remaining -= anc_len;
+  }
+
+  /* the last packet of the field or frame */
+  if (rtp->base.marker) {
+    rx_st40p_frame_done(ctx);
+    done++;
+  } else {
+    ctx->assembling_last_ns = mt_get_tsc(ctx->impl);
+  }
+
+  return done;
+}
+
+static int rx_st40p_rtp_ready(void* priv) {
+  struct st40p_rx_ctx* ctx = priv;
+  void* mbuf;
+  void* usrptr;
+  uint16_t len;
+  int done;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  /* the lcore tasklet is the only consumer of the transport rtp ring */
+  while ((mbuf = st40_rx_get_mbuf(ctx->transport, &usrptr, &len))) {
+    rte_spinlock_lock(&ctx->assembling_lock);
+    done = rx_st40p_handle_rtp(ctx, usrptr, len);
+    rte_spinlock_unlock(&ctx->assembling_lock);
+    st40_rx_put_mbuf(ctx->transport, mbuf);
+    /* never call into app with the assembling_lock held */
+    if (done) rx_st40p_notify_frame_available(ctx);
+  }
+
+  return 0;
+}
+
+static int rx_st40p_stat(void* priv) {
+  struct st40p_rx_ctx* ctx = priv;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  notice("RX_ST40P(%s), free %u ready %u\n", ctx->ops_name,
+         rte_ring_count(ctx->free_ring), rte_ring_count(ctx->ready_ring));
+
+  int busy = rte_atomic32_read(&ctx->stat_busy);
+  rte_atomic32_set(&ctx->stat_busy, 0);
+  if (busy) {
+    notice("RX_ST40P(%s), busy drop rtp %d\n", ctx->ops_name, busy);
+  }
+
+  int err_pkt = rte_atomic32_read(&ctx->stat_err_pkt);
+  rte_atomic32_set(&ctx->stat_err_pkt, 0);
+  if (err_pkt) {
+    notice("RX_ST40P(%s), parity or checksum error pkt %d\n", ctx->ops_name, err_pkt);
+  }
+
+  int overflow_pkt = rte_atomic32_read(&ctx->stat_overflow_pkt);
+  rte_atomic32_set(&ctx->stat_overflow_pkt, 0);
+  if (overflow_pkt) {
+    notice("RX_ST40P(%s), overflow drop pkt %d\n", ctx->ops_name, overflow_pkt);
+  }
+
+  int timeout_frame = rte_atomic32_read(&ctx->stat_timeout_frame);
+  rte_atomic32_set(&ctx->stat_timeout_frame, 0);
+  if (timeout_frame) {
+    notice("RX_ST40P(%s), assemble timeout frame %d\n", ctx->ops_name, timeout_frame);
+  }
+
+  return 0;
+}
+
+static int rx_st40p_create_transport(struct mtl_main_impl* impl, struct st40p_rx_ctx* ctx,
+                                     struct st40p_rx_ops* ops) {
+  int idx = ctx->idx;
+  struct st40_rx_ops ops_rx;
+  st40_rx_handle transport;
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = ops->name;
+  ops_rx.priv = ctx;
+  ops_rx.num_port = RTE_MIN(ops->port.num_port, MTL_SESSION_PORT_MAX);
+  for (int i = 0; i < ops_rx.num_port; i++) {
+    memcpy(ops_rx.sip_addr[i], ops->port.sip_addr[i], MTL_IP_ADDR_LEN);
+    snprintf(ops_rx.port[i], MTL_PORT_MAX_LEN, "%s", ops->port.port[i]);
+    ops_rx.udp_port[i] = ops->port.udp_port[i];
+  }
+  if (ops->flags & ST40P_RX_FLAG_DATA_PATH_ONLY)
+    ops_rx.flags |= ST40_RX_FLAG_DATA_PATH_ONLY;
+  ops_rx.payload_type = ops->port.payload_type;
+  ops_rx.rtp_ring_size = ST40P_RX_RTP_RING_SIZE;
+  ops_rx.notify_rtp_ready = rx_st40p_rtp_ready;
+
+  transport = st40_rx_create(impl, &ops_rx);
+  if (!transport) {
+    err("%s(%d), transport create fail\n", __func__, idx);
+    return -EIO;
+  }
+  ctx->transport = transport;
+
+  return 0;
+}
+
+static int rx_st40p_uinit_fbs(struct st40p_rx_ctx* ctx) {
+  if (ctx->framebuffs) {
+    mt_rte_free(ctx->framebuffs);
+    ctx->framebuffs = NULL;
+  }
+
+  if (ctx->free_ring) {
+    rte_ring_free(ctx->free_ring);
+    ctx->free_ring = NULL;
+  }
+  if (ctx->ready_ring) {
+    rte_ring_free(ctx->ready_ring);
+    ctx->ready_ring = NULL;
+  }
+
+  return 0;
+}
+
+static int rx_st40p_init_fbs(struct mtl_main_impl* impl, struct st40p_rx_ctx* ctx,
+                             struct st40p_rx_ops* ops) {
+  int idx = ctx->idx;
+  int soc_id = mt_socket_id(impl, MTL_PORT_P);
+  struct st40p_rx_frame* frames;
+
+  ctx->framebuff_cnt = ops->framebuff_cnt;
+  frames = mt_rte_zmalloc_socket(sizeof(*frames) * ctx->framebuff_cnt, soc_id);
+  if (!frames) {
+    err("%s(%d), frames malloc fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+  ctx->framebuffs = frames;
+
+  ctx->free_ring = rx_st40p_ring_create(ctx, "FREE");
+  ctx->ready_ring = rx_st40p_ring_create(ctx, "READY");
+  if (!ctx->free_ring || !ctx->ready_ring) {
+    rx_st40p_uinit_fbs(ctx);
+    return -ENOMEM;
+  }
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    frames[i].idx = i;
+    frames[i].frame.priv = &frames[i];
+    rx_st40p_ring_put(ctx->free_ring, &frames[i], ST40P_RX_FRAME_FREE);
+  }
+
+  info("%s(%d), succ with %u frames\n", __func__, idx, ctx->framebuff_cnt);
+  return 0;
+}
+
+struct st40_anc_frame* st40p_rx_get_frame(st40p_rx_handle handle) {
+  struct st40p_rx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st40p_rx_frame* framebuff;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return NULL;
+  }
+
+  if (!ctx->ready) return NULL; /* not ready */
+
+  mt_event_fd_ack(&ctx->event);
+
+  framebuff = rx_st40p_ring_get(ctx->ready_ring);
+  if (!framebuff && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    framebuff = rx_st40p_ring_get(ctx->ready_ring);
+    if (!framebuff) {
+      rx_st40p_block_wait(ctx);
+      framebuff = rx_st40p_ring_get(ctx->ready_ring);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
+    mt_pthread_mutex_unlock(&ctx->lock);
+  }
+  /* not any ready frame */
+  if (!framebuff) return NULL;
+
+  framebuff->stat = ST40P_RX_FRAME_IN_USER;
+
+  dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
+  return &framebuff->frame;
+}
+
+int st40p_rx_put_frame(st40p_rx_handle handle, struct st40_anc_frame* frame) {
+  struct st40p_rx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st40p_rx_frame* framebuff = frame->priv;
+  uint16_t consumer_idx = framebuff->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ST40P_RX_FRAME_IN_USER != framebuff->stat) {
+    err("%s(%d), frame %u not in user %d\n", __func__, idx, consumer_idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  rx_st40p_ring_put(ctx->free_ring, framebuff, ST40P_RX_FRAME_FREE);
+  dbg("%s(%d), frame %u succ\n", __func__, idx, consumer_idx);
+
+  return 0;
+}
+
+st40p_rx_handle st40p_rx_create(mtl_handle mt, struct st40p_rx_ops* ops) {
+  static int st40p_rx_idx;
+  struct mtl_main_impl* impl = mt;
+  struct st40p_rx_ctx* ctx;
+  int ret;
+  int idx = st40p_rx_idx;
+
+  notice("%s, start for %s\n", __func__, mt_string_safe(ops->name));
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+
+  uint32_t no_notify_flags = ST40P_RX_FLAG_BLOCK_GET | ST40P_RX_FLAG_EVENT_FD;
+  if (!(ops->flags & no_notify_flags) && !ops->notify_frame_available) {
+    err("%s, pls set notify_frame_available\n", __func__);
+    return NULL;
+  }
+
+  ctx = mt_rte_zmalloc_socket(sizeof(*ctx), mt_socket_id(impl, MTL_PORT_P));
+  if (!ctx) {
+    err("%s, ctx malloc fail\n", __func__);
+    return NULL;
+  }
+
+  ctx->idx = idx;
+  ctx->ready = false;
+  ctx->impl = impl;
+  ctx->type = MT_ST40_HANDLE_PIPELINE_RX;
+  rte_atomic32_set(&ctx->stat_busy, 0);
+  rte_atomic32_set(&ctx->stat_err_pkt, 0);
+  rte_atomic32_set(&ctx->stat_overflow_pkt, 0);
+  rte_atomic32_set(&ctx->stat_timeout_frame, 0);
+  rte_spinlock_init(&ctx->assembling_lock);
+  uint32_t assemble_timeout_us = ops->assemble_timeout_us;
+  if (!assemble_timeout_us) assemble_timeout_us = ST40P_RX_ASSEMBLE_TIMEOUT_US;
+  ctx->assemble_timeout_ns = (uint64_t)assemble_timeout_us * NS_PER_US;
+  mt_pthread_mutex_init(&ctx->lock, NULL);
+  mt_pthread_cond_wait_init(&ctx->block_wake_cond);
+  rte_atomic32_set(&ctx->block_waiters, 0);
+  ctx->block_get = (ops->flags & ST40P_RX_FLAG_BLOCK_GET) ? true : false;
+  ctx->block_timeout_ns = ST_PIPELINE_BLOCK_TIMEOUT_NS;
+  ctx->event.fd = -1;
+
+  /* copy ops */
+  if (ops->name) {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "%s", ops->name);
+  } else {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "ST40P_RX_%d", idx);
+  }
+  ctx->ops = *ops;
+
+  if (ops->flags & ST40P_RX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&ctx->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      st40p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
+  /* init fbs */
+  ret = rx_st40p_init_fbs(impl, ctx, ops);
+  if (ret < 0) {
+    err("%s(%d), init fbs fail %d\n", __func__, idx, ret);
+    st40p_rx_free(ctx);
+    return NULL;
+  }
+
+  /* crete transport handle */
+  ret = rx_st40p_create_transport(impl, ctx, ops);
+  if (ret < 0) {
+    err("%s(%d), create transport fail\n", __func__, idx);
+    st40p_rx_free(ctx);
+    return NULL;
+  }
+
+  ret = rte_eal_alarm_set(assemble_timeout_us, rx_st40p_assemble_alarm, ctx);
+  if (ret < 0) {
+    err("%s(%d), assemble alarm set fail %d\n", __func__, idx, ret);
+    st40p_rx_free(ctx);
+    return NULL;
+  }
+  ctx->alarm_started = true;
+
+  mt_stat_register(impl, rx_st40p_stat, ctx, ctx->ops_name);
+
+  /* all ready now */
+  ctx->ready = true;
+  notice("%s(%d), succ\n", __func__, idx);
+  st40p_rx_idx++;
+
+  return ctx;
+}
+
+int st40p_rx_free(st40p_rx_handle handle) {
+  struct st40p_rx_ctx* ctx = handle;
+
+  notice("%s(%d), start\n", __func__, ctx->idx);
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, ctx->idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->ready) mt_stat_unregister(ctx->impl, rx_st40p_stat, ctx);
+
+  if (ctx->alarm_started) {
+    rte_eal_alarm_cancel(rx_st40p_assemble_alarm, ctx);
+    ctx->alarm_started = false;
+  }
+
+  if (ctx->transport) {
+    st40_rx_free(ctx->transport);
+    ctx->transport = NULL;
+  }
+  rx_st40p_uinit_fbs(ctx);
+
+  mt_pthread_mutex_destroy(&ctx->lock);
+  mt_pthread_cond_destroy(&ctx->block_wake_cond);
+  mt_event_fd_uinit(&ctx->event);
+  notice("%s(%d), succ\n", __func__, ctx->idx);
+  mt_rte_free(ctx);
+
+  return 0;
+}
+
+int st40p_rx_get_queue_meta(st40p_rx_handle handle, struct st_queue_meta* meta) {
+  struct st40p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  return st40_rx_get_queue_meta(ctx->transport, meta);
+}
+
+int st40p_rx_wake_block(st40p_rx_handle handle) {
+  struct st40p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->block_get) rx_st40p_block_wake(ctx);
+
+  return 0;
+}
+
+int st40p_rx_set_block_timeout(st40p_rx_handle handle, uint64_t timedwait_ns) {
+  struct st40p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  ctx->block_timeout_ns = timedwait_ns;
+  return 0;
+}
+
+int st40p_rx_get_event_fd(st40p_rx_handle handle) {
+  struct st40p_rx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_RX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, cidx);
+    return -EIO;
+  }
+
+  return ctx->event.fd;
+}
@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_ST40_RX_HEAD_H_
+#define _ST_LIB_PIPELINE_ST40_RX_HEAD_H_
+
+#include "../st_main.h"
+
+/* the rtp ring size of the rx transport, power of 2 */
+#define ST40P_RX_RTP_RING_SIZE (1024)
+
+enum st40p_rx_frame_status {
+  ST40P_RX_FRAME_FREE = 0,
+  ST40P_RX_FRAME_IN_ASSEMBLING, /* the rtp packets of this frame are arriving */
+  ST40P_RX_FRAME_READY,
+  ST40P_RX_FRAME_IN_USER,
+  ST40P_RX_FRAME_STATUS_MAX,
+};
+
+struct st40p_rx_frame {
+  enum st40p_rx_frame_status stat;
+  struct st40_anc_frame frame; /* user frame */
+  uint32_t rtp_timestamp;
+  uint16_t idx;
+};
+
+struct st40p_rx_ctx {
+  struct mtl_main_impl* impl;
+  int idx;
+  enum mt_handle_type type; /* for sanity check */
+
+  char ops_name[ST_MAX_NAME_LEN];
+  struct st40p_rx_ops ops;
+
+  st40_rx_handle transport;
+  uint16_t framebuff_cnt;
+  struct st40p_rx_frame* framebuffs;
+  /* lock-free rings of framebuff pointer for each queued state */
+  struct rte_ring* free_ring;  /* ST40P_RX_FRAME_FREE */
+  struct rte_ring* ready_ring; /* ST40P_RX_FRAME_READY */
+  pthread_mutex_t lock;        /* only for the block wait */
+  /*
+   * the frame in assembling, accessed from the rtp ready callback and the timeout
+   * alarm, protected by assembling_lock.
+   */
+  rte_spinlock_t assembling_lock;
+  struct st40p_rx_frame* assembling;
+  uint64_t assembling_last_ns; /* the time of the last rtp of assembling */
+  uint64_t assemble_timeout_ns;
+  /* drop the rtp of this timestamp as no free frame */
+  bool dropping;
+  uint32_t drop_rtp_timestamp;
+  bool alarm_started;
+
+  bool ready;
+
+  /* for ST40P_RX_FLAG_BLOCK_GET, wait on lock */
+  bool block_get;
+  pthread_cond_t block_wake_cond;
+  rte_atomic32_t block_waiters; /* the block get waiting on block_wake_cond */
+  uint64_t block_timeout_ns;
+
+  /* for ST40P_RX_FLAG_EVENT_FD */
+  struct mt_event_fd event;
+
+  rte_atomic32_t stat_busy;
+  rte_atomic32_t stat_err_pkt;
+  rte_atomic32_t stat_overflow_pkt;
+  rte_atomic32_t stat_timeout_frame;
+};
+
+#endif
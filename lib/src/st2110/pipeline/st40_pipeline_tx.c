@@ -0,0 +1,498 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include "st40_pipeline_tx.h"
+
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+
+static struct rte_ring* tx_st40p_ring_create(struct st40p_tx_ctx* ctx, const char* tag) {
+  char ring_name[32];
+  struct rte_ring* ring;
+
+  snprintf(ring_name, sizeof(ring_name), "ST40PTX%d_%s", ctx->idx, tag);
+  /* multi-producer and multi-consumer, exact size to hold all frames */
+  ring = rte_ring_create(ring_name, ctx->framebuff_cnt,
+                         mt_socket_id(ctx->impl, MTL_PORT_P), RING_F_EXACT_SZ);
+  if (!ring) err("%s(%d), rte_ring_create %s fail\n", __func__, ctx->idx, ring_name);
+  return ring;
+}
+
+/* move the frame to the desired state ring */
+static inline void tx_st40p_ring_put(struct rte_ring* ring,
+                                     struct st40p_tx_frame* framebuff,
+                                     enum st40p_tx_frame_status stat) {
+  framebuff->stat = stat;
+  /* never full as the ring can hold all frames */
+  rte_ring_mp_enqueue(ring, framebuff);
+}
+
+static inline struct st40p_tx_frame* tx_st40p_ring_get(struct rte_ring* ring) {
+  struct st40p_tx_frame* framebuff;
+  if (rte_ring_mc_dequeue(ring, (void**)&framebuff) < 0) return NULL;
+  return framebuff;
+}
+
+static void tx_st40p_block_wake(struct st40p_tx_ctx* ctx) {
+  /* order the frame enqueue before the waiters read */
+  rte_smp_mb();
+  /* only lock and signal when any block get is waiting */
+  if (!rte_atomic32_read(&ctx->block_waiters)) return;
+  mt_pthread_mutex_lock(&ctx->lock);
+  mt_pthread_cond_signal(&ctx->block_wake_cond);
+  mt_pthread_mutex_unlock(&ctx->lock);
+}
+
+static void tx_st40p_notify_frame_available(struct st40p_tx_ctx* ctx) {
+  if (ctx->ops.notify_frame_available) { /* notify app */
+    ctx->ops.notify_frame_available(ctx->ops.priv);
+  }
+
+  if (ctx->block_get) tx_st40p_block_wake(ctx);
+
+  mt_event_fd_notify(&ctx->event);
+}
+
+/* wait until any frame status change or timeout, ctx->lock should be locked */
+static void tx_st40p_block_wait(struct st40p_tx_ctx* ctx) {
+  dbg("%s(%d), start\n", __func__, ctx->idx);
+  mt_pthread_cond_timedwait_ns(&ctx->block_wake_cond, &ctx->lock, ctx->block_timeout_ns);
+  dbg("%s(%d), end\n", __func__, ctx->idx);
+}
+
+/* fill the transport frame, the parity bits and checksum are added by transport */
+static int tx_st40p_fill_transport(struct st40p_tx_ctx* ctx,
+                                   struct st40p_tx_frame* framebuff) {
+  struct st40_anc_frame* frame = &framebuff->frame;
+  struct st40_frame* dst = framebuff->transport_frame;
+  struct st40_anc_pkt* pkt;
+  struct st40_meta* meta;
+  uint32_t offset = 0;
+
+  if (frame->pkt_cnt > ST40_MAX_META) {
+    err("%s(%d), invalid pkt_cnt %u, max %d\n", __func__, ctx->idx, frame->pkt_cnt,
+        ST40_MAX_META);
+    return -EINVAL;
+  }
+
+  for (uint32_t i = 0; i < frame->pkt_cnt; i++) {
+    pkt = &frame->pkts[i];
+    meta = &dst->meta[i];
+    meta->c = pkt->c;
+    meta->line_number = pkt->line_number;
+    meta->hori_offset = pkt->hori_offset;
+    meta->s = pkt->s;
+    meta->stream_num = pkt->stream_num;
+    meta->did = pkt->did;
+    meta->sdid = pkt->sdid;
+    meta->udw_size = pkt->udw_size;
+    meta->udw_offset = offset;
+    rte_memcpy(framebuff->udw_buf + offset, pkt->udw, pkt->udw_size);
+    offset += pkt->udw_size;
+  }
+  /* no udw is fine, transport send an empty rfc8331 packet with ANC_Count 0 */
+  dst->data = framebuff->udw_buf;
+  dst->data_size = offset;
+  dst->meta_num = frame->pkt_cnt;
+
+  return 0;
+}
+
+static int tx_st40p_next_frame(void* priv, uint16_t* next_frame_idx,
+                               struct st40_tx_frame_meta* meta) {
+  struct st40p_tx_ctx* ctx = priv;
+  struct st40p_tx_frame* framebuff;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  framebuff = tx_st40p_ring_get(ctx->ready_ring);
+  /* not any ready frame */
+  if (!framebuff) return -EBUSY;
+
+  framebuff->stat = ST40P_TX_FRAME_IN_TRANSMITTING;
+  *next_frame_idx = framebuff->idx;
+  if (ctx->ops.flags & (ST40P_TX_FLAG_USER_PACING | ST40P_TX_FLAG_USER_TIMESTAMP)) {
+    meta->tfmt = framebuff->frame.tfmt;
+    meta->timestamp = framebuff->frame.timestamp;
+    dbg("%s(%d), frame %u succ timestamp %" PRIu64 "\n", __func__, ctx->idx,
+        framebuff->idx, meta->timestamp);
+  }
+  dbg("%s(%d), frame %u succ\n", __func__, ctx->idx, framebuff->idx);
+  return 0;
+}
+
+static int tx_st40p_frame_done(void* priv, uint16_t frame_idx,
+                               struct st40_tx_frame_meta* meta) {
+  struct st40p_tx_ctx* ctx = priv;
+  int ret;
+  struct st40p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
+
+  framebuff->frame.tfmt = meta->tfmt;
+  framebuff->frame.timestamp = meta->timestamp;
+
+  if (ST40P_TX_FRAME_IN_TRANSMITTING == framebuff->stat) {
+    ret = 0;
+    tx_st40p_ring_put(ctx->free_ring, framebuff, ST40P_TX_FRAME_FREE);
+    dbg("%s(%d), done_idx %u\n", __func__, ctx->idx, frame_idx);
+  } else {
+    ret = -EIO;
+    err("%s(%d), err status %d for frame %u\n", __func__, ctx->idx, framebuff->stat,
+        frame_idx);
+  }
+
+  if (ctx->ops.notify_frame_done) { /* notify app which frame done */
+    ctx->ops.notify_frame_done(ctx->ops.priv, &framebuff->frame);
+  }
+
+  tx_st40p_notify_frame_available(ctx);
+
+  return ret;
+}
+
+static int tx_st40p_stat(void* priv) {
+  struct st40p_tx_ctx* ctx = priv;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  notice("TX_ST40P(%s), free %u ready %u\n", ctx->ops_name,
+         rte_ring_count(ctx->free_ring), rte_ring_count(ctx->ready_ring));
+  return 0;
+}
+
+static int tx_st40p_create_transport(struct mtl_main_impl* impl, struct st40p_tx_ctx* ctx,
+                                     struct st40p_tx_ops* ops) {
+  int idx = ctx->idx;
+  struct st40_tx_ops ops_tx;
+  st40_tx_handle transport;
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = ops->name;
+  ops_tx.priv = ctx;
+  ops_tx.num_port = RTE_MIN(ops->port.num_port, MTL_SESSION_PORT_MAX);
+  for (int i = 0; i < ops_tx.num_port; i++) {
+    memcpy(ops_tx.dip_addr[i], ops->port.dip_addr[i], MTL_IP_ADDR_LEN);
+    snprintf(ops_tx.port[i], MTL_PORT_MAX_LEN, "%s", ops->port.port[i]);
+    ops_tx.udp_src_port[i] = ops->port.udp_src_port[i];
+    ops_tx.udp_port[i] = ops->port.udp_port[i];
+  }
+  if (ops->flags & ST40P_TX_FLAG_USER_P_MAC) {
+    memcpy(&ops_tx.tx_dst_mac[MTL_SESSION_PORT_P][0], &ops->tx_dst_mac[MTL_PORT_P][0],
+           MTL_MAC_ADDR_LEN);
+    ops_tx.flags |= ST40_TX_FLAG_USER_P_MAC;
+  }
+  if (ops->flags & ST40P_TX_FLAG_USER_R_MAC) {
+    memcpy(&ops_tx.tx_dst_mac[MTL_SESSION_PORT_R][0], &ops->tx_dst_mac[MTL_PORT_R][0],
+           MTL_MAC_ADDR_LEN);
+    ops_tx.flags |= ST40_TX_FLAG_USER_R_MAC;
+  }
+  if (ops->flags & ST40P_TX_FLAG_USER_PACING) ops_tx.flags |= ST40_TX_FLAG_USER_PACING;
+  if (ops->flags & ST40P_TX_FLAG_USER_TIMESTAMP)
+    ops_tx.flags |= ST40_TX_FLAG_USER_TIMESTAMP;
+  ops_tx.fps = ops->fps;
+  ops_tx.payload_type = ops->port.payload_type;
+  ops_tx.type = ST40_TYPE_FRAME_LEVEL;
+  ops_tx.framebuff_cnt = ops->framebuff_cnt;
+  ops_tx.get_next_frame = tx_st40p_next_frame;
+  ops_tx.notify_frame_done = tx_st40p_frame_done;
+
+  transport = st40_tx_create(impl, &ops_tx);
+  if (!transport) {
+    err("%s(%d), transport create fail\n", __func__, idx);
+    return -EIO;
+  }
+  ctx->transport = transport;
+
+  struct st40p_tx_frame* frames = ctx->framebuffs;
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    frames[i].transport_frame = st40_tx_get_framebuffer(transport, i);
+  }
+
+  return 0;
+}
+
+static int tx_st40p_uinit_fbs(struct st40p_tx_ctx* ctx) {
+  if (ctx->framebuffs) {
+    for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+      if (ctx->framebuffs[i].udw_buf) {
+        mt_rte_free(ctx->framebuffs[i].udw_buf);
+        ctx->framebuffs[i].udw_buf = NULL;
+      }
+    }
+    mt_rte_free(ctx->framebuffs);
+    ctx->framebuffs = NULL;
+  }
+
+  if (ctx->free_ring) {
+    rte_ring_free(ctx->free_ring);
+    ctx->free_ring = NULL;
+  }
+  if (ctx->ready_ring) {
+    rte_ring_free(ctx->ready_ring);
+    ctx->ready_ring = NULL;
+  }
+
+  return 0;
+}
+
+static int tx_st40p_init_fbs(struct mtl_main_impl* impl, struct st40p_tx_ctx* ctx,
+                             struct st40p_tx_ops* ops) {
+  int idx = ctx->idx;
+  int soc_id = mt_socket_id(impl, MTL_PORT_P);
+  struct st40p_tx_frame* frames;
+  uint8_t* udw_buf;
+
+  ctx->framebuff_cnt = ops->framebuff_cnt;
+  frames = mt_rte_zmalloc_socket(sizeof(*frames) * ctx->framebuff_cnt, soc_id);
+  if (!frames) {
+    err("%s(%d), frames malloc fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+  ctx->framebuffs = frames;
+
+  ctx->free_ring = tx_st40p_ring_create(ctx, "FREE");
+  ctx->ready_ring = tx_st40p_ring_create(ctx, "READY");
+  if (!ctx->free_ring || !ctx->ready_ring) {
+    tx_st40p_uinit_fbs(ctx);
+    return -ENOMEM;
+  }
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    frames[i].idx = i;
+    /* enough for the max udw of all packets */
+    udw_buf = mt_rte_zmalloc_socket(ST40_MAX_META * ST40_MAX_UDW, soc_id);
+    if (!udw_buf) {
+      err("%s(%d), udw buf malloc fail at %u\n", __func__, idx, i);
+      tx_st40p_uinit_fbs(ctx);
+      return -ENOMEM;
+    }
+    frames[i].udw_buf = udw_buf;
+    frames[i].frame.priv = &frames[i];
+    tx_st40p_ring_put(ctx->free_ring, &frames[i], ST40P_TX_FRAME_FREE);
+  }
+
+  info("%s(%d), succ with %u frames\n", __func__, idx, ctx->framebuff_cnt);
+  return 0;
+}
+
+struct st40_anc_frame* st40p_tx_get_frame(st40p_tx_handle handle) {
+  struct st40p_tx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st40p_tx_frame* framebuff;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return NULL;
+  }
+
+  if (!ctx->ready) return NULL; /* not ready */
+
+  mt_event_fd_ack(&ctx->event);
+
+  framebuff = tx_st40p_ring_get(ctx->free_ring);
+  if (!framebuff && ctx->block_get) { /* wait here */
+    mt_pthread_mutex_lock(&ctx->lock);
+    rte_atomic32_inc(&ctx->block_waiters);
+    /* check again with the waiter counted to not miss the wake */
+    framebuff = tx_st40p_ring_get(ctx->free_ring);
+    if (!framebuff) {
+      tx_st40p_block_wait(ctx);
+      framebuff = tx_st40p_ring_get(ctx->free_ring);
+    }
+    rte_atomic32_dec(&ctx->block_waiters);
+    mt_pthread_mutex_unlock(&ctx->lock);
+  }
+  /* not any free frame */
+  if (!framebuff) return NULL;
+
+  framebuff->stat = ST40P_TX_FRAME_IN_USER;
+
+  dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
+  return &framebuff->frame;
+}
+
+int st40p_tx_put_frame(st40p_tx_handle handle, struct st40_anc_frame* frame) {
+  struct st40p_tx_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st40p_tx_frame* framebuff = frame->priv;
+  uint16_t producer_idx = framebuff->idx;
+  int ret;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ST40P_TX_FRAME_IN_USER != framebuff->stat) {
+    err("%s(%d), frame %u not in user %d\n", __func__, idx, producer_idx,
+        framebuff->stat);
+    return -EIO;
+  }
+
+  /* the transport framebuffer is idle as the frame is not in transmitting */
+  ret = tx_st40p_fill_transport(ctx, framebuff);
+  if (ret < 0) {
+    err("%s(%d), frame %u fill fail %d\n", __func__, idx, producer_idx, ret);
+    tx_st40p_ring_put(ctx->free_ring, framebuff, ST40P_TX_FRAME_FREE);
+    tx_st40p_notify_frame_available(ctx);
+    return ret;
+  }
+
+  tx_st40p_ring_put(ctx->ready_ring, framebuff, ST40P_TX_FRAME_READY);
+  dbg("%s(%d), frame %u succ\n", __func__, idx, producer_idx);
+
+  return 0;
+}
+
+st40p_tx_handle st40p_tx_create(mtl_handle mt, struct st40p_tx_ops* ops) {
+  static int st40p_tx_idx;
+  struct mtl_main_impl* impl = mt;
+  struct st40p_tx_ctx* ctx;
+  int ret;
+  int idx = st40p_tx_idx;
+
+  notice("%s, start for %s\n", __func__, mt_string_safe(ops->name));
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+
+  uint32_t no_notify_flags = ST40P_TX_FLAG_BLOCK_GET | ST40P_TX_FLAG_EVENT_FD;
+  if (!(ops->flags & no_notify_flags) && !ops->notify_frame_available) {
+    err("%s, pls set notify_frame_available\n", __func__);
+    return NULL;
+  }
+
+  ctx = mt_rte_zmalloc_socket(sizeof(*ctx), mt_socket_id(impl, MTL_PORT_P));
+  if (!ctx) {
+    err("%s, ctx malloc fail\n", __func__);
+    return NULL;
+  }
+
+  ctx->idx = idx;
+  ctx->ready = false;
+  ctx->impl = impl;
+  ctx->type = MT_ST40_HANDLE_PIPELINE_TX;
+  mt_pthread_mutex_init(&ctx->lock, NULL);
+  mt_pthread_cond_wait_init(&ctx->block_wake_cond);
+  rte_atomic32_set(&ctx->block_waiters, 0);
+  ctx->block_get = (ops->flags & ST40P_TX_FLAG_BLOCK_GET) ? true : false;
+  ctx->block_timeout_ns = ST_PIPELINE_BLOCK_TIMEOUT_NS;
+  ctx->event.fd = -1;
+
+  /* copy ops */
+  if (ops->name) {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "%s", ops->name);
+  } else {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "ST40P_TX_%d", idx);
+  }
+  ctx->ops = *ops;
+
+  if (ops->flags & ST40P_TX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&ctx->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      st40p_tx_free(ctx);
+      return NULL;
+    }
+  }
+
+  /* init fbs */
+  ret = tx_st40p_init_fbs(impl, ctx, ops);
+  if (ret < 0) {
+    err("%s(%d), init fbs fail %d\n", __func__, idx, ret);
+    st40p_tx_free(ctx);
+    return NULL;
+  }
+
+  /* crete transport handle */
+  ret = tx_st40p_create_transport(impl, ctx, ops);
+  if (ret < 0) {
+    err("%s(%d), create transport fail\n", __func__, idx);
+    st40p_tx_free(ctx);
+    return NULL;
+  }
+
+  mt_stat_register(impl, tx_st40p_stat, ctx, ctx->ops_name);
+
+  /* all ready now */
+  ctx->ready = true;
+  notice("%s(%d), fps %d\n", __func__, idx, ops->fps);
+  st40p_tx_idx++;
+
+  tx_st40p_notify_frame_available(ctx);
+
+  return ctx;
+}
+
+int st40p_tx_free(st40p_tx_handle handle) {
+  struct st40p_tx_ctx* ctx = handle;
+
+  notice("%s(%d), start\n", __func__, ctx->idx);
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, ctx->idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->ready) mt_stat_unregister(ctx->impl, tx_st40p_stat, ctx);
+
+  if (ctx->transport) {
+    st40_tx_free(ctx->transport);
+    ctx->transport = NULL;
+  }
+  tx_st40p_uinit_fbs(ctx);
+
+  mt_pthread_mutex_destroy(&ctx->lock);
+  mt_pthread_cond_destroy(&ctx->block_wake_cond);
+  mt_event_fd_uinit(&ctx->event);
+  notice("%s(%d), succ\n", __func__, ctx->idx);
+  mt_rte_free(ctx);
+
+  return 0;
+}
+
+int st40p_tx_wake_block(st40p_tx_handle handle) {
+  struct st40p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->block_get) tx_st40p_block_wake(ctx);
+
+  return 0;
+}
+
+int st40p_tx_set_block_timeout(st40p_tx_handle handle, uint64_t timedwait_ns) {
+  struct st40p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  ctx->block_timeout_ns = timedwait_ns;
+  return 0;
+}
+
+int st40p_tx_get_event_fd(st40p_tx_handle handle) {
+  struct st40p_tx_ctx* ctx = handle;
+  int cidx = ctx->idx;
+
+  if (ctx->type != MT_ST40_HANDLE_PIPELINE_TX) {
+    err("%s(%d), invalid type %d\n", __func__, cidx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, cidx);
+    return -EIO;
+  }
+
+  return ctx->event.fd;
+}
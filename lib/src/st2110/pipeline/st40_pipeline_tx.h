@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_ST40_TX_HEAD_H_
+#define _ST_LIB_PIPELINE_ST40_TX_HEAD_H_
+
+#include "../st_main.h"
+
+enum st40p_tx_frame_status {
+  ST40P_TX_FRAME_FREE = 0,
+  ST40P_TX_FRAME_IN_USER,
+  ST40P_TX_FRAME_READY,
+  ST40P_TX_FRAME_IN_TRANSMITTING, /* for transport */
+  ST40P_TX_FRAME_STATUS_MAX,
+};
+
+struct st40p_tx_frame {
+  enum st40p_tx_frame_status stat;
+  struct st40_anc_frame frame;        /* user frame */
+  struct st40_frame* transport_frame; /* the transport framebuffer with same idx */
+  uint8_t* udw_buf;                   /* the udw data of transport_frame */
+  uint16_t idx;
+};
+
+struct st40p_tx_ctx {
+  struct mtl_main_impl* impl;
+  int idx;
+  enum mt_handle_type type; /* for sanity check */
+
+  char ops_name[ST_MAX_NAME_LEN];
+  struct st40p_tx_ops ops;
+
+  st40_tx_handle transport;
+  uint16_t framebuff_cnt;
+  struct st40p_tx_frame* framebuffs;
+  /* lock-free rings of framebuff pointer for each queued state */
+  struct rte_ring* free_ring;  /* ST40P_TX_FRAME_FREE */
+  struct rte_ring* ready_ring; /* ST40P_TX_FRAME_READY */
+  pthread_mutex_t lock;        /* only for the block wait */
+
+  bool ready;
+
+  /* for ST40P_TX_FLAG_BLOCK_GET, wait on lock */
+  bool block_get;
+  pthread_cond_t block_wake_cond;
+  rte_atomic32_t block_waiters; /* the block get waiting on block_wake_cond */
+  uint64_t block_timeout_ns;
+
+  /* for ST40P_TX_FLAG_EVENT_FD */
+  struct mt_event_fd event;
+};
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "../../mt_log.h"
 #include "../../mt_stat.h"
+#include "st_plugin_batch.h"
 
 static int st_plugins_dump(void* priv);
 
@@ -15,6 +16,219 @@ static inline struct st_plugin_mgr* st_get_plugins_mgr(struct mtl_main_impl* imp
   return &impl->plugin_mgr;
 }
 
+/* loops of the internal converter self benchmark */
+#define ST_PLUGIN_BENCH_LOOPS (3)
+
+typedef double (*st_plugin_bench_fn)(void* priv, enum st_frame_fmt input_fmt,
+                                     enum st_frame_fmt output_fmt, uint32_t width,
+                                     uint32_t height);
+
+/* one capable dev for the request */
+struct st_plugin_candidate {
+  int dev_idx;
+  double rate;  /* pixel rate of the format pair, 0 if unknown */
+  double spare; /* the pixel rate not used by the sessions */
+  bool tried;
+};
+
+static inline double st_plugin_req_load(enum st_fps fps, uint32_t width,
+                                        uint32_t height) {
+  return st_frame_rate(fps) * width * height;
+}
+
+/* one format pair of one dev to benchmark without the mgr lock */
+struct st_plugin_bench_job {
+  struct st_plugin_bench* bench; /* the cache of the dev */
+  int* bench_cnt;
+  st_plugin_bench_fn benchmark;
+  void* priv;
+  rte_atomic32_t* ref_cnt; /* hold the dev during the benchmark, NULL for internal */
+  double rate;
+};
+
+/* the cached pixel rate of one format pair at one resolution, false if not measured */
+static bool st_plugin_bench_lookup(struct st_plugin_bench* bench, int bench_cnt,
+                                   const struct st_plugin_bench* key, double* rate) {
+  int cnt = RTE_MIN(bench_cnt, ST_PLUGIN_MAX_BENCH);
+
+  for (int i = 0; i < cnt; i++) {
+    if (bench[i].input_fmt == key->input_fmt && bench[i].output_fmt == key->output_fmt &&
+        bench[i].width == key->width && bench[i].height == key->height) {
+      *rate = bench[i].pixel_rate;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* the cache is a ring, the oldest entry is replaced when full */
+static void st_plugin_bench_store(struct st_plugin_bench* bench, int* bench_cnt,
+                                  const struct st_plugin_bench* key, double rate) {
+  struct st_plugin_bench* entry;
+  double cached;
+
+  /* another get may measure the same pair meanwhile */
+  if (st_plugin_bench_lookup(bench, *bench_cnt, key, &cached)) return;
+
+  entry = &bench[*bench_cnt % ST_PLUGIN_MAX_BENCH];
+  entry->input_fmt = key->input_fmt;
+  entry->output_fmt = key->output_fmt;
+  entry->width = key->width;
+  entry->height = key->height;
+  entry->pixel_rate = rate;
+  (*bench_cnt)++;
+}
+
+static inline void st_plugin_bench_key(struct st_plugin_bench* key,
+                                       enum st_frame_fmt input_fmt,
+                                       enum st_frame_fmt output_fmt, uint32_t width,
+                                       uint32_t height) {
+  memset(key, 0, sizeof(*key));
+  key->input_fmt = input_fmt;
+  key->output_fmt = output_fmt;
+  key->width = width;
+  key->height = height;
+}
+
+static void st_plugin_bench_job_add(struct st_plugin_bench_job* job,
+                                    struct st_plugin_bench* bench, int* bench_cnt,
+                                    st_plugin_bench_fn benchmark, void* priv,
+                                    rte_atomic32_t* ref_cnt) {
+  job->bench = bench;
+  job->bench_cnt = bench_cnt;
+  job->benchmark = benchmark;
+  job->priv = priv;
+  job->ref_cnt = ref_cnt;
+  job->rate = 0;
+}
+
+/*
+ * Measure the format pair on the first use, a benchmark hook may take a long time so it
+ * runs with the mgr lock released. The caller holds the mgr lock, it's held again on
+ * return. The devs are referenced meanwhile, the unregister fails with -EBUSY.
+ */
+static void st_plugin_bench_run(struct st_plugin_mgr* mgr,
+                                struct st_plugin_bench_job* jobs, int jobs_cnt,
+                                const struct st_plugin_bench* key) {
+  struct st_plugin_bench_job* job;
+  double fps;
+
+  if (!jobs_cnt) return;
+
+  for (int i = 0; i < jobs_cnt; i++) {
+    if (jobs[i].ref_cnt) rte_atomic32_inc(jobs[i].ref_cnt);
+  }
+  mt_pthread_mutex_unlock(&mgr->lock);
+
+  for (int i = 0; i < jobs_cnt; i++) {
+    job = &jobs[i];
+    fps = job->benchmark(job->priv, key->input_fmt, key->output_fmt, key->width,
+                         key->height);
+    job->rate = (fps > 0) ? (fps * key->width * key->height) : -1;
+    info("%s, %s to %s, %ux%u fps %f\n", __func__, st_frame_fmt_name(key->input_fmt),
+         st_frame_fmt_name(key->output_fmt), key->width, key->height, fps);
+  }
+
+  mt_pthread_mutex_lock(&mgr->lock);
+  for (int i = 0; i < jobs_cnt; i++) {
+    job = &jobs[i];
+    st_plugin_bench_store(job->bench, job->bench_cnt, key, job->rate);
+    if (job->ref_cnt) rte_atomic32_dec(job->ref_cnt);
+  }
+}
+
+/* the pixel rate of the request on one dev, < 0 not supported, 0 unknown */
+static double st_plugin_bench_rate(struct st_plugin_bench* bench, int bench_cnt,
+                                   const struct st_plugin_bench* key) {
+  double rate;
+
+  if (!st_plugin_bench_lookup(bench, bench_cnt, key, &rate)) return 0;
+  return rate;
+}
+
+/* 0: enough spare capacity, 1: unknown capacity, 2: overloaded */
+static inline int st_plugin_candidate_tier(struct st_plugin_candidate* cand,
+                                           double need) {
+  if (cand->rate <= 0) return 1;
+  return (cand->spare >= need) ? 0 : 2;
+}
+
+/*
+ * The next dev to try: the one with the most spare capacity if it can hold the request,
+ * then the devs without benchmark in register order, then the least overloaded one.
+ */
+static struct st_plugin_candidate* st_plugin_next_candidate(
+    struct st_plugin_candidate* cands, int cands_cnt, double need) {
+  struct st_plugin_candidate* best = NULL;
+  struct st_plugin_candidate* cand;
+  int tier, best_tier = 0;
+
+  for (int i = 0; i < cands_cnt; i++) {
+    cand = &cands[i];
+    if (cand->tried) continue;
+    tier = st_plugin_candidate_tier(cand, need);
+    if (!best || tier < best_tier ||
+        (tier == best_tier && tier != 1 && cand->spare > best->spare)) {
+      best = cand;
+      best_tier = tier;
+    }
+  }
+  if (best) best->tried = true;
+
+  return best;
+}
+
+static double st20_internal_convert_bench(void* priv, enum st_frame_fmt input_fmt,
+                                          enum st_frame_fmt output_fmt, uint32_t width,
+                                          uint32_t height) {
+  struct mtl_main_impl* impl = priv;
+  struct st_frame_converter converter;
+  struct st_frame src, dst;
+  size_t src_size, dst_size;
+  void* src_addr = NULL;
+  void* dst_addr = NULL;
+  uint64_t start, ns;
+  double fps = 0;
+
+  memset(&converter, 0, sizeof(converter));
+  if (st_frame_get_converter(input_fmt, output_fmt, &converter) < 0) return 0;
+  src_size = st_frame_size(input_fmt, width, height, false);
+  dst_size = st_frame_size(output_fmt, width, height, false);
+  if (!src_size || !dst_size) return 0;
+
+  src_addr = mt_rte_zmalloc_socket(src_size, mt_socket_id(impl, MTL_PORT_P));
+  dst_addr = mt_rte_zmalloc_socket(dst_size, mt_socket_id(impl, MTL_PORT_P));
+  if (!src_addr || !dst_addr) {
+    err("%s, frame malloc fail\n", __func__);
+    goto exit;
+  }
+
+  memset(&src, 0, sizeof(src));
+  src.fmt = input_fmt;
+  src.width = width;
+  src.height = height;
+  src.buffer_size = src_size;
+  src.data_size = src_size;
+  st_frame_init_plane_single_src(&src, src_addr, 0);
+  memset(&dst, 0, sizeof(dst));
+  dst.fmt = output_fmt;
+  dst.width = width;
+  dst.height = height;
+  dst.buffer_size = dst_size;
+  dst.data_size = dst_size;
+  st_frame_init_plane_single_src(&dst, dst_addr, 0);
+
+  start = mt_get_monotonic_time();
+  for (int i = 0; i < ST_PLUGIN_BENCH_LOOPS; i++) converter.convert_func(&src, &dst);
+  ns = mt_get_monotonic_time() - start;
+  if (ns) fps = (double)ST_PLUGIN_BENCH_LOOPS * NS_PER_S / ns;
+
+exit:
+  if (src_addr) mt_rte_free(src_addr);
+  if (dst_addr) mt_rte_free(dst_addr);
+  return fps;
+}
+
 static int st_plugin_free(struct st_dl_plugin_impl* plugin) {
   if (plugin->free) plugin->free(plugin->handle);
   if (plugin->dl_handle) {
@@ -51,6 +265,7 @@ int st_plugins_uinit(struct mtl_main_impl* impl) {
   for (int i = 0; i < ST_MAX_ENCODER_DEV; i++) {
     if (mgr->encode_devs[i]) {
       dbg("%s, still has encode dev in %d\n", __func__, i);
+      if (mgr->encode_devs[i]->batch) st_plugin_batch_free(mgr->encode_devs[i]->batch);
       mt_rte_free(mgr->encode_devs[i]);
       mgr->encode_devs[i] = NULL;
     }
@@ -58,6 +273,7 @@ int st_plugins_uinit(struct mtl_main_impl* impl) {
   for (int i = 0; i < ST_MAX_DECODER_DEV; i++) {
     if (mgr->decode_devs[i]) {
       dbg("%s, still has decode dev in %d\n", __func__, i);
+      if (mgr->decode_devs[i]->batch) st_plugin_batch_free(mgr->decode_devs[i]->batch);
       mt_rte_free(mgr->decode_devs[i]);
       mgr->decode_devs[i] = NULL;
     }
@@ -80,6 +296,7 @@ int st22_encode_notify_frame_ready(struct st22_encode_session_impl* encoder) {
   struct st22_encoder_dev* dev = &dev_impl->dev;
   st22_encode_priv session = encoder->session;
 
+  if (dev_impl->batch) return st_plugin_batch_notify(dev_impl->batch);
   return dev->notify_frame_available(session);
 }
 
@@ -91,9 +308,17 @@ int st22_put_encoder(struct mtl_main_impl* impl,
   int idx = dev_impl->idx;
   st22_encode_priv session = encoder->session;
 
+  /*
+   * stop the lib workers on this session before the plugin free it, the drain waits
+   * the inflight frames so do it without the mgr lock. The batch lives until the
+   * ref_cnt of the dev drops.
+   */
+  if (dev_impl->batch) st_plugin_batch_detach(dev_impl->batch, encoder->idx);
   mt_pthread_mutex_lock(&mgr->lock);
   dev->free_session(dev->priv, session);
   encoder->session = NULL;
+  dev_impl->load -= encoder->load;
+  encoder->load = 0;
   rte_atomic32_dec(&dev_impl->ref_cnt);
   mt_pthread_mutex_unlock(&mgr->lock);
 
@@ -108,6 +333,7 @@ static struct st22_encode_session_impl* st22_get_encoder_session(
   struct st22_encoder_create_req* create_req = &req->req;
   struct st22_encode_session_impl* session_impl;
   st22_encode_priv session;
+  int ret;
 
   for (int i = 0; i < ST_MAX_SESSIONS_PER_ENCODER; i++) {
     session_impl = &dev_impl->sessions[i];
@@ -119,6 +345,16 @@ static struct st22_encode_session_impl* st22_get_encoder_session(
       session_impl->codestream_max_size = create_req->max_codestream_size;
       session_impl->req = *req;
       session_impl->type = MT_ST22_HANDLE_PIPELINE_ENCODE;
+      if (dev_impl->batch) {
+        ret = st_plugin_batch_attach(dev_impl->batch, i, session_impl,
+                                     create_req->framebuff_cnt);
+        if (ret < 0) {
+          err("%s(%d), batch attach fail %d at %d\n", __func__, idx, ret, i);
+          dev->free_session(dev->priv, session);
+          session_impl->session = NULL;
+          return NULL;
+        }
+      }
       info("%s(%d), get one session at %d on dev %s, max codestream size %" PRIu64 "\n",
            __func__, idx, i, dev->name, session_impl->codestream_max_size);
       info("%s(%d), input fmt: %s, output fmt: %s\n", __func__, idx,
@@ -154,8 +390,30 @@ struct st22_encode_session_impl* st22_get_encoder(struct mtl_main_impl* impl,
   struct st22_encoder_dev* dev;
   struct st22_encode_dev_impl* dev_impl;
   struct st22_encode_session_impl* session_impl;
-
+  struct st22_encoder_create_req* create_req = &req->req;
+  struct st_plugin_candidate cands[ST_MAX_ENCODER_DEV];
+  struct st_plugin_candidate* cand;
+  struct st_plugin_bench_job jobs[ST_MAX_ENCODER_DEV];
+  int cands_cnt = 0, jobs_cnt = 0;
+  struct st_plugin_bench key;
+  double need, rate;
+
+  need = st_plugin_req_load(create_req->fps, create_req->width, create_req->height);
+  st_plugin_bench_key(&key, create_req->input_fmt, create_req->output_fmt,
+                      create_req->width, create_req->height);
   mt_pthread_mutex_lock(&mgr->lock);
+  for (int i = 0; i < ST_MAX_ENCODER_DEV; i++) {
+    dev_impl = mgr->encode_devs[i];
+    if (!dev_impl || !dev_impl->dev.benchmark) continue;
+    if (!st22_encoder_is_capable(&dev_impl->dev, req)) continue;
+    if (st_plugin_bench_lookup(dev_impl->bench, dev_impl->bench_cnt, &key, &rate))
+      continue;
+    st_plugin_bench_job_add(&jobs[jobs_cnt++], dev_impl->bench, &dev_impl->bench_cnt,
+                            dev_impl->dev.benchmark, dev_impl->dev.priv,
+                            &dev_impl->ref_cnt);
+  }
+  st_plugin_bench_run(mgr, jobs, jobs_cnt, &key);
+
   for (int i = 0; i < ST_MAX_ENCODER_DEV; i++) {
     dev_impl = mgr->encode_devs[i];
     if (!dev_impl) continue;
@@ -165,12 +423,29 @@ struct st22_encode_session_impl* st22_get_encoder(struct mtl_main_impl* impl,
       dbg("%s(%d), %s not capable\n", __func__, i, dev->name);
       continue;
     }
+    rate = st_plugin_bench_rate(dev_impl->bench, dev_impl->bench_cnt, &key);
+    if (rate < 0) {
+      dbg("%s(%d), %s not supported by benchmark\n", __func__, i, dev->name);
+      continue;
+    }
+    cand = &cands[cands_cnt++];
+    cand->dev_idx = i;
+    cand->rate = rate;
+    cand->spare = rate - dev_impl->load;
+    cand->tried = false;
+  }
 
-    dbg("%s(%d), try to find one session\n", __func__, i);
+  while ((cand = st_plugin_next_candidate(cands, cands_cnt, need))) {
+    dev_impl = mgr->encode_devs[cand->dev_idx];
+    dbg("%s(%d), try to find one session\n", __func__, cand->dev_idx);
     session_impl = st22_get_encoder_session(dev_impl, req);
     if (session_impl) {
+      session_impl->load = need;
+      dev_impl->load += need;
       rte_atomic32_inc(&dev_impl->ref_cnt);
       mt_pthread_mutex_unlock(&mgr->lock);
+      info("%s(%d), rate %f spare %f need %f\n", __func__, cand->dev_idx, cand->rate,
+           cand->spare, need);
       return session_impl;
     }
   }
@@ -186,6 +461,7 @@ int st22_decode_notify_frame_ready(struct st22_decode_session_impl* decoder) {
   struct st22_decoder_dev* dev = &dev_impl->dev;
   st22_decode_priv session = decoder->session;
 
+  if (dev_impl->batch) return st_plugin_batch_notify(dev_impl->batch);
   return dev->notify_frame_available(session);
 }
 
@@ -197,9 +473,17 @@ int st22_put_decoder(struct mtl_main_impl* impl,
   int idx = dev_impl->idx;
   st22_decode_priv session = decoder->session;
 
+  /*
+   * stop the lib workers on this session before the plugin free it, the drain waits
+   * the inflight frames so do it without the mgr lock. The batch lives until the
+   * ref_cnt of the dev drops.
+   */
+  if (dev_impl->batch) st_plugin_batch_detach(dev_impl->batch, decoder->idx);
   mt_pthread_mutex_lock(&mgr->lock);
   dev->free_session(dev->priv, session);
   decoder->session = NULL;
+  dev_impl->load -= decoder->load;
+  decoder->load = 0;
   rte_atomic32_dec(&dev_impl->ref_cnt);
   mt_pthread_mutex_unlock(&mgr->lock);
 
@@ -214,6 +498,7 @@ static struct st22_decode_session_impl* st22_get_decoder_session(
   struct st22_decoder_create_req* create_req = &req->req;
   struct st22_decode_session_impl* session_impl;
   st22_decode_priv session;
+  int ret;
 
   for (int i = 0; i < ST_MAX_SESSIONS_PER_DECODER; i++) {
     session_impl = &dev_impl->sessions[i];
@@ -224,6 +509,16 @@ static struct st22_decode_session_impl* st22_get_decoder_session(
       session_impl->session = session;
       session_impl->req = *req;
       session_impl->type = MT_ST22_HANDLE_PIPELINE_DECODE;
+      if (dev_impl->batch) {
+        ret = st_plugin_batch_attach(dev_impl->batch, i, session_impl,
+                                     create_req->framebuff_cnt);
+        if (ret < 0) {
+          err("%s(%d), batch attach fail %d at %d\n", __func__, idx, ret, i);
+          dev->free_session(dev->priv, session);
+          session_impl->session = NULL;
+          return NULL;
+        }
+      }
       info("%s(%d), get one session at %d on dev %s\n", __func__, idx, i, dev->name);
       info("%s(%d), input fmt: %s, output fmt: %s\n", __func__, idx,
            st_frame_fmt_name(req->req.input_fmt), st_frame_fmt_name(req->req.output_fmt));
@@ -258,20 +553,59 @@ struct st22_decode_session_impl* st22_get_decoder(struct mtl_main_impl* impl,
   struct st22_decoder_dev* dev;
   struct st22_decode_dev_impl* dev_impl;
   struct st22_decode_session_impl* session_impl;
-
+  struct st22_decoder_create_req* create_req = &req->req;
+  struct st_plugin_candidate cands[ST_MAX_DECODER_DEV];
+  struct st_plugin_candidate* cand;
+  struct st_plugin_bench_job jobs[ST_MAX_DECODER_DEV];
+  int cands_cnt = 0, jobs_cnt = 0;
+  struct st_plugin_bench key;
+  double need, rate;
+
+  need = st_plugin_req_load(create_req->fps, create_req->width, create_req->height);
+  st_plugin_bench_key(&key, create_req->input_fmt, create_req->output_fmt,
+                      create_req->width, create_req->height);
   mt_pthread_mutex_lock(&mgr->lock);
+  for (int i = 0; i < ST_MAX_DECODER_DEV; i++) {
+    dev_impl = mgr->decode_devs[i];
+    if (!dev_impl || !dev_impl->dev.benchmark) continue;
+    if (!st22_decoder_is_capable(&dev_impl->dev, req)) continue;
+    if (st_plugin_bench_lookup(dev_impl->bench, dev_impl->bench_cnt, &key, &rate))
+      continue;
+    st_plugin_bench_job_add(&jobs[jobs_cnt++], dev_impl->bench, &dev_impl->bench_cnt,
+                            dev_impl->dev.benchmark, dev_impl->dev.priv,
+                            &dev_impl->ref_cnt);
+  }
+  st_plugin_bench_run(mgr, jobs, jobs_cnt, &key);
+
   for (int i = 0; i < ST_MAX_DECODER_DEV; i++) {
     dev_impl = mgr->decode_devs[i];
     if (!dev_impl) continue;
     dbg("%s(%d), try to find one dev\n", __func__, i);
     dev = &mgr->decode_devs[i]->dev;
     if (!st22_decoder_is_capable(dev, req)) continue;
+    rate = st_plugin_bench_rate(dev_impl->bench, dev_impl->bench_cnt, &key);
+    if (rate < 0) {
+      dbg("%s(%d), %s not supported by benchmark\n", __func__, i, dev->name);
+      continue;
+    }
+    cand = &cands[cands_cnt++];
+    cand->dev_idx = i;
+    cand->rate = rate;
+    cand->spare = rate - dev_impl->load;
+    cand->tried = false;
+  }
 
-    dbg("%s(%d), try to find one session\n", __func__, i);
+  while ((cand = st_plugin_next_candidate(cands, cands_cnt, need))) {
+    dev_impl = mgr->decode_devs[cand->dev_idx];
+    dbg("%s(%d), try to find one session\n", __func__, cand->dev_idx);
     session_impl = st22_get_decoder_session(dev_impl, req);
     if (session_impl) {
+      session_impl->load = need;
+      dev_impl->load += need;
       rte_atomic32_inc(&dev_impl->ref_cnt);
       mt_pthread_mutex_unlock(&mgr->lock);
+      info("%s(%d), rate %f spare %f need %f\n", __func__, cand->dev_idx, cand->rate,
+           cand->spare, need);
       return session_impl;
     }
   }
@@ -301,6 +635,8 @@ int st20_put_converter(struct mtl_main_impl* impl,
   mt_pthread_mutex_lock(&mgr->lock);
   dev->free_session(dev->priv, session);
   converter->session = NULL;
+  dev_impl->load -= converter->load;
+  converter->load = 0;
   rte_atomic32_dec(&dev_impl->ref_cnt);
   mt_pthread_mutex_unlock(&mgr->lock);
 
@@ -353,26 +689,101 @@ static bool st20_converter_is_capable(struct st20_converter_dev* dev,
   return true;
 }
 
+/*
+ * The internal converter has more spare capacity than the plugin dev, the internal
+ * benchmark is measured in st20_get_converter and the load is from the sessions which
+ * use the internal converters, see st20_get_internal_converter.
+ */
+static bool st20_internal_converter_preferred(struct mtl_main_impl* impl,
+                                              struct st20_get_converter_request* req,
+                                              struct st_plugin_candidate* cand,
+                                              const struct st_plugin_bench* key) {
+  struct st_plugin_mgr* mgr = st_get_plugins_mgr(impl);
+  double internal_rate, internal_spare;
+
+  if (req->device != ST_PLUGIN_DEVICE_AUTO) return false;
+  /* keep the plugin without benchmark as before */
+  if (cand->rate <= 0) return false;
+
+  internal_rate = st_plugin_bench_rate(mgr->internal_bench, mgr->internal_bench_cnt, key);
+  if (internal_rate <= 0) return false;
+  internal_spare = internal_rate - mgr->internal_load;
+  if (internal_spare <= cand->spare) return false;
+
+  info("%s, internal rate %f spare %f, plugin dev %d rate %f spare %f\n", __func__,
+       internal_rate, internal_spare, cand->dev_idx, cand->rate, cand->spare);
+  return true;
+}
+
 struct st20_convert_session_impl* st20_get_converter(
     struct mtl_main_impl* impl, struct st20_get_converter_request* req) {
   struct st_plugin_mgr* mgr = st_get_plugins_mgr(impl);
   struct st20_converter_dev* dev;
   struct st20_convert_dev_impl* dev_impl;
   struct st20_convert_session_impl* session_impl;
-
+  struct st20_converter_create_req* create_req = &req->req;
+  struct st_plugin_candidate cands[ST_MAX_CONVERTER_DEV];
+  struct st_plugin_candidate* cand;
+  struct st_plugin_bench_job jobs[ST_MAX_CONVERTER_DEV + 1]; /* and the internal */
+  int cands_cnt = 0, jobs_cnt = 0;
+  bool has_bench = false;
+  struct st_plugin_bench key;
+  double need, rate;
+
+  need = st_plugin_req_load(create_req->fps, create_req->width, create_req->height);
+  st_plugin_bench_key(&key, create_req->input_fmt, create_req->output_fmt,
+                      create_req->width, create_req->height);
   mt_pthread_mutex_lock(&mgr->lock);
+  for (int i = 0; i < ST_MAX_CONVERTER_DEV; i++) {
+    dev_impl = mgr->convert_devs[i];
+    if (!dev_impl || !dev_impl->dev.benchmark) continue;
+    if (!st20_converter_is_capable(&dev_impl->dev, req)) continue;
+    has_bench = true;
+    if (st_plugin_bench_lookup(dev_impl->bench, dev_impl->bench_cnt, &key, &rate))
+      continue;
+    st_plugin_bench_job_add(&jobs[jobs_cnt++], dev_impl->bench, &dev_impl->bench_cnt,
+                            dev_impl->dev.benchmark, dev_impl->dev.priv,
+                            &dev_impl->ref_cnt);
+  }
+  /* the internal converter competes with the plugin devs with benchmark */
+  if (has_bench && req->device == ST_PLUGIN_DEVICE_AUTO &&
+      !st_plugin_bench_lookup(mgr->internal_bench, mgr->internal_bench_cnt, &key, &rate))
+    st_plugin_bench_job_add(&jobs[jobs_cnt++], mgr->internal_bench,
+                            &mgr->internal_bench_cnt, st20_internal_convert_bench, impl,
+                            NULL);
+  st_plugin_bench_run(mgr, jobs, jobs_cnt, &key);
+
   for (int i = 0; i < ST_MAX_CONVERTER_DEV; i++) {
     dev_impl = mgr->convert_devs[i];
     if (!dev_impl) continue;
     dbg("%s(%d), try to find one dev\n", __func__, i);
     dev = &mgr->convert_devs[i]->dev;
     if (!st20_converter_is_capable(dev, req)) continue;
+    rate = st_plugin_bench_rate(dev_impl->bench, dev_impl->bench_cnt, &key);
+    if (rate < 0) {
+      dbg("%s(%d), %s not supported by benchmark\n", __func__, i, dev->name);
+      continue;
+    }
+    cand = &cands[cands_cnt++];
+    cand->dev_idx = i;
+    cand->rate = rate;
+    cand->spare = rate - dev_impl->load;
+    cand->tried = false;
+  }
 
-    dbg("%s(%d), try to find one session\n", __func__, i);
+  while ((cand = st_plugin_next_candidate(cands, cands_cnt, need))) {
+    /* the candidates are in order, the following ones are not faster */
+    if (st20_internal_converter_preferred(impl, req, cand, &key)) break;
+    dev_impl = mgr->convert_devs[cand->dev_idx];
+    dbg("%s(%d), try to find one session\n", __func__, cand->dev_idx);
     session_impl = st20_get_converter_session(dev_impl, req);
     if (session_impl) {
+      session_impl->load = need;
+      dev_impl->load += need;
       rte_atomic32_inc(&dev_impl->ref_cnt);
       mt_pthread_mutex_unlock(&mgr->lock);
+      info("%s(%d), rate %f spare %f need %f\n", __func__, cand->dev_idx, cand->rate,
+           cand->spare, need);
       return session_impl;
     }
   }
@@ -383,6 +794,32 @@ struct st20_convert_session_impl* st20_get_converter(
   return NULL;
 }
 
+double st20_get_internal_converter(struct mtl_main_impl* impl,
+                                   struct st20_get_converter_request* req) {
+  struct st_plugin_mgr* mgr = st_get_plugins_mgr(impl);
+  struct st20_converter_create_req* create_req = &req->req;
+  double load;
+
+  load = st_plugin_req_load(create_req->fps, create_req->width, create_req->height);
+  mt_pthread_mutex_lock(&mgr->lock);
+  mgr->internal_load += load;
+  mt_pthread_mutex_unlock(&mgr->lock);
+
+  dbg("%s, load %f\n", __func__, load);
+  return load;
+}
+
+int st20_put_internal_converter(struct mtl_main_impl* impl, double load) {
+  struct st_plugin_mgr* mgr = st_get_plugins_mgr(impl);
+
+  mt_pthread_mutex_lock(&mgr->lock);
+  mgr->internal_load -= load;
+  mt_pthread_mutex_unlock(&mgr->lock);
+
+  dbg("%s, load %f\n", __func__, load);
+  return 0;
+}
+
 static int st22_encode_dev_dump(struct st22_encode_dev_impl* encode) {
   struct st22_encode_session_impl* session;
   int ref_cnt = rte_atomic32_read(&encode->ref_cnt);
@@ -478,6 +915,10 @@ int st22_encoder_unregister(st22_encoder_dev_handle handle) {
     err("%s(%d), %s are busy with ref_cnt %d\n", __func__, idx, dev->name, ref_cnt);
     return -EBUSY;
   }
+  if (dev->batch) {
+    st_plugin_batch_free(dev->batch);
+    dev->batch = NULL;
+  }
   mt_rte_free(dev);
   mgr->encode_devs[idx] = NULL;
   mt_pthread_mutex_unlock(&mgr->lock);
@@ -510,6 +951,10 @@ int st22_decoder_unregister(st22_decoder_dev_handle handle) {
     err("%s(%d), %s are busy with ref_cnt %d\n", __func__, idx, dev->name, ref_cnt);
     return -EBUSY;
   }
+  if (dev->batch) {
+    st_plugin_batch_free(dev->batch);
+    dev->batch = NULL;
+  }
   mt_rte_free(dev);
   mgr->decode_devs[idx] = NULL;
   mt_pthread_mutex_unlock(&mgr->lock);
@@ -549,6 +994,104 @@ int st20_converter_unregister(st20_converter_dev_handle handle) {
   return 0;
 }
 
+static void* st22_encode_batch_get_frame(void* session) {
+  struct st22_encode_session_impl* session_impl = session;
+
+  return session_impl->req.get_frame(session_impl->req.priv);
+}
+
+static int st22_encode_batch_put_frame(void* session, void* frame, int result) {
+  struct st22_encode_session_impl* session_impl = session;
+
+  return session_impl->req.put_frame(session_impl->req.priv, frame, result);
+}
+
+static int st22_encode_batch_process(void* priv, void** sessions, void** frames,
+                                     int* results, uint16_t nb_frames) {
+  struct st22_encode_dev_impl* dev_impl = priv;
+  struct st22_encoder_dev* dev = &dev_impl->dev;
+  st22_encode_priv encode_sessions[ST22_PLUGIN_MAX_BATCH];
+  struct st22_encode_frame_meta* encode_frames[ST22_PLUGIN_MAX_BATCH];
+  struct st22_encode_session_impl* session_impl;
+
+  for (uint16_t i = 0; i < nb_frames; i++) {
+    session_impl = sessions[i];
+    encode_sessions[i] = session_impl->session;
+    encode_frames[i] = frames[i];
+  }
+
+  return dev->encode_frames(dev->priv, encode_sessions, encode_frames, results,
+                            nb_frames);
+}
+
+static struct st_plugin_batch* st22_encode_batch_create(
+    struct mtl_main_impl* impl, struct st22_encode_dev_impl* dev_impl) {
+  struct st22_encoder_dev* dev = &dev_impl->dev;
+  struct st_plugin_batch_ops ops;
+  char name[ST_MAX_NAME_LEN];
+
+  snprintf(name, sizeof(name), "encode_%s", dev_impl->name);
+  memset(&ops, 0, sizeof(ops));
+  ops.name = name;
+  ops.worker_cnt = dev->worker_cnt;
+  ops.batch_size = dev->batch_size ? dev->batch_size : 1;
+  ops.priv = dev_impl;
+  ops.get_frame = st22_encode_batch_get_frame;
+  ops.put_frame = st22_encode_batch_put_frame;
+  ops.process = st22_encode_batch_process;
+
+  return st_plugin_batch_create(impl, &ops);
+}
+
+static void* st22_decode_batch_get_frame(void* session) {
+  struct st22_decode_session_impl* session_impl = session;
+
+  return session_impl->req.get_frame(session_impl->req.priv);
+}
+
+static int st22_decode_batch_put_frame(void* session, void* frame, int result) {
+  struct st22_decode_session_impl* session_impl = session;
+
+  return session_impl->req.put_frame(session_impl->req.priv, frame, result);
+}
+
+static int st22_decode_batch_process(void* priv, void** sessions, void** frames,
+                                     int* results, uint16_t nb_frames) {
+  struct st22_decode_dev_impl* dev_impl = priv;
+  struct st22_decoder_dev* dev = &dev_impl->dev;
+  st22_decode_priv decode_sessions[ST22_PLUGIN_MAX_BATCH];
+  struct st22_decode_frame_meta* decode_frames[ST22_PLUGIN_MAX_BATCH];
+  struct st22_decode_session_impl* session_impl;
+
+  for (uint16_t i = 0; i < nb_frames; i++) {
+    session_impl = sessions[i];
+    decode_sessions[i] = session_impl->session;
+    decode_frames[i] = frames[i];
+  }
+
+  return dev->decode_frames(dev->priv, decode_sessions, decode_frames, results,
+                            nb_frames);
+}
+
+static struct st_plugin_batch* st22_decode_batch_create(
+    struct mtl_main_impl* impl, struct st22_decode_dev_impl* dev_impl) {
+  struct st22_decoder_dev* dev = &dev_impl->dev;
+  struct st_plugin_batch_ops ops;
+  char name[ST_MAX_NAME_LEN];
+
+  snprintf(name, sizeof(name), "decode_%s", dev_impl->name);
+  memset(&ops, 0, sizeof(ops));
+  ops.name = name;
+  ops.worker_cnt = dev->worker_cnt;
+  ops.batch_size = dev->batch_size ? dev->batch_size : 1;
+  ops.priv = dev_impl;
+  ops.get_frame = st22_decode_batch_get_frame;
+  ops.put_frame = st22_decode_batch_put_frame;
+  ops.process = st22_decode_batch_process;
+
+  return st_plugin_batch_create(impl, &ops);
+}
+
 st22_encoder_dev_handle st22_encoder_register(mtl_handle mt,
                                               struct st22_encoder_dev* dev) {
   struct mtl_main_impl* impl = mt;
@@ -568,7 +1111,20 @@ st22_encoder_dev_handle st22_encoder_register(mtl_handle mt,
     err("%s, pls set free_session\n", __func__);
     return NULL;
   }
-  if (!dev->notify_frame_available) {
+  if (dev->worker_cnt) {
+    if (!dev->encode_frames) {
+      err("%s, pls set encode_frames for worker_cnt %u\n", __func__, dev->worker_cnt);
+      return NULL;
+    }
+    if (dev->worker_cnt > ST22_PLUGIN_MAX_WORKERS) {
+      err("%s, invalid worker_cnt %u\n", __func__, dev->worker_cnt);
+      return NULL;
+    }
+    if (dev->batch_size > ST22_PLUGIN_MAX_BATCH) {
+      err("%s, invalid batch_size %u\n", __func__, dev->batch_size);
+      return NULL;
+    }
+  } else if (!dev->notify_frame_available) {
     err("%s, pls set notify_frame_available\n", __func__);
     return NULL;
   }
@@ -593,6 +1149,15 @@ st22_encoder_dev_handle st22_encoder_register(mtl_handle mt,
       encode_dev->sessions[j].idx = j;
       encode_dev->sessions[j].parent = encode_dev;
     }
+    if (dev->worker_cnt) {
+      encode_dev->batch = st22_encode_batch_create(impl, encode_dev);
+      if (!encode_dev->batch) {
+        err("%s, batch create fail\n", __func__);
+        mt_rte_free(encode_dev);
+        mt_pthread_mutex_unlock(&mgr->lock);
+        return NULL;
+      }
+    }
     mgr->encode_devs[i] = encode_dev;
     mt_pthread_mutex_unlock(&mgr->lock);
     info("%s(%d), %s registered, device %d cap(0x%" PRIx64 ":0x%" PRIx64 ")\n", __func__,
@@ -625,7 +1190,20 @@ st22_decoder_dev_handle st22_decoder_register(mtl_handle mt,
     err("%s, pls set free_session\n", __func__);
     return NULL;
   }
-  if (!dev->notify_frame_available) {
+  if (dev->worker_cnt) {
+    if (!dev->decode_frames) {
+      err("%s, pls set decode_frames for worker_cnt %u\n", __func__, dev->worker_cnt);
+      return NULL;
+    }
+    if (dev->worker_cnt > ST22_PLUGIN_MAX_WORKERS) {
+      err("%s, invalid worker_cnt %u\n", __func__, dev->worker_cnt);
+      return NULL;
+    }
+    if (dev->batch_size > ST22_PLUGIN_MAX_BATCH) {
+      err("%s, invalid batch_size %u\n", __func__, dev->batch_size);
+      return NULL;
+    }
+  } else if (!dev->notify_frame_available) {
     err("%s, pls set notify_frame_available\n", __func__);
     return NULL;
   }
@@ -650,6 +1228,15 @@ st22_decoder_dev_handle st22_decoder_register(mtl_handle mt,
       decode_dev->sessions[j].idx = j;
       decode_dev->sessions[j].parent = decode_dev;
     }
+    if (dev->worker_cnt) {
+      decode_dev->batch = st22_decode_batch_create(impl, decode_dev);
+      if (!decode_dev->batch) {
+        err("%s, batch create fail\n", __func__);
+        mt_rte_free(decode_dev);
+        mt_pthread_mutex_unlock(&mgr->lock);
+        return NULL;
+      }
+    }
     mgr->decode_devs[i] = decode_dev;
     mt_pthread_mutex_unlock(&mgr->lock);
     info("%s(%d), %s registered, device %d cap(0x%" PRIx64 ":0x%" PRIx64 ")\n", __func__,
@@ -743,6 +1330,41 @@ int st22_encoder_put_frame(st22p_encode_session session,
   return session_impl->req.put_frame(session_impl->req.priv, frame, result);
 }
 
+uint16_t st22_encoder_get_frame_lines(st22p_encode_session session,
+                                      struct st22_encode_frame_meta* frame) {
+  struct st22_encode_session_impl* session_impl = session;
+
+  if (session_impl->type != MT_ST22_HANDLE_PIPELINE_ENCODE) {
+    err("%s(%d), invalid type %d\n", __func__, session_impl->idx, session_impl->type);
+    return 0;
+  }
+
+  if (!session_impl->req.get_frame_lines) {
+    err("%s(%d), slice not enabled\n", __func__, session_impl->idx);
+    return 0;
+  }
+
+  return session_impl->req.get_frame_lines(session_impl->req.priv, frame);
+}
+
+int st22_encoder_put_frame_bytes(st22p_encode_session session,
+                                 struct st22_encode_frame_meta* frame,
+                                 size_t bytes_ready) {
+  struct st22_encode_session_impl* session_impl = session;
+
+  if (session_impl->type != MT_ST22_HANDLE_PIPELINE_ENCODE) {
+    err("%s(%d), invalid type %d\n", __func__, session_impl->idx, session_impl->type);
+    return -EIO;
+  }
+
+  if (!session_impl->req.put_frame_bytes) {
+    err("%s(%d), slice not enabled\n", __func__, session_impl->idx);
+    return -EINVAL;
+  }
+
+  return session_impl->req.put_frame_bytes(session_impl->req.priv, frame, bytes_ready);
+}
+
 struct st22_decode_frame_meta* st22_decoder_get_frame(st22p_decode_session session) {
   struct st22_decode_session_impl* session_impl = session;
 
@@ -766,6 +1388,49 @@ int st22_decoder_put_frame(st22p_decode_session session,
   return session_impl->req.put_frame(session_impl->req.priv, frame, result);
 }
 
+int st22_decoder_hold_frame(st22p_decode_session session,
+                            struct st22_decode_frame_meta* frame) {
+  struct st22_decode_session_impl* session_impl = session;
+
+  if (session_impl->type != MT_ST22_HANDLE_PIPELINE_DECODE) {
+    err("%s(%d), invalid type %d\n", __func__, session_impl->idx, session_impl->type);
+    return -EIO;
+  }
+
+  return session_impl->req.hold_frame(session_impl->req.priv, frame);
+}
+
+int st22_decoder_release_frame(st22p_decode_session session,
+                               struct st22_decode_frame_meta* frame) {
+  struct st22_decode_session_impl* session_impl = session;
+
+  if (session_impl->type != MT_ST22_HANDLE_PIPELINE_DECODE) {
+    err("%s(%d), invalid type %d\n", __func__, session_impl->idx, session_impl->type);
+    return -EIO;
+  }
+
+  return session_impl->req.release_frame(session_impl->req.priv, frame);
+}
+
+size_t st22_decoder_get_frame_bytes(st22p_decode_session session,
+                                    struct st22_decode_frame_meta* frame,
+                                    bool* complete) {
+  struct st22_decode_session_impl* session_impl = session;
+
+  *complete = false;
+  if (session_impl->type != MT_ST22_HANDLE_PIPELINE_DECODE) {
+    err("%s(%d), invalid type %d\n", __func__, session_impl->idx, session_impl->type);
+    return 0;
+  }
+
+  if (!session_impl->req.get_frame_bytes) {
+    err("%s(%d), slice not enabled\n", __func__, session_impl->idx);
+    return 0;
+  }
+
+  return session_impl->req.get_frame_bytes(session_impl->req.priv, frame, complete);
+}
+
 struct st20_convert_frame_meta* st20_converter_get_frame(st20p_convert_session session) {
   struct st20_convert_session_impl* session_impl = session;
 
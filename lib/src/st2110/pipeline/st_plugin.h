@@ -24,6 +24,10 @@ struct st20_convert_session_impl* st20_get_converter(
 int st20_convert_notify_frame_ready(struct st20_convert_session_impl* converter);
 int st20_put_converter(struct mtl_main_impl* impl,
                        struct st20_convert_session_impl* converter);
+/* account the load of one session converted by the internal converter */
+double st20_get_internal_converter(struct mtl_main_impl* impl,
+                                   struct st20_get_converter_request* req);
+int st20_put_internal_converter(struct mtl_main_impl* impl, double load);
 
 int st_plugins_init(struct mtl_main_impl* impl);
 int st_plugins_uinit(struct mtl_main_impl* impl);
@@ -0,0 +1,332 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include "st_plugin_batch.h"
+
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+
+/* collect up to batch_size frames, one frame per session each round */
+static uint16_t plugin_batch_collect(struct st_plugin_batch* batch,
+                                     struct st_plugin_batch_worker* worker) {
+  struct st_plugin_batch_ops* ops = &batch->ops;
+  struct st_plugin_batch_session* bs;
+  uint16_t batch_size = ops->batch_size;
+  uint16_t nb = 0;
+  int start, idx;
+  void* frame;
+  bool got;
+
+  start = rte_atomic32_add_return(&batch->rr, 1) % ST_PLUGIN_BATCH_MAX_SESSIONS;
+  do {
+    got = false;
+    for (int i = 0; i < ST_PLUGIN_BATCH_MAX_SESSIONS && nb < batch_size; i++) {
+      idx = (start + i) % ST_PLUGIN_BATCH_MAX_SESSIONS;
+      bs = &batch->sessions[idx];
+      if (!bs->active) continue;
+
+      frame = NULL;
+      mt_pthread_mutex_lock(&bs->lock);
+      /* the seq assigned with the lock hold to follow the frame order */
+      if (bs->active && (bs->seq_get - bs->seq_put) < bs->slot_cnt) {
+        frame = ops->get_frame(bs->session);
+        if (frame) worker->seq[nb] = bs->seq_get++;
+      }
+      mt_pthread_mutex_unlock(&bs->lock);
+      if (!frame) continue;
+
+      worker->sessions[nb] = bs->session;
+      worker->frames[nb] = frame;
+      worker->session_idx[nb] = idx;
+      nb++;
+      got = true;
+    }
+  } while (got && nb < batch_size);
+
+  return nb;
+}
+
+/* put back the completed frames of one session in the order of the get */
+static void plugin_batch_complete(struct st_plugin_batch* batch,
+                                  struct st_plugin_batch_session* bs, uint64_t seq,
+                                  void* frame, int result) {
+  struct st_plugin_batch_ops* ops = &batch->ops;
+  struct st_plugin_batch_slot* slot;
+
+  mt_pthread_mutex_lock(&bs->lock);
+  if (seq != bs->seq_put) rte_atomic32_inc(&bs->stat_reorder);
+  slot = &bs->slots[seq % bs->slot_cnt];
+  slot->frame = frame;
+  slot->result = result;
+  slot->done = true;
+
+  while (bs->seq_put < bs->seq_get) {
+    slot = &bs->slots[bs->seq_put % bs->slot_cnt];
+    if (!slot->done) break;
+    ops->put_frame(bs->session, slot->frame, slot->result);
+    slot->done = false;
+    slot->frame = NULL;
+    bs->seq_put++;
+    rte_atomic32_inc(&bs->stat_frames);
+  }
+  /* wake the detach waiting for the drain */
+  if (!bs->active && bs->seq_put == bs->seq_get) mt_pthread_cond_signal(&bs->drain_cond);
+  mt_pthread_mutex_unlock(&bs->lock);
+}
+
+static void plugin_batch_wait(struct st_plugin_batch* batch) {
+  mt_pthread_mutex_lock(&batch->lock);
+  if (!rte_atomic32_read(&batch->wake_pending) && !rte_atomic32_read(&batch->stop)) {
+    mt_pthread_cond_timedwait_ns(&batch->wake_cond, &batch->lock,
+                                 ST_PIPELINE_BLOCK_TIMEOUT_NS);
+  }
+  mt_pthread_mutex_unlock(&batch->lock);
+}
+
+static void* plugin_batch_thread(void* arg) {
+  struct st_plugin_batch_worker* worker = arg;
+  struct st_plugin_batch* batch = worker->parent;
+  struct st_plugin_batch_ops* ops = &batch->ops;
+  uint16_t nb;
+  int ret;
+
+  info("%s(%s,%d), start\n", __func__, batch->name, worker->idx);
+  while (!rte_atomic32_read(&batch->stop)) {
+    rte_atomic32_set(&batch->wake_pending, 0);
+    nb = plugin_batch_collect(batch, worker);
+    if (!nb) {
+      plugin_batch_wait(batch);
+      continue;
+    }
+    /* a full batch, maybe more frames pending, wake one more worker */
+    if (nb >= ops->batch_size && batch->worker_cnt > 1) st_plugin_batch_notify(batch);
+
+    for (uint16_t i = 0; i < nb; i++) worker->results[i] = 0;
+    ret = ops->process(ops->priv, worker->sessions, worker->frames, worker->results, nb);
+    if (ret < 0) {
+      dbg("%s(%s,%d), process fail %d\n", __func__, batch->name, worker->idx, ret);
+      for (uint16_t i = 0; i < nb; i++) worker->results[i] = ret;
+    }
+
+    for (uint16_t i = 0; i < nb; i++) {
+      if (worker->results[i] < 0) rte_atomic32_inc(&batch->stat_fail);
+      plugin_batch_complete(batch, &batch->sessions[worker->session_idx[i]],
+                            worker->seq[i], worker->frames[i], worker->results[i]);
+    }
+    rte_atomic32_inc(&batch->stat_batches);
+    rte_atomic32_add(&batch->stat_frames, nb);
+  }
+  info("%s(%s,%d), stop\n", __func__, batch->name, worker->idx);
+
+  return NULL;
+}
+
+int st_plugin_batch_notify(struct st_plugin_batch* batch) {
+  /* wake up one idle worker */
+  rte_atomic32_set(&batch->wake_pending, 1);
+  mt_pthread_mutex_lock(&batch->lock);
+  mt_pthread_cond_signal(&batch->wake_cond);
+  mt_pthread_mutex_unlock(&batch->lock);
+  return 0;
+}
+
+int st_plugin_batch_attach(struct st_plugin_batch* batch, int idx, void* session,
+                           uint16_t framebuff_cnt) {
+  struct st_plugin_batch_session* bs;
+  struct st_plugin_batch_slot* slots;
+
+  if (idx < 0 || idx >= ST_PLUGIN_BATCH_MAX_SESSIONS) {
+    err("%s(%s), invalid idx %d\n", __func__, batch->name, idx);
+    return -EINVAL;
+  }
+  if (!framebuff_cnt) {
+    err("%s(%s,%d), invalid framebuff_cnt\n", __func__, batch->name, idx);
+    return -EINVAL;
+  }
+  bs = &batch->sessions[idx];
+  if (bs->active) {
+    err("%s(%s,%d), already attached\n", __func__, batch->name, idx);
+    return -EBUSY;
+  }
+
+  slots = mt_rte_zmalloc_socket(sizeof(*slots) * framebuff_cnt,
+                                mt_socket_id(batch->impl, MTL_PORT_P));
+  if (!slots) {
+    err("%s(%s,%d), slots malloc fail\n", __func__, batch->name, idx);
+    return -ENOMEM;
+  }
+
+  mt_pthread_mutex_lock(&bs->lock);
+  bs->session = session;
+  bs->slots = slots;
+  bs->slot_cnt = framebuff_cnt;
+  bs->seq_get = 0;
+  bs->seq_put = 0;
+  rte_atomic32_set(&bs->stat_frames, 0);
+  rte_atomic32_set(&bs->stat_reorder, 0);
+  bs->active = true;
+  mt_pthread_mutex_unlock(&bs->lock);
+
+  info("%s(%s,%d), framebuff_cnt %u\n", __func__, batch->name, idx, framebuff_cnt);
+  return 0;
+}
+
+int st_plugin_batch_detach(struct st_plugin_batch* batch, int idx) {
+  struct st_plugin_batch_session* bs;
+  uint64_t inflight;
+
+  if (idx < 0 || idx >= ST_PLUGIN_BATCH_MAX_SESSIONS) {
+    err("%s(%s), invalid idx %d\n", __func__, batch->name, idx);
+    return -EINVAL;
+  }
+  bs = &batch->sessions[idx];
+
+  mt_pthread_mutex_lock(&bs->lock);
+  bs->active = false;
+  /* wait all inflight frames back as the slots are used by the workers */
+  while ((inflight = bs->seq_get - bs->seq_put)) {
+    if (mt_pthread_cond_timedwait_ns(&bs->drain_cond, &bs->lock, NS_PER_S) == ETIMEDOUT)
+      warn("%s(%s,%d), still %" PRIu64 " inflight frames\n", __func__, batch->name, idx,
+           inflight);
+  }
+  if (bs->slots) {
+    mt_rte_free(bs->slots);
+    bs->slots = NULL;
+  }
+  bs->slot_cnt = 0;
+  bs->session = NULL;
+  mt_pthread_mutex_unlock(&bs->lock);
+
+  info("%s(%s,%d), succ\n", __func__, batch->name, idx);
+  return 0;
+}
+
+static int plugin_batch_stat(void* priv) {
+  struct st_plugin_batch* batch = priv;
+  struct st_plugin_batch_session* bs;
+
+  int batches = rte_atomic32_read(&batch->stat_batches);
+  rte_atomic32_set(&batch->stat_batches, 0);
+  int frames = rte_atomic32_read(&batch->stat_frames);
+  rte_atomic32_set(&batch->stat_frames, 0);
+  if (frames) {
+    notice("%s(%s), %u workers process %d frames in %d batches\n", __func__, batch->name,
+           batch->worker_cnt, frames, batches);
+  }
+
+  int fail = rte_atomic32_read(&batch->stat_fail);
+  rte_atomic32_set(&batch->stat_fail, 0);
+  if (fail) notice("%s(%s), process fail %d\n", __func__, batch->name, fail);
+
+  for (int i = 0; i < ST_PLUGIN_BATCH_MAX_SESSIONS; i++) {
+    bs = &batch->sessions[i];
+    if (!bs->active) continue;
+    int reorder = rte_atomic32_read(&bs->stat_reorder);
+    rte_atomic32_set(&bs->stat_reorder, 0);
+    int done = rte_atomic32_read(&bs->stat_frames);
+    rte_atomic32_set(&bs->stat_frames, 0);
+    notice("%s(%s,%d), frames %d reorder %d\n", __func__, batch->name, i, done, reorder);
+  }
+
+  return 0;
+}
+
+int st_plugin_batch_free(struct st_plugin_batch* batch) {
+  struct st_plugin_batch_worker* worker;
+
+  if (batch->stat_registered) {
+    mt_stat_unregister(batch->impl, plugin_batch_stat, batch);
+    batch->stat_registered = false;
+  }
+
+  rte_atomic32_set(&batch->stop, 1);
+  mt_pthread_mutex_lock(&batch->lock);
+  mt_pthread_cond_broadcast(&batch->wake_cond);
+  mt_pthread_mutex_unlock(&batch->lock);
+
+  for (uint16_t i = 0; i < batch->worker_cnt; i++) {
+    worker = &batch->workers[i];
+    if (worker->started) {
+      pthread_join(worker->tid, NULL);
+      worker->started = false;
+    }
+  }
+
+  for (int i = 0; i < ST_PLUGIN_BATCH_MAX_SESSIONS; i++) {
+    if (batch->sessions[i].slots) {
+      warn("%s(%s), session %d still attached\n", __func__, batch->name, i);
+      mt_rte_free(batch->sessions[i].slots);
+      batch->sessions[i].slots = NULL;
+    }
+    mt_pthread_mutex_destroy(&batch->sessions[i].lock);
+    mt_pthread_cond_destroy(&batch->sessions[i].drain_cond);
+  }
+  mt_pthread_mutex_destroy(&batch->lock);
+  mt_pthread_cond_destroy(&batch->wake_cond);
+  info("%s(%s), succ\n", __func__, batch->name);
+  mt_rte_free(batch);
+  return 0;
+}
+
+struct st_plugin_batch* st_plugin_batch_create(struct mtl_main_impl* impl,
+                                               struct st_plugin_batch_ops* ops) {
+  struct st_plugin_batch* batch;
+  struct st_plugin_batch_worker* worker;
+  int ret;
+
+  if (!ops->worker_cnt || ops->worker_cnt > ST22_PLUGIN_MAX_WORKERS) {
+    err("%s, invalid worker_cnt %u\n", __func__, ops->worker_cnt);
+    return NULL;
+  }
+  if (!ops->batch_size || ops->batch_size > ST22_PLUGIN_MAX_BATCH) {
+    err("%s, invalid batch_size %u\n", __func__, ops->batch_size);
+    return NULL;
+  }
+  if (!ops->get_frame || !ops->put_frame || !ops->process) {
+    err("%s, invalid ops\n", __func__);
+    return NULL;
+  }
+
+  batch = mt_rte_zmalloc_socket(sizeof(*batch), mt_socket_id(impl, MTL_PORT_P));
+  if (!batch) {
+    err("%s, batch malloc fail\n", __func__);
+    return NULL;
+  }
+  batch->impl = impl;
+  batch->ops = *ops;
+  snprintf(batch->name, sizeof(batch->name), "%s", mt_string_safe(ops->name));
+  mt_pthread_mutex_init(&batch->lock, NULL);
+  mt_pthread_cond_wait_init(&batch->wake_cond);
+  rte_atomic32_set(&batch->wake_pending, 0);
+  rte_atomic32_set(&batch->stop, 0);
+  rte_atomic32_set(&batch->rr, 0);
+  rte_atomic32_set(&batch->stat_batches, 0);
+  rte_atomic32_set(&batch->stat_frames, 0);
+  rte_atomic32_set(&batch->stat_fail, 0);
+  for (int i = 0; i < ST_PLUGIN_BATCH_MAX_SESSIONS; i++) {
+    mt_pthread_mutex_init(&batch->sessions[i].lock, NULL);
+    mt_pthread_cond_wait_init(&batch->sessions[i].drain_cond);
+  }
+
+  batch->worker_cnt = ops->worker_cnt;
+  for (uint16_t i = 0; i < batch->worker_cnt; i++) {
+    worker = &batch->workers[i];
+    worker->parent = batch;
+    worker->idx = i;
+    ret = pthread_create(&worker->tid, NULL, plugin_batch_thread, worker);
+    if (ret) {
+      err("%s(%s,%u), pthread_create fail %d\n", __func__, batch->name, i, ret);
+      st_plugin_batch_free(batch);
+      return NULL;
+    }
+    worker->started = true;
+  }
+
+  mt_stat_register(impl, plugin_batch_stat, batch, batch->name);
+  batch->stat_registered = true;
+
+  info("%s(%s), %u workers, batch size %u\n", __func__, batch->name, batch->worker_cnt,
+       ops->batch_size);
+  return batch;
+}
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_PLUGIN_BATCH_HEAD_H_
+#define _ST_LIB_PIPELINE_PLUGIN_BATCH_HEAD_H_
+
+#include "../st_main.h"
+
+/* same as the max sessions number per encoder/decoder */
+#define ST_PLUGIN_BATCH_MAX_SESSIONS (64)
+
+struct st_plugin_batch_ops {
+  const char* name;
+  /* worker thread count, [1, ST22_PLUGIN_MAX_WORKERS] */
+  uint16_t worker_cnt;
+  /* max frames for one process call, [1, ST22_PLUGIN_MAX_BATCH] */
+  uint16_t batch_size;
+
+  /* the dev impl */
+  void* priv;
+  /* get/put one frame of the session, no need to be mt safe for one session */
+  void* (*get_frame)(void* session);
+  int (*put_frame)(void* session, void* frame, int result);
+  /* process a batch of frames, frames[i] belongs to sessions[i] */
+  int (*process)(void* priv, void** sessions, void** frames, int* results,
+                 uint16_t nb_frames);
+};
+
+/* one frame slot to re-sequence the out-of-order completion */
+struct st_plugin_batch_slot {
+  void* frame;
+  int result;
+  bool done;
+};
+
+struct st_plugin_batch_session {
+  /* protect the get/put and the re-sequence of this session */
+  pthread_mutex_t lock;
+  /* signaled when the last inflight frame is put after the session deactivated */
+  pthread_cond_t drain_cond;
+  bool active;
+  void* session;
+  /* the sequence for next get, next put, in frame order of the session */
+  uint64_t seq_get;
+  uint64_t seq_put;
+  uint16_t slot_cnt;
+  struct st_plugin_batch_slot* slots;
+
+  rte_atomic32_t stat_frames;
+  rte_atomic32_t stat_reorder;
+};
+
+struct st_plugin_batch;
+
+struct st_plugin_batch_worker {
+  struct st_plugin_batch* parent;
+  int idx;
+  pthread_t tid;
+  bool started;
+
+  /* the frames for current batch */
+  void* sessions[ST22_PLUGIN_MAX_BATCH];
+  void* frames[ST22_PLUGIN_MAX_BATCH];
+  int results[ST22_PLUGIN_MAX_BATCH];
+  uint16_t session_idx[ST22_PLUGIN_MAX_BATCH];
+  uint64_t seq[ST22_PLUGIN_MAX_BATCH];
+};
+
+struct st_plugin_batch {
+  struct mtl_main_impl* impl;
+  char name[ST_MAX_NAME_LEN];
+  struct st_plugin_batch_ops ops;
+
+  /* the workers wait on cond when no ready frame */
+  pthread_mutex_t lock;
+  pthread_cond_t wake_cond;
+  rte_atomic32_t wake_pending;
+  rte_atomic32_t stop;
+  /* the start session for next collect, round robin between workers */
+  rte_atomic32_t rr;
+
+  struct st_plugin_batch_session sessions[ST_PLUGIN_BATCH_MAX_SESSIONS];
+
+  uint16_t worker_cnt;
+  struct st_plugin_batch_worker workers[ST22_PLUGIN_MAX_WORKERS];
+
+  rte_atomic32_t stat_batches;
+  rte_atomic32_t stat_frames;
+  rte_atomic32_t stat_fail;
+  bool stat_registered;
+};
+
+struct st_plugin_batch* st_plugin_batch_create(struct mtl_main_impl* impl,
+                                               struct st_plugin_batch_ops* ops);
+int st_plugin_batch_free(struct st_plugin_batch* batch);
+int st_plugin_batch_attach(struct st_plugin_batch* batch, int idx, void* session,
+                           uint16_t framebuff_cnt);
+int st_plugin_batch_detach(struct st_plugin_batch* batch, int idx);
+int st_plugin_batch_notify(struct st_plugin_batch* batch);
+
+#endif
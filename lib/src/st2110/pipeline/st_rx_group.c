@@ -0,0 +1,465 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include "st_rx_group.h"
+
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+#include "st20_pipeline_rx.h"
+
+/* media clock value to ns, integer math as tai_ns * rate overflows 64 bits */
+static inline uint64_t rx_group_clk_to_ns(uint64_t clk, uint32_t rate) {
+  return (clk / rate) * NS_PER_S + (clk % rate) * NS_PER_S / rate;
+}
+
+static inline uint64_t rx_group_ns_to_clk(uint64_t ns, uint32_t rate) {
+  return (ns / NS_PER_S) * rate + (ns % NS_PER_S) * rate / NS_PER_S;
+}
+
+/*
+ * map the 32 bits RTP timestamp to the TAI time, the media clock is unwrapped with the
+ * nearest value to the current ptp time.
+ */
+static uint64_t rx_group_tai(enum st10_timestamp_fmt tfmt, uint64_t timestamp,
+                             uint32_t rate, uint64_t ptp_ns) {
+  if (tfmt == ST10_TIMESTAMP_FMT_TAI) return timestamp;
+
+  uint64_t ptp_clk = rx_group_ns_to_clk(ptp_ns, rate);
+  uint64_t clk = (ptp_clk & ~(uint64_t)UINT32_MAX) | (uint32_t)timestamp;
+  const uint64_t half = (uint64_t)1 << 31;
+
+  if (clk > ptp_clk + half && clk >= ((uint64_t)1 << 32))
+    clk -= (uint64_t)1 << 32;
+  else if (clk + half < ptp_clk)
+    clk += (uint64_t)1 << 32;
+  return rx_group_clk_to_ns(clk, rate);
+}
+
+static struct st_rx_group_audio_share* rx_group_audio_share_find(
+    struct st_rx_group_ctx* ctx, struct st_rx_group_audio_member* member,
+    struct st30_frame* frame) {
+  for (uint16_t i = 0; i < ctx->item_cnt + 1; i++) {
+    if (member->shares[i].frame == frame) return &member->shares[i];
+  }
+  return NULL;
+}
+
+/* drop one holder of the audio frame, put it back to the session if no holder left */
+static void rx_group_audio_release(struct st_rx_group_ctx* ctx,
+                                   struct st_rx_group_audio_member* member,
+                                   struct st30_frame* frame) {
+  struct st_rx_group_audio_share* share = rx_group_audio_share_find(ctx, member, frame);
+
+  if (share) {
+    share->refs--;
+    if (share->refs) return;
+    share->frame = NULL;
+  }
+  st30p_rx_put_frame(member->handle, frame);
+}
+
+/* the frame attached to the current bundle is also kept as pending for the next one */
+static int rx_group_audio_share(struct st_rx_group_ctx* ctx,
+                                struct st_rx_group_audio_member* member,
+                                struct st30_frame* frame) {
+  struct st_rx_group_audio_share* share = rx_group_audio_share_find(ctx, member, frame);
+
+  if (!share) {
+    share = rx_group_audio_share_find(ctx, member, NULL);
+    if (!share) return -ENOMEM;
+    share->frame = frame;
+    share->refs = 1; /* the current bundle */
+  }
+  share->refs++; /* the pending slot */
+  member->pending = frame;
+  return 0;
+}
+
+/*
+ * pull the audio frames which overlap the video frame period, the frame straddling the
+ * end of the period is shared with the next bundle.
+ */
+static void rx_group_fill_audio(struct st_rx_group_ctx* ctx,
+                                struct st_rx_group_audio_member* member,
+                                struct st_rx_group_audio* audio,
+                                struct st_rx_group_item* item, uint64_t ptp_ns) {
+  struct st_rx_group_bundle* bundle = &item->bundle;
+  uint64_t bundle_end = bundle->tai + bundle->duration_ns;
+  struct st30_frame* frame;
+  uint64_t start, end;
+  int rate;
+
+  while (!audio->complete && audio->frame_cnt < ST_RX_GROUP_MAX_AUDIO_FRAMES) {
+    frame = member->pending;
+    member->pending = NULL;
+    if (!frame) frame = st30p_rx_get_frame(member->handle);
+    if (!frame) return; /* not arrived yet */
+
+    rate = st30_get_sample_rate(frame->sampling);
+    if (rate <= 0) {
+      rx_group_audio_release(ctx, member, frame);
+      rte_atomic32_inc(&member->stat_drop_frame);
+      continue;
+    }
+    start = rx_group_tai(frame->tfmt, frame->timestamp, rate, ptp_ns);
+    end = start + rx_group_clk_to_ns(frame->sample_num, rate);
+
+    if (end <= bundle->tai) { /* too late for this and all later bundles */
+      dbg("%s(%d), drop audio frame %" PRIu64 " for bundle %" PRIu64 "\n", __func__,
+          ctx->idx, start, bundle->tai);
+      rx_group_audio_release(ctx, member, frame);
+      rte_atomic32_inc(&member->stat_drop_frame);
+      continue;
+    }
+    if (start >= bundle_end) { /* belongs to a later bundle */
+      member->pending = frame;
+      audio->complete = true;
+      return;
+    }
+
+    audio->frames[audio->frame_cnt++] = frame;
+    if (end >= bundle_end) {
+      audio->complete = true;
+      if (end > bundle_end && rx_group_audio_share(ctx, member, frame) < 0)
+        warn("%s(%d), no free share for audio frame %" PRIu64 "\n", __func__, ctx->idx,
+             start);
+    }
+  }
+}
+
+/* pull the ANC frames within the video frame period */
+static void rx_group_fill_anc(struct st_rx_group_ctx* ctx,
+                              struct st_rx_group_anc_member* member,
+                              struct st_rx_group_anc* anc, struct st_rx_group_item* item,
+                              uint64_t ptp_ns) {
+  struct st_rx_group_bundle* bundle = &item->bundle;
+  /* ANC normally shares the video timestamp, allow a quarter frame for the rounding */
+  uint64_t slack = bundle->duration_ns / 4;
+  uint64_t window_start = (bundle->tai > slack) ? (bundle->tai - slack) : 0;
+  uint64_t window_end = bundle->tai + bundle->duration_ns - slack;
+  struct st40_anc_frame* frame;
+  uint64_t tai;
+
+  while (!anc->complete && anc->frame_cnt < ST_RX_GROUP_MAX_ANC_FRAMES) {
+    frame = member->pending;
+    member->pending = NULL;
+    if (!frame) frame = st40p_rx_get_frame(member->handle);
+    if (!frame) return; /* not arrived yet */
+
+    tai = rx_group_tai(frame->tfmt, frame->timestamp, 90 * 1000, ptp_ns);
+    if (tai < window_start) { /* too late for this and all later bundles */
+      dbg("%s(%d), drop anc frame %" PRIu64 " for bundle %" PRIu64 "\n", __func__,
+          ctx->idx, tai, bundle->tai);
+      st40p_rx_put_frame(member->handle, frame);
+      rte_atomic32_inc(&member->stat_drop_frame);
+      continue;
+    }
+    if (tai >= window_end) { /* belongs to a later bundle */
+      member->pending = frame;
+      anc->complete = true;
+      return;
+    }
+
+    anc->frames[anc->frame_cnt++] = frame;
+    /* the progressive frame or the second field completes the video frame */
+    if (frame->field != ST40_FIELD_FIRST) anc->complete = true;
+  }
+}
+
+static struct st_rx_group_item* rx_group_get_free_item(struct st_rx_group_ctx* ctx) {
+  for (uint16_t i = 0; i < ctx->item_cnt; i++) {
+    if (!ctx->items[i].in_user && (&ctx->items[i] != ctx->waiting))
+      return &ctx->items[i];
+  }
+  return NULL;
+}
+
+/* start one bundle for the next video frame */
+static struct st_rx_group_item* rx_group_start_item(struct st_rx_group_ctx* ctx) {
+  struct st_rx_group_item* item = rx_group_get_free_item(ctx);
+  struct st_rx_group_bundle* bundle;
+  struct st_frame* video;
+  uint64_t ptp_ns;
+
+  if (!item) {
+    dbg("%s(%d), no free bundle\n", __func__, ctx->idx);
+    return NULL;
+  }
+
+  video = st20p_rx_get_frame(ctx->video);
+  if (!video) return NULL;
+
+  ptp_ns = mtl_ptp_read_time(ctx->impl);
+  bundle = &item->bundle;
+  memset(bundle->audio, 0, sizeof(bundle->audio));
+  memset(bundle->anc, 0, sizeof(bundle->anc));
+  bundle->video = video;
+  bundle->tai = rx_group_tai(video->tfmt, video->timestamp, 90 * 1000, ptp_ns);
+  bundle->duration_ns = ctx->frame_time_ns;
+  bundle->audio_cnt = ctx->audio_cnt;
+  bundle->anc_cnt = ctx->anc_cnt;
+  bundle->complete = false;
+  item->deadline = ptp_ns + ctx->lateness_ns;
+
+  return item;
+}
+
+/* put back all the frames of the bundle to the sessions */
+static void rx_group_put_item(struct st_rx_group_ctx* ctx,
+                              struct st_rx_group_item* item) {
+  struct st_rx_group_bundle* bundle = &item->bundle;
+
+  for (uint16_t i = 0; i < bundle->audio_cnt; i++) {
+    struct st_rx_group_audio* audio = &bundle->audio[i];
+    for (uint16_t j = 0; j < audio->frame_cnt; j++)
+      rx_group_audio_release(ctx, &ctx->audio[i], audio->frames[j]);
+    audio->frame_cnt = 0;
+  }
+  for (uint16_t i = 0; i < bundle->anc_cnt; i++) {
+    struct st_rx_group_anc* anc = &bundle->anc[i];
+    for (uint16_t j = 0; j < anc->frame_cnt; j++)
+      st40p_rx_put_frame(ctx->anc[i].handle, anc->frames[j]);
+    anc->frame_cnt = 0;
+  }
+  if (bundle->video) {
+    st20p_rx_put_frame(ctx->video, bundle->video);
+    bundle->video = NULL;
+  }
+}
+
+static int rx_group_stat(void* priv) {
+  struct st_rx_group_ctx* ctx = priv;
+
+  int bundle = rte_atomic32_read(&ctx->stat_bundle);
+  rte_atomic32_set(&ctx->stat_bundle, 0);
+  int incomplete = rte_atomic32_read(&ctx->stat_incomplete);
+  rte_atomic32_set(&ctx->stat_incomplete, 0);
+  notice("RX_GROUP(%s), bundle %d incomplete %d\n", ctx->ops_name, bundle, incomplete);
+
+  for (uint16_t i = 0; i < ctx->audio_cnt; i++) {
+    int drop = rte_atomic32_read(&ctx->audio[i].stat_drop_frame);
+    rte_atomic32_set(&ctx->audio[i].stat_drop_frame, 0);
+    if (drop) {
+      notice("RX_GROUP(%s), audio %u late drop frame %d\n", ctx->ops_name, i, drop);
+    }
+  }
+  for (uint16_t i = 0; i < ctx->anc_cnt; i++) {
+    int drop = rte_atomic32_read(&ctx->anc[i].stat_drop_frame);
+    rte_atomic32_set(&ctx->anc[i].stat_drop_frame, 0);
+    if (drop) {
+      notice("RX_GROUP(%s), anc %u late drop frame %d\n", ctx->ops_name, i, drop);
+    }
+  }
+
+  return 0;
+}
+
+struct st_rx_group_bundle* st_rx_group_get_bundle(st_rx_group_handle handle) {
+  struct st_rx_group_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st_rx_group_item* item;
+  struct st_rx_group_bundle* bundle;
+  bool complete = true;
+  uint64_t ptp_ns;
+
+  if (ctx->type != MT_ST_HANDLE_RX_GROUP) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return NULL;
+  }
+
+  if (!ctx->waiting) ctx->waiting = rx_group_start_item(ctx);
+  item = ctx->waiting;
+  if (!item) return NULL;
+  bundle = &item->bundle;
+
+  ptp_ns = mtl_ptp_read_time(ctx->impl);
+  for (uint16_t i = 0; i < ctx->audio_cnt; i++) {
+    rx_group_fill_audio(ctx, &ctx->audio[i], &bundle->audio[i], item, ptp_ns);
+    if (!bundle->audio[i].complete) complete = false;
+  }
+  for (uint16_t i = 0; i < ctx->anc_cnt; i++) {
+    rx_group_fill_anc(ctx, &ctx->anc[i], &bundle->anc[i], item, ptp_ns);
+    if (!bundle->anc[i].complete) complete = false;
+  }
+
+  /* wait the late essences until the deadline */
+  if (!complete && ptp_ns < item->deadline) return NULL;
+
+  ctx->waiting = NULL;
+  item->in_user = true;
+  bundle->complete = complete;
+  rte_atomic32_inc(&ctx->stat_bundle);
+  if (!complete) rte_atomic32_inc(&ctx->stat_incomplete);
+
+  dbg("%s(%d), bundle %u tai %" PRIu64 " complete %d\n", __func__, idx, item->idx,
+      bundle->tai, complete);
+  return bundle;
+}
+
+int st_rx_group_put_bundle(st_rx_group_handle handle, struct st_rx_group_bundle* bundle) {
+  struct st_rx_group_ctx* ctx = handle;
+  int idx = ctx->idx;
+  struct st_rx_group_item* item = bundle->priv;
+
+  if (ctx->type != MT_ST_HANDLE_RX_GROUP) {
+    err("%s(%d), invalid type %d\n", __func__, idx, ctx->type);
+    return -EIO;
+  }
+
+  if (!item->in_user) {
+    err("%s(%d), bundle %u not in user\n", __func__, idx, item->idx);
+    return -EIO;
+  }
+
+  rx_group_put_item(ctx, item);
+  item->in_user = false;
+  dbg("%s(%d), bundle %u succ\n", __func__, idx, item->idx);
+
+  return 0;
+}
+
+st_rx_group_handle st_rx_group_create(mtl_handle mt, struct st_rx_group_ops* ops) {
+  static int st_rx_group_idx;
+  struct mtl_main_impl* impl = mt;
+  struct st_rx_group_ctx* ctx;
+  int idx = st_rx_group_idx;
+  int soc_id;
+
+  notice("%s, start for %s\n", __func__, mt_string_safe(ops->name));
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+
+  if (!ops->video || ops->video->type != MT_ST20_HANDLE_PIPELINE_RX) {
+    err("%s, invalid video session\n", __func__);
+    return NULL;
+  }
+  if (ops->audio_cnt > ST_RX_GROUP_MAX_AUDIO || ops->anc_cnt > ST_RX_GROUP_MAX_ANC) {
+    err("%s, invalid audio_cnt %u or anc_cnt %u\n", __func__, ops->audio_cnt,
+        ops->anc_cnt);
+    return NULL;
+  }
+  for (uint16_t i = 0; i < ops->audio_cnt; i++) {
+    if (!ops->audio[i]) {
+      err("%s, audio %u is NULL\n", __func__, i);
+      return NULL;
+    }
+  }
+  for (uint16_t i = 0; i < ops->anc_cnt; i++) {
+    if (!ops->anc[i]) {
+      err("%s, anc %u is NULL\n", __func__, i);
+      return NULL;
+    }
+  }
+
+  soc_id = mt_socket_id(impl, MTL_PORT_P);
+  ctx = mt_rte_zmalloc_socket(sizeof(*ctx), soc_id);
+  if (!ctx) {
+    err("%s, ctx malloc fail\n", __func__);
+    return NULL;
+  }
+
+  ctx->idx = idx;
+  ctx->impl = impl;
+  ctx->type = MT_ST_HANDLE_RX_GROUP;
+  rte_atomic32_set(&ctx->stat_bundle, 0);
+  rte_atomic32_set(&ctx->stat_incomplete, 0);
+
+  /* copy ops */
+  if (ops->name) {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "%s", ops->name);
+  } else {
+    snprintf(ctx->ops_name, sizeof(ctx->ops_name), "RX_GROUP_%d", idx);
+  }
+  ctx->ops = *ops;
+
+  ctx->video = ops->video;
+  ctx->frame_time_ns = NS_PER_S / st_frame_rate(ops->video->ops.fps);
+  ctx->lateness_ns = ops->lateness_ns ? ops->lateness_ns : ctx->frame_time_ns;
+  ctx->audio_cnt = ops->audio_cnt;
+  for (uint16_t i = 0; i < ctx->audio_cnt; i++) {
+    ctx->audio[i].handle = ops->audio[i];
+    rte_atomic32_set(&ctx->audio[i].stat_drop_frame, 0);
+  }
+  ctx->anc_cnt = ops->anc_cnt;
+  for (uint16_t i = 0; i < ctx->anc_cnt; i++) {
+    ctx->anc[i].handle = ops->anc[i];
+    rte_atomic32_set(&ctx->anc[i].stat_drop_frame, 0);
+  }
+
+  /* the video session can't hold more frames than its framebuff_cnt */
+  ctx->item_cnt = ops->video->framebuff_cnt;
+  for (uint16_t i = 0; i < ctx->audio_cnt; i++) {
+    size_t sz = sizeof(*ctx->audio[i].shares) * (ctx->item_cnt + 1);
+    ctx->audio[i].shares = mt_rte_zmalloc_socket(sz, soc_id);
+    if (!ctx->audio[i].shares) {
+      err("%s(%d), audio %u shares malloc fail\n", __func__, idx, i);
+      st_rx_group_free(ctx);
+      return NULL;
+    }
+  }
+  ctx->items = mt_rte_zmalloc_socket(sizeof(*ctx->items) * ctx->item_cnt, soc_id);
+  if (!ctx->items) {
+    err("%s(%d), items malloc fail\n", __func__, idx);
+    st_rx_group_free(ctx);
+    return NULL;
+  }
+  for (uint16_t i = 0; i < ctx->item_cnt; i++) {
+    ctx->items[i].idx = i;
+    ctx->items[i].bundle.priv = &ctx->items[i];
+  }
+
+  mt_stat_register(impl, rx_group_stat, ctx, ctx->ops_name);
+
+  notice("%s(%d), %u audio %u anc, frame time %" PRIu64 " lateness %" PRIu64 "ns\n",
+         __func__, idx, ctx->audio_cnt, ctx->anc_cnt, ctx->frame_time_ns,
+         ctx->lateness_ns);
+  st_rx_group_idx++;
+  return ctx;
+}
+
+int st_rx_group_free(st_rx_group_handle handle) {
+  struct st_rx_group_ctx* ctx = handle;
+
+  notice("%s(%d), start\n", __func__, ctx->idx);
+
+  if (ctx->type != MT_ST_HANDLE_RX_GROUP) {
+    err("%s(%d), invalid type %d\n", __func__, ctx->idx, ctx->type);
+    return -EIO;
+  }
+
+  if (ctx->items) {
+    mt_stat_unregister(ctx->impl, rx_group_stat, ctx);
+    for (uint16_t i = 0; i < ctx->item_cnt; i++) {
+      if (ctx->items[i].in_user)
+        warn("%s(%d), bundle %u still in user\n", __func__, ctx->idx, i);
+      rx_group_put_item(ctx, &ctx->items[i]);
+    }
+    mt_rte_free(ctx->items);
+    ctx->items = NULL;
+  }
+  for (uint16_t i = 0; i < ctx->audio_cnt; i++) {
+    if (ctx->audio[i].pending) {
+      rx_group_audio_release(ctx, &ctx->audio[i], ctx->audio[i].pending);
+      ctx->audio[i].pending = NULL;
+    }
+    if (ctx->audio[i].shares) {
+      mt_rte_free(ctx->audio[i].shares);
+      ctx->audio[i].shares = NULL;
+    }
+  }
+  for (uint16_t i = 0; i < ctx->anc_cnt; i++) {
+    if (ctx->anc[i].pending) {
+      st40p_rx_put_frame(ctx->anc[i].handle, ctx->anc[i].pending);
+      ctx->anc[i].pending = NULL;
+    }
+  }
+
+  notice("%s(%d), succ\n", __func__, ctx->idx);
+  mt_rte_free(ctx);
+
+  return 0;
+}
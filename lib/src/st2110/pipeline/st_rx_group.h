@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_RX_GROUP_HEAD_H_
+#define _ST_LIB_PIPELINE_RX_GROUP_HEAD_H_
+
+#include "../st_main.h"
+
+/* one audio frame straddling the bundle end, shared by the consecutive bundles */
+struct st_rx_group_audio_share {
+  struct st30_frame* frame;
+  uint16_t refs; /* the bundles and the pending slot holding the frame */
+};
+
+struct st_rx_group_audio_member {
+  st30p_rx_handle handle;
+  /* the frame got from session but belongs to a later bundle */
+  struct st30_frame* pending;
+  /* item_cnt + 1 entries, the shared frames alive can't be more than the bundles */
+  struct st_rx_group_audio_share* shares;
+  rte_atomic32_t stat_drop_frame;
+};
+
+struct st_rx_group_anc_member {
+  st40p_rx_handle handle;
+  /* the frame got from session but belongs to a later bundle */
+  struct st40_anc_frame* pending;
+  rte_atomic32_t stat_drop_frame;
+};
+
+struct st_rx_group_item {
+  struct st_rx_group_bundle bundle;
+  bool in_user;
+  uint64_t deadline; /* ptp time to hand out the bundle even if incomplete */
+  uint16_t idx;
+};
+
+struct st_rx_group_ctx {
+  struct mtl_main_impl* impl;
+  int idx;
+  enum mt_handle_type type; /* for sanity check */
+
+  char ops_name[ST_MAX_NAME_LEN];
+  struct st_rx_group_ops ops;
+
+  st20p_rx_handle video;
+  uint64_t frame_time_ns; /* the video frame period */
+  uint64_t lateness_ns;
+  struct st_rx_group_audio_member audio[ST_RX_GROUP_MAX_AUDIO];
+  uint16_t audio_cnt;
+  struct st_rx_group_anc_member anc[ST_RX_GROUP_MAX_ANC];
+  uint16_t anc_cnt;
+
+  /* one bundle for each video framebuff, only accessed from the app thread */
+  uint16_t item_cnt;
+  struct st_rx_group_item* items;
+  struct st_rx_group_item* waiting; /* the bundle waiting for late essences */
+
+  rte_atomic32_t stat_bundle;
+  rte_atomic32_t stat_incomplete;
+};
+
+#endif
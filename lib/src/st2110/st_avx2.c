@@ -215,5 +215,1759 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
   return 0;
 }
 /* end st20_rfc4175_422le10_to_422be10_avx2 */
+
+/* load two 128 bits lanes from two unaligned addresses */
+static inline __m256i st20_avx2_loadu2(void* hi, void* lo) {
+  __m256i v = _mm256_castsi128_si256(_mm_loadu_si128((__m128i*)lo));
+  return _mm256_inserti128_si256(v, _mm_loadu_si128((__m128i*)hi), 1);
+}
+
+/*
+ * pack the madd results to the 5 bytes pgroups, one pg in each 64 bits with the
+ * lower 32 bits for (Y0 | Cb << 10), higher 32 bits for (Y1 | Cr << 10).
+ */
+static inline __m256i st20_avx2_pack_be10(__m256i madd) {
+  __m256i lo = _mm256_and_si256(madd, _mm256_set1_epi64x(0xFFFFFFFF));
+  __m256i pg = _mm256_or_si256(_mm256_slli_epi64(lo, 20), _mm256_srli_epi64(madd, 32));
+  /* big endian bytes of the 40 bits, 10 bytes in each lane */
+  __m256i shuffle = _mm256_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1,
+                                     -1, 4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1,
+                                     -1, -1);
+  return _mm256_shuffle_epi8(pg, shuffle);
+}
+
+/* same as st20_avx2_pack_be10 but (Cb | Y0 << 10) and (Cr | Y1 << 10) in 64 bits */
+static inline __m256i st20_avx2_pack_le10(__m256i madd) {
+  __m256i lo = _mm256_and_si256(madd, _mm256_set1_epi64x(0xFFFFFFFF));
+  __m256i pg = _mm256_or_si256(lo, _mm256_slli_epi64(_mm256_srli_epi64(madd, 32), 20));
+  __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1,
+                                     -1, 0, 1, 2, 3, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1,
+                                     -1, -1);
+  return _mm256_shuffle_epi8(pg, shuffle);
+}
+
+/* store the 2 pgs(10 bytes) of each lane, the 6 bytes padding is written also */
+static inline void st20_avx2_store_pg2x2(uint8_t* dst, __m256i pg) {
+  _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(pg));
+  _mm_storeu_si128((__m128i*)(dst + 10), _mm256_extracti128_si256(pg, 1));
+}
+
+/*
+ * The words of one 10 bits value is picked by the shuffle, multiplied to move the value
+ * to the top 10 bits then shift right by 6.
+ */
+static inline __m256i st20_avx2_unpack10(__m256i input, __m256i shuffle, __m256i mul) {
+  __m256i words = _mm256_shuffle_epi8(input, shuffle);
+  return _mm256_srli_epi16(_mm256_mullo_epi16(words, mul), 6);
+}
+
+/* begin st20_rfc4175_422be10_to_yuv422p10le_avx2 */
+static uint8_t be10_to_yuv422p10le_shuffle_tbl_256[32] = {
+    2, 1, 4, 3, 7, 6, 9, 8, /* Y0 Y1 Y2 Y3 */
+    1, 0, 6, 5,             /* Cb0 Cb1 */
+    3, 2, 8, 7,             /* Cr0 Cr1 */
+    2, 1, 4, 3, 7, 6, 9, 8, /* Y0 Y1 Y2 Y3 */
+    1, 0, 6, 5,             /* Cb0 Cb1 */
+    3, 2, 8, 7,             /* Cr0 Cr1 */
+};
+
+static uint16_t be10_to_yuv422p10le_mul_tbl_256[16] = {
+    4, 64, 4, 64, 1, 1, 16, 16, 4, 64, 4, 64, 1, 1, 16, 16,
+};
+
+static uint8_t le10_to_yuv422p10le_shuffle_tbl_256[32] = {
+    1, 2, 3, 4, 6, 7, 8, 9, /* Y0 Y1 Y2 Y3 */
+    0, 1, 5, 6,             /* Cb0 Cb1 */
+    2, 3, 7, 8,             /* Cr0 Cr1 */
+    1, 2, 3, 4, 6, 7, 8, 9, /* Y0 Y1 Y2 Y3 */
+    0, 1, 5, 6,             /* Cb0 Cb1 */
+    2, 3, 7, 8,             /* Cr0 Cr1 */
+};
+
+static uint16_t le10_to_yuv422p10le_mul_tbl_256[16] = {
+    16, 1, 16, 1, 64, 64, 4, 4, 16, 1, 16, 1, 64, 64, 4, 4,
+};
+
+/* the simd part, return the number of pgs converted */
+static inline int st20_422_10_to_yuv422p10le_avx2(uint8_t* pg, uint16_t* y, uint16_t* b,
+                                                  uint16_t* r, int pg_cnt,
+                                                  uint8_t* shuffle_tbl,
+                                                  uint16_t* mul_tbl) {
+  __m256i shuffle = _mm256_loadu_si256((__m256i*)shuffle_tbl);
+  __m256i mul = _mm256_loadu_si256((__m256i*)mul_tbl);
+  __m256i cbcr_idx = _mm256_setr_epi32(0, 4, 2, 6, 1, 5, 3, 7);
+
+  /* 8 pgs in one batch, each lane loads 16 bytes for 2 pgs(10 bytes) */
+  int batch = pg_cnt / 8;
+  /* jump the last batch if no 2 pgs left, for the lane may access invalid memory */
+  if (batch && (pg_cnt % 8) < 2) batch--;
+
+  for (int i = 0; i < batch; i++) {
+    /* pgs 0,1 | pgs 2,3 and pgs 4,5 | pgs 6,7 */
+    __m256i a = st20_avx2_unpack10(st20_avx2_loadu2(pg + 10, pg), shuffle, mul);
+    __m256i c = st20_avx2_unpack10(st20_avx2_loadu2(pg + 30, pg + 20), shuffle, mul);
+    /* the Y of each lane is in the low 64 bits, Cb and Cr in the high 64 bits */
+    __m256i y_result = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, c), 0xD8);
+    __m256i cbcr = _mm256_unpackhi_epi64(a, c);
+    __m256i cbcr_result = _mm256_permutevar8x32_epi32(cbcr, cbcr_idx);
+
+    _mm256_storeu_si256((__m256i*)y, y_result);
+    _mm_storeu_si128((__m128i*)b, _mm256_castsi256_si128(cbcr_result));
+    _mm_storeu_si128((__m128i*)r, _mm256_extracti128_si256(cbcr_result, 1));
+
+    pg += 40;
+    y += 16;
+    b += 8;
+    r += 8;
+  }
+
+  return batch * 8;
+}
+
+int st20_rfc4175_422be10_to_yuv422p10le_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_422_10_to_yuv422p10le_avx2((uint8_t*)pg, y, b, r, pg_cnt,
+                                             be10_to_yuv422p10le_shuffle_tbl_256,
+                                             be10_to_yuv422p10le_mul_tbl_256);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    *b++ = (pg->Cb00 << 2) + pg->Cb00_;
+    *y++ = (pg->Y00 << 4) + pg->Y00_;
+    *r++ = (pg->Cr00 << 6) + pg->Cr00_;
+    *y++ = (pg->Y01 << 8) + pg->Y01_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_yuv422p10le_avx2 */
+
+/* begin st20_rfc4175_422le10_to_yuv422p10le_avx2 */
+int st20_rfc4175_422le10_to_yuv422p10le_avx2(struct st20_rfc4175_422_10_pg2_le* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_422_10_to_yuv422p10le_avx2((uint8_t*)pg, y, b, r, pg_cnt,
+                                             le10_to_yuv422p10le_shuffle_tbl_256,
+                                             le10_to_yuv422p10le_mul_tbl_256);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    *b++ = pg->Cb00 + (pg->Cb00_ << 8);
+    *y++ = pg->Y00 + (pg->Y00_ << 6);
+    *r++ = pg->Cr00 + (pg->Cr00_ << 4);
+    *y++ = pg->Y01 + (pg->Y01_ << 2);
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422le10_to_yuv422p10le_avx2 */
+
+/* begin st20_yuv422p10le_to_rfc4175_422be10_avx2 */
+/* the simd part for both be and le, return the number of pgs converted */
+static inline int st20_yuv422p10le_to_422_10_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                                  uint8_t* pg, int pg_cnt, bool be) {
+  __m256i mask_10 = _mm256_set1_epi16(0x3FF);
+  __m256i madd_mul = _mm256_set1_epi32(1 | (1024 << 16));
+
+  /* 8 pgs in one batch, each lane stores 16 bytes for 2 pgs(10 bytes) */
+  int batch = pg_cnt / 8;
+  /* jump the last batch if no 2 pgs left, for the lane may access invalid memory */
+  if (batch && (pg_cnt % 8) < 2) batch--;
+
+  for (int i = 0; i < batch; i++) {
+    __m256i y_input = _mm256_and_si256(_mm256_loadu_si256((__m256i*)y), mask_10);
+    __m128i b_input = _mm_loadu_si128((__m128i*)b);
+    __m128i r_input = _mm_loadu_si128((__m128i*)r);
+    /* Cb Cr of pgs 0-3 | pgs 4-7, same as the Y lanes */
+    __m256i cbcr = _mm256_and_si256(
+        _mm256_set_m128i(_mm_unpackhi_epi16(b_input, r_input),
+                         _mm_unpacklo_epi16(b_input, r_input)),
+        mask_10);
+    __m256i lo, hi;
+
+    if (be) { /* (Y0, Cb) and (Y1, Cr) pairs */
+      lo = st20_avx2_pack_be10(_mm256_madd_epi16(_mm256_unpacklo_epi16(y_input, cbcr),
+                                                 madd_mul));
+      hi = st20_avx2_pack_be10(_mm256_madd_epi16(_mm256_unpackhi_epi16(y_input, cbcr),
+                                                 madd_mul));
+    } else { /* (Cb, Y0) and (Cr, Y1) pairs */
+      lo = st20_avx2_pack_le10(_mm256_madd_epi16(_mm256_unpacklo_epi16(cbcr, y_input),
+                                                 madd_mul));
+      hi = st20_avx2_pack_le10(_mm256_madd_epi16(_mm256_unpackhi_epi16(cbcr, y_input),
+                                                 madd_mul));
+    }
+
+    /* lo: pgs 0,1 | pgs 4,5, hi: pgs 2,3 | pgs 6,7 */
+    _mm_storeu_si128((__m128i*)pg, _mm256_castsi256_si128(lo));
+    _mm_storeu_si128((__m128i*)(pg + 10), _mm256_castsi256_si128(hi));
+    _mm_storeu_si128((__m128i*)(pg + 20), _mm256_extracti128_si256(lo, 1));
+    _mm_storeu_si128((__m128i*)(pg + 30), _mm256_extracti128_si256(hi, 1));
+
+    y += 16;
+    b += 8;
+    r += 8;
+    pg += 40;
+  }
+
+  return batch * 8;
+}
+
+int st20_yuv422p10le_to_rfc4175_422be10_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_yuv422p10le_to_422_10_avx2(y, b, r, (uint8_t*)pg, pg_cnt, true);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    uint16_t cb = *b++;
+    uint16_t y0 = *y++;
+    uint16_t cr = *r++;
+    uint16_t y1 = *y++;
+
+    pg->Cb00 = cb >> 2;
+    pg->Cb00_ = cb;
+    pg->Y00 = y0 >> 4;
+    pg->Y00_ = y0;
+    pg->Cr00 = cr >> 6;
+    pg->Cr00_ = cr;
+    pg->Y01 = y1 >> 8;
+    pg->Y01_ = y1;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_yuv422p10le_to_rfc4175_422be10_avx2 */
+
+/* begin st20_yuv422p10le_to_rfc4175_422le10_avx2 */
+int st20_yuv422p10le_to_rfc4175_422le10_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_le* pg,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_yuv422p10le_to_422_10_avx2(y, b, r, (uint8_t*)pg, pg_cnt, false);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    uint16_t cb = *b++;
+    uint16_t y0 = *y++;
+    uint16_t cr = *r++;
+    uint16_t y1 = *y++;
+
+    pg->Cb00 = cb;
+    pg->Cb00_ = cb >> 8;
+    pg->Y00 = y0;
+    pg->Y00_ = y0 >> 6;
+    pg->Cr00 = cr;
+    pg->Cr00_ = cr >> 4;
+    pg->Y01 = y1;
+    pg->Y01_ = y1 >> 2;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_yuv422p10le_to_rfc4175_422le10_avx2 */
+
+/* begin st20_rfc4175_422be10_to_422le8_avx2 */
+static uint8_t be10_to_le8_shuffle_tbl_256[32] = {
+    1, 0, 2, 1, 3, 2, 4, 3, /* pg0 */
+    6, 5, 7, 6, 8, 7, 9, 8, /* pg1 */
+    1, 0, 2, 1, 3, 2, 4, 3, /* pg0 */
+    6, 5, 7, 6, 8, 7, 9, 8, /* pg1 */
+};
+
+static uint16_t be10_to_le8_mul_tbl_256[16] = {
+    1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64,
+};
+
+int st20_rfc4175_422be10_to_422le8_avx2(struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        uint32_t w, uint32_t h) {
+  __m256i shuffle = _mm256_loadu_si256((__m256i*)be10_to_le8_shuffle_tbl_256);
+  __m256i mul = _mm256_loadu_si256((__m256i*)be10_to_le8_mul_tbl_256);
+  uint8_t* pg = (uint8_t*)pg_10;
+
+  int pg_cnt = w * h / 2;
+  /* 8 pgs in one batch, each lane loads 16 bytes for 2 pgs(10 bytes) */
+  int batch = pg_cnt / 8;
+  /* jump the last batch if no 2 pgs left, for the lane may access invalid memory */
+  if (batch && (pg_cnt % 8) < 2) batch--;
+  int left = pg_cnt - batch * 8;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    /* the 10 bits value at the top of 16 bits, keep the higher 8 bits */
+    __m256i a = _mm256_srli_epi16(
+        _mm256_mullo_epi16(
+            _mm256_shuffle_epi8(st20_avx2_loadu2(pg + 10, pg), shuffle), mul),
+        8);
+    __m256i c = _mm256_srli_epi16(
+        _mm256_mullo_epi16(
+            _mm256_shuffle_epi8(st20_avx2_loadu2(pg + 30, pg + 20), shuffle), mul),
+        8);
+    /* pgs 0,1 | 4,5 | 2,3 | 6,7 after pack */
+    __m256i result = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, c), 0xD8);
+
+    _mm256_storeu_si256((__m256i*)pg_8, result);
+
+    pg += 40;
+    pg_8 += 8;
+  }
+
+  pg_10 = (struct st20_rfc4175_422_10_pg2_be*)pg;
+  while (left) {
+    pg_8->Cb00 = pg_10->Cb00;
+    pg_8->Y00 = (pg_10->Y00 << 2) + (pg_10->Y00_ >> 2);
+    pg_8->Cr00 = (pg_10->Cr00 << 4) + (pg_10->Cr00_ >> 2);
+    pg_8->Y01 = (pg_10->Y01 << 6) + (pg_10->Y01_ >> 2);
+    pg_10++;
+    pg_8++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_422le8_avx2 */
+
+/* begin st20_rfc4175_422be10_to_y210_avx2 */
+static uint8_t be10_to_y210_shuffle_tbl_256[32] = {
+    2, 1, 1, 0, 4, 3, 3, 2, /* Y0 Cb Y1 Cr of pg0 */
+    7, 6, 6, 5, 9, 8, 8, 7, /* Y0 Cb Y1 Cr of pg1 */
+    2, 1, 1, 0, 4, 3, 3, 2, /* Y0 Cb Y1 Cr of pg0 */
+    7, 6, 6, 5, 9, 8, 8, 7, /* Y0 Cb Y1 Cr of pg1 */
+};
+
+static uint16_t be10_to_y210_mul_tbl_256[16] = {
+    4, 1, 64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1, 64, 16,
+};
+
+int st20_rfc4175_422be10_to_y210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint16_t* pg_y210, uint32_t w, uint32_t h) {
+  __m256i shuffle = _mm256_loadu_si256((__m256i*)be10_to_y210_shuffle_tbl_256);
+  __m256i mul = _mm256_loadu_si256((__m256i*)be10_to_y210_mul_tbl_256);
+  __m256i mask = _mm256_set1_epi16(0xFFC0);
+  uint8_t* pg = (uint8_t*)pg_be;
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs in one batch, each lane loads 16 bytes for 2 pgs(10 bytes) */
+  int batch = pg_cnt / 4;
+  /* jump the last batch if no 2 pgs left, for the lane may access invalid memory */
+  if (batch && (pg_cnt % 4) < 2) batch--;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    /* the 10 bits value at the top of 16 bits is the y210 sample */
+    __m256i words = _mm256_shuffle_epi8(st20_avx2_loadu2(pg + 10, pg), shuffle);
+    __m256i result = _mm256_and_si256(_mm256_mullo_epi16(words, mul), mask);
+
+    _mm256_storeu_si256((__m256i*)pg_y210, result);
+
+    pg += 20;
+    pg_y210 += 16;
+  }
+
+  pg_be = (struct st20_rfc4175_422_10_pg2_be*)pg;
+  while (left) {
+    pg_y210[0] = (pg_be->Y00 << 10) + (pg_be->Y00_ << 6);
+    pg_y210[1] = (pg_be->Cb00 << 8) + (pg_be->Cb00_ << 6);
+    pg_y210[2] = (pg_be->Y01 << 14) + (pg_be->Y01_ << 6);
+    pg_y210[3] = (pg_be->Cr00 << 12) + (pg_be->Cr00_ << 6);
+    pg_be++;
+    pg_y210 += 4;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_y210_avx2 */
+
+/* begin st20_y210_to_rfc4175_422be10_avx2 */
+int st20_y210_to_rfc4175_422be10_avx2(uint16_t* pg_y210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h) {
+  __m256i madd_mul = _mm256_set1_epi32(1 | (1024 << 16));
+  uint8_t* pg = (uint8_t*)pg_be;
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs in one batch, each lane stores 16 bytes for 2 pgs(10 bytes) */
+  int batch = pg_cnt / 4;
+  /* jump the last batch if no 2 pgs left, for the lane may access invalid memory */
+  if (batch && (pg_cnt % 4) < 2) batch--;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    /* Y0 Cb Y1 Cr, the (Y0, Cb) and (Y1, Cr) pairs */
+    __m256i input = _mm256_srli_epi16(_mm256_loadu_si256((__m256i*)pg_y210), 6);
+    __m256i result = st20_avx2_pack_be10(_mm256_madd_epi16(input, madd_mul));
+
+    st20_avx2_store_pg2x2(pg, result);
+
+    pg += 20;
+    pg_y210 += 16;
+  }
+
+  pg_be = (struct st20_rfc4175_422_10_pg2_be*)pg;
+  while (left) {
+    pg_be->Cb00 = pg_y210[1] >> 8;
+    pg_be->Cb00_ = (pg_y210[1] >> 6) & 0x3;
+    pg_be->Y00 = pg_y210[0] >> 10;
+    pg_be->Y00_ = (pg_y210[0] >> 6) & 0xF;
+    pg_be->Cr00 = pg_y210[3] >> 12;
+    pg_be->Cr00_ = (pg_y210[3] >> 6) & 0x3F;
+    pg_be->Y01 = pg_y210[2] >> 14;
+    pg_be->Y01_ = (pg_y210[2] >> 6) & 0xFF;
+    pg_be++;
+    pg_y210 += 4;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_y210_to_rfc4175_422be10_avx2 */
+
+/* begin st20_rfc4175_422be10_to_v210_avx2 */
+/* 12 values of 3 pgs in each lane, 8 in x words and 4 in q words */
+static uint8_t be10_to_v210_shuffle_x_tbl_256[32] = {
+    1, 0, 2, 1, 4,  3,  6,  5,  /* v0 v1 v3 v4 */
+    8, 7, 9, 8, 12, 11, 13, 12, /* v6 v7 v9 v10 */
+    1, 0, 2, 1, 4,  3,  6,  5,  /* v0 v1 v3 v4 */
+    8, 7, 9, 8, 12, 11, 13, 12, /* v6 v7 v9 v10 */
+};
+
+static uint16_t be10_to_v210_mul_x_tbl_256[16] = {
+    1, 4, 64, 1, 16, 64, 4, 16, 1, 4, 64, 1, 16, 64, 4, 16,
+};
+
+static uint8_t be10_to_v210_shuffle_q_tbl_256[32] = {
+    3,  2,  0x80, 0x80, 7,  6,  0x80, 0x80, /* v2 v5 */
+    11, 10, 0x80, 0x80, 14, 13, 0x80, 0x80, /* v8 v11 */
+    3,  2,  0x80, 0x80, 7,  6,  0x80, 0x80, /* v2 v5 */
+    11, 10, 0x80, 0x80, 14, 13, 0x80, 0x80, /* v8 v11 */
+};
+
+static uint16_t be10_to_v210_mul_q_tbl_256[16] = {
+    16, 0, 4, 0, 1, 0, 64, 0, 16, 0, 4, 0, 1, 0, 64, 0,
+};
+
+static uint8_t le10_to_v210_shuffle_x_tbl_256[32] = {
+    0, 1, 1, 2, 3,  4,  5,  6,  /* v0 v1 v3 v4 */
+    7, 8, 8, 9, 11, 12, 12, 13, /* v6 v7 v9 v10 */
+    0, 1, 1, 2, 3,  4,  5,  6,  /* v0 v1 v3 v4 */
+    7, 8, 8, 9, 11, 12, 12, 13, /* v6 v7 v9 v10 */
+};
+
+static uint16_t le10_to_v210_mul_x_tbl_256[16] = {
+    64, 16, 1, 64, 4, 1, 16, 4, 64, 16, 1, 64, 4, 1, 16, 4,
+};
+
+static uint8_t le10_to_v210_shuffle_q_tbl_256[32] = {
+    2,  3,  0x80, 0x80, 6,  7,  0x80, 0x80, /* v2 v5 */
+    10, 11, 0x80, 0x80, 13, 14, 0x80, 0x80, /* v8 v11 */
+    2,  3,  0x80, 0x80, 6,  7,  0x80, 0x80, /* v2 v5 */
+    10, 11, 0x80, 0x80, 13, 14, 0x80, 0x80, /* v8 v11 */
+};
+
+static uint16_t le10_to_v210_mul_q_tbl_256[16] = {
+    4, 0, 16, 0, 64, 0, 1, 0, 4, 0, 16, 0, 64, 0, 1, 0,
+};
+
+struct st20_avx2_v210_masks {
+  __m256i shuffle_x;
+  __m256i mul_x;
+  __m256i shuffle_q;
+  __m256i mul_q;
+};
+
+/* 6 pgs(30 bytes) to 2 v210 blocks(32 bytes), the input is read 31 bytes */
+static inline void st20_avx2_422_10_to_v210(uint8_t* pg, uint8_t* pg_v210,
+                                            struct st20_avx2_v210_masks* masks) {
+  __m256i madd_mul = _mm256_set1_epi32(1 | (1024 << 16));
+  __m256i input = st20_avx2_loadu2(pg + 15, pg);
+  /* (v0 | v1 << 10) in each 32 bits, then or with v2 << 20 */
+  __m256i x = st20_avx2_unpack10(input, masks->shuffle_x, masks->mul_x);
+  __m256i q = st20_avx2_unpack10(input, masks->shuffle_q, masks->mul_q);
+  __m256i result =
+      _mm256_or_si256(_mm256_madd_epi16(x, madd_mul), _mm256_slli_epi32(q, 20));
+
+  _mm256_storeu_si256((__m256i*)pg_v210, result);
+}
+
+static int st20_422_10_to_v210_avx2(uint8_t* pg, uint8_t* pg_v210, uint32_t w,
+                                    uint32_t h, struct st20_avx2_v210_masks* masks) {
+  int pg_cnt = w * h / 2;
+  if (pg_cnt % 3 != 0) {
+    err("%s, invalid pg_cnt %d, pixel group number must be multiple of 3!\n", __func__,
+        pg_cnt);
+    return -EINVAL;
+  }
+
+  /* 2 v210 blocks in one batch */
+  int blocks = pg_cnt / 3;
+  int batch = blocks / 2;
+  int left = blocks % 2;
+  /* jump the last batch, for the Ymm may access invalid memory in the last byte */
+  if (batch && !left) {
+    batch--;
+    left = 2;
+  }
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    st20_avx2_422_10_to_v210(pg, pg_v210, masks);
+    pg += 30;
+    pg_v210 += 32;
+  }
+
+  if (left) { /* the left blocks with a local copy */
+    uint8_t pg_tmp[32] = {0};
+    uint8_t v210_tmp[32];
+
+    rte_memcpy(pg_tmp, pg, left * 15);
+    st20_avx2_422_10_to_v210(pg_tmp, v210_tmp, masks);
+    rte_memcpy(pg_v210, v210_tmp, left * 16);
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_v210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint8_t* pg_v210, uint32_t w, uint32_t h) {
+  struct st20_avx2_v210_masks masks;
+
+  masks.shuffle_x = _mm256_loadu_si256((__m256i*)be10_to_v210_shuffle_x_tbl_256);
+  masks.mul_x = _mm256_loadu_si256((__m256i*)be10_to_v210_mul_x_tbl_256);
+  masks.shuffle_q = _mm256_loadu_si256((__m256i*)be10_to_v210_shuffle_q_tbl_256);
+  masks.mul_q = _mm256_loadu_si256((__m256i*)be10_to_v210_mul_q_tbl_256);
+  return st20_422_10_to_v210_avx2((uint8_t*)pg_be, pg_v210, w, h, &masks);
+}
+/* end st20_rfc4175_422be10_to_v210_avx2 */
+
+/* begin st20_rfc4175_422le10_to_v210_avx2 */
+int st20_rfc4175_422le10_to_v210_avx2(uint8_t* pg_le, uint8_t* pg_v210, uint32_t w,
+                                      uint32_t h) {
+  struct st20_avx2_v210_masks masks;
+
+  masks.shuffle_x = _mm256_loadu_si256((__m256i*)le10_to_v210_shuffle_x_tbl_256);
+  masks.mul_x = _mm256_loadu_si256((__m256i*)le10_to_v210_mul_x_tbl_256);
+  masks.shuffle_q = _mm256_loadu_si256((__m256i*)le10_to_v210_shuffle_q_tbl_256);
+  masks.mul_q = _mm256_loadu_si256((__m256i*)le10_to_v210_mul_q_tbl_256);
+  return st20_422_10_to_v210_avx2(pg_le, pg_v210, w, h, &masks);
+}
+/* end st20_rfc4175_422le10_to_v210_avx2 */
+
+/* begin st20_v210_to_rfc4175_422be10_avx2 */
+/*
+ * 4 v210 blocks(12 pgs) in one batch, 2 pgs in each lane. The pgs pair starts at the
+ * a, c, b value of the v210 words in turn, so the lanes are loaded from the offsets 0,
+ * 8, 20 of every 2 blocks. The words of each pg in Y0 Cb Y1 Cr order.
+ */
+static uint8_t v210_to_be10_shuffle_tbl_256[3][32] = {
+    {
+        1, 2, 0, 1, 4, 5, 2, 3, 6, 7, 5, 6, 9, 10, 8, 9, /* offset 0 */
+        4, 5, 2, 3, 6, 7, 5, 6, 9, 10, 8, 9, 12, 13, 10, 11, /* offset 8 */
+    },
+    {
+        2, 3, 1, 2, 5, 6, 4, 5, 8, 9, 6, 7, 10, 11, 9, 10, /* offset 20 */
+        1, 2, 0, 1, 4, 5, 2, 3, 6, 7, 5, 6, 9, 10, 8, 9, /* offset 0 */
+    },
+    {
+        4, 5, 2, 3, 6, 7, 5, 6, 9, 10, 8, 9, 12, 13, 10, 11, /* offset 8 */
+        2, 3, 1, 2, 5, 6, 4, 5, 8, 9, 6, 7, 10, 11, 9, 10, /* offset 20 */
+    },
+};
+
+static uint16_t v210_to_be10_mul_tbl_256[3][16] = {
+    {16, 64, 64, 4, 4, 16, 16, 64, 64, 4, 4, 16, 16, 64, 64, 4},
+    {4, 16, 16, 64, 64, 4, 4, 16, 16, 64, 64, 4, 4, 16, 16, 64},
+    {64, 4, 4, 16, 16, 64, 64, 4, 4, 16, 16, 64, 64, 4, 4, 16},
+};
+
+/* the same for le but the words of each pg in Cb Y0 Cr Y1 order */
+static uint8_t v210_to_le10_shuffle_tbl_256[3][32] = {
+    {
+        0, 1, 1, 2, 2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, /* offset 0 */
+        2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13, /* offset 8 */
+    },
+    {
+        1, 2, 2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, /* offset 20 */
+        0, 1, 1, 2, 2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, /* offset 0 */
+    },
+    {
+        2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13, /* offset 8 */
+        1, 2, 2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, /* offset 20 */
+    },
+};
+
+static uint16_t v210_to_le10_mul_tbl_256[3][16] = {
+    {64, 16, 4, 64, 16, 4, 64, 16, 4, 64, 16, 4, 64, 16, 4, 64},
+    {16, 4, 64, 16, 4, 64, 16, 4, 64, 16, 4, 64, 16, 4, 64, 16},
+    {4, 64, 16, 4, 64, 16, 4, 64, 16, 4, 64, 16, 4, 64, 16, 4},
+};
+
+/* the simd part for both be and le, 12 pgs from 4 v210 blocks(64 bytes + 4 bytes) */
+static inline void st20_avx2_v210_to_422_10(uint8_t* pg_v210, uint8_t* pg, bool be,
+                                            __m256i* shuffle, __m256i* mul) {
+  __m256i madd_mul = _mm256_set1_epi32(1 | (1024 << 16));
+  __m256i input[3];
+  __m256i madd;
+
+  input[0] = st20_avx2_loadu2(pg_v210 + 8, pg_v210);
+  input[1] = st20_avx2_loadu2(pg_v210 + 32, pg_v210 + 20);
+  input[2] = st20_avx2_loadu2(pg_v210 + 52, pg_v210 + 40);
+  for (int i = 0; i < 3; i++) {
+    madd = _mm256_madd_epi16(st20_avx2_unpack10(input[i], shuffle[i], mul[i]), madd_mul);
+    st20_avx2_store_pg2x2(pg, be ? st20_avx2_pack_be10(madd) : st20_avx2_pack_le10(madd));
+    pg += 20;
+  }
+}
+
+static int st20_v210_to_422_10_avx2(uint8_t* pg_v210, uint8_t* pg, uint32_t w,
+                                    uint32_t h, bool be) {
+  uint8_t(*shuffle_tbl)[32] =
+      be ? v210_to_be10_shuffle_tbl_256 : v210_to_le10_shuffle_tbl_256;
+  uint16_t(*mul_tbl)[16] = be ? v210_to_be10_mul_tbl_256 : v210_to_le10_mul_tbl_256;
+  __m256i shuffle[3];
+  __m256i mul[3];
+
+  int pg_cnt = w * h / 2;
+  if (pg_cnt % 3 != 0) {
+    err("%s, invalid pg_cnt %d, pixel group number must be multiple of 3!\n", __func__,
+        pg_cnt);
+    return -EINVAL;
+  }
+
+  for (int i = 0; i < 3; i++) {
+    shuffle[i] = _mm256_loadu_si256((__m256i*)shuffle_tbl[i]);
+    mul[i] = _mm256_loadu_si256((__m256i*)mul_tbl[i]);
+  }
+
+  /* 4 v210 blocks in one batch */
+  int blocks = pg_cnt / 3;
+  int batch = blocks / 4;
+  int left = blocks % 4;
+  /* jump the last batch, for the Ymm may access invalid memory in the last bytes */
+  if (batch && !left) {
+    batch--;
+    left = 4;
+  }
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    st20_avx2_v210_to_422_10(pg_v210, pg, be, shuffle, mul);
+    pg_v210 += 64;
+    pg += 60;
+  }
+
+  if (left) { /* the left blocks with a local copy */
+    uint8_t v210_tmp[80] = {0};
+    uint8_t pg_tmp[80];
+
+    rte_memcpy(v210_tmp, pg_v210, left * 16);
+    st20_avx2_v210_to_422_10(v210_tmp, pg_tmp, be, shuffle, mul);
+    rte_memcpy(pg, pg_tmp, left * 15);
+  }
+
+  return 0;
+}
+
+int st20_v210_to_rfc4175_422be10_avx2(uint8_t* pg_v210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h) {
+  return st20_v210_to_422_10_avx2(pg_v210, (uint8_t*)pg_be, w, h, true);
+}
+/* end st20_v210_to_rfc4175_422be10_avx2 */
+
+/* begin st20_v210_to_rfc4175_422le10_avx2 */
+int st20_v210_to_rfc4175_422le10_avx2(uint8_t* pg_v210, uint8_t* pg_le, uint32_t w,
+                                      uint32_t h) {
+  return st20_v210_to_422_10_avx2(pg_v210, pg_le, w, h, false);
+}
+/* end st20_v210_to_rfc4175_422le10_avx2 */
+
+/*
+ * The words of one 12 bits value is picked by the shuffle, multiplied to move the value
+ * to the top 12 bits then shift right by 4.
+ */
+static inline __m256i st20_avx2_unpack12(__m256i input, __m256i shuffle, __m256i mul) {
+  __m256i words = _mm256_shuffle_epi8(input, shuffle);
+  return _mm256_srli_epi16(_mm256_mullo_epi16(words, mul), 4);
+}
+
+/* the 24 bits (first << 12 | second) in each 32 bits to 3 bytes, 12 bytes in each lane */
+static inline __m256i st20_avx2_pack_be12(__m256i madd) {
+  __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                                     -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                                     -1, -1);
+  return _mm256_shuffle_epi8(madd, shuffle);
+}
+
+/* same as st20_avx2_pack_be12 but (first | second << 12) in each 32 bits */
+static inline __m256i st20_avx2_pack_le12(__m256i madd) {
+  __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1,
+                                     -1, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1,
+                                     -1, -1);
+  return _mm256_shuffle_epi8(madd, shuffle);
+}
+
+/* store the 12 bytes of each lane, the 4 bytes padding is written also */
+static inline void st20_avx2_store_12x2(uint8_t* dst, __m256i v) {
+  _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(v));
+  _mm_storeu_si128((__m128i*)(dst + 12), _mm256_extracti128_si256(v, 1));
+}
+
+/* begin st20_rfc4175_422be12_to_yuv422p12le_avx2 */
+static uint8_t be12_to_yuv422p12le_shuffle_tbl_256[32] = {
+    2, 1, 5, 4, 8, 7, 11, 10, /* Y0 Y1 Y2 Y3 */
+    1, 0, 7, 6,               /* Cb0 Cb1 */
+    4, 3, 10, 9,              /* Cr0 Cr1 */
+    2, 1, 5, 4, 8, 7, 11, 10, /* Y0 Y1 Y2 Y3 */
+    1, 0, 7, 6,               /* Cb0 Cb1 */
+    4, 3, 10, 9,              /* Cr0 Cr1 */
+};
+
+static uint16_t be12_to_yuv422p12le_mul_tbl_256[16] = {
+    16, 16, 16, 16, 1, 1, 1, 1, 16, 16, 16, 16, 1, 1, 1, 1,
+};
+
+static uint8_t le12_to_yuv422p12le_shuffle_tbl_256[32] = {
+    1, 2, 4, 5, 7, 8, 10, 11, /* Y0 Y1 Y2 Y3 */
+    0, 1, 6, 7,               /* Cb0 Cb1 */
+    3, 4, 9, 10,              /* Cr0 Cr1 */
+    1, 2, 4, 5, 7, 8, 10, 11, /* Y0 Y1 Y2 Y3 */
+    0, 1, 6, 7,               /* Cb0 Cb1 */
+    3, 4, 9, 10,              /* Cr0 Cr1 */
+};
+
+static uint16_t le12_to_yuv422p12le_mul_tbl_256[16] = {
+    1, 1, 1, 1, 16, 16, 16, 16, 1, 1, 1, 1, 16, 16, 16, 16,
+};
+
+/* the simd part, return the number of pgs converted */
+static inline int st20_422_12_to_yuv422p12le_avx2(uint8_t* pg, uint16_t* y, uint16_t* b,
+                                                  uint16_t* r, int pg_cnt,
+                                                  uint8_t* shuffle_tbl,
+                                                  uint16_t* mul_tbl) {
+  __m256i shuffle = _mm256_loadu_si256((__m256i*)shuffle_tbl);
+  __m256i mul = _mm256_loadu_si256((__m256i*)mul_tbl);
+  __m256i cbcr_idx = _mm256_setr_epi32(0, 4, 2, 6, 1, 5, 3, 7);
+
+  /* 8 pgs in one batch, each lane loads 16 bytes for 2 pgs(12 bytes) */
+  int batch = pg_cnt / 8;
+  /* jump the last batch if no pg left, for the lane may access invalid memory */
+  if (batch && !(pg_cnt % 8)) batch--;
+
+  for (int i = 0; i < batch; i++) {
+    /* pgs 0,1 | pgs 2,3 and pgs 4,5 | pgs 6,7 */
+    __m256i a = st20_avx2_unpack12(st20_avx2_loadu2(pg + 12, pg), shuffle, mul);
+    __m256i c = st20_avx2_unpack12(st20_avx2_loadu2(pg + 36, pg + 24), shuffle, mul);
+    /* the Y of each lane is in the low 64 bits, Cb and Cr in the high 64 bits */
+    __m256i y_result = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, c), 0xD8);
+    __m256i cbcr = _mm256_unpackhi_epi64(a, c);
+    __m256i cbcr_result = _mm256_permutevar8x32_epi32(cbcr, cbcr_idx);
+
+    _mm256_storeu_si256((__m256i*)y, y_result);
+    _mm_storeu_si128((__m128i*)b, _mm256_castsi256_si128(cbcr_result));
+    _mm_storeu_si128((__m128i*)r, _mm256_extracti128_si256(cbcr_result, 1));
+
+    pg += 48;
+    y += 16;
+    b += 8;
+    r += 8;
+  }
+
+  return batch * 8;
+}
+
+int st20_rfc4175_422be12_to_yuv422p12le_avx2(struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_422_12_to_yuv422p12le_avx2((uint8_t*)pg, y, b, r, pg_cnt,
+                                             be12_to_yuv422p12le_shuffle_tbl_256,
+                                             be12_to_yuv422p12le_mul_tbl_256);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    *b++ = (pg->Cb00 << 4) + pg->Cb00_;
+    *y++ = (pg->Y00 << 8) + pg->Y00_;
+    *r++ = (pg->Cr00 << 4) + pg->Cr00_;
+    *y++ = (pg->Y01 << 8) + pg->Y01_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be12_to_yuv422p12le_avx2 */
+
+/* begin st20_rfc4175_422le12_to_yuv422p12le_avx2 */
+int st20_rfc4175_422le12_to_yuv422p12le_avx2(struct st20_rfc4175_422_12_pg2_le* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_422_12_to_yuv422p12le_avx2((uint8_t*)pg, y, b, r, pg_cnt,
+                                             le12_to_yuv422p12le_shuffle_tbl_256,
+                                             le12_to_yuv422p12le_mul_tbl_256);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    *b++ = pg->Cb00 + (pg->Cb00_ << 8);
+    *y++ = pg->Y00 + (pg->Y00_ << 4);
+    *r++ = pg->Cr00 + (pg->Cr00_ << 8);
+    *y++ = pg->Y01 + (pg->Y01_ << 4);
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422le12_to_yuv422p12le_avx2 */
+
+/* begin st20_yuv422p12le_to_rfc4175_422be12_avx2 */
+/* the simd part for both be and le, return the number of pgs converted */
+static inline int st20_yuv422p12le_to_422_12_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                                  uint8_t* pg, int pg_cnt, bool be) {
+  __m256i mask_12 = _mm256_set1_epi16(0xFFF);
+  __m256i madd_mul = _mm256_set1_epi32(1 | (4096 << 16));
+
+  /* 8 pgs in one batch, each lane stores 16 bytes for 2 pgs(12 bytes) */
+  int batch = pg_cnt / 8;
+  /* jump the last batch if no pg left, for the lane may access invalid memory */
+  if (batch && !(pg_cnt % 8)) batch--;
+
+  for (int i = 0; i < batch; i++) {
+    __m256i y_input = _mm256_and_si256(_mm256_loadu_si256((__m256i*)y), mask_12);
+    __m128i b_input = _mm_loadu_si128((__m128i*)b);
+    __m128i r_input = _mm_loadu_si128((__m128i*)r);
+    /* Cb Cr of pgs 0-3 | pgs 4-7, same as the Y lanes */
+    __m256i cbcr = _mm256_and_si256(
+        _mm256_set_m128i(_mm_unpackhi_epi16(b_input, r_input),
+                         _mm_unpacklo_epi16(b_input, r_input)),
+        mask_12);
+    __m256i lo, hi;
+
+    if (be) { /* (Y0, Cb) and (Y1, Cr) pairs */
+      lo = st20_avx2_pack_be12(_mm256_madd_epi16(_mm256_unpacklo_epi16(y_input, cbcr),
+                                                 madd_mul));
+      hi = st20_avx2_pack_be12(_mm256_madd_epi16(_mm256_unpackhi_epi16(y_input, cbcr),
+                                                 madd_mul));
+    } else { /* (Cb, Y0) and (Cr, Y1) pairs */
+      lo = st20_avx2_pack_le12(_mm256_madd_epi16(_mm256_unpacklo_epi16(cbcr, y_input),
+                                                 madd_mul));
+      hi = st20_avx2_pack_le12(_mm256_madd_epi16(_mm256_unpackhi_epi16(cbcr, y_input),
+                                                 madd_mul));
+    }
+
+    /* lo: pgs 0,1 | pgs 4,5, hi: pgs 2,3 | pgs 6,7 */
+    _mm_storeu_si128((__m128i*)pg, _mm256_castsi256_si128(lo));
+    _mm_storeu_si128((__m128i*)(pg + 12), _mm256_castsi256_si128(hi));
+    _mm_storeu_si128((__m128i*)(pg + 24), _mm256_extracti128_si256(lo, 1));
+    _mm_storeu_si128((__m128i*)(pg + 36), _mm256_extracti128_si256(hi, 1));
+
+    y += 16;
+    b += 8;
+    r += 8;
+    pg += 48;
+  }
+
+  return batch * 8;
+}
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_yuv422p12le_to_422_12_avx2(y, b, r, (uint8_t*)pg, pg_cnt, true);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    uint16_t cb = *b++;
+    uint16_t y0 = *y++;
+    uint16_t cr = *r++;
+    uint16_t y1 = *y++;
+
+    pg->Cb00 = cb >> 4;
+    pg->Cb00_ = cb;
+    pg->Y00 = y0 >> 8;
+    pg->Y00_ = y0;
+    pg->Cr00 = cr >> 4;
+    pg->Cr00_ = cr;
+    pg->Y01 = y1 >> 8;
+    pg->Y01_ = y1;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_yuv422p12le_to_rfc4175_422be12_avx2 */
+
+/* begin st20_yuv422p12le_to_rfc4175_422le12_avx2 */
+int st20_yuv422p12le_to_rfc4175_422le12_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_12_pg2_le* pg,
+                                             uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_yuv422p12le_to_422_12_avx2(y, b, r, (uint8_t*)pg, pg_cnt, false);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y += done * 2;
+  b += done;
+  r += done;
+  while (left) {
+    uint16_t cb = *b++;
+    uint16_t y0 = *y++;
+    uint16_t cr = *r++;
+    uint16_t y1 = *y++;
+
+    pg->Cb00 = cb;
+    pg->Cb00_ = cb >> 8;
+    pg->Y00 = y0;
+    pg->Y00_ = y0 >> 4;
+    pg->Cr00 = cr;
+    pg->Cr00_ = cr >> 8;
+    pg->Y01 = y1;
+    pg->Y01_ = y1 >> 4;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_yuv422p12le_to_rfc4175_422le12_avx2 */
+
+/* begin st20_rfc4175_422be12_to_422le12_avx2 */
+/* 8 values from 12 bytes in each lane */
+static uint8_t be12_unpack_shuffle_tbl_256[32] = {
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+};
+
+static uint16_t be12_unpack_mul_tbl_256[16] = {
+    1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16,
+};
+
+static uint8_t le12_unpack_shuffle_tbl_256[32] = {
+    0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+    0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+};
+
+static uint16_t le12_unpack_mul_tbl_256[16] = {
+    16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1,
+};
+
+/*
+ * The 12 bits pgroups of 422 and 444 are the same bits stream of values, 2 values in
+ * each 3 bytes group, convert the groups between be and le.
+ */
+static int st20_12_be_le_avx2(uint8_t* src, uint8_t* dst, int grp_cnt, bool be_to_le) {
+  __m256i shuffle = _mm256_loadu_si256(
+      (__m256i*)(be_to_le ? be12_unpack_shuffle_tbl_256 : le12_unpack_shuffle_tbl_256));
+  __m256i mul = _mm256_loadu_si256(
+      (__m256i*)(be_to_le ? be12_unpack_mul_tbl_256 : le12_unpack_mul_tbl_256));
+  /* (first | second << 12) for le, (first << 12 | second) for be */
+  __m256i madd_mul = be_to_le ? _mm256_set1_epi32(1 | (4096 << 16))
+                              : _mm256_set1_epi32(4096 | (1 << 16));
+
+  /* 8 groups in one batch, each lane loads 16 bytes for 4 groups(12 bytes) */
+  int batch = grp_cnt / 8;
+  /* jump the last batch if no 2 groups left, for the lane may access invalid memory */
+  if (batch && (grp_cnt % 8) < 2) batch--;
+  int left = grp_cnt - batch * 8;
+  dbg("%s, grp_cnt %d batch %d left %d\n", __func__, grp_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i values = st20_avx2_unpack12(st20_avx2_loadu2(src + 12, src), shuffle, mul);
+    __m256i madd = _mm256_madd_epi16(values, madd_mul);
+
+    if (be_to_le)
+      st20_avx2_store_12x2(dst, st20_avx2_pack_le12(madd));
+    else
+      st20_avx2_store_12x2(dst, st20_avx2_pack_be12(madd));
+    src += 24;
+    dst += 24;
+  }
+
+  while (left) {
+    uint16_t v0, v1;
+
+    if (be_to_le) {
+      v0 = (src[0] << 4) | (src[1] >> 4);
+      v1 = ((src[1] & 0xF) << 8) | src[2];
+      dst[0] = v0;
+      dst[1] = (v0 >> 8) | (v1 << 4);
+      dst[2] = v1 >> 4;
+    } else {
+      v0 = src[0] | ((src[1] & 0xF) << 8);
+      v1 = (src[1] >> 4) | (src[2] << 4);
+      dst[0] = v0 >> 4;
+      dst[1] = (v0 << 4) | (v1 >> 8);
+      dst[2] = v1;
+    }
+    src += 3;
+    dst += 3;
+    left--;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be12_to_422le12_avx2(struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 4 values in each pg */
+  return st20_12_be_le_avx2((uint8_t*)pg_be, (uint8_t*)pg_le, pg_cnt * 2, true);
+}
+/* end st20_rfc4175_422be12_to_422le12_avx2 */
+
+/* begin st20_rfc4175_422le12_to_422be12_avx2 */
+int st20_rfc4175_422le12_to_422be12_avx2(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 4 values in each pg */
+  return st20_12_be_le_avx2((uint8_t*)pg_le, (uint8_t*)pg_be, pg_cnt * 2, false);
+}
+/* end st20_rfc4175_422le12_to_422be12_avx2 */
+
+/*
+ * Interleave the B_R, Y_G, R_B planes of 8 pixels in each lane to the 24 values of
+ * pgroups, the value j of the pgroups is from plane (j % 3), index (j / 3).
+ * p444_interleave_shuffle_tbl_128[k][p] picks the values of plane p for values 8k - 8k+7.
+ */
+static uint8_t p444_interleave_shuffle_tbl_128[3][3][16] = {
+    {
+        {/* B_R */
+         0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3,
+         0x80, 0x80, 0x80, 0x80, 4, 5, 0x80, 0x80},
+        {/* Y_G */
+         0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80,
+         2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5},
+        {/* R_B */
+         0x80, 0x80, 0x80, 0x80, 0, 1, 0x80, 0x80,
+         0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80},
+    },
+    {
+        {/* B_R */
+         0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80,
+         8, 9, 0x80, 0x80, 0x80, 0x80, 10, 11},
+        {/* Y_G */
+         0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80,
+         0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80},
+        {/* R_B */
+         4, 5, 0x80, 0x80, 0x80, 0x80, 6, 7,
+         0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80},
+    },
+    {
+        {/* B_R */
+         0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80,
+         0x80, 0x80, 14, 15, 0x80, 0x80, 0x80, 0x80},
+        {/* Y_G */
+         10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13,
+         0x80, 0x80, 0x80, 0x80, 14, 15, 0x80, 0x80},
+        {/* R_B */
+         0x80, 0x80, 10, 11, 0x80, 0x80, 0x80, 0x80,
+         12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15},
+    },
+};
+
+/* the simd part for 10/12 bits be and le, return the number of pixels converted */
+static inline int st20_444p_to_444_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                        uint8_t* pg, int px_cnt, int depth, bool be) {
+  __m256i mask = _mm256_set1_epi16((1 << depth) - 1);
+  /* (first << depth | second) for be, (first | second << depth) for le */
+  __m256i madd_mul = be ? _mm256_set1_epi32((1 << depth) | (1 << 16))
+                        : _mm256_set1_epi32(1 | (1 << (depth + 16)));
+  __m256i shuffle[3][3];
+
+  for (int k = 0; k < 3; k++) {
+    for (int p = 0; p < 3; p++) {
+      shuffle[k][p] = _mm256_broadcastsi128_si256(
+          _mm_loadu_si128((__m128i*)p444_interleave_shuffle_tbl_128[k][p]));
+    }
+  }
+
+  /* 16 pixels in one batch, each lane stores 16 bytes for 8 values(depth bytes) */
+  int batch = px_cnt / 16;
+  /* jump the last batch if no pixel left, for the lane may access invalid memory */
+  if (batch && !(px_cnt % 16)) batch--;
+
+  for (int i = 0; i < batch; i++) {
+    /* pixels 0-7 | pixels 8-15 */
+    __m256i br = _mm256_and_si256(_mm256_loadu_si256((__m256i*)b_r), mask);
+    __m256i yg = _mm256_and_si256(_mm256_loadu_si256((__m256i*)y_g), mask);
+    __m256i rb = _mm256_and_si256(_mm256_loadu_si256((__m256i*)r_b), mask);
+    __m256i result[3];
+
+    for (int k = 0; k < 3; k++) {
+      __m256i values = _mm256_or_si256(
+          _mm256_or_si256(_mm256_shuffle_epi8(br, shuffle[k][0]),
+                          _mm256_shuffle_epi8(yg, shuffle[k][1])),
+          _mm256_shuffle_epi8(rb, shuffle[k][2]));
+      __m256i madd = _mm256_madd_epi16(values, madd_mul);
+
+      if (depth == 10)
+        result[k] = be ? st20_avx2_pack_be10(madd) : st20_avx2_pack_le10(madd);
+      else
+        result[k] = be ? st20_avx2_pack_be12(madd) : st20_avx2_pack_le12(madd);
+    }
+
+    /* store in the address order since each store writes the padding also */
+    for (int k = 0; k < 3; k++)
+      _mm_storeu_si128((__m128i*)(pg + k * depth), _mm256_castsi256_si128(result[k]));
+    for (int k = 0; k < 3; k++)
+      _mm_storeu_si128((__m128i*)(pg + (k + 3) * depth),
+                       _mm256_extracti128_si256(result[k], 1));
+
+    y_g += 16;
+    b_r += 16;
+    r_b += 16;
+    pg += 6 * depth;
+  }
+
+  return batch * 16;
+}
+
+/* begin st20_rfc4175_444be10_to_444p10le_avx2 */
+static uint8_t be10_to_444p10le_shuffle0_tbl_256[32] = {
+    1, 0, 4, 3, 8, 7, 12, 11, /* B_R0 B_R1 B_R2 B_R3 */
+    2, 1, 6, 5, 9, 8, 13, 12, /* Y_G0 Y_G1 Y_G2 Y_G3 */
+    1, 0, 4, 3, 8, 7, 12, 11, /* B_R0 B_R1 B_R2 B_R3 */
+    2, 1, 6, 5, 9, 8, 13, 12, /* Y_G0 Y_G1 Y_G2 Y_G3 */
+};
+
+static uint16_t be10_to_444p10le_mul0_tbl_256[16] = {
+    1, 64, 16, 4, 4, 1, 64, 16, 1, 64, 16, 4, 4, 1, 64, 16,
+};
+
+static uint8_t be10_to_444p10le_shuffle1_tbl_256[32] = {
+    3,    2,    7,    6,    11,   10,   14,   13,   /* R_B0 R_B1 R_B2 R_B3 */
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, /* zeros */
+    3,    2,    7,    6,    11,   10,   14,   13,   /* R_B0 R_B1 R_B2 R_B3 */
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, /* zeros */
+};
+
+static uint16_t be10_to_444p10le_mul1_tbl_256[16] = {
+    16, 4, 1, 64, 0, 0, 0, 0, 16, 4, 1, 64, 0, 0, 0, 0,
+};
+
+static uint8_t le10_to_444p10le_shuffle0_tbl_256[32] = {
+    0, 1, 3, 4, 7, 8, 11, 12, /* B_R0 B_R1 B_R2 B_R3 */
+    1, 2, 5, 6, 8, 9, 12, 13, /* Y_G0 Y_G1 Y_G2 Y_G3 */
+    0, 1, 3, 4, 7, 8, 11, 12, /* B_R0 B_R1 B_R2 B_R3 */
+    1, 2, 5, 6, 8, 9, 12, 13, /* Y_G0 Y_G1 Y_G2 Y_G3 */
+};
+
+static uint16_t le10_to_444p10le_mul0_tbl_256[16] = {
+    64, 1, 4, 16, 16, 64, 1, 4, 64, 1, 4, 16, 16, 64, 1, 4,
+};
+
+static uint8_t le10_to_444p10le_shuffle1_tbl_256[32] = {
+    2,    3,    6,    7,    10,   11,   13,   14,   /* R_B0 R_B1 R_B2 R_B3 */
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, /* zeros */
+    2,    3,    6,    7,    10,   11,   13,   14,   /* R_B0 R_B1 R_B2 R_B3 */
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, /* zeros */
+};
+
+static uint16_t le10_to_444p10le_mul1_tbl_256[16] = {
+    4, 16, 64, 1, 0, 0, 0, 0, 4, 16, 64, 1, 0, 0, 0, 0,
+};
+
+/* the simd part, return the number of pgs converted */
+static inline int st20_444_10_to_444p10le_avx2(uint8_t* pg, uint16_t* y_g, uint16_t* b_r,
+                                               uint16_t* r_b, int pg_cnt, bool be) {
+  uint8_t* shuffle0_tbl =
+      be ? be10_to_444p10le_shuffle0_tbl_256 : le10_to_444p10le_shuffle0_tbl_256;
+  uint16_t* mul0_tbl = be ? be10_to_444p10le_mul0_tbl_256 : le10_to_444p10le_mul0_tbl_256;
+  uint8_t* shuffle1_tbl =
+      be ? be10_to_444p10le_shuffle1_tbl_256 : le10_to_444p10le_shuffle1_tbl_256;
+  uint16_t* mul1_tbl = be ? be10_to_444p10le_mul1_tbl_256 : le10_to_444p10le_mul1_tbl_256;
+  __m256i shuffle0 = _mm256_loadu_si256((__m256i*)shuffle0_tbl);
+  __m256i mul0 = _mm256_loadu_si256((__m256i*)mul0_tbl);
+  __m256i shuffle1 = _mm256_loadu_si256((__m256i*)shuffle1_tbl);
+  __m256i mul1 = _mm256_loadu_si256((__m256i*)mul1_tbl);
+
+  /* 2 pgs in one batch, each lane loads 16 bytes for 1 pg(15 bytes) */
+  int batch = pg_cnt / 2;
+  /* jump the last batch if no pg left, for the lane may access invalid memory */
+  if (batch && !(pg_cnt % 2)) batch--;
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = st20_avx2_loadu2(pg + 15, pg);
+    /* B_R | Y_G of each lane to B_R of pgs 0,1 | Y_G of pgs 0,1 */
+    __m256i br_yg =
+        _mm256_permute4x64_epi64(st20_avx2_unpack10(input, shuffle0, mul0), 0xD8);
+    /* R_B in the low 64 bits of each lane */
+    __m256i rb =
+        _mm256_permute4x64_epi64(st20_avx2_unpack10(input, shuffle1, mul1), 0x08);
+
+    _mm_storeu_si128((__m128i*)b_r, _mm256_castsi256_si128(br_yg));
+    _mm_storeu_si128((__m128i*)y_g, _mm256_extracti128_si256(br_yg, 1));
+    _mm_storeu_si128((__m128i*)r_b, _mm256_castsi256_si128(rb));
+
+    pg += 30;
+    y_g += 8;
+    b_r += 8;
+    r_b += 8;
+  }
+
+  return batch * 2;
+}
+
+int st20_rfc4175_444be10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  int done = st20_444_10_to_444p10le_avx2((uint8_t*)pg, y_g, b_r, r_b, pg_cnt, true);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 4;
+  b_r += done * 4;
+  r_b += done * 4;
+  while (left) {
+    *b_r++ = (pg->Cb_R00 << 2) + pg->Cb_R00_;
+    *y_g++ = (pg->Y_G00 << 4) + pg->Y_G00_;
+    *r_b++ = (pg->Cr_B00 << 6) + pg->Cr_B00_;
+    *b_r++ = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+    *y_g++ = (pg->Y_G01 << 2) + pg->Y_G01_;
+    *r_b++ = (pg->Cr_B01 << 4) + pg->Cr_B01_;
+    *b_r++ = (pg->Cb_R02 << 6) + pg->Cb_R02_;
+    *y_g++ = (pg->Y_G02 << 8) + pg->Y_G02_;
+    *r_b++ = (pg->Cr_B02 << 2) + pg->Cr_B02_;
+    *b_r++ = (pg->Cb_R03 << 4) + pg->Cb_R03_;
+    *y_g++ = (pg->Y_G03 << 6) + pg->Y_G03_;
+    *r_b++ = (pg->Cr_B03 << 8) + pg->Cr_B03_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be10_to_444p10le_avx2 */
+
+/* begin st20_rfc4175_444le10_to_444p10le_avx2 */
+int st20_rfc4175_444le10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_le* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  int done = st20_444_10_to_444p10le_avx2((uint8_t*)pg, y_g, b_r, r_b, pg_cnt, false);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 4;
+  b_r += done * 4;
+  r_b += done * 4;
+  while (left) {
+    *b_r++ = pg->Cb_R00 + (pg->Cb_R00_ << 8);
+    *y_g++ = pg->Y_G00 + (pg->Y_G00_ << 6);
+    *r_b++ = pg->Cr_B00 + (pg->Cr_B00_ << 4);
+    *b_r++ = pg->Cb_R01 + (pg->Cb_R01_ << 2);
+    *y_g++ = pg->Y_G01 + (pg->Y_G01_ << 8);
+    *r_b++ = pg->Cr_B01 + (pg->Cr_B01_ << 6);
+    *b_r++ = pg->Cb_R02 + (pg->Cb_R02_ << 4);
+    *y_g++ = pg->Y_G02 + (pg->Y_G02_ << 2);
+    *r_b++ = pg->Cr_B02 + (pg->Cr_B02_ << 8);
+    *b_r++ = pg->Cb_R03 + (pg->Cb_R03_ << 6);
+    *y_g++ = pg->Y_G03 + (pg->Y_G03_ << 4);
+    *r_b++ = pg->Cr_B03 + (pg->Cr_B03_ << 2);
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444le10_to_444p10le_avx2 */
+
+/* begin st20_444p10le_to_rfc4175_444be10_avx2 */
+int st20_444p10le_to_rfc4175_444be10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  int done = st20_444p_to_444_avx2(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 4, 10, true) / 4;
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 4;
+  b_r += done * 4;
+  r_b += done * 4;
+  while (left) {
+    uint16_t cb_r0 = *b_r++;
+    uint16_t y_g0 = *y_g++;
+    uint16_t cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++;
+    uint16_t y_g1 = *y_g++;
+    uint16_t cr_b1 = *r_b++;
+    uint16_t cb_r2 = *b_r++;
+    uint16_t y_g2 = *y_g++;
+    uint16_t cr_b2 = *r_b++;
+    uint16_t cb_r3 = *b_r++;
+    uint16_t y_g3 = *y_g++;
+    uint16_t cr_b3 = *r_b++;
+
+    pg->Cb_R00 = cb_r0 >> 2;
+    pg->Cb_R00_ = cb_r0;
+    pg->Y_G00 = y_g0 >> 4;
+    pg->Y_G00_ = y_g0;
+    pg->Cr_B00 = cr_b0 >> 6;
+    pg->Cr_B00_ = cr_b0;
+    pg->Cb_R01 = cb_r1 >> 8;
+    pg->Cb_R01_ = cb_r1;
+    pg->Y_G01 = y_g1 >> 2;
+    pg->Y_G01_ = y_g1;
+    pg->Cr_B01 = cr_b1 >> 4;
+    pg->Cr_B01_ = cr_b1;
+    pg->Cb_R02 = cb_r2 >> 6;
+    pg->Cb_R02_ = cb_r2;
+    pg->Y_G02 = y_g2 >> 8;
+    pg->Y_G02_ = y_g2;
+    pg->Cr_B02 = cr_b2 >> 2;
+    pg->Cr_B02_ = cr_b2;
+    pg->Cb_R03 = cb_r3 >> 4;
+    pg->Cb_R03_ = cb_r3;
+    pg->Y_G03 = y_g3 >> 6;
+    pg->Y_G03_ = y_g3;
+    pg->Cr_B03 = cr_b3 >> 8;
+    pg->Cr_B03_ = cr_b3;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p10le_to_rfc4175_444be10_avx2 */
+
+/* begin st20_444p10le_to_rfc4175_444le10_avx2 */
+int st20_444p10le_to_rfc4175_444le10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_le* pg,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  int done =
+      st20_444p_to_444_avx2(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 4, 10, false) / 4;
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 4;
+  b_r += done * 4;
+  r_b += done * 4;
+  while (left) {
+    uint16_t cb_r0 = *b_r++;
+    uint16_t y_g0 = *y_g++;
+    uint16_t cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++;
+    uint16_t y_g1 = *y_g++;
+    uint16_t cr_b1 = *r_b++;
+    uint16_t cb_r2 = *b_r++;
+    uint16_t y_g2 = *y_g++;
+    uint16_t cr_b2 = *r_b++;
+    uint16_t cb_r3 = *b_r++;
+    uint16_t y_g3 = *y_g++;
+    uint16_t cr_b3 = *r_b++;
+
+    pg->Cb_R00 = cb_r0;
+    pg->Cb_R00_ = cb_r0 >> 8;
+    pg->Y_G00 = y_g0;
+    pg->Y_G00_ = y_g0 >> 6;
+    pg->Cr_B00 = cr_b0;
+    pg->Cr_B00_ = cr_b0 >> 4;
+    pg->Cb_R01 = cb_r1;
+    pg->Cb_R01_ = cb_r1 >> 2;
+    pg->Y_G01 = y_g1;
+    pg->Y_G01_ = y_g1 >> 8;
+    pg->Cr_B01 = cr_b1;
+    pg->Cr_B01_ = cr_b1 >> 6;
+    pg->Cb_R02 = cb_r2;
+    pg->Cb_R02_ = cb_r2 >> 4;
+    pg->Y_G02 = y_g2;
+    pg->Y_G02_ = y_g2 >> 2;
+    pg->Cr_B02 = cr_b2;
+    pg->Cr_B02_ = cr_b2 >> 8;
+    pg->Cb_R03 = cb_r3;
+    pg->Cb_R03_ = cb_r3 >> 6;
+    pg->Y_G03 = y_g3;
+    pg->Y_G03_ = y_g3 >> 4;
+    pg->Cr_B03 = cr_b3;
+    pg->Cr_B03_ = cr_b3 >> 2;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p10le_to_rfc4175_444le10_avx2 */
+
+/* begin st20_rfc4175_444be10_to_444le10_avx2 */
+int st20_rfc4175_444be10_to_444le10_avx2(struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                         struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                         uint32_t w, uint32_t h) {
+  /* one 444 pg4 is the same bits stream as three 422 pg2 */
+  int pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422be10_to_422le10_avx2((struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                              (struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                              pg2_cnt * 2, 1);
+}
+/* end st20_rfc4175_444be10_to_444le10_avx2 */
+
+/* begin st20_rfc4175_444le10_to_444be10_avx2 */
+int st20_rfc4175_444le10_to_444be10_avx2(struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                         struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                         uint32_t w, uint32_t h) {
+  /* one 444 pg4 is the same bits stream as three 422 pg2 */
+  int pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422le10_to_422be10_avx2((struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                              (struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                              pg2_cnt * 2, 1);
+}
+/* end st20_rfc4175_444le10_to_444be10_avx2 */
+
+/* begin st20_rfc4175_444be12_to_444p12le_avx2 */
+/* the 6 values of 1 pg in each lane, B_R, Y_G, R_B of 2 pixels in each 32 bits */
+static uint8_t be12_to_444p12le_shuffle_tbl_256[32] = {
+    1,    0,    5,    4,    /* B_R0 B_R1 */
+    2,    1,    7,    6,    /* Y_G0 Y_G1 */
+    4,    3,    8,    7,    /* R_B0 R_B1 */
+    0x80, 0x80, 0x80, 0x80, /* zeros */
+    1,    0,    5,    4,    /* B_R0 B_R1 */
+    2,    1,    7,    6,    /* Y_G0 Y_G1 */
+    4,    3,    8,    7,    /* R_B0 R_B1 */
+    0x80, 0x80, 0x80, 0x80, /* zeros */
+};
+
+static uint16_t be12_to_444p12le_mul_tbl_256[16] = {
+    1, 16, 16, 1, 1, 16, 0, 0, 1, 16, 16, 1, 1, 16, 0, 0,
+};
+
+static uint8_t le12_to_444p12le_shuffle_tbl_256[32] = {
+    0,    1,    4,    5,    /* B_R0 B_R1 */
+    1,    2,    6,    7,    /* Y_G0 Y_G1 */
+    3,    4,    7,    8,    /* R_B0 R_B1 */
+    0x80, 0x80, 0x80, 0x80, /* zeros */
+    0,    1,    4,    5,    /* B_R0 B_R1 */
+    1,    2,    6,    7,    /* Y_G0 Y_G1 */
+    3,    4,    7,    8,    /* R_B0 R_B1 */
+    0x80, 0x80, 0x80, 0x80, /* zeros */
+};
+
+static uint16_t le12_to_444p12le_mul_tbl_256[16] = {
+    16, 1, 1, 16, 16, 1, 0, 0, 16, 1, 1, 16, 16, 1, 0, 0,
+};
+
+/* the simd part, return the number of pgs converted */
+static inline int st20_444_12_to_444p12le_avx2(uint8_t* pg, uint16_t* y_g, uint16_t* b_r,
+                                               uint16_t* r_b, int pg_cnt, bool be) {
+  uint8_t* shuffle_tbl =
+      be ? be12_to_444p12le_shuffle_tbl_256 : le12_to_444p12le_shuffle_tbl_256;
+  uint16_t* mul_tbl = be ? be12_to_444p12le_mul_tbl_256 : le12_to_444p12le_mul_tbl_256;
+  __m256i shuffle = _mm256_loadu_si256((__m256i*)shuffle_tbl);
+  __m256i mul = _mm256_loadu_si256((__m256i*)mul_tbl);
+
+  /* 4 pgs in one batch, each lane loads 16 bytes for 1 pg(9 bytes) */
+  int batch = pg_cnt / 4;
+  /* jump the last batch if no pg left, for the lane may access invalid memory */
+  if (batch && !(pg_cnt % 4)) batch--;
+
+  for (int i = 0; i < batch; i++) {
+    /* pg 0 | pg 2 and pg 1 | pg 3 */
+    __m256i a = st20_avx2_unpack12(st20_avx2_loadu2(pg + 18, pg), shuffle, mul);
+    __m256i c = st20_avx2_unpack12(st20_avx2_loadu2(pg + 27, pg + 9), shuffle, mul);
+    /* B_R of pgs 0,1 | B_R of pgs 2,3 in the low 64 bits, Y_G in the high 64 bits */
+    __m256i br_yg = _mm256_permute4x64_epi64(_mm256_unpacklo_epi32(a, c), 0xD8);
+    /* R_B in the low 64 bits of each lane */
+    __m256i rb = _mm256_permute4x64_epi64(_mm256_unpackhi_epi32(a, c), 0x08);
+
+    _mm_storeu_si128((__m128i*)b_r, _mm256_castsi256_si128(br_yg));
+    _mm_storeu_si128((__m128i*)y_g, _mm256_extracti128_si256(br_yg, 1));
+    _mm_storeu_si128((__m128i*)r_b, _mm256_castsi256_si128(rb));
+
+    pg += 36;
+    y_g += 8;
+    b_r += 8;
+    r_b += 8;
+  }
+
+  return batch * 4;
+}
+
+int st20_rfc4175_444be12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_444_12_to_444p12le_avx2((uint8_t*)pg, y_g, b_r, r_b, pg_cnt, true);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 2;
+  b_r += done * 2;
+  r_b += done * 2;
+  while (left) {
+    *b_r++ = (pg->Cb_R00 << 4) + pg->Cb_R00_;
+    *y_g++ = (pg->Y_G00 << 8) + pg->Y_G00_;
+    *r_b++ = (pg->Cr_B00 << 4) + pg->Cr_B00_;
+    *b_r++ = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+    *y_g++ = (pg->Y_G01 << 4) + pg->Y_G01_;
+    *r_b++ = (pg->Cr_B01 << 8) + pg->Cr_B01_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be12_to_444p12le_avx2 */
+
+/* begin st20_rfc4175_444le12_to_444p12le_avx2 */
+int st20_rfc4175_444le12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_le* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  int done = st20_444_12_to_444p12le_avx2((uint8_t*)pg, y_g, b_r, r_b, pg_cnt, false);
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 2;
+  b_r += done * 2;
+  r_b += done * 2;
+  while (left) {
+    *b_r++ = pg->Cb_R00 + (pg->Cb_R00_ << 8);
+    *y_g++ = pg->Y_G00 + (pg->Y_G00_ << 4);
+    *r_b++ = pg->Cr_B00 + (pg->Cr_B00_ << 8);
+    *b_r++ = pg->Cb_R01 + (pg->Cb_R01_ << 4);
+    *y_g++ = pg->Y_G01 + (pg->Y_G01_ << 8);
+    *r_b++ = pg->Cr_B01 + (pg->Cr_B01_ << 4);
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444le12_to_444p12le_avx2 */
+
+/* begin st20_444p12le_to_rfc4175_444be12_avx2 */
+int st20_444p12le_to_rfc4175_444be12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  int done = st20_444p_to_444_avx2(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 2, 12, true) / 2;
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 2;
+  b_r += done * 2;
+  r_b += done * 2;
+  while (left) {
+    uint16_t cb_r0 = *b_r++;
+    uint16_t y_g0 = *y_g++;
+    uint16_t cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++;
+    uint16_t y_g1 = *y_g++;
+    uint16_t cr_b1 = *r_b++;
+
+    pg->Cb_R00 = cb_r0 >> 4;
+    pg->Cb_R00_ = cb_r0;
+    pg->Y_G00 = y_g0 >> 8;
+    pg->Y_G00_ = y_g0;
+    pg->Cr_B00 = cr_b0 >> 4;
+    pg->Cr_B00_ = cr_b0;
+    pg->Cb_R01 = cb_r1 >> 8;
+    pg->Cb_R01_ = cb_r1;
+    pg->Y_G01 = y_g1 >> 4;
+    pg->Y_G01_ = y_g1;
+    pg->Cr_B01 = cr_b1 >> 8;
+    pg->Cr_B01_ = cr_b1;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p12le_to_rfc4175_444be12_avx2 */
+
+/* begin st20_444p12le_to_rfc4175_444le12_avx2 */
+int st20_444p12le_to_rfc4175_444le12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_le* pg,
+                                          uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  int done =
+      st20_444p_to_444_avx2(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 2, 12, false) / 2;
+  int left = pg_cnt - done;
+  dbg("%s, pg_cnt %d done %d left %d\n", __func__, pg_cnt, done, left);
+
+  pg += done;
+  y_g += done * 2;
+  b_r += done * 2;
+  r_b += done * 2;
+  while (left) {
+    uint16_t cb_r0 = *b_r++;
+    uint16_t y_g0 = *y_g++;
+    uint16_t cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++;
+    uint16_t y_g1 = *y_g++;
+    uint16_t cr_b1 = *r_b++;
+
+    pg->Cb_R00 = cb_r0;
+    pg->Cb_R00_ = cb_r0 >> 8;
+    pg->Y_G00 = y_g0;
+    pg->Y_G00_ = y_g0 >> 4;
+    pg->Cr_B00 = cr_b0;
+    pg->Cr_B00_ = cr_b0 >> 8;
+    pg->Cb_R01 = cb_r1;
+    pg->Cb_R01_ = cb_r1 >> 4;
+    pg->Y_G01 = y_g1;
+    pg->Y_G01_ = y_g1 >> 8;
+    pg->Cr_B01 = cr_b1;
+    pg->Cr_B01_ = cr_b1 >> 4;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p12le_to_rfc4175_444le12_avx2 */
+
+/* begin st20_rfc4175_444be12_to_444le12_avx2 */
+int st20_rfc4175_444be12_to_444le12_avx2(struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                         struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                         uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 6 values in each pg */
+  return st20_12_be_le_avx2((uint8_t*)pg_be, (uint8_t*)pg_le, pg_cnt * 3, true);
+}
+/* end st20_rfc4175_444be12_to_444le12_avx2 */
+
+/* begin st20_rfc4175_444le12_to_444be12_avx2 */
+int st20_rfc4175_444le12_to_444be12_avx2(struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                         struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                         uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 6 values in each pg */
+  return st20_12_be_le_avx2((uint8_t*)pg_le, (uint8_t*)pg_be, pg_cnt * 3, false);
+}
+/* end st20_rfc4175_444le12_to_444be12_avx2 */
+
+/* begin st_color_matrix_avx2 */
+int st_color_matrix_avx2(uint16_t* in0, uint16_t* in1, uint16_t* in2, uint16_t* out0,
+                         uint16_t* out1, uint16_t* out2, uint32_t w,
+                         struct st_color_coefs* coefs) {
+  __m256i in_mask = _mm256_set1_epi16(coefs->in_mask);
+  __m256i in_off0 = _mm256_set1_epi16(coefs->in_off[0]);
+  __m256i in_off1 = _mm256_set1_epi16(coefs->in_off[1]);
+  __m256i in_off2 = _mm256_set1_epi16(coefs->in_off[2]);
+  __m256i max = _mm256_set1_epi16(coefs->max);
+  __m256i zero = _mm256_setzero_si256();
+  __m128i shift = _mm_cvtsi32_si128(coefs->shift);
+  __m256i m01[3], m2[3], add[3];
+  uint16_t* out[3] = {out0, out1, out2};
+
+  for (int k = 0; k < 3; k++) {
+    /* the (in0, in1) pair and the (in2, 0) pair for madd */
+    m01[k] = _mm256_set1_epi32((uint16_t)coefs->m[k][0] |
+                               ((uint32_t)(uint16_t)coefs->m[k][1] << 16));
+    m2[k] = _mm256_set1_epi32((uint16_t)coefs->m[k][2]);
+    add[k] = _mm256_set1_epi32(coefs->add[k]);
+  }
+
+  /* 16 pixels in one batch */
+  int batch = w / 16;
+  int left = w - batch * 16;
+  dbg("%s, w %u batch %d left %d\n", __func__, w, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i v0 = _mm256_and_si256(_mm256_loadu_si256((__m256i*)in0), in_mask);
+    __m256i v1 = _mm256_and_si256(_mm256_loadu_si256((__m256i*)in1), in_mask);
+    __m256i v2 = _mm256_and_si256(_mm256_loadu_si256((__m256i*)in2), in_mask);
+    v0 = _mm256_sub_epi16(v0, in_off0);
+    v1 = _mm256_sub_epi16(v1, in_off1);
+    v2 = _mm256_sub_epi16(v2, in_off2);
+    /* pixels 0-3,8-11 in lo and 4-7,12-15 in hi, packus restores the order */
+    __m256i v01_lo = _mm256_unpacklo_epi16(v0, v1);
+    __m256i v01_hi = _mm256_unpackhi_epi16(v0, v1);
+    __m256i v2_lo = _mm256_unpacklo_epi16(v2, zero);
+    __m256i v2_hi = _mm256_unpackhi_epi16(v2, zero);
+
+    for (int k = 0; k < 3; k++) {
+      __m256i sum_lo = _mm256_add_epi32(_mm256_madd_epi16(v01_lo, m01[k]),
+                                        _mm256_madd_epi16(v2_lo, m2[k]));
+      __m256i sum_hi = _mm256_add_epi32(_mm256_madd_epi16(v01_hi, m01[k]),
+                                        _mm256_madd_epi16(v2_hi, m2[k]));
+      sum_lo = _mm256_sra_epi32(_mm256_add_epi32(sum_lo, add[k]), shift);
+      sum_hi = _mm256_sra_epi32(_mm256_add_epi32(sum_hi, add[k]), shift);
+      /* packus clamps the negative to 0 */
+      __m256i result = _mm256_min_epu16(_mm256_packus_epi32(sum_lo, sum_hi), max);
+      _mm256_storeu_si256((__m256i*)out[k], result);
+      out[k] += 16;
+    }
+
+    in0 += 16;
+    in1 += 16;
+    in2 += 16;
+  }
+
+  while (left) {
+    st_color_coefs_px(coefs, *in0++, *in1++, *in2++, out[0]++, out[1]++, out[2]++);
+    left--;
+  }
+
+  return 0;
+}
+/* end st_color_matrix_avx2 */
 MT_TARGET_CODE_STOP
 #endif
@@ -15,4 +15,120 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
                                          struct st20_rfc4175_422_10_pg2_be* pg_be,
                                          uint32_t w, uint32_t h);
 
-#endif
\ No newline at end of file
+int st20_rfc4175_422be10_to_yuv422p10le_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le10_to_yuv422p10le_avx2(struct st20_rfc4175_422_10_pg2_le* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h);
+
+int st20_yuv422p10le_to_rfc4175_422be10_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint32_t w, uint32_t h);
+
+int st20_yuv422p10le_to_rfc4175_422le10_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_le* pg,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_422le8_avx2(struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_y210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint16_t* pg_y210, uint32_t w, uint32_t h);
+
+int st20_y210_to_rfc4175_422be10_avx2(uint16_t* pg_y210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_v210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint8_t* pg_v210, uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le10_to_v210_avx2(uint8_t* pg_le, uint8_t* pg_v210, uint32_t w,
+                                      uint32_t h);
+
+int st20_v210_to_rfc4175_422be10_avx2(uint8_t* pg_v210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h);
+
+int st20_v210_to_rfc4175_422le10_avx2(uint8_t* pg_v210, uint8_t* pg_le, uint32_t w,
+                                      uint32_t h);
+
+int st20_rfc4175_422be12_to_yuv422p12le_avx2(struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le12_to_yuv422p12le_avx2(struct st20_rfc4175_422_12_pg2_le* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h);
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint32_t w, uint32_t h);
+
+int st20_yuv422p12le_to_rfc4175_422le12_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_12_pg2_le* pg,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be12_to_422le12_avx2(struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le12_to_422be12_avx2(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_le* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p10le_to_rfc4175_444be10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p10le_to_rfc4175_444le10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_le* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_444le10_avx2(struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                         struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                         uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le10_to_444be10_avx2(struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                         struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                         uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_le* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p12le_to_rfc4175_444be12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p12le_to_rfc4175_444le12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_le* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444le12_avx2(struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                         struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                         uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le12_to_444be12_avx2(struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                         struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                         uint32_t w, uint32_t h);
+
+int st_color_matrix_avx2(uint16_t* in0, uint16_t* in1, uint16_t* in2, uint16_t* out0,
+                         uint16_t* out1, uint16_t* out2, uint32_t w,
+                         struct st_color_coefs* coefs);
+
+#endif
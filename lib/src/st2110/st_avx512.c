@@ -2629,5 +2629,545 @@ int st20_rfc4175_422be12_to_yuv422p12le_avx512_dma(
   return 0;
 }
 /* end st20_rfc4175_422be12_to_yuv422p12le_avx512 */
+
+/*
+ * The 422 12bit and 444 10/12bit pgroups are a bits stream of values, the helpers below
+ * convert 32 values between the stream and the 16 bits words of one __m512i, each lane
+ * with 8 values(depth bytes of the stream). All loads and stores are masked, so the
+ * last partial batch goes the same simd way and no scalar tail is needed.
+ */
+/* begin st20_stream_avx512 */
+static uint16_t stream10_lane_idx_tbl_512[32] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  /* words 0 - 4 to lane 0 */
+    5,  6,  7,  8,  9,  10, 11, 12, /* words 5 - 9 to lane 1 */
+    10, 11, 12, 13, 14, 15, 16, 17, /* words 10 - 14 to lane 2 */
+    15, 16, 17, 18, 19, 20, 21, 22, /* words 15 - 19 to lane 3 */
+};
+
+static uint16_t stream12_lane_idx_tbl_512[32] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  /* words 0 - 5 to lane 0 */
+    6,  7,  8,  9,  10, 11, 12, 13, /* words 6 - 11 to lane 1 */
+    12, 13, 14, 15, 16, 17, 18, 19, /* words 12 - 17 to lane 2 */
+    18, 19, 20, 21, 22, 23, 24, 25, /* words 18 - 23 to lane 3 */
+};
+
+/* the two bytes of each value, then shift right to the low bits */
+static uint8_t be10_stream_unpack_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8,
+};
+
+static uint16_t be10_stream_unpack_srlv_tbl_128[8] = {
+    6, 4, 2, 0, 6, 4, 2, 0,
+};
+
+static uint8_t le10_stream_unpack_shuffle_tbl_128[16] = {
+    0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9,
+};
+
+static uint16_t le10_stream_unpack_srlv_tbl_128[8] = {
+    0, 2, 4, 6, 0, 2, 4, 6,
+};
+
+static uint8_t be12_stream_unpack_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+};
+
+static uint16_t be12_stream_unpack_srlv_tbl_128[8] = {
+    4, 0, 4, 0, 4, 0, 4, 0,
+};
+
+static uint8_t le12_stream_unpack_shuffle_tbl_128[16] = {
+    0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+};
+
+static uint16_t le12_stream_unpack_srlv_tbl_128[8] = {
+    0, 4, 0, 4, 0, 4, 0, 4,
+};
+
+/* the 40 bits in each 64 bits to 5 bytes for 10bit, 24 bits in each 32 bits for 12bit */
+static uint8_t be10_stream_pack_shuffle_tbl_128[16] = {
+    4, 3, 2, 1, 0, 12, 11, 10, 9, 8, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+static uint8_t le10_stream_pack_shuffle_tbl_128[16] = {
+    0, 1, 2, 3, 4, 8, 9, 10, 11, 12, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+static uint8_t be12_stream_pack_shuffle_tbl_128[16] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0x80, 0x80, 0x80, 0x80,
+};
+
+static uint8_t le12_stream_pack_shuffle_tbl_128[16] = {
+    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 0x80, 0x80, 0x80, 0x80,
+};
+
+/* the packed bytes of the 4 lanes to the head */
+static uint16_t stream10_compact_idx_tbl_512[32] = {
+    0,  1,  2,  3,  4,  8,  9,  10, 11, 12, /* lane 0, 1 */
+    16, 17, 18, 19, 20, 24, 25, 26, 27, 28, /* lane 2, 3 */
+};
+
+static uint16_t stream12_compact_idx_tbl_512[32] = {
+    0,  1,  2,  3,  4,  5,  8,  9,  10, 11, 12, 13, /* lane 0, 1 */
+    16, 17, 18, 19, 20, 21, 24, 25, 26, 27, 28, 29, /* lane 2, 3 */
+};
+
+struct st20_stream_avx512 {
+  int depth;
+  bool be;
+  __m512i mask;
+  __m512i lane_idx;
+  __m512i unpack_shuffle;
+  __m512i unpack_srlv;
+  __m512i madd_mul;
+  __m512i pack_shuffle;
+  __m512i compact_idx;
+};
+
+static void st20_stream_avx512_init(struct st20_stream_avx512* s, int depth, bool be) {
+  uint8_t* unpack_shuffle;
+  uint16_t* unpack_srlv;
+  uint8_t* pack_shuffle;
+
+  if (depth == 10) {
+    unpack_shuffle =
+        be ? be10_stream_unpack_shuffle_tbl_128 : le10_stream_unpack_shuffle_tbl_128;
+    unpack_srlv = be ? be10_stream_unpack_srlv_tbl_128 : le10_stream_unpack_srlv_tbl_128;
+    pack_shuffle =
+        be ? be10_stream_pack_shuffle_tbl_128 : le10_stream_pack_shuffle_tbl_128;
+    s->lane_idx = _mm512_loadu_si512((__m512i*)stream10_lane_idx_tbl_512);
+    s->compact_idx = _mm512_loadu_si512((__m512i*)stream10_compact_idx_tbl_512);
+  } else {
+    unpack_shuffle =
+        be ? be12_stream_unpack_shuffle_tbl_128 : le12_stream_unpack_shuffle_tbl_128;
+    unpack_srlv = be ? be12_stream_unpack_srlv_tbl_128 : le12_stream_unpack_srlv_tbl_128;
+    pack_shuffle =
+        be ? be12_stream_pack_shuffle_tbl_128 : le12_stream_pack_shuffle_tbl_128;
+    s->lane_idx = _mm512_loadu_si512((__m512i*)stream12_lane_idx_tbl_512);
+    s->compact_idx = _mm512_loadu_si512((__m512i*)stream12_compact_idx_tbl_512);
+  }
+
+  s->depth = depth;
+  s->be = be;
+  s->mask = _mm512_set1_epi16((1 << depth) - 1);
+  s->unpack_shuffle = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)unpack_shuffle));
+  s->unpack_srlv = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)unpack_srlv));
+  /* (first << depth | second) for be, (first | second << depth) for le */
+  s->madd_mul = be ? _mm512_set1_epi32((1 << depth) | (1 << 16))
+                   : _mm512_set1_epi32(1 | (1 << (depth + 16)));
+  s->pack_shuffle = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)pack_shuffle));
+}
+
+/* the mask of the first n items, n can be out of 0 - 64 */
+static inline __mmask64 st20_avx512_mask(int n) {
+  if (n <= 0) return 0;
+  if (n >= 64) return ~0ULL;
+  return (1ULL << n) - 1;
+}
+
+/* unpack 32 values from the first n(up to depth * 4) bytes of src */
+static inline __m512i st20_stream_unpack_avx512(struct st20_stream_avx512* s,
+                                                uint8_t* src, int n) {
+  __m512i input = _mm512_maskz_loadu_epi8(st20_avx512_mask(n), src);
+  __m512i lanes = _mm512_permutexvar_epi16(s->lane_idx, input);
+  __m512i words = _mm512_shuffle_epi8(lanes, s->unpack_shuffle);
+  return _mm512_and_si512(_mm512_srlv_epi16(words, s->unpack_srlv), s->mask);
+}
+
+/* pack 32 values and store the first n(up to depth * 4) bytes to dst */
+static inline void st20_stream_pack_avx512(struct st20_stream_avx512* s, __m512i values,
+                                           uint8_t* dst, int n) {
+  __m512i madd = _mm512_madd_epi16(_mm512_and_si512(values, s->mask), s->madd_mul);
+
+  if (s->depth == 10) { /* the two 20 bits in each 64 bits to 40 bits */
+    if (s->be)
+      madd = _mm512_ternarylogic_epi64(_mm512_slli_epi64(madd, 20),
+                                       _mm512_set1_epi64(0xFFFFFFFFFF),
+                                       _mm512_srli_epi64(madd, 32), 0xEA);
+    else
+      madd = _mm512_ternarylogic_epi64(madd, _mm512_set1_epi64(0xFFFFF),
+                                       _mm512_srli_epi64(madd, 12), 0xE2);
+  }
+
+  __m512i bytes = _mm512_shuffle_epi8(madd, s->pack_shuffle);
+  bytes = _mm512_permutexvar_epi16(s->compact_idx, bytes);
+  _mm512_mask_storeu_epi8(dst, st20_avx512_mask(n), bytes);
+}
+
+/* Y of the 64 values of 16 pgs, {Cb, Y0, Cr, Y1} in each pg */
+static uint16_t p422_y_idx_tbl_512[32] = {
+    1,  3,  5,  7,  9,  11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+    33, 35, 37, 39, 41, 43, 45, 47, 49, 51, 53, 55, 57, 59, 61, 63,
+};
+
+/* Cb in the low 256 bits and Cr in the high 256 bits */
+static uint16_t p422_cbcr_idx_tbl_512[32] = {
+    0, 4, 8,  12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60,
+    2, 6, 10, 14, 18, 22, 26, 30, 34, 38, 42, 46, 50, 54, 58, 62,
+};
+
+/* the values 0 - 31 and 32 - 63 of 16 pgs from {Cb, Cr}(0 - 31) and Y(32 - 63) */
+static uint16_t p422_interleave_idx_tbl_512[2][32] = {
+    {0, 32, 16, 33, 1, 34, 17, 35, 2, 36, 18, 37, 3, 38, 19, 39,
+     4, 40, 20, 41, 5, 42, 21, 43, 6, 44, 22, 45, 7, 46, 23, 47},
+    {8,  48, 24, 49, 9,  50, 25, 51, 10, 52, 26, 53, 11, 54, 27, 55,
+     12, 56, 28, 57, 13, 58, 29, 59, 14, 60, 30, 61, 15, 62, 31, 63},
+};
+
+/*
+ * The value j of the 96 values of 32 pixels is from plane (j % 3) of B_R, Y_G, R_B.
+ * p444_plane_idx_tbl_512[p] picks plane p from the values 0 - 63, the lanes in
+ * p444_plane_mask[p] are picked from the values 64 - 95 with the same index.
+ */
+static uint16_t p444_plane_idx_tbl_512[3][32] = {
+    {0,  3,  6,  9,  12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45,
+     48, 51, 54, 57, 60, 63, 2,  5,  8,  11, 14, 17, 20, 23, 26, 29},
+    {1,  4,  7,  10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+     49, 52, 55, 58, 61, 0,  3,  6,  9,  12, 15, 18, 21, 24, 27, 30},
+    {2,  5,  8,  11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47,
+     50, 53, 56, 59, 62, 1,  4,  7,  10, 13, 16, 19, 22, 25, 28, 31},
+};
+
+static __mmask32 p444_plane_mask[3] = {0xFFC00000, 0xFFE00000, 0xFFE00000};
+
+/*
+ * p444_interleave_idx_tbl_512[k] picks the values 32k - 32k+31 from B_R(0 - 31) and
+ * Y_G(32 - 63), the lanes in p444_interleave_mask[k] are picked from R_B.
+ */
+static uint16_t p444_interleave_idx_tbl_512[3][32] = {
+    {0, 32, 0, 1, 33, 1, 2, 34, 2, 3, 35, 3, 4, 36, 4, 5,
+     37, 5, 6, 38, 6, 7, 39, 7, 8, 40, 8, 9, 41, 9, 10, 42},
+    {10, 11, 43, 11, 12, 44, 12, 13, 45, 13, 14, 46, 14, 15, 47, 15,
+     16, 48, 16, 17, 49, 17, 18, 50, 18, 19, 51, 19, 20, 52, 20, 21},
+    {53, 21, 22, 54, 22, 23, 55, 23, 24, 56, 24, 25, 57, 25, 26, 58,
+     26, 27, 59, 27, 28, 60, 28, 29, 61, 29, 30, 62, 30, 31, 63, 31},
+};
+
+static __mmask32 p444_interleave_mask[3] = {0x24924924, 0x49249249, 0x92492492};
+/* end st20_stream_avx512 */
+
+/* begin st20_rfc4175_422le12_to_yuv422p12le_avx512 */
+static int st20_422_12_to_yuv422p12le_avx512(uint8_t* pg, uint16_t* y, uint16_t* b,
+                                             uint16_t* r, int pg_cnt, bool be) {
+  __m512i y_idx = _mm512_loadu_si512((__m512i*)p422_y_idx_tbl_512);
+  __m512i cbcr_idx = _mm512_loadu_si512((__m512i*)p422_cbcr_idx_tbl_512);
+  struct st20_stream_avx512 s;
+
+  st20_stream_avx512_init(&s, 12, be);
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  /* 16 pgs(96 bytes) in one batch, the last batch with the left pgs */
+  while (pg_cnt > 0) {
+    int cnt = RTE_MIN(pg_cnt, 16);
+    int bytes = cnt * 6;
+    __m512i values0 = st20_stream_unpack_avx512(&s, pg, bytes);
+    __m512i values1 = st20_stream_unpack_avx512(&s, pg + 48, bytes - 48);
+    __m512i y_result = _mm512_permutex2var_epi16(values0, y_idx, values1);
+    __m512i cbcr_result = _mm512_permutex2var_epi16(values0, cbcr_idx, values1);
+    __mmask16 k = st20_avx512_mask(cnt);
+
+    _mm512_mask_storeu_epi16(y, st20_avx512_mask(cnt * 2), y_result);
+    _mm256_mask_storeu_epi16(b, k, _mm512_castsi512_si256(cbcr_result));
+    _mm256_mask_storeu_epi16(r, k, _mm512_extracti64x4_epi64(cbcr_result, 1));
+
+    pg += 96;
+    y += 32;
+    b += 16;
+    r += 16;
+    pg_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422le12_to_yuv422p12le_avx512(struct st20_rfc4175_422_12_pg2_le* pg,
+                                               uint16_t* y, uint16_t* b, uint16_t* r,
+                                               uint32_t w, uint32_t h) {
+  return st20_422_12_to_yuv422p12le_avx512((uint8_t*)pg, y, b, r, w * h / 2, false);
+}
+/* end st20_rfc4175_422le12_to_yuv422p12le_avx512 */
+
+/* begin st20_yuv422p12le_to_rfc4175_422be12_avx512 */
+static int st20_yuv422p12le_to_422_12_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint8_t* pg, int pg_cnt, bool be) {
+  __m512i interleave0 = _mm512_loadu_si512((__m512i*)p422_interleave_idx_tbl_512[0]);
+  __m512i interleave1 = _mm512_loadu_si512((__m512i*)p422_interleave_idx_tbl_512[1]);
+  struct st20_stream_avx512 s;
+
+  st20_stream_avx512_init(&s, 12, be);
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  /* 16 pgs(96 bytes) in one batch, the last batch with the left pgs */
+  while (pg_cnt > 0) {
+    int cnt = RTE_MIN(pg_cnt, 16);
+    int bytes = cnt * 6;
+    __mmask16 k = st20_avx512_mask(cnt);
+    __m512i y_input = _mm512_maskz_loadu_epi16(st20_avx512_mask(cnt * 2), y);
+    __m256i b_input = _mm256_maskz_loadu_epi16(k, b);
+    __m256i r_input = _mm256_maskz_loadu_epi16(k, r);
+    __m512i cbcr = _mm512_inserti64x4(_mm512_castsi256_si512(b_input), r_input, 1);
+
+    st20_stream_pack_avx512(&s, _mm512_permutex2var_epi16(cbcr, interleave0, y_input),
+                            pg, bytes);
+    st20_stream_pack_avx512(&s, _mm512_permutex2var_epi16(cbcr, interleave1, y_input),
+                            pg + 48, bytes - 48);
+
+    y += 32;
+    b += 16;
+    r += 16;
+    pg += 96;
+    pg_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_12_pg2_be* pg,
+                                               uint32_t w, uint32_t h) {
+  return st20_yuv422p12le_to_422_12_avx512(y, b, r, (uint8_t*)pg, w * h / 2, true);
+}
+/* end st20_yuv422p12le_to_rfc4175_422be12_avx512 */
+
+/* begin st20_yuv422p12le_to_rfc4175_422le12_avx512 */
+int st20_yuv422p12le_to_rfc4175_422le12_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_12_pg2_le* pg,
+                                               uint32_t w, uint32_t h) {
+  return st20_yuv422p12le_to_422_12_avx512(y, b, r, (uint8_t*)pg, w * h / 2, false);
+}
+/* end st20_yuv422p12le_to_rfc4175_422le12_avx512 */
+
+/* begin st20_rfc4175_422le12_to_422be12_avx512 */
+/* the 12 bits pgroups of 422 and 444 are the same bits stream, 2 values in 3 bytes */
+static int st20_12_be_le_avx512(uint8_t* src, uint8_t* dst, int grp_cnt, bool be_to_le) {
+  struct st20_stream_avx512 in, out;
+
+  st20_stream_avx512_init(&in, 12, be_to_le);
+  st20_stream_avx512_init(&out, 12, !be_to_le);
+  dbg("%s, grp_cnt %d\n", __func__, grp_cnt);
+
+  /* 16 groups(48 bytes) in one batch, the last batch with the left groups */
+  while (grp_cnt > 0) {
+    int cnt = RTE_MIN(grp_cnt, 16);
+    int bytes = cnt * 3;
+
+    st20_stream_pack_avx512(&out, st20_stream_unpack_avx512(&in, src, bytes), dst, bytes);
+
+    src += 48;
+    dst += 48;
+    grp_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422le12_to_422be12_avx512(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                           struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                           uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 4 values in each pg */
+  return st20_12_be_le_avx512((uint8_t*)pg_le, (uint8_t*)pg_be, pg_cnt * 2, false);
+}
+/* end st20_rfc4175_422le12_to_422be12_avx512 */
+
+/* begin st20_rfc4175_444be10_to_444p10le_avx512 */
+/* the 10/12 bits 444 pgroups to planes, px_cnt of whole pgs */
+static int st20_444_to_444p_avx512(uint8_t* pg, uint16_t* y_g, uint16_t* b_r,
+                                   uint16_t* r_b, int px_cnt, int depth, bool be) {
+  uint16_t* planes[3] = {b_r, y_g, r_b};
+  int zmm_bytes = depth * 4; /* 32 values */
+  __m512i plane_idx[3];
+  struct st20_stream_avx512 s;
+
+  for (int p = 0; p < 3; p++)
+    plane_idx[p] = _mm512_loadu_si512((__m512i*)p444_plane_idx_tbl_512[p]);
+  st20_stream_avx512_init(&s, depth, be);
+  dbg("%s, px_cnt %d depth %d\n", __func__, px_cnt, depth);
+
+  /* 32 pixels(96 values) in one batch, the last batch with the left pixels */
+  while (px_cnt > 0) {
+    int cnt = RTE_MIN(px_cnt, 32);
+    int bytes = cnt * 3 * depth / 8;
+    __mmask32 k = st20_avx512_mask(cnt);
+    __m512i values[3];
+
+    for (int i = 0; i < 3; i++)
+      values[i] =
+          st20_stream_unpack_avx512(&s, pg + i * zmm_bytes, bytes - i * zmm_bytes);
+    for (int p = 0; p < 3; p++) {
+      __m512i result = _mm512_permutex2var_epi16(values[0], plane_idx[p], values[1]);
+      result = _mm512_mask_permutexvar_epi16(result, p444_plane_mask[p], plane_idx[p],
+                                             values[2]);
+      _mm512_mask_storeu_epi16(planes[p], k, result);
+      planes[p] += 32;
+    }
+
+    pg += 3 * zmm_bytes;
+    px_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_444be10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444_to_444p_avx512((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 4, 10, true);
+}
+/* end st20_rfc4175_444be10_to_444p10le_avx512 */
+
+/* begin st20_rfc4175_444le10_to_444p10le_avx512 */
+int st20_rfc4175_444le10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_le* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444_to_444p_avx512((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 4, 10, false);
+}
+/* end st20_rfc4175_444le10_to_444p10le_avx512 */
+
+/* begin st20_444p10le_to_rfc4175_444be10_avx512 */
+/* the planes to 10/12 bits 444 pgroups, px_cnt of whole pgs */
+static int st20_444p_to_444_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                   uint8_t* pg, int px_cnt, int depth, bool be) {
+  int zmm_bytes = depth * 4; /* 32 values */
+  __m512i interleave_idx[3];
+  struct st20_stream_avx512 s;
+
+  for (int i = 0; i < 3; i++)
+    interleave_idx[i] = _mm512_loadu_si512((__m512i*)p444_interleave_idx_tbl_512[i]);
+  st20_stream_avx512_init(&s, depth, be);
+  dbg("%s, px_cnt %d depth %d\n", __func__, px_cnt, depth);
+
+  /* 32 pixels(96 values) in one batch, the last batch with the left pixels */
+  while (px_cnt > 0) {
+    int cnt = RTE_MIN(px_cnt, 32);
+    int bytes = cnt * 3 * depth / 8;
+    __mmask32 k = st20_avx512_mask(cnt);
+    __m512i br = _mm512_maskz_loadu_epi16(k, b_r);
+    __m512i yg = _mm512_maskz_loadu_epi16(k, y_g);
+    __m512i rb = _mm512_maskz_loadu_epi16(k, r_b);
+
+    for (int i = 0; i < 3; i++) {
+      __m512i values = _mm512_permutex2var_epi16(br, interleave_idx[i], yg);
+      values = _mm512_mask_permutexvar_epi16(values, p444_interleave_mask[i],
+                                             interleave_idx[i], rb);
+      st20_stream_pack_avx512(&s, values, pg + i * zmm_bytes, bytes - i * zmm_bytes);
+    }
+
+    y_g += 32;
+    b_r += 32;
+    r_b += 32;
+    pg += 3 * zmm_bytes;
+    px_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_444p10le_to_rfc4175_444be10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444p_to_444_avx512(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 4, 10, true);
+}
+/* end st20_444p10le_to_rfc4175_444be10_avx512 */
+
+/* begin st20_444p10le_to_rfc4175_444le10_avx512 */
+int st20_444p10le_to_rfc4175_444le10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_le* pg,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444p_to_444_avx512(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 4, 10, false);
+}
+/* end st20_444p10le_to_rfc4175_444le10_avx512 */
+
+/* begin st20_rfc4175_444be10_to_444le10_avx512 */
+int st20_rfc4175_444be10_to_444le10_avx512(struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                           struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                           uint32_t w, uint32_t h) {
+  /* one 444 pg4 is the same bits stream as three 422 pg2 */
+  int pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422be10_to_422le10_avx512((struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                                (struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                                pg2_cnt * 2, 1);
+}
+/* end st20_rfc4175_444be10_to_444le10_avx512 */
+
+/* begin st20_rfc4175_444le10_to_444be10_avx512 */
+int st20_rfc4175_444le10_to_444be10_avx512(struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                           struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                           uint32_t w, uint32_t h) {
+  /* one 444 pg4 is the same bits stream as three 422 pg2 */
+  int pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422le10_to_422be10_avx512((struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                                (struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                                pg2_cnt * 2, 1);
+}
+/* end st20_rfc4175_444le10_to_444be10_avx512 */
+
+/* begin st20_rfc4175_444be12_to_444p12le_avx512 */
+int st20_rfc4175_444be12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444_to_444p_avx512((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 2, 12, true);
+}
+/* end st20_rfc4175_444be12_to_444p12le_avx512 */
+
+/* begin st20_rfc4175_444le12_to_444p12le_avx512 */
+int st20_rfc4175_444le12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_le* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444_to_444p_avx512((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 2, 12, false);
+}
+/* end st20_rfc4175_444le12_to_444p12le_avx512 */
+
+/* begin st20_444p12le_to_rfc4175_444be12_avx512 */
+int st20_444p12le_to_rfc4175_444be12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444p_to_444_avx512(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 2, 12, true);
+}
+/* end st20_444p12le_to_rfc4175_444be12_avx512 */
+
+/* begin st20_444p12le_to_rfc4175_444le12_avx512 */
+int st20_444p12le_to_rfc4175_444le12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_le* pg,
+                                            uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444p_to_444_avx512(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 2, 12, false);
+}
+/* end st20_444p12le_to_rfc4175_444le12_avx512 */
+
+/* begin st20_rfc4175_444be12_to_444le12_avx512 */
+int st20_rfc4175_444be12_to_444le12_avx512(struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                           struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                           uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 6 values in each pg */
+  return st20_12_be_le_avx512((uint8_t*)pg_be, (uint8_t*)pg_le, pg_cnt * 3, true);
+}
+/* end st20_rfc4175_444be12_to_444le12_avx512 */
+
+/* begin st20_rfc4175_444le12_to_444be12_avx512 */
+int st20_rfc4175_444le12_to_444be12_avx512(struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                           struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                           uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 6 values in each pg */
+  return st20_12_be_le_avx512((uint8_t*)pg_le, (uint8_t*)pg_be, pg_cnt * 3, false);
+}
+/* end st20_rfc4175_444le12_to_444be12_avx512 */
 MT_TARGET_CODE_STOP
 #endif
@@ -111,4 +111,68 @@ int st20_rfc4175_422be12_to_yuv422p12le_avx512_dma(
     struct mtl_dma_lender_dev* dma, struct st20_rfc4175_422_12_pg2_be* pg_be,
     mtl_iova_t pg_be_iova, uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w, uint32_t h);
 
-#endif
\ No newline at end of file
+int st20_rfc4175_422le12_to_yuv422p12le_avx512(struct st20_rfc4175_422_12_pg2_le* pg,
+                                               uint16_t* y, uint16_t* b, uint16_t* r,
+                                               uint32_t w, uint32_t h);
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_12_pg2_be* pg,
+                                               uint32_t w, uint32_t h);
+
+int st20_yuv422p12le_to_rfc4175_422le12_avx512(uint16_t* y, uint16_t* b, uint16_t* r,
+                                               struct st20_rfc4175_422_12_pg2_le* pg,
+                                               uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le12_to_422be12_avx512(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                           struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                           uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_le* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_444p10le_to_rfc4175_444be10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_444p10le_to_rfc4175_444le10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_le* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_444le10_avx512(struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                           struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                           uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le10_to_444be10_avx512(struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                           struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                           uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_le* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_444p12le_to_rfc4175_444be12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_444p12le_to_rfc4175_444le12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_le* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444le12_avx512(struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                           struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                           uint32_t w, uint32_t h);
+
+int st20_rfc4175_444le12_to_444be12_avx512(struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                           struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                           uint32_t w, uint32_t h);
+
+#endif
@@ -1933,5 +1933,554 @@ int st20_rfc4175_422be12_to_yuv422p12le_avx512_vbmi_dma(
   return 0;
 }
 /* end st20_rfc4175_422be12_to_yuv422p12le_avx512_vbmi */
+
+/*
+ * The 422 12bit and 444 10/12bit pgroups are a bits stream of values, the helpers below
+ * convert 32 values between the stream and the 16 bits words of one __m512i with the
+ * byte permutes. All loads and stores are masked, so the last partial batch goes the
+ * same simd way and no scalar tail is needed.
+ */
+/* begin st20_stream_avx512_vbmi */
+/* the two bytes of each value from the 40 bytes of 32 values */
+static uint8_t be10_stream_unpack_permute_tbl_512[16 * 4] = {
+    1,  0,  2,  1,  3,  2,  4,  3,  6,  5,  7,  6,  8,  7,  9,  8,  /* 0 - 7 */
+    11, 10, 12, 11, 13, 12, 14, 13, 16, 15, 17, 16, 18, 17, 19, 18, /* 8 - 15 */
+    21, 20, 22, 21, 23, 22, 24, 23, 26, 25, 27, 26, 28, 27, 29, 28, /* 16 - 23 */
+    31, 30, 32, 31, 33, 32, 34, 33, 36, 35, 37, 36, 38, 37, 39, 38, /* 24 - 31 */
+};
+
+static uint8_t le10_stream_unpack_permute_tbl_512[16 * 4] = {
+    0,  1,  1,  2,  2,  3,  3,  4,  5,  6,  6,  7,  7,  8,  8,  9,  /* 0 - 7 */
+    10, 11, 11, 12, 12, 13, 13, 14, 15, 16, 16, 17, 17, 18, 18, 19, /* 8 - 15 */
+    20, 21, 21, 22, 22, 23, 23, 24, 25, 26, 26, 27, 27, 28, 28, 29, /* 16 - 23 */
+    30, 31, 31, 32, 32, 33, 33, 34, 35, 36, 36, 37, 37, 38, 38, 39, /* 24 - 31 */
+};
+
+/* the two bytes of each value from the 48 bytes of 32 values */
+static uint8_t be12_stream_unpack_permute_tbl_512[16 * 4] = {
+    1,  0,  2,  1,  4,  3,  5,  4,  7,  6,  8,  7,  10, 9,  11, 10, /* 0 - 7 */
+    13, 12, 14, 13, 16, 15, 17, 16, 19, 18, 20, 19, 22, 21, 23, 22, /* 8 - 15 */
+    25, 24, 26, 25, 28, 27, 29, 28, 31, 30, 32, 31, 34, 33, 35, 34, /* 16 - 23 */
+    37, 36, 38, 37, 40, 39, 41, 40, 43, 42, 44, 43, 46, 45, 47, 46, /* 24 - 31 */
+};
+
+static uint8_t le12_stream_unpack_permute_tbl_512[16 * 4] = {
+    0,  1,  1,  2,  3,  4,  4,  5,  6,  7,  7,  8,  9,  10, 10, 11, /* 0 - 7 */
+    12, 13, 13, 14, 15, 16, 16, 17, 18, 19, 19, 20, 21, 22, 22, 23, /* 8 - 15 */
+    24, 25, 25, 26, 27, 28, 28, 29, 30, 31, 31, 32, 33, 34, 34, 35, /* 16 - 23 */
+    36, 37, 37, 38, 39, 40, 40, 41, 42, 43, 43, 44, 45, 46, 46, 47, /* 24 - 31 */
+};
+
+/* shift right the words to the low bits */
+static uint16_t be10_stream_unpack_srlv_tbl_128[8] = {
+    6, 4, 2, 0, 6, 4, 2, 0,
+};
+
+static uint16_t le10_stream_unpack_srlv_tbl_128[8] = {
+    0, 2, 4, 6, 0, 2, 4, 6,
+};
+
+static uint16_t be12_stream_unpack_srlv_tbl_128[8] = {
+    4, 0, 4, 0, 4, 0, 4, 0,
+};
+
+static uint16_t le12_stream_unpack_srlv_tbl_128[8] = {
+    0, 4, 0, 4, 0, 4, 0, 4,
+};
+
+/* the 5 bytes of the 40 bits in each 64 bits to the head, 40 bytes of 32 values */
+static uint8_t be10_stream_pack_permute_tbl_512[16 * 4] = {
+    4,  3,  2,  1,  0,  12, 11, 10, 9,  8,  /* 0 - 7 */
+    20, 19, 18, 17, 16, 28, 27, 26, 25, 24, /* 8 - 15 */
+    36, 35, 34, 33, 32, 44, 43, 42, 41, 40, /* 16 - 23 */
+    52, 51, 50, 49, 48, 60, 59, 58, 57, 56, /* 24 - 31 */
+};
+
+static uint8_t le10_stream_pack_permute_tbl_512[16 * 4] = {
+    0,  1,  2,  3,  4,  8,  9,  10, 11, 12, /* 0 - 7 */
+    16, 17, 18, 19, 20, 24, 25, 26, 27, 28, /* 8 - 15 */
+    32, 33, 34, 35, 36, 40, 41, 42, 43, 44, /* 16 - 23 */
+    48, 49, 50, 51, 52, 56, 57, 58, 59, 60, /* 24 - 31 */
+};
+
+/* the 3 bytes of the 24 bits in each 32 bits to the head, 48 bytes of 32 values */
+static uint8_t be12_stream_pack_permute_tbl_512[16 * 4] = {
+    2,  1,  0,  6,  5,  4,  10, 9,  8,  14, 13, 12, /* 0 - 7 */
+    18, 17, 16, 22, 21, 20, 26, 25, 24, 30, 29, 28, /* 8 - 15 */
+    34, 33, 32, 38, 37, 36, 42, 41, 40, 46, 45, 44, /* 16 - 23 */
+    50, 49, 48, 54, 53, 52, 58, 57, 56, 62, 61, 60, /* 24 - 31 */
+};
+
+static uint8_t le12_stream_pack_permute_tbl_512[16 * 4] = {
+    0,  1,  2,  4,  5,  6,  8,  9,  10, 12, 13, 14, /* 0 - 7 */
+    16, 17, 18, 20, 21, 22, 24, 25, 26, 28, 29, 30, /* 8 - 15 */
+    32, 33, 34, 36, 37, 38, 40, 41, 42, 44, 45, 46, /* 16 - 23 */
+    48, 49, 50, 52, 53, 54, 56, 57, 58, 60, 61, 62, /* 24 - 31 */
+};
+
+struct st20_stream_avx512_vbmi {
+  int depth;
+  bool be;
+  __m512i mask;
+  __m512i unpack_permute;
+  __m512i unpack_srlv;
+  __m512i madd_mul;
+  __m512i pack_permute;
+};
+
+static void st20_stream_avx512_vbmi_init(struct st20_stream_avx512_vbmi* s, int depth,
+                                         bool be) {
+  uint8_t* unpack_permute;
+  uint16_t* unpack_srlv;
+  uint8_t* pack_permute;
+
+  if (depth == 10) {
+    unpack_permute =
+        be ? be10_stream_unpack_permute_tbl_512 : le10_stream_unpack_permute_tbl_512;
+    unpack_srlv = be ? be10_stream_unpack_srlv_tbl_128 : le10_stream_unpack_srlv_tbl_128;
+    pack_permute =
+        be ? be10_stream_pack_permute_tbl_512 : le10_stream_pack_permute_tbl_512;
+  } else {
+    unpack_permute =
+        be ? be12_stream_unpack_permute_tbl_512 : le12_stream_unpack_permute_tbl_512;
+    unpack_srlv = be ? be12_stream_unpack_srlv_tbl_128 : le12_stream_unpack_srlv_tbl_128;
+    pack_permute =
+        be ? be12_stream_pack_permute_tbl_512 : le12_stream_pack_permute_tbl_512;
+  }
+
+  s->depth = depth;
+  s->be = be;
+  s->mask = _mm512_set1_epi16((1 << depth) - 1);
+  s->unpack_permute = _mm512_loadu_si512((__m512i*)unpack_permute);
+  s->unpack_srlv = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)unpack_srlv));
+  /* (first << depth | second) for be, (first | second << depth) for le */
+  s->madd_mul = be ? _mm512_set1_epi32((1 << depth) | (1 << 16))
+                   : _mm512_set1_epi32(1 | (1 << (depth + 16)));
+  s->pack_permute = _mm512_loadu_si512((__m512i*)pack_permute);
+}
+
+/* the mask of the first n items, n can be out of 0 - 64 */
+static inline __mmask64 st20_avx512_vbmi_mask(int n) {
+  if (n <= 0) return 0;
+  if (n >= 64) return ~0ULL;
+  return (1ULL << n) - 1;
+}
+
+/* unpack 32 values from the first n(up to depth * 4) bytes of src */
+static inline __m512i st20_stream_unpack_avx512_vbmi(struct st20_stream_avx512_vbmi* s,
+                                                     uint8_t* src, int n) {
+  __m512i input = _mm512_maskz_loadu_epi8(st20_avx512_vbmi_mask(n), src);
+  __m512i words = _mm512_permutexvar_epi8(s->unpack_permute, input);
+  return _mm512_and_si512(_mm512_srlv_epi16(words, s->unpack_srlv), s->mask);
+}
+
+/* pack 32 values and store the first n(up to depth * 4) bytes to dst */
+static inline void st20_stream_pack_avx512_vbmi(struct st20_stream_avx512_vbmi* s,
+                                                __m512i values, uint8_t* dst, int n) {
+  __m512i madd = _mm512_madd_epi16(_mm512_and_si512(values, s->mask), s->madd_mul);
+
+  if (s->depth == 10) { /* the two 20 bits in each 64 bits to 40 bits */
+    if (s->be)
+      madd = _mm512_ternarylogic_epi64(_mm512_slli_epi64(madd, 20),
+                                       _mm512_set1_epi64(0xFFFFFFFFFF),
+                                       _mm512_srli_epi64(madd, 32), 0xEA);
+    else
+      madd = _mm512_ternarylogic_epi64(madd, _mm512_set1_epi64(0xFFFFF),
+                                       _mm512_srli_epi64(madd, 12), 0xE2);
+  }
+
+  __m512i bytes = _mm512_permutexvar_epi8(s->pack_permute, madd);
+  _mm512_mask_storeu_epi8(dst, st20_avx512_vbmi_mask(n), bytes);
+}
+
+/* Y of the 64 values of 16 pgs, {Cb, Y0, Cr, Y1} in each pg */
+static uint16_t p422_y_idx_tbl_512[32] = {
+    1,  3,  5,  7,  9,  11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+    33, 35, 37, 39, 41, 43, 45, 47, 49, 51, 53, 55, 57, 59, 61, 63,
+};
+
+/* Cb in the low 256 bits and Cr in the high 256 bits */
+static uint16_t p422_cbcr_idx_tbl_512[32] = {
+    0, 4, 8,  12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60,
+    2, 6, 10, 14, 18, 22, 26, 30, 34, 38, 42, 46, 50, 54, 58, 62,
+};
+
+/* the values 0 - 31 and 32 - 63 of 16 pgs from {Cb, Cr}(0 - 31) and Y(32 - 63) */
+static uint16_t p422_interleave_idx_tbl_512[2][32] = {
+    {0, 32, 16, 33, 1, 34, 17, 35, 2, 36, 18, 37, 3, 38, 19, 39,
+     4, 40, 20, 41, 5, 42, 21, 43, 6, 44, 22, 45, 7, 46, 23, 47},
+    {8,  48, 24, 49, 9,  50, 25, 51, 10, 52, 26, 53, 11, 54, 27, 55,
+     12, 56, 28, 57, 13, 58, 29, 59, 14, 60, 30, 61, 15, 62, 31, 63},
+};
+
+/*
+ * The value j of the 96 values of 32 pixels is from plane (j % 3) of B_R, Y_G, R_B.
+ * p444_plane_idx_tbl_512[p] picks plane p from the values 0 - 63, the lanes in
+ * p444_plane_mask[p] are picked from the values 64 - 95 with the same index.
+ */
+static uint16_t p444_plane_idx_tbl_512[3][32] = {
+    {0,  3,  6,  9,  12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45,
+     48, 51, 54, 57, 60, 63, 2,  5,  8,  11, 14, 17, 20, 23, 26, 29},
+    {1,  4,  7,  10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+     49, 52, 55, 58, 61, 0,  3,  6,  9,  12, 15, 18, 21, 24, 27, 30},
+    {2,  5,  8,  11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47,
+     50, 53, 56, 59, 62, 1,  4,  7,  10, 13, 16, 19, 22, 25, 28, 31},
+};
+
+static __mmask32 p444_plane_mask[3] = {0xFFC00000, 0xFFE00000, 0xFFE00000};
+
+/*
+ * p444_interleave_idx_tbl_512[k] picks the values 32k - 32k+31 from B_R(0 - 31) and
+ * Y_G(32 - 63), the lanes in p444_interleave_mask[k] are picked from R_B.
+ */
+static uint16_t p444_interleave_idx_tbl_512[3][32] = {
+    {0, 32, 0, 1, 33, 1, 2, 34, 2, 3, 35, 3, 4, 36, 4, 5,
+     37, 5, 6, 38, 6, 7, 39, 7, 8, 40, 8, 9, 41, 9, 10, 42},
+    {10, 11, 43, 11, 12, 44, 12, 13, 45, 13, 14, 46, 14, 15, 47, 15,
+     16, 48, 16, 17, 49, 17, 18, 50, 18, 19, 51, 19, 20, 52, 20, 21},
+    {53, 21, 22, 54, 22, 23, 55, 23, 24, 56, 24, 25, 57, 25, 26, 58,
+     26, 27, 59, 27, 28, 60, 28, 29, 61, 29, 30, 62, 30, 31, 63, 31},
+};
+
+static __mmask32 p444_interleave_mask[3] = {0x24924924, 0x49249249, 0x92492492};
+/* end st20_stream_avx512_vbmi */
+
+/* begin st20_rfc4175_422le12_to_yuv422p12le_avx512_vbmi */
+int st20_rfc4175_422le12_to_yuv422p12le_avx512_vbmi(
+    struct st20_rfc4175_422_12_pg2_le* pg_le, uint16_t* y, uint16_t* b, uint16_t* r,
+    uint32_t w, uint32_t h) {
+  uint8_t* pg = (uint8_t*)pg_le;
+  __m512i y_idx = _mm512_loadu_si512((__m512i*)p422_y_idx_tbl_512);
+  __m512i cbcr_idx = _mm512_loadu_si512((__m512i*)p422_cbcr_idx_tbl_512);
+  struct st20_stream_avx512_vbmi s;
+  int pg_cnt = w * h / 2;
+
+  st20_stream_avx512_vbmi_init(&s, 12, false);
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  /* 16 pgs(96 bytes) in one batch, the last batch with the left pgs */
+  while (pg_cnt > 0) {
+    int cnt = RTE_MIN(pg_cnt, 16);
+    int bytes = cnt * 6;
+    __m512i values0 = st20_stream_unpack_avx512_vbmi(&s, pg, bytes);
+    __m512i values1 = st20_stream_unpack_avx512_vbmi(&s, pg + 48, bytes - 48);
+    __m512i y_result = _mm512_permutex2var_epi16(values0, y_idx, values1);
+    __m512i cbcr_result = _mm512_permutex2var_epi16(values0, cbcr_idx, values1);
+    __mmask16 k = st20_avx512_vbmi_mask(cnt);
+
+    _mm512_mask_storeu_epi16(y, st20_avx512_vbmi_mask(cnt * 2), y_result);
+    _mm256_mask_storeu_epi16(b, k, _mm512_castsi512_si256(cbcr_result));
+    _mm256_mask_storeu_epi16(r, k, _mm512_extracti64x4_epi64(cbcr_result, 1));
+
+    pg += 96;
+    y += 32;
+    b += 16;
+    r += 16;
+    pg_cnt -= cnt;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422le12_to_yuv422p12le_avx512_vbmi */
+
+/* begin st20_yuv422p12le_to_rfc4175_422be12_avx512_vbmi */
+static int st20_yuv422p12le_to_422_12_avx512_vbmi(uint16_t* y, uint16_t* b, uint16_t* r,
+                                                  uint8_t* pg, int pg_cnt, bool be) {
+  __m512i interleave0 = _mm512_loadu_si512((__m512i*)p422_interleave_idx_tbl_512[0]);
+  __m512i interleave1 = _mm512_loadu_si512((__m512i*)p422_interleave_idx_tbl_512[1]);
+  struct st20_stream_avx512_vbmi s;
+
+  st20_stream_avx512_vbmi_init(&s, 12, be);
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+
+  /* 16 pgs(96 bytes) in one batch, the last batch with the left pgs */
+  while (pg_cnt > 0) {
+    int cnt = RTE_MIN(pg_cnt, 16);
+    int bytes = cnt * 6;
+    __mmask16 k = st20_avx512_vbmi_mask(cnt);
+    __m512i y_input = _mm512_maskz_loadu_epi16(st20_avx512_vbmi_mask(cnt * 2), y);
+    __m256i b_input = _mm256_maskz_loadu_epi16(k, b);
+    __m256i r_input = _mm256_maskz_loadu_epi16(k, r);
+    __m512i cbcr = _mm512_inserti64x4(_mm512_castsi256_si512(b_input), r_input, 1);
+
+    st20_stream_pack_avx512_vbmi(
+        &s, _mm512_permutex2var_epi16(cbcr, interleave0, y_input), pg, bytes);
+    st20_stream_pack_avx512_vbmi(
+        &s, _mm512_permutex2var_epi16(cbcr, interleave1, y_input), pg + 48, bytes - 48);
+
+    y += 32;
+    b += 16;
+    r += 16;
+    pg += 96;
+    pg_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_yuv422p12le_to_rfc4175_422be12_avx512_vbmi(uint16_t* y, uint16_t* b, uint16_t* r,
+                                                    struct st20_rfc4175_422_12_pg2_be* pg,
+                                                    uint32_t w, uint32_t h) {
+  return st20_yuv422p12le_to_422_12_avx512_vbmi(y, b, r, (uint8_t*)pg, w * h / 2, true);
+}
+/* end st20_yuv422p12le_to_rfc4175_422be12_avx512_vbmi */
+
+/* begin st20_yuv422p12le_to_rfc4175_422le12_avx512_vbmi */
+int st20_yuv422p12le_to_rfc4175_422le12_avx512_vbmi(uint16_t* y, uint16_t* b, uint16_t* r,
+                                                    struct st20_rfc4175_422_12_pg2_le* pg,
+                                                    uint32_t w, uint32_t h) {
+  return st20_yuv422p12le_to_422_12_avx512_vbmi(y, b, r, (uint8_t*)pg, w * h / 2, false);
+}
+/* end st20_yuv422p12le_to_rfc4175_422le12_avx512_vbmi */
+
+/* begin st20_rfc4175_422be12_to_422le12_avx512_vbmi */
+/* the 12 bits pgroups of 422 and 444 are the same bits stream, 2 values in 3 bytes */
+static int st20_12_be_le_avx512_vbmi(uint8_t* src, uint8_t* dst, int grp_cnt,
+                                     bool be_to_le) {
+  struct st20_stream_avx512_vbmi in, out;
+
+  st20_stream_avx512_vbmi_init(&in, 12, be_to_le);
+  st20_stream_avx512_vbmi_init(&out, 12, !be_to_le);
+  dbg("%s, grp_cnt %d\n", __func__, grp_cnt);
+
+  /* 16 groups(48 bytes) in one batch, the last batch with the left groups */
+  while (grp_cnt > 0) {
+    int cnt = RTE_MIN(grp_cnt, 16);
+    int bytes = cnt * 3;
+    __m512i values = st20_stream_unpack_avx512_vbmi(&in, src, bytes);
+
+    st20_stream_pack_avx512_vbmi(&out, values, dst, bytes);
+
+    src += 48;
+    dst += 48;
+    grp_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be12_to_422le12_avx512_vbmi(struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                                struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                                uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 4 values in each pg */
+  return st20_12_be_le_avx512_vbmi((uint8_t*)pg_be, (uint8_t*)pg_le, pg_cnt * 2, true);
+}
+/* end st20_rfc4175_422be12_to_422le12_avx512_vbmi */
+
+/* begin st20_rfc4175_422le12_to_422be12_avx512_vbmi */
+int st20_rfc4175_422le12_to_422be12_avx512_vbmi(struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                                struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                                uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 4 values in each pg */
+  return st20_12_be_le_avx512_vbmi((uint8_t*)pg_le, (uint8_t*)pg_be, pg_cnt * 2, false);
+}
+/* end st20_rfc4175_422le12_to_422be12_avx512_vbmi */
+
+/* begin st20_rfc4175_444be10_to_444p10le_avx512_vbmi */
+/* the 10/12 bits 444 pgroups to planes, px_cnt of whole pgs */
+static int st20_444_to_444p_avx512_vbmi(uint8_t* pg, uint16_t* y_g, uint16_t* b_r,
+                                        uint16_t* r_b, int px_cnt, int depth, bool be) {
+  uint16_t* planes[3] = {b_r, y_g, r_b};
+  int zmm_bytes = depth * 4; /* 32 values */
+  __m512i plane_idx[3];
+  struct st20_stream_avx512_vbmi s;
+
+  for (int p = 0; p < 3; p++)
+    plane_idx[p] = _mm512_loadu_si512((__m512i*)p444_plane_idx_tbl_512[p]);
+  st20_stream_avx512_vbmi_init(&s, depth, be);
+  dbg("%s, px_cnt %d depth %d\n", __func__, px_cnt, depth);
+
+  /* 32 pixels(96 values) in one batch, the last batch with the left pixels */
+  while (px_cnt > 0) {
+    int cnt = RTE_MIN(px_cnt, 32);
+    int bytes = cnt * 3 * depth / 8;
+    __mmask32 k = st20_avx512_vbmi_mask(cnt);
+    __m512i values[3];
+
+    for (int i = 0; i < 3; i++)
+      values[i] =
+          st20_stream_unpack_avx512_vbmi(&s, pg + i * zmm_bytes, bytes - i * zmm_bytes);
+    for (int p = 0; p < 3; p++) {
+      __m512i result = _mm512_permutex2var_epi16(values[0], plane_idx[p], values[1]);
+      result = _mm512_mask_permutexvar_epi16(result, p444_plane_mask[p], plane_idx[p],
+                                             values[2]);
+      _mm512_mask_storeu_epi16(planes[p], k, result);
+      planes[p] += 32;
+    }
+
+    pg += 3 * zmm_bytes;
+    px_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_444be10_to_444p10le_avx512_vbmi(struct st20_rfc4175_444_10_pg4_be* pg,
+                                                 uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b, uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444_to_444p_avx512_vbmi((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 4, 10, true);
+}
+/* end st20_rfc4175_444be10_to_444p10le_avx512_vbmi */
+
+/* begin st20_rfc4175_444le10_to_444p10le_avx512_vbmi */
+int st20_rfc4175_444le10_to_444p10le_avx512_vbmi(struct st20_rfc4175_444_10_pg4_le* pg,
+                                                 uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b, uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444_to_444p_avx512_vbmi((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 4, 10, false);
+}
+/* end st20_rfc4175_444le10_to_444p10le_avx512_vbmi */
+
+/* begin st20_444p10le_to_rfc4175_444be10_avx512_vbmi */
+/* the planes to 10/12 bits 444 pgroups, px_cnt of whole pgs */
+static int st20_444p_to_444_avx512_vbmi(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                        uint8_t* pg, int px_cnt, int depth, bool be) {
+  int zmm_bytes = depth * 4; /* 32 values */
+  __m512i interleave_idx[3];
+  struct st20_stream_avx512_vbmi s;
+
+  for (int i = 0; i < 3; i++)
+    interleave_idx[i] = _mm512_loadu_si512((__m512i*)p444_interleave_idx_tbl_512[i]);
+  st20_stream_avx512_vbmi_init(&s, depth, be);
+  dbg("%s, px_cnt %d depth %d\n", __func__, px_cnt, depth);
+
+  /* 32 pixels(96 values) in one batch, the last batch with the left pixels */
+  while (px_cnt > 0) {
+    int cnt = RTE_MIN(px_cnt, 32);
+    int bytes = cnt * 3 * depth / 8;
+    __mmask32 k = st20_avx512_vbmi_mask(cnt);
+    __m512i br = _mm512_maskz_loadu_epi16(k, b_r);
+    __m512i yg = _mm512_maskz_loadu_epi16(k, y_g);
+    __m512i rb = _mm512_maskz_loadu_epi16(k, r_b);
+
+    for (int i = 0; i < 3; i++) {
+      __m512i values = _mm512_permutex2var_epi16(br, interleave_idx[i], yg);
+      values = _mm512_mask_permutexvar_epi16(values, p444_interleave_mask[i],
+                                             interleave_idx[i], rb);
+      st20_stream_pack_avx512_vbmi(&s, values, pg + i * zmm_bytes,
+                                   bytes - i * zmm_bytes);
+    }
+
+    y_g += 32;
+    b_r += 32;
+    r_b += 32;
+    pg += 3 * zmm_bytes;
+    px_cnt -= cnt;
+  }
+
+  return 0;
+}
+
+int st20_444p10le_to_rfc4175_444be10_avx512_vbmi(uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b,
+                                                 struct st20_rfc4175_444_10_pg4_be* pg,
+                                                 uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444p_to_444_avx512_vbmi(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 4, 10, true);
+}
+/* end st20_444p10le_to_rfc4175_444be10_avx512_vbmi */
+
+/* begin st20_444p10le_to_rfc4175_444le10_avx512_vbmi */
+int st20_444p10le_to_rfc4175_444le10_avx512_vbmi(uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b,
+                                                 struct st20_rfc4175_444_10_pg4_le* pg,
+                                                 uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 4;
+  /* 4 pixels in each pg */
+  return st20_444p_to_444_avx512_vbmi(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 4, 10, false);
+}
+/* end st20_444p10le_to_rfc4175_444le10_avx512_vbmi */
+
+/* begin st20_rfc4175_444be10_to_444le10_avx512_vbmi */
+int st20_rfc4175_444be10_to_444le10_avx512_vbmi(struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                                struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                                uint32_t w, uint32_t h) {
+  /* one 444 pg4 is the same bits stream as three 422 pg2 */
+  int pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422be10_to_422le10_avx512_vbmi(
+      (struct st20_rfc4175_422_10_pg2_be*)pg_be,
+      (struct st20_rfc4175_422_10_pg2_le*)pg_le, pg2_cnt * 2, 1);
+}
+/* end st20_rfc4175_444be10_to_444le10_avx512_vbmi */
+
+/* begin st20_rfc4175_444le10_to_444be10_avx512_vbmi */
+int st20_rfc4175_444le10_to_444be10_avx512_vbmi(struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                                struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                                uint32_t w, uint32_t h) {
+  /* one 444 pg4 is the same bits stream as three 422 pg2 */
+  int pg2_cnt = w * h / 4 * 3;
+  return st20_rfc4175_422le10_to_422be10_vbmi((struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                              (struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                              pg2_cnt * 2, 1);
+}
+/* end st20_rfc4175_444le10_to_444be10_avx512_vbmi */
+
+/* begin st20_rfc4175_444be12_to_444p12le_avx512_vbmi */
+int st20_rfc4175_444be12_to_444p12le_avx512_vbmi(struct st20_rfc4175_444_12_pg2_be* pg,
+                                                 uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b, uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444_to_444p_avx512_vbmi((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 2, 12, true);
+}
+/* end st20_rfc4175_444be12_to_444p12le_avx512_vbmi */
+
+/* begin st20_rfc4175_444le12_to_444p12le_avx512_vbmi */
+int st20_rfc4175_444le12_to_444p12le_avx512_vbmi(struct st20_rfc4175_444_12_pg2_le* pg,
+                                                 uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b, uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444_to_444p_avx512_vbmi((uint8_t*)pg, y_g, b_r, r_b, pg_cnt * 2, 12, false);
+}
+/* end st20_rfc4175_444le12_to_444p12le_avx512_vbmi */
+
+/* begin st20_444p12le_to_rfc4175_444be12_avx512_vbmi */
+int st20_444p12le_to_rfc4175_444be12_avx512_vbmi(uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b,
+                                                 struct st20_rfc4175_444_12_pg2_be* pg,
+                                                 uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444p_to_444_avx512_vbmi(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 2, 12, true);
+}
+/* end st20_444p12le_to_rfc4175_444be12_avx512_vbmi */
+
+/* begin st20_444p12le_to_rfc4175_444le12_avx512_vbmi */
+int st20_444p12le_to_rfc4175_444le12_avx512_vbmi(uint16_t* y_g, uint16_t* b_r,
+                                                 uint16_t* r_b,
+                                                 struct st20_rfc4175_444_12_pg2_le* pg,
+                                                 uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 2 pixels in each pg */
+  return st20_444p_to_444_avx512_vbmi(y_g, b_r, r_b, (uint8_t*)pg, pg_cnt * 2, 12, false);
+}
+/* end st20_444p12le_to_rfc4175_444le12_avx512_vbmi */
+
+/* begin st20_rfc4175_444be12_to_444le12_avx512_vbmi */
+int st20_rfc4175_444be12_to_444le12_avx512_vbmi(struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                                struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                                uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 6 values in each pg */
+  return st20_12_be_le_avx512_vbmi((uint8_t*)pg_be, (uint8_t*)pg_le, pg_cnt * 3, true);
+}
+/* end st20_rfc4175_444be12_to_444le12_avx512_vbmi */
+
+/* begin st20_rfc4175_444le12_to_444be12_avx512_vbmi */
+int st20_rfc4175_444le12_to_444be12_avx512_vbmi(struct st20_rfc4175_444_12_pg2_le* pg_le,
+                                                struct st20_rfc4175_444_12_pg2_be* pg_be,
+                                                uint32_t w, uint32_t h) {
+  int pg_cnt = w * h / 2;
+  /* 6 values in each pg */
+  return st20_12_be_le_avx512_vbmi((uint8_t*)pg_le, (uint8_t*)pg_be, pg_cnt * 3, false);
+}
+/* end st20_rfc4175_444le12_to_444be12_avx512_vbmi */
 MT_TARGET_CODE_STOP
 #endif
@@ -427,6 +427,427 @@ static int convert_gbrp12le_to_rfc4175_444be12(struct st_frame* src,
   return ret;
 }
 
+/* fixed point bits, the YUV to RGB coefficients go up to 2.15 */
+#define ST_COLOR_RGB_TO_YUV_SHIFT (14)
+#define ST_COLOR_YUV_TO_RGB_SHIFT (13)
+/* pixels of one chunk of the RGB <-> YUV convert, the chunk buffers are on the stack */
+#define ST_COLOR_CHUNK_PIXELS (512)
+
+int st_color_coefs_init(struct st_color_coefs* coefs, enum st_frame_color_matrix matrix,
+                        bool full_range, bool to_yuv, int rgb_depth, int yuv_depth) {
+  double kr, kb, kg;
+  double rgb_max = (1 << rgb_depth) - 1;
+  double y_scale, c_scale;
+  double m[3][3];
+  int y_off, c_off;
+
+  switch (matrix) {
+    case ST_FRAME_COLOR_MATRIX_BT709:
+      kr = 0.2126;
+      kb = 0.0722;
+      break;
+    case ST_FRAME_COLOR_MATRIX_BT601:
+      kr = 0.299;
+      kb = 0.114;
+      break;
+    case ST_FRAME_COLOR_MATRIX_BT2020:
+      kr = 0.2627;
+      kb = 0.0593;
+      break;
+    default:
+      err("%s, invalid matrix %d\n", __func__, matrix);
+      return -EINVAL;
+  }
+  kg = 1.0 - kr - kb;
+
+  /* the scale from the normalized RGB to the YUV codes */
+  if (full_range) {
+    y_scale = c_scale = (1 << yuv_depth) - 1;
+    y_off = 0;
+  } else {
+    y_scale = 219 << (yuv_depth - 8);
+    c_scale = 224 << (yuv_depth - 8);
+    y_off = 16 << (yuv_depth - 8);
+  }
+  c_off = 1 << (yuv_depth - 1);
+
+  memset(coefs, 0, sizeof(*coefs));
+  if (to_yuv) {
+    double ys = y_scale / rgb_max, cs = c_scale / rgb_max;
+    double cb = cs / (2 * (1 - kb)), cr = cs / (2 * (1 - kr));
+
+    m[0][0] = kr * ys;
+    m[0][1] = kg * ys;
+    m[0][2] = kb * ys;
+    m[1][0] = -kr * cb;
+    m[1][1] = -kg * cb;
+    m[1][2] = (1 - kb) * cb;
+    m[2][0] = (1 - kr) * cr;
+    m[2][1] = -kg * cr;
+    m[2][2] = -kb * cr;
+    coefs->shift = ST_COLOR_RGB_TO_YUV_SHIFT;
+    coefs->in_mask = rgb_max;
+    coefs->max = (1 << yuv_depth) - 1;
+    coefs->add[0] = y_off << coefs->shift;
+    coefs->add[1] = coefs->add[2] = c_off << coefs->shift;
+  } else {
+    double ys = rgb_max / y_scale, cs = rgb_max / c_scale;
+
+    m[0][0] = ys;
+    m[0][1] = 0;
+    m[0][2] = 2 * (1 - kr) * cs;
+    m[1][0] = ys;
+    m[1][1] = -2 * kb * (1 - kb) / kg * cs;
+    m[1][2] = -2 * kr * (1 - kr) / kg * cs;
+    m[2][0] = ys;
+    m[2][1] = 2 * (1 - kb) * cs;
+    m[2][2] = 0;
+    coefs->shift = ST_COLOR_YUV_TO_RGB_SHIFT;
+    coefs->in_mask = (1 << yuv_depth) - 1;
+    coefs->in_off[0] = y_off;
+    coefs->in_off[1] = coefs->in_off[2] = c_off;
+    coefs->max = rgb_max;
+  }
+
+  for (int k = 0; k < 3; k++) {
+    double row = 0;
+    for (int j = 0; j < 3; j++) {
+      double v = m[k][j] * (1 << coefs->shift);
+      if (v >= INT16_MAX || v <= INT16_MIN) {
+        err("%s, coef %f out of range, depth %d %d\n", __func__, v, rgb_depth, yuv_depth);
+        return -EINVAL;
+      }
+      coefs->m[k][j] = lround(v);
+      row += v;
+    }
+    /* keep the row sum to have the exact gray */
+    if (to_yuv)
+      coefs->m[k][1] = lround(row) - coefs->m[k][0] - coefs->m[k][2];
+    coefs->add[k] += 1 << (coefs->shift - 1);
+  }
+
+  return 0;
+}
+
+static void convert_color_matrix_line(uint16_t* in0, uint16_t* in1, uint16_t* in2,
+                                      uint16_t* out0, uint16_t* out1, uint16_t* out2,
+                                      uint32_t w, struct st_color_coefs* coefs) {
+#ifdef MTL_HAS_AVX2
+  if (mtl_get_simd_level() >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    int ret = st_color_matrix_avx2(in0, in1, in2, out0, out1, out2, w, coefs);
+    if (ret == 0) return;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  for (uint32_t i = 0; i < w; i++)
+    st_color_coefs_px(coefs, in0[i], in1[i], in2[i], &out0[i], &out1[i], &out2[i]);
+}
+
+/*
+ * 4:4:4 to 4:2:2 in place, [1 2 1] filter co-sited with the even pixels. left is the
+ * 4:4:4 chroma before c[0], the chunks of one line are filtered in order.
+ */
+static void convert_chroma_444_to_422(uint16_t* c, uint32_t w, uint16_t left) {
+  for (uint32_t i = 0; i < w / 2; i++) {
+    uint32_t x = i * 2;
+    uint16_t right = (x + 1 < w) ? c[x + 1] : c[x];
+    c[i] = (left + 2 * c[x] + right + 2) >> 2;
+    left = right;
+  }
+}
+
+/*
+ * 4:2:2 to 4:4:4 in place, the odd pixels are interpolated. c has half_cnt chroma which
+ * may include the one after the w pixels of this chunk.
+ */
+static void convert_chroma_422_to_444(uint16_t* c, uint32_t w, uint32_t half_cnt) {
+  for (int32_t i = w / 2 - 1; i >= 0; i--) {
+    uint16_t even = c[i];
+    uint16_t next = (i + 1 < half_cnt) ? c[i + 1] : even;
+    c[i * 2 + 1] = (even + next + 1) >> 1;
+    c[i * 2] = even;
+  }
+}
+
+static int convert_color_yuv_fmt(enum st_frame_fmt fmt, int* depth, bool* is_422) {
+  switch (fmt) {
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE10:
+      *depth = 10;
+      *is_422 = true;
+      return 0;
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE12:
+      *depth = 12;
+      *is_422 = true;
+      return 0;
+    case ST_FRAME_FMT_YUV444RFC4175PG4BE10:
+      *depth = 10;
+      *is_422 = false;
+      return 0;
+    case ST_FRAME_FMT_YUV444RFC4175PG2BE12:
+      *depth = 12;
+      *is_422 = false;
+      return 0;
+    default:
+      err("%s, invalid fmt %s\n", __func__, st_frame_fmt_name(fmt));
+      return -EINVAL;
+  }
+}
+
+static int convert_color_rgb_depth(enum st_frame_fmt fmt) {
+  switch (fmt) {
+    case ST_FRAME_FMT_RGB8:
+      return 8;
+    case ST_FRAME_FMT_GBRPLANAR10LE:
+    case ST_FRAME_FMT_RGBRFC4175PG4BE10:
+      return 10;
+    case ST_FRAME_FMT_GBRPLANAR12LE:
+    case ST_FRAME_FMT_RGBRFC4175PG2BE12:
+      return 12;
+    default:
+      err("%s, invalid fmt %s\n", __func__, st_frame_fmt_name(fmt));
+      return -EINVAL;
+  }
+}
+
+/* the pgroup which starts at pixel x of one line, x is aligned to the pg coverage */
+static void* convert_color_line_pg(struct st_frame* frame, struct st20_pgroup* pg,
+                                   uint32_t line, uint32_t x) {
+  return (uint8_t*)frame->addr[0] + frame->linesize[0] * line +
+         x / pg->coverage * pg->size;
+}
+
+static int convert_color_pgroup(enum st_frame_fmt fmt, struct st20_pgroup* pg) {
+  int ret = st20_get_pgroup(st_frame_fmt_to_transport(fmt), pg);
+  if (ret < 0) {
+    err("%s, get pgroup fail for %s\n", __func__, st_frame_fmt_name(fmt));
+    return ret;
+  }
+  return 0;
+}
+
+static int convert_yuv_chunk_pack(enum st_frame_fmt fmt, uint16_t* y, uint16_t* b,
+                                  uint16_t* r, void* pg, uint32_t w) {
+  switch (fmt) {
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE10:
+      return st20_yuv422p10le_to_rfc4175_422be10(y, b, r, pg, w, 1);
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE12:
+      return st20_yuv422p12le_to_rfc4175_422be12(y, b, r, pg, w, 1);
+    case ST_FRAME_FMT_YUV444RFC4175PG4BE10:
+      return st20_yuv444p10le_to_rfc4175_444be10(y, b, r, pg, w, 1);
+    case ST_FRAME_FMT_YUV444RFC4175PG2BE12:
+      return st20_yuv444p12le_to_rfc4175_444be12(y, b, r, pg, w, 1);
+    default:
+      return -EINVAL;
+  }
+}
+
+static int convert_yuv_chunk_unpack(enum st_frame_fmt fmt, void* pg, uint16_t* y,
+                                    uint16_t* b, uint16_t* r, uint32_t w) {
+  switch (fmt) {
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE10:
+      return st20_rfc4175_422be10_to_yuv422p10le(pg, y, b, r, w, 1);
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE12:
+      return st20_rfc4175_422be12_to_yuv422p12le(pg, y, b, r, w, 1);
+    case ST_FRAME_FMT_YUV444RFC4175PG4BE10:
+      return st20_rfc4175_444be10_to_yuv444p10le(pg, y, b, r, w, 1);
+    case ST_FRAME_FMT_YUV444RFC4175PG2BE12:
+      return st20_rfc4175_444be12_to_yuv444p12le(pg, y, b, r, w, 1);
+    default:
+      return -EINVAL;
+  }
+}
+
+/*
+ * the r, g, b of the pixels [x, x + w) of one line, the gbr planes are used in place and
+ * others are unpacked to the chunk buffers. RGB8 is expanded to depth by the bits
+ * replication.
+ */
+static int convert_rgb_chunk_load(struct st_frame* frame, struct st20_pgroup* pg,
+                                  uint32_t line, uint32_t x, uint32_t w, int depth,
+                                  uint16_t** r, uint16_t** g, uint16_t** b) {
+  switch (frame->fmt) {
+    case ST_FRAME_FMT_RGB8: {
+      uint8_t* rgb = (uint8_t*)frame->addr[0] + frame->linesize[0] * line + x * 3;
+      int ls = depth - 8, rs = 16 - depth;
+      for (uint32_t i = 0; i < w; i++) {
+        (*r)[i] = (rgb[0] << ls) | (rgb[0] >> rs);
+        (*g)[i] = (rgb[1] << ls) | (rgb[1] >> rs);
+        (*b)[i] = (rgb[2] << ls) | (rgb[2] >> rs);
+        rgb += 3;
+      }
+      return 0;
+    }
+    case ST_FRAME_FMT_GBRPLANAR10LE:
+    case ST_FRAME_FMT_GBRPLANAR12LE:
+      *g = (uint16_t*)((uint8_t*)frame->addr[0] + frame->linesize[0] * line) + x;
+      *b = (uint16_t*)((uint8_t*)frame->addr[1] + frame->linesize[1] * line) + x;
+      *r = (uint16_t*)((uint8_t*)frame->addr[2] + frame->linesize[2] * line) + x;
+      return 0;
+    case ST_FRAME_FMT_RGBRFC4175PG4BE10:
+      return st20_rfc4175_444be10_to_gbrp10le(convert_color_line_pg(frame, pg, line, x),
+                                              *g, *b, *r, w, 1);
+    case ST_FRAME_FMT_RGBRFC4175PG2BE12:
+      return st20_rfc4175_444be12_to_gbrp12le(convert_color_line_pg(frame, pg, line, x),
+                                              *g, *b, *r, w, 1);
+    default:
+      return -EINVAL;
+  }
+}
+
+/* the output r, g, b of the pixels [x, x + w), the gbr planes are written in place */
+static void convert_rgb_chunk_out(struct st_frame* frame, uint32_t line, uint32_t x,
+                                  uint16_t** r, uint16_t** g, uint16_t** b) {
+  if (frame->fmt == ST_FRAME_FMT_GBRPLANAR10LE ||
+      frame->fmt == ST_FRAME_FMT_GBRPLANAR12LE) {
+    *g = (uint16_t*)((uint8_t*)frame->addr[0] + frame->linesize[0] * line) + x;
+    *b = (uint16_t*)((uint8_t*)frame->addr[1] + frame->linesize[1] * line) + x;
+    *r = (uint16_t*)((uint8_t*)frame->addr[2] + frame->linesize[2] * line) + x;
+  }
+}
+
+static int convert_rgb_chunk_store(struct st_frame* frame, struct st20_pgroup* pg,
+                                   uint32_t line, uint32_t x, uint32_t w, uint16_t* r,
+                                   uint16_t* g, uint16_t* b) {
+  switch (frame->fmt) {
+    case ST_FRAME_FMT_RGB8: {
+      uint8_t* rgb = (uint8_t*)frame->addr[0] + frame->linesize[0] * line + x * 3;
+      for (uint32_t i = 0; i < w; i++) {
+        rgb[0] = r[i];
+        rgb[1] = g[i];
+        rgb[2] = b[i];
+        rgb += 3;
+      }
+      return 0;
+    }
+    case ST_FRAME_FMT_GBRPLANAR10LE:
+    case ST_FRAME_FMT_GBRPLANAR12LE:
+      return 0; /* already in place */
+    case ST_FRAME_FMT_RGBRFC4175PG4BE10:
+      return st20_gbrp10le_to_rfc4175_444be10(g, b, r,
+                                              convert_color_line_pg(frame, pg, line, x),
+                                              w, 1);
+    case ST_FRAME_FMT_RGBRFC4175PG2BE12:
+      return st20_gbrp12le_to_rfc4175_444be12(g, b, r,
+                                              convert_color_line_pg(frame, pg, line, x),
+                                              w, 1);
+    default:
+      return -EINVAL;
+  }
+}
+
+/*
+ * RGB to the yuv rfc4175 formats, the matrix and range are from the dst frame. The lines
+ * are converted in chunks of ST_COLOR_CHUNK_PIXELS, the chunk size keeps the pgroups.
+ */
+static int convert_rgb_to_yuv(struct st_frame* src, struct st_frame* dst) {
+  uint16_t buf[6][ST_COLOR_CHUNK_PIXELS]; /* y, cb, cr and r, g, b for the unpacked */
+  struct st_color_coefs coefs;
+  struct st20_pgroup src_pg, dst_pg;
+  uint32_t w = src->width;
+  int rgb_depth, yuv_depth;
+  bool is_422;
+  int ret;
+
+  rgb_depth = convert_color_rgb_depth(src->fmt);
+  if (rgb_depth < 0) return rgb_depth;
+  ret = convert_color_yuv_fmt(dst->fmt, &yuv_depth, &is_422);
+  if (ret < 0) return ret;
+  ret = convert_color_pgroup(dst->fmt, &dst_pg);
+  if (ret < 0) return ret;
+  if (src->fmt == ST_FRAME_FMT_RGBRFC4175PG4BE10 ||
+      src->fmt == ST_FRAME_FMT_RGBRFC4175PG2BE12) {
+    ret = convert_color_pgroup(src->fmt, &src_pg);
+    if (ret < 0) return ret;
+  }
+  /* RGB8 is expanded to the yuv depth by the bits replication */
+  if (src->fmt == ST_FRAME_FMT_RGB8) rgb_depth = yuv_depth;
+  ret = st_color_coefs_init(&coefs, dst->color_matrix, dst->color_full_range, true,
+                            rgb_depth, yuv_depth);
+  if (ret < 0) return ret;
+
+  uint16_t *y = buf[0], *cb = buf[1], *cr = buf[2];
+  for (uint32_t line = 0; line < src->height; line++) {
+    uint16_t left_cb = 0, left_cr = 0; /* the 4:4:4 chroma before the chunk */
+
+    for (uint32_t x = 0; x < w; x += ST_COLOR_CHUNK_PIXELS) {
+      uint32_t cnt = RTE_MIN(w - x, ST_COLOR_CHUNK_PIXELS);
+      uint16_t *r = buf[3], *g = buf[4], *b = buf[5];
+
+      ret = convert_rgb_chunk_load(src, &src_pg, line, x, cnt, yuv_depth, &r, &g, &b);
+      if (ret < 0) return ret;
+      convert_color_matrix_line(r, g, b, y, cb, cr, cnt, &coefs);
+      if (is_422) {
+        uint16_t last_cb = cb[cnt - 1], last_cr = cr[cnt - 1];
+        convert_chroma_444_to_422(cb, cnt, x ? left_cb : cb[0]);
+        convert_chroma_444_to_422(cr, cnt, x ? left_cr : cr[0]);
+        left_cb = last_cb;
+        left_cr = last_cr;
+      }
+
+      ret = convert_yuv_chunk_pack(dst->fmt, y, cb, cr,
+                                   convert_color_line_pg(dst, &dst_pg, line, x), cnt);
+      if (ret < 0) return ret;
+    }
+  }
+
+  return 0;
+}
+
+/* the yuv rfc4175 formats to RGB, the matrix and range are from the src frame */
+static int convert_yuv_to_rgb(struct st_frame* src, struct st_frame* dst) {
+  /* y, cb, cr with the 4:2:2 chroma of the next pgroup, and r, g, b */
+  uint16_t buf[6][ST_COLOR_CHUNK_PIXELS + 2];
+  struct st_color_coefs coefs;
+  struct st20_pgroup src_pg, dst_pg;
+  uint32_t w = src->width;
+  int rgb_depth, yuv_depth;
+  bool is_422;
+  int ret;
+
+  ret = convert_color_yuv_fmt(src->fmt, &yuv_depth, &is_422);
+  if (ret < 0) return ret;
+  rgb_depth = convert_color_rgb_depth(dst->fmt);
+  if (rgb_depth < 0) return rgb_depth;
+  ret = convert_color_pgroup(src->fmt, &src_pg);
+  if (ret < 0) return ret;
+  if (dst->fmt == ST_FRAME_FMT_RGBRFC4175PG4BE10 ||
+      dst->fmt == ST_FRAME_FMT_RGBRFC4175PG2BE12) {
+    ret = convert_color_pgroup(dst->fmt, &dst_pg);
+    if (ret < 0) return ret;
+  }
+  ret = st_color_coefs_init(&coefs, src->color_matrix, src->color_full_range, false,
+                            rgb_depth, yuv_depth);
+  if (ret < 0) return ret;
+
+  uint16_t *y = buf[0], *cb = buf[1], *cr = buf[2];
+  for (uint32_t line = 0; line < src->height; line++) {
+    for (uint32_t x = 0; x < w; x += ST_COLOR_CHUNK_PIXELS) {
+      uint32_t cnt = RTE_MIN(w - x, ST_COLOR_CHUNK_PIXELS);
+      /* one more 4:2:2 pgroup to interpolate the last odd pixel */
+      uint32_t unpack_cnt = is_422 ? RTE_MIN(w - x, cnt + 2) : cnt;
+      uint16_t *r = buf[3], *g = buf[4], *b = buf[5];
+
+      void* pg = convert_color_line_pg(src, &src_pg, line, x);
+
+      ret = convert_yuv_chunk_unpack(src->fmt, pg, y, cb, cr, unpack_cnt);
+      if (ret < 0) return ret;
+      if (is_422) {
+        convert_chroma_422_to_444(cb, cnt, unpack_cnt / 2);
+        convert_chroma_422_to_444(cr, cnt, unpack_cnt / 2);
+      }
+
+      convert_rgb_chunk_out(dst, line, x, &r, &g, &b);
+      convert_color_matrix_line(y, cb, cr, r, g, b, cnt, &coefs);
+      ret = convert_rgb_chunk_store(dst, &dst_pg, line, x, cnt, r, g, b);
+      if (ret < 0) return ret;
+    }
+  }
+
+  return 0;
+}
+
 static const struct st_frame_converter converters[] = {
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
@@ -513,22 +934,464 @@ static const struct st_frame_converter converters[] = {
         .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
         .convert_func = convert_gbrp12le_to_rfc4175_444be12,
     },
+    {
+        .src_fmt = ST_FRAME_FMT_RGB8,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGB8,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGB8,
+        .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
+        .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGB8,
+        .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
+        .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
+        .convert_func = convert_rgb_to_yuv,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_RGB8,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_RGB8,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_RGB8,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_RGB8,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
+        .convert_func = convert_yuv_to_rgb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
+        .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
+        .convert_func = convert_yuv_to_rgb,
+    },
 };
 
-int st_frame_convert(struct st_frame* src, struct st_frame* dst) {
+int st_frame_band_view(struct st_frame* frame, uint32_t start, uint32_t lines) {
+  uint8_t planes = st_frame_fmt_planes(frame->fmt);
+  size_t linesize;
+
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    linesize = frame->linesize[plane];
+    /* no padding, the lines are packed */
+    if (!linesize) linesize = st_frame_least_linesize(frame->fmt, frame->width, plane);
+    if (!linesize) {
+      err("%s, unknown linesize for fmt %d plane %u\n", __func__, frame->fmt, plane);
+      return -EINVAL;
+    }
+    frame->linesize[plane] = linesize;
+    size_t offset = linesize * start;
+    frame->addr[plane] = (uint8_t*)frame->addr[plane] + offset;
+    if (frame->iova[plane]) frame->iova[plane] += offset;
+  }
+  frame->height = lines;
+  return 0;
+}
+
+/* pixels of one pixel group, a band should not split the group */
+static uint32_t convert_band_coverage(enum st_frame_fmt fmt) {
+  switch (fmt) {
+    case ST_FRAME_FMT_V210:
+      return 6;
+    case ST_FRAME_FMT_YUV444RFC4175PG4BE10:
+    case ST_FRAME_FMT_RGBRFC4175PG4BE10:
+      return 4;
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE10:
+    case ST_FRAME_FMT_YUV422RFC4175PG2BE12:
+    case ST_FRAME_FMT_YUV444RFC4175PG2BE12:
+    case ST_FRAME_FMT_RGBRFC4175PG2BE12:
+    case ST_FRAME_FMT_UYVY:
+    case ST_FRAME_FMT_Y210:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+/* the lines of each band, aligned to keep the pgroup inside one band */
+static uint32_t convert_band_lines(struct st_frame* src, struct st_frame* dst,
+                                   uint32_t band_cnt) {
+  uint32_t src_cov = convert_band_coverage(src->fmt);
+  uint32_t dst_cov = convert_band_coverage(dst->fmt);
+  uint32_t align = 1;
+  uint32_t lines;
+
+  while (((src->width * align) % src_cov) || ((dst->width * align) % dst_cov)) align++;
+
+  lines = (src->height + band_cnt - 1) / band_cnt;
+  lines = (lines + align - 1) / align * align;
+  return lines;
+}
+
+static int convert_band(struct st_frame* src, struct st_frame* dst,
+                        int (*convert_func)(struct st_frame* src, struct st_frame* dst),
+                        uint32_t band_lines, uint32_t band_idx) {
+  uint32_t start = band_lines * band_idx;
+  if (start >= src->height) return 0; /* empty band after the alignment */
+  uint32_t lines = RTE_MIN(band_lines, src->height - start);
+  struct st_frame band_src = *src;
+  struct st_frame band_dst = *dst;
+  int ret;
+
+  ret = st_frame_band_view(&band_src, start, lines);
+  if (ret < 0) return ret;
+  ret = st_frame_band_view(&band_dst, start, lines);
+  if (ret < 0) return ret;
+  return convert_func(&band_src, &band_dst);
+}
+
+struct convert_band_job {
+  struct st_frame* src;
+  struct st_frame* dst;
+  int (*convert_func)(struct st_frame* src, struct st_frame* dst);
+  uint32_t band_cnt;
+  uint32_t band_lines;
+  rte_atomic32_t next_band;
+  rte_atomic32_t ret;
+  int users; /* helper threads working on this job, protected by the pool lock */
+  struct convert_band_job* next;
+};
+
+/*
+ * the internal band pool of st_frame_convert, the caller works on the bands of its own
+ * job and the helper threads join any job which still has bands left, so concurrent
+ * converts from several sessions all run on the pool.
+ */
+struct convert_band_pool {
+  pthread_mutex_t lock;
+  pthread_cond_t wake_cond; /* new job */
+  pthread_cond_t done_cond; /* helper threads leave one job or a user leaves the pool */
+  struct convert_band_job* jobs; /* the jobs in running */
+  int refs;                      /* the st_frame_convert callers using the pool */
+  bool stop;
+  uint8_t threads_cnt; /* the helper threads, not include the caller */
+  pthread_t tids[ST_CONVERT_BAND_THREADS_MAX];
+};
+
+/* protect the pool create/free and the pool refs get */
+static pthread_mutex_t convert_band_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct convert_band_pool* convert_band_pool;
+
+static void convert_band_job_run(struct convert_band_job* job) {
+  uint32_t band;
+  int ret;
+
+  while (1) {
+    band = rte_atomic32_add_return(&job->next_band, 1) - 1;
+    if (band >= job->band_cnt) break;
+    ret = convert_band(job->src, job->dst, job->convert_func, job->band_lines, band);
+    if (ret < 0) rte_atomic32_set(&job->ret, ret);
+  }
+}
+
+/* the first job which has bands left, pool->lock should be locked */
+static struct convert_band_job* convert_band_pool_pick(struct convert_band_pool* pool) {
+  struct convert_band_job* job = pool->jobs;
+
+  while (job) {
+    if ((uint32_t)rte_atomic32_read(&job->next_band) < job->band_cnt) return job;
+    job = job->next;
+  }
+  return NULL;
+}
+
+static void* convert_band_thread(void* arg) {
+  struct convert_band_pool* pool = arg;
+  struct convert_band_job* job;
+
+  mt_pthread_mutex_lock(&pool->lock);
+  while (!pool->stop) {
+    job = convert_band_pool_pick(pool);
+    if (!job) {
+      mt_pthread_cond_wait(&pool->wake_cond, &pool->lock);
+      continue;
+    }
+
+    job->users++;
+    mt_pthread_mutex_unlock(&pool->lock);
+    convert_band_job_run(job);
+    mt_pthread_mutex_lock(&pool->lock);
+    job->users--;
+    if (!job->users) mt_pthread_cond_broadcast(&pool->done_cond);
+  }
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  return NULL;
+}
+
+static struct convert_band_pool* convert_band_pool_get(void) {
+  struct convert_band_pool* pool;
+
+  mt_pthread_mutex_lock(&convert_band_pool_lock);
+  pool = convert_band_pool;
+  if (pool) {
+    mt_pthread_mutex_lock(&pool->lock);
+    pool->refs++;
+    mt_pthread_mutex_unlock(&pool->lock);
+  }
+  mt_pthread_mutex_unlock(&convert_band_pool_lock);
+
+  return pool;
+}
+
+static void convert_band_pool_put(struct convert_band_pool* pool) {
+  mt_pthread_mutex_lock(&pool->lock);
+  pool->refs--;
+  if (!pool->refs) mt_pthread_cond_broadcast(&pool->done_cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+}
+
+static void convert_band_pool_free(struct convert_band_pool* pool) {
+  mt_pthread_mutex_lock(&pool->lock);
+  /* wait the converts in running */
+  while (pool->refs) mt_pthread_cond_wait(&pool->done_cond, &pool->lock);
+  pool->stop = true;
+  mt_pthread_cond_broadcast(&pool->wake_cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  for (uint8_t i = 0; i < pool->threads_cnt; i++) pthread_join(pool->tids[i], NULL);
+
+  mt_pthread_mutex_destroy(&pool->lock);
+  mt_pthread_cond_destroy(&pool->wake_cond);
+  mt_pthread_cond_destroy(&pool->done_cond);
+  mt_free(pool);
+}
+
+static struct convert_band_pool* convert_band_pool_create(uint8_t threads_cnt) {
+  struct convert_band_pool* pool;
+  int ret;
+
+  pool = mt_zmalloc(sizeof(*pool));
+  if (!pool) {
+    err("%s, pool malloc fail\n", __func__);
+    return NULL;
+  }
+  mt_pthread_mutex_init(&pool->lock, NULL);
+  mt_pthread_cond_init(&pool->wake_cond, NULL);
+  mt_pthread_cond_init(&pool->done_cond, NULL);
+
+  for (uint8_t i = 0; i < threads_cnt; i++) {
+    ret = pthread_create(&pool->tids[i], NULL, convert_band_thread, pool);
+    if (ret) {
+      err("%s, pthread_create fail %d at %u\n", __func__, ret, i);
+      convert_band_pool_free(pool);
+      return NULL;
+    }
+    pool->threads_cnt++;
+  }
+
+  return pool;
+}
+
+static int convert_band_pool_run(struct convert_band_pool* pool,
+                                 struct convert_band_job* job) {
+  struct convert_band_job** pos;
+
+  mt_pthread_mutex_lock(&pool->lock);
+  job->users = 0;
+  job->next = pool->jobs;
+  pool->jobs = job;
+  mt_pthread_cond_broadcast(&pool->wake_cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  convert_band_job_run(job);
+
+  /* wait until all helper threads leave the job */
+  mt_pthread_mutex_lock(&pool->lock);
+  while (job->users) mt_pthread_cond_wait(&pool->done_cond, &pool->lock);
+  for (pos = &pool->jobs; *pos; pos = &(*pos)->next) {
+    if (*pos == job) {
+      *pos = job->next;
+      break;
+    }
+  }
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  return rte_atomic32_read(&job->ret);
+}
+
+int st_frame_convert_set_threads(uint8_t threads) {
+  if (threads > ST_CONVERT_BAND_THREADS_MAX + 1) {
+    err("%s, invalid threads %u, max %u\n", __func__, threads,
+        ST_CONVERT_BAND_THREADS_MAX + 1);
+    return -EINVAL;
+  }
+
+  mt_pthread_mutex_lock(&convert_band_pool_lock);
+  if (convert_band_pool) {
+    /* the converts which got the pool keep it until done */
+    convert_band_pool_free(convert_band_pool);
+    convert_band_pool = NULL;
+  }
+  if (threads > 1) {
+    convert_band_pool = convert_band_pool_create(threads - 1);
+    if (!convert_band_pool) {
+      mt_pthread_mutex_unlock(&convert_band_pool_lock);
+      return -ENOMEM;
+    }
+  }
+  mt_pthread_mutex_unlock(&convert_band_pool_lock);
+
+  info("%s, band threads %u\n", __func__, threads);
+  return 0;
+}
+
+static int convert_check(struct st_frame* src, struct st_frame* dst,
+                         struct st_frame_converter* converter) {
   if (src->width != dst->width || src->height != dst->height) {
     err("%s, width/height mismatch, source: %u x %u, dest: %u x %u\n", __func__,
         src->width, src->height, dst->width, dst->height);
     return -EINVAL;
   }
-  struct st_frame_converter converter;
-  if (st_frame_get_converter(src->fmt, dst->fmt, &converter) < 0) {
+  if (st_frame_get_converter(src->fmt, dst->fmt, converter) < 0) {
     err("%s, get converter fail\n", __func__);
     return -EINVAL;
   }
+  return 0;
+}
+
+int st_frame_convert(struct st_frame* src, struct st_frame* dst) {
+  struct st_frame_converter converter;
+  int ret;
+
+  ret = convert_check(src, dst, &converter);
+  if (ret < 0) return ret;
+
+  /* split to bands on the pool, the concurrent converts share the helper threads */
+  struct convert_band_pool* pool = src->interlaced ? NULL : convert_band_pool_get();
+  if (pool) {
+    uint32_t band_cnt =
+        RTE_MIN(pool->threads_cnt + 1, src->height / ST_CONVERT_BAND_MIN_LINES);
+    if (band_cnt > 1) {
+      struct convert_band_job job;
+      memset(&job, 0, sizeof(job));
+      job.src = src;
+      job.dst = dst;
+      job.convert_func = converter.convert_func;
+      job.band_cnt = band_cnt;
+      job.band_lines = convert_band_lines(src, dst, band_cnt);
+      rte_atomic32_set(&job.next_band, 0);
+      rte_atomic32_set(&job.ret, 0);
+      ret = convert_band_pool_run(pool, &job);
+      convert_band_pool_put(pool);
+      return ret;
+    }
+    convert_band_pool_put(pool);
+  }
+
   return converter.convert_func(src, dst);
 }
 
+int st_frame_convert_band(struct st_frame* src, struct st_frame* dst, uint32_t band_idx,
+                          uint32_t band_cnt) {
+  struct st_frame_converter converter;
+  int ret;
+
+  if (!band_cnt || band_idx >= band_cnt) {
+    err("%s, invalid band %u of %u\n", __func__, band_idx, band_cnt);
+    return -EINVAL;
+  }
+  if (src->interlaced) {
+    err("%s, interlaced frame not support band convert\n", __func__);
+    return -EINVAL;
+  }
+
+  ret = convert_check(src, dst, &converter);
+  if (ret < 0) return ret;
+
+  uint32_t band_lines = convert_band_lines(src, dst, band_cnt);
+  return convert_band(src, dst, converter.convert_func, band_lines, band_idx);
+}
+
 int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
                            struct st_frame_converter* converter) {
   for (int i = 0; i < MTL_ARRAY_SIZE(converters); i++) {
@@ -665,6 +1528,15 @@ int st20_yuv422p10le_to_rfc4175_422be10_simd(uint16_t* y, uint16_t* b, uint16_t*
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_yuv422p10le_to_rfc4175_422be10_avx2(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_yuv422p10le_to_rfc4175_422be10_scalar(y, b, r, pg, w, h);
 }
@@ -744,6 +1616,15 @@ int st20_rfc4175_422be10_to_yuv422p10le_simd(struct st20_rfc4175_422_10_pg2_be*
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_yuv422p10le_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_yuv422p10le_scalar(pg, y, b, r, w, h);
 }
@@ -784,9 +1665,9 @@ int st20_rfc4175_422be10_to_yuv422p10le_simd_dma(mtl_udma_handle udma,
   return st20_rfc4175_422be10_to_yuv422p10le_scalar(pg_be, y, b, r, w, h);
 }
 
-int st20_yuv422p10le_to_rfc4175_422le10(uint16_t* y, uint16_t* b, uint16_t* r,
-                                        struct st20_rfc4175_422_10_pg2_le* pg, uint32_t w,
-                                        uint32_t h) {
+static int st20_yuv422p10le_to_rfc4175_422le10_scalar(
+    uint16_t* y, uint16_t* b, uint16_t* r, struct st20_rfc4175_422_10_pg2_le* pg,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 2; /* two pgs in one convert */
   uint16_t cb, y0, cr, y1;
 
@@ -811,9 +1692,25 @@ int st20_yuv422p10le_to_rfc4175_422le10(uint16_t* y, uint16_t* b, uint16_t* r,
   return 0;
 }
 
-int st20_rfc4175_422le10_to_yuv422p10le(struct st20_rfc4175_422_10_pg2_le* pg,
-                                        uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w,
+int st20_yuv422p10le_to_rfc4175_422le10(uint16_t* y, uint16_t* b, uint16_t* r,
+                                        struct st20_rfc4175_422_10_pg2_le* pg, uint32_t w,
                                         uint32_t h) {
+#ifdef MTL_HAS_AVX2
+  if (mtl_get_simd_level() >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    int ret = st20_yuv422p10le_to_rfc4175_422le10_avx2(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_yuv422p10le_to_rfc4175_422le10_scalar(y, b, r, pg, w, h);
+}
+
+static int st20_rfc4175_422le10_to_yuv422p10le_scalar(
+    struct st20_rfc4175_422_10_pg2_le* pg, uint16_t* y, uint16_t* b, uint16_t* r,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 2; /* two pgs in one convert */
   uint16_t cb, y0, cr, y1;
 
@@ -833,6 +1730,22 @@ int st20_rfc4175_422le10_to_yuv422p10le(struct st20_rfc4175_422_10_pg2_le* pg,
   return 0;
 }
 
+int st20_rfc4175_422le10_to_yuv422p10le(struct st20_rfc4175_422_10_pg2_le* pg,
+                                        uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w,
+                                        uint32_t h) {
+#ifdef MTL_HAS_AVX2
+  if (mtl_get_simd_level() >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    int ret = st20_rfc4175_422le10_to_yuv422p10le_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422le10_to_yuv422p10le_scalar(pg, y, b, r, w, h);
+}
+
 int st20_rfc4175_422be10_to_422le10_scalar(struct st20_rfc4175_422_10_pg2_be* pg_be,
                                            struct st20_rfc4175_422_10_pg2_le* pg_le,
                                            uint32_t w, uint32_t h) {
@@ -1093,6 +2006,15 @@ int st20_rfc4175_422be10_to_422le8_simd(struct st20_rfc4175_422_10_pg2_be* pg_10
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_422le8_avx2(pg_10, pg_8, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_422le8_scalar(pg_10, pg_8, w, h);
 }
@@ -1200,12 +2122,21 @@ int st20_rfc4175_422le10_to_v210_simd(uint8_t* pg_le, uint8_t* pg_v210, uint32_t
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422le10_to_v210_avx2(pg_le, pg_v210, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422le10_to_v210_scalar(pg_le, pg_v210, w, h);
 }
 
-int st20_v210_to_rfc4175_422le10(uint8_t* pg_v210, uint8_t* pg_le, uint32_t w,
-                                 uint32_t h) {
+static int st20_v210_to_rfc4175_422le10_scalar(uint8_t* pg_v210, uint8_t* pg_le,
+                                               uint32_t w, uint32_t h) {
   uint32_t pg_count = w * h / 2;
   if (pg_count % 3 != 0) {
     err("%s, invalid pg_count %d, pixel group number must be multiple of 3!\n", __func__,
@@ -1240,6 +2171,21 @@ int st20_v210_to_rfc4175_422le10(uint8_t* pg_v210, uint8_t* pg_le, uint32_t w,
   return 0;
 }
 
+int st20_v210_to_rfc4175_422le10(uint8_t* pg_v210, uint8_t* pg_le, uint32_t w,
+                                 uint32_t h) {
+#ifdef MTL_HAS_AVX2
+  if (mtl_get_simd_level() >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    int ret = st20_v210_to_rfc4175_422le10_avx2(pg_v210, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_v210_to_rfc4175_422le10_scalar(pg_v210, pg_le, w, h);
+}
+
 int st20_rfc4175_422be10_to_v210_scalar(uint8_t* pg_be, uint8_t* pg_v210, uint32_t w,
                                         uint32_t h) {
   uint32_t pg_count = w * h / 2;
@@ -1308,6 +2254,15 @@ int st20_rfc4175_422be10_to_v210_simd(struct st20_rfc4175_422_10_pg2_be* pg_be,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_v210_avx2(pg_be, pg_v210, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_v210_scalar((uint8_t*)pg_be, pg_v210, w, h);
 }
@@ -1414,6 +2369,15 @@ int st20_v210_to_rfc4175_422be10_simd(uint8_t* pg_v210,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_v210_to_rfc4175_422be10_avx2(pg_v210, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_v210_to_rfc4175_422be10_scalar(pg_v210, (uint8_t*)pg_be, w, h);
 }
@@ -1488,6 +2452,15 @@ int st20_rfc4175_422be10_to_y210_simd(struct st20_rfc4175_422_10_pg2_be* pg_be,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_y210_avx2(pg_be, pg_y210, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_y210_scalar(pg_be, pg_y210, w, h);
 }
@@ -1558,6 +2531,15 @@ int st20_y210_to_rfc4175_422be10_simd(uint16_t* pg_y210,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_y210_to_rfc4175_422be10_avx2(pg_y210, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_y210_to_rfc4175_422be10_scalar(pg_y210, pg_be, w, h);
 }
@@ -1618,7 +2600,41 @@ int st20_yuv422p12le_to_rfc4175_422be12_simd(uint16_t* y, uint16_t* b, uint16_t*
                                              struct st20_rfc4175_422_12_pg2_be* pg,
                                              uint32_t w, uint32_t h,
                                              enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422be12_avx512_vbmi(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422be12_avx512(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422be12_avx2(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_yuv422p12le_to_rfc4175_422be12_scalar(y, b, r, pg, w, h);
 }
 
@@ -1673,6 +2689,15 @@ int st20_rfc4175_422be12_to_yuv422p12le_simd(struct st20_rfc4175_422_12_pg2_be*
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be12_to_yuv422p12le_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be12_to_yuv422p12le_scalar(pg, y, b, r, w, h);
 }
@@ -1704,9 +2729,9 @@ int st20_rfc4175_422be12_to_yuv422p12le_simd_dma(mtl_udma_handle udma,
   return st20_rfc4175_422be12_to_yuv422p12le_scalar(pg_be, y, b, r, w, h);
 }
 
-int st20_yuv422p12le_to_rfc4175_422le12(uint16_t* y, uint16_t* b, uint16_t* r,
-                                        struct st20_rfc4175_422_12_pg2_le* pg, uint32_t w,
-                                        uint32_t h) {
+static int st20_yuv422p12le_to_rfc4175_422le12_scalar(
+    uint16_t* y, uint16_t* b, uint16_t* r, struct st20_rfc4175_422_12_pg2_le* pg,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 2; /* two pgs in one convert */
   uint16_t cb, y0, cr, y1;
 
@@ -1725,15 +2750,54 @@ int st20_yuv422p12le_to_rfc4175_422le12(uint16_t* y, uint16_t* b, uint16_t* r,
     pg->Y01 = y1;
     pg->Y01_ = y1 >> 4;
 
-    pg++;
+    pg++;
+  }
+
+  return 0;
+}
+
+int st20_yuv422p12le_to_rfc4175_422le12(uint16_t* y, uint16_t* b, uint16_t* r,
+                                        struct st20_rfc4175_422_12_pg2_le* pg, uint32_t w,
+                                        uint32_t h) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422le12_avx512_vbmi(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422le12_avx512(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
   }
+#endif
 
-  return 0;
+#ifdef MTL_HAS_AVX2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_yuv422p12le_to_rfc4175_422le12_avx2(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  return st20_yuv422p12le_to_rfc4175_422le12_scalar(y, b, r, pg, w, h);
 }
 
-int st20_rfc4175_422le12_to_yuv422p12le(struct st20_rfc4175_422_12_pg2_le* pg,
-                                        uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w,
-                                        uint32_t h) {
+static int st20_rfc4175_422le12_to_yuv422p12le_scalar(
+    struct st20_rfc4175_422_12_pg2_le* pg, uint16_t* y, uint16_t* b, uint16_t* r,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 2; /* two pgs in one convert */
   uint16_t cb, y0, cr, y1;
 
@@ -1753,6 +2817,45 @@ int st20_rfc4175_422le12_to_yuv422p12le(struct st20_rfc4175_422_12_pg2_le* pg,
   return 0;
 }
 
+int st20_rfc4175_422le12_to_yuv422p12le(struct st20_rfc4175_422_12_pg2_le* pg,
+                                        uint16_t* y, uint16_t* b, uint16_t* r, uint32_t w,
+                                        uint32_t h) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_yuv422p12le_avx512_vbmi(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_yuv422p12le_avx512(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_yuv422p12le_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  return st20_rfc4175_422le12_to_yuv422p12le_scalar(pg, y, b, r, w, h);
+}
+
 int st20_rfc4175_422be12_to_422le12_scalar(struct st20_rfc4175_422_12_pg2_be* pg_be,
                                            struct st20_rfc4175_422_12_pg2_le* pg_le,
                                            uint32_t w, uint32_t h) {
@@ -1791,6 +2894,16 @@ int st20_rfc4175_422be12_to_422le12_simd(struct st20_rfc4175_422_12_pg2_be* pg_b
   MT_MAY_UNUSED(cpu_level);
   MT_MAY_UNUSED(ret);
 
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_422be12_to_422le12_avx512_vbmi(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
 #ifdef MTL_HAS_AVX512
   if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
     dbg("%s, avx512 ways\n", __func__);
@@ -1800,6 +2913,15 @@ int st20_rfc4175_422be12_to_422le12_simd(struct st20_rfc4175_422_12_pg2_be* pg_b
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be12_to_422le12_avx2(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be12_to_422le12_scalar(pg_be, pg_le, w, h);
 }
@@ -1863,7 +2985,41 @@ int st20_rfc4175_422le12_to_422be12_simd(struct st20_rfc4175_422_12_pg2_le* pg_l
                                          struct st20_rfc4175_422_12_pg2_be* pg_be,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_422be12_avx512_vbmi(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_422be12_avx512(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422le12_to_422be12_avx2(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_422le12_to_422be12_scalar(pg_le, pg_be, w, h);
 }
 
@@ -1923,7 +3079,41 @@ int st20_444p10le_to_rfc4175_444be10_simd(uint16_t* y_g, uint16_t* b_r, uint16_t
                                           struct st20_rfc4175_444_10_pg4_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444be10_avx512_vbmi(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444be10_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444be10_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_444p10le_to_rfc4175_444be10_scalar(y_g, b_r, r_b, pg, w, h);
 }
 
@@ -1970,13 +3160,47 @@ int st20_rfc4175_444be10_to_444p10le_simd(struct st20_rfc4175_444_10_pg4_be* pg,
                                           uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx512_vbmi(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444be10_to_444p10le_scalar(pg, y_g, b_r, r_b, w, h);
 }
 
-int st20_444p10le_to_rfc4175_444le10(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
-                                     struct st20_rfc4175_444_10_pg4_le* pg, uint32_t w,
-                                     uint32_t h) {
+static int st20_444p10le_to_rfc4175_444le10_scalar(
+    uint16_t* y_g, uint16_t* b_r, uint16_t* r_b, struct st20_rfc4175_444_10_pg4_le* pg,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 4; /* four pgs in one convert */
   uint16_t cb_r0, y_g0, cr_b0, cb_r1, y_g1, cr_b1, cb_r2, y_g2, cr_b2, cb_r3, y_g3, cr_b3;
 
@@ -2025,9 +3249,48 @@ int st20_444p10le_to_rfc4175_444le10(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b
   return 0;
 }
 
-int st20_rfc4175_444le10_to_444p10le(struct st20_rfc4175_444_10_pg4_le* pg, uint16_t* y_g,
-                                     uint16_t* b_r, uint16_t* r_b, uint32_t w,
+int st20_444p10le_to_rfc4175_444le10(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                     struct st20_rfc4175_444_10_pg4_le* pg, uint32_t w,
                                      uint32_t h) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444le10_avx512_vbmi(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444le10_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444le10_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  return st20_444p10le_to_rfc4175_444le10_scalar(y_g, b_r, r_b, pg, w, h);
+}
+
+static int st20_rfc4175_444le10_to_444p10le_scalar(
+    struct st20_rfc4175_444_10_pg4_le* pg, uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 4; /* four pgs in one convert */
   uint16_t cb_r0, y_g0, cr_b0, cb_r1, y_g1, cr_b1, cb_r2, y_g2, cr_b2, cb_r3, y_g3, cr_b3;
 
@@ -2063,6 +3326,45 @@ int st20_rfc4175_444le10_to_444p10le(struct st20_rfc4175_444_10_pg4_le* pg, uint
   return 0;
 }
 
+int st20_rfc4175_444le10_to_444p10le(struct st20_rfc4175_444_10_pg4_le* pg, uint16_t* y_g,
+                                     uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                     uint32_t h) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444le10_to_444p10le_avx512_vbmi(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444le10_to_444p10le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444le10_to_444p10le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  return st20_rfc4175_444le10_to_444p10le_scalar(pg, y_g, b_r, r_b, w, h);
+}
+
 int st20_rfc4175_444be10_to_444le10_scalar(struct st20_rfc4175_444_10_pg4_be* pg_be,
                                            struct st20_rfc4175_444_10_pg4_le* pg_le,
                                            uint32_t w, uint32_t h) {
@@ -2108,18 +3410,52 @@ int st20_rfc4175_444be10_to_444le10_scalar(struct st20_rfc4175_444_10_pg4_be* pg
     pg_le->Cr_B03 = cr_b3;
     pg_le->Cr_B03_ = cr_b3 >> 2;
 
-    pg_be++;
-    pg_le++;
+    pg_be++;
+    pg_le++;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_444be10_to_444le10_simd(struct st20_rfc4175_444_10_pg4_be* pg_be,
+                                         struct st20_rfc4175_444_10_pg4_le* pg_le,
+                                         uint32_t w, uint32_t h,
+                                         enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444le10_avx512_vbmi(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444le10_avx512(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
   }
+#endif
 
-  return 0;
-}
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444le10_avx2(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
 
-int st20_rfc4175_444be10_to_444le10_simd(struct st20_rfc4175_444_10_pg4_be* pg_be,
-                                         struct st20_rfc4175_444_10_pg4_le* pg_le,
-                                         uint32_t w, uint32_t h,
-                                         enum mtl_simd_level level) {
-  /* the only option */
+  /* the last option */
   return st20_rfc4175_444be10_to_444le10_scalar(pg_be, pg_le, w, h);
 }
 
@@ -2179,7 +3515,41 @@ int st20_rfc4175_444le10_to_444be10_simd(struct st20_rfc4175_444_10_pg4_le* pg_l
                                          struct st20_rfc4175_444_10_pg4_be* pg_be,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444le10_to_444be10_avx512_vbmi(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444le10_to_444be10_avx512(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444le10_to_444be10_avx2(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444le10_to_444be10_scalar(pg_le, pg_be, w, h);
 }
 
@@ -2221,7 +3591,41 @@ int st20_444p12le_to_rfc4175_444be12_simd(uint16_t* y_g, uint16_t* b_r, uint16_t
                                           struct st20_rfc4175_444_12_pg2_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444be12_avx512_vbmi(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444be12_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444be12_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_444p12le_to_rfc4175_444be12_scalar(y_g, b_r, r_b, pg, w, h);
 }
 
@@ -2256,13 +3660,47 @@ int st20_rfc4175_444be12_to_444p12le_simd(struct st20_rfc4175_444_12_pg2_be* pg,
                                           uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx512_vbmi(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444be12_to_444p12le_scalar(pg, y_g, b_r, r_b, w, h);
 }
 
-int st20_444p12le_to_rfc4175_444le12(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
-                                     struct st20_rfc4175_444_12_pg2_le* pg, uint32_t w,
-                                     uint32_t h) {
+static int st20_444p12le_to_rfc4175_444le12_scalar(
+    uint16_t* y_g, uint16_t* b_r, uint16_t* r_b, struct st20_rfc4175_444_12_pg2_le* pg,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 2; /* two pgs in one convert */
   uint16_t cb_r0, y_g0, cr_b0, cb_r1, y_g1, cr_b1;
 
@@ -2293,9 +3731,48 @@ int st20_444p12le_to_rfc4175_444le12(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b
   return 0;
 }
 
-int st20_rfc4175_444le12_to_444p12le(struct st20_rfc4175_444_12_pg2_le* pg, uint16_t* y_g,
-                                     uint16_t* b_r, uint16_t* r_b, uint32_t w,
+int st20_444p12le_to_rfc4175_444le12(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                     struct st20_rfc4175_444_12_pg2_le* pg, uint32_t w,
                                      uint32_t h) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444le12_avx512_vbmi(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444le12_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444le12_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  return st20_444p12le_to_rfc4175_444le12_scalar(y_g, b_r, r_b, pg, w, h);
+}
+
+static int st20_rfc4175_444le12_to_444p12le_scalar(
+    struct st20_rfc4175_444_12_pg2_le* pg, uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+    uint32_t w, uint32_t h) {
   uint32_t cnt = w * h / 2; /* two pgs in one convert */
   uint16_t cb_r0, y_g0, cr_b0, cb_r1, y_g1, cr_b1;
 
@@ -2319,6 +3796,45 @@ int st20_rfc4175_444le12_to_444p12le(struct st20_rfc4175_444_12_pg2_le* pg, uint
   return 0;
 }
 
+int st20_rfc4175_444le12_to_444p12le(struct st20_rfc4175_444_12_pg2_le* pg, uint16_t* y_g,
+                                     uint16_t* b_r, uint16_t* r_b, uint32_t w,
+                                     uint32_t h) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444le12_to_444p12le_avx512_vbmi(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX512) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444le12_to_444p12le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (cpu_level >= MTL_SIMD_LEVEL_AVX2) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444le12_to_444p12le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  return st20_rfc4175_444le12_to_444p12le_scalar(pg, y_g, b_r, r_b, w, h);
+}
+
 int st20_rfc4175_444be12_to_444le12_scalar(struct st20_rfc4175_444_12_pg2_be* pg_be,
                                            struct st20_rfc4175_444_12_pg2_le* pg_le,
                                            uint32_t w, uint32_t h) {
@@ -2357,7 +3873,41 @@ int st20_rfc4175_444be12_to_444le12_simd(struct st20_rfc4175_444_12_pg2_be* pg_b
                                          struct st20_rfc4175_444_12_pg2_le* pg_le,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444le12_avx512_vbmi(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444le12_avx512(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444le12_avx2(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444be12_to_444le12_scalar(pg_be, pg_le, w, h);
 }
 
@@ -2399,7 +3949,41 @@ int st20_rfc4175_444le12_to_444be12_simd(struct st20_rfc4175_444_12_pg2_le* pg_l
                                          struct st20_rfc4175_444_12_pg2_be* pg_be,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MT_MAY_UNUSED(cpu_level);
+  MT_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512_VBMI2
+  if ((level >= MTL_SIMD_LEVEL_AVX512_VBMI2) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512_VBMI2)) {
+    dbg("%s, avx512_vbmi ways\n", __func__);
+    ret = st20_rfc4175_444le12_to_444be12_avx512_vbmi(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512_vbmi ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444le12_to_444be12_avx512(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444le12_to_444be12_avx2(pg_le, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444le12_to_444be12_scalar(pg_le, pg_be, w, h);
 }
 
@@ -8,6 +8,11 @@
 #include <st_convert_api.h>
 #include <st_pipeline_api.h>
 
+/* max helper threads of the st_frame_convert band pool */
+#define ST_CONVERT_BAND_THREADS_MAX (7)
+/* min lines of one band, small frames are not worth to split */
+#define ST_CONVERT_BAND_MIN_LINES (64)
+
 struct st_frame_converter {
   enum st_frame_fmt src_fmt;
   enum st_frame_fmt dst_fmt;
@@ -17,4 +22,46 @@ struct st_frame_converter {
 int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
                            struct st_frame_converter* converter);
 
+/*
+ * The fixed point matrix of one RGB <-> YUV direction, the inputs are (R, G, B) or
+ * (Y, Cb, Cr) in order, also the outputs.
+ * out[k] = clamp((sum(m[k][j] * ((in[j] & in_mask) - in_off[j])) + add[k]) >> shift)
+ */
+struct st_color_coefs {
+  int16_t m[3][3];
+  int32_t add[3]; /* the output offset and the rounding */
+  int16_t in_off[3];
+  uint16_t in_mask;
+  uint16_t max; /* the max value of the output */
+  int shift;
+};
+
+int st_color_coefs_init(struct st_color_coefs* coefs, enum st_frame_color_matrix matrix,
+                        bool full_range, bool to_yuv, int rgb_depth, int yuv_depth);
+
+static inline void st_color_coefs_px(struct st_color_coefs* coefs, uint16_t in0,
+                                     uint16_t in1, uint16_t in2, uint16_t* out0,
+                                     uint16_t* out1, uint16_t* out2) {
+  int32_t v0 = (in0 & coefs->in_mask) - coefs->in_off[0];
+  int32_t v1 = (in1 & coefs->in_mask) - coefs->in_off[1];
+  int32_t v2 = (in2 & coefs->in_mask) - coefs->in_off[2];
+  uint16_t* out[3] = {out0, out1, out2};
+
+  for (int k = 0; k < 3; k++) {
+    int32_t sum = coefs->m[k][0] * v0 + coefs->m[k][1] * v1 + coefs->m[k][2] * v2;
+    int32_t o = (sum + coefs->add[k]) >> coefs->shift;
+    if (o < 0)
+      o = 0;
+    else if (o > coefs->max)
+      o = coefs->max;
+    *out[k] = o;
+  }
+}
+
+/*
+ * point the frame to the lines in [start, start + lines), all planes full height.
+ * A zero linesize is set to the least linesize of the format.
+ */
+int st_frame_band_view(struct st_frame* frame, uint32_t start, uint32_t lines);
+
 #endif
@@ -1040,6 +1040,39 @@ int st30_get_packet_size(enum st30_fmt fmt, enum st30_ptime ptime,
   return sample_size * sample_num * channel;
 }
 
+/* the count of ptime packets in one pipeline frame, at least one */
+int st30_frame_pkts(enum st30_ptime ptime, uint32_t frame_time_us) {
+  double pkt_time = st30_get_packet_time(ptime);
+  int pkts;
+
+  if (pkt_time <= 0) {
+    err("%s, invalid ptime %d\n", __func__, ptime);
+    return -EINVAL;
+  }
+
+  pkts = (double)frame_time_us * 1000 / pkt_time + 0.5;
+  return RTE_MAX(pkts, 1);
+}
+
+/* the sample size of the pipeline frame, -EINVAL if not support the transport fmt */
+int st30_frame_sample_size(enum st30_frame_fmt fmt, enum st30_fmt tfmt) {
+  switch (fmt) {
+    case ST30_FRAME_FMT_TRANSPORT:
+      return st30_get_sample_size(tfmt);
+    case ST30_FRAME_FMT_S32LE:
+      if ((tfmt == ST30_FMT_PCM16) || (tfmt == ST30_FMT_PCM24)) return 4;
+      break;
+    case ST30_FRAME_FMT_AES3:
+      if (tfmt == ST31_FMT_AM824) return sizeof(struct st31_aes3);
+      break;
+    default:
+      break;
+  }
+
+  err("%s, fmt %d not support transport fmt %d\n", __func__, fmt, tfmt);
+  return -EINVAL;
+}
+
 void st_frame_init_plane_single_src(struct st_frame* frame, void* addr, mtl_iova_t iova) {
   uint8_t planes = st_frame_fmt_planes(frame->fmt);
 
@@ -5,6 +5,7 @@
 #ifndef _ST_LIB_FMT_HEAD_H_
 #define _ST_LIB_FMT_HEAD_H_
 
+#include <st30_pipeline_api.h>
 #include <st_convert_api.h>
 #include <st_pipeline_api.h>
 
@@ -45,6 +46,10 @@ int st22_rtp_bandwidth_bps(uint32_t total_pkts, uint16_t pkt_size, enum st_fps f
 
 int st22_frame_bandwidth_bps(size_t frame_size, enum st_fps fps, uint64_t* bps);
 
+int st30_frame_pkts(enum st30_ptime ptime, uint32_t frame_time_us);
+
+int st30_frame_sample_size(enum st30_frame_fmt fmt, enum st30_fmt tfmt);
+
 static inline void st20_unpack_pg2be_422le10(struct st20_rfc4175_422_10_pg2_be* pg,
                                              uint16_t* cb00, uint16_t* y00,
                                              uint16_t* cr00, uint16_t* y01) {
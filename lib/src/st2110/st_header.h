@@ -8,10 +8,13 @@
 #include "../mt_header.h"
 #include "st20_api.h"
 #include "st30_api.h"
+#include "st30_pipeline_api.h"
 #include "st40_api.h"
+#include "st40_pipeline_api.h"
 #include "st_convert.h"
 #include "st_fmt.h"
 #include "st_pipeline_api.h"
+#include "st_rx_group_api.h"
 #include "st_pkt.h"
 
 #define ST_MAX_NAME_LEN (32)
@@ -62,11 +65,15 @@
 /* max converter devices number */
 #define ST_MAX_CONVERTER_DEV (8)
 /* max sessions number per encoder */
-#define ST_MAX_SESSIONS_PER_ENCODER (16)
+#define ST_MAX_SESSIONS_PER_ENCODER (64)
 /* max sessions number per decoder */
-#define ST_MAX_SESSIONS_PER_DECODER (16)
+#define ST_MAX_SESSIONS_PER_DECODER (64)
 /* max sessions number per converter */
 #define ST_MAX_SESSIONS_PER_CONVERTER (16)
+/* max cached self benchmark results(format pair and resolution) per plugin device */
+#define ST_PLUGIN_MAX_BENCH (16)
+/* default timeout for the block get of pipeline sessions */
+#define ST_PIPELINE_BLOCK_TIMEOUT_NS (NS_PER_S)
 
 #define ST_TX_DUMMY_PKT_IDX (0xFFFFFFFF)
 
@@ -108,6 +115,8 @@ struct st_rx_muf_priv_data {
 #define ST_FT_FLAG_RTE_MALLOC (MTL_BIT32(0))
 /* ext frame by application */
 #define ST_FT_FLAG_EXT (MTL_BIT32(1))
+/* the iova of ext frame is from the auto map registry, put it after done */
+#define ST_FT_FLAG_EXT_AUTO_MAP (MTL_BIT32(2))
 
 /* IOVA mapping info of each page in frame, used for IOVA:PA mode */
 struct st_page_info {
@@ -228,6 +237,10 @@ struct st22_tx_video_info {
                         struct st22_tx_frame_meta* meta);
   int (*notify_frame_done)(void* priv, uint16_t frame_idx,
                            struct st22_tx_frame_meta* meta);
+  /* for ST22_TYPE_SLICE_LEVEL */
+  int (*query_frame_bytes_ready)(void* priv, uint16_t frame_idx,
+                                 struct st22_tx_slice_meta* meta);
+  size_t bytes_ready; /* codestream bytes ready of current frame */
 
   struct st22_rfc9134_rtp_hdr rtp_hdr[MTL_SESSION_PORT_MAX];
   int pkt_idx;           /* for P&F counter*/
@@ -245,6 +258,54 @@ struct st_vsync_info {
   bool init;
 };
 
+/* owner of the tx ebu trace, handed off between the tasklet and the stat thread */
+enum st_tx_video_ebu_state {
+  ST_TX_VIDEO_EBU_TRACING = 0, /* tasklet owns the trace */
+  ST_TX_VIDEO_EBU_FULL,        /* trace ready, stat thread owns it for analyse */
+  ST_TX_VIDEO_EBU_ANALYSED,    /* tasklet to reset and restart the trace */
+};
+
+/* one trace entry of the pkts bursted by the video transmitter */
+struct st_tx_video_ebu_trace {
+  uint64_t ptp;         /* burst time, converted to ptp time domain */
+  uint32_t rtp_tmstamp; /* timestamp in the rtp hdr */
+  uint32_t pkt_idx;     /* pkt index in the frame */
+};
+
+struct st_tx_video_ebu_info {
+  /* pass criteria */
+  uint32_t c_max_narrow_pass;
+  uint32_t c_max_wide_pass;
+  uint32_t vrx_full_narrow_pass;
+  uint32_t vrx_full_wide_pass;
+  int32_t rtp_offset_max_pass;
+
+  /* value of last analysed trace */
+  int32_t cinst_max;
+  int32_t vrx_min;
+  int32_t vrx_max;
+  int32_t fpt_min;
+  int32_t fpt_max;
+  int32_t rtp_offset_min;
+  int32_t rtp_offset_max;
+};
+
+struct st_tx_video_ebu_result {
+  int ebu_result_num; /* number of analysed traces */
+  int cinst_pass_narrow;
+  int cinst_pass_wide;
+  int cinst_fail;
+  int vrx_pass_narrow;
+  int vrx_pass_wide;
+  int vrx_fail;
+  int fpt_pass;
+  int fpt_fail;
+  int rtp_offset_pass;
+  int rtp_offset_fail;
+  int compliance;
+  int compliance_narrow;
+};
+
 struct st_tx_video_session_impl {
   struct mtl_main_impl* impl;
   struct st_tx_video_sessions_mgr* mgr;
@@ -257,6 +318,8 @@ struct st_tx_video_session_impl {
   struct rte_mempool* mbuf_mempool_copy_chain;
   bool tx_mono_pool;   /* if reuse tx mono pool */
   bool tx_no_chain;    /* if tx not use chain mbuf */
+  /* if redundant pkts refer the payload of primary pkts in no chain mode */
+  bool tx_r_shared;
   bool multi_src_port; /* if tx use multiple src port */
   /* if the eth dev support chain buff */
   bool eth_has_chain[MTL_SESSION_PORT_MAX];
@@ -325,6 +388,14 @@ struct st_tx_video_session_impl {
   uint16_t st20_frame_idx; /* current frame index */
   enum st21_tx_frame_status st20_frame_stat;
   uint16_t st20_frame_lines_ready;
+  /* next frame got from app and prefetched before the boundary of current frame */
+  bool next_frame_prepared;
+  bool next_frame_prefetched; /* first lines prefetched in the tail of current frame */
+  uint16_t next_frame_idx;
+  uint64_t next_frame_prepared_tsc;
+  /* user frame mode, app fills the payload by uframe_pg_callback */
+  struct st20_tx_uframe_pg_meta pg_meta;
+  uint8_t black_pg[16]; /* one black pgroup to fill the pkt of the uframe pg fail */
 
   struct st20_pgroup st20_pg;
   struct st_fps_timing fps_tm;
@@ -358,6 +429,15 @@ struct st_tx_video_session_impl {
   struct mt_rtcp_tx* rtcp_tx[MTL_SESSION_PORT_MAX];
   struct mt_rxq_entry* rtcp_q[MTL_SESSION_PORT_MAX];
 
+  /* ebu(st2110-21) check on the burst trace of primary port, debug usage only */
+  struct st_tx_video_ebu_trace* ebu_trace;
+  uint32_t ebu_trace_max; /* max entries in ebu_trace */
+  uint32_t ebu_trace_cnt; /* recorded entries, only touched by the tasklet */
+  /* enum st_tx_video_ebu_state, the handoff between the tasklet and stat thread */
+  rte_atomic32_t ebu_trace_state;
+  struct st_tx_video_ebu_info ebu_info;
+  struct st_tx_video_ebu_result ebu_result;
+
   /* use atomic safe? */
   struct st20_tx_port_status port_user_stats[MTL_SESSION_PORT_MAX];
 
@@ -368,6 +448,7 @@ struct st_tx_video_session_impl {
   int stat_pkts_burst;
   int stat_pkts_burst_dummy;
   int stat_pkts_chain_realloc_fail;
+  int stat_pkts_uframe_pg_fail; /* uframe_pg_callback fail, the payload is black */
   int stat_trs_ret_code[MTL_SESSION_PORT_MAX];
   int stat_build_ret_code;
   uint64_t stat_last_time;
@@ -380,7 +461,7 @@ struct st_tx_video_session_impl {
   uint32_t stat_exceed_frame_time;
   bool stat_user_busy_first;
   uint32_t stat_user_busy;       /* get_next_frame or dequeue_bulk from rtp ring fail */
-  uint32_t stat_lines_not_ready; /* query app lines not ready */
+  uint32_t stat_lines_not_ready; /* query app lines(st22 bytes) not ready */
   uint32_t stat_vsync_mismatch;
   uint32_t stat_tx_done_cleanup;
   uint64_t stat_bytes_tx[MTL_SESSION_PORT_MAX];
@@ -390,6 +471,9 @@ struct st_tx_video_session_impl {
   uint32_t stat_max_notify_frame_us;
   uint32_t stat_unrecoverable_error;
   uint32_t stat_recoverable_error;
+  uint32_t stat_next_frame_prepared;
+  uint32_t stat_min_next_frame_early_us; /* min time the next frame ready before used */
+  uint32_t stat_max_next_frame_early_us;
 };
 
 struct st_tx_video_sessions_mgr {
@@ -562,12 +646,51 @@ struct st_rx_video_detector {
   struct st20_detect_meta meta;
 };
 
+/* the codestream segments of one frame, for ST22_RX_FLAG_CODESTREAM_SEGMENTS */
+struct st22_rx_frame_segs {
+  struct rte_mbuf** mbufs; /* the mbuf held for each pkt, NULL if copied */
+  struct st22_codestream_seg* segs; /* by pkt idx, lost pkts are NULL/0 holes */
+  uint32_t segs_cnt;                 /* the max pkt idx received + 1 */
+};
+
 struct st22_rx_video_info {
   /* app callback */
   int (*notify_frame_ready)(void* priv, void* frame, struct st22_rx_frame_meta* meta);
+  /* for ST22_TYPE_SLICE_LEVEL */
+  int (*notify_slice_ready)(void* priv, void* frame, struct st22_rx_slice_meta* meta);
 
   struct st22_rx_frame_meta meta;
+  struct st22_rx_slice_meta slice_meta;
   size_t cur_frame_size; /* size per frame */
+
+  /* for ST22_RX_FLAG_CODESTREAM_SEGMENTS, indexed by the frame idx */
+  struct st22_rx_frame_segs* frame_segs;
+  uint32_t max_segs;         /* max pkts per frame */
+  unsigned int pool_reserve; /* the free mbufs kept for the rx queue */
+  bool pool_low;             /* copy the payload as the mempool is running low */
+  uint32_t stat_segs_held;
+  uint32_t stat_segs_copied;
+};
+
+/* the decimated preview sampled from the pkts of one frame */
+struct st20_rx_preview_info {
+  int (*notify_preview_ready)(void* priv, struct st20_rx_preview_meta* meta);
+
+  uint8_t scale;
+  uint16_t interval;
+  uint32_t width;  /* preview width, even */
+  uint32_t height; /* preview height, per field for interlaced */
+  size_t linesize;
+  uint8_t* buf; /* ST20_FMT_YUV_422_8BIT */
+  size_t size;
+
+  bool active;      /* sampling the frame of tmstamp */
+  uint32_t tmstamp; /* the frame on sampling */
+  uint32_t frame_cnt;
+  struct st20_rx_preview_meta meta;
+
+  uint32_t stat_previews;
+  uint32_t stat_previews_dropped;
 };
 
 struct st_rx_video_hdr_split_info {
@@ -614,6 +737,7 @@ struct st_rx_video_session_impl {
   struct st22_rx_video_session_handle_impl* st22_handle;
 
   struct st22_rx_video_info* st22_info;
+  struct st20_rx_preview_info* preview;
 
   bool is_hdr_split;
   struct st_rx_video_hdr_split_info hdr_split_info[MTL_SESSION_PORT_MAX];
@@ -794,6 +918,7 @@ struct st_tx_audio_session_impl {
   struct rte_ring* packet_ring;
   bool pacing_in_build; /* if control pacing in the build stage */
   bool time_measure;
+  struct mt_event_fd event; /* for ST30_TX_FLAG_EVENT_FD */
 
   uint16_t st30_frames_cnt; /* numbers of frames requested */
   struct st_frame_trans* st30_frames;
@@ -926,6 +1051,7 @@ struct st_rx_audio_session_impl {
   struct st_rx_session_priv priv[MTL_SESSION_PORT_MAX];
   struct st_rx_audio_session_handle_impl* st30_handle;
   bool time_measure;
+  struct mt_event_fd event; /* for ST30_RX_FLAG_EVENT_FD */
 
   enum mtl_port port_maps[MTL_SESSION_PORT_MAX];
   struct mt_rxq_entry* rxq[MTL_SESSION_PORT_MAX];
@@ -1013,6 +1139,7 @@ struct st_tx_ancillary_session_impl {
   int inflight_cnt[MTL_SESSION_PORT_MAX]; /* for stats */
   struct rte_ring* packet_ring;
   bool time_measure;
+  struct mt_event_fd event; /* for ST40_TX_FLAG_EVENT_FD */
 
   uint32_t max_pkt_len; /* max data len(byte) for each pkt */
 
@@ -1086,6 +1213,7 @@ struct st_rx_ancillary_session_impl {
   struct st_rx_session_priv priv[MTL_SESSION_PORT_MAX];
   struct st_rx_ancillary_session_handle_impl* st40_handle;
   bool time_measure;
+  struct mt_event_fd event; /* for ST40_RX_FLAG_EVENT_FD */
 
   enum mtl_port port_maps[MTL_SESSION_PORT_MAX];
   struct mt_rxq_entry* rxq[MTL_SESSION_PORT_MAX];
@@ -1137,6 +1265,9 @@ struct st22_get_encoder_request {
   struct st22_encode_frame_meta* (*get_frame)(void* priv);
   int (*put_frame)(void* priv, struct st22_encode_frame_meta* frame, int result);
   int (*dump)(void* priv);
+  /* for the slice_enabled encoder */
+  uint16_t (*get_frame_lines)(void* priv, struct st22_encode_frame_meta* frame);
+  int (*put_frame_bytes)(void* priv, struct st22_encode_frame_meta* frame, size_t bytes);
 };
 
 struct st22_get_decoder_request {
@@ -1147,6 +1278,12 @@ struct st22_get_decoder_request {
   struct st22_decode_frame_meta* (*get_frame)(void* priv);
   int (*put_frame)(void* priv, struct st22_decode_frame_meta* frame, int result);
   int (*dump)(void* priv);
+  /* for the slice_enabled decoder */
+  size_t (*get_frame_bytes)(void* priv, struct st22_decode_frame_meta* frame,
+                            bool* complete);
+  /* for the decoder keeps the dst as reference */
+  int (*hold_frame)(void* priv, struct st22_decode_frame_meta* frame);
+  int (*release_frame)(void* priv, struct st22_decode_frame_meta* frame);
 };
 
 struct st20_get_converter_request {
@@ -1159,11 +1296,21 @@ struct st20_get_converter_request {
   int (*dump)(void* priv);
 };
 
+/* the self benchmark result of one format pair at one resolution */
+struct st_plugin_bench {
+  enum st_frame_fmt input_fmt;
+  enum st_frame_fmt output_fmt;
+  uint32_t width;
+  uint32_t height;
+  double pixel_rate; /* pixels per second, < 0 if not supported, 0 if unknown */
+};
+
 struct st22_encode_session_impl {
   int idx;
   void* parent; /* point to struct st22_encode_dev_impl */
   st22_encode_priv session;
   enum mt_handle_type type; /* for sanity check */
+  double load; /* the pixel rate of this session */
 
   size_t codestream_max_size;
 
@@ -1177,6 +1324,12 @@ struct st22_encode_dev_impl {
   char name[ST_MAX_NAME_LEN];
   struct st22_encoder_dev dev;
   rte_atomic32_t ref_cnt;
+  /* the pixel rate of all sessions, protected by the mgr lock */
+  double load;
+  struct st_plugin_bench bench[ST_PLUGIN_MAX_BENCH];
+  int bench_cnt; /* the entries ever stored, bench is a ring of ST_PLUGIN_MAX_BENCH */
+  /* the lib workers shared by all sessions, only if worker_cnt set by dev */
+  struct st_plugin_batch* batch;
   struct st22_encode_session_impl sessions[ST_MAX_SESSIONS_PER_ENCODER];
 };
 
@@ -1185,6 +1338,7 @@ struct st22_decode_session_impl {
   void* parent; /* point to struct st22_decode_dev_impl */
   st22_decode_priv session;
   enum mt_handle_type type; /* for sanity check */
+  double load; /* the pixel rate of this session */
 
   struct st22_get_decoder_request req;
 };
@@ -1196,6 +1350,12 @@ struct st22_decode_dev_impl {
   char name[ST_MAX_NAME_LEN];
   struct st22_decoder_dev dev;
   rte_atomic32_t ref_cnt;
+  /* the pixel rate of all sessions, protected by the mgr lock */
+  double load;
+  struct st_plugin_bench bench[ST_PLUGIN_MAX_BENCH];
+  int bench_cnt; /* the entries ever stored, bench is a ring of ST_PLUGIN_MAX_BENCH */
+  /* the lib workers shared by all sessions, only if worker_cnt set by dev */
+  struct st_plugin_batch* batch;
   struct st22_decode_session_impl sessions[ST_MAX_SESSIONS_PER_DECODER];
 };
 
@@ -1204,6 +1364,7 @@ struct st20_convert_session_impl {
   void* parent; /* point to struct st20_convert_dev_impl */
   st20_convert_priv session;
   enum mt_handle_type type; /* for sanity check */
+  double load; /* the pixel rate of this session */
 
   struct st20_get_converter_request req;
 };
@@ -1215,6 +1376,10 @@ struct st20_convert_dev_impl {
   char name[ST_MAX_NAME_LEN];
   struct st20_converter_dev dev;
   rte_atomic32_t ref_cnt;
+  /* the pixel rate of all sessions, protected by the mgr lock */
+  double load;
+  struct st_plugin_bench bench[ST_PLUGIN_MAX_BENCH];
+  int bench_cnt; /* the entries ever stored, bench is a ring of ST_PLUGIN_MAX_BENCH */
   struct st20_convert_session_impl sessions[ST_MAX_SESSIONS_PER_CONVERTER];
 };
 
@@ -1233,6 +1398,11 @@ struct st_plugin_mgr {
   struct st22_encode_dev_impl* encode_devs[ST_MAX_ENCODER_DEV];
   struct st22_decode_dev_impl* decode_devs[ST_MAX_DECODER_DEV];
   struct st20_convert_dev_impl* convert_devs[ST_MAX_CONVERTER_DEV];
+  /* the self benchmark of the internal converters */
+  struct st_plugin_bench internal_bench[ST_PLUGIN_MAX_BENCH];
+  int internal_bench_cnt; /* the entries ever stored, a ring as the dev bench */
+  /* the pixel rate of the sessions using the internal converters */
+  double internal_load;
   pthread_mutex_t plugins_lock; /* lock for plugins */
   struct st_dl_plugin_impl* plugins[ST_MAX_DL_PLUGINS];
   int plugins_nb;
@@ -1309,4 +1479,11 @@ static inline bool st20_is_frame_type(enum st20_type type) {
     return false;
 }
 
+static inline bool st22_is_frame_type(enum st22_type type) {
+  if ((type == ST22_TYPE_FRAME_LEVEL) || (type == ST22_TYPE_SLICE_LEVEL))
+    return true;
+  else
+    return false;
+}
+
 #endif
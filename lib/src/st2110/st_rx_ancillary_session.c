@@ -121,6 +121,7 @@ static int rx_ancillary_session_handle_pkt(struct mtl_main_impl* impl,
   uint64_t tsc_start = 0;
   if (s->time_measure) tsc_start = mt_get_tsc(impl);
   ops->notify_rtp_ready(ops->priv);
+  mt_event_fd_notify(&s->event);
   if (s->time_measure) {
     uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
     s->stat_max_notify_rtp_us = RTE_MAX(s->stat_max_notify_rtp_us, delta_us);
@@ -316,6 +317,7 @@ static int rx_ancillary_session_attach(struct mtl_main_impl* impl,
   int idx = s->idx, num_port = ops->num_port;
   char* ports[MTL_SESSION_PORT_MAX];
 
+  s->event.fd = -1;
   for (int i = 0; i < num_port; i++) ports[i] = ops->port[i];
   ret = mt_build_port_map(impl, ports, s->port_maps, num_port);
   if (ret < 0) return ret;
@@ -359,6 +361,17 @@ static int rx_ancillary_session_attach(struct mtl_main_impl* impl,
     return -EIO;
   }
 
+  if (ops->flags & ST40_RX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&s->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      rx_ancillary_session_uinit_mcast(impl, s);
+      rx_ancillary_session_uinit_sw(impl, s);
+      rx_ancillary_session_uinit_hw(impl, s);
+      return ret;
+    }
+  }
+
   s->attached = true;
   info("%s(%d), succ\n", __func__, idx);
   return 0;
@@ -400,6 +413,7 @@ static int rx_ancillary_session_detach(struct mtl_main_impl* impl,
   rx_ancillary_session_uinit_mcast(impl, s);
   rx_ancillary_session_uinit_sw(impl, s);
   rx_ancillary_session_uinit_hw(impl, s);
+  mt_event_fd_uinit(&s->event);
   return 0;
 }
 
@@ -825,6 +839,7 @@ void* st40_rx_get_mbuf(st40_rx_handle handle, void** usrptr, uint16_t* len) {
     return NULL;
   }
 
+  mt_event_fd_ack(&s->event);
   ret = rte_ring_sc_dequeue(packet_ring, (void**)&pkt);
   if (ret == 0) {
     int header_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) +
@@ -875,3 +890,21 @@ int st40_rx_get_queue_meta(st40_rx_handle handle, struct st_queue_meta* meta) {
 
   return 0;
 }
+
+int st40_rx_get_event_fd(st40_rx_handle handle) {
+  struct st_rx_ancillary_session_handle_impl* s_impl = handle;
+  struct st_rx_ancillary_session_impl* s;
+
+  if (s_impl->type != MT_HANDLE_RX_ANC) {
+    err("%s, invalid type %d\n", __func__, s_impl->type);
+    return -EIO;
+  }
+
+  s = s_impl->impl;
+  if (s->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, s->idx);
+    return -EIO;
+  }
+
+  return s->event.fd;
+}
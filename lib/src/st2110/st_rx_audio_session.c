@@ -455,6 +455,8 @@ static int rx_audio_session_handle_frame_pkt(struct mtl_main_impl* impl,
     if (ret < 0) {
       err("%s(%d), notify_frame_ready return fail %d\n", __func__, s->idx, ret);
       rx_audio_session_put_frame(s, s->st30_cur_frame);
+    } else {
+      mt_event_fd_notify(&s->event);
     }
     s->frame_recv_size = 0;
     s->st30_pkt_idx = 0;
@@ -507,6 +509,7 @@ static int rx_audio_session_handle_rtp_pkt(struct mtl_main_impl* impl,
   rte_mbuf_refcnt_update(mbuf, 1); /* free when app put */
 
   ops->notify_rtp_ready(ops->priv);
+  mt_event_fd_notify(&s->event);
   s->st30_stat_pkts_received++;
 
   if (mt_has_ebu(impl) && inf->feature & MT_IF_FEATURE_RX_OFFLOAD_TIMESTAMP) {
@@ -703,6 +706,7 @@ static int rx_audio_session_attach(struct mtl_main_impl* impl,
   int idx = s->idx, num_port = ops->num_port;
   char* ports[MTL_SESSION_PORT_MAX];
 
+  s->event.fd = -1;
   for (int i = 0; i < num_port; i++) ports[i] = ops->port[i];
   ret = mt_build_port_map(impl, ports, s->port_maps, num_port);
   if (ret < 0) return ret;
@@ -777,6 +781,17 @@ static int rx_audio_session_attach(struct mtl_main_impl* impl,
     return -EIO;
   }
 
+  if (ops->flags & ST30_RX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&s->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      rx_audio_session_uinit_mcast(impl, s);
+      rx_audio_session_uinit_sw(impl, s);
+      rx_audio_session_uinit_hw(impl, s);
+      return ret;
+    }
+  }
+
   s->attached = true;
   info("%s(%d), pkt_len %u frame_size %" PRId64 "\n", __func__, idx, s->pkt_len,
        s->st30_frame_size);
@@ -832,6 +847,7 @@ static int rx_audio_session_detach(struct mtl_main_impl* impl,
   rx_audio_session_uinit_mcast(impl, s);
   rx_audio_session_uinit_sw(impl, s);
   rx_audio_session_uinit_hw(impl, s);
+  mt_event_fd_uinit(&s->event);
   return 0;
 }
 
@@ -1261,6 +1277,7 @@ int st30_rx_put_framebuff(st30_rx_handle handle, void* frame) {
   }
 
   s = s_impl->impl;
+  mt_event_fd_ack(&s->event);
 
   return rx_audio_session_put_frame(s, frame);
 }
@@ -1285,6 +1302,7 @@ void* st30_rx_get_mbuf(st30_rx_handle handle, void** usrptr, uint16_t* len) {
     return NULL;
   }
 
+  mt_event_fd_ack(&s->event);
   ret = rte_ring_sc_dequeue(rtps_ring, (void**)&pkt);
   if (ret < 0) {
     dbg("%s(%d), rtp ring is empty\n", __func__, idx);
@@ -1336,3 +1354,21 @@ int st30_rx_get_queue_meta(st30_rx_handle handle, struct st_queue_meta* meta) {
 
   return 0;
 }
+
+int st30_rx_get_event_fd(st30_rx_handle handle) {
+  struct st_rx_audio_session_handle_impl* s_impl = handle;
+  struct st_rx_audio_session_impl* s;
+
+  if (s_impl->type != MT_HANDLE_RX_AUDIO) {
+    err("%s, invalid type %d\n", __func__, s_impl->type);
+    return -EIO;
+  }
+
+  s = s_impl->impl;
+  if (s->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, s->idx);
+    return -EIO;
+  }
+
+  return s->event.fd;
+}
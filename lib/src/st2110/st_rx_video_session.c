@@ -607,9 +607,24 @@ static struct st_frame_trans* rv_get_frame(struct st_rx_video_session_impl* s) {
   return NULL;
 }
 
+static void rv_st22_segs_release(struct st22_rx_frame_segs* frame_segs) {
+  for (uint32_t i = 0; i < frame_segs->segs_cnt; i++) {
+    if (frame_segs->mbufs[i]) {
+      rte_pktmbuf_free(frame_segs->mbufs[i]);
+      frame_segs->mbufs[i] = NULL;
+    }
+    frame_segs->segs[i].addr = NULL;
+    frame_segs->segs[i].len = 0;
+  }
+  frame_segs->segs_cnt = 0;
+}
+
 static int rv_put_frame(struct st_rx_video_session_impl* s,
                         struct st_frame_trans* frame) {
   dbg("%s(%d), put frame at %d\n", __func__, s->idx, frame->idx);
+  /* release the pkts held by the frame before it's free */
+  if (s->st22_info && s->st22_info->frame_segs)
+    rv_st22_segs_release(&s->st22_info->frame_segs[frame->idx]);
   rte_atomic32_dec(&frame->refcnt);
   return 0;
 }
@@ -1111,6 +1126,70 @@ static inline int st22_notify_frame_ready(struct st_rx_video_session_impl* s, vo
   return ret;
 }
 
+static void rv_preview_frame_start(struct st_rx_video_session_impl* s,
+                                   uint32_t tmstamp) {
+  struct st20_rx_preview_info* preview = s->preview;
+
+  preview->frame_cnt++;
+  if (preview->frame_cnt < preview->interval) return;
+  preview->frame_cnt = 0;
+
+  /* previous one not notified as the frame is lost */
+  if (preview->active) preview->stat_previews_dropped++;
+  preview->active = true;
+  preview->tmstamp = tmstamp;
+}
+
+/* sample the preview from one row segment of the pkt payload */
+static void rv_preview_add(struct st_rx_video_session_impl* s, uint8_t* payload,
+                           uint16_t line, uint16_t pixel_offset, uint16_t length) {
+  struct st20_rx_preview_info* preview = s->preview;
+  struct st20_pgroup* pg = &s->st20_pg;
+  uint32_t scale = preview->scale;
+
+  if (line % scale) return; /* not a sampled line */
+  uint32_t row = line / scale;
+  if (row >= preview->height) return;
+
+  /* the preview pixels in [start, end) of this segment */
+  uint32_t pixels = length / pg->size * pg->coverage;
+  uint32_t start = (pixel_offset + scale - 1) / scale;
+  uint32_t end = (pixel_offset + pixels + scale - 1) / scale;
+  if (end > preview->width) end = preview->width;
+
+  bool is_10bit = (s->ops.fmt == ST20_FMT_YUV_422_10BIT);
+  uint8_t* dst = preview->buf + row * preview->linesize;
+  uint8_t* src;
+  for (uint32_t x = start; x < end; x++) {
+    /* scale is even, the sampled pixel is always the Y0 of one pgroup */
+    src = payload + (x * scale - pixel_offset) / pg->coverage * pg->size;
+    /* 8 msb of Cb Y0 Cr Y1, Cb for the even preview pixel and Cr for the odd one */
+    if (is_10bit) {
+      dst[x * 2] = (x & 1) ? (((src[2] & 0x0f) << 4) | (src[3] >> 4)) : src[0];
+      dst[x * 2 + 1] = ((src[1] & 0x3f) << 2) | (src[2] >> 6);
+    } else {
+      dst[x * 2] = (x & 1) ? src[2] : src[0];
+      dst[x * 2 + 1] = src[1];
+    }
+  }
+}
+
+static void rv_preview_frame_done(struct st_rx_video_session_impl* s,
+                                  struct st_rx_video_slot_impl* slot,
+                                  enum st_frame_status status) {
+  struct st20_rx_preview_info* preview = s->preview;
+  struct st20_rx_preview_meta* meta = &preview->meta;
+
+  if (!preview->active || (preview->tmstamp != slot->tmstamp)) return;
+  preview->active = false;
+
+  meta->timestamp = slot->tmstamp;
+  meta->second_field = slot->second_field;
+  meta->status = status;
+  preview->notify_preview_ready(s->ops.priv, meta);
+  preview->stat_previews++;
+}
+
 static void rv_frame_notify(struct st_rx_video_session_impl* s,
                             struct st_rx_video_slot_impl* slot) {
   struct st20_rx_ops* ops = &s->ops;
@@ -1135,6 +1214,12 @@ static void rv_frame_notify(struct st_rx_video_session_impl* s,
   meta->frame_total_size = s->st20_frame_size;
   meta->uframe_total_size = s->st20_uframe_size;
   meta->frame_recv_size = rv_slot_get_frame_size(s, slot);
+  if (s->preview) {
+    rv_preview_frame_done(s, slot,
+                          (meta->frame_recv_size >= s->st20_frame_size)
+                              ? ST_FRAME_STATUS_COMPLETE
+                              : ST_FRAME_STATUS_CORRUPTED);
+  }
   if (slot->frame->user_meta_data_size) {
     meta->user_meta_size = slot->frame->user_meta_data_size;
     meta->user_meta = slot->frame->user_meta;
@@ -1201,6 +1286,11 @@ static void rv_st22_frame_notify(struct st_rx_video_session_impl* s,
   meta->timestamp = slot->tmstamp;
   meta->frame_total_size = rv_slot_get_frame_size(s, slot);
   meta->status = status;
+  if (s->st22_info->frame_segs) {
+    struct st22_rx_frame_segs* frame_segs = &s->st22_info->frame_segs[slot->frame->idx];
+    meta->segs = frame_segs->segs;
+    meta->segs_cnt = frame_segs->segs_cnt;
+  }
 
   /* notify frame */
   int ret = -EIO;
@@ -1244,12 +1334,30 @@ static void rv_st22_frame_notify(struct st_rx_video_session_impl* s,
   s->st22_expect_frame_size = 0;
 }
 
+static void rv_st22_slice_notify(struct st_rx_video_session_impl* s,
+                                 struct st_rx_video_slot_impl* slot,
+                                 struct st_rx_video_slot_slice_info* slice_info) {
+  struct st22_rx_video_info* st22_info = s->st22_info;
+  struct st22_rx_slice_meta* meta = &st22_info->slice_meta;
+
+  meta->timestamp = slot->tmstamp;
+  /* the main slice is the received codestream without any gap */
+  meta->frame_recv_size = slice_info->slices[0].size;
+  st22_info->notify_slice_ready(s->ops.priv, slot->frame->addr, meta);
+  s->stat_slices_received++;
+}
+
 static void rv_slice_notify(struct st_rx_video_session_impl* s,
                             struct st_rx_video_slot_impl* slot,
                             struct st_rx_video_slot_slice_info* slice_info) {
   struct st20_rx_ops* ops = &s->ops;
   struct st20_rx_slice_meta* meta = &s->slice_meta;
 
+  if (s->st22_info) {
+    rv_st22_slice_notify(s, slot, slice_info);
+    return;
+  }
+
   /* w, h, fps, fmt, etc are fixed info */
   meta->timestamp = slot->tmstamp;
   meta->second_field = slot->second_field;
@@ -1410,6 +1518,8 @@ static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
 
   rte_atomic32_inc(&s->cbs_frame_slot_cnt);
 
+  if (s->preview) rv_preview_frame_start(s, tmstamp);
+
   dbg("%s(%d): assign slot %d framebuff %p for tmstamp %u\n", __func__, s->idx, slot_idx,
       slot->frame->addr, tmstamp);
   return slot;
@@ -1864,6 +1974,16 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   }
   slot->last_pkt_idx = pkt_idx;
 
+  /* sample the preview before the payload is passed to dma */
+  if (s->preview && s->preview->active && (s->preview->tmstamp == tmstamp)) {
+    rv_preview_add(s, payload, line1_number, line1_offset, line1_length);
+    if (extra_rtp) {
+      rv_preview_add(s, payload + line1_length,
+                     ntohs(extra_rtp->row_number) & ~ST20_SECOND_FIELD,
+                     ntohs(extra_rtp->row_offset), ntohs(extra_rtp->row_length));
+    }
+  }
+
   bool dma_copy = false;
   bool need_copy = true;
   struct mtl_dma_lender_dev* dma_dev = s->dma_dev;
@@ -2098,6 +2218,47 @@ static int rv_parse_st22_boxes(struct st_rx_video_session_impl* s, void* boxes,
   return 0;
 }
 
+/* hold the pkt as one codestream segment, ST22_RX_FLAG_CODESTREAM_SEGMENTS */
+static int rv_st22_seg_add(struct st_rx_video_session_impl* s,
+                           struct st_rx_video_slot_impl* slot, struct rte_mbuf* mbuf,
+                           int pkt_idx, uint32_t offset, void* payload, uint16_t len) {
+  struct st22_rx_video_info* st22_info = s->st22_info;
+  struct st22_rx_frame_segs* frame_segs = &st22_info->frame_segs[slot->frame->idx];
+  struct st22_codestream_seg* seg;
+
+  if (pkt_idx >= st22_info->max_segs) {
+    s->stat_pkts_idx_oo_bitmap++;
+    return -EIO;
+  }
+  seg = &frame_segs->segs[pkt_idx];
+
+  /*
+   * the held mbufs may starve the rx queue refill, check the mempool for every pkt.
+   * The ring count skips the lcore caches, it's cheap and never over reports.
+   */
+  st22_info->pool_low = rte_mempool_ops_get_count(mbuf->pool) < st22_info->pool_reserve;
+
+  if (st22_info->pool_low) {
+    /* copy to the framebuffer as the fallback */
+    seg->addr = slot->frame->addr + offset;
+    rte_memcpy(seg->addr, payload, len);
+    st22_info->stat_segs_copied++;
+  } else {
+    rte_mbuf_refcnt_update(mbuf, 1); /* free when the frame put */
+    frame_segs->mbufs[pkt_idx] = mbuf;
+    seg->addr = payload;
+    st22_info->stat_segs_held++;
+  }
+  seg->len = len;
+  /*
+   * the segs are indexed by the pkt idx to keep the codestream order, a lost pkt
+   * leaves a hole of NULL addr and 0 len which is reset in rv_st22_segs_release.
+   */
+  if (pkt_idx >= frame_segs->segs_cnt) frame_segs->segs_cnt = pkt_idx + 1;
+
+  return 0;
+}
+
 static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf* mbuf,
                               enum mtl_session_port s_port, bool ctrl_thread) {
   struct st20_rx_ops* ops = &s->ops;
@@ -2215,10 +2376,18 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
     s->stat_pkts_offset_dropped++;
     return -EIO;
   }
-  rte_memcpy(slot->frame->addr + offset, payload, payload_length);
+  if (s->st22_info->frame_segs) {
+    ret = rv_st22_seg_add(s, slot, mbuf, pkt_idx, offset, payload, payload_length);
+    if (ret < 0) return ret;
+  } else {
+    rte_memcpy(slot->frame->addr + offset, payload, payload_length);
+  }
   rv_slot_add_frame_size(s, slot, payload_length);
   s->stat_pkts_received++;
   slot->pkts_received++;
+  if (slot->slice_info) { /* ST22_TYPE_SLICE_LEVEL */
+    rv_slice_add(s, slot, offset, payload_length);
+  }
 
   /* update the expect frame size */
   if (rtp->base.marker) {
@@ -2502,6 +2671,30 @@ static int rv_init_pkt_lcore(struct mtl_main_impl* impl,
   return 0;
 }
 
+static int rv_uinit_st22(struct st_rx_video_session_impl* s) {
+  struct st22_rx_video_info* st22_info = s->st22_info;
+
+  if (!st22_info) return 0;
+
+  if (st22_info->frame_segs) {
+    struct st22_rx_frame_segs* frame_segs;
+    for (int i = 0; i < s->st20_frames_cnt; i++) {
+      frame_segs = &st22_info->frame_segs[i];
+      if (frame_segs->mbufs) {
+        rv_st22_segs_release(frame_segs);
+        mt_rte_free(frame_segs->mbufs);
+      }
+      if (frame_segs->segs) mt_rte_free(frame_segs->segs);
+    }
+    mt_rte_free(st22_info->frame_segs);
+    st22_info->frame_segs = NULL;
+  }
+  mt_rte_free(st22_info);
+  s->st22_info = NULL;
+
+  return 0;
+}
+
 static int rv_init_st22(struct mtl_main_impl* impl, struct st_rx_video_session_impl* s,
                         struct st22_rx_ops* st22_frame_ops) {
   struct st22_rx_video_info* st22_info;
@@ -2510,20 +2703,116 @@ static int rv_init_st22(struct mtl_main_impl* impl, struct st_rx_video_session_i
   if (!st22_info) return -ENOMEM;
 
   st22_info->notify_frame_ready = st22_frame_ops->notify_frame_ready;
+  st22_info->notify_slice_ready = st22_frame_ops->notify_slice_ready;
 
   st22_info->meta.tfmt = ST10_TIMESTAMP_FMT_MEDIA_CLK;
+  st22_info->slice_meta.tfmt = ST10_TIMESTAMP_FMT_MEDIA_CLK;
 
   s->st22_info = st22_info;
 
+  if (st22_frame_ops->flags & ST22_RX_FLAG_CODESTREAM_SEGMENTS) {
+    enum mtl_port port = mt_port_logic2phy(s->port_maps, MTL_SESSION_PORT_P);
+    int soc_id = mt_socket_id(impl, port);
+    uint16_t frames_cnt = s->st20_frames_cnt;
+    uint32_t max_segs = s->st20_frame_bitmap_size * 8;
+    struct st22_rx_frame_segs* frame_segs;
+
+    frame_segs = mt_rte_zmalloc_socket(sizeof(*frame_segs) * frames_cnt, soc_id);
+    if (!frame_segs) {
+      err("%s(%d), frame segs malloc fail\n", __func__, s->idx);
+      rv_uinit_st22(s);
+      return -ENOMEM;
+    }
+    st22_info->frame_segs = frame_segs;
+    for (uint16_t i = 0; i < frames_cnt; i++) {
+      frame_segs[i].mbufs =
+          mt_rte_zmalloc_socket(sizeof(*frame_segs[i].mbufs) * max_segs, soc_id);
+      frame_segs[i].segs =
+          mt_rte_zmalloc_socket(sizeof(*frame_segs[i].segs) * max_segs, soc_id);
+      if (!frame_segs[i].mbufs || !frame_segs[i].segs) {
+        err("%s(%d), segs malloc fail at %u\n", __func__, s->idx, i);
+        rv_uinit_st22(s);
+        return -ENOMEM;
+      }
+    }
+    st22_info->max_segs = max_segs;
+    /* keep one full rx ring of free mbufs for the queue refill */
+    st22_info->pool_reserve = mt_if_nb_rx_desc(impl, port);
+    info("%s(%d), codestream segments with max %u segs, pool reserve %u\n", __func__,
+         s->idx, max_segs, st22_info->pool_reserve);
+  }
+
   return 0;
 }
 
-static int rv_uinit_st22(struct st_rx_video_session_impl* s) {
-  if (s->st22_info) {
-    mt_rte_free(s->st22_info);
-    s->st22_info = NULL;
+static int rv_uinit_preview(struct st_rx_video_session_impl* s) {
+  struct st20_rx_preview_info* preview = s->preview;
+
+  if (!preview) return 0;
+
+  if (preview->buf) {
+    mt_rte_free(preview->buf);
+    preview->buf = NULL;
+  }
+  mt_rte_free(preview);
+  s->preview = NULL;
+
+  return 0;
+}
+
+static int rv_init_preview(struct mtl_main_impl* impl,
+                           struct st_rx_video_session_impl* s) {
+  struct st20_rx_ops* ops = &s->ops;
+  int idx = s->idx;
+  int soc_id = mt_socket_id(impl, MTL_PORT_P);
+  struct st20_rx_preview_info* preview;
+  uint8_t scale = ops->preview_scale;
+  uint32_t height = ops->interlaced ? (ops->height >> 1) : ops->height;
+
+  /* sampled from the pkt directly, only the 422 formats */
+  if ((ops->fmt != ST20_FMT_YUV_422_10BIT) && (ops->fmt != ST20_FMT_YUV_422_8BIT)) {
+    err("%s(%d), preview not support fmt %s\n", __func__, idx,
+        st20_frame_fmt_name(ops->fmt));
+    return -EINVAL;
   }
 
+  preview = mt_rte_zmalloc_socket(sizeof(*preview), soc_id);
+  if (!preview) return -ENOMEM;
+  s->preview = preview;
+
+  preview->notify_preview_ready = ops->notify_preview_ready;
+  preview->scale = scale;
+  preview->interval = ops->preview_interval ? ops->preview_interval : 1;
+  /* the first frame has one preview */
+  preview->frame_cnt = preview->interval - 1;
+  preview->width = (ops->width / scale) & ~1U;
+  preview->height = height / scale;
+  if (!preview->width || !preview->height) {
+    err("%s(%d), invalid preview %ux%u\n", __func__, idx, preview->width,
+        preview->height);
+    rv_uinit_preview(s);
+    return -EINVAL;
+  }
+  preview->linesize = preview->width * 2;
+  preview->size = preview->linesize * preview->height;
+  preview->buf = mt_rte_zmalloc_socket(preview->size, soc_id);
+  if (!preview->buf) {
+    err("%s(%d), preview buf malloc fail\n", __func__, idx);
+    rv_uinit_preview(s);
+    return -ENOMEM;
+  }
+
+  struct st20_rx_preview_meta* meta = &preview->meta;
+  meta->addr = preview->buf;
+  meta->width = preview->width;
+  meta->height = preview->height;
+  meta->linesize = preview->linesize;
+  meta->size = preview->size;
+  meta->fmt = ST20_FMT_YUV_422_8BIT;
+  meta->tfmt = ST10_TIMESTAMP_FMT_MEDIA_CLK;
+
+  info("%s(%d), preview %ux%u scale %u interval %u\n", __func__, idx, preview->width,
+       preview->height, scale, preview->interval);
   return 0;
 }
 
@@ -2534,6 +2823,7 @@ static int rv_uinit_sw(struct mtl_main_impl* impl, struct st_rx_video_session_im
   rv_free_frames(s);
   rv_free_rtps(s);
   rv_uinit_st22(s);
+  rv_uinit_preview(s);
   return 0;
 }
 
@@ -2577,6 +2867,15 @@ static int rv_init_sw(struct mtl_main_impl* impl, struct st_rx_video_sessions_mg
     return ret;
   }
 
+  if (ops->preview_scale && !st22_ops) {
+    ret = rv_init_preview(impl, s);
+    if (ret < 0) {
+      err("%s(%d), preview init fail %d\n", __func__, idx, ret);
+      rv_uinit_sw(impl, s);
+      return ret;
+    }
+  }
+
   if (type == ST20_TYPE_SLICE_LEVEL) {
     struct st20_rx_slice_meta* slice_meta = &s->slice_meta;
     slice_meta->width = ops->width;
@@ -3186,6 +3485,9 @@ static int rv_attach(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr
     s->st20_frame_size = st22_ops->framebuff_max_size;
     s->st20_fb_size = s->st20_frame_size;
     s->st22_ops_flags = st22_ops->flags;
+    /* slice of the codestream bytes */
+    s->slice_size = st22_ops->slice_size;
+    if (!s->slice_size) s->slice_size = s->st20_frame_size / 32;
   } else
     s->st20_frame_size = ops->width * ops->height * s->st20_pg.size / s->st20_pg.coverage;
   s->st20_uframe_size = ops->uframe_size;
@@ -3498,6 +3800,18 @@ static void rv_stat(struct st_rx_video_sessions_mgr* mgr,
            s->stat_pkts_slice_fail);
     s->stat_pkts_slice_fail = 0;
   }
+  if (s->st22_info && s->st22_info->frame_segs) {
+    notice("RX_VIDEO_SESSION(%d,%d): codestream segs held %u copied %u\n", m_idx, idx,
+           s->st22_info->stat_segs_held, s->st22_info->stat_segs_copied);
+    s->st22_info->stat_segs_held = 0;
+    s->st22_info->stat_segs_copied = 0;
+  }
+  if (s->preview) {
+    notice("RX_VIDEO_SESSION(%d,%d): previews %u dropped %u\n", m_idx, idx,
+           s->preview->stat_previews, s->preview->stat_previews_dropped);
+    s->preview->stat_previews = 0;
+    s->preview->stat_previews_dropped = 0;
+  }
   if (s->stat_pkts_slice_merged) {
     notice("RX_VIDEO_SESSION(%d,%d): pkts %d merged as slice\n", m_idx, idx,
            s->stat_pkts_slice_merged);
@@ -3926,6 +4240,27 @@ static int rv_ops_check(struct st20_rx_ops* ops) {
     }
   }
 
+  if (ops->preview_scale) {
+    uint8_t scale = ops->preview_scale;
+    if (!st20_is_frame_type(type)) {
+      err("%s, preview only for frame or slice type\n", __func__);
+      return -EINVAL;
+    }
+    if ((scale != 2) && (scale != 4) && (scale != 8) && (scale != 16)) {
+      err("%s, invalid preview_scale %u\n", __func__, scale);
+      return -EINVAL;
+    }
+    if (!ops->notify_preview_ready) {
+      err("%s, pls set notify_preview_ready\n", __func__);
+      return -EINVAL;
+    }
+    if (ops->flags & ST20_RX_FLAG_HDR_SPLIT) {
+      /* the payload is not walked by cpu in hdr split mode */
+      err("%s, preview not support hdr split\n", __func__);
+      return -EINVAL;
+    }
+  }
+
   if (ops->uframe_size) {
     if (!ops->uframe_pg_callback) {
       err("%s, pls set uframe_pg_callback\n", __func__);
@@ -3985,7 +4320,7 @@ static int rv_st22_ops_check(struct st22_rx_ops* ops) {
     }
   }
 
-  if (ops->type == ST22_TYPE_FRAME_LEVEL) {
+  if (st22_is_frame_type(ops->type)) {
     if ((ops->framebuff_cnt < 2) || (ops->framebuff_cnt > ST22_FB_MAX_COUNT)) {
       err("%s, invalid framebuff_cnt %d, should in range [2:%d]\n", __func__,
           ops->framebuff_cnt, ST22_FB_MAX_COUNT);
@@ -4005,6 +4340,26 @@ static int rv_st22_ops_check(struct st22_rx_ops* ops) {
     }
   }
 
+  if (ops->type == ST22_TYPE_SLICE_LEVEL) {
+    if (!ops->notify_slice_ready) {
+      err("%s, pls set notify_slice_ready\n", __func__);
+      return -EINVAL;
+    }
+    if (!(ops->flags & ST22_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)) {
+      err("%s, pls enable ST22_RX_FLAG_RECEIVE_INCOMPLETE_FRAME for slice mode\n",
+          __func__);
+      return -EINVAL;
+    }
+  }
+
+  if (ops->flags & ST22_RX_FLAG_CODESTREAM_SEGMENTS) {
+    if (ops->type != ST22_TYPE_FRAME_LEVEL) {
+      err("%s, codestream segments only for frame level, type %d\n", __func__,
+          ops->type);
+      return -EINVAL;
+    }
+  }
+
   if (ops->type == ST22_TYPE_RTP_LEVEL) {
     if (ops->rtp_ring_size <= 0) {
       err("%s, invalid rtp_ring_size %d\n", __func__, ops->rtp_ring_size);
@@ -4478,6 +4833,8 @@ st22_rx_handle st22_rx_create(mtl_handle mt, struct st22_rx_ops* ops) {
   st20_ops.pacing = ops->pacing;
   if (ops->type == ST22_TYPE_RTP_LEVEL)
     st20_ops.type = ST20_TYPE_RTP_LEVEL;
+  else if (ops->type == ST22_TYPE_SLICE_LEVEL)
+    st20_ops.type = ST20_TYPE_SLICE_LEVEL;
   else
     st20_ops.type = ST20_TYPE_FRAME_LEVEL;
   st20_ops.width = ops->width;
@@ -663,6 +663,7 @@ static int tx_ancillary_session_tasklet_frame(struct mtl_main_impl* impl,
     }
 
     tx_ancillary_session_init_next_meta(s, &meta);
+    mt_event_fd_ack(&s->event);
     /* Query next frame buffer idx */
     uint64_t tsc_start = 0;
     if (s->time_measure) tsc_start = mt_get_tsc(impl);
@@ -698,10 +699,8 @@ static int tx_ancillary_session_tasklet_frame(struct mtl_main_impl* impl,
     /* how do we split if it need two or more pkts? */
     dbg("%s(%d), st40_total_pkts %d total_udw %d meta_num %u src %p\n", __func__, idx,
         s->st40_total_pkts, total_udw, src->meta_num, src);
-    if (s->st40_total_pkts < 1) {
-      err("%s(%d), frame %u invalid st40_total_pkts %d\n", __func__, idx, next_frame_idx,
-          s->st40_total_pkts);
-    }
+    /* a frame without any ANC data still sends one packet with ANC_Count 0 */
+    if (s->st40_total_pkts < 1) s->st40_total_pkts = 1;
   }
 
   /* sync pacing */
@@ -817,6 +816,7 @@ static int tx_ancillary_session_tasklet_frame(struct mtl_main_impl* impl,
     /* end of current frame */
     if (s->ops.notify_frame_done)
       ops->notify_frame_done(ops->priv, s->st40_frame_idx, &frame->tc_meta);
+    mt_event_fd_notify(&s->event);
     if (s->time_measure) {
       uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
       s->stat_max_notify_frame_us = RTE_MAX(s->stat_max_notify_frame_us, delta_us);
@@ -905,6 +905,7 @@ static int tx_ancillary_session_tasklet_rtp(struct mtl_main_impl* impl,
   }
 
   s->ops.notify_rtp_done(s->ops.priv);
+  mt_event_fd_notify(&s->event);
 
   pkt = rte_pktmbuf_alloc(hdr_pool_p);
   if (!pkt) {
@@ -1259,6 +1260,7 @@ static int tx_ancillary_session_attach(struct mtl_main_impl* impl,
   int idx = s->idx, num_port = ops->num_port;
   char* ports[MTL_SESSION_PORT_MAX];
 
+  s->event.fd = -1;
   for (int i = 0; i < num_port; i++) ports[i] = ops->port[i];
   ret = mt_build_port_map(impl, ports, s->port_maps, num_port);
   if (ret < 0) return ret;
@@ -1325,6 +1327,15 @@ static int tx_ancillary_session_attach(struct mtl_main_impl* impl,
     return ret;
   }
 
+  if (ops->flags & ST40_TX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&s->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      tx_ancillary_session_uinit_sw(mgr, s);
+      return ret;
+    }
+  }
+
   info("%s(%d), succ\n", __func__, idx);
   return 0;
 }
@@ -1381,6 +1392,7 @@ static int tx_ancillary_session_detach(struct st_tx_ancillary_sessions_mgr* mgr,
                                        struct st_tx_ancillary_session_impl* s) {
   tx_ancillary_session_stat(s);
   tx_ancillary_session_uinit_sw(mgr, s);
+  mt_event_fd_uinit(&s->event);
   return 0;
 }
 
@@ -1769,6 +1781,7 @@ void* st40_tx_get_mbuf(st40_tx_handle handle, void** usrptr) {
     return NULL;
   }
 
+  mt_event_fd_ack(&s->event);
   if (rte_ring_full(packet_ring)) {
     dbg("%s(%d), packet ring is full\n", __func__, idx);
     return NULL;
@@ -1822,6 +1835,24 @@ int st40_tx_put_mbuf(st40_tx_handle handle, void* mbuf, uint16_t len) {
   return 0;
 }
 
+int st40_tx_get_event_fd(st40_tx_handle handle) {
+  struct st_tx_ancillary_session_handle_impl* s_impl = handle;
+  struct st_tx_ancillary_session_impl* s;
+
+  if (s_impl->type != MT_HANDLE_TX_ANC) {
+    err("%s, invalid type %d\n", __func__, s_impl->type);
+    return -EIO;
+  }
+
+  s = s_impl->impl;
+  if (s->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, s->idx);
+    return -EIO;
+  }
+
+  return s->event.fd;
+}
+
 int st40_tx_update_destination(st40_tx_handle handle, struct st_tx_dest_info* dst) {
   struct st_tx_ancillary_session_handle_impl* s_impl = handle;
   struct st_tx_ancillary_session_impl* s;
@@ -589,6 +589,7 @@ static int tx_audio_session_tasklet_frame(struct mtl_main_impl* impl,
       }
 
       tx_audio_session_init_next_meta(s, &meta);
+      mt_event_fd_ack(&s->event);
       /* Query next frame buffer idx */
       if (s->time_measure) tsc_start = mt_get_tsc(impl);
       ret = ops->get_next_frame(ops->priv, &next_frame_idx, &meta);
@@ -731,6 +732,7 @@ static int tx_audio_session_tasklet_frame(struct mtl_main_impl* impl,
     /* end of current frame */
     if (s->ops.notify_frame_done)
       ops->notify_frame_done(ops->priv, s->st30_frame_idx, &frame->ta_meta);
+    mt_event_fd_notify(&s->event);
     if (s->time_measure) {
       uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
       s->stat_max_notify_frame_us = RTE_MAX(s->stat_max_notify_frame_us, delta_us);
@@ -824,6 +826,7 @@ static int tx_audio_session_tasklet_rtp(struct mtl_main_impl* impl,
     return MT_TASKLET_ALL_DONE;
   }
   s->ops.notify_rtp_done(s->ops.priv);
+  mt_event_fd_notify(&s->event);
 
   pkt = rte_pktmbuf_alloc(hdr_pool_p);
   if (!pkt) {
@@ -1331,6 +1334,7 @@ static int tx_audio_session_attach(struct mtl_main_impl* impl,
   int idx = s->idx, num_port = ops->num_port;
   char* ports[MTL_SESSION_PORT_MAX];
 
+  s->event.fd = -1;
   for (int i = 0; i < num_port; i++) ports[i] = ops->port[i];
   ret = mt_build_port_map(impl, ports, s->port_maps, num_port);
   if (ret < 0) return ret;
@@ -1423,6 +1427,15 @@ static int tx_audio_session_attach(struct mtl_main_impl* impl,
     return ret;
   }
 
+  if (ops->flags & ST30_TX_FLAG_EVENT_FD) {
+    ret = mt_event_fd_init(&s->event);
+    if (ret < 0) {
+      err("%s(%d), event fd init fail %d\n", __func__, idx, ret);
+      tx_audio_session_uinit_sw(mgr, s);
+      return ret;
+    }
+  }
+
   s->active = true;
 
   info("%s(%d), pkt_len %u frame_size %u fps %f\n", __func__, idx, s->pkt_len,
@@ -1552,6 +1565,7 @@ static int tx_audio_session_detach(struct st_tx_audio_sessions_mgr* mgr,
                                    struct st_tx_audio_session_impl* s) {
   tx_audio_session_stat(mgr, s);
   tx_audio_session_uinit_sw(mgr, s);
+  mt_event_fd_uinit(&s->event);
   return 0;
 }
 
@@ -2074,6 +2088,7 @@ void* st30_tx_get_mbuf(st30_tx_handle handle, void** usrptr) {
     return NULL;
   }
 
+  mt_event_fd_ack(&s->event);
   if (rte_ring_full(packet_ring)) {
     dbg("%s(%d), packet ring is full\n", __func__, idx);
     return NULL;
@@ -2127,3 +2142,21 @@ int st30_tx_put_mbuf(st30_tx_handle handle, void* mbuf, uint16_t len) {
 
   return 0;
 }
+
+int st30_tx_get_event_fd(st30_tx_handle handle) {
+  struct st_tx_audio_session_handle_impl* s_impl = handle;
+  struct st_tx_audio_session_impl* s;
+
+  if (s_impl->type != MT_HANDLE_TX_AUDIO) {
+    err("%s, invalid type %d\n", __func__, s_impl->type);
+    return -EIO;
+  }
+
+  s = s_impl->impl;
+  if (s->event.fd < 0) {
+    err("%s(%d), EVENT_FD flag not enabled\n", __func__, s->idx);
+    return -EIO;
+  }
+
+  return s->event.fd;
+}
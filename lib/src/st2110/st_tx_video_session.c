@@ -6,6 +6,7 @@
 
 #include <math.h>
 
+#include "../mt_dma.h"
 #include "../mt_log.h"
 #include "../mt_queue.h"
 #include "../mt_rtcp.h"
@@ -89,6 +90,27 @@ static void tv_notify_frame_done(struct st_tx_video_session_impl* s, uint16_t fr
   }
 }
 
+/* release the auto mapping of the ext frame */
+static void tv_frame_map_put(struct st_tx_video_session_impl* s,
+                             struct st_frame_trans* frame_info) {
+  if (frame_info->flags & ST_FT_FLAG_EXT_AUTO_MAP) {
+    mt_map_put(s->impl, frame_info->addr, s->st20_fb_size);
+    frame_info->flags &= ~ST_FT_FLAG_EXT_AUTO_MAP;
+  }
+}
+
+/* release the frame refcnt hold by tv_get_next_frame */
+static void tv_frame_put(struct st_tx_video_session_impl* s,
+                         struct st_frame_trans* frame_info) {
+  rte_atomic32_dec(&frame_info->refcnt);
+  /* clear ext frame info */
+  if (frame_info->flags & ST_FT_FLAG_EXT) {
+    tv_frame_map_put(s, frame_info);
+    frame_info->addr = NULL;
+    frame_info->iova = 0;
+  }
+}
+
 static void tv_frame_free_cb(void* addr, void* opaque) {
   struct st_frame_trans* frame_info = opaque;
   struct st_tx_video_session_impl* s = frame_info->priv;
@@ -98,17 +120,27 @@ static void tv_frame_free_cb(void* addr, void* opaque) {
     err("%s(%d), addr %p does not belong to frame %d\n", __func__, s_idx, addr,
         frame_idx);
 
+  /* put the mapping before app can free the buffer and reuse the va */
+  tv_frame_map_put(s, frame_info);
   tv_notify_frame_done(s, frame_idx);
-  rte_atomic32_dec(&frame_info->refcnt);
-  /* clear ext frame info */
-  if (frame_info->flags & ST_FT_FLAG_EXT) {
-    frame_info->addr = NULL;
-    frame_info->iova = 0;
-  }
+  tv_frame_put(s, frame_info);
 
   dbg("%s(%d), succ frame_idx %d\n", __func__, s_idx, frame_idx);
 }
 
+/*
+ * drop the prepared frame which never went on the wire, no notify_frame_done as it's
+ * not transmitted. Only for the session free, the other paths keep it for the next tx.
+ */
+static void tv_release_next_frame(struct st_tx_video_session_impl* s) {
+  if (!s->next_frame_prepared) return;
+
+  dbg("%s(%d), release frame %u\n", __func__, s->idx, s->next_frame_idx);
+  s->next_frame_prepared = false;
+  s->next_frame_prefetched = false;
+  tv_frame_put(s, &s->st20_frames[s->next_frame_idx]);
+}
+
 static rte_iova_t tv_frame_get_offset_iova(struct st_tx_video_session_impl* s,
                                            struct st_frame_trans* frame_info,
                                            size_t offset) {
@@ -212,6 +244,12 @@ static int tv_alloc_frames(struct mtl_main_impl* impl,
       frame_info->addr = NULL;
       frame_info->flags = ST_FT_FLAG_EXT;
       info("%s(%d), use external framebuffer, skip allocation\n", __func__, idx);
+    } else if (s->ops.uframe_pg_callback) {
+      /* user frame mode, app fills the payload of each pkt, the frame is never read */
+      frame_info->iova = 0;
+      frame_info->addr = NULL;
+      frame_info->flags = 0;
+      dbg("%s(%d), user frame mode, skip allocation\n", __func__, idx);
     } else {
       void* frame = mt_rte_zmalloc_socket(s->st20_fb_size, soc_id);
       if (!frame) {
@@ -249,8 +287,11 @@ static int tv_alloc_frames(struct mtl_main_impl* impl,
 static int tv_free_frames(struct st_tx_video_session_impl* s) {
   if (s->st20_frames) {
     struct st_frame_trans* frame;
+
+    tv_release_next_frame(s);
     for (int i = 0; i < s->st20_frames_cnt; i++) {
       frame = &s->st20_frames[i];
+      tv_frame_map_put(s, frame);
       st_frame_trans_uinit(frame);
     }
 
@@ -883,6 +924,260 @@ static int tv_init_rtcp(struct mtl_main_impl* impl, struct st_tx_video_sessions_
   return 0;
 }
 
+static inline double tv_ebu_pass_rate(struct st_tx_video_ebu_result* ebu_result,
+                                      int pass) {
+  return (double)pass * 100 / ebu_result->ebu_result_num;
+}
+
+static void tv_ebu_final_result(struct st_tx_video_session_impl* s) {
+  int idx = s->idx;
+  struct st_tx_video_ebu_result* ebu_result = &s->ebu_result;
+
+  if (ebu_result->ebu_result_num <= 0) {
+    err("%s(%d), ebu result not enough\n", __func__, idx);
+    return;
+  }
+
+  critical("st20(%d), [ --- Total %d ---  Compliance Rate Narrow %.2f%%  Wide %.2f%% ]\n",
+           idx, ebu_result->ebu_result_num,
+           tv_ebu_pass_rate(ebu_result, ebu_result->compliance_narrow),
+           tv_ebu_pass_rate(ebu_result,
+                            ebu_result->compliance - ebu_result->compliance_narrow));
+  critical("st20(%d), [ Cinst ]\t| Narrow %.2f%% | Wide %.2f%% | Fail %.2f%% |\n", idx,
+           tv_ebu_pass_rate(ebu_result, ebu_result->cinst_pass_narrow),
+           tv_ebu_pass_rate(ebu_result, ebu_result->cinst_pass_wide),
+           tv_ebu_pass_rate(ebu_result, ebu_result->cinst_fail));
+  critical("st20(%d), [ VRX ]\t| Narrow %.2f%% | Wide %.2f%% | Fail %.2f%% |\n", idx,
+           tv_ebu_pass_rate(ebu_result, ebu_result->vrx_pass_narrow),
+           tv_ebu_pass_rate(ebu_result, ebu_result->vrx_pass_wide),
+           tv_ebu_pass_rate(ebu_result, ebu_result->vrx_fail));
+  critical("st20(%d), [ TRO ]\t| Pass %.2f%% | Fail %.2f%% |\n", idx,
+           tv_ebu_pass_rate(ebu_result, ebu_result->fpt_pass),
+           tv_ebu_pass_rate(ebu_result, ebu_result->fpt_fail));
+  critical("st20(%d), [ RTP Offset ]\t| Pass %.2f%% | Fail %.2f%% |\n", idx,
+           tv_ebu_pass_rate(ebu_result, ebu_result->rtp_offset_pass),
+           tv_ebu_pass_rate(ebu_result, ebu_result->rtp_offset_fail));
+}
+
+/* run the st2110-21 model over the burst trace */
+static void tv_ebu_analyse(struct st_tx_video_session_impl* s) {
+  struct st_tx_video_pacing* pacing = &s->pacing;
+  struct st_tx_video_ebu_info* ebu_info = &s->ebu_info;
+  struct st_tx_video_ebu_result* ebu_result = &s->ebu_result;
+  double trs = pacing->trs, frame_time = pacing->frame_time;
+  double tvd = 0, cinst_initial_time = 0;
+  int32_t vrx_prev = 0, vrx_drained_prev = 0;
+  bool compliant = true, compliant_narrow = true;
+  char* cinst_result;
+  char* vrx_result;
+  char* fpt_result;
+  char* rtp_offset_result;
+  int idx = s->idx;
+
+  ebu_info->cinst_max = 0;
+  ebu_info->vrx_min = INT_MAX;
+  ebu_info->vrx_max = INT_MIN;
+  ebu_info->fpt_min = INT_MAX;
+  ebu_info->fpt_max = INT_MIN;
+  ebu_info->rtp_offset_min = INT_MAX;
+  ebu_info->rtp_offset_max = INT_MIN;
+
+  for (uint32_t i = 0; i < s->ebu_trace_cnt; i++) {
+    struct st_tx_video_ebu_trace* trace = &s->ebu_trace[i];
+
+    if (!trace->pkt_idx) { /* start of new frame */
+      uint64_t epochs = (double)trace->ptp / frame_time;
+      double epoch_tmstamp = (double)epochs * frame_time;
+      int32_t fpt = (double)trace->ptp - epoch_tmstamp;
+      uint32_t tmstamp32 = (uint64_t)(epochs * pacing->frame_time_sampling);
+      int32_t rtp_offset = trace->rtp_tmstamp - tmstamp32;
+
+      ebu_info->fpt_min = RTE_MIN(fpt, ebu_info->fpt_min);
+      ebu_info->fpt_max = RTE_MAX(fpt, ebu_info->fpt_max);
+      ebu_info->rtp_offset_min = RTE_MIN(rtp_offset, ebu_info->rtp_offset_min);
+      ebu_info->rtp_offset_max = RTE_MAX(rtp_offset, ebu_info->rtp_offset_max);
+
+      tvd = epoch_tmstamp + pacing->tr_offset;
+      cinst_initial_time = trace->ptp;
+      vrx_prev = 0;
+      vrx_drained_prev = 0;
+    }
+
+    /* vrx */
+    double packet_delta_ns = (double)trace->ptp - tvd;
+    int32_t drained = (packet_delta_ns + trs) / trs;
+    int32_t vrx_cur = vrx_prev + 1 - (drained - vrx_drained_prev);
+    ebu_info->vrx_min = RTE_MIN(vrx_cur, ebu_info->vrx_min);
+    ebu_info->vrx_max = RTE_MAX(vrx_cur, ebu_info->vrx_max);
+    vrx_prev = vrx_cur;
+    vrx_drained_prev = drained;
+
+    /* cinst */
+    int exp_cin_pkts =
+        ((trace->ptp - cinst_initial_time) / trs) * ST_EBU_CINST_DRAIN_FACTOR;
+    int32_t cinst = RTE_MAX(0, (int32_t)trace->pkt_idx - exp_cin_pkts);
+    ebu_info->cinst_max = RTE_MAX(cinst, ebu_info->cinst_max);
+  }
+
+  ebu_result->ebu_result_num++;
+
+  if (ebu_info->cinst_max <= ebu_info->c_max_narrow_pass) {
+    ebu_result->cinst_pass_narrow++;
+    cinst_result = ST_EBU_PASS_NARROW;
+  } else if (ebu_info->cinst_max <= ebu_info->c_max_wide_pass) {
+    ebu_result->cinst_pass_wide++;
+    compliant_narrow = false;
+    cinst_result = ST_EBU_PASS_WIDE;
+  } else {
+    ebu_result->cinst_fail++;
+    compliant = false;
+    cinst_result = ST_EBU_FAIL;
+  }
+
+  if ((ebu_info->vrx_min >= 0) && (ebu_info->vrx_max <= ebu_info->vrx_full_narrow_pass)) {
+    ebu_result->vrx_pass_narrow++;
+    vrx_result = ST_EBU_PASS_NARROW;
+  } else if ((ebu_info->vrx_min >= 0) &&
+             (ebu_info->vrx_max <= ebu_info->vrx_full_wide_pass)) {
+    ebu_result->vrx_pass_wide++;
+    compliant_narrow = false;
+    vrx_result = ST_EBU_PASS_WIDE;
+  } else {
+    ebu_result->vrx_fail++;
+    compliant = false;
+    vrx_result = ST_EBU_FAIL;
+  }
+
+  if ((ebu_info->fpt_min >= 0) && (ebu_info->fpt_max <= pacing->tr_offset)) {
+    ebu_result->fpt_pass++;
+    fpt_result = ST_EBU_PASS;
+  } else {
+    ebu_result->fpt_fail++;
+    compliant = false;
+    fpt_result = ST_EBU_FAIL;
+  }
+
+  if ((ebu_info->rtp_offset_min >= ST_EBU_RTP_OFFSET_MIN) &&
+      (ebu_info->rtp_offset_max <= ebu_info->rtp_offset_max_pass)) {
+    ebu_result->rtp_offset_pass++;
+    rtp_offset_result = ST_EBU_PASS;
+  } else {
+    ebu_result->rtp_offset_fail++;
+    compliant = false;
+    rtp_offset_result = ST_EBU_FAIL;
+  }
+
+  if (compliant) {
+    ebu_result->compliance++;
+    if (compliant_narrow) ebu_result->compliance_narrow++;
+  }
+
+  info("%s(%d), %u pkts, Cinst MAX %d test %s!\n", __func__, idx, s->ebu_trace_cnt,
+       ebu_info->cinst_max, cinst_result);
+  info("%s(%d), VRX MIN %d MAX %d test %s!\n", __func__, idx, ebu_info->vrx_min,
+       ebu_info->vrx_max, vrx_result);
+  info("%s(%d), TRO %.2f FPT MIN %d MAX %d test %s!\n", __func__, idx,
+       pacing->tr_offset, ebu_info->fpt_min, ebu_info->fpt_max, fpt_result);
+  info("%s(%d), RTP Offset MIN %d MAX %d test %s!\n", __func__, idx,
+       ebu_info->rtp_offset_min, ebu_info->rtp_offset_max, rtp_offset_result);
+}
+
+uint16_t st20_tx_ebu_on_burst(struct mtl_main_impl* impl,
+                              struct st_tx_video_session_impl* s, struct rte_mbuf** pkts,
+                              uint16_t nb_pkts) {
+  int state = rte_atomic32_read(&s->ebu_trace_state);
+  uint32_t cnt;
+  uint16_t recorded = 0;
+  uint64_t cur_tsc;
+
+  if (state == ST_TX_VIDEO_EBU_FULL) return 0; /* wait the analyse in stat */
+  if (state == ST_TX_VIDEO_EBU_ANALYSED) {
+    /* restart the trace, the stat thread is done with it */
+    rte_smp_rmb();
+    s->ebu_trace_cnt = 0;
+    rte_atomic32_set(&s->ebu_trace_state, ST_TX_VIDEO_EBU_TRACING);
+  }
+
+  cnt = s->ebu_trace_cnt;
+  if ((cnt + nb_pkts) > s->ebu_trace_max) {
+    /* publish the trace entries before handing off to the stat thread */
+    rte_smp_wmb();
+    rte_atomic32_set(&s->ebu_trace_state, ST_TX_VIDEO_EBU_FULL);
+    return 0;
+  }
+
+  cur_tsc = mt_get_tsc(impl);
+  for (uint16_t i = 0; i < nb_pkts; i++) {
+    struct rte_mbuf* pkt = pkts[i];
+    uint32_t pkt_idx = st_tx_mbuf_get_idx(pkt);
+    struct st_rfc3550_rtp_hdr rtp_buf;
+    const struct st_rfc3550_rtp_hdr* rtp;
+    struct st_tx_video_ebu_trace* trace;
+
+    /* trace always start from the first pkt of a frame */
+    if (!cnt && pkt_idx) continue;
+
+    /* rtp hdr may in the chain mbuf for rtp level */
+    rtp = rte_pktmbuf_read(pkt, sizeof(struct mt_udp_hdr), sizeof(rtp_buf), &rtp_buf);
+    trace = &s->ebu_trace[cnt];
+    /* convert to ptp time domain with the pacing target of this pkt */
+    trace->ptp = cur_tsc - st_tx_mbuf_get_tsc(pkt) + st_tx_mbuf_get_ptp(pkt);
+    trace->rtp_tmstamp = rtp ? ntohl(rtp->tmstamp) : 0;
+    trace->pkt_idx = pkt_idx;
+    cnt++;
+    recorded++;
+  }
+  s->ebu_trace_cnt = cnt;
+
+  return recorded;
+}
+
+static int tv_uinit_ebu(struct st_tx_video_session_impl* s) {
+  if (s->ebu_trace) {
+    mt_rte_free(s->ebu_trace);
+    s->ebu_trace = NULL;
+  }
+
+  return 0;
+}
+
+static int tv_init_ebu(struct mtl_main_impl* impl, struct st_tx_video_session_impl* s) {
+  int idx = s->idx;
+  struct st_tx_video_pacing* pacing = &s->pacing;
+  struct st_tx_video_ebu_info* ebu_info = &s->ebu_info;
+  int st20_total_pkts = s->st20_total_pkts;
+  double frame_time_s = pacing->frame_time / NS_PER_S;
+  /* trs = frame_time * reactive / total_pkts */
+  double reactive = pacing->trs * st20_total_pkts / pacing->frame_time;
+
+  s->ebu_trace_max = st20_total_pkts * ST_TX_VIDEO_EBU_TRACE_FRAMES;
+  s->ebu_trace = mt_rte_zmalloc_socket(sizeof(*s->ebu_trace) * s->ebu_trace_max,
+                                       mt_socket_id(impl, MTL_PORT_P));
+  if (!s->ebu_trace) {
+    err("%s(%d), ebu trace malloc fail, max %u\n", __func__, idx, s->ebu_trace_max);
+    return -ENOMEM;
+  }
+  s->ebu_trace_cnt = 0;
+  rte_atomic32_set(&s->ebu_trace_state, ST_TX_VIDEO_EBU_TRACING);
+  memset(&s->ebu_result, 0, sizeof(s->ebu_result));
+
+  ebu_info->c_max_narrow_pass =
+      RTE_MAX(4, (double)st20_total_pkts / (43200 * reactive * frame_time_s));
+  ebu_info->c_max_wide_pass =
+      RTE_MAX(16, (double)st20_total_pkts / (21600 * frame_time_s));
+  ebu_info->vrx_full_narrow_pass = RTE_MAX(8, st20_total_pkts / (27000 * frame_time_s));
+  ebu_info->vrx_full_wide_pass = RTE_MAX(720, st20_total_pkts / (300 * frame_time_s));
+  ebu_info->rtp_offset_max_pass =
+      ceil(pacing->tr_offset * pacing->frame_time_sampling / pacing->frame_time) + 1;
+
+  info("%s(%d), cmax_narrow %d cmax_wide %d vrx_full_narrow %d vrx_full_wide %d "
+       "rtp_offset_max %d, trace %u pkts\n",
+       __func__, idx, ebu_info->c_max_narrow_pass, ebu_info->c_max_wide_pass,
+       ebu_info->vrx_full_narrow_pass, ebu_info->vrx_full_wide_pass,
+       ebu_info->rtp_offset_max_pass, s->ebu_trace_max);
+  return 0;
+}
+
 static int tv_update_redundant(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt) {
   struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(pkt, struct mt_udp_hdr*);
   struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
@@ -903,6 +1198,156 @@ static int tv_update_redundant(struct st_tx_video_session_impl* s, struct rte_mb
   return 0;
 }
 
+/*
+ * build the redundant pkt for no chain mode, only the hdrs are copied to pkt_r, the
+ * payload of pkt_base is referenced by the indirect pkt_chain instead of a full copy.
+ */
+static int tv_build_redundant_shared(struct st_tx_video_session_impl* s,
+                                     struct rte_mbuf* pkt_r, struct rte_mbuf* pkt_chain,
+                                     struct rte_mbuf* pkt_base, uint16_t hdr_len) {
+  /* copy all hdrs from base pkt and update the eth/ip/udp for redundant port */
+  rte_memcpy(rte_pktmbuf_mtod(pkt_r, void*), rte_pktmbuf_mtod(pkt_base, void*), hdr_len);
+  pkt_r->data_len = hdr_len;
+  pkt_r->pkt_len = hdr_len;
+  pkt_r->l2_len = pkt_base->l2_len;
+  pkt_r->l3_len = pkt_base->l3_len;
+  pkt_r->ol_flags = pkt_base->ol_flags;
+  tv_update_redundant(s, pkt_r);
+
+  /* attach to the base pkt, refcnt of pkt_base is increased */
+  rte_pktmbuf_attach(pkt_chain, pkt_base);
+  rte_pktmbuf_adj(pkt_chain, hdr_len);
+  rte_pktmbuf_chain(pkt_r, pkt_chain);
+
+  return 0;
+}
+
+static int tv_build_st20_redundant_shared(struct st_tx_video_session_impl* s,
+                                          struct rte_mbuf* pkt_r,
+                                          struct rte_mbuf* pkt_chain,
+                                          struct rte_mbuf* pkt_base) {
+  struct st_rfc4175_video_hdr* hdr_base =
+      rte_pktmbuf_mtod(pkt_base, struct st_rfc4175_video_hdr*);
+  uint16_t hdr_len = sizeof(*hdr_base);
+
+  /* extra hdr if Continuation */
+  if (ntohs(hdr_base->rtp.row_offset) & ST20_SRD_OFFSET_CONTINUATION)
+    hdr_len += sizeof(struct st20_rfc4175_extra_rtp_hdr);
+
+  return tv_build_redundant_shared(s, pkt_r, pkt_chain, pkt_base, hdr_len);
+}
+
+static int tv_build_st22_redundant_shared(struct st_tx_video_session_impl* s,
+                                          struct rte_mbuf* pkt_r,
+                                          struct rte_mbuf* pkt_chain,
+                                          struct rte_mbuf* pkt_base) {
+  return tv_build_redundant_shared(s, pkt_r, pkt_chain, pkt_base,
+                                   sizeof(struct st22_rfc9134_video_hdr));
+}
+
+/* set the n-th component of the pgroup, the components are packed from the msb */
+static void tv_black_pg_set(uint8_t* pg, uint32_t n, uint8_t depth, uint16_t val) {
+  uint32_t bit = n * depth;
+
+  for (int i = depth - 1; i >= 0; i--, bit++) {
+    if ((val >> i) & 0x1) pg[bit / 8] |= 0x80 >> (bit % 8);
+  }
+}
+
+/* the pgroup of black pixels: Y 16 and C 128 scaled to the depth, zero for rgb */
+static int tv_init_black_pg(struct st_tx_video_session_impl* s) {
+  struct st20_pgroup* pg = &s->st20_pg;
+  uint8_t* black = s->black_pg;
+  enum st_frame_sampling sampling;
+  uint8_t depth;
+  uint32_t n = 0;
+
+  memset(black, 0, sizeof(s->black_pg));
+  if (pg->size > sizeof(s->black_pg)) {
+    err("%s(%d), pg size %u too large\n", __func__, s->idx, pg->size);
+    return -EINVAL;
+  }
+
+  switch (s->ops.fmt) {
+    case ST20_FMT_YUV_422_8BIT:
+    case ST20_FMT_YUV_422_10BIT:
+    case ST20_FMT_YUV_422_12BIT:
+    case ST20_FMT_YUV_422_16BIT:
+      sampling = ST_FRAME_SAMPLING_422;
+      break;
+    case ST20_FMT_YUV_420_8BIT:
+    case ST20_FMT_YUV_420_10BIT:
+    case ST20_FMT_YUV_420_12BIT:
+      sampling = ST_FRAME_SAMPLING_420;
+      break;
+    case ST20_FMT_YUV_444_8BIT:
+    case ST20_FMT_YUV_444_10BIT:
+    case ST20_FMT_YUV_444_12BIT:
+    case ST20_FMT_YUV_444_16BIT:
+      sampling = ST_FRAME_SAMPLING_444;
+      break;
+    default: /* rgb */
+      return 0;
+  }
+  /* 3, 2 and 1.5 components per pixel for 444, 422 and 420 */
+  uint32_t half_comps = (sampling == ST_FRAME_SAMPLING_444)   ? 6
+                        : (sampling == ST_FRAME_SAMPLING_422) ? 4
+                                                              : 3;
+  depth = pg->size * 8 * 2 / (pg->coverage * half_comps);
+
+  uint16_t y = 16 << (depth - 8), c = 128 << (depth - 8);
+  switch (sampling) {
+    case ST_FRAME_SAMPLING_422: /* Cb Y0 Cr Y1 */
+      for (uint32_t i = 0; i < pg->coverage / 2; i++) {
+        tv_black_pg_set(black, n++, depth, c);
+        tv_black_pg_set(black, n++, depth, y);
+        tv_black_pg_set(black, n++, depth, c);
+        tv_black_pg_set(black, n++, depth, y);
+      }
+      break;
+    case ST_FRAME_SAMPLING_420: /* Y00 Y01 Y10 Y11 Cb Cr */
+      for (uint32_t i = 0; i < pg->coverage / 4; i++) {
+        for (uint32_t j = 0; j < 4; j++) tv_black_pg_set(black, n++, depth, y);
+        tv_black_pg_set(black, n++, depth, c);
+        tv_black_pg_set(black, n++, depth, c);
+      }
+      break;
+    default: /* Cb Y Cr */
+      for (uint32_t i = 0; i < pg->coverage; i++) {
+        tv_black_pg_set(black, n++, depth, c);
+        tv_black_pg_set(black, n++, depth, y);
+        tv_black_pg_set(black, n++, depth, c);
+      }
+      break;
+  }
+
+  return 0;
+}
+
+/* fill the payload with the black pgroups */
+static void tv_fill_black_pg(struct st_tx_video_session_impl* s, uint8_t* payload,
+                             uint16_t len) {
+  uint8_t pg_size = s->st20_pg.size;
+
+  for (uint16_t i = 0; i + pg_size <= len; i += pg_size)
+    mtl_memcpy(payload + i, s->black_pg, pg_size);
+}
+
+/* ask app to fill the pixel groups of one line segment from the user frame */
+static inline int tv_build_uframe_pg(struct st_tx_video_session_impl* s,
+                                     uint16_t frame_idx, void* payload,
+                                     uint16_t row_number, uint16_t row_offset,
+                                     uint16_t row_length) {
+  struct st20_tx_uframe_pg_meta* pg_meta = &s->pg_meta;
+
+  pg_meta->payload = payload;
+  pg_meta->row_length = row_length;
+  pg_meta->row_number = row_number;
+  pg_meta->row_offset = row_offset;
+  pg_meta->pg_cnt = row_length / s->st20_pg.size;
+  return s->ops.uframe_pg_callback(s->ops.priv, frame_idx, pg_meta);
+}
+
 static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt) {
   struct st_rfc4175_video_hdr* hdr;
   struct rte_ipv4_hdr* ipv4;
@@ -986,7 +1431,29 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
     payload = &e_rtp[1];
   else
     payload = &rtp[1];
-  if (e_rtp && s->st20_linesize > s->st20_bytes_in_line) {
+  int ret = 0;
+  if (ops->uframe_pg_callback) {
+    /* user frame mode, app fills the payload from the user frame */
+    if (e_rtp) {
+      ret = tv_build_uframe_pg(s, frame_info->idx, payload, line1_number, line1_offset,
+                               line1_length);
+      if (ret >= 0)
+        ret = tv_build_uframe_pg(s, frame_info->idx, payload + line1_length,
+                                 line1_number + 1, 0, line2_length);
+    } else {
+      ret = tv_build_uframe_pg(s, frame_info->idx, payload, line1_number, line1_offset,
+                               left_len);
+    }
+    if (ret < 0) {
+      /*
+       * keep the pkt to not break the seq and the pacing of the frame, but never send
+       * the stale data of the reused mbuf, the receiver sees a black segment.
+       */
+      tv_fill_black_pg(s, payload, left_len);
+      dbg("%s(%d), uframe pg fail %d at pkt %d\n", __func__, s->idx, ret,
+          s->st20_pkt_idx);
+    }
+  } else if (e_rtp && s->st20_linesize > s->st20_bytes_in_line) {
     /* cross lines with padding case */
     mtl_memcpy(payload, frame_info->addr + offset, line1_length);
     mtl_memcpy(payload + line1_length,
@@ -1005,7 +1472,7 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
     ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
   }
 
-  return 0;
+  return ret;
 }
 
 static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt,
@@ -1519,6 +1986,7 @@ static int tv_tasklet_start(void* priv) {
     if (!s) continue;
     /* re-calculate the vsync */
     if (s->ops.flags & ST20_TX_FLAG_ENABLE_VSYNC) st_vsync_calculate(impl, &s->vsync);
+    /* the prepared frame is kept, its epoch is synced when it starts */
     /* calculate the pacing epoch */
     tv_init_pacing_epoch(impl, s);
     tx_video_session_put(mgr, sidx);
@@ -1529,11 +1997,91 @@ static int tv_tasklet_start(void* priv) {
 
 static int tv_tasklet_stop(void* priv) { return 0; }
 
+/* get the next frame from app, the refcnt of the frame is hold if succ */
+static int tv_get_next_frame(struct mtl_main_impl* impl,
+                             struct st_tx_video_session_impl* s,
+                             uint16_t* next_frame_idx) {
+  struct st20_tx_ops* ops = &s->ops;
+  struct st20_tx_frame_meta meta;
+  uint64_t tsc_start = 0;
+  int idx = s->idx;
+  int ret;
+
+  tv_init_next_meta(s, &meta);
+  /* Query next frame buffer idx */
+  if (s->time_measure) tsc_start = mt_get_tsc(impl);
+  ret = ops->get_next_frame(ops->priv, next_frame_idx, &meta);
+  if (s->time_measure) {
+    uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
+    s->stat_max_next_frame_us = RTE_MAX(s->stat_max_next_frame_us, delta_us);
+  }
+  if (ret < 0) { /* no frame ready from app */
+    dbg("%s(%d), get_next_frame fail %d\n", __func__, idx, ret);
+    return -EBUSY;
+  }
+  /* check frame refcnt */
+  struct st_frame_trans* frame = &s->st20_frames[*next_frame_idx];
+  int refcnt = rte_atomic32_read(&frame->refcnt);
+  if (refcnt) {
+    err("%s(%d), frame %u refcnt not zero %d\n", __func__, idx, *next_frame_idx, refcnt);
+    s->stat_build_ret_code = -STI_FRAME_APP_ERR_TX_FRAME;
+    return -EIO;
+  }
+  frame->tv_meta = meta;
+
+  frame->user_meta_data_size = 0;
+  if (meta.user_meta) {
+    if (meta.user_meta_size > frame->user_meta_buffer_size) {
+      err("%s(%d), frame %u user meta size %" PRId64 " too large\n", __func__, idx,
+          *next_frame_idx, meta.user_meta_size);
+      s->stat_build_ret_code = -STI_FRAME_APP_ERR_USER_META;
+      return -EIO;
+    }
+    s->stat_user_meta_cnt++;
+    /* copy user meta to frame meta */
+    rte_memcpy(frame->user_meta, meta.user_meta, meta.user_meta_size);
+    frame->user_meta_data_size = meta.user_meta_size;
+  }
+
+  s->stat_user_busy_first = true;
+  /* all check fine */
+  rte_atomic32_inc(&frame->refcnt);
+  return 0;
+}
+
+/*
+ * get the next frame while current frame is still transmitting, so the app latency is
+ * not on the frame boundary.
+ */
+static void tv_prepare_next_frame(struct mtl_main_impl* impl,
+                                  struct st_tx_video_session_impl* s) {
+  uint16_t next_frame_idx = 0;
+  int ret;
+
+  ret = tv_get_next_frame(impl, s, &next_frame_idx);
+  if (ret < 0) return;
+
+  s->next_frame_idx = next_frame_idx;
+  s->next_frame_prepared_tsc = mt_get_tsc(impl);
+  s->next_frame_prepared = true;
+  s->next_frame_prefetched = false;
+}
+
+/* prefetch the first lines of the frame, close enough to the use to stay in cache */
+static inline void tv_prefetch_frame(struct st_tx_video_session_impl* s,
+                                     struct st_frame_trans* frame) {
+  uint8_t* addr = frame->addr;
+  size_t size = RTE_MIN(s->st20_linesize * ST_TX_VIDEO_PREFETCH_LINES, s->st20_fb_size);
+
+  if (!addr) return;
+  for (size_t offset = 0; offset < size; offset += RTE_CACHE_LINE_SIZE)
+    rte_prefetch0(addr + offset);
+}
+
 static int tv_tasklet_frame(struct mtl_main_impl* impl,
                             struct st_tx_video_session_impl* s) {
   unsigned int bulk = s->bulk;
   unsigned int n;
-  int idx = s->idx;
   struct st20_tx_ops* ops = &s->ops;
   struct st_tx_video_pacing* pacing = &s->pacing;
   int ret;
@@ -1581,90 +2129,75 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
   if (0 == s->st20_pkt_idx) {
     if (ST21_TX_STAT_WAIT_FRAME == s->st20_frame_stat) {
       uint16_t next_frame_idx = 0;
-      struct st20_tx_frame_meta meta;
-      uint64_t tsc_start = 0;
-
-      tv_init_next_meta(s, &meta);
-      /* Query next frame buffer idx */
-      if (s->time_measure) tsc_start = mt_get_tsc(impl);
-      ret = ops->get_next_frame(ops->priv, &next_frame_idx, &meta);
-      if (s->time_measure) {
-        uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
-        s->stat_max_next_frame_us = RTE_MAX(s->stat_max_next_frame_us, delta_us);
-      }
-      if (ret < 0) { /* no frame ready from app */
-        if (s->stat_user_busy_first) {
-          s->stat_user_busy++;
-          s->stat_user_busy_first = false;
-          dbg("%s(%d), get_next_frame fail %d\n", __func__, idx, ret);
-        }
-        if (s->tx_done_cleanup[MTL_SESSION_PORT_P] &&
-            (mt_get_tsc(impl) > pacing->tsc_time_cursor)) {
-          /* flush tx queue to cleanup all mbufs, for tv_frame_free_cb */
-          dbg("%s(%d), tx done cleanup %u\n", __func__, s->idx,
-              s->tx_done_cleanup[MTL_SESSION_PORT_P]);
-          for (int i = 0; i < num_port; i++) {
-            struct rte_mbuf* pad = s->pad[i][ST20_PKT_TYPE_NORMAL];
-            if (!pad) continue;
-
-            rte_mbuf_refcnt_update(pad, 1);
-            uint16_t tx = mt_txq_burst(s->queue[i], &pad, 1);
-            if (tx < 1) {
-              rte_mbuf_refcnt_update(pad, -1);
-            } else {
-              s->tx_done_cleanup[i]--;
-              s->stat_tx_done_cleanup++;
+      bool prefetched = false;
+
+      if (s->next_frame_prepared) {
+        /* already got and prefetched before the frame boundary */
+        uint32_t early_us = (mt_get_tsc(impl) - s->next_frame_prepared_tsc) / NS_PER_US;
+        s->stat_min_next_frame_early_us =
+            RTE_MIN(s->stat_min_next_frame_early_us, early_us);
+        s->stat_max_next_frame_early_us =
+            RTE_MAX(s->stat_max_next_frame_early_us, early_us);
+        s->stat_next_frame_prepared++;
+        next_frame_idx = s->next_frame_idx;
+        s->next_frame_prepared = false;
+        prefetched = s->next_frame_prefetched;
+        s->next_frame_prefetched = false;
+      } else {
+        ret = tv_get_next_frame(impl, s, &next_frame_idx);
+        if (ret == -EBUSY) { /* no frame ready from app */
+          if (s->stat_user_busy_first) {
+            s->stat_user_busy++;
+            s->stat_user_busy_first = false;
+          }
+          if (s->tx_done_cleanup[MTL_SESSION_PORT_P] &&
+              (mt_get_tsc(impl) > pacing->tsc_time_cursor)) {
+            /* flush tx queue to cleanup all mbufs, for tv_frame_free_cb */
+            dbg("%s(%d), tx done cleanup %u\n", __func__, s->idx,
+                s->tx_done_cleanup[MTL_SESSION_PORT_P]);
+            for (int i = 0; i < num_port; i++) {
+              struct rte_mbuf* pad = s->pad[i][ST20_PKT_TYPE_NORMAL];
+              if (!pad) continue;
+
+              rte_mbuf_refcnt_update(pad, 1);
+              uint16_t tx = mt_txq_burst(s->queue[i], &pad, 1);
+              if (tx < 1) {
+                rte_mbuf_refcnt_update(pad, -1);
+              } else {
+                s->tx_done_cleanup[i]--;
+                s->stat_tx_done_cleanup++;
+              }
             }
           }
-        }
-        s->stat_build_ret_code = -STI_FRAME_APP_GET_FRAME_BUSY;
-        return MT_TASKLET_ALL_DONE;
-      }
-      /* check frame refcnt */
-      struct st_frame_trans* frame = &s->st20_frames[next_frame_idx];
-      int refcnt = rte_atomic32_read(&frame->refcnt);
-      if (refcnt) {
-        err("%s(%d), frame %u refcnt not zero %d\n", __func__, idx, next_frame_idx,
-            refcnt);
-        s->stat_build_ret_code = -STI_FRAME_APP_ERR_TX_FRAME;
-        return MT_TASKLET_ALL_DONE;
-      }
-      frame->tv_meta = meta;
-
-      frame->user_meta_data_size = 0;
-      if (meta.user_meta) {
-        if (meta.user_meta_size > frame->user_meta_buffer_size) {
-          err("%s(%d), frame %u user meta size %" PRId64 " too large\n", __func__, idx,
-              next_frame_idx, meta.user_meta_size);
-          s->stat_build_ret_code = -STI_FRAME_APP_ERR_USER_META;
+          s->stat_build_ret_code = -STI_FRAME_APP_GET_FRAME_BUSY;
+          return MT_TASKLET_ALL_DONE;
+        } else if (ret < 0) {
           return MT_TASKLET_ALL_DONE;
         }
-        s->stat_user_meta_cnt++;
-        /* copy user meta to frame meta */
-        rte_memcpy(frame->user_meta, meta.user_meta, meta.user_meta_size);
-        frame->user_meta_data_size = meta.user_meta_size;
       }
 
-      s->stat_user_busy_first = true;
-      /* all check fine */
-      rte_atomic32_inc(&frame->refcnt);
+      struct st_frame_trans* frame = &s->st20_frames[next_frame_idx];
       s->st20_frame_idx = next_frame_idx;
       s->st20_frame_lines_ready = 0;
+      /* not warmed in the tail of last frame */
+      if (!prefetched) tv_prefetch_frame(s, frame);
       for (int i = 0; i < num_port; i++) {
         s->tx_done_cleanup[i] = s->queue_burst_pkts[i];
       }
-      dbg("%s(%d), next_frame_idx %d start\n", __func__, idx, next_frame_idx);
+      dbg("%s(%d), next_frame_idx %d start\n", __func__, s->idx, next_frame_idx);
       s->st20_frame_stat = ST21_TX_STAT_SENDING_PKTS;
 
       /* user timestamp control if any */
-      uint64_t required_tai = tv_pacing_required_tai(s, meta.tfmt, meta.timestamp);
+      uint64_t required_tai =
+          tv_pacing_required_tai(s, frame->tv_meta.tfmt, frame->tv_meta.timestamp);
       bool second_field = frame->tv_meta.second_field;
       tv_sync_pacing(impl, s, false, required_tai, second_field);
       if (ops->flags & ST20_TX_FLAG_USER_TIMESTAMP &&
           (frame->tv_meta.tfmt == ST10_TIMESTAMP_FMT_MEDIA_CLK)) {
-        pacing->rtp_time_stamp = st10_get_media_clk(meta.tfmt, meta.timestamp, 90 * 1000);
+        pacing->rtp_time_stamp = st10_get_media_clk(frame->tv_meta.tfmt,
+                                                    frame->tv_meta.timestamp, 90 * 1000);
       }
-      dbg("%s(%d), rtp time stamp %u\n", __func__, idx, pacing->rtp_time_stamp);
+      dbg("%s(%d), rtp time stamp %u\n", __func__, s->idx, pacing->rtp_time_stamp);
       frame->tv_meta.tfmt = ST10_TIMESTAMP_FMT_TAI;
       frame->tv_meta.timestamp = pacing->cur_epoch_time;
       frame->tv_meta.epoch = pacing->cur_epochs;
@@ -1707,15 +2240,15 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
 
   ret = rte_pktmbuf_alloc_bulk(hdr_pool_p, pkts, bulk);
   if (ret < 0) {
-    dbg("%s(%d), pkts alloc fail %d\n", __func__, idx, ret);
+    dbg("%s(%d), pkts alloc fail %d\n", __func__, s->idx, ret);
     s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
     return MT_TASKLET_ALL_DONE;
   }
 
-  if (!s->tx_no_chain) {
+  if (!s->tx_no_chain || s->tx_r_shared) {
     ret = rte_pktmbuf_alloc_bulk(chain_pool, pkts_chain, bulk);
     if (ret < 0) {
-      dbg("%s(%d), pkts chain alloc fail %d\n", __func__, idx, ret);
+      dbg("%s(%d), pkts chain alloc fail %d\n", __func__, s->idx, ret);
       rte_pktmbuf_free_bulk(pkts, bulk);
       s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
       return MT_TASKLET_ALL_DONE;
@@ -1723,7 +2256,7 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
     if (send_r) {
       ret = rte_pktmbuf_alloc_bulk(hdr_pool_r, pkts_r, bulk);
       if (ret < 0) {
-        dbg("%s(%d), pkts_r alloc fail %d\n", __func__, idx, ret);
+        dbg("%s(%d), pkts_r alloc fail %d\n", __func__, s->idx, ret);
         rte_pktmbuf_free_bulk(pkts, bulk);
         rte_pktmbuf_free_bulk(pkts_chain, bulk);
         s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
@@ -1736,23 +2269,29 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
     st_tx_mbuf_set_priv(pkts[i], &s->st20_frames[s->st20_frame_idx]);
     if (s->st20_pkt_idx >= s->st20_total_pkts) {
       s->stat_pkts_dummy++;
-      if (!s->tx_no_chain) rte_pktmbuf_free(pkts_chain[i]);
+      if (!s->tx_no_chain || s->tx_r_shared) rte_pktmbuf_free(pkts_chain[i]);
       st_tx_mbuf_set_idx(pkts[i], ST_TX_DUMMY_PKT_IDX);
     } else {
-      if (s->tx_no_chain)
-        tv_build_st20(s, pkts[i]);
-      else
+      if (s->tx_no_chain) {
+        ret = tv_build_st20(s, pkts[i]);
+        if (ret < 0) {
+          /* the pkt is still sent with black pgroups to keep the pacing */
+          s->stat_pkts_uframe_pg_fail++;
+          s->stat_build_ret_code = -STI_FRAME_APP_ERR_UFRAME_PG;
+        }
+      } else {
         tv_build_st20_chain(s, pkts[i], pkts_chain[i]);
+      }
       st_tx_mbuf_set_idx(pkts[i], s->st20_pkt_idx);
       s->port_user_stats[MTL_SESSION_PORT_P].build++;
     }
     pacing_set_mbuf_time_stamp(pkts[i], pacing);
 
     if (send_r) {
-      if (s->tx_no_chain) {
+      if (s->tx_no_chain && !s->tx_r_shared) {
         pkts_r[i] = rte_pktmbuf_copy(pkts[i], hdr_pool_r, 0, UINT32_MAX);
         if (pkts_r[i] == NULL) {
-          dbg("%s(%d), pkts_r alloc fail %d\n", __func__, idx, ret);
+          dbg("%s(%d), pkts_r alloc fail %d\n", __func__, s->idx, ret);
           rte_pktmbuf_free_bulk(pkts, bulk);
           rte_pktmbuf_free_bulk(pkts_r, bulk);
           s->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
@@ -1764,9 +2303,11 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
       if (s->st20_pkt_idx >= s->st20_total_pkts) {
         st_tx_mbuf_set_idx(pkts_r[i], ST_TX_DUMMY_PKT_IDX);
       } else {
-        if (s->tx_no_chain) {
+        if (s->tx_r_shared)
+          tv_build_st20_redundant_shared(s, pkts_r[i], pkts_chain[i], pkts[i]);
+        else if (s->tx_no_chain)
           tv_update_redundant(s, pkts_r[i]);
-        } else
+        else
           tv_build_st20_redundant_chain(s, pkts_r[i], pkts[i]);
         st_tx_mbuf_set_idx(pkts_r[i], s->st20_pkt_idx);
         s->port_user_stats[MTL_SESSION_PORT_R].build++;
@@ -1798,8 +2339,23 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
     }
   }
 
+  /* prepare the next frame once half of current frame is sent */
+  if (!s->next_frame_prepared && (ops->type == ST20_TYPE_FRAME_LEVEL) &&
+      (s->st20_pkt_idx >= (s->st20_total_pkts / 2)) &&
+      (s->st20_pkt_idx < s->st20_total_pkts))
+    tv_prepare_next_frame(impl, s);
+
+  /* warm the first lines of the prepared frame in the last lines of current frame */
+  if (s->next_frame_prepared && !s->next_frame_prefetched) {
+    int tail_pkts = s->st20_total_pkts * ST_TX_VIDEO_PREFETCH_LINES / ops->height + 1;
+    if (s->st20_pkt_idx + tail_pkts >= s->st20_total_pkts) {
+      tv_prefetch_frame(s, &s->st20_frames[s->next_frame_idx]);
+      s->next_frame_prefetched = true;
+    }
+  }
+
   if (s->st20_pkt_idx >= s->st20_total_pkts) {
-    dbg("%s(%d), frame %d done with %d pkts\n", __func__, idx, s->st20_frame_idx,
+    dbg("%s(%d), frame %d done with %d pkts\n", __func__, s->idx, s->st20_frame_idx,
         s->st20_pkt_idx);
     /* end of current frame */
     s->st20_frame_stat = ST21_TX_STAT_WAIT_FRAME;
@@ -1816,7 +2372,7 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
     uint64_t frame_end_time = mt_get_tsc(impl);
     if (frame_end_time > pacing->tsc_time_cursor) {
       s->stat_exceed_frame_time++;
-      dbg("%s(%d), frame %d build time out %fus\n", __func__, idx, s->st20_frame_idx,
+      dbg("%s(%d), frame %d build time out %fus\n", __func__, s->idx, s->st20_frame_idx,
           (frame_end_time - pacing->tsc_time_cursor) / NS_PER_US);
     }
     /* point to tsc time of next epoch */
@@ -1854,9 +2410,6 @@ static int tv_tasklet_rtp(struct mtl_main_impl* impl,
                           struct st_tx_video_session_impl* s) {
   unsigned int bulk = s->bulk;
   unsigned int n;
-#ifdef DEBUG
-  int idx = s->idx;
-#endif
   struct st_tx_video_pacing* pacing = &s->pacing;
   int ret;
   bool send_r = false;
@@ -1906,14 +2459,15 @@ static int tv_tasklet_rtp(struct mtl_main_impl* impl,
   unsigned int pkts_bulk = eof ? 1 : bulk; /* bulk one only at end of frame */
 
   if (eof)
-    dbg("%s(%d), pkts_bulk %d pkt idx %d\n", __func__, idx, pkts_bulk, s->st20_pkt_idx);
+    dbg("%s(%d), pkts_bulk %d pkt idx %d\n", __func__, s->idx, pkts_bulk,
+        s->st20_pkt_idx);
 
   n = mt_rte_ring_sc_dequeue_bulk(s->packet_ring, (void**)&pkts_chain, pkts_bulk, NULL);
   if (n == 0) {
     if (s->stat_user_busy_first) {
       s->stat_user_busy++;
       s->stat_user_busy_first = false;
-      dbg("%s(%d), rtp pkts not ready %d, ring cnt %d\n", __func__, idx, ret,
+      dbg("%s(%d), rtp pkts not ready %d, ring cnt %d\n", __func__, s->idx, ret,
           rte_ring_count(s->packet_ring));
     }
     s->stat_build_ret_code = -STI_RTP_APP_DEQUEUE_FAIL;
@@ -1924,7 +2478,7 @@ static int tv_tasklet_rtp(struct mtl_main_impl* impl,
 
   ret = rte_pktmbuf_alloc_bulk(hdr_pool_p, pkts, bulk);
   if (ret < 0) {
-    dbg("%s(%d), pkts alloc fail %d\n", __func__, idx, ret);
+    dbg("%s(%d), pkts alloc fail %d\n", __func__, s->idx, ret);
     rte_pktmbuf_free_bulk(pkts_chain, bulk);
     s->stat_build_ret_code = -STI_RTP_PKT_ALLOC_FAIL;
     return MT_TASKLET_ALL_DONE;
@@ -1933,7 +2487,7 @@ static int tv_tasklet_rtp(struct mtl_main_impl* impl,
   if (send_r) {
     ret = rte_pktmbuf_alloc_bulk(hdr_pool_r, pkts_r, bulk);
     if (ret < 0) {
-      dbg("%s(%d), pkts_r alloc fail %d\n", __func__, idx, ret);
+      dbg("%s(%d), pkts_r alloc fail %d\n", __func__, s->idx, ret);
       rte_pktmbuf_free_bulk(pkts, bulk);
       rte_pktmbuf_free_bulk(pkts_chain, bulk);
       s->stat_build_ret_code = -STI_RTP_PKT_ALLOC_FAIL;
@@ -2097,6 +2651,7 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
       if (s->st20_total_pkts < st22_info->st22_min_pkts)
         s->st20_total_pkts = st22_info->st22_min_pkts;
       st22_info->cur_frame_size = frame_size;
+      st22_info->bytes_ready = 0;
       s->st20_frame_idx = next_frame_idx;
       s->st20_frame_stat = ST21_TX_STAT_SENDING_PKTS;
 
@@ -2117,6 +2672,27 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
     }
   }
 
+  if ((ops->type == ST20_TYPE_SLICE_LEVEL) &&
+      (s->st20_pkt_idx < st22_info->st22_total_pkts)) {
+    /* the codestream bytes required by the pkts of this bulk */
+    size_t end = RTE_MIN((size_t)s->st20_pkt_len * (s->st20_pkt_idx + bulk),
+                         st22_info->cur_frame_size);
+    size_t bytes = (end > s->st22_box_hdr_length) ? (end - s->st22_box_hdr_length) : 0;
+    if (bytes > st22_info->bytes_ready) {
+      struct st22_tx_slice_meta slice_meta;
+      memset(&slice_meta, 0, sizeof(slice_meta));
+      ret = st22_info->query_frame_bytes_ready(ops->priv, s->st20_frame_idx, &slice_meta);
+      if (ret >= 0) st22_info->bytes_ready = slice_meta.bytes_ready;
+      if ((ret < 0) || (bytes > st22_info->bytes_ready)) {
+        dbg("%s(%d), bytes %" PRIu64 " not ready, ready bytes %" PRIu64 "\n", __func__,
+            idx, bytes, st22_info->bytes_ready);
+        s->stat_lines_not_ready++;
+        s->stat_build_ret_code = -STI_ST22_APP_SLICE_NOT_READY;
+        return MT_TASKLET_ALL_DONE;
+      }
+    }
+  }
+
   struct rte_mbuf* pkts[bulk];
   struct rte_mbuf* pkts_r[bulk];
 
@@ -2152,7 +2728,7 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
       return MT_TASKLET_ALL_DONE;
     }
 
-    if (!s->tx_no_chain) {
+    if (!s->tx_no_chain || s->tx_r_shared) {
       ret = rte_pktmbuf_alloc_bulk(chain_pool, pkts_chain, bulk);
       if (ret < 0) {
         dbg("%s(%d), pkts chain alloc fail %d\n", __func__, idx, ret);
@@ -2176,7 +2752,7 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
       if (s->st20_pkt_idx >= st22_info->st22_total_pkts) {
         dbg("%s(%d), pad on pkt %d\n", __func__, s->idx, s->st20_pkt_idx);
         s->stat_pkts_dummy++;
-        if (!s->tx_no_chain) rte_pktmbuf_free(pkts_chain[i]);
+        if (!s->tx_no_chain || s->tx_r_shared) rte_pktmbuf_free(pkts_chain[i]);
         st_tx_mbuf_set_idx(pkts[i], ST_TX_DUMMY_PKT_IDX);
       } else {
         if (s->tx_no_chain)
@@ -2192,7 +2768,9 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
         if (s->st20_pkt_idx >= st22_info->st22_total_pkts) {
           st_tx_mbuf_set_idx(pkts_r[i], ST_TX_DUMMY_PKT_IDX);
         } else {
-          if (s->tx_no_chain) {
+          if (s->tx_r_shared) {
+            tv_build_st22_redundant_shared(s, pkts_r[i], pkts_chain[i], pkts[i]);
+          } else if (s->tx_no_chain) {
             pkts_r[i] = rte_pktmbuf_copy(pkts[i], hdr_pool_r, 0, UINT32_MAX);
             if (pkts_r[i] == NULL) {
               dbg("%s(%d), pkts_r alloc fail %d\n", __func__, idx, ret);
@@ -2479,8 +3057,25 @@ static int tv_mempool_init(struct mtl_main_impl* impl,
       info("%s(%d), use tx mono hdr mempool(%p) for port %d\n", __func__, idx,
            s->mbuf_mempool_hdr[i], i);
     } else {
+      uint16_t room_size = hdr_room_size;
       n = mt_if_nb_tx_desc(impl, port) + s->ring_count;
       if (s->ops.flags & ST20_TX_FLAG_ENABLE_RTCP) n += ST_TX_VIDEO_RTCP_RING_SIZE;
+      if (s->tx_r_shared) {
+        if (i == MTL_SESSION_PORT_P) {
+          /* primary pkts are also referenced by the inflight redundant pkts */
+          n += mt_if_nb_tx_desc(impl, mt_port_logic2phy(s->port_maps,
+                                                        MTL_SESSION_PORT_R)) +
+               s->ring_count;
+        } else {
+          /* redundant pkts only carry the hdrs */
+          if (s->st22_info) {
+            room_size = sizeof(struct st22_rfc9134_video_hdr);
+          } else {
+            room_size = sizeof(struct st_rfc4175_video_hdr) +
+                        sizeof(struct st20_rfc4175_extra_rtp_hdr);
+          }
+        }
+      }
       if (s->mbuf_mempool_hdr[i]) {
         warn("%s(%d), use previous hdr mempool for port %d\n", __func__, idx, i);
       } else {
@@ -2489,7 +3084,7 @@ static int tv_mempool_init(struct mtl_main_impl* impl,
                  i, s->recovery_idx);
         struct rte_mempool* mbuf_pool =
             mt_mempool_create(impl, port, pool_name, n, MT_MBUF_CACHE_SIZE,
-                              sizeof(struct mt_muf_priv_data), hdr_room_size);
+                              sizeof(struct mt_muf_priv_data), room_size);
         if (!mbuf_pool) {
           tv_mempool_free(s);
           return -ENOMEM;
@@ -2539,6 +3134,28 @@ static int tv_mempool_init(struct mtl_main_impl* impl,
         s->mbuf_mempool_copy_chain = mbuf_pool;
       }
     }
+  } else if (s->tx_r_shared) {
+    /* indirect mbuf pool for the redundant pkts to refer the payload of primary */
+    port = mt_port_logic2phy(s->port_maps, MTL_SESSION_PORT_R);
+    n = mt_if_nb_tx_desc(impl, port) + s->ring_count;
+    if (s->ops.flags & ST20_TX_FLAG_ENABLE_RTCP) n += ST_TX_VIDEO_RTCP_RING_SIZE;
+
+    if (s->tx_mono_pool) {
+      s->mbuf_mempool_chain = mt_get_tx_mempool(impl, port);
+      info("%s(%d), use tx mono chain mempool(%p)\n", __func__, idx,
+           s->mbuf_mempool_chain);
+    } else {
+      char pool_name[32];
+      snprintf(pool_name, 32, "%sM%dS%d_SHARE_%d", ST_TX_VIDEO_PREFIX, mgr->idx, idx,
+               s->recovery_idx);
+      struct rte_mempool* mbuf_pool =
+          mt_mempool_create(impl, port, pool_name, n, MT_MBUF_CACHE_SIZE, 0, 0);
+      if (!mbuf_pool) {
+        tv_mempool_free(s);
+        return -ENOMEM;
+      }
+      s->mbuf_mempool_chain = mbuf_pool;
+    }
   }
 
   return 0;
@@ -2614,6 +3231,7 @@ static int tv_init_st22_frame(struct mtl_main_impl* impl,
 
   st22_info->get_next_frame = st22_frame_ops->get_next_frame;
   st22_info->notify_frame_done = st22_frame_ops->notify_frame_done;
+  st22_info->query_frame_bytes_ready = st22_frame_ops->query_frame_bytes_ready;
   st22_info->st22_min_pkts = mt_if_nb_tx_desc(impl, MTL_PORT_P) / s->st20_frames_cnt + 1;
   dbg("%s(%d), st22_min_pkts %d\n", __func__, s->idx, st22_info->st22_min_pkts);
 
@@ -2896,6 +3514,23 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
   s->tx_mono_pool = mt_has_tx_mono_pool(impl);
   /* manually disable chain or any port can't support chain */
   s->tx_no_chain = mt_has_tx_no_chain(impl) || !tv_has_chain_buf(s);
+  /* user frame mode fills the payload of each pkt, no chain to the framebuffer */
+  if (ops->uframe_pg_callback && (ops->type != ST20_TYPE_RTP_LEVEL)) {
+    s->tx_no_chain = true;
+    s->pg_meta.width = ops->width;
+    s->pg_meta.height = ops->height;
+    s->pg_meta.fps = ops->fps;
+    s->pg_meta.fmt = ops->fmt;
+    ret = tv_init_black_pg(s);
+    if (ret < 0) return ret;
+    info("%s(%d), user frame mode\n", __func__, idx);
+  }
+  /* redundant port can chain, share the payload of primary pkts instead of copy */
+  s->tx_r_shared = s->tx_no_chain && (num_port > 1) &&
+                   (ops->type != ST20_TYPE_RTP_LEVEL) &&
+                   s->eth_has_chain[MTL_SESSION_PORT_R] &&
+                   !s->mbuf_mempool_reuse_rx[MTL_SESSION_PORT_R];
+  if (s->tx_r_shared) info("%s(%d), redundant pkts share payload\n", __func__, idx);
   s->multi_src_port = mt_multi_src_port(impl);
   s->st20_ipv4_packet_id = 0;
 
@@ -2954,6 +3589,17 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
     return ret;
   }
 
+  if (mt_has_tx_ebu(impl) && !s->st22_info) {
+    ret = tv_init_ebu(impl, s);
+    if (ret < 0) {
+      err("%s(%d), tx_session_init_ebu fail %d\n", __func__, idx, ret);
+      tv_uinit_rtcp(s);
+      tv_uinit_hw(impl, s);
+      tv_uinit_sw(s);
+      return ret;
+    }
+  }
+
   /* init vsync */
   s->vsync.meta.frame_time = s->pacing.frame_time;
   st_vsync_calculate(impl, &s->vsync);
@@ -2965,6 +3611,11 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
     info("%s(%d), advice sleep us %" PRIu64 "\n", __func__, idx, s->advice_sleep_us);
   }
 
+  s->next_frame_prepared = false;
+  s->next_frame_prefetched = false;
+  s->stat_next_frame_prepared = 0;
+  s->stat_min_next_frame_early_us = UINT32_MAX;
+  s->stat_max_next_frame_early_us = 0;
   s->stat_lines_not_ready = 0;
   s->stat_user_busy = 0;
   s->stat_user_busy_first = true;
@@ -3042,6 +3693,13 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
   s->stat_last_time = cur_time_ns;
   s->stat_pkts_build = 0;
   s->stat_pkts_burst = 0;
+  if (s->ebu_trace && rte_atomic32_read(&s->ebu_trace_state) == ST_TX_VIDEO_EBU_FULL) {
+    rte_smp_rmb();
+    tv_ebu_analyse(s);
+    /* the tasklet restarts the trace as it is the only writer of the entries */
+    rte_smp_wmb();
+    rte_atomic32_set(&s->ebu_trace_state, ST_TX_VIDEO_EBU_ANALYSED);
+  }
   s->trs_inflight_cnt[0] = 0;
   s->inflight_cnt[0] = 0;
   s->stat_bytes_tx[MTL_SESSION_PORT_P] = 0;
@@ -3114,6 +3772,11 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
     notice("TX_VIDEO_SESSION(%d,%d): SERIOUS MEMORY ISSUE!\n", m_idx, idx);
     s->stat_pkts_chain_realloc_fail = 0;
   }
+  if (s->stat_pkts_uframe_pg_fail) {
+    warn("TX_VIDEO_SESSION(%d,%d): user frame pg fail cnt %d\n", m_idx, idx,
+         s->stat_pkts_uframe_pg_fail);
+    s->stat_pkts_uframe_pg_fail = 0;
+  }
   if (frame_cnt <= 0) {
     warn("TX_VIDEO_SESSION(%d,%d:%s): build ret %d, trs ret %d:%d\n", m_idx, idx,
          s->ops_name, s->stat_build_ret_code, s->stat_trs_ret_code[MTL_SESSION_PORT_P],
@@ -3131,6 +3794,14 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
     s->stat_max_next_frame_us = 0;
     s->stat_max_notify_frame_us = 0;
   }
+  if (s->stat_next_frame_prepared) {
+    notice("TX_VIDEO_SESSION(%d,%d): next frame prepared %u, early min %uus max %uus\n",
+           m_idx, idx, s->stat_next_frame_prepared, s->stat_min_next_frame_early_us,
+           s->stat_max_next_frame_early_us);
+    s->stat_next_frame_prepared = 0;
+    s->stat_min_next_frame_early_us = UINT32_MAX;
+    s->stat_max_next_frame_early_us = 0;
+  }
   if (s->stat_recoverable_error) {
     notice("TX_VIDEO_SESSION(%d,%d): recoverable_error %u \n", m_idx, idx,
            s->stat_recoverable_error);
@@ -3161,6 +3832,13 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
 static int tv_detach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr* mgr,
                      struct st_tx_video_session_impl* s) {
   tv_stat(mgr, s);
+  if (s->ebu_trace) {
+    if (rte_atomic32_read(&s->ebu_trace_state) == ST_TX_VIDEO_EBU_FULL)
+      tv_ebu_analyse(s);
+    tv_ebu_final_result(s);
+    tv_uinit_ebu(s);
+  }
+  tv_release_next_frame(s);
   /* must uinit hw firstly as frame use shared external buffer */
   tv_uinit_rtcp(s);
   tv_uinit_hw(impl, s);
@@ -3414,6 +4092,7 @@ int st_tx_video_sessions_sch_uinit(struct mtl_main_impl* impl, struct mt_sch_imp
 int st_tx_video_session_migrate(struct mtl_main_impl* impl,
                                 struct st_tx_video_sessions_mgr* mgr,
                                 struct st_tx_video_session_impl* s, int idx) {
+  /* the prepared frame is kept and sent by the new tasklet */
   tv_init(impl, mgr, s, idx);
   return 0;
 }
@@ -3511,7 +4190,7 @@ static int tv_st22_ops_check(struct st22_tx_ops* ops) {
     }
   }
 
-  if (ops->type == ST22_TYPE_FRAME_LEVEL) {
+  if (st22_is_frame_type(ops->type)) {
     if ((ops->framebuff_cnt < 2) || (ops->framebuff_cnt > ST22_FB_MAX_COUNT)) {
       err("%s, invalid framebuff_cnt %d, should in range [2:%d]\n", __func__,
           ops->framebuff_cnt, ST22_FB_MAX_COUNT);
@@ -3529,6 +4208,12 @@ static int tv_st22_ops_check(struct st22_tx_ops* ops) {
       err("%s, pls set get_next_frame\n", __func__);
       return -EINVAL;
     }
+    if (ops->type == ST22_TYPE_SLICE_LEVEL) {
+      if (!ops->query_frame_bytes_ready) {
+        err("%s, pls set query_frame_bytes_ready\n", __func__);
+        return -EINVAL;
+      }
+    }
   }
 
   if (ops->type == ST22_TYPE_RTP_LEVEL) {
@@ -3594,9 +4279,10 @@ int st20_tx_queue_fatal_error(struct mtl_main_impl* impl,
   uint16_t queue_id = mt_txq_queue_id(s->queue[s_port]);
   info("%s(%d,%d), new queue_id %u\n", __func__, idx, s_port, queue_id);
 
-  /* cleanup frame manager */
+  /* cleanup frame manager, the prepared frame is not on the wire and kept for tx */
   struct st_frame_trans* frame;
   for (uint16_t i = 0; i < s->st20_frames_cnt; i++) {
+    if (s->next_frame_prepared && (i == s->next_frame_idx)) continue;
     frame = &s->st20_frames[i];
     int refcnt = rte_atomic32_read(&frame->refcnt);
     if (refcnt) {
@@ -3809,10 +4495,6 @@ int st20_tx_set_ext_frame(st20_tx_handle handle, uint16_t idx,
     return -EIO;
   }
   rte_iova_t iova_addr = ext_frame->buf_iova;
-  if (iova_addr == MTL_BAD_IOVA || iova_addr == 0) {
-    err("%s(%d), invalid ext frame iova 0x%" PRIx64 "\n", __func__, s_idx, iova_addr);
-    return -EIO;
-  }
 
   for (int i = 0; i < s->st20_frames_cnt; i++) {
     if (addr == s->st20_frames[i].addr) {
@@ -3839,6 +4521,16 @@ int st20_tx_set_ext_frame(st20_tx_handle handle, uint16_t idx,
     err("%s(%d), frame %d are not ext enabled\n", __func__, s_idx, idx);
     return -EINVAL;
   }
+  tv_frame_map_put(s, frame); /* set again before transmitted */
+  if (iova_addr == MTL_BAD_IOVA || iova_addr == 0) {
+    /* not mapped by app, get it from the map registry */
+    iova_addr = mt_map_get(s->impl, addr, s->st20_fb_size);
+    if (iova_addr == MTL_BAD_IOVA) {
+      err("%s(%d), map ext frame %p fail\n", __func__, s_idx, addr);
+      return -EIO;
+    }
+    frame->flags |= ST_FT_FLAG_EXT_AUTO_MAP;
+  }
 
   frame->addr = addr;
   frame->iova = iova_addr;
@@ -4189,6 +4881,8 @@ st22_tx_handle st22_tx_create(mtl_handle mt, struct st22_tx_ops* ops) {
   st20_ops.pacing = ops->pacing;
   if (ST22_TYPE_RTP_LEVEL == ops->type)
     st20_ops.type = ST20_TYPE_RTP_LEVEL;
+  else if (ST22_TYPE_SLICE_LEVEL == ops->type)
+    st20_ops.type = ST20_TYPE_SLICE_LEVEL;
   else
     st20_ops.type = ST20_TYPE_FRAME_LEVEL;
   st20_ops.width = ops->width;
@@ -12,6 +12,12 @@
 #define ST_TX_VIDEO_RTCP_BURST_SIZE (32)
 #define ST_TX_VIDEO_RTCP_RING_SIZE (1024)
 
+/* lines of the next frame prefetched in the same count of tail lines of current frame */
+#define ST_TX_VIDEO_PREFETCH_LINES (4)
+
+/* frames in the burst trace for the ebu check */
+#define ST_TX_VIDEO_EBU_TRACE_FRAMES (8)
+
 int st_tx_video_sessions_sch_init(struct mtl_main_impl* impl, struct mt_sch_impl* sch);
 
 int st_tx_video_sessions_sch_uinit(struct mtl_main_impl* impl, struct mt_sch_impl* sch);
@@ -70,4 +76,9 @@ int st_tx_video_session_migrate(struct mtl_main_impl* impl,
 
 int st20_pacing_static_profiling(struct st_tx_video_session_impl* s);
 
+/* record the pkts before the burst for the ebu check, return the recorded number */
+uint16_t st20_tx_ebu_on_burst(struct mtl_main_impl* impl,
+                              struct st_tx_video_session_impl* s, struct rte_mbuf** pkts,
+                              uint16_t nb_pkts);
+
 #endif
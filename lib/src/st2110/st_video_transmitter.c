@@ -60,8 +60,15 @@ static uint16_t video_trs_burst(struct mtl_main_impl* impl,
                                 struct st_tx_video_session_impl* s,
                                 enum mtl_session_port s_port, struct rte_mbuf** tx_pkts,
                                 uint16_t nb_pkts) {
+  uint16_t ebu_pkts = 0;
+  if (s->ebu_trace && s_port == MTL_SESSION_PORT_P)
+    ebu_pkts = st20_tx_ebu_on_burst(impl, s, tx_pkts, nb_pkts);
   if (s->rtcp_tx[s_port]) mt_mbuf_refcnt_inc_bulk(tx_pkts, nb_pkts);
   uint16_t tx = mt_txq_burst(s->queue[s_port], tx_pkts, nb_pkts);
+  if (ebu_pkts && tx < nb_pkts) {
+    /* not sent pkts will be recorded again on next burst */
+    s->ebu_trace_cnt -= RTE_MIN(ebu_pkts, nb_pkts - tx);
+  }
   if (!tx) {
     if (s->rtcp_tx[s_port]) rte_pktmbuf_free_bulk(tx_pkts, nb_pkts);
     return video_trs_burst_fail(impl, s, s_port, tx_pkts, nb_pkts);
@@ -131,7 +131,19 @@ static int decode_frame(struct st22_decoder_session* s,
   size_t codestream_size = frame->src->data_size;
 
   /* call the real decode here, sample just copy and sleep */
-  memcpy(frame->dst->addr[0], frame->src->addr[0], codestream_size);
+  if (frame->src_segs) {
+    /* read the codestream from the received packets directly */
+    size_t offset = 0;
+    for (uint32_t i = 0; i < frame->src_segs_cnt; i++) {
+      struct st22_codestream_seg* seg = &frame->src_segs[i];
+      if (!seg->addr) continue; /* pkt lost */
+      if (offset + seg->len > frame->dst->data_size) break;
+      memcpy(frame->dst->addr[0] + offset, seg->addr, seg->len);
+      offset += seg->len;
+    }
+  } else {
+    memcpy(frame->dst->addr[0], frame->src->addr[0], codestream_size);
+  }
   st_usleep(10 * 1000);
 
   s->frame_cnt++;
@@ -177,6 +189,8 @@ static st22_decode_priv decoder_create_session(void* priv, st22p_decode_session
     st_pthread_mutex_init(&session->wake_mutex, NULL);
     st_pthread_cond_init(&session->wake_cond, NULL);
 
+    /* the sample decoder can read the codestream segments */
+    if (req->codestream_segs) req->segs_enabled = true;
     session->req = *req;
     session->session_p = session_p;
 
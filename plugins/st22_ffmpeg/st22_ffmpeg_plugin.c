@@ -15,6 +15,103 @@
 #include "../log.h"
 #include "../plugin_platform.h"
 
+#define ST22_FFMPEG_FMT_CAPS \
+  (ST_FMT_CAP_YUV422PLANAR8 | ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_YUV420CUSTOM8)
+
+static enum AVPixelFormat st22_ffmpeg_pix_fmt(enum st_frame_fmt fmt) {
+  switch (fmt) {
+    case ST_FRAME_FMT_YUV422PLANAR8:
+      return AV_PIX_FMT_YUV422P;
+    case ST_FRAME_FMT_YUV422PLANAR10LE:
+      return AV_PIX_FMT_YUV422P10LE;
+    case ST_FRAME_FMT_YUV420CUSTOM8:
+      return AV_PIX_FMT_YUV420P; /* I420 */
+    default:
+      return AV_PIX_FMT_NONE;
+  }
+}
+
+/* the three planes of the pipeline frame in the view of libavcodec */
+static void st22_ffmpeg_frame_planes(struct st_frame* frame, uint8_t* data[3],
+                                     int linesize[3]) {
+  if (frame->fmt == ST_FRAME_FMT_YUV420CUSTOM8) {
+    /* I420 in one plane without lines padding */
+    uint32_t w = frame->width;
+    uint32_t h = frame->height;
+
+    data[0] = frame->addr[0];
+    linesize[0] = w;
+    data[1] = data[0] + w * h;
+    linesize[1] = w / 2;
+    data[2] = data[1] + (w / 2) * (h / 2);
+    linesize[2] = w / 2;
+    return;
+  }
+
+  for (int i = 0; i < 3; i++) {
+    data[i] = frame->addr[i];
+    linesize[i] = frame->linesize[i];
+  }
+}
+
+static void encoder_src_free(void* opaque, uint8_t* data) {
+  struct st22_encoder_session* s = opaque;
+
+  /* the src frame is owned by the pipeline, give it back once the last ref dropped */
+  s->src_refs--;
+  if (!s->src_refs && s->held_frame) {
+    st22_encoder_put_frame(s->session_p, s->held_frame, s->held_result);
+    s->held_frame = NULL;
+  }
+}
+
+/* wrap the src frame to libavcodec without copy */
+static int encoder_wrap_src(struct st22_encoder_session* s, struct st_frame* src) {
+  AVFrame* f = s->codec_frame;
+  uint8_t* data[3];
+  int linesize[3];
+
+  av_frame_unref(f);
+  f->buf[0] = av_buffer_create(src->addr[0], src->buffer_size, encoder_src_free, s,
+                               AV_BUFFER_FLAG_READONLY);
+  if (!f->buf[0]) return AVERROR(ENOMEM);
+  s->src_refs++;
+  st22_ffmpeg_frame_planes(src, data, linesize);
+  for (int i = 0; i < 3; i++) {
+    f->data[i] = data[i];
+    f->linesize[i] = linesize[i];
+  }
+  f->extended_data = f->data;
+  f->format = s->pix_fmt;
+  f->width = s->codec_ctx->width;
+  f->height = s->codec_ctx->height;
+  return 0;
+}
+
+/* copy the src frame to a buffer owned by libavcodec */
+static int encoder_copy_src(struct st22_encoder_session* s, struct st_frame* src) {
+  AVFrame* f = s->codec_frame;
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(s->pix_fmt);
+  uint8_t* data[3];
+  int linesize[3];
+  int ret;
+
+  av_frame_unref(f);
+  f->format = s->pix_fmt;
+  f->width = s->codec_ctx->width;
+  f->height = s->codec_ctx->height;
+  ret = av_frame_get_buffer(f, 0);
+  if (ret < 0) return ret;
+  st22_ffmpeg_frame_planes(src, data, linesize);
+  for (int i = 0; i < 3; i++) {
+    int w = i ? AV_CEIL_RSHIFT(f->width, desc->log2_chroma_w) : f->width;
+    int h = i ? AV_CEIL_RSHIFT(f->height, desc->log2_chroma_h) : f->height;
+    av_image_copy_plane(f->data[i], f->linesize[i], data[i], linesize[i],
+                        w * desc->comp[0].step, h);
+  }
+  return 0;
+}
+
 static int encode_frame(struct st22_encoder_session* s,
                         struct st22_encode_frame_meta* frame) {
   int idx = s->idx;
@@ -23,6 +120,8 @@ static int encode_frame(struct st22_encoder_session* s,
   AVPacket* p = s->codec_pkt;
   AVCodecContext* ctx = s->codec_ctx;
   size_t data_size = 0;
+  bool src_copy = s->src_copy;
+  int result = 0;
   int ret;
   bool measure_time = false;
   uint64_t start_time = 0, end_time = 0;
@@ -33,15 +132,20 @@ static int encode_frame(struct st22_encoder_session* s,
 
   frame->dst->data_size = 0;
 
-  /* prepare src */
+  if (src_copy)
+    ret = encoder_copy_src(s, frame->src);
+  else
+    ret = encoder_wrap_src(s, frame->src);
+  if (ret < 0) {
+    err("%s(%d), prepare src frame(%d) fail %s\n", __func__, idx, f_idx,
+        av_err2str(ret));
+    return ret;
+  }
   f->pict_type = AV_PICTURE_TYPE_I; /* all are i frame */
   f->pts = f_idx;
-  /* only YUV422P now */
-  mtl_memcpy(f->data[0], frame->src->addr[0], st_frame_plane_size(frame->src, 0));
-  mtl_memcpy(f->data[1], frame->src->addr[1], st_frame_plane_size(frame->src, 1));
-  mtl_memcpy(f->data[2], frame->src->addr[2], st_frame_plane_size(frame->src, 2));
 
   ret = avcodec_send_frame(ctx, f);
+  av_frame_unref(f); /* libavcodec has its own ref */
   s->frame_idx++;
   if (ret < 0) {
     err("%s(%d), send frame(%d) fail %s\n", __func__, idx, f_idx, av_err2str(ret));
@@ -53,11 +157,12 @@ static int encode_frame(struct st22_encoder_session* s,
     if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
       dbg("%s(%d), receive packet fail %s on frame %d\n", __func__, idx, av_err2str(ret),
           f_idx);
-      goto exit;
+      break;
     } else if (ret < 0) {
       err("%s(%d), receive packet fail %s on frame %d\n", __func__, idx, av_err2str(ret),
           f_idx);
-      return ret;
+      result = ret;
+      break;
     }
 
     dbg("%s, receive packet %" PRId64 " size %d on frame %d\n", __func__, p->pts, p->size,
@@ -67,7 +172,19 @@ static int encode_frame(struct st22_encoder_session* s,
     av_packet_unref(p);
   }
 
-exit:
+  if (src_copy) {
+    s->copy_cnt++;
+  } else if (s->src_refs) {
+    /* libavcodec still reads the src, keep it until encoder_src_free */
+    warn("%s(%d), src frame(%d) still referenced by codec, copy the next frames\n",
+         __func__, idx, f_idx);
+    s->held_frame = frame;
+    s->src_copy = true;
+  } else {
+    s->zero_copy_cnt++;
+  }
+  if (result < 0) return result;
+
   if (measure_time) {
     end_time = st_get_monotonic_time();
     info("%s(%d), consume time %" PRIu64 "us for frame %d\n", __func__, idx,
@@ -96,6 +213,10 @@ static void* encode_thread(void* arg) {
       continue;
     }
     result = encode_frame(s, frame);
+    if (s->held_frame == frame) { /* put back in encoder_src_free */
+      s->held_result = result;
+      continue;
+    }
     st22_encoder_put_frame(session_p, frame, result);
   }
   info("%s(%d), stop\n", __func__, s->idx);
@@ -116,7 +237,7 @@ static int encoder_uinit_session(struct st22_encoder_session* session) {
     session->encode_thread = 0;
   }
 
-  if (session->codec_ctx) {
+  if (session->codec_ctx) { /* the held src is put back as libavcodec drops the refs */
     avcodec_free_context(&session->codec_ctx);
     session->codec_ctx = NULL;
   }
@@ -131,6 +252,13 @@ static int encoder_uinit_session(struct st22_encoder_session* session) {
     session->codec_pkt = NULL;
   }
 
+  if (session->held_frame) {
+    warn("%s(%d), src still referenced %d, put it back\n", __func__, idx,
+         session->src_refs);
+    st22_encoder_put_frame(session->session_p, session->held_frame, -EIO);
+    session->held_frame = NULL;
+  }
+
   st_pthread_mutex_destroy(&session->wake_mutex);
   st_pthread_cond_destroy(&session->wake_cond);
   return 0;
@@ -146,6 +274,13 @@ static int encoder_init_session(struct st22_encoder_session* session,
 
   req->max_codestream_size = req->codestream_size;
   session->req = *req;
+  session->pix_fmt = st22_ffmpeg_pix_fmt(req->input_fmt);
+  if (session->pix_fmt == AV_PIX_FMT_NONE) {
+    err("%s(%d), not support input fmt %s\n", __func__, idx,
+        st_frame_fmt_name(req->input_fmt));
+    encoder_uinit_session(session);
+    return -EINVAL;
+  }
 
   AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_H264);
   if (!codec) {
@@ -172,7 +307,7 @@ static int encoder_init_session(struct st22_encoder_session* session,
   c->width = req->width;
   c->height = req->height;
   c->time_base = (AVRational){1, fps};
-  c->pix_fmt = AV_PIX_FMT_YUV422P;
+  c->pix_fmt = session->pix_fmt;
   av_opt_set(c->priv_data, "fast", "preset", 0);
   av_opt_set(c->priv_data, "tune", "zerolatency", 0);
   av_opt_set(c->priv_data, "nal-hrd", "cbr", 0);
@@ -190,16 +325,8 @@ static int encoder_init_session(struct st22_encoder_session* session,
     encoder_uinit_session(session);
     return -EIO;
   }
+  /* the buffer is wrapped from the src frame for each encode */
   session->codec_frame = f;
-  f->format = c->pix_fmt;
-  f->width = c->width;
-  f->height = c->height;
-  ret = av_frame_get_buffer(f, 0);
-  if (ret < 0) {
-    err("%s(%d), frame get fail\n", __func__, idx);
-    encoder_uinit_session(session);
-    return -EIO;
-  }
 
   AVPacket* p = av_packet_alloc();
   if (!p) {
@@ -256,7 +383,9 @@ static int encoder_free_session(void* priv, st22_encode_priv session) {
   struct st22_encoder_session* encoder_session = session;
   int idx = encoder_session->idx;
 
-  info("%s(%d), total %d encode frames\n", __func__, idx, encoder_session->frame_cnt);
+  info("%s(%d), total %d encode frames, zero copy %d copy %d\n", __func__, idx,
+       encoder_session->frame_cnt, encoder_session->zero_copy_cnt,
+       encoder_session->copy_cnt);
 
   encoder_uinit_session(encoder_session);
 
@@ -276,6 +405,86 @@ static int encoder_frame_available(void* priv) {
   return 0;
 }
 
+/* libavcodec drops the last reference of the dst, give it back to the pipeline */
+static void decoder_dst_free(void* opaque, uint8_t* data) {
+  struct st22_decoder_dst_hold* hold = opaque;
+  struct st22_decoder_session* s = hold->session;
+
+  s->dst_held--;
+  st22_decoder_release_frame(s->session_p, hold->frame);
+  free(hold);
+}
+
+/* if libavcodec can write the aligned(macroblock) frame into the dst directly */
+static bool decoder_dst_fit(struct st22_decoder_session* s, AVCodecContext* c,
+                            AVFrame* f, struct st_frame* dst) {
+  int w = f->width, h = f->height;
+  int linesize_align[AV_NUM_DATA_POINTERS];
+  const AVPixFmtDescriptor* desc;
+
+  if (f->format != s->pix_fmt) return false;
+  if (dst->fmt == ST_FRAME_FMT_YUV420CUSTOM8) return false; /* no lines padding */
+  if (f->width != dst->width || f->height != dst->height) return false;
+
+  avcodec_align_dimensions2(c, &w, &h, linesize_align);
+  desc = av_pix_fmt_desc_get(f->format);
+  for (int i = 0; i < 3; i++) {
+    int rows = i ? AV_CEIL_RSHIFT(h, desc->log2_chroma_h) : h;
+    int bytes = (i ? AV_CEIL_RSHIFT(w, desc->log2_chroma_w) : w) * desc->comp[0].step;
+    uint8_t* end = (i < 2) ? (uint8_t*)dst->addr[i + 1]
+                           : (uint8_t*)dst->addr[0] + dst->buffer_size;
+
+    if (linesize_align[i] && (dst->linesize[i] % linesize_align[i])) return false;
+    if (dst->linesize[i] < bytes) return false;
+    if ((uint8_t*)dst->addr[i] + dst->linesize[i] * rows > end) return false;
+  }
+
+  return true;
+}
+
+/*
+ * decode into the pipeline dst frame if the layout fits, otherwise copy later.
+ * libavcodec may keep the picture as a reference after the frame is put back, so the dst
+ * is held until the AVBuffer is freed. Half of the frames at most, the others are left
+ * for the transport and the app.
+ */
+static int decoder_get_buffer2(AVCodecContext* c, AVFrame* f, int flags) {
+  struct st22_decoder_session* s = c->opaque;
+  struct st22_decode_frame_meta* frame = s->cur_frame;
+  struct st_frame* dst = frame ? frame->dst : NULL;
+  struct st22_decoder_dst_hold* hold;
+
+  if (!dst || (s->dst_held >= s->req.framebuff_cnt / 2) ||
+      !decoder_dst_fit(s, c, f, dst)) {
+    return avcodec_default_get_buffer2(c, f, flags);
+  }
+
+  hold = malloc(sizeof(*hold));
+  if (!hold) return AVERROR(ENOMEM);
+  if (st22_decoder_hold_frame(s->session_p, frame) < 0) {
+    free(hold);
+    return avcodec_default_get_buffer2(c, f, flags);
+  }
+  hold->session = s;
+  hold->frame = frame;
+
+  f->buf[0] = av_buffer_create(dst->addr[0], dst->buffer_size, decoder_dst_free, hold, 0);
+  if (!f->buf[0]) {
+    st22_decoder_release_frame(s->session_p, frame);
+    free(hold);
+    return AVERROR(ENOMEM);
+  }
+  s->dst_held++;
+  for (int i = 0; i < 3; i++) {
+    f->data[i] = dst->addr[i];
+    f->linesize[i] = dst->linesize[i];
+  }
+  f->extended_data = f->data;
+  s->cur_frame = NULL; /* one frame for one packet */
+
+  return 0;
+}
+
 static int decode_frame(struct st22_decoder_session* s,
                         struct st22_decode_frame_meta* frame) {
   int idx = s->idx;
@@ -285,14 +494,19 @@ static int decode_frame(struct st22_decoder_session* s,
   AVPacket* p = s->codec_pkt;
   int ret;
   size_t src_size = frame->src->data_size;
-  size_t frame_size = 0;
+  bool decoded = false;
+  uint8_t* data[3];
+  int linesize[3];
+  const AVPixFmtDescriptor* desc;
 
   s->frame_idx++;
 
   av_packet_unref(p);
   p->data = frame->src->addr[0];
   p->size = src_size;
+  s->cur_frame = frame;
   ret = avcodec_send_packet(ctx, p);
+  s->cur_frame = NULL;
   if (ret < 0) {
     err("%s(%d), send pkt(%d) fail %s\n", __func__, idx, f_idx, av_err2str(ret));
     return ret;
@@ -310,19 +524,34 @@ static int decode_frame(struct st22_decoder_session* s,
 
     dbg("%s, format(%dx%d@%d) on frame %d\n", __func__, f->width, f->height, f->format,
         f_idx);
-    frame_size = f->width * f->height;
-    /* only YUV422P now */
-    mtl_memcpy(frame->dst->addr[0], f->data[0], frame_size);
-    frame_size /= 2;
-    mtl_memcpy(frame->dst->addr[1], f->data[1], frame_size);
-    mtl_memcpy(frame->dst->addr[2], f->data[2], frame_size);
+    if (f->format != s->pix_fmt || f->width != frame->dst->width ||
+        f->height != frame->dst->height) {
+      err("%s(%d), format(%dx%d@%d) mismatch on frame %d\n", __func__, idx, f->width,
+          f->height, f->format, f_idx);
+      av_frame_unref(f);
+      continue;
+    }
+    st22_ffmpeg_frame_planes(frame->dst, data, linesize);
+    if (f->data[0] == data[0]) { /* decoded into dst already */
+      s->zero_copy_cnt++;
+    } else {
+      desc = av_pix_fmt_desc_get(f->format);
+      for (int i = 0; i < 3; i++) {
+        int w = i ? AV_CEIL_RSHIFT(f->width, desc->log2_chroma_w) : f->width;
+        int h = i ? AV_CEIL_RSHIFT(f->height, desc->log2_chroma_h) : f->height;
+        av_image_copy_plane(data[i], linesize[i], f->data[i], f->linesize[i],
+                            w * desc->comp[0].step, h);
+      }
+      s->copy_cnt++;
+    }
+    decoded = true;
 
     av_frame_unref(f);
   }
 
 exit:
   s->frame_cnt++;
-  return frame_size > 0 ? 0 : -EIO;
+  return decoded ? 0 : -EIO;
 }
 
 static void* decode_thread(void* arg) {
@@ -394,7 +623,13 @@ static int decoder_init_session(struct st22_decoder_session* session,
   st_pthread_mutex_init(&session->wake_mutex, NULL);
   st_pthread_cond_init(&session->wake_cond, NULL);
 
-  session->req = *req;
+  session->pix_fmt = st22_ffmpeg_pix_fmt(req->output_fmt);
+  if (session->pix_fmt == AV_PIX_FMT_NONE) {
+    err("%s(%d), not support output fmt %s\n", __func__, idx,
+        st_frame_fmt_name(req->output_fmt));
+    decoder_uinit_session(session);
+    return -EINVAL;
+  }
 
   AVCodec* codec = avcodec_find_decoder(AV_CODEC_ID_H264);
   if (!codec) {
@@ -423,7 +658,26 @@ static int decoder_init_session(struct st22_decoder_session* session,
   c->height = req->height;
   c->time_base = (AVRational){1, 60};
   c->framerate = (AVRational){60, 1};
-  c->pix_fmt = AV_PIX_FMT_YUV422P;
+  c->pix_fmt = session->pix_fmt;
+  c->opaque = session;
+  c->get_buffer2 = decoder_get_buffer2;
+  c->thread_count = 1; /* cur_frame and dst_held are only for the decode thread */
+  /* ask the lib to pad the dst frame as libavcodec required to decode into it */
+  if (req->output_fmt != ST_FRAME_FMT_YUV420CUSTOM8) {
+    int w = req->width, h = req->height;
+    int linesize_align[AV_NUM_DATA_POINTERS];
+    uint32_t align = 0;
+
+    avcodec_align_dimensions2(c, &w, &h, linesize_align);
+    for (int i = 0; i < 3; i++) {
+      if (linesize_align[i] > align) align = linesize_align[i];
+    }
+    req->dst_linesize_align = align;
+    req->dst_pad_lines = h - req->height;
+    info("%s(%d), dst linesize align %u pad lines %u\n", __func__, idx,
+         req->dst_linesize_align, req->dst_pad_lines);
+  }
+  session->req = *req;
 
   ret = avcodec_open2(c, codec, NULL);
   if (ret < 0) {
@@ -493,18 +747,19 @@ static int decoder_free_session(void* priv, st22_decode_priv session) {
   struct st22_decoder_session* decoder_session = session;
   int idx = decoder_session->idx;
 
-  decoder_session->stop = true;
-  st_pthread_mutex_lock(&decoder_session->wake_mutex);
-  st_pthread_cond_signal(&decoder_session->wake_cond);
-  st_pthread_mutex_unlock(&decoder_session->wake_mutex);
-  pthread_join(decoder_session->decode_thread, NULL);
-
-  st_pthread_mutex_destroy(&decoder_session->wake_mutex);
-  st_pthread_cond_destroy(&decoder_session->wake_cond);
-
-  info("%s(%d), total %d decode frames\n", __func__, idx, decoder_session->frame_cnt);
-  free(decoder_session);
+  /* libavcodec drops all the refs here, the held dst frames are released */
+  decoder_uinit_session(decoder_session);
+  info("%s(%d), total %d decode frames, zero copy %d copy %d\n", __func__, idx,
+       decoder_session->frame_cnt, decoder_session->zero_copy_cnt,
+       decoder_session->copy_cnt);
   ctx->decoder_sessions[idx] = NULL;
+  if (decoder_session->dst_held) {
+    /* decoder_dst_free still refers the session, never free it */
+    err("%s(%d), still %d dst frames held, leak the session\n", __func__, idx,
+        decoder_session->dst_held);
+    return -EBUSY;
+  }
+  free(decoder_session);
   return 0;
 }
 
@@ -532,7 +787,7 @@ st_plugin_priv st_plugin_create(mtl_handle st) {
   d_dev.priv = ctx;
   d_dev.target_device = ST_PLUGIN_DEVICE_CPU;
   d_dev.input_fmt_caps = ST_FMT_CAP_H264_CBR_CODESTREAM;
-  d_dev.output_fmt_caps = ST_FMT_CAP_YUV422PLANAR8;
+  d_dev.output_fmt_caps = ST22_FFMPEG_FMT_CAPS;
   d_dev.create_session = decoder_create_session;
   d_dev.free_session = decoder_free_session;
   d_dev.notify_frame_available = decoder_frame_available;
@@ -548,7 +803,7 @@ st_plugin_priv st_plugin_create(mtl_handle st) {
   e_dev.name = "st22_ffmpeg_plugin_encoder";
   e_dev.priv = ctx;
   e_dev.target_device = ST_PLUGIN_DEVICE_CPU;
-  e_dev.input_fmt_caps = ST_FMT_CAP_YUV422PLANAR8;
+  e_dev.input_fmt_caps = ST22_FFMPEG_FMT_CAPS;
   e_dev.output_fmt_caps = ST_FMT_CAP_H264_CBR_CODESTREAM;
   e_dev.create_session = encoder_create_session;
   e_dev.free_session = encoder_free_session;
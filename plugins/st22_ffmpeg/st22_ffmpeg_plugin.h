@@ -6,7 +6,9 @@
 #define _ST22_FFMPEG_PLUGIN_HEAD_H_
 
 #include <libavcodec/avcodec.h>
+#include <libavutil/imgutils.h>
 #include <libavutil/opt.h>
+#include <libavutil/pixdesc.h>
 #include <mtl/st_pipeline_api.h>
 
 #define MAX_ST22_ENCODER_SESSIONS (8)
@@ -29,6 +31,16 @@ struct st22_encoder_session {
   AVCodecContext* codec_ctx;
   AVFrame* codec_frame;
   AVPacket* codec_pkt;
+  enum AVPixelFormat pix_fmt;
+  /* the refs of the wrapped src frame still held by libavcodec */
+  int src_refs;
+  /* the src frame kept for libavcodec refs, put back in encoder_src_free */
+  struct st22_encode_frame_meta* held_frame;
+  int held_result;
+  /* libavcodec keeps the src as a reference, encode from a copy since then */
+  bool src_copy;
+  int zero_copy_cnt;
+  int copy_cnt;
 };
 
 struct st22_decoder_session {
@@ -49,6 +61,19 @@ struct st22_decoder_session {
   AVFrame* codec_frame;
   AVPacket* codec_pkt;
   AVCodecParserContext* codec_parser;
+  enum AVPixelFormat pix_fmt;
+  /* the pipeline frame for the get_buffer2 of current packet */
+  struct st22_decode_frame_meta* cur_frame;
+  /* the dst frames held by libavcodec, the buffers are freed in the decode thread */
+  int dst_held;
+  int zero_copy_cnt;
+  int copy_cnt;
+};
+
+/* one dst frame referenced by an AVBuffer of libavcodec */
+struct st22_decoder_dst_hold {
+  struct st22_decoder_session* session;
+  struct st22_decode_frame_meta* frame;
 };
 
 struct st22_ffmpeg_ctx {
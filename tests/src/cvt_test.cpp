@@ -2,6 +2,9 @@
  * Copyright(c) 2022 Intel Corporation
  */
 
+#include <thread>
+#include <vector>
+
 #include "log.h"
 #include "tests.h"
 
@@ -58,6 +61,22 @@ TEST(Cvt, rfc4175_422be10_to_yuv422p10le_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_yuv422p10le_avx2) {
+  test_cvt_rfc4175_422be10_to_yuv422p10le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_yuv422p10le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_yuv422p10le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_yuv422p10le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be10_to_yuv422p10le(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be10_to_yuv422p10le_avx512) {
   test_cvt_rfc4175_422be10_to_yuv422p10le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                           MTL_SIMD_LEVEL_AVX512);
@@ -248,6 +267,22 @@ TEST(Cvt, yuv422p10le_to_rfc4175_422be10_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, yuv422p10le_to_rfc4175_422be10_avx2) {
+  test_cvt_yuv422p10le_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p10le_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p10le_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p10le_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_yuv422p10le_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, yuv422p10le_to_rfc4175_422be10_avx512) {
   test_cvt_yuv422p10le_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                           MTL_SIMD_LEVEL_AVX512);
@@ -979,6 +1014,18 @@ TEST(Cvt, rfc4175_422be10_to_422le8_scalar) {
                                      MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_422le8_avx2) {
+  test_cvt_rfc4175_422be10_to_422le8(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_422le8(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_422le8(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_422le8(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be10_to_422le8(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be10_to_422le8_avx512) {
   test_cvt_rfc4175_422be10_to_422le8(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                      MTL_SIMD_LEVEL_AVX512);
@@ -1168,6 +1215,14 @@ TEST(Cvt, rfc4175_422le10_to_v210_scalar) {
   test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422le10_to_v210_avx2) {
+  test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_422le10_to_v210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le10_to_v210(1921, 1079, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, rfc4175_422le10_to_v210_avx512) {
   test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1255,6 +1310,14 @@ TEST(Cvt, rfc4175_422be10_to_v210_scalar) {
   test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_v210_avx2) {
+  test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_422be10_to_v210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_v210(1921, 1079, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, rfc4175_422be10_to_v210_avx512) {
   test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1458,6 +1521,14 @@ TEST(Cvt, v210_to_rfc4175_422be10_scalar) {
   test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, v210_to_rfc4175_422be10_avx2) {
+  test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_v210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10(1921, 1079, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, v210_to_rfc4175_422be10_avx512) {
   test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1541,6 +1612,18 @@ TEST(Cvt, v210_to_rfc4175_422be10_2_scalar) {
                                      MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, v210_to_rfc4175_422be10_2_avx2) {
+  test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_NONE,
+                                     MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_NONE);
+  test_cvt_v210_to_rfc4175_422be10_2(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10_2(1921, 1079, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, v210_to_rfc4175_422be10_2_avx512) {
   test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                      MTL_SIMD_LEVEL_AVX512);
@@ -1729,6 +1812,17 @@ TEST(Cvt, rfc4175_422be10_to_y210_scalar) {
   test_cvt_rfc4175_422be10_to_y210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_y210_avx2) {
+  test_cvt_rfc4175_422be10_to_y210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_y210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_y210(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_y210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be10_to_y210(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be10_to_y210_avx512) {
   test_cvt_rfc4175_422be10_to_y210(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1869,6 +1963,17 @@ TEST(Cvt, y210_to_rfc4175_422be10_scalar) {
   test_cvt_y210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, y210_to_rfc4175_422be10_avx2) {
+  test_cvt_y210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_y210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_y210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_y210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_y210_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, y210_to_rfc4175_422be10_avx512) {
   test_cvt_y210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -2152,6 +2257,22 @@ TEST(Cvt, rfc4175_422be12_to_yuv422p12le_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be12_to_yuv422p12le_avx2) {
+  test_cvt_rfc4175_422be12_to_yuv422p12le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_yuv422p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_yuv422p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_yuv422p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be12_to_yuv422p12le(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be12_to_yuv422p12le_avx512) {
   test_cvt_rfc4175_422be12_to_yuv422p12le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                           MTL_SIMD_LEVEL_AVX512);
@@ -2319,6 +2440,54 @@ TEST(Cvt, yuv422p12le_to_rfc4175_422be12_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, yuv422p12le_to_rfc4175_422be12_avx2) {
+  test_cvt_yuv422p12le_to_rfc4175_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_yuv422p12le_to_rfc4175_422be12(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, yuv422p12le_to_rfc4175_422be12_avx512) {
+  test_cvt_yuv422p12le_to_rfc4175_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX512);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_yuv422p12le_to_rfc4175_422be12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                            MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, yuv422p12le_to_rfc4175_422be12_avx512_vbmi) {
+  test_cvt_yuv422p12le_to_rfc4175_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                          MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                          MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_yuv422p12le_to_rfc4175_422be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_yuv422p12le_to_rfc4175_422be12(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                            MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_rfc4175_422le12_to_yuv422p12le(int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -2458,6 +2627,18 @@ TEST(Cvt, rfc4175_422be12_to_422le12_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be12_to_422le12_avx2) {
+  test_cvt_rfc4175_422be12_to_422le12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be12_to_422le12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be12_to_422le12_avx512) {
   test_cvt_rfc4175_422be12_to_422le12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                       MTL_SIMD_LEVEL_AVX512);
@@ -2474,6 +2655,22 @@ TEST(Cvt, rfc4175_422be12_to_422le12_avx512) {
   }
 }
 
+TEST(Cvt, rfc4175_422be12_to_422le12_avx512_vbmi) {
+  test_cvt_rfc4175_422be12_to_422le12(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be12_to_422le12(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_rfc4175_422be12_to_422le12_dma(mtl_udma_handle dma, int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -2641,6 +2838,67 @@ TEST(Cvt, rfc4175_422le12_to_422be12_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422le12_to_422be12_avx2) {
+  test_cvt_rfc4175_422le12_to_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_422le12_to_422be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422le12_to_422be12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+    test_cvt_rfc4175_422le12_to_422be12_2(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_422le12_to_422be12_avx512) {
+  test_cvt_rfc4175_422le12_to_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_422le12_to_422be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422le12_to_422be12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+    test_cvt_rfc4175_422le12_to_422be12_2(w, h, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_422le12_to_422be12_avx512_vbmi) {
+  test_cvt_rfc4175_422le12_to_422be12(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_422le12_to_422be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_422le12_to_422be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_422le12_to_422be12_2(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422le12_to_422be12(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+    test_cvt_rfc4175_422le12_to_422be12_2(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                          MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_rotate_rfc4175_422be12_422le12_yuv422p12le(
     int w, int h, enum mtl_simd_level cvt1_level, enum mtl_simd_level cvt2_level,
     enum mtl_simd_level cvt3_level) {
@@ -2786,6 +3044,53 @@ TEST(Cvt, rfc4175_444be10_to_444p10le_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx2) {
+  test_cvt_rfc4175_444be10_to_444p10le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx512) {
+  test_cvt_rfc4175_444be10_to_444p10le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx512_vbmi) {
+  test_cvt_rfc4175_444be10_to_444p10le(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be10_to_444p10le(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                         MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_444p10le_to_rfc4175_444be10(int w, int h,
                                                  enum mtl_simd_level cvt_level,
                                                  enum mtl_simd_level back_level) {
@@ -2834,6 +3139,53 @@ TEST(Cvt, 444p10le_to_rfc4175_444be10_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, 444p10le_to_rfc4175_444be10_avx2) {
+  test_cvt_444p10le_to_rfc4175_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p10le_to_rfc4175_444be10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, 444p10le_to_rfc4175_444be10_avx512) {
+  test_cvt_444p10le_to_rfc4175_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p10le_to_rfc4175_444be10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, 444p10le_to_rfc4175_444be10_avx512_vbmi) {
+  test_cvt_444p10le_to_rfc4175_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_444p10le_to_rfc4175_444be10(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p10le_to_rfc4175_444be10(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                         MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_rfc4175_444le10_to_yuv444p10le(int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -3068,6 +3420,50 @@ TEST(Cvt, rfc4175_444be10_to_444le10_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be10_to_444le10_avx2) {
+  test_cvt_rfc4175_444be10_to_444le10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444le10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be10_to_444le10_avx512) {
+  test_cvt_rfc4175_444be10_to_444le10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444le10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444be10_to_444le10_avx512_vbmi) {
+  test_cvt_rfc4175_444be10_to_444le10(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be10_to_444le10(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444le10(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_rfc4175_444le10_to_444be10(int w, int h,
                                                 enum mtl_simd_level cvt_level,
                                                 enum mtl_simd_level back_level) {
@@ -3148,6 +3544,67 @@ TEST(Cvt, rfc4175_444le10_to_444be10_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444le10_to_444be10_avx2) {
+  test_cvt_rfc4175_444le10_to_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_444le10_to_444be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le10_to_444be10_2(722, 110, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le10_to_444be10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+    test_cvt_rfc4175_444le10_to_444be10_2(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444le10_to_444be10_avx512) {
+  test_cvt_rfc4175_444le10_to_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_444le10_to_444be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le10_to_444be10_2(722, 110, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le10_to_444be10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+    test_cvt_rfc4175_444le10_to_444be10_2(w, h, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444le10_to_444be10_avx512_vbmi) {
+  test_cvt_rfc4175_444le10_to_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le10_to_444be10(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_444le10_to_444be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le10_to_444be10_2(722, 110, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le10_to_444be10(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+    test_cvt_rfc4175_444le10_to_444be10_2(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                          MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_rotate_rfc4175_444be10_444le10_444p10le(int w, int h,
                                                          enum mtl_simd_level cvt1_level,
                                                          enum mtl_simd_level cvt2_level,
@@ -3295,6 +3752,53 @@ TEST(Cvt, rfc4175_444be12_to_444p12le_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx2) {
+  test_cvt_rfc4175_444be12_to_444p12le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx512) {
+  test_cvt_rfc4175_444be12_to_444p12le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx512_vbmi) {
+  test_cvt_rfc4175_444be12_to_444p12le(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                         MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_444p12le_to_rfc4175_444be12(int w, int h,
                                                  enum mtl_simd_level cvt_level,
                                                  enum mtl_simd_level back_level) {
@@ -3343,6 +3847,53 @@ TEST(Cvt, 444p12le_to_rfc4175_444be12_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, 444p12le_to_rfc4175_444be12_avx2) {
+  test_cvt_444p12le_to_rfc4175_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p12le_to_rfc4175_444be12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, 444p12le_to_rfc4175_444be12_avx512) {
+  test_cvt_444p12le_to_rfc4175_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p12le_to_rfc4175_444be12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, 444p12le_to_rfc4175_444be12_avx512_vbmi) {
+  test_cvt_444p12le_to_rfc4175_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p12le_to_rfc4175_444be12(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                         MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_rfc4175_444le12_to_yuv444p12le(int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -3577,6 +4128,50 @@ TEST(Cvt, rfc4175_444be12_to_444le12_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be12_to_444le12_avx2) {
+  test_cvt_rfc4175_444be12_to_444le12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444le12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be12_to_444le12_avx512) {
+  test_cvt_rfc4175_444be12_to_444le12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444le12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444be12_to_444le12_avx512_vbmi) {
+  test_cvt_rfc4175_444be12_to_444le12(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444le12(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_cvt_rfc4175_444le12_to_444be12(int w, int h,
                                                 enum mtl_simd_level cvt_level,
                                                 enum mtl_simd_level back_level) {
@@ -3657,6 +4252,67 @@ TEST(Cvt, rfc4175_444le12_to_444be12_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444le12_to_444be12_avx2) {
+  test_cvt_rfc4175_444le12_to_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_444le12_to_444be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le12_to_444be12_2(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                        MTL_SIMD_LEVEL_AVX2);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le12_to_444be12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+    test_cvt_rfc4175_444le12_to_444be12_2(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444le12_to_444be12_avx512) {
+  test_cvt_rfc4175_444le12_to_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_444le12_to_444be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le12_to_444be12_2(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le12_to_444be12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+    test_cvt_rfc4175_444le12_to_444be12_2(w, h, MTL_SIMD_LEVEL_AVX512,
+                                          MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
+TEST(Cvt, rfc4175_444le12_to_444be12_avx512_vbmi) {
+  test_cvt_rfc4175_444le12_to_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le12_to_444be12(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                      MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_444le12_to_444be12_2(1920, 1080, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  test_cvt_rfc4175_444le12_to_444be12_2(722, 111, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le12_to_444be12(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                        MTL_SIMD_LEVEL_AVX512_VBMI2);
+    test_cvt_rfc4175_444le12_to_444be12_2(w, h, MTL_SIMD_LEVEL_AVX512_VBMI2,
+                                          MTL_SIMD_LEVEL_AVX512_VBMI2);
+  }
+}
+
 static void test_rotate_rfc4175_444be12_444le12_444p12le(int w, int h,
                                                          enum mtl_simd_level cvt1_level,
                                                          enum mtl_simd_level cvt2_level,
@@ -4103,3 +4759,355 @@ TEST(Cvt, st_frame_convert_rotate_mix_padding) {
   frame_free(&dst);
   frame_free(&new_src);
 }
+
+static int rgb_frame_get(struct st_frame* frame, uint32_t line, uint32_t x, int c) {
+  if (frame->fmt == ST_FRAME_FMT_RGB8) {
+    uint8_t* rgb = (uint8_t*)frame->addr[0] + frame->linesize[0] * line;
+    return rgb[x * 3 + c];
+  }
+  /* gbr planes for r, g, b */
+  int plane = (c + 2) % 3;
+  uint16_t* p = (uint16_t*)((uint8_t*)frame->addr[plane] + frame->linesize[plane] * line);
+  return p[x];
+}
+
+static void rgb_frame_set(struct st_frame* frame, uint32_t line, uint32_t x, int c,
+                          int v) {
+  if (frame->fmt == ST_FRAME_FMT_RGB8) {
+    uint8_t* rgb = (uint8_t*)frame->addr[0] + frame->linesize[0] * line;
+    rgb[x * 3 + c] = v;
+    return;
+  }
+  int plane = (c + 2) % 3;
+  uint16_t* p = (uint16_t*)((uint8_t*)frame->addr[plane] + frame->linesize[plane] * line);
+  p[x] = v;
+}
+
+/* 422 chroma is filtered, only the flat lines can back to the same RGB */
+static void test_st_frame_convert_rgb_yuv(enum st_frame_fmt rgb_fmt,
+                                          enum st_frame_fmt yuv_fmt, int depth,
+                                          enum st_frame_color_matrix matrix,
+                                          bool full_range, bool flat) {
+  struct st_frame src, dst, new_src;
+  int max = (1 << depth) - 1;
+  int ret;
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  memset(&new_src, 0, sizeof(new_src));
+  dst.color_matrix = matrix;
+  dst.color_full_range = full_range;
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 64;
+  src.fmt = new_src.fmt = rgb_fmt;
+  dst.fmt = yuv_fmt;
+  frame_malloc(&src, 0, false);
+  frame_malloc(&dst, 0, true);
+  frame_malloc(&new_src, 0, false);
+
+  for (uint32_t line = 0; line < src.height; line++) {
+    int color[3];
+    for (int c = 0; c < 3; c++) color[c] = rand() & max;
+    for (uint32_t x = 0; x < src.width; x++) {
+      for (int c = 0; c < 3; c++) {
+        rgb_frame_set(&src, line, x, c, flat ? color[c] : (rand() & max));
+      }
+    }
+  }
+
+  ret = st_frame_convert(&src, &dst);
+  EXPECT_EQ(0, ret);
+  ret = st_frame_convert(&dst, &new_src);
+  EXPECT_EQ(0, ret);
+
+  int max_diff = 0;
+  for (uint32_t line = 0; line < src.height; line++) {
+    for (uint32_t x = 0; x < src.width; x++) {
+      for (int c = 0; c < 3; c++) {
+        int diff =
+            abs(rgb_frame_get(&src, line, x, c) - rgb_frame_get(&new_src, line, x, c));
+        if (diff > max_diff) max_diff = diff;
+      }
+    }
+  }
+  EXPECT_LE(max_diff, 2);
+
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
+}
+
+TEST(Cvt, st_frame_convert_rgb_yuv) {
+  for (int i = 0; i < ST_FRAME_COLOR_MATRIX_MAX; i++) {
+    enum st_frame_color_matrix matrix = (enum st_frame_color_matrix)i;
+    for (int full = 0; full < 2; full++) {
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_RGB8, ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                                    8, matrix, full, true);
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_RGB8, ST_FRAME_FMT_YUV422RFC4175PG2BE12,
+                                    8, matrix, full, true);
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_RGB8, ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+                                    8, matrix, full, false);
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_RGB8, ST_FRAME_FMT_YUV444RFC4175PG2BE12,
+                                    8, matrix, full, false);
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_GBRPLANAR10LE,
+                                    ST_FRAME_FMT_YUV422RFC4175PG2BE10, 10, matrix, full,
+                                    true);
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_GBRPLANAR12LE,
+                                    ST_FRAME_FMT_YUV422RFC4175PG2BE12, 12, matrix, full,
+                                    true);
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_GBRPLANAR10LE,
+                                    ST_FRAME_FMT_YUV444RFC4175PG4BE10, 10, matrix, full,
+                                    false);
+      test_st_frame_convert_rgb_yuv(ST_FRAME_FMT_GBRPLANAR12LE,
+                                    ST_FRAME_FMT_YUV444RFC4175PG2BE12, 12, matrix, full,
+                                    false);
+    }
+  }
+}
+
+TEST(Cvt, st_frame_convert_rgb_yuv_bt709) {
+  struct st_frame src, dst;
+  /* white, black, red and the codes of bt709 10bit narrow range */
+  int rgb[3][3] = {{1023, 1023, 1023}, {0, 0, 0}, {1023, 0, 0}};
+  uint16_t yuv[3][3] = {{940, 512, 512}, {64, 512, 512}, {250, 409, 960}};
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  dst.color_matrix = ST_FRAME_COLOR_MATRIX_BT709;
+  dst.color_full_range = false;
+  src.width = dst.width = 16;
+  src.height = dst.height = 3;
+  src.fmt = ST_FRAME_FMT_GBRPLANAR10LE;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  frame_malloc(&src, 0, false);
+  frame_malloc(&dst, 0, false);
+  for (uint32_t line = 0; line < src.height; line++) {
+    for (uint32_t x = 0; x < src.width; x++) {
+      for (int c = 0; c < 3; c++) rgb_frame_set(&src, line, x, c, rgb[line][c]);
+    }
+  }
+
+  EXPECT_EQ(0, st_frame_convert(&src, &dst));
+  /* the matrix is from the yuv frame */
+  dst.color_matrix = ST_FRAME_COLOR_MATRIX_MAX;
+  EXPECT_NE(0, st_frame_convert(&src, &dst));
+  dst.color_matrix = ST_FRAME_COLOR_MATRIX_BT709;
+
+  uint16_t y[16], b[8], r[8];
+  for (uint32_t line = 0; line < dst.height; line++) {
+    struct st20_rfc4175_422_10_pg2_be* pg =
+        (struct st20_rfc4175_422_10_pg2_be*)((uint8_t*)dst.addr[0] +
+                                             dst.linesize[0] * line);
+    st20_rfc4175_422be10_to_yuv422p10le(pg, y, b, r, dst.width, 1);
+    EXPECT_EQ(yuv[line][0], y[0]);
+    EXPECT_EQ(yuv[line][1], b[0]);
+    EXPECT_EQ(yuv[line][2], r[0]);
+    EXPECT_EQ(yuv[line][0], y[15]);
+  }
+
+  frame_free(&src);
+  frame_free(&dst);
+}
+
+static int frame_compare_buffer(struct st_frame* a, struct st_frame* b) {
+  int planes = st_frame_fmt_planes(a->fmt);
+  int ret = 0;
+
+  for (int plane = 0; plane < planes; plane++) {
+    size_t a_linesize = a->linesize[plane];
+    size_t b_linesize = b->linesize[plane];
+    size_t least = st_frame_least_linesize(a->fmt, a->width, plane);
+    if (!a_linesize) a_linesize = least;
+    if (!b_linesize) b_linesize = least;
+    for (uint32_t line = 0; line < a->height; line++) {
+      ret += memcmp((uint8_t*)a->addr[plane] + a_linesize * line,
+                    (uint8_t*)b->addr[plane] + b_linesize * line, least);
+    }
+  }
+
+  return ret;
+}
+
+/* the rfc4175 RGB frame should convert the same as the gbr planes of the same data */
+static void test_st_frame_convert_rgb_rfc4175_yuv(enum st_frame_fmt rgb_fmt,
+                                                  enum st_frame_fmt gbr_fmt,
+                                                  enum st_frame_fmt yuv_fmt, int depth) {
+  struct st_frame gbr, rgb, yuv, gbr_yuv, new_rgb, new_gbr;
+  int max = (1 << depth) - 1;
+
+  memset(&gbr, 0, sizeof(gbr));
+  memset(&rgb, 0, sizeof(rgb));
+  memset(&yuv, 0, sizeof(yuv));
+  memset(&gbr_yuv, 0, sizeof(gbr_yuv));
+  memset(&new_rgb, 0, sizeof(new_rgb));
+  memset(&new_gbr, 0, sizeof(new_gbr));
+  gbr.width = rgb.width = yuv.width = gbr_yuv.width = 1920;
+  new_rgb.width = new_gbr.width = 1920;
+  gbr.height = rgb.height = yuv.height = gbr_yuv.height = 16;
+  new_rgb.height = new_gbr.height = 16;
+  gbr.fmt = new_gbr.fmt = gbr_fmt;
+  rgb.fmt = new_rgb.fmt = rgb_fmt;
+  yuv.fmt = gbr_yuv.fmt = yuv_fmt;
+  yuv.color_matrix = gbr_yuv.color_matrix = ST_FRAME_COLOR_MATRIX_BT2020;
+  frame_malloc(&gbr, 0, false);
+  frame_malloc(&rgb, 0, true);
+  frame_malloc(&yuv, 0, false);
+  frame_malloc(&gbr_yuv, 0, true);
+  frame_malloc(&new_rgb, 0, false);
+  frame_malloc(&new_gbr, 0, false);
+
+  for (uint32_t line = 0; line < gbr.height; line++) {
+    for (uint32_t x = 0; x < gbr.width; x++) {
+      for (int c = 0; c < 3; c++) rgb_frame_set(&gbr, line, x, c, rand() & max);
+    }
+  }
+  /* pack the gbr planes to the rfc4175 RGB frame */
+  EXPECT_EQ(0, st_frame_convert(&gbr, &rgb));
+
+  EXPECT_EQ(0, st_frame_convert(&rgb, &yuv));
+  EXPECT_EQ(0, st_frame_convert(&gbr, &gbr_yuv));
+  EXPECT_EQ(0, frame_compare_buffer(&yuv, &gbr_yuv));
+
+  EXPECT_EQ(0, st_frame_convert(&yuv, &new_rgb));
+  EXPECT_EQ(0, st_frame_convert(&yuv, &new_gbr));
+  EXPECT_EQ(0, st_frame_convert(&new_rgb, &gbr));
+  EXPECT_EQ(0, frame_compare_buffer(&gbr, &new_gbr));
+
+  frame_free(&gbr);
+  frame_free(&rgb);
+  frame_free(&yuv);
+  frame_free(&gbr_yuv);
+  frame_free(&new_rgb);
+  frame_free(&new_gbr);
+}
+
+TEST(Cvt, st_frame_convert_rgb_rfc4175_yuv) {
+  test_st_frame_convert_rgb_rfc4175_yuv(ST_FRAME_FMT_RGBRFC4175PG4BE10,
+                                        ST_FRAME_FMT_GBRPLANAR10LE,
+                                        ST_FRAME_FMT_YUV422RFC4175PG2BE10, 10);
+  test_st_frame_convert_rgb_rfc4175_yuv(ST_FRAME_FMT_RGBRFC4175PG4BE10,
+                                        ST_FRAME_FMT_GBRPLANAR10LE,
+                                        ST_FRAME_FMT_YUV444RFC4175PG4BE10, 10);
+  test_st_frame_convert_rgb_rfc4175_yuv(ST_FRAME_FMT_RGBRFC4175PG2BE12,
+                                        ST_FRAME_FMT_GBRPLANAR12LE,
+                                        ST_FRAME_FMT_YUV422RFC4175PG2BE12, 12);
+  test_st_frame_convert_rgb_rfc4175_yuv(ST_FRAME_FMT_RGBRFC4175PG2BE12,
+                                        ST_FRAME_FMT_GBRPLANAR12LE,
+                                        ST_FRAME_FMT_YUV444RFC4175PG2BE12, 12);
+}
+
+/* all bands of st_frame_convert_band should give the same frame as one convert */
+static void test_st_frame_convert_band(enum st_frame_fmt src_fmt,
+                                       enum st_frame_fmt dst_fmt, uint32_t w, uint32_t h,
+                                       bool padding, bool zero_linesize) {
+  struct st_frame src, dst, band_dst;
+  int ret;
+
+  src.width = dst.width = band_dst.width = w;
+  src.height = dst.height = band_dst.height = h;
+  src.interlaced = dst.interlaced = band_dst.interlaced = false;
+  src.fmt = src_fmt;
+  dst.fmt = band_dst.fmt = dst_fmt;
+  frame_malloc(&src, 1, padding);
+  frame_malloc(&dst, 0, padding);
+  frame_malloc(&band_dst, 0, padding);
+  if (zero_linesize) { /* no padding, let the lib derive the line stride */
+    for (int plane = 0; plane < ST_MAX_PLANES; plane++) {
+      src.linesize[plane] = 0;
+      band_dst.linesize[plane] = 0;
+    }
+  }
+
+  ret = st_frame_convert(&src, &dst);
+  EXPECT_EQ(0, ret);
+
+  for (uint32_t band_cnt = 1; band_cnt <= 7; band_cnt++) {
+    memset(band_dst.addr[0], 0, band_dst.buffer_size);
+    for (uint32_t band = 0; band < band_cnt; band++) {
+      ret = st_frame_convert_band(&src, &band_dst, band, band_cnt);
+      EXPECT_EQ(0, ret);
+    }
+    ret = frame_compare_buffer(&dst, &band_dst);
+    EXPECT_EQ(0, ret) << "band_cnt " << band_cnt;
+  }
+  EXPECT_NE(0, st_frame_convert_band(&src, &band_dst, 1, 1));
+  EXPECT_NE(0, st_frame_convert_band(&src, &band_dst, 0, 0));
+
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&band_dst);
+}
+
+TEST(Cvt, st_frame_convert_band) {
+  test_st_frame_convert_band(ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                             ST_FRAME_FMT_YUV422PLANAR10LE, 1920, 1080, false, false);
+  test_st_frame_convert_band(ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                             ST_FRAME_FMT_YUV422PLANAR10LE, 1920, 1081, true, false);
+  test_st_frame_convert_band(ST_FRAME_FMT_YUV422RFC4175PG2BE10, ST_FRAME_FMT_V210,
+                             1280, 721, false, false);
+  test_st_frame_convert_band(ST_FRAME_FMT_V210, ST_FRAME_FMT_YUV422RFC4175PG2BE10, 1920,
+                             1080, true, false);
+  test_st_frame_convert_band(ST_FRAME_FMT_YUV444RFC4175PG4BE10,
+                             ST_FRAME_FMT_GBRPLANAR10LE, 1920, 1080, false, false);
+}
+
+TEST(Cvt, st_frame_convert_band_zero_linesize) {
+  test_st_frame_convert_band(ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+                             ST_FRAME_FMT_YUV422PLANAR10LE, 1920, 1080, false, true);
+  test_st_frame_convert_band(ST_FRAME_FMT_YUV422RFC4175PG2BE10, ST_FRAME_FMT_Y210, 1920,
+                             1081, false, true);
+  test_st_frame_convert_band(ST_FRAME_FMT_GBRPLANAR12LE,
+                             ST_FRAME_FMT_YUV444RFC4175PG2BE12, 1280, 720, false, true);
+}
+
+/* the band pool output should be same as the one thread convert */
+static void test_st_frame_convert_threads(uint8_t threads, int callers) {
+  std::vector<struct st_frame> src(callers), dst(callers), ref(callers);
+  std::vector<std::thread> convert_thread(callers);
+  std::vector<int> result(callers);
+
+  for (int i = 0; i < callers; i++) {
+    src[i].width = dst[i].width = ref[i].width = 1920;
+    src[i].height = dst[i].height = ref[i].height = 1080;
+    src[i].interlaced = dst[i].interlaced = ref[i].interlaced = false;
+    src[i].fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+    dst[i].fmt = ref[i].fmt = ST_FRAME_FMT_YUV422PLANAR10LE;
+    frame_malloc(&src[i], i + 1, false);
+    frame_malloc(&dst[i], 0, i % 2);
+    frame_malloc(&ref[i], 0, false);
+    EXPECT_EQ(0, st_frame_convert(&src[i], &ref[i]));
+  }
+
+  EXPECT_EQ(0, st_frame_convert_set_threads(threads));
+  for (int i = 0; i < callers; i++) {
+    convert_thread[i] = std::thread([&, i]() {
+      result[i] = 0;
+      for (int loop = 0; loop < 8; loop++) {
+        int ret = st_frame_convert(&src[i], &dst[i]);
+        if (ret < 0) result[i] = ret;
+      }
+    });
+  }
+  for (int i = 0; i < callers; i++) {
+    convert_thread[i].join();
+    EXPECT_EQ(0, result[i]);
+    EXPECT_EQ(0, frame_compare_buffer(&ref[i], &dst[i]));
+  }
+  EXPECT_EQ(0, st_frame_convert_set_threads(1));
+
+  for (int i = 0; i < callers; i++) {
+    frame_free(&src[i]);
+    frame_free(&dst[i]);
+    frame_free(&ref[i]);
+  }
+}
+
+TEST(Cvt, st_frame_convert_threads) {
+  test_st_frame_convert_threads(4, 1);
+  test_st_frame_convert_threads(8, 1);
+}
+
+TEST(Cvt, st_frame_convert_threads_concurrent) {
+  test_st_frame_convert_threads(4, 3);
+  test_st_frame_convert_threads(2, 4);
+}
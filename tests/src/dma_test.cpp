@@ -2,6 +2,10 @@
  * Copyright(c) 2022 Intel Corporation
  */
 
+#ifndef WINDOWSENV
+#include <sys/mman.h>
+#endif
+
 #include "log.h"
 #include "tests.h"
 
@@ -506,4 +510,265 @@ TEST(Dma, mem_alloc_free) {
   temtl_dma_mem_alloc_free(ctx, 2222);
   temtl_dma_mem_alloc_free(ctx, 33333);
   temtl_dma_mem_alloc_free(ctx, 444444);
-}
\ No newline at end of file
+}
+
+static int test_dma_map_ext_next_frame(void* priv, uint16_t* next_frame_idx,
+                                       struct st20_tx_frame_meta* meta) {
+  return -EBUSY; /* only the ext frame mapping is tested */
+}
+
+/* the ext frames carved from one buffer share the partial pages with the neighbours */
+static void test_dma_map_ext_shared_page(struct st_tests_context* ctx, uint16_t fb_cnt) {
+  auto st = ctx->handle;
+  size_t pg_sz = mtl_page_size(st);
+  struct st20_tx_ops ops;
+
+  memset(&ops, 0, sizeof(ops));
+  ops.name = "dma_map_test";
+  ops.num_port = 1;
+  memcpy(ops.dip_addr[MTL_SESSION_PORT_P], ctx->mcast_ip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops.udp_port[MTL_SESSION_PORT_P] = 10000;
+  ops.pacing = ST21_PACING_NARROW;
+  ops.type = ST20_TYPE_FRAME_LEVEL;
+  ops.width = 1920;
+  ops.height = 1080;
+  ops.fps = ST_FPS_P59_94;
+  ops.fmt = ST20_FMT_YUV_422_10BIT;
+  ops.payload_type = 112;
+  ops.framebuff_cnt = fb_cnt;
+  ops.flags = ST20_TX_FLAG_EXT_FRAME;
+  ops.get_next_frame = test_dma_map_ext_next_frame;
+
+  st20_tx_handle handle = st20_tx_create(st, &ops);
+  ASSERT_TRUE(handle != NULL);
+  size_t frame_size = st20_tx_get_framebuffer_size(handle);
+  ASSERT_TRUE(frame_size % pg_sz != 0);
+
+  /* not page aligned start, no page multiple size */
+  uint8_t* p = (uint8_t*)malloc(frame_size * fb_cnt + pg_sz);
+  ASSERT_TRUE(p != NULL);
+  uint8_t* base = p + 64;
+  struct st20_ext_frame ext;
+  int ret;
+
+  /* the even frames firstly, then the odd ones fill the gaps between */
+  for (int pass = 0; pass < 2; pass++) {
+    for (uint16_t i = pass; i < fb_cnt; i += 2) {
+      ext.buf_addr = base + i * frame_size;
+      ext.buf_iova = 0; /* lib to map it */
+      ext.buf_len = frame_size;
+      ret = st20_tx_set_ext_frame(handle, i, &ext);
+      EXPECT_GE(ret, 0);
+    }
+  }
+  /* set again before transmitted */
+  for (uint16_t i = 0; i < fb_cnt; i++) {
+    ext.buf_addr = base + i * frame_size;
+    ext.buf_iova = 0;
+    ext.buf_len = frame_size;
+    ret = st20_tx_set_ext_frame(handle, i, &ext);
+    EXPECT_GE(ret, 0);
+  }
+
+  ret = st20_tx_free(handle);
+  EXPECT_GE(ret, 0);
+  free(p);
+}
+
+TEST(Dma, map_ext_shared_page) {
+  struct st_tests_context* ctx = st_test_ctx();
+
+  if (ctx->iova == MTL_IOVA_MODE_PA) {
+    info("%s, skip as it's IOVA PA mode\n", __func__);
+    return;
+  }
+
+  test_dma_map_ext_shared_page(ctx, 3);
+  /* the mappings of last round are unmapped with the session, map again */
+  test_dma_map_ext_shared_page(ctx, 5);
+}
+
+#ifndef WINDOWSENV
+struct test_dma_realloc_ctx {
+  void* tx;
+  void* rx;
+  bool tx_ready;
+  bool tx_in_use;
+  size_t frame_size;
+  uint8_t* expect[2]; /* the payload before and after the realloc */
+  int rx_cnt[2];
+  int rx_fail_cnt;
+};
+
+static int test_dma_realloc_next_frame(void* priv, uint16_t* next_frame_idx,
+                                       struct st20_tx_frame_meta* meta) {
+  auto ctx = (struct test_dma_realloc_ctx*)priv;
+
+  if (!ctx->tx_ready || ctx->tx_in_use) return -EBUSY;
+  ctx->tx_in_use = true;
+  *next_frame_idx = 0;
+  return 0;
+}
+
+static int test_dma_realloc_frame_done(void* priv, uint16_t frame_idx,
+                                       struct st20_tx_frame_meta* meta) {
+  auto ctx = (struct test_dma_realloc_ctx*)priv;
+
+  ctx->tx_in_use = false;
+  return 0;
+}
+
+static int test_dma_realloc_frame_ready(void* priv, void* frame,
+                                        struct st20_rx_frame_meta* meta) {
+  auto ctx = (struct test_dma_realloc_ctx*)priv;
+
+  if (!ctx->rx) return -EIO;
+
+  if (st_is_frame_complete(meta->status)) {
+    if (!memcmp(frame, ctx->expect[0], ctx->frame_size))
+      ctx->rx_cnt[0]++;
+    else if (!memcmp(frame, ctx->expect[1], ctx->frame_size))
+      ctx->rx_cnt[1]++;
+    else
+      ctx->rx_fail_cnt++;
+  }
+  st20_rx_put_framebuff((st20_rx_handle)ctx->rx, frame);
+  return 0;
+}
+
+static void test_dma_realloc_send(struct test_dma_realloc_ctx* ctx, int sec) {
+  ctx->tx_ready = true;
+  sleep(sec);
+  ctx->tx_ready = false;
+  /* wait the frame done */
+  for (int i = 0; i < 100 && ctx->tx_in_use; i++) st_usleep(10 * 1000);
+  EXPECT_FALSE(ctx->tx_in_use);
+}
+
+/* the ext frame is freed and a new buffer is allocated on the same va */
+static void test_dma_map_ext_realloc(struct st_tests_context* ctx) {
+  auto st = ctx->handle;
+  size_t pg_sz = mtl_page_size(st);
+  struct test_dma_realloc_ctx test_ctx;
+  struct st20_tx_ops ops_tx;
+  struct st20_rx_ops ops_rx;
+  struct st20_ext_frame ext;
+  int ret;
+
+  memset(&test_ctx, 0, sizeof(test_ctx));
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "dma_realloc_test";
+  ops_tx.priv = &test_ctx;
+  ops_tx.num_port = 1;
+  memcpy(ops_tx.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops_tx.udp_port[MTL_SESSION_PORT_P] = 10000;
+  ops_tx.pacing = ST21_PACING_NARROW;
+  ops_tx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_tx.width = 1280;
+  ops_tx.height = 720;
+  ops_tx.fps = ST_FPS_P59_94;
+  ops_tx.fmt = ST20_FMT_YUV_422_10BIT;
+  ops_tx.payload_type = 112;
+  ops_tx.framebuff_cnt = 2;
+  ops_tx.flags = ST20_TX_FLAG_EXT_FRAME;
+  ops_tx.get_next_frame = test_dma_realloc_next_frame;
+  ops_tx.notify_frame_done = test_dma_realloc_frame_done;
+  st20_tx_handle tx = st20_tx_create(st, &ops_tx);
+  ASSERT_TRUE(tx != NULL);
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "dma_realloc_test";
+  ops_rx.priv = &test_ctx;
+  ops_rx.num_port = 1;
+  memcpy(ops_rx.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_rx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  ops_rx.udp_port[MTL_SESSION_PORT_P] = 10000;
+  ops_rx.pacing = ST21_PACING_NARROW;
+  ops_rx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_rx.width = ops_tx.width;
+  ops_rx.height = ops_tx.height;
+  ops_rx.fps = ops_tx.fps;
+  ops_rx.fmt = ops_tx.fmt;
+  ops_rx.payload_type = 112;
+  ops_rx.framebuff_cnt = 3;
+  ops_rx.notify_frame_ready = test_dma_realloc_frame_ready;
+  st20_rx_handle rx = st20_rx_create(st, &ops_rx);
+  ASSERT_TRUE(rx != NULL);
+
+  size_t frame_size = st20_tx_get_framebuffer_size(tx);
+  size_t map_size = mtl_size_page_align(frame_size, pg_sz);
+  test_ctx.frame_size = frame_size;
+  for (int i = 0; i < 2; i++) {
+    test_ctx.expect[i] = (uint8_t*)st_test_zmalloc(frame_size);
+    ASSERT_TRUE(test_ctx.expect[i] != NULL);
+    memset(test_ctx.expect[i], 0x5a + i, frame_size);
+  }
+  test_ctx.tx = tx;
+  test_ctx.rx = rx;
+
+  uint8_t* buf = (uint8_t*)mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_TRUE(buf != MAP_FAILED);
+  memcpy(buf, test_ctx.expect[0], frame_size);
+  ext.buf_addr = buf;
+  ext.buf_iova = 0; /* lib to map it */
+  ext.buf_len = frame_size;
+  ret = st20_tx_set_ext_frame(tx, 0, &ext);
+  EXPECT_GE(ret, 0);
+
+  ret = mtl_start(st);
+  EXPECT_GE(ret, 0);
+  test_dma_realloc_send(&test_ctx, 2);
+
+  /* free and get new pages on the same va, the old mapping must not be hit */
+  munmap(buf, map_size);
+  uint8_t* new_buf = (uint8_t*)mmap(buf, map_size, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+  ASSERT_TRUE(new_buf == buf);
+  memcpy(buf, test_ctx.expect[1], frame_size);
+  ret = st20_tx_set_ext_frame(tx, 0, &ext);
+  EXPECT_GE(ret, 0);
+  int rx_cnt_first = test_ctx.rx_cnt[0];
+  test_dma_realloc_send(&test_ctx, 2);
+
+  ret = mtl_stop(st);
+  EXPECT_GE(ret, 0);
+  info("%s, rx cnt %d:%d fail %d\n", __func__, test_ctx.rx_cnt[0], test_ctx.rx_cnt[1],
+       test_ctx.rx_fail_cnt);
+  EXPECT_GT(rx_cnt_first, 0);
+  EXPECT_GT(test_ctx.rx_cnt[1], 0);
+  EXPECT_EQ(test_ctx.rx_fail_cnt, 0);
+
+  test_ctx.rx = NULL;
+  ret = st20_rx_free(rx);
+  EXPECT_GE(ret, 0);
+  ret = st20_tx_free(tx);
+  EXPECT_GE(ret, 0);
+  munmap(buf, map_size);
+  for (int i = 0; i < 2; i++) st_test_free(test_ctx.expect[i]);
+}
+
+TEST(Dma, map_ext_realloc) {
+  struct st_tests_context* ctx = st_test_ctx();
+
+  if (ctx->iova == MTL_IOVA_MODE_PA) {
+    info("%s, skip as it's IOVA PA mode\n", __func__);
+    return;
+  }
+  if (ctx->para.num_ports != 2) {
+    info("%s, skip as dual port is needed, one for tx and one for rx\n", __func__);
+    return;
+  }
+
+  test_dma_map_ext_realloc(ctx);
+}
+#endif
@@ -841,6 +841,107 @@ static void st20_tx_fps_test(enum st20_type type[], enum st_fps fps[], int width
   }
 }
 
+/* frame owner check for the next frame prepared before the frame boundary */
+struct st20_tx_prepare_check {
+  int in_use_cnt;
+  int in_use_max;
+  int done_fail_cnt;
+};
+
+static int tx_next_video_frame_prepare(void* priv, uint16_t* next_frame_idx,
+                                       struct st20_tx_frame_meta* meta) {
+  auto ctx = (tests_context*)priv;
+  auto check = (struct st20_tx_prepare_check*)ctx->priv;
+
+  if (!ctx->handle) return -EIO; /* not ready */
+
+  if (ctx->ext_fb_in_use[ctx->fb_idx]) return -EBUSY; /* not done yet */
+  ctx->ext_fb_in_use[ctx->fb_idx] = true;
+  check->in_use_cnt++;
+  check->in_use_max = std::max(check->in_use_max, check->in_use_cnt);
+
+  *next_frame_idx = ctx->fb_idx;
+  ctx->fb_idx++;
+  if (ctx->fb_idx >= ctx->fb_cnt) ctx->fb_idx = 0;
+  ctx->fb_send++;
+  return 0;
+}
+
+static int tx_notify_frame_done_prepare(void* priv, uint16_t frame_idx,
+                                        struct st20_tx_frame_meta* meta) {
+  auto ctx = (tests_context*)priv;
+  auto check = (struct st20_tx_prepare_check*)ctx->priv;
+
+  if (!ctx->handle) return -EIO; /* not ready */
+
+  if (!ctx->ext_fb_in_use[frame_idx]) {
+    err("%s, frame %u done but not in use\n", __func__, frame_idx);
+    check->done_fail_cnt++;
+    return -EIO;
+  }
+  ctx->ext_fb_in_use[frame_idx] = false;
+  check->in_use_cnt--;
+  ctx->fb_send_done++;
+  return 0;
+}
+
+/*
+ * the next frame is got from app while current frame is sending, it has to be kept over
+ * the stop/start and returned on free without a notify_frame_done as it's never sent.
+ */
+static void st20_tx_next_frame_prepare_test(enum st_test_level level) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  struct st20_tx_ops ops;
+  st20_tx_handle handle;
+  int ret;
+
+  /* return if level small than global */
+  if (level < ctx->level) return;
+
+  auto test_ctx = new tests_context();
+  ASSERT_TRUE(test_ctx != NULL);
+  test_ctx->idx = 0;
+  test_ctx->ctx = ctx;
+  test_ctx->fb_cnt = 3;
+  test_ctx->fb_idx = 0;
+  size_t check_sz = sizeof(struct st20_tx_prepare_check);
+  auto check = (struct st20_tx_prepare_check*)st_test_zmalloc(check_sz);
+  ASSERT_TRUE(check != NULL);
+  test_ctx->priv = check; /* freed in tests_context_unit */
+  st20_tx_ops_init(test_ctx, &ops);
+  ops.packing = ST20_PACKING_BPM;
+  ops.get_next_frame = tx_next_video_frame_prepare;
+  ops.notify_frame_done = tx_notify_frame_done_prepare;
+  handle = st20_tx_create(m_handle, &ops);
+  ASSERT_TRUE(handle != NULL);
+  test_ctx->handle = handle;
+
+  /* the stop/start restarts the pacing with a prepared frame */
+  for (int i = 0; i < 2; i++) {
+    ret = mtl_start(m_handle);
+    EXPECT_GE(ret, 0);
+    sleep(2);
+    ret = mtl_stop(m_handle);
+    EXPECT_GE(ret, 0);
+  }
+  int fb_send = test_ctx->fb_send;
+
+  ret = st20_tx_free(handle);
+  EXPECT_GE(ret, 0);
+  info("%s, fb_send %d fb_send_done %d in_use max %d left %d\n", __func__, fb_send,
+       test_ctx->fb_send_done, check->in_use_max, check->in_use_cnt);
+  EXPECT_GT(fb_send, 0);
+  EXPECT_GT(test_ctx->fb_send_done, 0);
+  EXPECT_EQ(check->done_fail_cnt, 0);
+  /* one frame got before the boundary of the sending one */
+  EXPECT_GE(check->in_use_max, 2);
+  /* only the prepared frame is left without the done callback */
+  EXPECT_LE(check->in_use_cnt, 1);
+  tests_context_unit(test_ctx);
+  delete test_ctx;
+}
+
 static void st20_rx_fps_test(enum st20_type type[], enum st_fps fps[], int width[],
                              int height[], enum st20_fmt fmt, enum st_test_level level,
                              int sessions = 1, bool ext_buf = false) {
@@ -1048,6 +1149,28 @@ TEST(St20_tx, rtp_1080p_fps59_94_s1) {
   int height[1] = {1080};
   st20_tx_fps_test(type, fps, width, height, ST20_FMT_YUV_422_10BIT, ST_TEST_LEVEL_ALL);
 }
+/* tx pacing check without a nic, run with --p_port net_null0 --tx_ebu */
+TEST(St20_tx, tx_ebu_vdev_1080p_fps59_94_s1) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  const char* port = ctx->para.port[MTL_PORT_P];
+
+  if (strncmp(port, "net_null", strlen("net_null")) &&
+      strncmp(port, "net_ring", strlen("net_ring"))) {
+    info("%s, skip as port %s is not a net_null/net_ring vdev\n", __func__, port);
+    return;
+  }
+  if (!(ctx->para.flags & MTL_FLAG_TX_VIDEO_EBU)) {
+    info("%s, skip as tx ebu is not enabled\n", __func__);
+    return;
+  }
+
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  st20_tx_fps_test(type, fps, width, height, ST20_FMT_YUV_422_10BIT,
+                   ST_TEST_LEVEL_MANDATORY);
+}
 TEST(St20_tx, frame_1080p_fps29_97_s1) {
   enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
   enum st_fps fps[1] = {ST_FPS_P29_97};
@@ -1232,6 +1355,9 @@ TEST(St20_tx, ext_frame_mix_s3) {
   st20_tx_fps_test(type, fps, width, height, ST20_FMT_YUV_422_10BIT,
                    ST_TEST_LEVEL_MANDATORY, 3, true);
 }
+TEST(St20_tx, next_frame_prepare) {
+  st20_tx_next_frame_prepare_test(ST_TEST_LEVEL_MANDATORY);
+}
 TEST(St20_rx, frame_s3) {
   enum st20_type type[3] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_FRAME_LEVEL,
                             ST20_TYPE_FRAME_LEVEL};
@@ -2884,6 +3010,217 @@ TEST(St20_rx, frame_meta_1080p_fps59_94_s1) {
   st20_rx_meta_test(fps, width, height, ST20_FMT_YUV_422_10BIT);
 }
 
+struct st20_rx_preview_test_priv {
+  uint32_t width;  /* the expected preview width */
+  uint32_t height; /* the expected preview height */
+  uint8_t* expect; /* the expected preview of the tx frame */
+  int frames;
+  int previews;
+  int dimension_fail;
+  int pixel_fail;
+};
+
+/* decimate the tx frame to the expected preview, the 8 msb of Cb/Cr Y0 per pixel */
+static void st20_rx_preview_expect(struct st20_rx_preview_test_priv* preview,
+                                   uint8_t* fb, enum st20_fmt fmt, uint32_t width,
+                                   uint32_t scale) {
+  struct st20_pgroup pg;
+  size_t bytes_in_line = st20_frame_size(fmt, width, 1);
+  uint16_t cb, y0, cr;
+
+  st20_get_pgroup(fmt, &pg);
+  for (uint32_t row = 0; row < preview->height; row++) {
+    uint8_t* dst = preview->expect + row * preview->width * 2;
+    for (uint32_t x = 0; x < preview->width; x++) {
+      uint8_t* src = fb + row * scale * bytes_in_line + x * scale / pg.coverage * pg.size;
+      if (fmt == ST20_FMT_YUV_422_10BIT) {
+        cb = (src[0] << 2) | (src[1] >> 6);
+        y0 = ((src[1] & 0x3f) << 4) | (src[2] >> 4);
+        cr = ((src[2] & 0x0f) << 6) | (src[3] >> 2);
+        cb >>= 2;
+        y0 >>= 2;
+        cr >>= 2;
+      } else {
+        cb = src[0];
+        y0 = src[1];
+        cr = src[2];
+      }
+      dst[x * 2] = (x & 1) ? cr : cb;
+      dst[x * 2 + 1] = y0;
+    }
+  }
+}
+
+static int st20_rx_preview_frame_ready(void* priv, void* frame,
+                                       struct st20_rx_frame_meta* meta) {
+  auto ctx = (tests_context*)priv;
+  auto preview = (struct st20_rx_preview_test_priv*)ctx->priv;
+
+  if (!ctx->handle) return -EIO;
+
+  preview->frames++;
+  if (st_is_frame_complete(meta->status)) {
+    ctx->fb_rec++;
+    if (!ctx->start_time) ctx->start_time = st_test_get_monotonic_time();
+  }
+  st20_rx_put_framebuff((st20_rx_handle)ctx->handle, frame);
+  return 0;
+}
+
+static int st20_rx_preview_ready(void* priv, struct st20_rx_preview_meta* meta) {
+  auto ctx = (tests_context*)priv;
+  auto preview = (struct st20_rx_preview_test_priv*)ctx->priv;
+
+  if (!ctx->handle) return -EIO;
+
+  preview->previews++;
+  if ((meta->width != preview->width) || (meta->height != preview->height) ||
+      (meta->linesize != preview->width * 2) ||
+      (meta->size != meta->linesize * preview->height) ||
+      (meta->fmt != ST20_FMT_YUV_422_8BIT)) {
+    preview->dimension_fail++;
+    return 0;
+  }
+  if (!st_is_frame_complete(meta->status)) return 0;
+  /* all the tx frames are same */
+  if (memcmp(meta->addr, preview->expect, meta->size)) preview->pixel_fail++;
+  return 0;
+}
+
+static void st20_rx_preview_test(enum st_fps fps, int width, int height,
+                                 enum st20_fmt fmt, uint8_t scale, uint16_t interval) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  int ret;
+  struct st20_tx_ops ops_tx;
+  struct st20_rx_ops ops_rx;
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled for tx test, one for tx and one for rx\n",
+         __func__);
+    return;
+  }
+
+  tests_context* test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  test_ctx_tx->idx = 0;
+  test_ctx_tx->ctx = ctx;
+  test_ctx_tx->fb_cnt = 3;
+  test_ctx_tx->fb_idx = 0;
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st20_preview_test";
+  ops_tx.priv = test_ctx_tx;
+  ops_tx.num_port = 1;
+  memcpy(ops_tx.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops_tx.udp_port[MTL_SESSION_PORT_P] = 10000;
+  ops_tx.pacing = ST21_PACING_NARROW;
+  ops_tx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_tx.width = width;
+  ops_tx.height = height;
+  ops_tx.fps = fps;
+  ops_tx.fmt = fmt;
+  ops_tx.payload_type = ST20_TEST_PAYLOAD_TYPE;
+  ops_tx.framebuff_cnt = test_ctx_tx->fb_cnt;
+  ops_tx.get_next_frame = tx_next_video_frame;
+  st20_tx_handle tx_handle = st20_tx_create(m_handle, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+
+  /* same content for all the tx frames */
+  size_t frame_size = st20_frame_size(fmt, width, height);
+  for (int frame = 0; frame < test_ctx_tx->fb_cnt; frame++) {
+    uint8_t* fb = (uint8_t*)st20_tx_get_framebuffer(tx_handle, frame);
+    ASSERT_TRUE(fb != NULL);
+    srand(width + height);
+    st_test_rand_data(fb, frame_size, 0);
+  }
+  test_ctx_tx->handle = tx_handle;
+
+  tests_context* test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+  test_ctx_rx->idx = 0;
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->fb_cnt = 3;
+  test_ctx_rx->fb_idx = 0;
+
+  struct st20_rx_preview_test_priv* preview = (struct st20_rx_preview_test_priv*)
+      st_test_zmalloc(sizeof(struct st20_rx_preview_test_priv));
+  ASSERT_TRUE(preview != NULL);
+  preview->width = (width / scale) & ~1U;
+  preview->height = height / scale;
+  preview->expect = (uint8_t*)st_test_zmalloc(preview->width * 2 * preview->height);
+  ASSERT_TRUE(preview->expect != NULL);
+  st20_rx_preview_expect(preview, (uint8_t*)st20_tx_get_framebuffer(tx_handle, 0), fmt,
+                         width, scale);
+  test_ctx_rx->priv = preview;
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "st20_preview_test";
+  ops_rx.priv = test_ctx_rx;
+  ops_rx.num_port = 1;
+  memcpy(ops_rx.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_rx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  ops_rx.udp_port[MTL_SESSION_PORT_P] = 10000;
+  ops_rx.pacing = ST21_PACING_NARROW;
+  ops_rx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_rx.width = width;
+  ops_rx.height = height;
+  ops_rx.fps = fps;
+  ops_rx.fmt = fmt;
+  ops_rx.payload_type = ST20_TEST_PAYLOAD_TYPE;
+  ops_rx.framebuff_cnt = test_ctx_rx->fb_cnt;
+  ops_rx.notify_frame_ready = st20_rx_preview_frame_ready;
+  ops_rx.preview_scale = scale;
+  ops_rx.preview_interval = interval;
+  ops_rx.notify_preview_ready = st20_rx_preview_ready;
+  st20_rx_handle rx_handle = st20_rx_create(m_handle, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  test_ctx_rx->handle = rx_handle;
+
+  ret = mtl_start(m_handle);
+  EXPECT_GE(ret, 0);
+  sleep(ST20_TRAIN_TIME_S); /* time for train_pacing */
+  sleep(5);
+  ret = mtl_stop(m_handle);
+  EXPECT_GE(ret, 0);
+
+  info("%s, fb_rec %d frames %d previews %d\n", __func__, test_ctx_rx->fb_rec,
+       preview->frames, preview->previews);
+  EXPECT_GT(test_ctx_rx->fb_rec, 0);
+  EXPECT_GT(preview->previews, 0);
+  EXPECT_EQ(preview->dimension_fail, 0);
+  EXPECT_EQ(preview->pixel_fail, 0);
+  /* one preview every interval frames */
+  double expect_previews = (double)preview->frames / (interval ? interval : 1);
+  EXPECT_NEAR(preview->previews, expect_previews, std::max(expect_previews * 0.1, 2.0));
+
+  ret = st20_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st20_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+  st_test_free(preview->expect);
+  tests_context_unit(test_ctx_tx);
+  tests_context_unit(test_ctx_rx);
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
+
+TEST(St20_rx, preview_1080p_10bit) {
+  st20_rx_preview_test(ST_FPS_P59_94, 1920, 1080, ST20_FMT_YUV_422_10BIT, 4, 1);
+}
+TEST(St20_rx, preview_1080p_10bit_interval) {
+  st20_rx_preview_test(ST_FPS_P50, 1920, 1080, ST20_FMT_YUV_422_10BIT, 16, 5);
+}
+TEST(St20_rx, preview_720p_8bit) {
+  st20_rx_preview_test(ST_FPS_P59_94, 1280, 720, ST20_FMT_YUV_422_8BIT, 2, 1);
+}
+TEST(St20_rx, preview_720p_8bit_interval) {
+  st20_rx_preview_test(ST_FPS_P59_94, 1280, 720, ST20_FMT_YUV_422_8BIT, 8, 3);
+}
+
 static void st20_rx_after_start_test(enum st20_type type[], enum st_fps fps[],
                                      int width[], int height[], enum st20_fmt fmt,
                                      int sessions, int repeat, enum st_test_level level) {
@@ -386,6 +386,14 @@ static void test_st20p_tx_frame_thread(void* args) {
       s->ext_fb_in_use[s->ext_idx] = true;
       s->ext_idx++;
       if (s->ext_idx >= s->fb_cnt) s->ext_idx = 0;
+    } else if (s->slice) {
+      /* publish the lines slice by slice while the transport is sending */
+      for (uint32_t lines = s->lines_per_slice; lines < s->height;
+           lines += s->lines_per_slice) {
+        st20p_tx_put_frame_lines((st20p_tx_handle)handle, frame, lines);
+        st_usleep(500);
+      }
+      st20p_tx_put_frame_lines((st20p_tx_handle)handle, frame, s->height);
     } else {
       /* directly put */
       st20p_tx_put_frame((st20p_tx_handle)handle, frame);
@@ -618,10 +626,15 @@ struct st20p_rx_digest_test_para {
   bool user_timestamp;
   bool vsync;
   bool pkt_convert;
+  bool tx_pkt_convert;
   size_t line_padding_size;
   bool send_done_check;
   bool interlace;
   bool user_meta;
+  uint8_t convert_worker_cnt;
+  uint8_t stages_cnt;
+  uint8_t stage_worker_cnt;
+  uint16_t tx_slice_lines; /* lines per slice for ST20P_TX_FLAG_SLICE_LEVEL */
 };
 
 static void test_st20p_init_rx_digest_para(struct st20p_rx_digest_test_para* para) {
@@ -639,10 +652,24 @@ static void test_st20p_init_rx_digest_para(struct st20p_rx_digest_test_para* par
   para->user_timestamp = false;
   para->vsync = true;
   para->pkt_convert = false;
+  para->tx_pkt_convert = false;
   para->line_padding_size = 0;
   para->send_done_check = false;
   para->interlace = false;
   para->user_meta = false;
+  para->convert_worker_cnt = 0;
+  para->stages_cnt = 0;
+  para->stage_worker_cnt = 0;
+  para->tx_slice_lines = 0;
+}
+
+static int test_st20p_stage_process(void* priv, struct st_frame* src,
+                                    struct st_frame* dst) {
+  /* copy with a random delay, the workers finish the frames out of order */
+  if (src->data_size != dst->data_size) return -EIO;
+  mtl_memcpy(dst->addr[0], src->addr[0], dst->data_size);
+  st_usleep(rand() % 10000);
+  return 0;
 }
 
 static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
@@ -746,8 +773,15 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     if (para->tx_ext) {
       ops_tx.flags |= ST20P_TX_FLAG_EXT_FRAME;
     }
+    if (para->tx_slice_lines) {
+      ops_tx.flags |= ST20P_TX_FLAG_SLICE_LEVEL;
+      test_ctx_tx[i]->slice = true;
+      test_ctx_tx[i]->lines_per_slice = para->tx_slice_lines;
+    }
     if (para->user_timestamp) ops_tx.flags |= ST20P_TX_FLAG_USER_TIMESTAMP;
     if (para->vsync) ops_tx.flags |= ST20P_TX_FLAG_ENABLE_VSYNC;
+    if (para->tx_pkt_convert) ops_tx.flags |= ST20P_TX_FLAG_PKT_CONVERT;
+    ops_tx.convert_worker_cnt = para->convert_worker_cnt;
 
     uint8_t planes = st_frame_fmt_planes(tx_fmt[i]);
     test_ctx_tx[i]->frame_size =
@@ -827,12 +861,22 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
           }
         }
       }
-      if (tx_fmt[i] == ST_FRAME_FMT_YUV422PLANAR10LE) {
+      if (tx_fmt[i] == ST_FRAME_FMT_YUV422PLANAR10LE ||
+          tx_fmt[i] == ST_FRAME_FMT_YUV444PLANAR10LE ||
+          tx_fmt[i] == ST_FRAME_FMT_GBRPLANAR10LE) {
         /* only LSB 10 valid */
         uint16_t* p10_u16 = (uint16_t*)fb;
         for (size_t j = 0; j < (frame_size / 2); j++) {
           p10_u16[j] &= 0x3ff; /* only 10 bit */
         }
+      } else if (tx_fmt[i] == ST_FRAME_FMT_YUV422PLANAR12LE ||
+                 tx_fmt[i] == ST_FRAME_FMT_YUV444PLANAR12LE ||
+                 tx_fmt[i] == ST_FRAME_FMT_GBRPLANAR12LE) {
+        /* only LSB 12 valid */
+        uint16_t* p12_u16 = (uint16_t*)fb;
+        for (size_t j = 0; j < (frame_size / 2); j++) {
+          p12_u16[j] &= 0xfff; /* only 12 bit */
+        }
       } else if (tx_fmt[i] == ST_FRAME_FMT_Y210) {
         /* only MSB 10 valid */
         uint16_t* y210_u16 = (uint16_t*)fb;
@@ -960,6 +1004,18 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     if (para->vsync) ops_rx.flags |= ST20P_RX_FLAG_ENABLE_VSYNC;
     if (para->rx_get_ext) ops_rx.flags |= ST20P_RX_FLAG_EXT_FRAME;
     if (para->pkt_convert) ops_rx.flags |= ST20P_RX_FLAG_PKT_CONVERT;
+    ops_rx.convert_worker_cnt = para->convert_worker_cnt;
+    struct st20p_stage_ops stages[ST20P_STAGES_MAX];
+    memset(stages, 0, sizeof(stages));
+    for (uint8_t j = 0; j < para->stages_cnt; j++) {
+      stages[j].output_fmt = rx_fmt[i];
+      stages[j].worker_cnt = para->stage_worker_cnt;
+      stages[j].process = test_st20p_stage_process;
+    }
+    if (para->stages_cnt) {
+      ops_rx.stages = stages;
+      ops_rx.stages_cnt = para->stages_cnt;
+    }
 
     rx_handle[i] = st20p_rx_create(st, &ops_rx);
     ASSERT_TRUE(rx_handle[i] != NULL);
@@ -1235,6 +1291,151 @@ TEST(St20p, digest_1080p_packet_convert_s2) {
   st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
 }
 
+TEST(St20p, digest_1080p_packet_convert_v210_12bit_s2) {
+  enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_V210, ST_FRAME_FMT_YUV422PLANAR12LE};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_12BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_V210, ST_FRAME_FMT_YUV422PLANAR12LE};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.pkt_convert = true;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, digest_720p_packet_convert_444_s2) {
+  enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
+  int width[2] = {1280, 1280};
+  int height[2] = {720, 720};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV444PLANAR10LE,
+                                 ST_FRAME_FMT_YUV444PLANAR12LE};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_444_10BIT, ST20_FMT_YUV_444_12BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV444PLANAR10LE,
+                                 ST_FRAME_FMT_YUV444PLANAR12LE};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.pkt_convert = true;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, digest_720p_packet_convert_gbr_s2) {
+  enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
+  int width[2] = {1280, 1280};
+  int height[2] = {720, 720};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_GBRPLANAR10LE, ST_FRAME_FMT_GBRPLANAR12LE};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_RGB_10BIT, ST20_FMT_RGB_12BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_GBRPLANAR10LE, ST_FRAME_FMT_GBRPLANAR12LE};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.pkt_convert = true;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, rx_packet_convert_v210_width) {
+  auto ctx = st_test_ctx();
+  auto m_handle = ctx->handle;
+  struct st20p_rx_ops ops;
+  auto test_ctx = new tests_context();
+  ASSERT_TRUE(test_ctx != NULL);
+
+  test_ctx->idx = 0;
+  test_ctx->ctx = ctx;
+  test_ctx->fb_cnt = 2;
+  test_ctx->fb_idx = 0;
+  st20p_rx_ops_init(test_ctx, &ops);
+  ops.flags |= ST20P_RX_FLAG_PKT_CONVERT;
+  ops.output_fmt = ST_FRAME_FMT_V210;
+  /* the v210 line is not whole 6 pixels blocks */
+  ops.width = 1280;
+  ops.height = 720;
+  st20p_rx_handle handle = st20p_rx_create(m_handle, &ops);
+  EXPECT_TRUE(handle == NULL);
+  if (handle) st20p_rx_free(handle);
+  /* whole blocks */
+  ops.width = 1920;
+  ops.height = 1080;
+  handle = st20p_rx_create(m_handle, &ops);
+  EXPECT_TRUE(handle != NULL);
+  if (handle) st20p_rx_free(handle);
+
+  delete test_ctx;
+}
+
+TEST(St20p, digest_1080p_tx_packet_convert_s2) {
+  enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_V210};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_V210};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.tx_pkt_convert = true;
+  para.send_done_check = true;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, digest_720p_tx_rx_packet_convert_s2) {
+  enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
+  int width[2] = {1280, 1280};
+  int height[2] = {720, 720};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV444PLANAR12LE,
+                                 ST_FRAME_FMT_GBRPLANAR10LE};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_444_12BIT, ST20_FMT_RGB_10BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV444PLANAR12LE,
+                                 ST_FRAME_FMT_GBRPLANAR10LE};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.tx_pkt_convert = true;
+  para.pkt_convert = true;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, digest_1080p_tx_slice_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1280};
+  int height[2] = {1080, 720};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.tx_slice_lines = 64;
+  para.send_done_check = true;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
 TEST(St20p, tx_ext_digest_1080p_no_convert_s2) {
   enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
   int width[2] = {1920, 1920};
@@ -1490,4 +1691,67 @@ TEST(St20p, digest_user_meta_s2) {
   para.check_fps = false;
 
   st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
-}
\ No newline at end of file
+}
+
+TEST(St20p, digest_convert_workers_order_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1280};
+  int height[2] = {1080, 720};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  /* the user meta frame idx checks the frames come out in the put order */
+  para.user_meta = true;
+  para.user_timestamp = true;
+  para.convert_worker_cnt = 3;
+  para.check_fps = false;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, digest_stage_workers_order_s1) {
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  enum st_frame_fmt tx_fmt[1] = {ST_FRAME_FMT_YUV422PLANAR10LE};
+  enum st20_fmt t_fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[1] = {ST_FRAME_FMT_YUV422PLANAR10LE};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  /* the user meta frame idx checks the stage output keeps the input order */
+  para.user_meta = true;
+  para.user_timestamp = true;
+  para.stages_cnt = 1;
+  para.stage_worker_cnt = 4;
+  para.check_fps = false;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, digest_stages_order_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1280};
+  int height[2] = {1080, 720};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.user_meta = true;
+  para.user_timestamp = true;
+  para.stages_cnt = 3;
+  para.stage_worker_cnt = 2;
+  para.check_fps = false;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
@@ -2,6 +2,7 @@
  * Copyright(c) 2022 Intel Corporation
  */
 
+#include <atomic>
 #include <thread>
 
 #include "log.h"
@@ -53,6 +54,46 @@ static int test_encode_frame(struct test_st22_encoder_session* s,
   return 0;
 }
 
+static int test_encode_slice_frame(struct test_st22_encoder_session* s,
+                                   struct st22_encode_frame_meta* frame) {
+  struct st22_encoder_create_req* req = &s->req;
+  st22p_encode_session session_p = s->session_p;
+  size_t codestream_size = req->codestream_size;
+  uint16_t lines_encoded = 0;
+  int ret;
+
+  /* check frame sanity */
+  if (frame->src->width != req->width) return -EIO;
+  if (frame->dst->width != req->width) return -EIO;
+  if (frame->src->height != req->height) return -EIO;
+  if (frame->dst->height != req->height) return -EIO;
+  if (frame->src->fmt != req->input_fmt) return -EIO;
+  if (frame->dst->fmt != req->output_fmt) return -EIO;
+
+  /* encode as the lines get ready, the src sha is at the start of the frame */
+  while (lines_encoded < req->height) {
+    if (s->stop) return -EIO;
+    uint16_t lines = st22_encoder_get_frame_lines(session_p, frame);
+    if (lines == lines_encoded) {
+      st_usleep(100);
+      continue;
+    }
+    if (!lines_encoded)
+      memcpy(frame->dst->addr[0], frame->src->addr[0], SHA256_DIGEST_LENGTH);
+    lines_encoded = lines;
+    ret = st22_encoder_put_frame_bytes(session_p, frame,
+                                       codestream_size * lines_encoded / req->height);
+    if (ret < 0) return ret;
+    s->slice_cnt++;
+  }
+  /* the codestream size is fixed in the slice mode */
+  frame->dst->data_size = codestream_size;
+
+  s->frame_cnt++;
+  dbg("%s(%d), succ, slice_cnt %d\n", __func__, s->idx, s->slice_cnt);
+  return 0;
+}
+
 static void* test_encode_thread(void* arg) {
   struct test_st22_encoder_session* s = (struct test_st22_encoder_session*)arg;
   st22p_encode_session session_p = s->session_p;
@@ -68,7 +109,10 @@ static void* test_encode_thread(void* arg) {
       st_pthread_mutex_unlock(&s->wake_mutex);
       continue;
     }
-    result = test_encode_frame(s, frame);
+    if (s->req.slice_enabled)
+      result = test_encode_slice_frame(s, frame);
+    else
+      result = test_encode_frame(s, frame);
     st22_encoder_put_frame(session_p, frame, result);
   }
   dbg("%s(%d), stop\n", __func__, s->idx);
@@ -93,6 +137,8 @@ static st22_encode_priv test_encoder_create_session(void* priv,
     st_pthread_cond_init(&session->wake_cond, NULL);
 
     req->max_codestream_size = req->codestream_size;
+    /* the test encoder supports the slice level */
+    if (req->slice_level) req->slice_enabled = true;
 
     session->req = *req;
     session->session_p = session_p;
@@ -141,6 +187,7 @@ static int test_encoder_free_session(void* priv, st22_encode_priv session) {
   st_pthread_cond_destroy(&encoder_session->wake_cond);
 
   dbg("%s(%d), total %d encode frames\n", __func__, idx, encoder_session->frame_cnt);
+  ctx->plugin_encode_slice_cnt += encoder_session->slice_cnt;
   free(encoder_session);
   ctx->encoder_sessions[idx] = NULL;
   return 0;
@@ -193,6 +240,46 @@ static int test_decode_frame(struct test_st22_decoder_session* s,
   return 0;
 }
 
+static int test_decode_slice_frame(struct test_st22_decoder_session* s,
+                                   struct st22_decode_frame_meta* frame) {
+  struct st22_decoder_create_req* req = &s->req;
+  st22p_decode_session session_p = s->session_p;
+  bool complete = false;
+  bool sha_copied = false;
+  size_t bytes = 0;
+
+  /* check frame sanity */
+  if (frame->src->width != req->width) return -EIO;
+  if (frame->dst->width != req->width) return -EIO;
+  if (frame->src->height != req->height) return -EIO;
+  if (frame->dst->height != req->height) return -EIO;
+  if (frame->src->fmt != req->input_fmt) return -EIO;
+  if (frame->dst->fmt != req->output_fmt) return -EIO;
+
+  /* decode as the codestream bytes arrive, the sha is in the first bytes */
+  while (!complete) {
+    if (s->stop) return -EIO;
+    size_t bytes_ready = st22_decoder_get_frame_bytes(session_p, frame, &complete);
+    if ((bytes_ready == bytes) && !complete) {
+      st_usleep(100);
+      continue;
+    }
+    bytes = bytes_ready;
+    if (!sha_copied && (bytes >= SHA256_DIGEST_LENGTH)) {
+      memcpy((uint8_t*)frame->dst->addr[0] + frame->dst->data_size - SHA256_DIGEST_LENGTH,
+             frame->src->addr[0], SHA256_DIGEST_LENGTH);
+      sha_copied = true;
+    }
+    s->slice_cnt++;
+  }
+  if (!sha_copied) return -EIO;
+  if (frame->src->data_size > frame->src->buffer_size) return -EIO;
+
+  s->frame_cnt++;
+  dbg("%s(%d), succ, slice_cnt %d\n", __func__, s->idx, s->slice_cnt);
+  return 0;
+}
+
 static void* test_decode_thread(void* arg) {
   struct test_st22_decoder_session* s = (struct test_st22_decoder_session*)arg;
   st22p_decode_session session_p = s->session_p;
@@ -208,7 +295,10 @@ static void* test_decode_thread(void* arg) {
       st_pthread_mutex_unlock(&s->wake_mutex);
       continue;
     }
-    result = test_decode_frame(s, frame);
+    if (s->req.slice_enabled)
+      result = test_decode_slice_frame(s, frame);
+    else
+      result = test_decode_frame(s, frame);
     st22_decoder_put_frame(session_p, frame, result);
   }
   dbg("%s(%d), stop\n", __func__, s->idx);
@@ -232,6 +322,9 @@ static st22_decode_priv test_decoder_create_session(void* priv,
     st_pthread_mutex_init(&session->wake_mutex, NULL);
     st_pthread_cond_init(&session->wake_cond, NULL);
 
+    /* the test decoder supports the slice level */
+    if (req->slice_level) req->slice_enabled = true;
+
     session->req = *req;
     session->session_p = session_p;
     double fps = st_frame_rate(req->fps);
@@ -277,6 +370,7 @@ static int test_decoder_free_session(void* priv, st22_decode_priv session) {
   st_pthread_cond_destroy(&decoder_session->wake_cond);
 
   dbg("%s(%d), total %d decode frames\n", __func__, idx, decoder_session->frame_cnt);
+  ctx->plugin_decode_slice_cnt += decoder_session->slice_cnt;
   free(decoder_session);
   ctx->decoder_sessions[idx] = NULL;
   return 0;
@@ -346,6 +440,175 @@ int st_test_st22_plugin_register(struct st_tests_context* ctx) {
   return 0;
 }
 
+/* the test devs run by the lib batch workers, for ST_PLUGIN_DEVICE_TEST_INTERNAL */
+struct test_st22_batch_dev {
+  int sleep_us; /* the time of each batch */
+  std::atomic<int> inflight;
+  std::atomic<int> frames;
+  std::atomic<int> batches;
+  std::atomic<int> max_batch;
+  std::atomic<int> sessions;
+  st22_encoder_dev_handle encoder;
+  st22_decoder_dev_handle decoder;
+};
+
+static void test_st22_batch_done(struct test_st22_batch_dev* dev, uint16_t nb_frames) {
+  int max = dev->max_batch;
+
+  st_usleep(dev->sleep_us);
+  while (nb_frames > max && !dev->max_batch.compare_exchange_weak(max, nb_frames)) {
+  }
+  dev->frames += nb_frames;
+  dev->batches++;
+  dev->inflight--;
+}
+
+static int test_batch_encode_frames(void* priv, st22_encode_priv* sessions,
+                                    struct st22_encode_frame_meta** frames, int* results,
+                                    uint16_t nb_frames) {
+  auto dev = (struct test_st22_batch_dev*)priv;
+
+  dev->inflight++;
+  for (uint16_t i = 0; i < nb_frames; i++) {
+    auto s = (struct test_st22_encoder_session*)sessions[i];
+    struct st22_encode_frame_meta* frame = frames[i];
+
+    if (frame->src->width != s->req.width || frame->src->fmt != s->req.input_fmt) {
+      results[i] = -EIO;
+      continue;
+    }
+    /* copy src sha to the start of encode frame */
+    memcpy(frame->dst->addr[0],
+           (uint8_t*)frame->src->addr[0] + frame->src->data_size - SHA256_DIGEST_LENGTH,
+           SHA256_DIGEST_LENGTH);
+    frame->dst->data_size = s->req.max_codestream_size;
+  }
+  test_st22_batch_done(dev, nb_frames);
+
+  return 0;
+}
+
+static st22_encode_priv test_batch_encoder_create_session(
+    void* priv, st22p_encode_session session_p, struct st22_encoder_create_req* req) {
+  auto dev = (struct test_st22_batch_dev*)priv;
+  struct test_st22_encoder_session* session =
+      (struct test_st22_encoder_session*)malloc(sizeof(*session));
+  if (!session) return NULL;
+
+  memset(session, 0, sizeof(*session));
+  req->max_codestream_size = req->codestream_size;
+  session->idx = dev->sessions++;
+  session->req = *req;
+  session->session_p = session_p;
+  return session;
+}
+
+static int test_batch_encoder_free_session(void* priv, st22_encode_priv session) {
+  auto dev = (struct test_st22_batch_dev*)priv;
+
+  dev->sessions--;
+  free(session);
+  return 0;
+}
+
+static int test_batch_decode_frames(void* priv, st22_decode_priv* sessions,
+                                    struct st22_decode_frame_meta** frames, int* results,
+                                    uint16_t nb_frames) {
+  auto dev = (struct test_st22_batch_dev*)priv;
+
+  dev->inflight++;
+  for (uint16_t i = 0; i < nb_frames; i++) {
+    auto s = (struct test_st22_decoder_session*)sessions[i];
+    struct st22_decode_frame_meta* frame = frames[i];
+
+    if (frame->dst->width != s->req.width || frame->dst->fmt != s->req.output_fmt ||
+        frame->src->data_size > frame->src->buffer_size) {
+      results[i] = -EIO;
+      continue;
+    }
+    /* copy sha to the end of decode frame */
+    memcpy((uint8_t*)frame->dst->addr[0] + frame->dst->data_size - SHA256_DIGEST_LENGTH,
+           frame->src->addr[0], SHA256_DIGEST_LENGTH);
+  }
+  test_st22_batch_done(dev, nb_frames);
+
+  return 0;
+}
+
+static st22_decode_priv test_batch_decoder_create_session(
+    void* priv, st22p_decode_session session_p, struct st22_decoder_create_req* req) {
+  auto dev = (struct test_st22_batch_dev*)priv;
+  struct test_st22_decoder_session* session =
+      (struct test_st22_decoder_session*)malloc(sizeof(*session));
+  if (!session) return NULL;
+
+  memset(session, 0, sizeof(*session));
+  session->idx = dev->sessions++;
+  session->req = *req;
+  session->session_p = session_p;
+  return session;
+}
+
+static int test_batch_decoder_free_session(void* priv, st22_decode_priv session) {
+  auto dev = (struct test_st22_batch_dev*)priv;
+
+  dev->sessions--;
+  free(session);
+  return 0;
+}
+
+static int test_st22_batch_register(struct test_st22_batch_dev* dev, uint16_t worker_cnt,
+                                    uint16_t batch_size) {
+  auto st = st_test_ctx()->handle;
+
+  struct st22_encoder_dev e_dev;
+  memset(&e_dev, 0, sizeof(e_dev));
+  e_dev.name = "st22_test_batch_encoder";
+  e_dev.priv = dev;
+  e_dev.target_device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  e_dev.input_fmt_caps = ST_FMT_CAP_YUV422PLANAR10LE;
+  e_dev.output_fmt_caps = ST_FMT_CAP_JPEGXS_CODESTREAM;
+  e_dev.create_session = test_batch_encoder_create_session;
+  e_dev.free_session = test_batch_encoder_free_session;
+  e_dev.worker_cnt = worker_cnt;
+  e_dev.batch_size = batch_size;
+  e_dev.encode_frames = test_batch_encode_frames;
+  dev->encoder = st22_encoder_register(st, &e_dev);
+  if (!dev->encoder) return -EIO;
+
+  struct st22_decoder_dev d_dev;
+  memset(&d_dev, 0, sizeof(d_dev));
+  d_dev.name = "st22_test_batch_decoder";
+  d_dev.priv = dev;
+  d_dev.target_device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  d_dev.input_fmt_caps = ST_FMT_CAP_JPEGXS_CODESTREAM;
+  d_dev.output_fmt_caps = ST_FMT_CAP_YUV422PLANAR10LE;
+  d_dev.create_session = test_batch_decoder_create_session;
+  d_dev.free_session = test_batch_decoder_free_session;
+  d_dev.worker_cnt = worker_cnt;
+  d_dev.batch_size = batch_size;
+  d_dev.decode_frames = test_batch_decode_frames;
+  dev->decoder = st22_decoder_register(st, &d_dev);
+  if (!dev->decoder) {
+    st22_encoder_unregister(dev->encoder);
+    dev->encoder = NULL;
+    return -EIO;
+  }
+
+  return 0;
+}
+
+static void test_st22_batch_unregister(struct test_st22_batch_dev* dev) {
+  if (dev->decoder) {
+    st22_decoder_unregister(dev->decoder);
+    dev->decoder = NULL;
+  }
+  if (dev->encoder) {
+    st22_encoder_unregister(dev->encoder);
+    dev->encoder = NULL;
+  }
+}
+
 static void plugin_register_test(const char* so_name, bool expect_succ) {
   auto ctx = st_test_ctx();
   auto st = ctx->handle;
@@ -570,8 +833,20 @@ static void test_st22p_tx_frame_thread(void* args) {
       frame->timestamp = s->fb_send;
       dbg("%s(%d), timestamp %d\n", __func__, s->idx, s->fb_send);
     }
-    /* directly put */
-    st22p_tx_put_frame((st22p_tx_handle)handle, frame);
+    if (s->slice) {
+      /* publish the frame in slices as the lines get ready */
+      uint32_t lines = 0;
+      while (lines < s->height) {
+        lines += s->lines_per_slice;
+        if (lines > s->height) lines = s->height;
+        st22p_tx_put_frame_lines((st22p_tx_handle)handle, frame, lines);
+        s->slice_cnt++;
+        if (lines < s->height) st_usleep(1000);
+      }
+    } else {
+      /* directly put */
+      st22p_tx_put_frame((st22p_tx_handle)handle, frame);
+    }
     s->fb_send++;
     if (!s->start_time) {
       s->start_time = st_test_get_monotonic_time();
@@ -623,16 +898,18 @@ static void test_st22p_rx_frame_thread(void* args) {
       s->pre_timestamp = (uint32_t)frame->timestamp;
     }
 
-    unsigned char* sha =
-        (unsigned char*)frame->addr[0] + frame->data_size - SHA256_DIGEST_LENGTH;
-    int i = 0;
-    for (i = 0; i < ST22_TEST_SHA_HIST_NUM; i++) {
-      unsigned char* target_sha = s->shas[i];
-      if (!memcmp(sha, target_sha, SHA256_DIGEST_LENGTH)) break;
-    }
-    if (i >= ST22_TEST_SHA_HIST_NUM) {
-      test_sha_dump("st22p_rx_error_sha", sha);
-      s->sha_fail_cnt++;
+    if (s->check_sha) {
+      unsigned char* sha =
+          (unsigned char*)frame->addr[0] + frame->data_size - SHA256_DIGEST_LENGTH;
+      int i = 0;
+      for (i = 0; i < ST22_TEST_SHA_HIST_NUM; i++) {
+        unsigned char* target_sha = s->shas[i];
+        if (!memcmp(sha, target_sha, SHA256_DIGEST_LENGTH)) break;
+      }
+      if (i >= ST22_TEST_SHA_HIST_NUM) {
+        test_sha_dump("st22p_rx_error_sha", sha);
+        s->sha_fail_cnt++;
+      }
     }
     /* directly put */
     st22p_rx_put_frame((st22p_rx_handle)handle, frame);
@@ -652,6 +929,10 @@ struct st22p_rx_digest_test_para {
   enum st_test_level level;
   bool user_timestamp;
   bool vsync;
+  bool tx_slice;
+  bool rx_slice;
+  enum st_plugin_device device;
+  bool check_sha; /* false for the lossy codec */
 };
 
 static void test_st22p_init_rx_digest_para(struct st22p_rx_digest_test_para* para) {
@@ -664,6 +945,10 @@ static void test_st22p_init_rx_digest_para(struct st22p_rx_digest_test_para* par
   para->level = ST_TEST_LEVEL_MANDATORY;
   para->user_timestamp = false;
   para->vsync = true;
+  para->tx_slice = false;
+  para->rx_slice = false;
+  para->device = ST_PLUGIN_DEVICE_TEST;
+  para->check_sha = true;
 }
 
 static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
@@ -681,6 +966,8 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
   st_test_jxs_timeout_interval(ctx, para->timeout_interval);
   st_test_jxs_timeout_ms(ctx, para->timeout_ms);
   st_test_jxs_rand_ratio(ctx, para->rand_ratio);
+  ctx->plugin_encode_slice_cnt = 0;
+  ctx->plugin_decode_slice_cnt = 0;
 
   if (ctx->para.num_ports != 2) {
     info("%s, dual port should be enabled, one for tx and one for rx\n", __func__);
@@ -734,6 +1021,8 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     test_ctx_tx[i]->height = height[i];
     test_ctx_tx[i]->fmt = fmt[i];
     test_ctx_tx[i]->user_timestamp = para->user_timestamp;
+    test_ctx_tx[i]->slice = para->tx_slice;
+    test_ctx_tx[i]->lines_per_slice = height[i] / 8;
 
     memset(&ops_tx, 0, sizeof(ops_tx));
     ops_tx.name = "st22p_test";
@@ -751,13 +1040,14 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     ops_tx.input_fmt = fmt[i];
     ops_tx.pack_type = ST22_PACK_CODESTREAM;
     ops_tx.codec = codec[i];
-    ops_tx.device = ST_PLUGIN_DEVICE_TEST;
+    ops_tx.device = para->device;
     ops_tx.quality = ST22_QUALITY_MODE_QUALITY;
     ops_tx.framebuff_cnt = test_ctx_tx[i]->fb_cnt;
     ops_tx.notify_frame_available = test_st22p_tx_frame_available;
     ops_tx.notify_event = test_ctx_notify_event;
     if (para->user_timestamp) ops_tx.flags |= ST22P_TX_FLAG_USER_TIMESTAMP;
     if (para->vsync) ops_tx.flags |= ST22P_TX_FLAG_ENABLE_VSYNC;
+    if (para->tx_slice) ops_tx.flags |= ST22P_TX_FLAG_SLICE_LEVEL;
 
     test_ctx_tx[i]->frame_size =
         st_frame_size(ops_tx.input_fmt, ops_tx.width, ops_tx.height, false);
@@ -779,6 +1069,8 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
       test_sha_dump("st22p_tx", result);
       /* copy sha to the end of frame */
       memcpy(fb + frame_size - SHA256_DIGEST_LENGTH, result, SHA256_DIGEST_LENGTH);
+      /* the slice encoder gets the sha from the first line */
+      if (para->tx_slice) memcpy(fb, result, SHA256_DIGEST_LENGTH);
     }
 
     test_ctx_tx[i]->handle = tx_handle[i];
@@ -804,6 +1096,7 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     test_ctx_rx[i]->height = height[i];
     test_ctx_rx[i]->fmt = fmt[i];
     test_ctx_rx[i]->user_timestamp = para->user_timestamp;
+    test_ctx_rx[i]->check_sha = para->check_sha;
     /* copy sha */
     memcpy(test_ctx_rx[i]->shas, test_ctx_tx[i]->shas,
            ST22_TEST_SHA_HIST_NUM * SHA256_DIGEST_LENGTH);
@@ -824,11 +1117,12 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     ops_rx.output_fmt = fmt[i];
     ops_rx.pack_type = ST22_PACK_CODESTREAM;
     ops_rx.codec = codec[i];
-    ops_rx.device = ST_PLUGIN_DEVICE_TEST;
+    ops_rx.device = para->device;
     ops_rx.framebuff_cnt = test_ctx_rx[i]->fb_cnt;
     ops_rx.notify_frame_available = test_st22p_rx_frame_available;
     ops_rx.notify_event = test_ctx_notify_event;
     if (para->vsync) ops_rx.flags |= ST22P_RX_FLAG_ENABLE_VSYNC;
+    if (para->rx_slice) ops_rx.flags |= ST22P_RX_FLAG_SLICE_LEVEL;
 
     test_ctx_rx[i]->frame_size =
         st_frame_size(ops_rx.output_fmt, ops_rx.width, ops_rx.height, false);
@@ -914,6 +1208,14 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     }
     delete test_ctx_rx[i];
   }
+
+  /* the test plugins are working on the slices */
+  if (para->tx_slice) {
+    EXPECT_GT(ctx->plugin_encode_slice_cnt, 0);
+  }
+  if (para->rx_slice) {
+    EXPECT_GT(ctx->plugin_decode_slice_cnt, 0);
+  }
 }
 
 TEST(St22p, digest_st22_1080p_s1) {
@@ -1008,3 +1310,277 @@ TEST(St22p, digest_st22_1080p_rand_size) {
 
   st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
 }
+
+TEST(St22p, digest_st22_1080p_slice) {
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  enum st_frame_fmt fmt[1] = {ST_FRAME_FMT_YUV422PLANAR10LE};
+  enum st22_codec codec[1] = {ST22_CODEC_JPEGXS};
+  int compress_ratio[1] = {10};
+
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  para.tx_slice = true;
+  para.rx_slice = true;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+}
+
+TEST(St22p, digest_st22_1080p_tx_slice) {
+  enum st_fps fps[1] = {ST_FPS_P50};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  enum st_frame_fmt fmt[1] = {ST_FRAME_FMT_YUV422PLANAR8};
+  enum st22_codec codec[1] = {ST22_CODEC_H264_CBR};
+  int compress_ratio[1] = {5};
+
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  para.tx_slice = true;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+}
+
+TEST(St22p, digest_st22_1080p_rx_slice_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  enum st_frame_fmt fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE,
+                              ST_FRAME_FMT_YUV422PLANAR10LE};
+  enum st22_codec codec[2] = {ST22_CODEC_JPEGXS, ST22_CODEC_JPEGXS};
+  int compress_ratio[2] = {10, 16};
+
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.rx_slice = true;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+}
+
+TEST(St22p, digest_st22_1080p_ffmpeg_plugin) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto st = ctx->handle;
+  const char* so_name = "/usr/local/lib/x86_64-linux-gnu/libst_plugin_st22_ffmpeg.so";
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  enum st_frame_fmt fmt[1] = {ST_FRAME_FMT_YUV422PLANAR8};
+  enum st22_codec codec[1] = {ST22_CODEC_H264_CBR};
+  int compress_ratio[1] = {10};
+
+  int ret = st_plugin_register(st, so_name);
+  if (ret < 0) {
+    info("%s, skip as the st22 ffmpeg plugin is not installed\n", __func__);
+    return;
+  }
+
+  /* the zero-copy encode and decode of libavcodec, the output is lossy */
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  para.device = ST_PLUGIN_DEVICE_CPU;
+  para.check_sha = false;
+  para.check_fps = false;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+
+  ret = st_plugin_unregister(st, so_name);
+  EXPECT_GE(ret, 0);
+}
+
+TEST(St22p, digest_st22_1080p_batch_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  enum st_frame_fmt fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE,
+                              ST_FRAME_FMT_YUV422PLANAR10LE};
+  enum st22_codec codec[2] = {ST22_CODEC_JPEGXS, ST22_CODEC_JPEGXS};
+  int compress_ratio[2] = {10, 16};
+  struct test_st22_batch_dev dev;
+
+  dev.sleep_us = 1000 * 1000 / 60 * 8 / 10;
+  dev.inflight = 0;
+  dev.frames = 0;
+  dev.batches = 0;
+  dev.max_batch = 0;
+  dev.sessions = 0;
+  /* the workers are shared by the encode and decode of both sessions */
+  ASSERT_GE(test_st22_batch_register(&dev, 2, 4), 0);
+
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+
+  info("%s, %d frames in %d batches, max batch %d\n", __func__, dev.frames.load(),
+       dev.batches.load(), dev.max_batch.load());
+  EXPECT_GT(dev.frames.load(), 0);
+  EXPECT_EQ(dev.sessions.load(), 0);
+  test_st22_batch_unregister(&dev);
+}
+
+TEST(St22p, batch_detach_inflight) {
+  auto ctx = st_test_ctx();
+  auto st = ctx->handle;
+  struct test_st22_batch_dev dev;
+  tests_context* test_ctx[2];
+  st22p_tx_handle handle[2];
+  struct st22p_tx_ops ops;
+  struct st_frame* frame;
+
+  /* one worker with a long batch, the detach always hits the inflight batch */
+  dev.sleep_us = 200 * 1000;
+  dev.inflight = 0;
+  dev.frames = 0;
+  dev.batches = 0;
+  dev.max_batch = 0;
+  dev.sessions = 0;
+  ASSERT_GE(test_st22_batch_register(&dev, 1, 2), 0);
+
+  for (int i = 0; i < 2; i++) {
+    test_ctx[i] = new tests_context();
+    ASSERT_TRUE(test_ctx[i] != NULL);
+    test_ctx[i]->idx = i;
+    test_ctx[i]->ctx = ctx;
+    test_ctx[i]->fb_cnt = 3;
+    test_ctx[i]->fb_idx = 0;
+    st22p_tx_ops_init(test_ctx[i], &ops);
+    ops.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+    handle[i] = st22p_tx_create(st, &ops);
+    ASSERT_TRUE(handle[i] != NULL);
+  }
+  EXPECT_EQ(dev.sessions.load(), 2);
+
+  /* one frame of each session to the workers */
+  for (int i = 0; i < 2; i++) {
+    frame = st22p_tx_get_frame(handle[i]);
+    ASSERT_TRUE(frame != NULL);
+    memset(frame->addr[0], 0, frame->data_size);
+    EXPECT_GE(st22p_tx_put_frame(handle[i], frame), 0);
+  }
+  for (int i = 0; i < 100 && !dev.inflight; i++) st_usleep(1000);
+  EXPECT_GT(dev.inflight.load(), 0);
+
+  /* free the first session with the batch inflight, it waits the frame back */
+  EXPECT_GE(st22p_tx_free(handle[0]), 0);
+  EXPECT_EQ(dev.sessions.load(), 1);
+
+  /* the other session keeps going after the detach */
+  for (int i = 0; i < 100 && dev.frames < 2; i++) st_usleep(10 * 1000);
+  EXPECT_EQ(dev.frames.load(), 2);
+  frame = st22p_tx_get_frame(handle[1]);
+  ASSERT_TRUE(frame != NULL);
+  EXPECT_GE(st22p_tx_put_frame(handle[1], frame), 0);
+  for (int i = 0; i < 100 && dev.frames < 3; i++) st_usleep(10 * 1000);
+  EXPECT_EQ(dev.frames.load(), 3);
+
+  EXPECT_GE(st22p_tx_free(handle[1]), 0);
+  EXPECT_EQ(dev.sessions.load(), 0);
+  EXPECT_EQ(dev.inflight.load(), 0);
+  for (int i = 0; i < 2; i++) delete test_ctx[i];
+  test_st22_batch_unregister(&dev);
+}
+
+/* the sample dev with a fixed self benchmark result */
+struct test_st22_bench_dev {
+  double fps;
+  std::atomic<int> bench_cnt;
+  std::atomic<int> sessions;
+  st22_encoder_dev_handle handle;
+};
+
+static double test_bench_encoder_benchmark(void* priv, enum st_frame_fmt input_fmt,
+                                           enum st_frame_fmt output_fmt, uint32_t width,
+                                           uint32_t height) {
+  auto dev = (struct test_st22_bench_dev*)priv;
+
+  dev->bench_cnt++;
+  return dev->fps;
+}
+
+static st22_encode_priv test_bench_encoder_create_session(
+    void* priv, st22p_encode_session session_p, struct st22_encoder_create_req* req) {
+  auto dev = (struct test_st22_bench_dev*)priv;
+
+  req->max_codestream_size = req->codestream_size;
+  dev->sessions++;
+  return dev;
+}
+
+static int test_bench_encoder_free_session(void* priv, st22_encode_priv session) {
+  auto dev = (struct test_st22_bench_dev*)priv;
+
+  dev->sessions--;
+  return 0;
+}
+
+static int test_bench_encoder_frame_available(void* priv) { return 0; }
+
+static int test_st22_bench_register(struct test_st22_bench_dev* dev, const char* name,
+                                    double fps) {
+  auto st = st_test_ctx()->handle;
+  struct st22_encoder_dev e_dev;
+
+  dev->fps = fps;
+  dev->bench_cnt = 0;
+  dev->sessions = 0;
+  memset(&e_dev, 0, sizeof(e_dev));
+  e_dev.name = name;
+  e_dev.priv = dev;
+  e_dev.target_device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  e_dev.input_fmt_caps = ST_FMT_CAP_YUV422PLANAR10LE;
+  e_dev.output_fmt_caps = ST_FMT_CAP_JPEGXS_CODESTREAM;
+  e_dev.create_session = test_bench_encoder_create_session;
+  e_dev.free_session = test_bench_encoder_free_session;
+  e_dev.notify_frame_available = test_bench_encoder_frame_available;
+  e_dev.benchmark = test_bench_encoder_benchmark;
+  dev->handle = st22_encoder_register(st, &e_dev);
+  return dev->handle ? 0 : -EIO;
+}
+
+TEST(St22p, plugin_bench_pick) {
+  auto ctx = st_test_ctx();
+  auto st = ctx->handle;
+  struct test_st22_bench_dev slow, fast;
+  tests_context* test_ctx[4];
+  st22p_tx_handle handle[4];
+  struct st22p_tx_ops ops;
+  /* the dev picked for each 1080p60 session, the fast one until its spare drops */
+  int expect_fast[4] = {1, 2, 3, 3};
+  int expect_slow[4] = {0, 0, 0, 1};
+
+  /* the slow one registered first to not win by the register order */
+  ASSERT_GE(test_st22_bench_register(&slow, "st22_test_bench_slow", 100), 0);
+  ASSERT_GE(test_st22_bench_register(&fast, "st22_test_bench_fast", 250), 0);
+
+  for (int i = 0; i < 4; i++) {
+    test_ctx[i] = new tests_context();
+    ASSERT_TRUE(test_ctx[i] != NULL);
+    test_ctx[i]->idx = i;
+    test_ctx[i]->ctx = ctx;
+    test_ctx[i]->fb_cnt = 3;
+    test_ctx[i]->fb_idx = 0;
+    st22p_tx_ops_init(test_ctx[i], &ops);
+    ops.fps = ST_FPS_P60;
+    ops.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+    handle[i] = st22p_tx_create(st, &ops);
+    ASSERT_TRUE(handle[i] != NULL);
+    EXPECT_EQ(fast.sessions.load(), expect_fast[i]);
+    EXPECT_EQ(slow.sessions.load(), expect_slow[i]);
+  }
+  /* the result is cached for the same format pair and resolution */
+  EXPECT_EQ(fast.bench_cnt.load(), 1);
+  EXPECT_EQ(slow.bench_cnt.load(), 1);
+
+  for (int i = 0; i < 4; i++) {
+    EXPECT_GE(st22p_tx_free(handle[i]), 0);
+    delete test_ctx[i];
+  }
+  EXPECT_EQ(fast.sessions.load(), 0);
+  EXPECT_EQ(slow.sessions.load(), 0);
+  st22_encoder_unregister(fast.handle);
+  st22_encoder_unregister(slow.handle);
+}
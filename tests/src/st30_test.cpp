@@ -1430,3 +1430,146 @@ TEST(St30_rx, after_start_frame_s1_r2) {
   enum st30_fmt f[1] = {ST30_FMT_PCM16};
   st30_create_after_start_test(type, s, c, f, 1, 2, ST_TEST_LEVEL_ALL);
 }
+
+static void tx_feed_packet_event(void* args) {
+  auto ctx = (tests_context*)args;
+  struct pollfd pfd;
+  void* mbuf;
+  void* usrptr = NULL;
+  uint16_t mbuf_len = 0;
+
+  memset(&pfd, 0, sizeof(pfd));
+  pfd.fd = st30_tx_get_event_fd((st30_tx_handle)ctx->handle);
+  pfd.events = POLLIN;
+  while (!ctx->stop) {
+    mbuf = st30_tx_get_mbuf((st30_tx_handle)ctx->handle, &usrptr);
+    if (!mbuf) {
+      poll(&pfd, 1, 100);
+      continue;
+    }
+    tx_audio_build_rtp_packet(ctx, (struct st_rfc3550_rtp_hdr*)usrptr, &mbuf_len);
+    st30_tx_put_mbuf((st30_tx_handle)ctx->handle, mbuf, mbuf_len);
+  }
+}
+
+static void rx_get_packet_event(void* args) {
+  auto ctx = (tests_context*)args;
+  struct pollfd pfd;
+  void* mbuf;
+  void* usrptr = NULL;
+  uint16_t mbuf_len = 0;
+
+  memset(&pfd, 0, sizeof(pfd));
+  pfd.fd = st30_rx_get_event_fd((st30_rx_handle)ctx->handle);
+  pfd.events = POLLIN;
+  while (!ctx->stop) {
+    mbuf = st30_rx_get_mbuf((st30_rx_handle)ctx->handle, &usrptr, &mbuf_len);
+    if (!mbuf) {
+      poll(&pfd, 1, 100);
+      continue;
+    }
+    ctx->fb_rec++;
+    st30_rx_put_mbuf((st30_rx_handle)ctx->handle, mbuf);
+  }
+}
+
+static int st30_event_rtp_done(void* args) {
+  auto ctx = (tests_context*)args;
+
+  if (!ctx->handle) return -EIO; /* not ready */
+  if (!ctx->start_time) ctx->start_time = st_test_get_monotonic_time();
+  ctx->fb_send++;
+  return 0;
+}
+
+static int st30_event_rtp_ready(void* args) {
+  auto ctx = (tests_context*)args;
+
+  if (!ctx->handle) return -EIO; /* not ready */
+  if (!ctx->start_time) ctx->start_time = st_test_get_monotonic_time();
+  return 0;
+}
+
+static void st30_event_fd_test(enum st_test_level level) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  int ret;
+  struct st30_tx_ops ops_tx;
+  struct st30_rx_ops ops_rx;
+
+  /* return if level small than global */
+  if (level < ctx->level) return;
+
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled for tx test, one for tx and one for rx\n",
+         __func__);
+    return;
+  }
+
+  auto test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  test_ctx_tx->idx = 0;
+  test_ctx_tx->ctx = ctx;
+  test_ctx_tx->fb_cnt = 3;
+  test_ctx_tx->fb_idx = 0;
+  st30_tx_ops_init(test_ctx_tx, &ops_tx);
+  ops_tx.num_port = 1;
+  memcpy(ops_tx.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  ops_tx.type = ST30_TYPE_RTP_LEVEL;
+  ops_tx.notify_rtp_done = st30_event_rtp_done;
+  ops_tx.flags |= ST30_TX_FLAG_EVENT_FD;
+  auto tx_handle = st30_tx_create(m_handle, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+  test_ctx_tx->handle = tx_handle;
+  EXPECT_GE(st30_tx_get_event_fd(tx_handle), 0);
+
+  auto test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+  test_ctx_rx->idx = 0;
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->fb_cnt = 3;
+  test_ctx_rx->fb_idx = 0;
+  st30_rx_ops_init(test_ctx_rx, &ops_rx);
+  ops_rx.num_port = 1;
+  memcpy(ops_rx.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_rx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  ops_rx.type = ST30_TYPE_RTP_LEVEL;
+  ops_rx.notify_rtp_ready = st30_event_rtp_ready;
+  ops_rx.flags |= ST30_RX_FLAG_EVENT_FD;
+  auto rx_handle = st30_rx_create(m_handle, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  test_ctx_rx->handle = rx_handle;
+  EXPECT_GE(st30_rx_get_event_fd(rx_handle), 0);
+
+  test_ctx_tx->stop = false;
+  test_ctx_rx->stop = false;
+  std::thread tx_thread = std::thread(tx_feed_packet_event, test_ctx_tx);
+  std::thread rx_thread = std::thread(rx_get_packet_event, test_ctx_rx);
+
+  ret = mtl_start(m_handle);
+  EXPECT_GE(ret, 0);
+  sleep(5);
+  test_ctx_tx->stop = true;
+  test_ctx_rx->stop = true;
+  tx_thread.join();
+  rx_thread.join();
+  ret = mtl_stop(m_handle);
+  EXPECT_GE(ret, 0);
+
+  info("%s, fb_send %d fb_rec %d\n", __func__, test_ctx_tx->fb_send,
+       test_ctx_rx->fb_rec);
+  EXPECT_GT(test_ctx_tx->fb_send, 0);
+  EXPECT_GT(test_ctx_rx->fb_rec, 0);
+
+  ret = st30_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st30_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
+
+TEST(St30_rx, rtp_event_fd) { st30_event_fd_test(ST_TEST_LEVEL_MANDATORY); }
@@ -0,0 +1,397 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include <thread>
+
+#include "log.h"
+#include "tests.h"
+
+#define ST30P_TEST_PAYLOAD_TYPE (111)
+#define ST30P_TEST_UDP_PORT (21000)
+/* the aes3 channel status block length in frames */
+#define ST30P_TEST_AES3_BLOCK (192)
+
+struct st30p_test_session {
+  enum st30_fmt fmt;
+  enum st30_frame_fmt frame_fmt;
+  uint16_t channel;
+  /* the global subframe index of next tx frame */
+  uint32_t subframe_idx;
+  /* fail as sample value or aes3 bits check fail */
+  int sample_fail_cnt;
+  int frame_fail_cnt;
+};
+
+static uint32_t st30p_test_sample_mask(enum st30_fmt fmt) {
+  if (fmt == ST30_FMT_PCM16) return 0xffff;
+  return 0xffffff; /* PCM24 and AM824 */
+}
+
+/* write the ramp value into subframe i of the frame */
+static void st30p_test_write(struct st30_frame* frame, uint32_t i, uint32_t g,
+                             uint32_t value) {
+  uint16_t ch = g % frame->channel;
+  bool block_start = !ch && !((g / frame->channel) % ST30P_TEST_AES3_BLOCK);
+
+  if (frame->fmt == ST30_FRAME_FMT_S32LE) {
+    uint32_t* dst = (uint32_t*)frame->addr;
+    int shift = (frame->transport_fmt == ST30_FMT_PCM16) ? 16 : 8;
+    dst[i] = value << shift; /* left aligned, test run on little endian cpu */
+  } else if (frame->fmt == ST30_FRAME_FMT_AES3) {
+    struct st31_aes3* dst = (struct st31_aes3*)frame->addr + i;
+    dst->preamble = ch ? 0x1 : (block_start ? 0x2 : 0x0);
+    dst->data_0 = value & 0xf;
+    dst->data_1 = (value >> 4) & 0xffff;
+    dst->data_2 = (value >> 20) & 0xf;
+    dst->p = value & 0x1;
+    dst->c = (value >> 1) & 0x1;
+    dst->u = (value >> 2) & 0x1;
+    dst->v = 0;
+  } else if (frame->transport_fmt == ST31_FMT_AM824) {
+    struct st31_am824* dst = (struct st31_am824*)frame->addr + i;
+    dst->unused = 0;
+    dst->b = block_start ? 1 : 0;
+    dst->f = ch ? 0 : 1;
+    dst->data[0] = value & 0xff;
+    dst->data[1] = (value >> 8) & 0xff;
+    dst->data[2] = (value >> 16) & 0xff;
+    dst->p = value & 0x1;
+    dst->c = (value >> 1) & 0x1;
+    dst->u = (value >> 2) & 0x1;
+    dst->v = 0;
+  } else { /* big endian pcm */
+    int size = st30_get_sample_size(frame->transport_fmt);
+    uint8_t* dst = (uint8_t*)frame->addr + i * size;
+    for (int b = 0; b < size; b++) dst[b] = value >> ((size - 1 - b) * 8);
+  }
+}
+
+/* read the value of subframe i, return false if the aes3/am824 bits are wrong */
+static bool st30p_test_read(struct st30_frame* frame, uint32_t i, uint32_t* value) {
+  uint16_t ch = i % frame->channel;
+  uint32_t v;
+
+  if (frame->fmt == ST30_FRAME_FMT_S32LE) {
+    uint32_t* src = (uint32_t*)frame->addr;
+    int shift = (frame->transport_fmt == ST30_FMT_PCM16) ? 16 : 8;
+    /* the bits below the transport sample should be zero */
+    if (src[i] & ((1u << shift) - 1)) return false;
+    *value = src[i] >> shift;
+    return true;
+  }
+
+  if (frame->fmt == ST30_FRAME_FMT_AES3) {
+    struct st31_aes3* src = (struct st31_aes3*)frame->addr + i;
+    v = src->data_0 | ((uint32_t)src->data_1 << 4) | ((uint32_t)src->data_2 << 20);
+    *value = v;
+    if (ch && src->preamble != 0x1) return false;
+    if (!ch && src->preamble != 0x0 && src->preamble != 0x2) return false;
+    if (src->p != (v & 0x1) || src->c != ((v >> 1) & 0x1)) return false;
+    if (src->u != ((v >> 2) & 0x1) || src->v) return false;
+    return true;
+  }
+
+  if (frame->transport_fmt == ST31_FMT_AM824) {
+    struct st31_am824* src = (struct st31_am824*)frame->addr + i;
+    v = src->data[0] | ((uint32_t)src->data[1] << 8) | ((uint32_t)src->data[2] << 16);
+    *value = v;
+    if (src->f != (ch ? 0 : 1) || (src->b && !src->f)) return false;
+    if (src->p != (v & 0x1) || src->c != ((v >> 1) & 0x1)) return false;
+    if (src->u != ((v >> 2) & 0x1) || src->v) return false;
+    return true;
+  }
+
+  int size = st30_get_sample_size(frame->transport_fmt);
+  uint8_t* src = (uint8_t*)frame->addr + i * size;
+  v = 0;
+  for (int b = 0; b < size; b++) v = (v << 8) | src[b];
+  *value = v;
+  return true;
+}
+
+static void test_st30p_tx_frame_thread(void* args) {
+  tests_context* s = (tests_context*)args;
+  auto handle = (st30p_tx_handle)s->handle;
+  auto session = (struct st30p_test_session*)s->priv;
+  uint32_t mask = st30p_test_sample_mask(session->fmt);
+  struct st30_frame* frame;
+
+  dbg("%s(%d), start\n", __func__, s->idx);
+  while (!s->stop) {
+    frame = st30p_tx_get_frame(handle);
+    if (!frame) continue; /* block get timeout or wake */
+
+    if (frame->fmt != session->frame_fmt) session->frame_fail_cnt++;
+    if (frame->transport_fmt != session->fmt) session->frame_fail_cnt++;
+    if (frame->channel != session->channel) session->frame_fail_cnt++;
+    if (frame->data_size != s->frame_size) session->frame_fail_cnt++;
+
+    uint32_t subframes = frame->sample_num * frame->channel;
+    for (uint32_t i = 0; i < subframes; i++) {
+      uint32_t g = session->subframe_idx + i;
+      st30p_test_write(frame, i, g, g & mask);
+    }
+    session->subframe_idx += subframes;
+
+    st30p_tx_put_frame(handle, frame);
+    s->fb_send++;
+    if (!s->start_time) s->start_time = st_test_get_monotonic_time();
+  }
+  dbg("%s(%d), stop\n", __func__, s->idx);
+}
+
+static void test_st30p_rx_frame_thread(void* args) {
+  tests_context* s = (tests_context*)args;
+  auto handle = (st30p_rx_handle)s->handle;
+  auto session = (struct st30p_test_session*)s->priv;
+  uint32_t mask = st30p_test_sample_mask(session->fmt);
+  struct st30_frame* frame;
+  uint32_t first, value;
+
+  dbg("%s(%d), start\n", __func__, s->idx);
+  while (!s->stop) {
+    frame = st30p_rx_get_frame(handle);
+    if (!frame) continue; /* block get timeout or wake */
+
+    if (frame->fmt != session->frame_fmt) session->frame_fail_cnt++;
+    if (frame->transport_fmt != session->fmt) session->frame_fail_cnt++;
+    if (frame->channel != session->channel) session->frame_fail_cnt++;
+    if (frame->data_size != s->frame_size) session->frame_fail_cnt++;
+
+    /* the samples should keep the tx ramp from the first subframe */
+    uint32_t subframes = frame->sample_num * frame->channel;
+    if (!st30p_test_read(frame, 0, &first)) session->sample_fail_cnt++;
+    for (uint32_t i = 1; i < subframes; i++) {
+      if (!st30p_test_read(frame, i, &value) || value != ((first + i) & mask)) {
+        session->sample_fail_cnt++;
+        dbg("%s(%d), subframe %u value 0x%x first 0x%x\n", __func__, s->idx, i, value,
+            first);
+        break;
+      }
+    }
+
+    st30p_rx_put_frame(handle, frame);
+    s->fb_rec++;
+    if (!s->start_time) s->start_time = st_test_get_monotonic_time();
+  }
+  dbg("%s(%d), stop\n", __func__, s->idx);
+}
+
+static void st30p_rx_digest_test(enum st30_fmt fmt, enum st30_frame_fmt tx_frame_fmt,
+                                 enum st30_frame_fmt rx_frame_fmt,
+                                 enum st30_sampling sampling, enum st30_ptime ptime,
+                                 uint16_t channel) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto st = ctx->handle;
+  struct st30p_tx_ops ops_tx;
+  struct st30p_rx_ops ops_rx;
+  struct st30p_test_session session_tx, session_rx;
+  int ret;
+
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled, one for tx and one for rx\n", __func__);
+    return;
+  }
+
+  tests_context* test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  tests_context* test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+
+  memset(&session_tx, 0, sizeof(session_tx));
+  session_tx.fmt = fmt;
+  session_tx.frame_fmt = tx_frame_fmt;
+  session_tx.channel = channel;
+  session_rx = session_tx;
+  session_rx.frame_fmt = rx_frame_fmt;
+
+  test_ctx_tx->idx = 0;
+  test_ctx_tx->ctx = ctx;
+  test_ctx_tx->priv = &session_tx;
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st30p_test";
+  ops_tx.priv = test_ctx_tx;
+  ops_tx.port.num_port = 1;
+  memcpy(ops_tx.port.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops_tx.port.udp_port[MTL_SESSION_PORT_P] = ST30P_TEST_UDP_PORT;
+  ops_tx.port.payload_type = ST30P_TEST_PAYLOAD_TYPE;
+  ops_tx.fmt = fmt;
+  ops_tx.channel = channel;
+  ops_tx.sampling = sampling;
+  ops_tx.ptime = ptime;
+  ops_tx.frame_fmt = tx_frame_fmt;
+  ops_tx.frame_time_us = 10 * 1000;
+  ops_tx.framebuff_cnt = 3;
+  ops_tx.flags = ST30P_TX_FLAG_BLOCK_GET;
+
+  st30p_tx_handle tx_handle = st30p_tx_create(st, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+  test_ctx_tx->handle = tx_handle;
+  test_ctx_tx->frame_size = st30p_tx_frame_size(tx_handle);
+  EXPECT_GT(test_ctx_tx->frame_size, 0);
+
+  test_ctx_rx->idx = 0;
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->priv = &session_rx;
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "st30p_test";
+  ops_rx.priv = test_ctx_rx;
+  ops_rx.port.num_port = 1;
+  memcpy(ops_rx.port.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_rx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  ops_rx.port.udp_port[MTL_SESSION_PORT_P] = ST30P_TEST_UDP_PORT;
+  ops_rx.port.payload_type = ST30P_TEST_PAYLOAD_TYPE;
+  ops_rx.fmt = fmt;
+  ops_rx.channel = channel;
+  ops_rx.sampling = sampling;
+  ops_rx.ptime = ptime;
+  ops_rx.frame_fmt = rx_frame_fmt;
+  ops_rx.frame_time_us = 10 * 1000;
+  ops_rx.framebuff_cnt = 3;
+  ops_rx.flags = ST30P_RX_FLAG_BLOCK_GET;
+
+  st30p_rx_handle rx_handle = st30p_rx_create(st, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  test_ctx_rx->handle = rx_handle;
+  test_ctx_rx->frame_size = st30p_rx_frame_size(rx_handle);
+  EXPECT_GT(test_ctx_rx->frame_size, 0);
+
+  struct st_queue_meta meta;
+  ret = st30p_rx_get_queue_meta(rx_handle, &meta);
+  EXPECT_GE(ret, 0);
+
+  std::thread tx_thread(test_st30p_tx_frame_thread, test_ctx_tx);
+  std::thread rx_thread(test_st30p_rx_frame_thread, test_ctx_rx);
+
+  ret = mtl_start(st);
+  EXPECT_GE(ret, 0);
+  sleep(5);
+  ret = mtl_stop(st);
+  EXPECT_GE(ret, 0);
+
+  test_ctx_tx->stop = true;
+  st30p_tx_wake_block(tx_handle);
+  tx_thread.join();
+  test_ctx_rx->stop = true;
+  st30p_rx_wake_block(rx_handle);
+  rx_thread.join();
+
+  uint64_t cur_time_ns = st_test_get_monotonic_time();
+  double time_sec = (double)(cur_time_ns - test_ctx_rx->start_time) / NS_PER_S;
+  double framerate_rx = test_ctx_rx->fb_rec / time_sec;
+
+  ret = st30p_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st30p_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+
+  info("%s, fb_send %d fb_rec %d framerate %f\n", __func__, test_ctx_tx->fb_send,
+       test_ctx_rx->fb_rec, framerate_rx);
+  EXPECT_GT(test_ctx_tx->fb_send, 0);
+  EXPECT_GT(test_ctx_rx->fb_rec, 0);
+  EXPECT_EQ(session_tx.frame_fail_cnt, 0);
+  EXPECT_EQ(session_rx.frame_fail_cnt, 0);
+  EXPECT_EQ(session_rx.sample_fail_cnt, 0);
+  /* 10ms frame */
+  EXPECT_NEAR(framerate_rx, 100, 100 * 0.1);
+
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
+
+TEST(St30p, create_expect_fail_frame_fmt) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto st = ctx->handle;
+  struct st30p_tx_ops ops_tx;
+  struct st30p_rx_ops ops_rx;
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st30p_test";
+  ops_tx.port.num_port = 1;
+  memcpy(ops_tx.port.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops_tx.port.udp_port[MTL_SESSION_PORT_P] = ST30P_TEST_UDP_PORT;
+  ops_tx.port.payload_type = ST30P_TEST_PAYLOAD_TYPE;
+  ops_tx.channel = 2;
+  ops_tx.sampling = ST30_SAMPLING_48K;
+  ops_tx.ptime = ST30_PTIME_1MS;
+  ops_tx.frame_time_us = 10 * 1000;
+  ops_tx.framebuff_cnt = 3;
+  ops_tx.flags = ST30P_TX_FLAG_BLOCK_GET;
+
+  /* s32le only for pcm16/pcm24, aes3 only for am824 */
+  ops_tx.fmt = ST31_FMT_AM824;
+  ops_tx.frame_fmt = ST30_FRAME_FMT_S32LE;
+  EXPECT_TRUE(st30p_tx_create(st, &ops_tx) == NULL);
+  ops_tx.fmt = ST30_FMT_PCM16;
+  ops_tx.frame_fmt = ST30_FRAME_FMT_AES3;
+  EXPECT_TRUE(st30p_tx_create(st, &ops_tx) == NULL);
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "st30p_test";
+  ops_rx.port.num_port = 1;
+  memcpy(ops_rx.port.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_rx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  ops_rx.port.udp_port[MTL_SESSION_PORT_P] = ST30P_TEST_UDP_PORT;
+  ops_rx.port.payload_type = ST30P_TEST_PAYLOAD_TYPE;
+  ops_rx.channel = 2;
+  ops_rx.sampling = ST30_SAMPLING_48K;
+  ops_rx.ptime = ST30_PTIME_1MS;
+  ops_rx.frame_time_us = 10 * 1000;
+  ops_rx.framebuff_cnt = 3;
+  ops_rx.flags = ST30P_RX_FLAG_BLOCK_GET;
+
+  ops_rx.fmt = ST30_FMT_PCM24;
+  ops_rx.frame_fmt = ST30_FRAME_FMT_AES3;
+  EXPECT_TRUE(st30p_rx_create(st, &ops_rx) == NULL);
+  ops_rx.fmt = ST31_FMT_AM824;
+  ops_rx.frame_fmt = ST30_FRAME_FMT_S32LE;
+  EXPECT_TRUE(st30p_rx_create(st, &ops_rx) == NULL);
+}
+
+TEST(St30p, digest_pcm16_s32le) {
+  st30p_rx_digest_test(ST30_FMT_PCM16, ST30_FRAME_FMT_S32LE, ST30_FRAME_FMT_S32LE,
+                       ST30_SAMPLING_48K, ST30_PTIME_1MS, 2);
+}
+
+TEST(St30p, digest_pcm24_s32le) {
+  st30p_rx_digest_test(ST30_FMT_PCM24, ST30_FRAME_FMT_S32LE, ST30_FRAME_FMT_S32LE,
+                       ST30_SAMPLING_96K, ST30_PTIME_125US, 8);
+}
+
+TEST(St30p, digest_pcm16_s32le_to_transport) {
+  st30p_rx_digest_test(ST30_FMT_PCM16, ST30_FRAME_FMT_S32LE, ST30_FRAME_FMT_TRANSPORT,
+                       ST30_SAMPLING_48K, ST30_PTIME_1MS, 1);
+}
+
+TEST(St30p, digest_pcm24_transport_to_s32le) {
+  st30p_rx_digest_test(ST30_FMT_PCM24, ST30_FRAME_FMT_TRANSPORT, ST30_FRAME_FMT_S32LE,
+                       ST30_SAMPLING_48K, ST30_PTIME_1MS, 2);
+}
+
+TEST(St30p, digest_am824_aes3) {
+  st30p_rx_digest_test(ST31_FMT_AM824, ST30_FRAME_FMT_AES3, ST30_FRAME_FMT_AES3,
+                       ST30_SAMPLING_48K, ST30_PTIME_1MS, 2);
+}
+
+TEST(St30p, digest_am824_aes3_to_transport) {
+  st30p_rx_digest_test(ST31_FMT_AM824, ST30_FRAME_FMT_AES3, ST30_FRAME_FMT_TRANSPORT,
+                       ST30_SAMPLING_48K, ST30_PTIME_125US, 4);
+}
+
+TEST(St30p, digest_am824_transport_to_aes3) {
+  st30p_rx_digest_test(ST31_FMT_AM824, ST30_FRAME_FMT_TRANSPORT, ST30_FRAME_FMT_AES3,
+                       ST30_SAMPLING_96K, ST30_PTIME_1MS, 2);
+}
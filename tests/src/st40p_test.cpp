@@ -0,0 +1,370 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include <thread>
+
+#include "log.h"
+#include "tests.h"
+
+#define ST40P_TEST_PAYLOAD_TYPE (113)
+#define ST40P_TEST_UDP_PORT (31000)
+/* the max anc packets of one test frame, the frame of 0 packets is also sent */
+#define ST40P_TEST_MAX_PKTS (3)
+
+struct st40p_test_session {
+  uint32_t frame_cnt;
+  int empty_frame_cnt;
+  int pkt_fail_cnt;
+  int frame_fail_cnt;
+};
+
+/* the udw_size and did/sdid of pkt j is fixed, the udw is a ramp from udw[0] */
+static void st40p_test_fill_pkt(struct st40_anc_pkt* pkt, uint32_t j, uint8_t start) {
+  memset(pkt, 0, sizeof(*pkt));
+  pkt->c = 0;
+  pkt->line_number = 10 + j;
+  pkt->hori_offset = 0;
+  pkt->s = 0;
+  pkt->stream_num = 0;
+  pkt->did = 0x43;
+  pkt->sdid = 0x02 + j;
+  pkt->udw_size = 8 + j * 5;
+  for (uint8_t k = 0; k < pkt->udw_size; k++) pkt->udw[k] = start + k;
+}
+
+static bool st40p_test_check_pkt(struct st40_anc_pkt* pkt) {
+  uint32_t j = pkt->sdid - 0x02;
+
+  if (j >= ST40P_TEST_MAX_PKTS) return false;
+  if (pkt->did != 0x43 || pkt->line_number != 10 + j) return false;
+  if (pkt->udw_size != 8 + j * 5) return false;
+  for (uint8_t k = 0; k < pkt->udw_size; k++) {
+    if (pkt->udw[k] != (uint8_t)(pkt->udw[0] + k)) return false;
+  }
+  return true;
+}
+
+static void test_st40p_tx_frame_thread(void* args) {
+  tests_context* s = (tests_context*)args;
+  auto handle = (st40p_tx_handle)s->handle;
+  auto session = (struct st40p_test_session*)s->priv;
+  struct st40_anc_frame* frame;
+
+  dbg("%s(%d), start\n", __func__, s->idx);
+  while (!s->stop) {
+    frame = st40p_tx_get_frame(handle);
+    if (!frame) continue; /* block get timeout or wake */
+
+    /* 0 to ST40P_TEST_MAX_PKTS packets round robin */
+    frame->pkt_cnt = session->frame_cnt % (ST40P_TEST_MAX_PKTS + 1);
+    for (uint32_t j = 0; j < frame->pkt_cnt; j++) {
+      st40p_test_fill_pkt(&frame->pkts[j], j, session->frame_cnt + j);
+    }
+    session->frame_cnt++;
+
+    int ret = st40p_tx_put_frame(handle, frame);
+    if (ret < 0) session->frame_fail_cnt++;
+    s->fb_send++;
+    if (!s->start_time) s->start_time = st_test_get_monotonic_time();
+  }
+  dbg("%s(%d), stop\n", __func__, s->idx);
+}
+
+static void test_st40p_rx_frame_thread(void* args) {
+  tests_context* s = (tests_context*)args;
+  auto handle = (st40p_rx_handle)s->handle;
+  auto session = (struct st40p_test_session*)s->priv;
+  struct st40_anc_frame* frame;
+  uint64_t timestamp = 0;
+
+  dbg("%s(%d), start\n", __func__, s->idx);
+  while (!s->stop) {
+    frame = st40p_rx_get_frame(handle);
+    if (!frame) continue; /* block get timeout or wake */
+
+    if (frame->pkt_cnt > ST40P_TEST_MAX_PKTS) session->frame_fail_cnt++;
+    if (s->fb_rec && frame->timestamp == timestamp) session->frame_fail_cnt++;
+    timestamp = frame->timestamp;
+    if (!frame->pkt_cnt) session->empty_frame_cnt++;
+    for (uint32_t j = 0; j < frame->pkt_cnt; j++) {
+      if (!st40p_test_check_pkt(&frame->pkts[j])) session->pkt_fail_cnt++;
+    }
+
+    st40p_rx_put_frame(handle, frame);
+    s->fb_rec++;
+    if (!s->start_time) s->start_time = st_test_get_monotonic_time();
+  }
+  dbg("%s(%d), stop\n", __func__, s->idx);
+}
+
+static void st40p_rx_ops_init(tests_context* s, struct st40p_rx_ops* ops) {
+  auto ctx = s->ctx;
+
+  memset(ops, 0, sizeof(*ops));
+  ops->name = "st40p_test";
+  ops->priv = s;
+  ops->port.num_port = 1;
+  memcpy(ops->port.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops->port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  ops->port.udp_port[MTL_SESSION_PORT_P] = ST40P_TEST_UDP_PORT + s->idx * 2;
+  ops->port.payload_type = ST40P_TEST_PAYLOAD_TYPE;
+  ops->framebuff_cnt = 3;
+  ops->flags = ST40P_RX_FLAG_BLOCK_GET;
+}
+
+TEST(St40p, digest_s1) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto st = ctx->handle;
+  struct st40p_tx_ops ops_tx;
+  struct st40p_rx_ops ops_rx;
+  struct st40p_test_session session_tx, session_rx;
+  int ret;
+
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled, one for tx and one for rx\n", __func__);
+    return;
+  }
+
+  memset(&session_tx, 0, sizeof(session_tx));
+  memset(&session_rx, 0, sizeof(session_rx));
+  tests_context* test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  test_ctx_tx->ctx = ctx;
+  test_ctx_tx->priv = &session_tx;
+  tests_context* test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->priv = &session_rx;
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st40p_test";
+  ops_tx.priv = test_ctx_tx;
+  ops_tx.port.num_port = 1;
+  memcpy(ops_tx.port.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops_tx.port.udp_port[MTL_SESSION_PORT_P] = ST40P_TEST_UDP_PORT;
+  ops_tx.port.payload_type = ST40P_TEST_PAYLOAD_TYPE;
+  ops_tx.fps = ST_FPS_P59_94;
+  ops_tx.framebuff_cnt = 3;
+  ops_tx.flags = ST40P_TX_FLAG_BLOCK_GET;
+
+  st40p_tx_handle tx_handle = st40p_tx_create(st, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+  test_ctx_tx->handle = tx_handle;
+
+  st40p_rx_ops_init(test_ctx_rx, &ops_rx);
+  st40p_rx_handle rx_handle = st40p_rx_create(st, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  test_ctx_rx->handle = rx_handle;
+
+  struct st_queue_meta meta;
+  ret = st40p_rx_get_queue_meta(rx_handle, &meta);
+  EXPECT_GE(ret, 0);
+
+  std::thread tx_thread(test_st40p_tx_frame_thread, test_ctx_tx);
+  std::thread rx_thread(test_st40p_rx_frame_thread, test_ctx_rx);
+
+  ret = mtl_start(st);
+  EXPECT_GE(ret, 0);
+  sleep(5);
+  ret = mtl_stop(st);
+  EXPECT_GE(ret, 0);
+
+  test_ctx_tx->stop = true;
+  st40p_tx_wake_block(tx_handle);
+  tx_thread.join();
+  test_ctx_rx->stop = true;
+  st40p_rx_wake_block(rx_handle);
+  rx_thread.join();
+
+  uint64_t cur_time_ns = st_test_get_monotonic_time();
+  double time_sec = (double)(cur_time_ns - test_ctx_rx->start_time) / NS_PER_S;
+  double framerate_rx = test_ctx_rx->fb_rec / time_sec;
+  double expect_framerate = st_frame_rate(ops_tx.fps);
+
+  ret = st40p_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st40p_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+
+  info("%s, fb_send %d fb_rec %d empty %d framerate %f\n", __func__,
+       test_ctx_tx->fb_send, test_ctx_rx->fb_rec, session_rx.empty_frame_cnt,
+       framerate_rx);
+  EXPECT_GT(test_ctx_tx->fb_send, 0);
+  EXPECT_GT(test_ctx_rx->fb_rec, 0);
+  /* the frames without any anc packet should be sent and received also */
+  EXPECT_EQ(session_tx.frame_fail_cnt, 0);
+  EXPECT_GT(session_rx.empty_frame_cnt, 0);
+  EXPECT_EQ(session_rx.frame_fail_cnt, 0);
+  EXPECT_EQ(session_rx.pkt_fail_cnt, 0);
+  EXPECT_NEAR(framerate_rx, expect_framerate, expect_framerate * 0.1);
+
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
+
+/* build one anc packet without marker, all packets share the same rtp timestamp */
+static uint16_t st40p_test_build_rtp_no_marker(tests_context* s,
+                                               struct st40_rfc8331_rtp_hdr* rtp) {
+  struct st40_rfc8331_payload_hdr* payload_hdr =
+      (struct st40_rfc8331_payload_hdr*)(&rtp[1]);
+  struct st40_anc_pkt pkt;
+  int total_size, payload_len;
+
+  memset(rtp, 0x0, sizeof(*rtp));
+  rtp->base.marker = 0;
+  rtp->base.payload_type = ST40P_TEST_PAYLOAD_TYPE;
+  rtp->base.version = 2;
+  rtp->f = 0b00;
+  rtp->base.tmstamp = htonl(0x1234);
+  rtp->base.ssrc = htonl(0x88888888 + s->idx);
+  rtp->base.seq_number = htons((uint16_t)s->seq_id);
+  rtp->seq_number_ext = htons((uint16_t)(s->seq_id >> 16));
+  s->seq_id++;
+
+  st40p_test_fill_pkt(&pkt, 0, s->seq_id);
+  payload_hdr->first_hdr_chunk.c = pkt.c;
+  payload_hdr->first_hdr_chunk.line_number = pkt.line_number;
+  payload_hdr->first_hdr_chunk.horizontal_offset = pkt.hori_offset;
+  payload_hdr->first_hdr_chunk.s = pkt.s;
+  payload_hdr->first_hdr_chunk.stream_num = pkt.stream_num;
+  payload_hdr->second_hdr_chunk.did = st40_add_parity_bits(pkt.did);
+  payload_hdr->second_hdr_chunk.sdid = st40_add_parity_bits(pkt.sdid);
+  payload_hdr->second_hdr_chunk.data_count = st40_add_parity_bits(pkt.udw_size);
+  payload_hdr->swaped_first_hdr_chunk = htonl(payload_hdr->swaped_first_hdr_chunk);
+  payload_hdr->swaped_second_hdr_chunk = htonl(payload_hdr->swaped_second_hdr_chunk);
+  for (int i = 0; i < pkt.udw_size; i++) {
+    st40_set_udw(i + 3, st40_add_parity_bits(pkt.udw[i]),
+                 (uint8_t*)&payload_hdr->second_hdr_chunk);
+  }
+  uint16_t check_sum =
+      st40_calc_checksum(3 + pkt.udw_size, (uint8_t*)&payload_hdr->second_hdr_chunk);
+  st40_set_udw(pkt.udw_size + 3, check_sum, (uint8_t*)&payload_hdr->second_hdr_chunk);
+  total_size = ((3 + pkt.udw_size + 1) * 10) / 8;
+  total_size = (4 - total_size % 4) + total_size;
+  payload_len = sizeof(struct st40_rfc8331_payload_hdr) - 4 + total_size;
+  rtp->anc_count = 1;
+  rtp->length = htons(payload_len);
+
+  return payload_len + sizeof(struct st40_rfc8331_rtp_hdr);
+}
+
+static int st40p_test_tx_rtp_done(void* args) {
+  auto s = (tests_context*)args;
+
+  std::unique_lock<std::mutex> lck(s->mtx);
+  s->cv.notify_all();
+  s->fb_send++;
+  return 0;
+}
+
+static void st40p_test_tx_feed_packet(void* args) {
+  auto s = (tests_context*)args;
+  auto handle = (st40_tx_handle)s->handle;
+  void* mbuf;
+  void* usrptr = NULL;
+  std::unique_lock<std::mutex> lck(s->mtx, std::defer_lock);
+
+  while (!s->stop) {
+    mbuf = st40_tx_get_mbuf(handle, &usrptr);
+    if (!mbuf) {
+      lck.lock();
+      if (!s->stop) s->cv.wait(lck);
+      lck.unlock();
+      continue;
+    }
+    auto rtp = (struct st40_rfc8331_rtp_hdr*)usrptr;
+    uint16_t len = st40p_test_build_rtp_no_marker(s, rtp);
+    st40_tx_put_mbuf(handle, mbuf, len);
+  }
+}
+
+/* no marker and no new timestamp, the frames can only be delivered by the timeout */
+TEST(St40p, rx_assemble_timeout) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto st = ctx->handle;
+  struct st40_tx_ops ops_tx;
+  struct st40p_rx_ops ops_rx;
+  struct st40p_test_session session_rx;
+  int ret;
+
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled, one for tx and one for rx\n", __func__);
+    return;
+  }
+
+  memset(&session_rx, 0, sizeof(session_rx));
+  tests_context* test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  test_ctx_tx->ctx = ctx;
+  tests_context* test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->priv = &session_rx;
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st40p_test_rtp";
+  ops_tx.priv = test_ctx_tx;
+  ops_tx.num_port = 1;
+  memcpy(ops_tx.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops_tx.udp_port[MTL_SESSION_PORT_P] = ST40P_TEST_UDP_PORT;
+  ops_tx.type = ST40_TYPE_RTP_LEVEL;
+  /* one packet every 40ms, longer than the assemble timeout */
+  ops_tx.fps = ST_FPS_P25;
+  ops_tx.payload_type = ST40P_TEST_PAYLOAD_TYPE;
+  ops_tx.rtp_ring_size = 1024;
+  ops_tx.notify_rtp_done = st40p_test_tx_rtp_done;
+
+  st40_tx_handle tx_handle = st40_tx_create(st, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+  test_ctx_tx->handle = tx_handle;
+
+  st40p_rx_ops_init(test_ctx_rx, &ops_rx);
+  ops_rx.assemble_timeout_us = 10 * 1000;
+  st40p_rx_handle rx_handle = st40p_rx_create(st, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  test_ctx_rx->handle = rx_handle;
+
+  std::thread tx_thread(st40p_test_tx_feed_packet, test_ctx_tx);
+  std::thread rx_thread(test_st40p_rx_frame_thread, test_ctx_rx);
+
+  ret = mtl_start(st);
+  EXPECT_GE(ret, 0);
+  sleep(5);
+  ret = mtl_stop(st);
+  EXPECT_GE(ret, 0);
+
+  test_ctx_tx->stop = true;
+  {
+    std::unique_lock<std::mutex> lck(test_ctx_tx->mtx);
+    test_ctx_tx->cv.notify_all();
+  }
+  tx_thread.join();
+  test_ctx_rx->stop = true;
+  st40p_rx_wake_block(rx_handle);
+  rx_thread.join();
+
+  ret = st40_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st40p_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+
+  info("%s, pkt send %d fb_rec %d\n", __func__, test_ctx_tx->fb_send,
+       test_ctx_rx->fb_rec);
+  EXPECT_GT(test_ctx_tx->fb_send, 0);
+  /* each packet is flushed as one frame by the timeout */
+  EXPECT_NEAR(test_ctx_rx->fb_rec, test_ctx_tx->fb_send, test_ctx_tx->fb_send * 0.1);
+  EXPECT_EQ(session_rx.pkt_fail_cnt, 0);
+  EXPECT_EQ(session_rx.empty_frame_cnt, 0);
+
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
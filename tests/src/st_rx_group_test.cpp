@@ -0,0 +1,296 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2022 Intel Corporation
+ */
+
+#include <thread>
+
+#include "log.h"
+#include "tests.h"
+
+#define RX_GROUP_TEST_UDP_PORT (22000)
+#define RX_GROUP_TEST_VIDEO_PT (112)
+#define RX_GROUP_TEST_AUDIO_PT (111)
+#define RX_GROUP_TEST_ANC_PT (113)
+
+struct rx_group_test_result {
+  int bundle_cnt;
+  int complete_cnt;
+  int shared_audio_cnt;     /* the audio frame attached to two consecutive bundles */
+  int audio_order_fail_cnt; /* the audio frames of one bundle not in timestamp order */
+  int anc_missing_cnt;      /* complete bundle without any anc frame */
+};
+
+static void rx_group_test_tx_video(tests_context* s) {
+  auto handle = (st20p_tx_handle)s->handle;
+  struct st_frame* frame;
+
+  while (!s->stop) {
+    frame = st20p_tx_get_frame(handle);
+    if (!frame) continue; /* block get timeout */
+    st20p_tx_put_frame(handle, frame);
+    s->fb_send++;
+  }
+}
+
+static void rx_group_test_tx_audio(tests_context* s) {
+  auto handle = (st30p_tx_handle)s->handle;
+  struct st30_frame* frame;
+
+  while (!s->stop) {
+    frame = st30p_tx_get_frame(handle);
+    if (!frame) continue; /* block get timeout */
+    st30p_tx_put_frame(handle, frame);
+    s->fb_send++;
+  }
+}
+
+static void rx_group_test_tx_anc(tests_context* s) {
+  auto handle = (st40p_tx_handle)s->handle;
+  struct st40_anc_frame* frame;
+
+  while (!s->stop) {
+    frame = st40p_tx_get_frame(handle);
+    if (!frame) continue; /* block get timeout */
+    memset(&frame->pkts[0], 0, sizeof(frame->pkts[0]));
+    frame->pkts[0].did = 0x41;
+    frame->pkts[0].sdid = 0x07;
+    frame->pkts[0].line_number = 9;
+    frame->pkts[0].udw_size = 4;
+    frame->pkt_cnt = 1;
+    st40p_tx_put_frame(handle, frame);
+    s->fb_send++;
+  }
+}
+
+static void rx_group_test_rx(st_rx_group_handle group, tests_context* s,
+                             struct rx_group_test_result* result) {
+  struct st_rx_group_bundle* bundle;
+  struct st_rx_group_bundle* prev = NULL;
+
+  while (!s->stop) {
+    bundle = st_rx_group_get_bundle(group);
+    if (!bundle) {
+      st_usleep(1000);
+      continue;
+    }
+
+    result->bundle_cnt++;
+    if (bundle->complete) result->complete_cnt++;
+
+    struct st_rx_group_audio* audio = &bundle->audio[0];
+    for (uint16_t i = 1; i < audio->frame_cnt; i++) {
+      if (audio->frames[i]->timestamp < audio->frames[i - 1]->timestamp)
+        result->audio_order_fail_cnt++;
+    }
+    /* the previous bundle is still held, the shared frame is the same pointer */
+    if (prev && prev->audio[0].frame_cnt && audio->frame_cnt) {
+      struct st_rx_group_audio* prev_audio = &prev->audio[0];
+      if (prev_audio->frames[prev_audio->frame_cnt - 1] == audio->frames[0])
+        result->shared_audio_cnt++;
+    }
+    if (bundle->complete && !bundle->anc[0].frame_cnt) result->anc_missing_cnt++;
+
+    if (prev) st_rx_group_put_bundle(group, prev);
+    prev = bundle;
+  }
+  if (prev) st_rx_group_put_bundle(group, prev);
+}
+
+TEST(St_rx_group, video_audio_anc_s1) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto st = ctx->handle;
+  int ret;
+
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled, one for tx and one for rx\n", __func__);
+    return;
+  }
+
+  tests_context* video_tx = new tests_context();
+  tests_context* audio_tx = new tests_context();
+  tests_context* anc_tx = new tests_context();
+  tests_context* group_rx = new tests_context();
+
+  /* video */
+  struct st20p_tx_ops video_tx_ops;
+  memset(&video_tx_ops, 0, sizeof(video_tx_ops));
+  video_tx_ops.name = "rx_group_test";
+  video_tx_ops.port.num_port = 1;
+  memcpy(video_tx_ops.port.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(video_tx_ops.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  video_tx_ops.port.udp_port[MTL_SESSION_PORT_P] = RX_GROUP_TEST_UDP_PORT;
+  video_tx_ops.port.payload_type = RX_GROUP_TEST_VIDEO_PT;
+  video_tx_ops.width = 1280;
+  video_tx_ops.height = 720;
+  video_tx_ops.fps = ST_FPS_P59_94;
+  video_tx_ops.input_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  video_tx_ops.transport_fmt = ST20_FMT_YUV_422_10BIT;
+  video_tx_ops.device = ST_PLUGIN_DEVICE_AUTO;
+  video_tx_ops.framebuff_cnt = 3;
+  video_tx_ops.flags = ST20P_TX_FLAG_BLOCK_GET;
+  st20p_tx_handle video_tx_handle = st20p_tx_create(st, &video_tx_ops);
+  ASSERT_TRUE(video_tx_handle != NULL);
+  video_tx->handle = video_tx_handle;
+
+  struct st20p_rx_ops video_rx_ops;
+  memset(&video_rx_ops, 0, sizeof(video_rx_ops));
+  video_rx_ops.name = "rx_group_test";
+  video_rx_ops.port.num_port = 1;
+  memcpy(video_rx_ops.port.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(video_rx_ops.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  video_rx_ops.port.udp_port[MTL_SESSION_PORT_P] = RX_GROUP_TEST_UDP_PORT;
+  video_rx_ops.port.payload_type = RX_GROUP_TEST_VIDEO_PT;
+  video_rx_ops.width = video_tx_ops.width;
+  video_rx_ops.height = video_tx_ops.height;
+  video_rx_ops.fps = video_tx_ops.fps;
+  video_rx_ops.output_fmt = video_tx_ops.input_fmt;
+  video_rx_ops.transport_fmt = video_tx_ops.transport_fmt;
+  video_rx_ops.device = ST_PLUGIN_DEVICE_AUTO;
+  video_rx_ops.framebuff_cnt = 4;
+  video_rx_ops.flags = ST20P_RX_FLAG_BLOCK_GET;
+  st20p_rx_handle video_rx_handle = st20p_rx_create(st, &video_rx_ops);
+  ASSERT_TRUE(video_rx_handle != NULL);
+
+  /* 10ms audio frame, some of them straddle the 16.7ms video frames */
+  struct st30p_tx_ops audio_tx_ops;
+  memset(&audio_tx_ops, 0, sizeof(audio_tx_ops));
+  audio_tx_ops.name = "rx_group_test";
+  audio_tx_ops.port.num_port = 1;
+  memcpy(audio_tx_ops.port.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(audio_tx_ops.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  audio_tx_ops.port.udp_port[MTL_SESSION_PORT_P] = RX_GROUP_TEST_UDP_PORT + 2;
+  audio_tx_ops.port.payload_type = RX_GROUP_TEST_AUDIO_PT;
+  audio_tx_ops.fmt = ST30_FMT_PCM24;
+  audio_tx_ops.channel = 2;
+  audio_tx_ops.sampling = ST30_SAMPLING_48K;
+  audio_tx_ops.ptime = ST30_PTIME_1MS;
+  audio_tx_ops.frame_fmt = ST30_FRAME_FMT_TRANSPORT;
+  audio_tx_ops.frame_time_us = 10 * 1000;
+  audio_tx_ops.framebuff_cnt = 3;
+  audio_tx_ops.flags = ST30P_TX_FLAG_BLOCK_GET;
+  st30p_tx_handle audio_tx_handle = st30p_tx_create(st, &audio_tx_ops);
+  ASSERT_TRUE(audio_tx_handle != NULL);
+  audio_tx->handle = audio_tx_handle;
+
+  struct st30p_rx_ops audio_rx_ops;
+  memset(&audio_rx_ops, 0, sizeof(audio_rx_ops));
+  audio_rx_ops.name = "rx_group_test";
+  audio_rx_ops.port.num_port = 1;
+  memcpy(audio_rx_ops.port.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(audio_rx_ops.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  audio_rx_ops.port.udp_port[MTL_SESSION_PORT_P] = RX_GROUP_TEST_UDP_PORT + 2;
+  audio_rx_ops.port.payload_type = RX_GROUP_TEST_AUDIO_PT;
+  audio_rx_ops.fmt = audio_tx_ops.fmt;
+  audio_rx_ops.channel = audio_tx_ops.channel;
+  audio_rx_ops.sampling = audio_tx_ops.sampling;
+  audio_rx_ops.ptime = audio_tx_ops.ptime;
+  audio_rx_ops.frame_fmt = ST30_FRAME_FMT_TRANSPORT;
+  audio_rx_ops.frame_time_us = audio_tx_ops.frame_time_us;
+  audio_rx_ops.framebuff_cnt = 16;
+  /* the group polls the sessions, no block get */
+  audio_rx_ops.flags = ST30P_RX_FLAG_EVENT_FD;
+  st30p_rx_handle audio_rx_handle = st30p_rx_create(st, &audio_rx_ops);
+  ASSERT_TRUE(audio_rx_handle != NULL);
+
+  struct st40p_tx_ops anc_tx_ops;
+  memset(&anc_tx_ops, 0, sizeof(anc_tx_ops));
+  anc_tx_ops.name = "rx_group_test";
+  anc_tx_ops.port.num_port = 1;
+  memcpy(anc_tx_ops.port.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(anc_tx_ops.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  anc_tx_ops.port.udp_port[MTL_SESSION_PORT_P] = RX_GROUP_TEST_UDP_PORT + 4;
+  anc_tx_ops.port.payload_type = RX_GROUP_TEST_ANC_PT;
+  anc_tx_ops.fps = video_tx_ops.fps;
+  anc_tx_ops.framebuff_cnt = 3;
+  anc_tx_ops.flags = ST40P_TX_FLAG_BLOCK_GET;
+  st40p_tx_handle anc_tx_handle = st40p_tx_create(st, &anc_tx_ops);
+  ASSERT_TRUE(anc_tx_handle != NULL);
+  anc_tx->handle = anc_tx_handle;
+
+  struct st40p_rx_ops anc_rx_ops;
+  memset(&anc_rx_ops, 0, sizeof(anc_rx_ops));
+  anc_rx_ops.name = "rx_group_test";
+  anc_rx_ops.port.num_port = 1;
+  memcpy(anc_rx_ops.port.sip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(anc_rx_ops.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  anc_rx_ops.port.udp_port[MTL_SESSION_PORT_P] = RX_GROUP_TEST_UDP_PORT + 4;
+  anc_rx_ops.port.payload_type = RX_GROUP_TEST_ANC_PT;
+  anc_rx_ops.framebuff_cnt = 8;
+  anc_rx_ops.flags = ST40P_RX_FLAG_EVENT_FD;
+  st40p_rx_handle anc_rx_handle = st40p_rx_create(st, &anc_rx_ops);
+  ASSERT_TRUE(anc_rx_handle != NULL);
+
+  struct st_rx_group_ops group_ops;
+  memset(&group_ops, 0, sizeof(group_ops));
+  group_ops.name = "rx_group_test";
+  group_ops.video = video_rx_handle;
+  group_ops.audio[0] = audio_rx_handle;
+  group_ops.audio_cnt = 1;
+  group_ops.anc[0] = anc_rx_handle;
+  group_ops.anc_cnt = 1;
+  st_rx_group_handle group = st_rx_group_create(st, &group_ops);
+  ASSERT_TRUE(group != NULL);
+
+  struct rx_group_test_result result;
+  memset(&result, 0, sizeof(result));
+
+  std::thread video_thread(rx_group_test_tx_video, video_tx);
+  std::thread audio_thread(rx_group_test_tx_audio, audio_tx);
+  std::thread anc_thread(rx_group_test_tx_anc, anc_tx);
+  std::thread rx_thread(rx_group_test_rx, group, group_rx, &result);
+
+  ret = mtl_start(st);
+  EXPECT_GE(ret, 0);
+  sleep(10);
+
+  video_tx->stop = true;
+  audio_tx->stop = true;
+  anc_tx->stop = true;
+  group_rx->stop = true;
+  st20p_tx_wake_block(video_tx_handle);
+  st30p_tx_wake_block(audio_tx_handle);
+  st40p_tx_wake_block(anc_tx_handle);
+  st20p_rx_wake_block(video_rx_handle);
+  video_thread.join();
+  audio_thread.join();
+  anc_thread.join();
+  rx_thread.join();
+
+  ret = mtl_stop(st);
+  EXPECT_GE(ret, 0);
+
+  info("%s, bundle %d complete %d shared audio %d\n", __func__, result.bundle_cnt,
+       result.complete_cnt, result.shared_audio_cnt);
+  EXPECT_GT(result.bundle_cnt, 0);
+  /* allow some incomplete bundles at the start up */
+  EXPECT_GT(result.complete_cnt, result.bundle_cnt * 8 / 10);
+  EXPECT_GT(result.shared_audio_cnt, 0);
+  EXPECT_EQ(result.audio_order_fail_cnt, 0);
+  EXPECT_LT(result.anc_missing_cnt, 3);
+
+  ret = st_rx_group_free(group);
+  EXPECT_GE(ret, 0);
+  EXPECT_GE(st20p_tx_free(video_tx_handle), 0);
+  EXPECT_GE(st20p_rx_free(video_rx_handle), 0);
+  EXPECT_GE(st30p_tx_free(audio_tx_handle), 0);
+  EXPECT_GE(st30p_rx_free(audio_rx_handle), 0);
+  EXPECT_GE(st40p_tx_free(anc_tx_handle), 0);
+  EXPECT_GE(st40p_rx_free(anc_rx_handle), 0);
+
+  delete video_tx;
+  delete audio_tx;
+  delete anc_tx;
+  delete group_rx;
+}
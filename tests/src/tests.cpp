@@ -44,6 +44,7 @@ enum test_args_cmd {
   TEST_ARG_IOVA_MODE,
   TEST_ARG_MULTI_SRC_PORT,
   TEST_ARG_DHCP,
+  TEST_ARG_TX_EBU,
 };
 
 static struct option test_args_options[] = {
@@ -80,6 +81,7 @@ static struct option test_args_options[] = {
     {"iova_mode", required_argument, 0, TEST_ARG_IOVA_MODE},
     {"multi_src_port", no_argument, 0, TEST_ARG_MULTI_SRC_PORT},
     {"dhcp", no_argument, 0, TEST_ARG_DHCP},
+    {"tx_ebu", no_argument, 0, TEST_ARG_TX_EBU},
 
     {0, 0, 0, 0}};
 
@@ -265,6 +267,9 @@ static int test_parse_args(struct st_tests_context* ctx, struct mtl_init_params*
           p->net_proto[port] = MTL_PROTO_DHCP;
         ctx->dhcp = true;
         break;
+      case TEST_ARG_TX_EBU:
+        p->flags |= MTL_FLAG_TX_VIDEO_EBU;
+        break;
       default:
         break;
     }
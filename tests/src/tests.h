@@ -8,9 +8,12 @@
 #include <inttypes.h>
 #include <math.h>
 #include <mtl/st30_api.h>
+#include <mtl/st30_pipeline_api.h>
 #include <mtl/st40_api.h>
+#include <mtl/st40_pipeline_api.h>
 #include <mtl/st_convert_api.h>
 #include <mtl/st_pipeline_api.h>
+#include <mtl/st_rx_group_api.h>
 
 #include "test_util.h"
 
@@ -64,6 +67,7 @@ struct test_st22_encoder_session {
   int timeout_interval;
   int timeout_ms;
   int rand_ratio;
+  int slice_cnt;
 };
 
 struct test_st22_decoder_session {
@@ -82,6 +86,7 @@ struct test_st22_decoder_session {
   int fail_interval;
   int timeout_interval;
   int timeout_ms;
+  int slice_cnt;
 };
 
 struct st_tests_context {
@@ -106,6 +111,8 @@ struct st_tests_context {
   int plugin_timeout_interval;
   int plugin_timeout_ms;
   int plugin_rand_ratio;
+  int plugin_encode_slice_cnt; /* the slices published by the test encoders */
+  int plugin_decode_slice_cnt; /* the slices got by the test decoders */
 };
 
 struct st_tests_context* st_test_ctx(void);